@@ -3,6 +3,7 @@
 
 #include "NomadThreading.h"
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 
 namespace Nomad {
@@ -29,33 +30,50 @@ enum class AudioQueueCommandType : uint8_t {
 
 // Ensure cache-friendly alignment for RT path
 struct alignas(32) AudioQueueCommand {
+    static constexpr uint64_t kApplyImmediately = ~0ull;
+
     AudioQueueCommandType type{AudioQueueCommandType::None};
     uint32_t trackIndex{0};    // For track-scoped commands
     float value1{0.0f};        // Generic value (gain/pan/mute flag/etc.)
     float value2{0.0f};        // Optional secondary value
     uint64_t samplePos{0};     // For seeks / absolute positions
     uint32_t payloadIndex{0};  // Optional external payload reference
+
+    /**
+     * Stream frame the command takes effect at, on the engine's stream clock
+     * (frames rendered since the engine started, AudioEngine::getStreamSamplePos()).
+     * The engine splits its block at that frame, so the change lands on exactly
+     * that sample. kApplyImmediately applies at the start of the next block; a
+     * time that has already passed does the same and counts as late.
+     */
+    uint64_t sampleTime{kApplyImmediately};
+    uint64_t enqueueNs{0};     // Stamped by push() for latency telemetry
 };
 
 /**
  * @brief Single-producer/single-consumer command queue for UI → Audio.
  *
  * Uses the existing lock-free ring buffer from NomadCore. Capacity is fixed to
- * avoid allocations and keep RT guarantees.
+ * avoid allocations and keep RT guarantees. Immediate and dated commands travel
+ * in separate lanes (each of capacity()), so immediate ones never wait behind
+ * dated ones the engine has no room to schedule yet.
  */
 class AudioCommandQueue {
 public:
     static constexpr size_t kQueueCapacity = 1024;
 
     bool push(const AudioQueueCommand& cmd) {
-        const bool ok = m_queue.push(cmd);
+        AudioQueueCommand stamped = cmd;
+        stamped.enqueueNs = nowNs();
+        auto& lane = cmd.sampleTime == AudioQueueCommand::kApplyImmediately ? m_queue : m_datedQueue;
+        const bool ok = lane.push(stamped);
         if (!ok) {
             // Drop-newest policy: keep audio thread deterministic; UI can observe drops via telemetry.
             m_dropped.fetch_add(1, std::memory_order_relaxed);
             return false;
         }
 
-        const uint32_t depth = static_cast<uint32_t>(m_queue.size());
+        const uint32_t depth = approxDepth();
         uint32_t prev = m_maxDepth.load(std::memory_order_relaxed);
         while (depth > prev &&
                !m_maxDepth.compare_exchange_weak(prev, depth,
@@ -65,16 +83,26 @@ public:
         return true;
     }
 
-    bool pop(AudioQueueCommand& outCmd) {
+    /// Next command pushed with kApplyImmediately.
+    bool popImmediate(AudioQueueCommand& outCmd) {
         return m_queue.pop(outCmd);
     }
 
+    /// Next command pushed with a sampleTime, in push order.
+    bool popDated(AudioQueueCommand& outCmd) {
+        return m_datedQueue.pop(outCmd);
+    }
+
+    bool hasDated() const {
+        return !m_datedQueue.isEmpty();
+    }
+
     bool empty() const {
-        return m_queue.isEmpty();
+        return m_queue.isEmpty() && m_datedQueue.isEmpty();
     }
 
     uint32_t approxDepth() const noexcept {
-        return static_cast<uint32_t>(m_queue.size());
+        return static_cast<uint32_t>(m_queue.size() + m_datedQueue.size());
     }
 
     uint32_t maxDepth() const noexcept {
@@ -85,12 +113,20 @@ public:
         return m_dropped.load(std::memory_order_relaxed);
     }
 
+    /// Commands each lane holds.
     static constexpr uint32_t capacity() noexcept {
         return static_cast<uint32_t>(Nomad::LockFreeRingBuffer<AudioQueueCommand, kQueueCapacity>::capacity());
     }
 
+    /// Monotonic clock used for enqueueNs; compare against it when a command is applied.
+    static uint64_t nowNs() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
 private:
-    Nomad::LockFreeRingBuffer<AudioQueueCommand, kQueueCapacity> m_queue;
+    Nomad::LockFreeRingBuffer<AudioQueueCommand, kQueueCapacity> m_queue;        // kApplyImmediately
+    Nomad::LockFreeRingBuffer<AudioQueueCommand, kQueueCapacity> m_datedQueue;   // Everything with a sampleTime
     std::atomic<uint64_t> m_dropped{0};
     std::atomic<uint32_t> m_maxDepth{0};
 };
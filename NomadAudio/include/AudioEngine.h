@@ -2,12 +2,23 @@
 #pragma once
 
 #include "AudioCommandQueue.h"
+#include "AudioKernels.h"
 #include "AudioTelemetry.h"
+#include "ChannelSlotMap.h"
+#include "ClipResampler.h"
 #include "EngineState.h"
-#include "Interpolators.h"
+#include "LoudnessMeter.h"
+#include "MeterSnapshot.h"
+#include "RenderArena.h"
+#include "RTWorkerPool.h"
+#include "SamplePool.h"
+#include "TimeStretcher.h"
+#include <array>
 #include <cstdint>
 #include <cmath>
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Nomad {
@@ -19,14 +30,24 @@ namespace Audio {
  * Design principles:
  * - Zero allocations in RT thread (all buffers pre-allocated)
  * - Double-precision internal processing (144dB dynamic range)
- * - Lock-free command processing
- * - Multiple interpolation quality modes
+ * - Lock-free command processing, sample-accurate: commands carry a stream
+ *   sample time and the block is split at each one
+ * - Routing (tracks → buses → master, sends) walked from a precompiled,
+ *   level-partitioned RenderSchedule; each level may render in parallel
+ * - No fixed track/bus ceiling: render resources are sized from each published
+ *   graph and grown off the RT thread before the graph goes live
+ * - Block SIMD polyphase resampling for clips at other sample rates
+ * - Per-track/bus peak and RMS measured during the mix and published to a
+ *   MeterSnapshotBuffer once per block
+ * - BS.1770 / EBU R128 loudness and true peak on the master (optionally per
+ *   channel), published to a LoudnessSnapshotBuffer
  * - Proper headroom management
  * - Soft limiting to prevent digital clipping
  */
 class AudioEngine {
 public:
-    AudioEngine() = default;
+    AudioEngine();
+    ~AudioEngine();
 
     /**
      * @brief Process a single audio block (driver callback entry).
@@ -47,18 +68,66 @@ public:
     void setBufferConfig(uint32_t maxFrames, uint32_t numChannels);
     void setTransportPlaying(bool playing) { m_transportPlaying = playing; }
     bool isTransportPlaying() const { return m_transportPlaying; }
-    void setGraph(const AudioGraph& graph) { m_state.swapGraph(graph); }
+    /**
+     * @brief Publish a graph (non-RT). Graphs without a compiled schedule are compiled first.
+     * Grows the render resources first if the graph needs more slots/tracks/buses.
+     */
+    void setGraph(const AudioGraph& graph);
+    /// As above, without copying the graph.
+    void setGraph(AudioGraph&& graph);
+    /**
+     * @brief Republish the graph once decoded stream copies are ready (non-RT).
+     *
+     * Reversed, looped and stretched clips of a forward-only stream need a
+     * decoded copy; setGraph() starts the decode on the sample pool's threads
+     * and plays the stream until then. Call this periodically from the thread
+     * that calls setGraph(). True if it republished.
+     */
+    bool refreshDecodedStreams();
+    /// Wait for every decoded copy setGraph() started, then republish (non-RT; offline rendering).
+    void waitForDecodedStreams();
+    /**
+     * @brief Free graphs replaced by setGraph() once the audio thread is past them (non-RT).
+     * Publishing does this too; call it periodically so memory isn't held until the next edit.
+     */
+    void collectRetiredGraphs() { m_state.collectGarbage(); }
     
     // Position tracking
     uint64_t getGlobalSamplePos() const { return m_globalSamplePos; }
+    /**
+     * @brief Frames rendered since the engine started (any thread).
+     * The clock AudioQueueCommand::sampleTime is scheduled against; unlike the
+     * transport position it never stops or jumps.
+     */
+    uint64_t getStreamSamplePos() const { return m_streamClock.load(std::memory_order_relaxed); }
     void setGlobalSamplePos(uint64_t pos) { m_globalSamplePos = pos; }
+
+    /**
+     * @brief Cue the streamed clips audible from position (non-RT).
+     *
+     * Playback cues a clip before the playhead reaches it; a jump into the middle
+     * of one (a seek, an offline render starting mid-clip) finds nothing loaded
+     * there. Call with the new position to start loading it before the first block.
+     */
+    void cueStreams(uint64_t position) const;
     double getPositionSeconds() const { 
         return m_sampleRate > 0 ? static_cast<double>(m_globalSamplePos) / m_sampleRate : 0.0; 
     }
     
     // Quality settings
-    void setInterpolationQuality(Interpolators::InterpolationQuality q) { m_interpQuality = q; }
-    Interpolators::InterpolationQuality getInterpolationQuality() const { return m_interpQuality; }
+    /**
+     * @brief Resampling quality for clips whose rate differs from the engine's (non-RT).
+     * Re-prepares the active graph's clip resamplers, so it takes effect immediately.
+     */
+    void setResamplingQuality(SRCQuality quality);
+    SRCQuality getResamplingQuality() const { return m_resampleQuality.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Time-stretch quality for pitch-preserving clips (non-RT).
+     * Gives the active graph's stretched clips new voices, so it takes effect immediately.
+     */
+    void setStretchQuality(StretchQuality quality);
+    StretchQuality getStretchQuality() const { return m_stretchQuality.load(std::memory_order_relaxed); }
     
     // Master output control
     void setMasterGain(float gain) { m_masterGainTarget = gain; }
@@ -67,19 +136,92 @@ public:
     void setSafetyProcessingEnabled(bool enabled) { m_safetyProcessingEnabled = enabled; }
     bool isSafetyProcessingEnabled() const { return m_safetyProcessingEnabled; }
 
+    // Parallel track rendering
+    /**
+     * @brief Start/stop the track render workers (non-RT; call while the stream is stopped).
+     * @param numWorkers Helper threads besides the audio thread; 0 = serial rendering only
+     */
+    void setRenderThreadCount(uint32_t numWorkers);
+    uint32_t getRenderThreadCount() const { return m_renderPool.getWorkerCount(); }
+    void setParallelRenderingEnabled(bool enabled) { m_parallelRenderEnabled.store(enabled, std::memory_order_relaxed); }
+    bool isParallelRenderingEnabled() const { return m_parallelRenderEnabled.load(std::memory_order_relaxed); }
+    /// Graphs with fewer audible tracks than this are rendered serially (dispatch isn't free).
+    void setParallelRenderMinTracks(uint32_t minTracks) { m_parallelMinTracks.store(minTracks, std::memory_order_relaxed); }
+    uint32_t getParallelRenderMinTracks() const { return m_parallelMinTracks.load(std::memory_order_relaxed); }
+    const RTWorkerPool& renderWorkerPool() const { return m_renderPool; }
+
+    // Offline stem capture
+    /**
+     * @brief Capture each track's output per block (offline export; call from the thread
+     * that drives processBlock, or while the stream is stopped).
+     *
+     * taps[i] receives graph.tracks[i] post-fader/pan, before bus routing and the master
+     * stage, as interleaved stereo float; silence when the track is not playing. Null
+     * entries are skipped. Each buffer must hold the block's frames. nullptr disables.
+     */
+    void setStemCapture(float* const* taps, uint32_t count) {
+        m_stemTaps = taps;
+        m_stemTapCount = taps ? count : 0;
+    }
+
     // Metering (read on UI thread)
     float getPeakL() const { return m_peakL.load(std::memory_order_relaxed); }
     float getPeakR() const { return m_peakR.load(std::memory_order_relaxed); }
     float getRmsL() const { return m_rmsL.load(std::memory_order_relaxed); }
     float getRmsR() const { return m_rmsR.load(std::memory_order_relaxed); }
 
+    /**
+     * @brief Publish per-channel meters to snapshots (call while the stream is stopped).
+     *
+     * Each block, every metered track and bus gets its post-fader peak and RMS, and the
+     * master output its own in ChannelSlotMap::MASTER_SLOT_INDEX; clip flags latch at
+     * 0 dBFS. Slots are the ones ChannelSlotMap::rebuild(graph) assigns for the
+     * published graph. nullptr disables per-channel metering.
+     */
+    void setMeterSnapshots(std::shared_ptr<MeterSnapshotBuffer> snapshots) {
+        m_meterSnapshotsOwned = snapshots;
+        m_meterSnapshots = snapshots.get();
+    }
+    MeterSnapshotBuffer* getMeterSnapshots() const { return m_meterSnapshots; }
+
+    /**
+     * @brief The snapshot slot a track's meter is published in (UI thread).
+     *
+     * Follows the last graph given to setGraph(); ChannelSlotMap::INVALID_SLOT when that
+     * graph does not carry the track. Look it up per read: slots move when tracks do.
+     */
+    uint32_t getMeterSlot(uint32_t trackId) const;
+
+    /**
+     * @brief Publish loudness readings to snapshots (non-RT; safe while the stream runs).
+     *
+     * The master output is always measured, into ChannelSlotMap::MASTER_SLOT_INDEX.
+     * With perChannel, every metered track and bus is too (post-fader, in the slot
+     * setMeterSnapshots() uses). That runs a K-weighting filter and a 4x true-peak
+     * interpolator per channel inline on the audio thread, roughly 18 us per
+     * channel per 512-frame block (1.2 ms at 64 tracks, over a tenth of the
+     * period), so it is off by default: use it for offline analysis or small
+     * sessions. nullptr disables loudness metering.
+     *
+     * The new meters are built here and handed to the audio thread, which switches
+     * at its next block; the old ones are freed once it has.
+     */
+    void setLoudnessSnapshots(std::shared_ptr<LoudnessSnapshotBuffer> snapshots, bool perChannel = false);
+    LoudnessSnapshotBuffer* getLoudnessSnapshots() const;
+    /// Restart integrated loudness, LRA, maxima and held true peaks (any thread; next block).
+    void resetLoudness() { m_loudnessResetPending.store(true, std::memory_order_relaxed); }
+
     // Waveform history (interleaved stereo), safe to read on UI thread.
     uint32_t getWaveformHistoryCapacity() const { return m_waveformHistoryFrames; }
     uint32_t copyWaveformHistory(float* outInterleaved, uint32_t maxFrames) const;
 
 private:
-    static constexpr size_t kMaxTracks = 64;
+    // Initial render capacity; grown on demand by setGraph(), never shrunk.
+    static constexpr uint32_t kInitialTrackCapacity = 64;
+    static constexpr uint32_t kInitialBusCapacity = 32;
+    static constexpr uint32_t kInitialSlotCapacity = 128;   // Track + bus outputs plus pre-fader taps
     static constexpr uint32_t kWaveformHistoryFramesDefault = 2048;
+    static constexpr uint32_t kDefaultParallelMinTracks = 4;
 
     // Double-precision smoothed parameter for zero-zipper automation
     struct SmoothedParamD {
@@ -101,11 +243,124 @@ private:
         SmoothedParamD pan;
         bool mute{false};
         bool solo{false};
+        // Set by commands: the commanded value wins over the graph's until the
+        // next graph is published (which is built with it).
+        bool volumeSet{false};
+        bool panSet{false};
+        bool muteSet{false};
+        bool soloSet{false};
+
+        float volumeFor(const TrackRenderState& track) const {
+            return volumeSet ? static_cast<float>(volume.target) : track.volume;
+        }
+        float panFor(const TrackRenderState& track) const {
+            return panSet ? static_cast<float>(pan.target) : track.pan;
+        }
+        bool mutedFor(const TrackRenderState& track) const { return muteSet ? mute : track.mute; }
+        bool soloedFor(const TrackRenderState& track) const { return soloSet ? solo : track.solo; }
     };
 
+    /**
+     * @brief Everything the render path indexes by track/bus/node/slot.
+     *
+     * Built off the RT thread and handed over through m_pendingResources; the
+     * audio thread adopts it at a block boundary and carries the per-track and
+     * per-bus smoothing state across.
+     */
+    struct RenderResources {
+        RenderArena buffers;                   // One slot per schedule buffer
+        std::vector<TrackRTState> trackState;  // Indexed by TrackRenderState::trackIndex
+        std::vector<TrackRTState> busState;    // Volume/pan smoothing per bus
+        std::vector<uint32_t> renderJobs;      // Schedule node indices for the current level
+        std::vector<uint8_t> nodeActive;       // Per schedule node: rendered this block
+        std::vector<uint32_t> slotMap;         // Schedule slot -> arena slot, packed per block
+        std::vector<StereoLevels> nodeLevels;  // Per schedule node: meter levels summed over the block
+        std::vector<uint32_t> nodeMeteredFrames; // Per schedule node: frames metered this block
+
+        RenderResources(uint32_t slots, uint32_t frames, uint32_t tracks, uint32_t buses, uint32_t nodes)
+            : buffers(slots, frames), trackState(tracks), busState(buses),
+              renderJobs(nodes, 0), nodeActive(nodes, 0), slotMap(slots, 0), nodeLevels(nodes),
+              nodeMeteredFrames(nodes, 0) {}
+
+        uint32_t nodeCapacity() const { return static_cast<uint32_t>(nodeActive.size()); }
+    };
+
+    /// Loudness meters with the snapshots they publish to, swapped as one (see setLoudnessSnapshots).
+    struct LoudnessMeters {
+        std::shared_ptr<LoudnessSnapshotBuffer> snapshots;   // nullptr: metering off
+        LoudnessMeter master;
+        std::vector<LoudnessMeter> channels;                 // Indexed by meter slot; empty unless per-channel
+    };
+
+    void ensureRenderCapacity(uint32_t slots, uint32_t tracks, uint32_t buses, uint32_t nodes);
+    void adoptPendingResources();
+    void adoptPendingLoudness() noexcept;
+    /// Arena buffer backing a schedule slot this block (only valid for active nodes).
+    double* slotBuffer(uint32_t slot) noexcept { return m_rt->buffers.slot(m_rt->slotMap[slot]); }
     TrackRTState& ensureTrackState(uint32_t trackId);
     void renderGraph(const AudioGraph& graph, uint32_t numFrames);
-    void applyPendingCommands();
+    void renderNode(uint32_t nodeIndex);
+    void renderTrack(const RenderNode& node, const TrackRenderState& track);
+    void renderBus(const RenderNode& node, const BusRenderState& bus);
+    void captureStems(const RenderSchedule& schedule, uint32_t numFrames);
+    /// Fold a rendered node's output into its block meter levels and loudness (node's own thread).
+    void meterNode(uint32_t nodeIndex, const RenderNode& node) noexcept;
+    /// Write the block's channel and master levels and loudness to the snapshots, then reset them.
+    void publishMeters(const AudioGraph& graph, uint32_t numFrames, const StereoLevels& master) noexcept;
+    /// Apply a pending loudness reset or sample-rate change before the block (RT).
+    void prepareLoudnessMeters() noexcept;
+    /// Give each schedule node its MeterSnapshotBuffer slot (non-RT).
+    static void assignMeterSlots(AudioGraph& graph, ChannelSlotMap& slots);
+    static void renderNodeTask(void* context, uint32_t jobIndex);
+    static void applyFaderPan(double* data, uint32_t numFrames, TrackRTState& state, float volume, float pan);
+    /// Clip gain plus the click-free micro-fade at the clip's edges (start = project sample of data[0]).
+    static void applyClipGain(double* data, uint32_t numFrames, uint64_t start, const ClipRenderState& clip);
+    /// Clip frames from source position phase (clipFrame frames into the clip): through the clip's
+    /// time-stretch voice when it has one, else read directly.
+    bool renderClipSource(const ClipRenderState& clip, double phase, uint64_t clipFrame, double ratio,
+                          SRCQuality quality, double* dst, uint32_t frames) const noexcept;
+    struct GrainReadContext;
+    /// TimeStretcher::Reader over readClip().
+    static bool readGrain(void* context, double position, double step, double* dst, uint32_t frames) noexcept;
+    /// Clip frames from source position phase, resampled unless step is 1; false if a stream read fell short.
+    /// Reversed and looping clips map phase into their span and are read pass by pass.
+    bool readClip(const ClipRenderState& clip, double phase, double step, SRCQuality quality,
+                  double* dst, uint32_t frames) const noexcept;
+    /// Forward read of source frames from phase (no reverse or loop mapping).
+    bool readSpan(const ClipRenderState& clip, double phase, double step, SRCQuality quality,
+                  double* dst, uint32_t frames) const noexcept;
+    /// Frames at span offsets within + i * step, read backward for reversed clips.
+    bool readPass(const ClipRenderState& clip, double within, double span, double step, SRCQuality quality,
+                  double* dst, uint32_t frames) const noexcept;
+    /// Crossfade frames approaching a loop's wrap into the start of the next pass.
+    bool blendLoopSeam(const ClipRenderState& clip, double within, double span, bool wrapped, double step,
+                       SRCQuality quality, double* dst, uint32_t frames) const noexcept;
+    /// Source frames a reversed or looping clip plays through (its loop, or its trimmed span);
+    /// ratio is the clip's source frames per output frame.
+    static double clipSpan(const ClipRenderState& clip, double ratio) noexcept;
+    /// Streamed clip at the source rate: source frames [start, start + frames) to dst.
+    static bool readStream(StreamingSource& stream, uint64_t start, uint32_t frames, double* dst) noexcept;
+    /// Packed clip at the source rate: unpacked in cache-sized chunks, then widened to double.
+    static void readPacked(const ClipRenderState& clip, uint64_t start, uint32_t frames, double* dst) noexcept;
+    /// Prefetch the start of streamed clips the playhead is about to reach.
+    void cueUpcomingClips(const TrackRenderState& track, uint64_t blockEnd) const noexcept;
+    /// Play reversed, looped and stretched clips of forward-only streams from decoded copies
+    /// already cached; start decoding the others (non-RT, never decodes here).
+    void prepareDecodedStreams(AudioGraph& graph);
+    /// Give every resampled clip a resampler for the current rate and quality (non-RT).
+    bool resamplersReady(const AudioGraph& graph) const;
+    void prepareResamplers(AudioGraph& graph) const;
+    /// Give every stretched clip a voice of this engine's current quality (non-RT).
+    void prepareStretchers(AudioGraph& graph) const;
+    /// Move queued commands into the time-ordered schedule (RT, bounded).
+    void drainCommandQueue(uint64_t blockStart);
+    void scheduleCommand(const AudioQueueCommand& cmd) noexcept;
+    /// Apply every scheduled command due at or before streamPos.
+    void applyDueCommands(uint64_t streamPos, uint64_t& nowNs);
+    void applyCommand(const AudioQueueCommand& cmd);
+    /// Render frames of one sub-block (commands in effect for its whole length).
+    void renderSegment(const AudioGraph& graph, float* outputBuffer, uint32_t numFrames,
+                       bool wasPlaying, StereoLevels& levels);
     
     // Soft clipper (transparent below unity)
     static inline double softClipD(double x) {
@@ -133,6 +388,16 @@ private:
     AudioTelemetry m_telemetry;
     EngineState m_state;
 
+    // Commands waiting for their sampleTime, sorted by it (FIFO among equal times).
+    // Dated commands fill at most kMaxScheduledCommands; the reserve is for immediate ones.
+    static constexpr uint32_t kMaxScheduledCommands = 256;
+    static constexpr uint32_t kImmediateReserve = 256;
+    std::array<AudioQueueCommand, kMaxScheduledCommands + kImmediateReserve> m_scheduled;
+    uint32_t m_scheduledCount{0};
+    uint64_t m_streamSamplePos{0};                    // RT-owned stream clock
+    std::atomic<uint64_t> m_streamClock{0};           // Published copy for other threads
+    const AudioGraph* m_lastGraph{nullptr};           // Detects graph swaps (clears command overrides)
+
     uint32_t m_sampleRate{48000};
     uint32_t m_maxBufferFrames{4096};  // Larger default for safety
     uint32_t m_outputChannels{2};
@@ -140,12 +405,59 @@ private:
     uint64_t m_globalSamplePos{0};
     
     // Pre-allocated buffers - DOUBLE PRECISION for internal mixing
-    std::vector<std::vector<double>> m_trackBuffersD;  // Double precision track buffers
     std::vector<double> m_masterBufferD;               // Double precision master
-    std::vector<TrackRTState> m_trackState;
+
+    // Render resources. m_rt is owned by the audio thread; the non-RT side keeps
+    // the last published set plus the one before it (which the RT thread may
+    // still be using until it adopts the newer one).
+    RenderResources* m_rt{nullptr};
+    std::atomic<RenderResources*> m_pendingResources{nullptr};
+    std::atomic<RenderResources*> m_adoptedResources{nullptr};
+    std::unique_ptr<RenderResources> m_publishedResources;
+    std::unique_ptr<RenderResources> m_previousResources;
+    std::mutex m_resourceMutex;                        // Serialises non-RT growth
+
+    // Parallel render: block context shared with workers
+    RTWorkerPool m_renderPool;
+    const AudioGraph* m_renderGraph{nullptr};
+    uint64_t m_renderBlockStart{0};
+    uint32_t m_renderBlockFrames{0};
+    std::atomic<bool> m_renderSrcActive{false};
+    std::atomic<bool> m_parallelRenderEnabled{true};
+    std::atomic<uint32_t> m_parallelMinTracks{kDefaultParallelMinTracks};
+
+    // Offline stem capture (see setStemCapture)
+    float* const* m_stemTaps{nullptr};
+    uint32_t m_stemTapCount{0};
+
+    // Per-channel metering (see setMeterSnapshots). Raw pointer for the RT thread (no refcount).
+    std::shared_ptr<MeterSnapshotBuffer> m_meterSnapshotsOwned;
+    MeterSnapshotBuffer* m_meterSnapshots{nullptr};
+    // Slots of the last graph set, for getMeterSlot() (non-RT).
+    ChannelSlotMap m_meterSlots;
+    mutable std::mutex m_meterSlotMutex;
+
+    // Decoded stream copies in flight (see refreshDecodedStreams), cancelled on destruction.
+    std::vector<SampleLoadHandle> m_streamDecodes;
+    std::mutex m_streamDecodeMutex;
+    std::shared_ptr<std::atomic<bool>> m_streamDecodesDone = std::make_shared<std::atomic<bool>>(false);
+
+    // Loudness metering (see setLoudnessSnapshots), handed over like the render
+    // resources: m_loudness is the audio thread's set (nullptr when off); the
+    // non-RT side keeps the last published set and the one before it.
+    LoudnessMeters* m_loudness{nullptr};
+    std::atomic<LoudnessMeters*> m_pendingLoudness{nullptr};
+    std::atomic<LoudnessMeters*> m_adoptedLoudness{nullptr};
+    std::unique_ptr<LoudnessMeters> m_publishedLoudness;
+    std::unique_ptr<LoudnessMeters> m_previousLoudness;
+    mutable std::mutex m_loudnessMutex;                // Serialises setLoudnessSnapshots()
+    std::atomic<bool> m_loudnessResetPending{false};
     
-    // Interpolation quality
-    Interpolators::InterpolationQuality m_interpQuality{Interpolators::InterpolationQuality::Cubic};
+    // Clip resampling. Clips get their own resampler in setGraph(); the defaults
+    // (full-band tables, one per SRCQuality) cover clips that were not prepared.
+    std::atomic<SRCQuality> m_resampleQuality{SRCQuality::Cubic};
+    std::atomic<StretchQuality> m_stretchQuality{StretchQuality::Realtime};
+    std::array<ClipResampler, 5> m_defaultResamplers;
     
     // Master output processing (double precision)
     float m_masterGainTarget{1.0f};
@@ -173,6 +485,9 @@ private:
     static constexpr uint32_t FADE_OUT_SAMPLES = 1024;
     static constexpr uint32_t FADE_IN_SAMPLES = 256;
     static constexpr uint32_t CLIP_EDGE_FADE_SAMPLES = 128;
+    static constexpr uint32_t CLIP_MIX_CHUNK_FRAMES = 512;  // Overlapping clips are summed in chunks this size
+    static constexpr uint32_t LOOP_SEAM_FRAMES = 256;  // Source frames crossfaded where a loop wraps
+    static constexpr uint32_t STREAM_CUE_SECONDS = 2;  // Streamed clips cued this far ahead
     
     // Pre-computed constants
     static constexpr double PI_D = 3.14159265358979323846;
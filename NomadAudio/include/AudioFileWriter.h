@@ -0,0 +1,130 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include "Track.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Container formats the offline exporter can write.
+ */
+enum class AudioFileFormat {
+    Wav,    // RIFF/WAVE, PCM or IEEE float
+    Flac    // Lossless, integer PCM only
+};
+
+/**
+ * @brief Sample encodings for exported files.
+ */
+enum class AudioSampleFormat {
+    Int16,
+    Int24,
+    Float32
+};
+
+/**
+ * @brief Dither and quantize float audio to N-bit integers.
+ *
+ * Modes follow AudioQualitySettings::dithering, scaled to the target word length:
+ * - Triangular: TPDF dither, +/-1 LSB
+ * - HighPass: TPDF dither differenced (d[n] - 0.5 d[n-1]), less audible hiss
+ * - NoiseShaped: TPDF dither plus second-order error feedback that moves the
+ *   requantization noise above ~2 kHz (same F-weighted coefficients as Track)
+ *
+ * State (PRNG, feedback history) is per channel and carried across calls, so a
+ * stream quantized in blocks is identical to one quantized in a single call.
+ */
+class SampleQuantizer {
+public:
+    void configure(uint32_t bits, uint32_t channels, DitheringMode mode, uint32_t seed = 0x9E3779B9u);
+
+    /// frames of interleaved input to integers in [-2^(bits-1), 2^(bits-1) - 1].
+    void process(const float* input, int32_t* output, uint32_t frames) noexcept;
+
+    uint32_t bits() const noexcept { return m_bits; }
+    DitheringMode mode() const noexcept { return m_mode; }
+
+private:
+    struct ChannelState {
+        float prevDither{0.0f};   // HighPass
+        float error1{0.0f};       // NoiseShaped feedback history (in LSBs)
+        float error2{0.0f};
+    };
+
+    float nextTpdf() noexcept;
+
+    uint32_t m_bits{16};
+    uint32_t m_channels{2};
+    DitheringMode m_mode{DitheringMode::None};
+    uint32_t m_rngState{0x9E3779B9u};
+    std::vector<ChannelState> m_state;
+};
+
+/**
+ * @brief Streaming audio file writer (WAV or FLAC).
+ *
+ * write() takes interleaved float blocks of any size; integer formats are
+ * dithered and quantized on the way out. Headers that depend on the length
+ * (RIFF sizes, FLAC STREAMINFO) are patched by close(). Not thread-safe; the
+ * offline exporter drives each writer from its writer thread.
+ *
+ * Usage:
+ * @code
+ *   auto writer = AudioFileWriter::create(AudioFileFormat::Flac);
+ *   writer->open("mix.flac", 48000, 2, AudioSampleFormat::Int24, DitheringMode::Triangular);
+ *   writer->write(block, frames);
+ *   writer->close();
+ * @endcode
+ */
+class AudioFileWriter {
+public:
+    virtual ~AudioFileWriter() = default;
+
+    static std::unique_ptr<AudioFileWriter> create(AudioFileFormat format);
+
+    /// FLAC stores integers only; WAV takes every sample format.
+    static bool supports(AudioFileFormat format, AudioSampleFormat sampleFormat);
+    static const char* extension(AudioFileFormat format);
+    static uint32_t bitsPerSample(AudioSampleFormat sampleFormat);
+
+    bool open(const std::string& path, uint32_t sampleRate, uint32_t channels,
+              AudioSampleFormat sampleFormat, DitheringMode dithering);
+    bool write(const float* interleaved, uint32_t frames);
+    /// Finalize headers and close the file. Safe to call twice.
+    bool close();
+
+    bool isOpen() const { return m_file.is_open(); }
+    uint64_t framesWritten() const { return m_framesWritten; }
+    const std::string& path() const { return m_path; }
+    const std::string& lastError() const { return m_error; }
+
+protected:
+    virtual bool writeHeader() = 0;
+    virtual bool writeInt(const int32_t* interleaved, uint32_t frames) = 0;
+    virtual bool writeFloat(const float* interleaved, uint32_t frames) = 0;
+    virtual bool finish() = 0;
+
+    bool fail(const std::string& message);
+
+    std::ofstream m_file;
+    std::string m_path;
+    std::string m_error;
+    uint32_t m_sampleRate{0};
+    uint32_t m_channels{0};
+    AudioSampleFormat m_sampleFormat{AudioSampleFormat::Int24};
+    uint64_t m_framesWritten{0};
+
+private:
+    SampleQuantizer m_quantizer;
+    std::vector<int32_t> m_intScratch;
+};
+
+} // namespace Audio
+} // namespace Nomad
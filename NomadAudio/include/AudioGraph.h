@@ -1,6 +1,7 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -9,6 +10,10 @@ namespace Nomad {
 namespace Audio {
 
 struct AudioBuffer; // Forward declaration (defined in SamplePool.h)
+struct AudioBufferData; // Forward declaration (defined in ClipSource.h)
+class ClipResampler; // Forward declaration (defined in ClipResampler.h)
+class StreamingSource; // Forward declaration (defined in StreamingSource.h)
+class TimeStretcher; // Forward declaration (defined in TimeStretcher.h)
 
 /**
  * @brief Render-time clip state used by the audio thread.
@@ -18,14 +23,74 @@ struct AudioBuffer; // Forward declaration (defined in SamplePool.h)
  */
 struct ClipRenderState {
     std::shared_ptr<const AudioBuffer> buffer; // Owns audioData lifetime for the snapshot
+    std::shared_ptr<const AudioBufferData> sourceData; // Instead of buffer for playlist clips
     const float* audioData{nullptr};    // Interleaved stereo (engine format)
+    const uint8_t* packedData{nullptr}; // Instead of audioData: packed int16/int24 stereo (owned by buffer)
+    uint32_t packedSampleBytes{0};      // 2 or 3 when packedData is set
+    StreamingSource* stream{nullptr};   // Instead of audioData for streaming buffers (owned by buffer)
     uint64_t startSample{0};            // Absolute project sample (engine rate)
     uint64_t endSample{0};              // Exclusive end
     uint64_t sampleOffset{0};           // Offset into audioData in frames
     uint64_t totalFrames{0};            // Bounds for audioData to guard OOB
     double sourceSampleRate{48000.0};   // Original clip sample rate
+    std::shared_ptr<const ClipResampler> resampler; // Set by AudioEngine::setGraph() when rates differ
     float gain{1.0f};
-    float pan{0.0f};
+    float pan{0.0f};                    // Balance: the far side is attenuated, centre is unity
+    double playbackRate{1.0};           // Source speed on top of the rate conversion
+    uint64_t fadeInSamples{0};          // Linear fades at the clip edges (engine rate), on
+    uint64_t fadeOutSamples{0};         // top of the engine's click-guard micro-fade
+    bool reversed{false};               // Plays its source span backward
+    uint64_t loopFrames{0};             // Source frames looped from sampleOffset (0 = no loop)
+    bool preservePitch{false};          // playbackRate changes tempo only (time-stretched)
+    double pitchRatio{1.0};             // Pitch shift of a pitch-preserving clip
+    std::shared_ptr<TimeStretcher> stretcher; // Set by AudioEngine::setGraph() when stretched()
+
+    /// Source frames read per second of output.
+    double readRate(double outputRate) const noexcept {
+        return (sourceSampleRate > 0.0 ? sourceSampleRate : outputRate) * playbackRate;
+    }
+
+    bool stretched() const noexcept { return preservePitch && (playbackRate != 1.0 || pitchRatio != 1.0); }
+
+    /// Rate the resampler reads at: a stretched clip's grains play at its pitch, not its tempo.
+    double resampleRate(double outputRate) const noexcept {
+        return stretched() ? (sourceSampleRate > 0.0 ? sourceSampleRate : outputRate) * pitchRatio
+                           : readRate(outputRate);
+    }
+};
+
+/**
+ * @brief Interval index over a track's clips for per-block activity lookup.
+ *
+ * Built off the RT thread together with the schedule (AudioGraphCompiler);
+ * requires the track's clips sorted by startSample. maxEnd[i] is the running
+ * maximum of endSample over clips[0..i], so the clips overlapping a block
+ * are found with two binary searches instead of a scan over every clip.
+ */
+struct ClipIntervalIndex {
+    std::vector<uint64_t> maxEnd;
+
+    struct Range {
+        uint32_t first{0};
+        uint32_t last{0};                // Exclusive
+        bool empty() const noexcept { return first >= last; }
+    };
+};
+
+/// Routing target meaning "the master output" (otherwise an index into AudioGraph::buses).
+constexpr uint32_t kMasterBusIndex = 0xFFFFFFFFu;
+/// Sentinel for "no buffer slot" in the compiled schedule.
+constexpr uint32_t kNoBufferSlot = 0xFFFFFFFFu;
+/// Sentinel for "not metered" (same value as ChannelSlotMap::INVALID_SLOT).
+constexpr uint32_t kNoMeterSlot = 0xFFFFFFFFu;
+
+/**
+ * @brief Auxiliary send from a track or bus to a bus.
+ */
+struct SendRenderState {
+    uint32_t targetBus{kMasterBusIndex}; // Index into AudioGraph::buses (or master)
+    float gain{1.0f};
+    bool preFader{false};                // Tap before volume/pan instead of after
 };
 
 /**
@@ -39,6 +104,85 @@ struct TrackRenderState {
     float pan{0.0f};
     bool mute{false};
     bool solo{false};
+    uint32_t outputBus{kMasterBusIndex}; // Main output routing
+    std::vector<SendRenderState> sends;
+    ClipIntervalIndex clipIndex;         // Over clips (sorted by startSample)
+    bool hasStreamedClips{false};        // Some clip reads from disk: cue upcoming ones
+
+    /**
+     * @brief Candidate clips for [blockStart, blockEnd) (RT-safe, no allocation).
+     *
+     * Every clip in the range starts before blockEnd; the first one is known to
+     * overlap, later ones may still end before blockStart and must be checked.
+     * Empty means no clip on this track overlaps the block.
+     */
+    ClipIntervalIndex::Range activeClips(uint64_t blockStart, uint64_t blockEnd) const noexcept {
+        const auto& maxEnd = clipIndex.maxEnd;
+        if (maxEnd.size() != clips.size() || clips.empty()) {
+            return {0, static_cast<uint32_t>(clips.size())}; // Unindexed: scan everything
+        }
+        const auto firstLive = std::upper_bound(maxEnd.begin(), maxEnd.end(), blockStart);
+        const auto pastStart = std::lower_bound(clips.begin(), clips.end(), blockEnd,
+            [](const ClipRenderState& clip, uint64_t end) { return clip.startSample < end; });
+        return {static_cast<uint32_t>(firstLive - maxEnd.begin()),
+                static_cast<uint32_t>(pastStart - clips.begin())};
+    }
+};
+
+/**
+ * @brief Render-time group/return bus state.
+ */
+struct BusRenderState {
+    uint32_t busId{0};
+    float volume{1.0f};
+    float pan{0.0f};
+    bool mute{false};
+    uint32_t outputBus{kMasterBusIndex}; // Another bus or master
+    std::vector<SendRenderState> sends;
+};
+
+/**
+ * @brief One input of a bus (or of master) in the compiled schedule.
+ */
+struct RenderEdge {
+    uint32_t sourceNode{0};              // Index into RenderSchedule::nodes
+    uint32_t sourceSlot{kNoBufferSlot};  // Buffer read (post-fader, or the pre-fader copy)
+    double gain{1.0};
+};
+
+/**
+ * @brief One track or bus in the compiled schedule.
+ */
+struct RenderNode {
+    enum class Type : uint8_t { Track, Bus };
+    Type type{Type::Track};
+    uint32_t index{0};                   // Into AudioGraph::tracks or AudioGraph::buses
+    uint32_t level{0};                   // Dependency depth (tracks are level 0)
+    uint32_t postSlot{kNoBufferSlot};    // Output buffer (after volume/pan)
+    uint32_t preSlot{kNoBufferSlot};     // Pre-fader copy, only if a pre-fader send reads it
+    uint32_t meterSlot{kNoMeterSlot};    // MeterSnapshotBuffer slot (assigned by AudioEngine::setGraph)
+    uint32_t firstInput{0};              // Range in RenderSchedule::inputs (buses only)
+    uint32_t inputCount{0};
+};
+
+/**
+ * @brief Topologically sorted, level-partitioned render plan.
+ *
+ * Compiled off the RT thread by AudioGraphCompiler. Nodes within one level
+ * only read buffers written by lower levels, so a level can be rendered in
+ * parallel; levels run in order and master sums masterInputs last.
+ */
+struct RenderSchedule {
+    std::vector<RenderNode> nodes;         // Sorted by level
+    std::vector<uint32_t> levelOffsets;    // Level L = nodes[levelOffsets[L], levelOffsets[L+1])
+    std::vector<RenderEdge> inputs;        // Bus inputs, grouped per node
+    std::vector<RenderEdge> masterInputs;  // Summed into master in this order
+    uint32_t bufferCount{0};               // Buffer slots referenced by the plan
+    bool compiled{false};
+
+    uint32_t levelCount() const noexcept {
+        return levelOffsets.empty() ? 0u : static_cast<uint32_t>(levelOffsets.size() - 1);
+    }
 };
 
 /**
@@ -46,6 +190,8 @@ struct TrackRenderState {
  */
 struct AudioGraph {
     std::vector<TrackRenderState> tracks;
+    std::vector<BusRenderState> buses;
+    RenderSchedule schedule;
     // Precomputed max end sample across all clips (engine sample rate).
     // Used for transport looping without scanning clips on the RT thread.
     uint64_t timelineEndSample{0};
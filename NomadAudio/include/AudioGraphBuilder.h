@@ -2,26 +2,123 @@
 #pragma once
 
 #include "AudioGraph.h"
+#include "AudioTelemetry.h"
+#include "ClipSource.h"
+#include "PlaylistRuntimeSnapshot.h"
+#include "SamplePool.h"
 #include "TrackManager.h"
 
+#include <memory>
+#include <unordered_map>
+
 namespace Nomad {
 namespace Audio {
 
 /**
  * @brief Builds AudioGraph snapshots from higher-level track state.
  *
- * This runs off the real-time thread. The resulting graph is immutable and can
- * be swapped into EngineState for RT consumption.
+ * This runs off the real-time thread. The resulting graph is immutable, carries
+ * a compiled RenderSchedule (see AudioGraphCompiler), and can be swapped into
+ * EngineState for RT consumption.
+ *
+ * A builder instance is incremental: it keeps each track's TrackRenderState and
+ * resolved audio buffer from the previous build, keyed by the track's version
+ * counters (Track::getGraphVersion / getAudioDataVersion). Unchanged tracks are
+ * reused as they are, tracks whose parameters or clip timing changed get their
+ * clips recomputed against the cached buffer, and only tracks whose samples
+ * changed have their buffer resolved (or copied) again. A fader drag in a
+ * 100-track session therefore touches one track, not all of them.
+ *
+ * The buffers of the most recent graph stay pinned in SamplePool, so the cache
+ * never evicts what is playing.
+ *
+ * A PlaylistRuntimeSnapshot builds instead into one track per lane carrying every
+ * clip of that lane; the engine finds a block's clips through the track's
+ * interval index, so per-block cost follows the clips under the playhead, not
+ * the clips on the lane.
  */
 class AudioGraphBuilder {
 public:
+    /// What the last build() did, per track.
+    struct BuildStats {
+        uint32_t rebuilt{0};     // Audio data changed (or first build)
+        uint32_t patched{0};     // Parameters or timing changed; cached buffer reused
+        uint32_t reused{0};      // Unchanged; previous entry reused as-is
+        uint64_t buildNs{0};
+    };
+
     /**
-     * @brief Build a render graph from the current TrackManager state.
+     * @brief Build a render graph, reusing whatever is unchanged since the last build.
+     *
+     * @param trackManager Source track manager (UI/engine thread)
+     * @param outputSampleRate Target sample rate for rendering (engine/device rate)
+     * @param telemetry Optional; receives the build time and reuse counts
+     */
+    AudioGraph build(const TrackManager& trackManager, double outputSampleRate,
+                     AudioTelemetry* telemetry = nullptr);
+
+    /**
+     * @brief Build a render graph from a playlist snapshot: one track per lane.
+     *
+     * Lane i becomes the track with trackIndex i (trackId i + 1). Clips keep
+     * their gain, pan, fades and playback rate; muted clips and clips whose source
+     * isn't loaded are left out. Clip buffers are held through sources (the
+     * snapshot only carries raw pointers), and non-stereo sources are converted
+     * to stereo once and reused by later builds.
+     *
+     * @param snapshot Playlist state (PlaylistModel::buildRuntimeSnapshot)
+     * @param sources Sources the snapshot's clips point into
+     * @param outputSampleRate Target sample rate for rendering (engine/device rate)
+     * @param telemetry Optional; receives the build time (every lane counted as rebuilt)
+     */
+    AudioGraph build(const PlaylistRuntimeSnapshot& snapshot, const SourceManager& sources,
+                     double outputSampleRate, AudioTelemetry* telemetry = nullptr);
+
+    const BuildStats& lastStats() const { return m_stats; }
+
+    /// Forget cached tracks; the next build() starts from scratch.
+    void reset() { m_cache.clear(); }
+
+    /**
+     * @brief Build a render graph from the current TrackManager state (no caching).
      *
      * @param trackManager Source track manager (UI/engine thread)
      * @param outputSampleRate Target sample rate for rendering (engine/device rate)
      */
     static AudioGraph buildFromTrackManager(const TrackManager& trackManager, double outputSampleRate);
+
+private:
+    /// A track's audio as the graph sees it: shared decoded buffer or an owned copy.
+    struct ResolvedAudio {
+        std::shared_ptr<const AudioBuffer> buffer;
+        double sampleRate{0.0};
+        bool pending{false};     // Decode or pre-resample still running: resolve again next build
+    };
+
+    struct CachedTrack {
+        uint64_t graphVersion{0};
+        uint64_t audioDataVersion{0};
+        ResolvedAudio audio;
+        TrackRenderState state;
+    };
+
+    static ResolvedAudio resolveAudio(const Track& track, double outputSampleRate);
+    static TrackRenderState makeTrackState(const Track& track, const ResolvedAudio& audio,
+                                           double outputSampleRate);
+
+    /// A playlist source in engine format (interleaved stereo).
+    struct StereoSource {
+        std::weak_ptr<const AudioBufferData> source;
+        std::shared_ptr<const AudioBufferData> stereo;
+    };
+
+    static std::shared_ptr<const AudioBufferData> toStereo(const AudioBufferData& source);
+
+    std::unordered_map<const Track*, CachedTrack> m_cache;
+    std::unordered_map<const AudioBufferData*, StereoSource> m_stereoSources;
+    double m_sampleRate{0.0};
+    BuildStats m_stats;
+    SamplePinSet m_pins;
 };
 
 } // namespace Audio
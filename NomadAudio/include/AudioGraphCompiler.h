@@ -0,0 +1,35 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include "AudioGraph.h"
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Compiles an AudioGraph's routing (tracks → buses → master, sends)
+ * into a flat RenderSchedule.
+ *
+ * Runs off the real-time thread (AudioGraphBuilder / AudioEngine::setGraph).
+ * Invalid routing never reaches the RT path:
+ * - out-of-range bus targets fall back to master (outputs) or are dropped (sends)
+ * - buses that form a cycle are routed straight to master and their bus sends dropped
+ *
+ * Compilation also sorts each track's clips by start and builds its
+ * ClipIntervalIndex, so the RT thread can skip tracks with nothing to play.
+ */
+class AudioGraphCompiler {
+public:
+    /**
+     * @brief Build graph.schedule from graph.tracks / graph.buses.
+     * @return false if routing had to be repaired (cycle or bad target); the
+     *         schedule is still valid and usable in that case.
+     */
+    static bool compile(AudioGraph& graph);
+
+    /// Sort a track's clips by startSample and rebuild its ClipIntervalIndex.
+    static void indexClips(TrackRenderState& track);
+};
+
+} // namespace Audio
+} // namespace Nomad
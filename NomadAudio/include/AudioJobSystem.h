@@ -0,0 +1,79 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include "RTWorkerPool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Fixed-capacity job system for per-block parallel audio work.
+ *
+ * A submit/dispatch front end over RTWorkerPool, which owns the workers,
+ * the spin-then-futex parking and the work stealing:
+ * - Job slots are preallocated; submit()/dispatchAndWait() never allocate
+ * - Jobs are a function pointer + context + index (no std::function, no captures)
+ * - A batch is handed to RTWorkerPool::run(), so the calling thread participates
+ *   and returns only when every job ran
+ *
+ * Usage per block (single submitting thread):
+ *   for (...) jobs.submit(fn, ctx, i);
+ *   jobs.dispatchAndWait();
+ */
+class AudioJobSystem {
+public:
+    using JobFn = void (*)(void* context, uint32_t index);
+
+    static constexpr uint32_t kMaxJobs = 512;                         // Per batch; submit() fails beyond this
+    static constexpr uint32_t kMaxWorkers = RTWorkerPool::kMaxWorkers; // Participants = workers + submitting thread
+
+    struct Stats {
+        uint64_t batches{0};
+        uint64_t jobsExecuted{0};
+        uint64_t jobsStolen{0};
+        uint64_t overflowJobs{0};  // Jobs run inline because the slot table was full
+    };
+
+    explicit AudioJobSystem(size_t numWorkers);
+    ~AudioJobSystem();
+
+    AudioJobSystem(const AudioJobSystem&) = delete;
+    AudioJobSystem& operator=(const AudioJobSystem&) = delete;
+
+    /**
+     * @brief Stage a job for the next dispatchAndWait(). RT-safe.
+     * @return false if all slots are taken (the job is then run inline by the caller)
+     */
+    bool submit(JobFn fn, void* context, uint32_t index) noexcept;
+
+    /// Run all staged jobs across the workers and the calling thread; returns when all are done. RT-safe.
+    void dispatchAndWait() noexcept;
+
+    // Get number of worker threads
+    size_t getThreadCount() const { return m_pool.getWorkerCount(); }
+
+    Stats getStats() const noexcept;
+
+private:
+    struct Job {
+        JobFn fn{nullptr};
+        void* context{nullptr};
+        uint32_t index{0};
+    };
+
+    static void runJob(void* context, uint32_t slot) noexcept;
+
+    RTWorkerPool m_pool;
+    Job m_jobs[kMaxJobs];
+    uint32_t m_jobCount{0};
+
+    std::atomic<uint64_t> m_batches{0};
+    std::atomic<uint64_t> m_overflowJobs{0};
+};
+
+} // namespace Audio
+} // namespace Nomad
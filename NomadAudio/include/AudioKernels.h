@@ -0,0 +1,116 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Instruction set tiers the kernel library is built for.
+ */
+enum class SimdLevel : uint8_t {
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Per-channel linear gain ramp over a block.
+ *
+ * Gain at frame i is start + delta * i (computed per frame, not accumulated),
+ * which every implementation evaluates identically.
+ */
+struct StereoRamp {
+    double startL{1.0};
+    double startR{1.0};
+    double deltaL{0.0};
+    double deltaR{0.0};
+};
+
+/**
+ * @brief Peak and sum of squares of an interleaved stereo block.
+ */
+struct StereoLevels {
+    double peakL{0.0};
+    double peakR{0.0};
+    double sumSqL{0.0};
+    double sumSqR{0.0};
+};
+
+/**
+ * @brief One implementation of every kernel (all interleaved stereo unless noted).
+ *
+ * All entries are RT-safe: no allocation, no locks. Every tier produces
+ * bit-identical results to the scalar reference: sums of squares use eight
+ * accumulator lanes (sample index mod 8) in every tier and reduce them in the
+ * same fixed order, and nothing is fused into FMA.
+ */
+struct AudioKernelTable {
+    SimdLevel level{SimdLevel::Scalar};
+
+    /// data *= ramp (in place). Track/bus fader and pan.
+    void (*applyGainRamp)(double* data, uint32_t frames, const StereoRamp& ramp) noexcept;
+    /// dst += src * ramp.
+    void (*mixGainRamp)(double* dst, const double* src, uint32_t frames, const StereoRamp& ramp) noexcept;
+    /// dst += src * gain over a flat sample count.
+    void (*mix)(double* dst, const double* src, double gain, size_t samples) noexcept;
+    /// Peak and sum of squares.
+    void (*measure)(const double* src, uint32_t frames, StereoLevels& out) noexcept;
+    /// dst = float(src * ramp); levels measured on the scaled double signal. Master output stage.
+    void (*rampToFloat)(float* dst, const double* src, uint32_t frames, const StereoRamp& ramp,
+                        StereoLevels& out) noexcept;
+    /// Flat conversions.
+    void (*doubleToFloat)(float* dst, const double* src, size_t samples) noexcept;
+    void (*floatToDouble)(double* dst, const float* src, size_t samples) noexcept;
+    /// Planar <-> interleaved stereo.
+    void (*interleave)(float* dst, const float* left, const float* right, uint32_t frames) noexcept;
+    void (*deinterleave)(float* left, float* right, const float* src, uint32_t frames) noexcept;
+    /// Packed integer PCM to float over a flat sample count: little-endian int16 (x / 32768)
+    /// and three-byte int24 (x / 8388608). Exact, so every tier matches bit for bit.
+    void (*int16ToFloat)(float* dst, const uint8_t* src, size_t samples) noexcept;
+    void (*int24ToFloat)(float* dst, const uint8_t* src, size_t samples) noexcept;
+    /// Running min/max of interleaved frames of any channel count. peaks holds a {min, max}
+    /// pair per channel and is narrowed/widened in place. Eight lanes (sample index mod 8)
+    /// when channels divides eight, so every tier matches bit for bit.
+    void (*peakRange)(const float* src, size_t frames, uint32_t channels, float* peaks) noexcept;
+
+    /// int16ToFloat or int24ToFloat by bytes per sample (2 or 3).
+    void unpack(float* dst, const uint8_t* src, uint32_t sampleBytes, size_t samples) const noexcept {
+        if (sampleBytes == 2) {
+            int16ToFloat(dst, src, samples);
+        } else {
+            int24ToFloat(dst, src, samples);
+        }
+    }
+};
+
+/**
+ * @brief Runtime-dispatched SIMD kernels for the mixing and output paths.
+ *
+ * The CPU is probed once (CPUID + OS support for the wider register files);
+ * the best tier this build supports becomes active. Tiers can be forced down
+ * for testing and benchmarking.
+ */
+class AudioKernels {
+public:
+    /// Active kernel table (RT-safe).
+    static const AudioKernelTable& active() noexcept;
+
+    /// Table for a specific tier, or nullptr if the build or the CPU lacks it.
+    static const AudioKernelTable* table(SimdLevel level) noexcept;
+
+    /// Highest tier usable on this machine.
+    static SimdLevel detectedLevel() noexcept;
+    static SimdLevel activeLevel() noexcept { return active().level; }
+
+    /// Select a tier (non-RT). Requests above detectedLevel() are clamped.
+    static void setLevel(SimdLevel level) noexcept;
+
+    static const char* levelName(SimdLevel level) noexcept;
+};
+
+} // namespace Audio
+} // namespace Nomad
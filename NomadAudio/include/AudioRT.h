@@ -47,6 +47,15 @@ inline uint64_t readCycleCounter() noexcept {
 #endif
 }
 
+// Spin-wait hint for busy loops (PAUSE on x86, YIELD on ARM). RT-safe.
+inline void cpuRelax() noexcept {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 } // namespace RT
 } // namespace Audio
 } // namespace Nomad
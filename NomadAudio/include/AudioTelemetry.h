@@ -32,6 +32,38 @@ struct AudioTelemetry {
     // SRC activity: number of processed blocks that executed resampling work.
     std::atomic<uint64_t> srcActiveBlocks{0};
 
+    // Blocks whose tracks were rendered on the parallel worker pool.
+    std::atomic<uint64_t> parallelRenderBlocks{0};
+
+    // Track activity: tracks with a clip in the block vs. tracks in the graph.
+    // Last block plus running totals over all rendered blocks.
+    std::atomic<uint32_t> lastTracksRendered{0};
+    std::atomic<uint32_t> lastTracksInGraph{0};
+    std::atomic<uint64_t> tracksRendered{0};
+    std::atomic<uint64_t> tracksInGraph{0};
+
+    // Command queue: push-to-apply latency and sub-block scheduling.
+    std::atomic<uint64_t> commandsApplied{0};
+    std::atomic<uint64_t> commandLatencyTotalNs{0};
+    std::atomic<uint64_t> maxCommandLatencyNs{0};
+    std::atomic<uint64_t> lastCommandLatencyNs{0};
+    std::atomic<uint64_t> lateCommands{0};       // sampleTime already passed when drained
+    std::atomic<uint64_t> blockSplits{0};        // Sub-blocks started at a command boundary
+    std::atomic<uint32_t> scheduledCommands{0};  // Waiting for a future block
+    std::atomic<uint64_t> scheduleOverflows{0};  // Drains stopped by a full schedule
+
+    // Graph rebuilds (AudioGraphBuilder, non-RT): time and how much was reused.
+    std::atomic<uint64_t> graphBuilds{0};
+    std::atomic<uint64_t> lastGraphBuildNs{0};
+    std::atomic<uint64_t> maxGraphBuildNs{0};
+    std::atomic<uint32_t> lastGraphTracksRebuilt{0};   // Audio data changed: buffer re-resolved
+    std::atomic<uint32_t> lastGraphTracksPatched{0};   // Parameters/timing changed: clips recomputed
+    std::atomic<uint32_t> lastGraphTracksReused{0};    // Unchanged: previous entry reused as-is
+
+    // Disk streaming (all streamed clips; per-clip counts: StreamingSource::underruns())
+    std::atomic<uint64_t> streamedClipReads{0};        // Clip renders that read from disk
+    std::atomic<uint64_t> streamUnderruns{0};          // ...that found data missing (silence)
+
     // Convenience methods for relaxed memory ordering access
     // Increments
     void incrementBlocksProcessed() noexcept { blocksProcessed.fetch_add(1, std::memory_order_relaxed); }
@@ -39,6 +71,7 @@ struct AudioTelemetry {
     void incrementUnderruns() noexcept { underruns.fetch_add(1, std::memory_order_relaxed); }
     void incrementOverruns() noexcept { overruns.fetch_add(1, std::memory_order_relaxed); }
     void incrementSrcActiveBlocks() noexcept { srcActiveBlocks.fetch_add(1, std::memory_order_relaxed); }
+    void incrementParallelRenderBlocks() noexcept { parallelRenderBlocks.fetch_add(1, std::memory_order_relaxed); }
     
     // Updates
     void updateMaxCallbackNs(uint64_t ns) noexcept {
@@ -62,7 +95,46 @@ struct AudioTelemetry {
     void updateCycleHz(uint64_t hz) noexcept {
         cycleHz.store(hz, std::memory_order_relaxed);
     }
+    void updateTrackActivity(uint32_t rendered, uint32_t inGraph) noexcept {
+        lastTracksRendered.store(rendered, std::memory_order_relaxed);
+        lastTracksInGraph.store(inGraph, std::memory_order_relaxed);
+        tracksRendered.fetch_add(rendered, std::memory_order_relaxed);
+        tracksInGraph.fetch_add(inGraph, std::memory_order_relaxed);
+    }
     
+    void recordCommandApplied(uint64_t latencyNs) noexcept {
+        commandsApplied.fetch_add(1, std::memory_order_relaxed);
+        commandLatencyTotalNs.fetch_add(latencyNs, std::memory_order_relaxed);
+        lastCommandLatencyNs.store(latencyNs, std::memory_order_relaxed);
+        uint64_t current = maxCommandLatencyNs.load(std::memory_order_relaxed);
+        while (latencyNs > current &&
+               !maxCommandLatencyNs.compare_exchange_weak(current, latencyNs, std::memory_order_relaxed)) {
+        }
+    }
+    void incrementLateCommands() noexcept { lateCommands.fetch_add(1, std::memory_order_relaxed); }
+    void incrementBlockSplits() noexcept { blockSplits.fetch_add(1, std::memory_order_relaxed); }
+    void incrementScheduleOverflows() noexcept { scheduleOverflows.fetch_add(1, std::memory_order_relaxed); }
+    void updateScheduledCommands(uint32_t count) noexcept { scheduledCommands.store(count, std::memory_order_relaxed); }
+
+    void recordGraphBuild(uint64_t ns, uint32_t rebuilt, uint32_t patched, uint32_t reused) noexcept {
+        graphBuilds.fetch_add(1, std::memory_order_relaxed);
+        lastGraphBuildNs.store(ns, std::memory_order_relaxed);
+        uint64_t current = maxGraphBuildNs.load(std::memory_order_relaxed);
+        while (ns > current &&
+               !maxGraphBuildNs.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+        }
+        lastGraphTracksRebuilt.store(rebuilt, std::memory_order_relaxed);
+        lastGraphTracksPatched.store(patched, std::memory_order_relaxed);
+        lastGraphTracksReused.store(reused, std::memory_order_relaxed);
+    }
+
+    void recordStreamRead(bool complete) noexcept {
+        streamedClipReads.fetch_add(1, std::memory_order_relaxed);
+        if (!complete) {
+            streamUnderruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
     // Reads with relaxed ordering
     uint64_t getBlocksProcessed() const noexcept { return blocksProcessed.load(std::memory_order_relaxed); }
     uint64_t getXruns() const noexcept { return xruns.load(std::memory_order_relaxed); }
@@ -74,6 +146,30 @@ struct AudioTelemetry {
     uint32_t getLastSampleRate() const noexcept { return lastSampleRate.load(std::memory_order_relaxed); }
     uint64_t getCycleHz() const noexcept { return cycleHz.load(std::memory_order_relaxed); }
     uint64_t getSrcActiveBlocks() const noexcept { return srcActiveBlocks.load(std::memory_order_relaxed); }
+    uint64_t getParallelRenderBlocks() const noexcept { return parallelRenderBlocks.load(std::memory_order_relaxed); }
+    uint32_t getLastTracksRendered() const noexcept { return lastTracksRendered.load(std::memory_order_relaxed); }
+    uint32_t getLastTracksInGraph() const noexcept { return lastTracksInGraph.load(std::memory_order_relaxed); }
+    uint64_t getTracksRendered() const noexcept { return tracksRendered.load(std::memory_order_relaxed); }
+    uint64_t getTracksInGraph() const noexcept { return tracksInGraph.load(std::memory_order_relaxed); }
+    uint64_t getCommandsApplied() const noexcept { return commandsApplied.load(std::memory_order_relaxed); }
+    uint64_t getMaxCommandLatencyNs() const noexcept { return maxCommandLatencyNs.load(std::memory_order_relaxed); }
+    uint64_t getLastCommandLatencyNs() const noexcept { return lastCommandLatencyNs.load(std::memory_order_relaxed); }
+    uint64_t getAverageCommandLatencyNs() const noexcept {
+        const uint64_t applied = getCommandsApplied();
+        return applied ? commandLatencyTotalNs.load(std::memory_order_relaxed) / applied : 0;
+    }
+    uint64_t getLateCommands() const noexcept { return lateCommands.load(std::memory_order_relaxed); }
+    uint64_t getBlockSplits() const noexcept { return blockSplits.load(std::memory_order_relaxed); }
+    uint32_t getScheduledCommands() const noexcept { return scheduledCommands.load(std::memory_order_relaxed); }
+    uint64_t getScheduleOverflows() const noexcept { return scheduleOverflows.load(std::memory_order_relaxed); }
+    uint64_t getGraphBuilds() const noexcept { return graphBuilds.load(std::memory_order_relaxed); }
+    uint64_t getLastGraphBuildNs() const noexcept { return lastGraphBuildNs.load(std::memory_order_relaxed); }
+    uint64_t getMaxGraphBuildNs() const noexcept { return maxGraphBuildNs.load(std::memory_order_relaxed); }
+    uint32_t getLastGraphTracksRebuilt() const noexcept { return lastGraphTracksRebuilt.load(std::memory_order_relaxed); }
+    uint32_t getLastGraphTracksPatched() const noexcept { return lastGraphTracksPatched.load(std::memory_order_relaxed); }
+    uint32_t getLastGraphTracksReused() const noexcept { return lastGraphTracksReused.load(std::memory_order_relaxed); }
+    uint64_t getStreamedClipReads() const noexcept { return streamedClipReads.load(std::memory_order_relaxed); }
+    uint64_t getStreamUnderruns() const noexcept { return streamUnderruns.load(std::memory_order_relaxed); }
 };
 
 } // namespace Audio
@@ -9,8 +9,9 @@
 namespace Nomad {
 namespace Audio {
 
-// Forward declaration
+// Forward declarations
 class Track;
+struct AudioGraph;
 
 /**
  * @brief Maps channel IDs to dense slot indices for lock-free buffer access.
@@ -62,6 +63,17 @@ public:
      */
     void rebuild(const std::vector<std::shared_ptr<Track>>& tracks);
 
+    /**
+     * @brief Rebuild the mapping from a render graph (non-RT).
+     *
+     * Tracks get slots 0, 1, 2... by TrackRenderState::trackId in graph order
+     * (the same slots rebuild(tracks) gives a TrackManager's tracks), then buses
+     * by BusRenderState::busId. Channels past MAX_CHANNEL_SLOTS are not mapped.
+     *
+     * @param graph Graph whose tracks and buses are metered
+     */
+    void rebuild(const AudioGraph& graph);
+
     /**
      * @brief Get the dense slot index for a channel ID.
      *
@@ -97,6 +109,19 @@ public:
      */
     bool hasChannel(uint32_t channelId) const;
 
+    /**
+     * @brief Get the dense slot index for a bus ID (bus IDs have their own namespace).
+     *
+     * @param busId The bus ID
+     * @return Dense slot index, or INVALID_SLOT if not found
+     */
+    uint32_t getBusSlotIndex(uint32_t busId) const;
+
+    /**
+     * @brief Get the number of mapped buses (slots after the channel slots).
+     */
+    uint32_t getBusCount() const { return m_busCount; }
+
     /**
      * @brief Clear all mappings.
      */
@@ -105,7 +130,9 @@ public:
 private:
     std::unordered_map<uint32_t, uint32_t> m_idToSlot;   ///< channelId -> slotIndex
     std::unordered_map<uint32_t, uint32_t> m_slotToId;   ///< slotIndex -> channelId
+    std::unordered_map<uint32_t, uint32_t> m_busToSlot;  ///< busId -> slotIndex
     uint32_t m_channelCount{0};                          ///< Number of mapped channels
+    uint32_t m_busCount{0};                              ///< Number of mapped buses
 };
 
 } // namespace Audio
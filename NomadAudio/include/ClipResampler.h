@@ -0,0 +1,123 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include "SampleRateConverter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+class StreamingSource;
+
+/**
+ * @brief Polyphase coefficient table for one quality and cutoff.
+ *
+ * Row p holds the taps for fractional source position p / POLYPHASE_PHASES;
+ * the extra last row (position 1.0) lets the kernel interpolate between
+ * adjacent phases instead of snapping to the nearest one. Rows are padded
+ * with zero taps to a multiple of eight so the SIMD loops have no tail.
+ * Immutable once built and shared between every clip that needs it.
+ */
+struct ClipResamplerBank {
+    std::vector<float> coeffs;           // (POLYPHASE_PHASES + 1) rows of stride floats
+    uint32_t numTaps{0};                 // Taps that carry weight
+    uint32_t stride{0};                  // numTaps rounded up to 8
+    SRCQuality quality{SRCQuality::Cubic};
+    double cutoff{1.0};                  // Relative to the source Nyquist
+
+    const float* row(uint32_t phase) const noexcept { return coeffs.data() + static_cast<size_t>(phase) * stride; }
+};
+
+/**
+ * @brief Block-oriented polyphase resampler for clip playback.
+ *
+ * Renders a whole block of one clip per call: the source frames the block
+ * touches are deinterleaved into a planar window once, then every output frame
+ * is a pair of SIMD dot products against a phase-interpolated coefficient row.
+ * Output frame i is the source at position + i * step, computed per frame
+ * rather than accumulated, so splitting a block never changes the result.
+ *
+ * One instance describes one clip's conversion (filter table for its rate
+ * pair and quality). It is prepared off the RT thread and is read-only while
+ * rendering, so a clip's resampler can be shared by graph snapshots.
+ *
+ * Usage:
+ * @code
+ *   ClipResampler rs;
+ *   rs.configure(44100.0, 48000.0, SRCQuality::Sinc16);   // Non-RT
+ *   rs.process(clipData, clipFrames, sourcePos, rs.step(), block, frames);   // RT
+ * @endcode
+ */
+class ClipResampler {
+public:
+    /**
+     * @brief Prepare for a source/output rate pair (non-RT).
+     *
+     * Filter tables are cached per (quality, cutoff) and shared between clips.
+     * Downsampling lowers the cutoff to the output Nyquist.
+     */
+    void configure(double sourceRate, double outputRate, SRCQuality quality);
+
+    bool isConfigured() const noexcept { return m_bank != nullptr; }
+
+    /// True if configure() was called with exactly these parameters.
+    bool matches(double sourceRate, double outputRate, SRCQuality quality) const noexcept {
+        return m_bank && m_sourceRate == sourceRate && m_outputRate == outputRate && m_bank->quality == quality;
+    }
+
+    SRCQuality quality() const noexcept { return m_bank ? m_bank->quality : SRCQuality::Cubic; }
+    uint32_t numTaps() const noexcept { return m_bank ? m_bank->numTaps : 0; }
+    /// Source frames advanced per output frame (sourceRate / outputRate).
+    double step() const noexcept { return m_step; }
+
+    /**
+     * @brief Render frames output frames (RT-safe, no allocation).
+     *
+     * @param source Interleaved stereo clip data
+     * @param totalFrames Source length; frames outside [0, totalFrames) read as silence
+     * @param position Fractional source frame of the first output frame
+     * @param step Source frames per output frame (normally step())
+     * @param dst Interleaved stereo output, overwritten
+     */
+    void process(const float* source, uint64_t totalFrames, double position, double step,
+                 double* dst, uint32_t frames) const noexcept;
+
+    /**
+     * @brief Same as above for packed integer stereo (RT-safe, no allocation).
+     *
+     * @param sampleBytes 2 for int16, 3 for int24 (see AudioKernelTable::unpack)
+     */
+    void process(const uint8_t* source, uint32_t sampleBytes, uint64_t totalFrames, double position,
+                 double step, double* dst, uint32_t frames) const noexcept;
+
+    /**
+     * @brief Same as above, pulling source frames from a streaming clip (RT-safe).
+     *
+     * Reads exactly the frames the in-memory overload would touch, so a fully
+     * buffered stream renders bit-identically.
+     * @return false if any read underran (those frames rendered as silence)
+     */
+    bool process(StreamingSource& source, double position, double step,
+                 double* dst, uint32_t frames) const noexcept;
+
+    /// Filter length used for a quality (2 = linear, 4 = Catmull-Rom, else windowed sinc).
+    static uint32_t tapsFor(SRCQuality quality) noexcept;
+
+    static const char* qualityName(SRCQuality quality) noexcept;
+
+private:
+    static std::shared_ptr<const ClipResamplerBank> bankFor(SRCQuality quality, double cutoff);
+    static std::shared_ptr<const ClipResamplerBank> buildBank(SRCQuality quality, double cutoff);
+
+    std::shared_ptr<const ClipResamplerBank> m_bank;
+    double m_sourceRate{0.0};
+    double m_outputRate{0.0};
+    double m_step{1.0};
+};
+
+} // namespace Audio
+} // namespace Nomad
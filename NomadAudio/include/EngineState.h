@@ -2,38 +2,111 @@
 #pragma once
 
 #include "AudioGraph.h"
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Nomad {
 namespace Audio {
 
 /**
- * @brief Double-buffered engine state for safe UI → RT handoff.
+ * @brief RCU-style graph publication for safe UI → RT handoff.
  *
- * Build new graphs off the audio thread, then swap them in atomically so the
- * callback always reads an immutable snapshot without locking.
+ * Each published graph is an immutable heap snapshot behind an atomic pointer.
+ * Publishing swaps the pointer (O(1), no copy) and moves the previous graph to
+ * a retire list. The audio thread pins the graph it renders with a hazard
+ * pointer, so a graph is only freed once the callback has moved past it, and
+ * always on a non-RT thread: the publisher, or whoever calls collectGarbage().
+ * The last shared_ptr<AudioBuffer> releases held by clips therefore never land
+ * on the callback.
+ *
+ * One reader (the audio thread, whose render workers only run inside its
+ * block), any number of publishers (serialised internally).
  */
 class EngineState {
 public:
-    const AudioGraph& activeGraph() const noexcept {
-        return m_graphs[m_activeIndex.load(std::memory_order_acquire)];
+    EngineState() : m_active(new AudioGraph()) {}
+
+    ~EngineState() {
+        delete m_active.load(std::memory_order_relaxed);
+        for (const AudioGraph* graph : m_retired) {
+            delete graph;
+        }
+    }
+
+    EngineState(const EngineState&) = delete;
+    EngineState& operator=(const EngineState&) = delete;
+
+    /**
+     * @brief Pin and return the current graph (audio thread, once per block).
+     *
+     * The graph stays valid until the next acquireGraph() call. Lock-free;
+     * retries only if a publish lands between the load and the pin.
+     */
+    const AudioGraph& acquireGraph() noexcept {
+        const AudioGraph* graph = m_active.load(std::memory_order_acquire);
+        for (;;) {
+            m_hazard.store(graph, std::memory_order_seq_cst);
+            const AudioGraph* again = m_active.load(std::memory_order_seq_cst);
+            if (again == graph) {
+                return *graph;
+            }
+            graph = again;
+        }
     }
 
-    void swapGraph(const AudioGraph& next) {
-        const int inactive = 1 - m_activeIndex.load(std::memory_order_relaxed);
-        m_graphs[inactive] = next; // copy/move from builder thread
-        m_activeIndex.store(inactive, std::memory_order_release);
+    /**
+     * @brief Publish a new graph (non-RT). Takes ownership; reclaims what it can.
+     */
+    void publish(std::unique_ptr<AudioGraph> next) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const AudioGraph* old = m_active.exchange(next.release(), std::memory_order_seq_cst);
+        m_retired.push_back(old);
+        reclaimLocked();
     }
 
-    // Non-RT access for initialization or inspection.
-    AudioGraph& mutableInactiveGraph() {
-        const int inactive = 1 - m_activeIndex.load(std::memory_order_relaxed);
-        return m_graphs[inactive];
+    /**
+     * @brief Copy of the latest published graph (non-RT).
+     */
+    AudioGraph copyActiveGraph() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return *m_active.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Free retired graphs the audio thread no longer uses (non-RT).
+     * Call periodically so a retired graph doesn't wait for the next publish.
+     */
+    void collectGarbage() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        reclaimLocked();
+    }
+
+    /// Retired graphs still waiting to be freed (non-RT).
+    size_t retiredCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_retired.size();
     }
 
 private:
-    AudioGraph m_graphs[2];
-    std::atomic<int> m_activeIndex{0};
+    void reclaimLocked() {
+        // A graph retired before this load can only be pinned if the reader pinned
+        // it before the publish, which this load then sees.
+        const AudioGraph* pinned = m_hazard.load(std::memory_order_seq_cst);
+        auto keep = std::partition(m_retired.begin(), m_retired.end(),
+                                   [pinned](const AudioGraph* graph) { return graph == pinned; });
+        for (auto it = keep; it != m_retired.end(); ++it) {
+            delete *it;
+        }
+        m_retired.erase(keep, m_retired.end());
+    }
+
+    std::atomic<const AudioGraph*> m_active;
+    std::atomic<const AudioGraph*> m_hazard{nullptr};   // Graph the audio thread is rendering
+    std::vector<const AudioGraph*> m_retired;           // Guarded by m_mutex
+    mutable std::mutex m_mutex;
 };
 
 } // namespace Audio
@@ -0,0 +1,172 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief One meter's loudness readings (LUFS/LU per EBU R128, true peak LINEAR).
+ */
+struct LoudnessReadings {
+    static constexpr float kSilence = -std::numeric_limits<float>::infinity();
+
+    float momentaryLufs{kSilence};      // 400 ms window
+    float shortTermLufs{kSilence};      // 3 s window
+    float integratedLufs{kSilence};     // Gated programme loudness since reset
+    float loudnessRange{0.0f};          // LRA in LU since reset
+    float maxMomentaryLufs{kSilence};
+    float maxShortTermLufs{kSilence};
+    float truePeakL{0.0f};              // Held since reset (LINEAR, 4x oversampled)
+    float truePeakR{0.0f};
+};
+
+/**
+ * @brief Real-time loudness and true-peak meter for one stereo signal (ITU-R BS.1770-4).
+ *
+ * The signal is K-weighted and its energy summed in 100 ms steps. Every step
+ * updates momentary (4 steps) and short-term (30 steps) loudness; the gated
+ * integrated loudness (-70 LUFS absolute, -10 LU relative gate) and the
+ * loudness range (EBU Tech 3342: -20 LU relative gate, 10th to 95th
+ * percentile of short-term values) are kept in 0.1 LU histograms, so memory is
+ * fixed however long the programme runs. True peak comes from the BS.1770
+ * 48-tap polyphase interpolator at 4x.
+ *
+ * All state lives inline: prepare(), reset() and process() never allocate, so
+ * a meter may be re-prepared on the audio thread when the sample rate changes.
+ * Not thread-safe: process and read readings() on one thread, and publish
+ * them through LoudnessSnapshotBuffer.
+ *
+ * Usage:
+ * @code
+ *   LoudnessMeter meter;
+ *   meter.prepare(48000.0);
+ *   meter.process(interleavedStereo, frames);
+ *   float lufs = meter.readings().integratedLufs;
+ * @endcode
+ */
+class LoudnessMeter {
+public:
+    LoudnessMeter() = default;
+
+    /// Set the sample rate and reset (RT-safe). Unprepared meters ignore input.
+    void prepare(double sampleRate) noexcept;
+    double sampleRate() const noexcept { return m_sampleRate; }
+
+    /// Forget everything measured so far: integrated, LRA, maxima and held peaks restart.
+    void reset() noexcept;
+
+    /// Measure interleaved stereo frames.
+    void process(const float* interleaved, uint32_t frames) noexcept;
+    void process(const double* interleaved, uint32_t frames) noexcept;
+    /// Advance time by frames of silence without touching samples (inactive tracks).
+    void processSilence(uint32_t frames) noexcept;
+
+    /// Readings as of the last completed 100 ms step; true peaks are always current.
+    const LoudnessReadings& readings() const noexcept { return m_readings; }
+
+    /// LINEAR peak to dBTP / dBFS (-inf for silence).
+    static float toDecibels(float linear) noexcept;
+
+private:
+    static constexpr uint32_t kShortTermSteps = 30;   // 3 s of 100 ms steps
+    static constexpr uint32_t kMomentarySteps = 4;    // 400 ms
+    static constexpr uint32_t kHistogramBins = 1000;  // -70 .. +30 LUFS in 0.1 LU bins
+    static constexpr uint32_t kTruePeakTaps = 12;     // Per phase; 4 phases
+
+    struct Biquad {
+        double b0{1.0}, b1{0.0}, b2{0.0}, a1{0.0}, a2{0.0};
+    };
+
+    /// Gating-block energies bucketed by loudness, with the exact energy per bucket.
+    struct Histogram {
+        std::array<uint32_t, kHistogramBins> counts{};
+        std::array<double, kHistogramBins> energy{};
+        uint64_t total{0};
+
+        void add(double blockEnergy) noexcept;
+        /// Mean energy of blocks at or above gateLufs; 0 if none.
+        double meanAbove(double gateLufs, uint64_t* count = nullptr) const noexcept;
+        void clear() noexcept;
+    };
+
+    template <typename Sample>
+    void processFrames(const Sample* src, uint32_t frames) noexcept;
+    double truePeakStep(uint32_t channel, double x) noexcept;
+    void completeStep() noexcept;
+    void updateGatedReadings() noexcept;
+    void clearSignalState() noexcept;
+
+    double m_sampleRate{0.0};
+    uint32_t m_stepFrames{0};                 // Frames per 100 ms step
+    uint32_t m_stepPos{0};
+    std::array<double, 2> m_stepEnergy{};     // K-weighted sum of squares this step
+
+    // K-weighting: high shelf then high pass, transposed direct form II per channel.
+    Biquad m_shelf;
+    Biquad m_highPass;
+    std::array<std::array<double, 4>, 2> m_filterState{};
+
+    // Last kShortTermSteps step energies (channel mean squares summed).
+    std::array<double, kShortTermSteps> m_steps{};
+    uint32_t m_stepIndex{0};
+    uint64_t m_stepsSeen{0};
+
+    Histogram m_momentaryBlocks;              // Gating blocks for integrated loudness
+    Histogram m_shortTermBlocks;              // Short-term values for LRA
+
+    // True-peak interpolator history, written twice so the last taps are contiguous.
+    std::array<std::array<double, kTruePeakTaps * 2>, 2> m_peakHistory{};
+    uint32_t m_peakPos{0};
+    std::array<double, 2> m_truePeak{};
+    bool m_signalStateClear{true};
+
+    LoudnessReadings m_readings;
+};
+
+/**
+ * @brief Lock-free loudness readings per meter slot, mirroring MeterSnapshotBuffer.
+ *
+ * Same slots as MeterSnapshotBuffer (ChannelSlotMap, master in MASTER_SLOT_INDEX).
+ * The audio thread writes into [writeIndex] and flips it with release semantics;
+ * the UI reads [1 - writeIndex] with acquire semantics.
+ */
+class LoudnessSnapshotBuffer {
+public:
+    static constexpr size_t MAX_CHANNELS = 128;
+
+    /// Write a slot's readings (audio thread).
+    void write(uint32_t slotIndex, const LoudnessReadings& readings) noexcept {
+        if (slotIndex >= MAX_CHANNELS) return;
+        auto& snap = m_snapshots[slotIndex];
+        const uint8_t writeIdx = snap.writeIndex.load(std::memory_order_relaxed);
+        snap.buffers[writeIdx] = readings;
+        snap.writeIndex.store(1 - writeIdx, std::memory_order_release);
+    }
+
+    /// Read a slot's readings (UI thread); defaults for slots never written.
+    void read(uint32_t slotIndex, LoudnessReadings& out) const noexcept {
+        if (slotIndex >= MAX_CHANNELS) {
+            out = LoudnessReadings{};
+            return;
+        }
+        const auto& snap = m_snapshots[slotIndex];
+        out = snap.buffers[1 - snap.writeIndex.load(std::memory_order_acquire)];
+    }
+
+private:
+    struct alignas(64) Snapshot {
+        LoudnessReadings buffers[2];
+        std::atomic<uint8_t> writeIndex{0};
+    };
+
+    std::array<Snapshot, MAX_CHANNELS> m_snapshots;
+};
+
+} // namespace Audio
+} // namespace Nomad
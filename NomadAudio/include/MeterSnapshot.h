@@ -41,6 +41,8 @@ struct alignas(64) ChannelMeterSnapshot {
     struct Buffer {
         uint32_t peakL_bits{0};  // float as uint32_t bitcast (LINEAR 0..1)
         uint32_t peakR_bits{0};  // float as uint32_t bitcast (LINEAR 0..1)
+        uint32_t rmsL_bits{0};   // float as uint32_t bitcast (LINEAR 0..1)
+        uint32_t rmsR_bits{0};   // float as uint32_t bitcast (LINEAR 0..1)
         uint8_t clipFlags{0};    // bit 0 = L clip, bit 1 = R clip
     };
 
@@ -68,7 +70,7 @@ public:
     /**
      * @brief Write peak levels from audio thread.
      *
-     * Called during mix loop with LINEAR peak values (0..1).
+     * Called during mix loop with LINEAR peak values (0..1). RMS is written as zero.
      * Uses release semantics on index swap to ensure buffer writes are visible.
      *
      * @param slotIndex Dense slot index (0..MAX_CHANNELS-1)
@@ -76,12 +78,29 @@ public:
      * @param peakR Right channel peak (LINEAR 0..1)
      */
     void writePeak(uint32_t slotIndex, float peakL, float peakR) {
+        writeLevels(slotIndex, peakL, peakR, 0.0f, 0.0f);
+    }
+
+    /**
+     * @brief Write peak and RMS levels from audio thread.
+     *
+     * As writePeak(), with the block's RMS alongside (LINEAR 0..1).
+     *
+     * @param slotIndex Dense slot index (0..MAX_CHANNELS-1)
+     * @param peakL Left channel peak
+     * @param peakR Right channel peak
+     * @param rmsL Left channel RMS
+     * @param rmsR Right channel RMS
+     */
+    void writeLevels(uint32_t slotIndex, float peakL, float peakR, float rmsL, float rmsR) {
         if (slotIndex >= MAX_CHANNELS) return;
         auto& snap = m_snapshots[slotIndex];
         uint8_t writeIdx = snap.writeIndex.load(std::memory_order_relaxed);
         auto& buf = snap.buffers[writeIdx];
         buf.peakL_bits = MeterBitcast::floatToU32(peakL);
         buf.peakR_bits = MeterBitcast::floatToU32(peakR);
+        buf.rmsL_bits = MeterBitcast::floatToU32(rmsL);
+        buf.rmsR_bits = MeterBitcast::floatToU32(rmsR);
         // Swap buffer index with release semantics
         snap.writeIndex.store(1 - writeIdx, std::memory_order_release);
     }
@@ -139,6 +158,25 @@ public:
         clipR = (buf.clipFlags & ChannelMeterSnapshot::CLIP_R) != 0;
     }
 
+    /**
+     * @brief Read RMS levels from UI thread (zero for slots only written by writePeak()).
+     *
+     * @param slotIndex Dense slot index
+     * @param[out] rmsL Left channel RMS (LINEAR 0..1)
+     * @param[out] rmsR Right channel RMS (LINEAR 0..1)
+     */
+    void readRms(uint32_t slotIndex, float& rmsL, float& rmsR) const {
+        if (slotIndex >= MAX_CHANNELS) {
+            rmsL = rmsR = 0.0f;
+            return;
+        }
+        const auto& snap = m_snapshots[slotIndex];
+        uint8_t readIdx = 1 - snap.writeIndex.load(std::memory_order_acquire);
+        const auto& buf = snap.buffers[readIdx];
+        rmsL = MeterBitcast::u32ToFloat(buf.rmsL_bits);
+        rmsR = MeterBitcast::u32ToFloat(buf.rmsR_bits);
+    }
+
     /**
      * @brief Clear clip latch for a channel (UI thread).
      *
@@ -162,9 +200,13 @@ public:
         for (auto& snap : m_snapshots) {
             snap.buffers[0].peakL_bits = 0;
             snap.buffers[0].peakR_bits = 0;
+            snap.buffers[0].rmsL_bits = 0;
+            snap.buffers[0].rmsR_bits = 0;
             snap.buffers[0].clipFlags = 0;
             snap.buffers[1].peakL_bits = 0;
             snap.buffers[1].peakR_bits = 0;
+            snap.buffers[1].rmsL_bits = 0;
+            snap.buffers[1].rmsR_bits = 0;
             snap.buffers[1].clipFlags = 0;
             snap.writeIndex.store(0, std::memory_order_relaxed);
         }
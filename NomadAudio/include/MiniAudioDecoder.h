@@ -1,7 +1,11 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #pragma once
 
+#include "StreamingSource.h"
+
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,7 +24,8 @@ namespace Audio {
  *                  Data is normalized to [-1.0, 1.0] range and ready for audio processing
  * @param sampleRate Output parameter: sample rate in Hz (e.g., 44100, 48000)
  * @param numChannels Output parameter: number of channels (1=mono, 2=stereo, etc.)
- * @return true if successful, false if file could not be decoded
+ * @param progress Optional: called with the fraction decoded between chunks; return false to abort
+ * @return true if successful, false if file could not be decoded (or was aborted)
  *
  * @warning The audioData vector is resized to contain the decoded samples.
  *          Previous contents are lost on successful decode.
@@ -30,7 +35,16 @@ namespace Audio {
 [[nodiscard]] bool loadWithMiniAudio(const std::string& filePath,
                                      std::vector<float>& audioData,
                                      uint32_t& sampleRate,
-                                     uint32_t& numChannels);
+                                     uint32_t& numChannels,
+                                     const std::function<bool(float)>& progress = {});
+
+/**
+ * @brief Incremental miniaudio decoder for RingStreamSource (stereo float out).
+ *
+ * Returns nullptr when NOMAD_USE_MINIAUDIO is not defined, the file can't be
+ * opened, or its length is unknown.
+ */
+[[nodiscard]] std::unique_ptr<StreamDecoder> openMiniAudioStream(const std::string& filePath);
 
 } // namespace Audio
 } // namespace Nomad
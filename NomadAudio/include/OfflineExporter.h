@@ -0,0 +1,115 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include "AudioFileWriter.h"
+#include "AudioGraph.h"
+#include "LoudnessMeter.h"
+#include "TimeStretcher.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief What to render and how to encode it.
+ */
+struct ExportSettings {
+    std::string outputPath;                    // Mixdown file (when exportMix)
+    std::string stemDirectory;                 // Stem files go here (when exportStems)
+    std::vector<std::string> stemNames;        // Per graph track; default "Track <id>"
+
+    AudioFileFormat format{AudioFileFormat::Wav};
+    AudioSampleFormat sampleFormat{AudioSampleFormat::Int24};
+    DitheringMode dithering{DitheringMode::Triangular};   // Integer formats only
+    SRCQuality resampling{SRCQuality::Sinc64};            // Clips at other rates
+    StretchQuality stretching{StretchQuality::HighQuality}; // Pitch-preserving clips
+
+    uint32_t sampleRate{48000};                // Must match the rate the graph was built for
+    uint64_t startSample{0};
+    uint64_t endSample{0};                     // Exclusive; 0 = graph.timelineEndSample
+    bool exportMix{true};
+    bool exportStems{false};                   // One file per track, same pass as the mix
+
+    uint32_t blockFrames{4096};                // Large blocks: no deadline offline
+    uint32_t renderThreads{0};                 // Track render helpers; 0 = all cores but one
+    uint32_t queueBlocks{8};                   // Rendered blocks the writer may lag behind
+
+    float masterGain{1.0f};
+    float headroomDb{-6.0f};
+    bool safetyProcessing{false};
+
+    bool normalizeLoudness{false};             // Gain the mix to targetLufs (adds a measuring pass)
+    float targetLufs{-14.0f};                  // Integrated loudness to normalise to
+    float truePeakCeilingDb{-1.0f};            // Normalising never raises the true peak above this
+
+    /// Take dithering and resampling quality from the project's quality settings.
+    void applyQualitySettings(const AudioQualitySettings& quality);
+};
+
+/**
+ * @brief Outcome of an export, including how much faster than realtime it ran.
+ */
+struct ExportResult {
+    bool success{false};
+    bool cancelled{false};
+    std::string error;
+    std::vector<std::string> files;            // Mix first, then stems in track order
+    uint64_t framesRendered{0};
+    double audioSeconds{0.0};
+    double renderSeconds{0.0};                 // Wall time, render start to last file closed
+    double realtimeFactor{0.0};                // audioSeconds / renderSeconds
+    uint64_t writerStalls{0};                  // Blocks the renderer waited for the writer
+    LoudnessReadings loudness;                 // The written mix (EBU R128), when exportMix
+    float normalizationGainDb{0.0f};           // Gain normalizeLoudness applied to the mix
+};
+
+/**
+ * @brief Faster-than-realtime bounce of a graph to disk.
+ *
+ * Drives a private AudioEngine through OfflineRenderHarness as fast as it will
+ * go: large blocks, parallel track rendering on every spare core, no device
+ * deadline. Rendered blocks go through a bounded queue to a writer thread that
+ * dithers, encodes and writes the mix and every stem, so disk and encoder time
+ * overlap rendering and memory stays fixed however long the project is.
+ * Streamed clips are loaded on the rendering thread before each block
+ * (StreamIOPool::serviceNow), since the I/O threads can't keep up with it.
+ *
+ * Stems are captured in the same pass as the mix (AudioEngine::setStemCapture):
+ * each is the track's post-fader output before buses and the master stage.
+ *
+ * The writer thread measures the mix's loudness and true peak as it goes
+ * (ExportResult::loudness). With normalizeLoudness, a first pass only measures;
+ * the export pass then scales the master by the gain that reaches targetLufs,
+ * held back so the true peak stays under truePeakCeilingDb. With
+ * safetyProcessing the soft clip after master gain is not linear, so that gain
+ * is measured again once applied and corrected (a few passes at most) until the
+ * mix lands within 0.1 dB of the target and under the ceiling. Stems are not
+ * affected.
+ *
+ * Usage:
+ * @code
+ *   ExportSettings settings;
+ *   settings.outputPath = "song.flac";
+ *   settings.format = AudioFileFormat::Flac;
+ *   settings.applyQualitySettings(track.getQualitySettings());
+ *   ExportResult result = OfflineExporter::run(graph, settings);
+ * @endcode
+ */
+class OfflineExporter {
+public:
+    /// Return false from the progress callback (0..1, render thread) to cancel.
+    using ProgressFn = std::function<bool(double progress)>;
+
+    static ExportResult run(const AudioGraph& graph, const ExportSettings& settings,
+                            const ProgressFn& progress = {});
+
+    /// File-system safe stem name ("Kick/Snare" -> "Kick_Snare").
+    static std::string sanitizeFileName(const std::string& name);
+};
+
+} // namespace Audio
+} // namespace Nomad
@@ -33,7 +33,19 @@ public:
         }
     }
 
+    /**
+     * @brief Render one block straight into the caller's buffer.
+     *
+     * @param output Interleaved, at least frames * channels floats
+     * @param frames At most the harness block size
+     */
+    void renderBlock(float* output, uint32_t frames) {
+        m_engine.processBlock(output, nullptr, frames, 0.0);
+    }
+
     const std::vector<float>& buffer() const { return m_buffer; }
+    uint32_t bufferFrames() const { return m_bufferFrames; }
+    uint32_t channels() const { return m_channels; }
 
 private:
     AudioEngine& m_engine;
@@ -94,6 +94,7 @@ namespace ClipFlags {
     constexpr uint32_t FadeIn      = 1 << 3;   // Has fade in
     constexpr uint32_t FadeOut     = 1 << 4;   // Has fade out
     constexpr uint32_t Selected    = 1 << 5;   // Currently selected (UI state)
+    constexpr uint32_t PreservePitch = 1 << 6; // playbackRate changes tempo only (time-stretch)
 }
 
 // =============================================================================
@@ -131,6 +132,7 @@ struct PlaylistClip {
     // === Source Offset (source sample rate) ===
     SampleIndex sourceStart = 0;               ///< Starting sample in source audio
     // Note: source end is implied as sourceStart + (length * sourceRate/projectRate)
+    SampleIndex loopLength = 0;                ///< Looped span from sourceStart (0 = to source end)
     
     // === Playback Properties ===
     float gainLinear = 1.0f;                   ///< Linear gain [0.0, 2.0]
@@ -140,6 +142,7 @@ struct PlaylistClip {
     // === Time-Stretch / SRC ===
     double playbackRate = 1.0;                 ///< Rate multiplier (1.0 = normal)
     // Note: actual SRC ratio may differ if source rate != project rate
+    float pitchSemitones = 0.0f;               ///< Pitch shift; time-stretched like PreservePitch
     
     // === Fades (in samples) ===
     SampleIndex fadeInLength = 0;              ///< Fade-in duration
@@ -37,6 +37,7 @@ struct ClipRuntimeInfo {
     
     // === Source Offset ===
     SampleIndex sourceStart = 0;                 ///< Offset into source audio
+    SampleIndex loopLength = 0;                  ///< Looped span when ClipFlags::Looping
     
     // === Playback Properties ===
     float gainLinear = 1.0f;                     ///< Volume
@@ -45,6 +46,7 @@ struct ClipRuntimeInfo {
     
     // === Time-Stretch / SRC ===
     double playbackRate = 1.0;                   ///< Rate multiplier
+    float pitchSemitones = 0.0f;                 ///< Pitch shift (time-stretch voice)
     
     // === Fades ===
     SampleIndex fadeInLength = 0;
@@ -1,5 +1,6 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #pragma once
+#include <algorithm>
 
 #include "AudioClip.h"
 #include <memory>
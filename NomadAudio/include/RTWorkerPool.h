@@ -0,0 +1,121 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Real-time safe parallel-for worker pool for the audio callback.
+ *
+ * Design principles:
+ * - Workers are spawned up front (start()/stop() are NOT RT-safe)
+ * - run() is lock-free and allocation-free: no std::function, no mutex, no condvar
+ * - Tasks are split into one contiguous range per participant (caller + workers);
+ *   participants drain their own range first and then steal from the others
+ * - Idle workers spin briefly, then sleep on a futex keyed to the dispatch generation
+ * - The calling thread always participates, so a dispatch completes even if no
+ *   worker wakes up in time (workers only ever speed things up)
+ *
+ * Each range is a single 64-bit atomic packing {generation, next, end}, so a
+ * worker that wakes late can never claim a task belonging to a newer dispatch.
+ */
+class RTWorkerPool {
+public:
+    /// Task entry point: plain function pointer + opaque context (no captures, no heap).
+    using TaskFn = void (*)(void* context, uint32_t taskIndex);
+
+    static constexpr uint32_t kMaxWorkers = 15;        // Participants = workers + caller
+    static constexpr uint32_t kMaxTasksPerRun = 0xFFFF; // Range indices are packed into 16 bits
+
+    /**
+     * @brief Per-participant counters (slot 0 = calling thread).
+     *
+     * Busy time is measured in cycle-counter ticks (see RT::readCycleCounter);
+     * divide by getDispatchCycles() for utilisation.
+     */
+    struct alignas(64) ParticipantStats {
+        std::atomic<uint64_t> tasksExecuted{0};
+        std::atomic<uint64_t> tasksStolen{0};
+        std::atomic<uint64_t> busyCycles{0};
+        std::atomic<uint64_t> wakeups{0};
+    };
+
+    RTWorkerPool() = default;
+    ~RTWorkerPool();
+
+    RTWorkerPool(const RTWorkerPool&) = delete;
+    RTWorkerPool& operator=(const RTWorkerPool&) = delete;
+
+    /**
+     * @brief Spawn worker threads (non-RT). Restarts the pool if already running.
+     * @param numWorkers Helper threads in addition to the caller (clamped to kMaxWorkers)
+     */
+    void start(uint32_t numWorkers);
+
+    /// Stop and join all workers (non-RT). Must not race with run().
+    void stop();
+
+    bool isRunning() const noexcept { return m_numWorkers > 0; }
+    uint32_t getWorkerCount() const noexcept { return m_numWorkers; }
+
+    /**
+     * @brief Execute fn(context, i) for every i in [0, taskCount) and wait for completion.
+     *
+     * RT-safe. Only one thread may call run() at a time (the audio callback).
+     * Falls back to inline execution when no workers are running or taskCount < 2.
+     */
+    void run(TaskFn fn, void* context, uint32_t taskCount) noexcept;
+
+    // Telemetry (safe to read from any thread)
+    const ParticipantStats& getStats(uint32_t participant) const noexcept { return m_stats[participant]; }
+    uint32_t getParticipantCount() const noexcept { return m_numWorkers + 1; }
+    uint64_t getDispatchCount() const noexcept { return m_dispatchCount.load(std::memory_order_relaxed); }
+    uint64_t getDispatchCycles() const noexcept { return m_dispatchCycles.load(std::memory_order_relaxed); }
+    void resetStats() noexcept;
+
+private:
+    static constexpr uint32_t kMaxParticipants = kMaxWorkers + 1;
+    static constexpr uint32_t kSpinIterations = 4096;
+
+    // Packed range: [63..32] generation, [31..16] next index, [15..0] end index
+    struct alignas(64) TaskRange {
+        std::atomic<uint64_t> state{0};
+    };
+
+    static constexpr uint64_t packRange(uint32_t generation, uint32_t next, uint32_t end) noexcept {
+        return (static_cast<uint64_t>(generation) << 32) |
+               (static_cast<uint64_t>(next & 0xFFFF) << 16) |
+               static_cast<uint64_t>(end & 0xFFFF);
+    }
+
+    void workerLoop(uint32_t participant);
+    void participate(uint32_t participant, uint32_t generation) noexcept;
+    bool claim(uint32_t rangeIndex, uint32_t generation, uint32_t& outTask) noexcept;
+
+    std::vector<std::thread> m_threads;
+    uint32_t m_numWorkers{0};
+
+    // Current dispatch (written by run() before the generation is published)
+    TaskFn m_fn{nullptr};
+    void* m_context{nullptr};
+    std::atomic<uint32_t> m_numRanges{0};
+
+    TaskRange m_ranges[kMaxParticipants];
+    ParticipantStats m_stats[kMaxParticipants];
+
+    alignas(64) std::atomic<uint32_t> m_generation{0};  // Futex word
+    alignas(64) std::atomic<uint32_t> m_pending{0};     // Tasks not yet finished
+    alignas(64) std::atomic<uint32_t> m_sleepers{0};    // Workers parked on the futex
+    std::atomic<bool> m_stop{false};
+
+    std::atomic<uint64_t> m_dispatchCount{0};
+    std::atomic<uint64_t> m_dispatchCycles{0};
+};
+
+} // namespace Audio
+} // namespace Nomad
@@ -0,0 +1,50 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Contiguous, cache-line aligned block of interleaved stereo render buffers.
+ *
+ * One allocation holds every schedule slot; each slot starts on its own cache
+ * line so parallel render jobs never share a line. Allocation happens off the
+ * RT thread; slot() is a plain pointer offset.
+ */
+class RenderArena {
+public:
+    static constexpr size_t kAlignment = 64;
+
+    RenderArena() = default;
+    /// Allocate (non-RT): slotCount buffers of frameCapacity stereo frames, zeroed.
+    RenderArena(uint32_t slotCount, uint32_t frameCapacity);
+    ~RenderArena();
+
+    RenderArena(const RenderArena&) = delete;
+    RenderArena& operator=(const RenderArena&) = delete;
+    RenderArena(RenderArena&& other) noexcept;
+    RenderArena& operator=(RenderArena&& other) noexcept;
+
+    double* slot(uint32_t index) noexcept { return m_data + static_cast<size_t>(index) * m_stride; }
+    const double* slot(uint32_t index) const noexcept { return m_data + static_cast<size_t>(index) * m_stride; }
+
+    uint32_t slotCount() const noexcept { return m_slotCount; }
+    uint32_t frameCapacity() const noexcept { return m_frameCapacity; }
+    /// Distance between slots in doubles (a multiple of one cache line).
+    size_t stride() const noexcept { return m_stride; }
+    size_t bytes() const noexcept { return m_stride * m_slotCount * sizeof(double); }
+
+private:
+    void release() noexcept;
+
+    double* m_data{nullptr};
+    size_t m_stride{0};
+    uint32_t m_slotCount{0};
+    uint32_t m_frameCapacity{0};
+};
+
+} // namespace Audio
+} // namespace Nomad
@@ -1,17 +1,29 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #pragma once
 
+#include "SampleRateConverter.h"
+#include "StreamingSource.h"
+
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Nomad {
 namespace Audio {
 
+class WaveformCache;
+
 /**
  * @brief Unique identity for a sample on disk
  *
@@ -41,40 +53,224 @@ struct SampleKeyHasher {
     }
 };
 
+/**
+ * @brief Identity of a pre-resampled copy: source sample, target rate and quality.
+ */
+struct ResampledKey {
+    SampleKey source;
+    uint32_t targetRate{0};
+    SRCQuality quality{SRCQuality::Sinc64};
+
+    bool operator==(const ResampledKey& other) const noexcept {
+        return source == other.source && targetRate == other.targetRate && quality == other.quality;
+    }
+};
+
+struct ResampledKeyHasher {
+    size_t operator()(const ResampledKey& key) const noexcept {
+        size_t h = SampleKeyHasher{}(key.source);
+        h ^= (static_cast<size_t>(key.targetRate) << 4 | static_cast<size_t>(key.quality)) +
+             0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+/**
+ * @brief How a decoded sample is held in memory.
+ */
+enum class SampleStorage : uint8_t {
+    Float32,    ///< 32-bit float in AudioBuffer::data
+    Int16,      ///< 16-bit integer in AudioBuffer::packed (half the memory)
+    Int24,      ///< 24-bit integer in AudioBuffer::packed (three quarters)
+    Native,     ///< Policy only: the smallest of the above that holds the source exactly
+};
+
 /**
  * @brief Shared audio buffer representation
  *
  * Holds decoded PCM float samples and metadata. Lifetime is managed by shared_ptr
- * returned from SamplePool. When all references are dropped, the buffer becomes
- * eligible for garbage collection.
+ * returned from SamplePool. The pool keeps its own reference while the buffer is
+ * cached, so a released buffer stays available until it is evicted.
  */
 struct AudioBuffer {
     std::vector<float> data;          // Interleaved float samples [-1.0, 1.0]
     uint32_t channels{0};             // Number of channels (e.g., 1=mono, 2=stereo)
     uint32_t sampleRate{0};           // Sample rate in Hz (e.g., 44100)
     uint64_t numFrames{0};            // Total frames = data.size() / channels
-    bool isStreaming{false};          // True if backed by streaming source
+    bool isStreaming{false};          // True if backed by streaming source (data stays empty)
 
-    // Future extension point for streaming sources
-    std::shared_ptr<void> source;
+    // Packed integer samples instead of data (interleaved, little-endian, data stays empty).
+    // Read through SamplePool::readFrames() or the kernels' unpack().
+    SampleStorage storage{SampleStorage::Float32};
+    std::vector<uint8_t> packed;
+    uint32_t sourceBitDepth{0};       // Integer PCM bits in the file (0 = float or unknown)
+
+    bool isPacked() const noexcept { return storage == SampleStorage::Int16 || storage == SampleStorage::Int24; }
+    /// Bytes per packed sample (2 or 3; 0 for float).
+    uint32_t packedSampleBytes() const noexcept {
+        return storage == SampleStorage::Int16 ? 2 : (storage == SampleStorage::Int24 ? 3 : 0);
+    }
+
+    // Disk-backed samples for a streaming buffer (stereo, read on the audio thread)
+    std::shared_ptr<StreamingSource> stream;
 
     // Cache management (automatically updated by SamplePool)
     std::atomic<bool> ready{false};              // true when data is valid
-    std::atomic<uint64_t> lastAccessTick{0};     // LRU timestamp
+    std::atomic<uint64_t> lastAccessTick{0};     // Last cache access (diagnostics)
     std::string sourcePath;                      // For debugging/reloading
+
+    // Display peaks, shared by every clip of this sample (see Track::getWaveformCache).
+    // Published once with std::atomic_store; read with std::atomic_load.
+    std::shared_ptr<const WaveformCache> waveform;
+    std::atomic<bool> waveformRequested{false};  // A peak build has been queued
+};
+
+struct SampleLoad;
+
+/**
+ * @brief What an asynchronous loader sees: report progress, notice cancellation.
+ */
+class SampleLoadContext {
+public:
+    /// Fraction decoded so far (0..1); call as often as convenient.
+    void setProgress(float fraction) noexcept {
+        m_progress.store(fraction < 0.0f ? 0.0f : (fraction > 1.0f ? 1.0f : fraction), std::memory_order_relaxed);
+    }
+    float progress() const noexcept { return m_progress.load(std::memory_order_relaxed); }
+
+    /// Every requester cancelled: return false as soon as possible (the result is discarded).
+    bool cancelled() const noexcept { return m_cancelled.load(std::memory_order_acquire); }
+
+private:
+    friend class SamplePool;
+    std::atomic<float> m_progress{0.0f};
+    std::atomic<bool> m_cancelled{false};
+};
+
+/**
+ * @brief One requester's view of SamplePool::acquireAsync().
+ *
+ * Move-only. Dropping a handle does not cancel the load, so prefetching can
+ * be fire-and-forget; cancel() withdraws this requester, and the decode stops
+ * once every requester of the same sample has withdrawn.
+ */
+class SampleLoadHandle {
+public:
+    SampleLoadHandle() = default;
+    SampleLoadHandle(SampleLoadHandle&&) noexcept = default;
+    SampleLoadHandle& operator=(SampleLoadHandle&&) noexcept = default;
+    SampleLoadHandle(const SampleLoadHandle&) = delete;
+    SampleLoadHandle& operator=(const SampleLoadHandle&) = delete;
+
+    bool valid() const noexcept { return m_future.valid(); }
+    /// Finished: loaded, failed or cancelled.
+    bool isReady() const;
+    /// Fraction decoded (1 once ready).
+    float progress() const noexcept;
+    /// Block until finished; nullptr on failure or cancellation.
+    std::shared_ptr<AudioBuffer> get() const;
+    const std::shared_future<std::shared_ptr<AudioBuffer>>& future() const noexcept { return m_future; }
+
+    /**
+     * @brief Withdraw this request (its completion callback will not run).
+     *
+     * If the callback is running right now this waits for it to return, so the
+     * requester may free whatever the callback touches afterwards.
+     */
+    void cancel();
+    bool isCancelled() const noexcept { return m_cancelled; }
+
+private:
+    friend class SamplePool;
+    std::shared_ptr<SampleLoad> m_load;          // null for cache hits and immediate failures
+    std::shared_future<std::shared_ptr<AudioBuffer>> m_future;
+    uint64_t m_requester{0};
+    bool m_cancelled{false};
+};
+
+/**
+ * @brief Aggregate state of the decode pipeline (e.g. a project-load progress bar).
+ *
+ * A batch starts when a load is queued while none is in flight, so fraction
+ * covers everything requested since the pool was last idle.
+ */
+struct SampleLoadProgress {
+    uint32_t queued{0};         ///< Waiting for a decode thread
+    uint32_t active{0};         ///< Decoding now
+    uint32_t batchTotal{0};     ///< Loads in the current batch
+    uint32_t batchDone{0};      ///< ...of which finished
+    float fraction{1.0f};       ///< Batch progress, counting partial decodes
+    uint64_t completed{0};      ///< Loads that produced a buffer (lifetime)
+    uint64_t failed{0};
+    uint64_t cancelled{0};
+    uint64_t joined{0};         ///< Requests that joined a load already in flight
+};
+
+/**
+ * @brief Cache counters and byte totals (SamplePool::getStats()).
+ *
+ * Bytes cover the buffers the pool keeps alive: decoded samples and
+ * resampled copies, pinned or not. A buffer evicted while clips still hold it
+ * lives on outside the budget until they drop it.
+ */
+struct SamplePoolStats {
+    uint64_t hits{0};             ///< acquire()/acquireAsync() served from the cache
+    uint64_t misses{0};           ///< ...that had to load (or join a load)
+    uint64_t copyHits{0};         ///< acquireResampled() returned a copy
+    uint64_t copyMisses{0};
+    uint64_t evictions{0};
+    uint64_t evictedBytes{0};
+    size_t bytes{0};              ///< Total held (getMemoryUsage())
+    size_t pinnedBytes{0};        ///< ...of which pinned, i.e. exempt from eviction
+    size_t resampledBytes{0};     ///< ...of which resampled copies
+    size_t budget{0};             ///< 0 = unlimited
+    uint32_t entries{0};          ///< Buffers held
+    uint32_t pinnedEntries{0};
+};
+
+/**
+ * @brief A set of buffers pinned in SamplePool (e.g. everything the live graph plays).
+ *
+ * Pinned buffers are never evicted. assign() replaces the set, pinning the new
+ * buffers before releasing the old ones so buffers in both never become
+ * evictable in between. Buffers the pool does not own (streams, track-owned
+ * copies) are ignored. Move-only; destruction releases the pins.
+ */
+class SamplePinSet {
+public:
+    SamplePinSet() = default;
+    ~SamplePinSet() { clear(); }
+    SamplePinSet(SamplePinSet&& other) noexcept : m_pinned(std::move(other.m_pinned)) { other.m_pinned.clear(); }
+    SamplePinSet& operator=(SamplePinSet&& other) noexcept;
+    SamplePinSet(const SamplePinSet&) = delete;
+    SamplePinSet& operator=(const SamplePinSet&) = delete;
+
+    void assign(std::vector<const AudioBuffer*> buffers);
+    void clear();
+    /// Buffers actually pinned (those the pool owns).
+    size_t size() const noexcept { return m_pinned.size(); }
+
+private:
+    std::vector<const AudioBuffer*> m_pinned;   // Sorted; kept alive by the pins themselves
 };
 
 /**
  * @brief Thread-safe LRU cache for decoded audio samples
  *
- * Deduplicates audio buffers by file path, automatically loads on cache miss,
- * and evicts least-recently-used entries when memory budget is exceeded.
- * Lifetime is managed through standard shared_ptr semantics.
+ * Deduplicates audio buffers by file path and automatically loads on cache
+ * miss. The pool holds a reference to every cached buffer, so released samples
+ * stay warm for the next clip that wants them; when the memory budget is
+ * exceeded the least recently used unpinned buffers are evicted. Recency is an
+ * intrusive list (touch, insert and evict are O(1)) and byte totals are kept
+ * incrementally. A decoded sample evicted while clips still use it remains
+ * deduplicated until the last of them lets go.
  */
 class SamplePool {
 public:
     static SamplePool& getInstance();
 
+    static constexpr size_t kDefaultMemoryBudget = size_t(1) << 30;   // 1 GiB
+
     /**
      * @brief Acquire a buffer for the given path
      * 
@@ -88,28 +284,163 @@ public:
     std::shared_ptr<AudioBuffer> acquire(const std::string& path,
                                          const std::function<bool(AudioBuffer&)>& loader = {});
 
+    /// Loader for acquireAsync(): fills the buffer like acquire()'s, may report progress and stop early.
+    using AsyncLoader = std::function<bool(AudioBuffer&, SampleLoadContext&)>;
+    /// Runs when an asynchronous load finishes (on the decode thread; inline for cache hits).
+    using LoadCallback = std::function<void(const std::shared_ptr<AudioBuffer>&)>;
+
+    /**
+     * @brief Start loading a sample on the decode threads (non-blocking).
+     *
+     * A cached sample completes at once. A sample already being loaded (by
+     * either acquire call) is joined rather than decoded twice; otherwise the
+     * loader is queued for the first free decode thread. acquire() on a key
+     * that is still queued runs the load on the caller's thread instead of
+     * waiting its turn.
+     *
+     * @param onComplete Called with the buffer (nullptr on failure) unless this request was cancelled
+     */
+    SampleLoadHandle acquireAsync(const std::string& path, AsyncLoader loader, LoadCallback onComplete = {});
+
+    /// Decode threads (0 = one less than the hardware threads, at least one). Applies to new threads.
+    void setDecodeThreadCount(uint32_t threads);
+    uint32_t getDecodeThreadCount() const;
+
+    SampleLoadProgress getLoadProgress() const;
+
+    /// Block until no load is queued or running (tests, project load completion).
+    void waitForLoads();
+
+    /**
+     * @brief Streaming buffer for a file too large to decode into memory (non-RT).
+     *
+     * Uncompressed PCM WAV/RF64/AIFF is memory-mapped; anything else miniaudio
+     * can open is decoded into a per-clip read-ahead ring. Every call makes a
+     * new source, because read-ahead follows one clip's playhead; the pages of a
+     * mapped file are still shared through the OS cache. Streaming buffers hold
+     * no samples and don't count against the memory budget.
+     *
+     * @return Buffer with isStreaming set, or nullptr if the file can't be streamed
+     */
+    std::shared_ptr<AudioBuffer> acquireStreaming(const std::string& path);
+
+    /**
+     * @brief Decoded copy of a forward-only streaming source (non-RT, decodes on a miss).
+     *
+     * For clips that read a stream out of order (reversed, looped or
+     * time-stretched), which a read-ahead ring can't serve
+     * (StreamingSource::randomAccess()). Cached like any decoded sample under
+     * the source's path.
+     *
+     * @return Stereo buffer at the source's rate, or nullptr if it can't be decoded again
+     */
+    std::shared_ptr<AudioBuffer> acquireDecoded(const StreamingSource& source);
+
+    /**
+     * @brief acquireDecoded() on the decode threads (non-blocking).
+     *
+     * Completes at once if the path is cached. Unlike acquireDecoded() the
+     * result isn't checked: a buffer another loader cached for the path may
+     * not be stereo at the source's rate.
+     */
+    SampleLoadHandle acquireDecodedAsync(const std::shared_ptr<StreamingSource>& source,
+                                         LoadCallback onComplete = {});
+
     /**
      * @brief Perform garbage collection
-     * 
-     * Removes expired buffers and evicts LRU entries until memory budget is met.
-     * Called automatically after each acquire(); manual calls are optional.
+     *
+     * Forgets evicted samples that nothing uses any more and evicts LRU entries
+     * until the memory budget is met. Eviction also runs whenever a buffer
+     * enters the cache; manual calls are optional.
      */
     void garbageCollect();
 
-    // Memory budget management
+    /// Evict every unpinned buffer (e.g. on a low-memory warning).
+    void purge();
+
+    /// Bytes the pool may hold before evicting (0 = unlimited). Pinned buffers count but are never evicted.
     void setMemoryBudget(size_t bytes);
     size_t getMemoryBudget() const { return m_memoryBudget; }
     
     /**
      * @brief Get current total memory usage (bytes)
      * 
-     * Thread-safe read of memory used by all managed buffers (cached + active).
+     * Thread-safe read of memory held by the pool (pinned and cached buffers).
      */
     size_t getMemoryUsage() const { return m_memoryCurrent.load(); }
 
+    SamplePoolStats getStats() const;
+
+    // =========================================================================
+    // Pre-resampled clip cache
+    // =========================================================================
+
+    /**
+     * @brief Copy of a decoded stereo sample resampled to targetRate (non-RT, never blocks).
+     *
+     * Returns the cached copy when it is ready. Otherwise queues one background
+     * render for the key and returns nullptr; the caller keeps playing the
+     * original through the engine's real-time resampler and picks the copy up
+     * on a later graph build (see consumeResampledReady()).
+     *
+     * Copies are owned by the pool, count against the memory budget and are
+     * evicted least-recently-used like decoded samples. Returns nullptr when the
+     * cache is disabled, the source is not a stereo file-backed buffer, it is
+     * already at targetRate, or the copy could never fit in the budget.
+     */
+    std::shared_ptr<const AudioBuffer> acquireResampled(const std::shared_ptr<const AudioBuffer>& source,
+                                                        uint32_t targetRate);
+
+    void setResampleCacheEnabled(bool enabled) { m_resampleEnabled.store(enabled); }
+    bool isResampleCacheEnabled() const { return m_resampleEnabled.load(); }
+    /// Quality of new copies (existing copies are keyed by theirs).
+    void setResampleQuality(SRCQuality quality) { m_resampleQuality.store(quality); }
+    SRCQuality getResampleQuality() const { return m_resampleQuality.load(); }
+
+    /// True once after background copies finished; rebuild the graph to use them.
+    bool consumeResampledReady() { return m_resampledReady.exchange(false); }
+
+    /// Block until every queued resample job has finished (tests, offline rendering).
+    void waitForResampleJobs();
+
+    // =========================================================================
+    // Sample storage
+    // =========================================================================
+
+    /**
+     * @brief Storage for samples decoded from now on (Float32 by default).
+     *
+     * Packed buffers render through SIMD conversion in the clip loop, bit for
+     * bit like float when the source fits (Native); forcing Int16/Int24 on
+     * wider material quantises it. Buffers already in the pool keep theirs.
+     */
+    void setSampleStorage(SampleStorage storage);
+    SampleStorage getSampleStorage() const;
+
+    /// Storage for one file, overriding the pool setting (applies when it is next decoded).
+    void setSampleStorage(const std::string& path, SampleStorage storage);
+
+    /**
+     * @brief Convert a float buffer's data to packed storage (non-RT).
+     *
+     * Native picks Int16 for 8/16-bit sources and Int24 for 24-bit ones and
+     * leaves anything else as float. Samples are rounded and clipped to range.
+     * @return true if the buffer is now packed
+     */
+    static bool pack(AudioBuffer& buffer, SampleStorage storage);
+
+    /// Interleaved float frames [start, start + frames) of any storage; frames past the end read as zero (RT-safe).
+    static void readFrames(const AudioBuffer& buffer, uint64_t start, uint32_t frames, float* dst) noexcept;
+
+    /// The whole buffer as interleaved float (a copy for packed buffers).
+    static std::vector<float> toFloat(const AudioBuffer& buffer);
+
+    /// Bytes held by resampled copies (included in getMemoryUsage()).
+    size_t getResampledMemoryUsage() const { return m_resampledBytes.load(); }
+
 private:
     SamplePool() = default;
-    ~SamplePool() = default;
+    ~SamplePool();
     SamplePool(const SamplePool&) = delete;
     SamplePool& operator=(const SamplePool&) = delete;
 
@@ -119,18 +450,106 @@ private:
     // Memory calculation
     static size_t calculateBufferBytes(const AudioBuffer& buffer);
 
+    /**
+     * @brief A cached buffer: decoded sample or resampled copy.
+     *
+     * Decoded samples use key.targetRate 0 (no copy has rate 0). An evicted
+     * sample keeps its entry, with only the weak reference, while clips still
+     * use it, so a later acquire() finds it instead of decoding it again.
+     */
+    struct CacheEntry {
+        ResampledKey key;
+        std::shared_ptr<AudioBuffer> buffer;      // The pool's reference; null once evicted
+        std::weak_ptr<AudioBuffer> weak;
+        size_t bytes{0};
+        uint32_t pins{0};
+        const AudioBuffer* address{nullptr};      // Index key in m_entryByBuffer
+        std::list<CacheEntry*>::iterator lru;     // Valid while held and unpinned
+    };
+
     // Internal helpers (require m_mutex to be held)
-    void updateMemoryUsageLocked();
     void garbageCollectLocked();
+    std::shared_ptr<AudioBuffer> lookupSampleLocked(const SampleKey& key);
+    void holdLocked(CacheEntry& entry, std::shared_ptr<AudioBuffer> buffer);
+    void touchLocked(CacheEntry& entry);
+    void evictLocked(CacheEntry& entry);
+    void eraseLocked(CacheEntry& entry);
+    void enforceBudgetLocked();
+
+    // Pins (SamplePinSet)
+    friend class SamplePinSet;
+    std::vector<const AudioBuffer*> pin(const std::vector<const AudioBuffer*>& buffers);
+    void unpin(const std::vector<const AudioBuffer*>& buffers);
+
+    // Loads (sync and async share the in-flight table)
+    friend class SampleLoadHandle;
+    std::shared_ptr<SampleLoad> registerLoadLocked(const SampleKey& key, const std::string& path, AsyncLoader loader);
+    void runLoad(const std::shared_ptr<SampleLoad>& load);
+    void cancelRequest(SampleLoad& load, uint64_t requester);
+    void startDecodeThreadsLocked();
+    void decodeWorkerLoop();
+
+    // Background resampling
+    struct ResampleJob {
+        ResampledKey key;
+        std::shared_ptr<const AudioBuffer> source;
+    };
+    void resampleWorkerLoop();
+    static std::shared_ptr<AudioBuffer> renderResampled(const AudioBuffer& source, uint32_t targetRate,
+                                                        SRCQuality quality);
+    static uint64_t resampledFrameCount(uint64_t frames, uint32_t sourceRate, uint32_t targetRate);
 
     // Data members
     mutable std::mutex m_mutex;
-    std::unordered_map<SampleKey, std::weak_ptr<AudioBuffer>, SampleKeyHasher> m_samples;
-    
-    size_t m_memoryBudget{0};                         // 0 = unlimited
-    std::atomic<size_t> m_memoryCurrent{0};          // Total bytes of all buffers
-    
-    std::atomic_uint64_t m_accessCounter{0};         // Monotonic LRU ticker
+    std::unordered_map<SampleKey, CacheEntry, SampleKeyHasher> m_samples;
+    std::unordered_map<const AudioBuffer*, CacheEntry*> m_entryByBuffer;   // For pins
+    std::list<CacheEntry*> m_lru;                    // Held, unpinned; most recent first
+
+    size_t m_memoryBudget{kDefaultMemoryBudget};     // 0 = unlimited
+    std::atomic<size_t> m_memoryCurrent{0};          // Bytes held by the pool
+    size_t m_pinnedBytes{0};
+    uint32_t m_heldEntries{0};
+    uint32_t m_pinnedEntries{0};
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+    uint64_t m_copyHits{0};
+    uint64_t m_copyMisses{0};
+    uint64_t m_evictions{0};
+    uint64_t m_evictedBytes{0};
+
+    std::atomic_uint64_t m_accessCounter{0};         // Monotonic access ticker
+
+    // Decode pipeline (guarded by m_mutex)
+    std::unordered_map<SampleKey, std::shared_ptr<SampleLoad>, SampleKeyHasher> m_loading;
+    std::deque<std::shared_ptr<SampleLoad>> m_decodeQueue;
+    std::condition_variable m_decodeCv;              // Queue changes and load completions
+    std::vector<std::thread> m_decodeThreads;
+    uint32_t m_decodeThreadCount{0};                 // 0 = automatic
+    bool m_decodeStop{false};
+    uint64_t m_nextRequester{1};
+    uint32_t m_activeLoads{0};
+    uint64_t m_batchId{0};
+    uint32_t m_batchTotal{0};
+    uint32_t m_batchDone{0};
+    uint64_t m_loadsCompleted{0};
+    uint64_t m_loadsFailed{0};
+    uint64_t m_loadsCancelled{0};
+    uint64_t m_loadsJoined{0};
+
+    // Resampled copies are owned here (nothing else keeps them alive between graph builds).
+    std::unordered_map<ResampledKey, CacheEntry, ResampledKeyHasher> m_resampled;
+    std::unordered_set<ResampledKey, ResampledKeyHasher> m_resamplePending;
+    std::deque<ResampleJob> m_resampleQueue;
+    std::condition_variable m_resampleCv;
+    std::thread m_resampleThread;
+    bool m_resampleStop{false};
+    std::atomic<bool> m_resampleEnabled{false};
+    std::atomic<SRCQuality> m_resampleQuality{SRCQuality::Sinc64};
+    std::atomic<bool> m_resampledReady{false};
+    std::atomic<size_t> m_resampledBytes{0};
+
+    std::atomic<SampleStorage> m_storage{SampleStorage::Float32};
+    std::unordered_map<std::string, SampleStorage> m_storageByFile;   // Key filePath; guarded by m_mutex
 };
 
 } // namespace Audio
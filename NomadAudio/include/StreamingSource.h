@@ -0,0 +1,324 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Clip audio served from disk instead of a decoded buffer.
+ *
+ * A streaming AudioBuffer (AudioBuffer::isStreaming) carries one of these in
+ * place of its samples. The audio thread pulls interleaved stereo frames with
+ * read(); the shared StreamIOPool keeps data ahead of the last read (and of
+ * any cue()) resident so reads find it. Frames the source does not have yet
+ * read as silence and count as an underrun (a missed I/O deadline).
+ *
+ * One source serves one clip: read positions and read-ahead are per source.
+ */
+class StreamingSource {
+public:
+    virtual ~StreamingSource() = default;
+
+    uint32_t sampleRate() const noexcept { return m_sampleRate; }
+    uint64_t numFrames() const noexcept { return m_numFrames; }
+    uint32_t sourceChannels() const noexcept { return m_sourceChannels; }
+    const std::string& path() const noexcept { return m_path; }
+
+    /**
+     * @brief Interleaved stereo frames [start, start + frames) (RT-safe).
+     *
+     * Frames past the end of the file are silence. Frames the read-ahead has
+     * not loaded are silence too, and make this return false.
+     */
+    virtual bool read(uint64_t start, uint32_t frames, float* dst) noexcept = 0;
+
+    /// Whether reads may go anywhere in any order. A forward-only source misses every read behind its last one.
+    virtual bool randomAccess() const noexcept { return true; }
+
+    /// Receives one slice of decodeSlices(); false stops the decode.
+    using SliceConsumer = std::function<bool(const float* stereo, uint32_t frames)>;
+
+    /**
+     * @brief Non-RT: every frame front to back as interleaved stereo, a slice at a time.
+     *
+     * For work that needs the whole file off the playback path (decoded copies,
+     * display peaks). Reads with its own decoder or file position, so playback
+     * from this source is undisturbed. False if the source can't be read again,
+     * or consume stopped it.
+     */
+    virtual bool decodeSlices(const SliceConsumer& consume) const {
+        (void)consume;
+        return false;
+    }
+
+    /**
+     * @brief Non-RT: every frame as interleaved stereo, for clips that read out of order.
+     *
+     * Only forward-only sources need it (see randomAccess()). Frames past a
+     * decoder that runs dry early are silence. False as for decodeSlices().
+     */
+    bool decodeAll(std::vector<float>& out) const;
+
+    /**
+     * @brief The playhead will need this frame in secondsUntilNeeded (locate, upcoming clip). RT-safe.
+     *
+     * The lead time orders the load against other sources' deadlines; 0 means now.
+     */
+    virtual void cue(uint64_t frame, double secondsUntilNeeded) noexcept = 0;
+
+    /// I/O thread: whether service() has work (data missing ahead of the playhead).
+    virtual bool needsService() const noexcept = 0;
+    /// I/O thread: seconds of audio loaded ahead of the playhead (0 after a locate).
+    virtual double bufferedSeconds() const noexcept = 0;
+    /// I/O thread: load one chunk ahead of the playhead. Returns true if more is wanted.
+    virtual bool service() = 0;
+
+    /**
+     * @brief I/O thread: seconds until the playhead reaches data that isn't loaded.
+     *
+     * What's buffered while playing; the cue's lead time (less what has
+     * elapsed) after a cue; 0 when a read has already missed.
+     */
+    double deadlineSeconds(int64_t nowNs) const noexcept;
+
+    /// Reads that found no data (this clip).
+    uint64_t underruns() const noexcept { return m_underruns.load(std::memory_order_relaxed); }
+    /// Bytes service() has made resident: file bytes for mapped PCM, decoded samples for rings.
+    uint64_t bytesLoaded() const noexcept { return m_bytesLoaded.load(std::memory_order_relaxed); }
+
+    void setReadAheadFrames(uint64_t frames) noexcept { m_readAhead.store(frames, std::memory_order_relaxed); }
+    uint64_t readAheadFrames() const noexcept { return m_readAhead.load(std::memory_order_relaxed); }
+
+protected:
+    /// A read found its frames missing: due now (RT-safe).
+    void countUnderrun() noexcept;
+    /// Record when the frame a cue() asked for is needed (RT-safe).
+    void setDue(double secondsUntilNeeded) noexcept;
+    void countBytesLoaded(uint64_t bytes) noexcept { m_bytesLoaded.fetch_add(bytes, std::memory_order_relaxed); }
+    /// Ask the I/O pool to service this source (RT-safe, coalesced until serviced).
+    void requestService() noexcept;
+    friend class StreamIOPool;
+
+    std::string m_path;
+    uint32_t m_sampleRate{0};
+    uint64_t m_numFrames{0};
+    uint32_t m_sourceChannels{0};
+    std::atomic<uint64_t> m_readAhead{0};
+    std::atomic<uint64_t> m_underruns{0};
+    std::atomic<uint64_t> m_bytesLoaded{0};
+    std::atomic<int64_t> m_dueNs{0};         // steady_clock time the cued/missed frame is needed
+    std::atomic<bool> m_serviceRequested{false};
+    std::atomic<bool> m_servicing{false};   // One I/O thread at a time
+};
+
+/**
+ * @brief PCM WAV / RF64 / AIFF / AIFC served straight from a memory-mapped file.
+ *
+ * Samples are converted to float stereo on every read (16/24/32-bit integer
+ * either endianness, 32-bit float; mono is duplicated). Nothing is decoded up
+ * front, so hours of material cost address space, not RAM. The I/O pool reads
+ * the bytes ahead of the playhead with positional reads (pread / overlapped
+ * ReadFile) and then touches the mapped pages so the audio thread doesn't fault
+ * them in; a read outside that window never touches the mapping, reads as
+ * silence and counts as an underrun.
+ */
+class MappedPcmSource : public StreamingSource {
+public:
+    /// nullptr if the file is not uncompressed PCM in 1 or 2 channels, or can't be mapped.
+    static std::shared_ptr<MappedPcmSource> open(const std::string& path);
+    ~MappedPcmSource() override;
+
+    bool read(uint64_t start, uint32_t frames, float* dst) noexcept override;
+    void cue(uint64_t frame, double secondsUntilNeeded) noexcept override;
+    bool needsService() const noexcept override;
+    double bufferedSeconds() const noexcept override;
+    bool service() override;
+    bool decodeSlices(const SliceConsumer& consume) const override;
+
+    enum class Encoding { Int16, Int24, Int32, Float32 };
+    Encoding encoding() const noexcept { return m_encoding; }
+    bool bigEndian() const noexcept { return m_bigEndian; }
+
+private:
+    MappedPcmSource() = default;
+    bool map();
+    void unmap();
+    void convert(const uint8_t* src, uint32_t frames, float* dst) const noexcept;
+
+    Encoding m_encoding{Encoding::Int16};
+    bool m_bigEndian{false};
+    uint32_t m_bytesPerFrame{0};
+
+    // Mapping (whole file; m_data points at the first sample frame)
+    void* m_mapping{nullptr};
+    uint64_t m_mappingBytes{0};
+    void* m_fileHandle{nullptr};      // Windows: file + mapping handles
+    void* m_mapHandle{nullptr};
+    int m_fd{-1};                     // POSIX: kept open for positional reads
+    bool m_readFailed{false};         // Logged once; service() is never concurrent
+    const uint8_t* m_data{nullptr};
+
+    // Resident window [m_windowStart, m_windowEnd) in frames, advanced by service()
+    std::atomic<uint64_t> m_playhead{0};
+    std::atomic<uint64_t> m_windowStart{0};
+    std::atomic<uint64_t> m_windowEnd{0};
+};
+
+/**
+ * @brief Sequential decoder feeding a RingStreamSource (compressed formats).
+ *
+ * Produces interleaved stereo float. Called only from I/O threads.
+ */
+class StreamDecoder {
+public:
+    virtual ~StreamDecoder() = default;
+    virtual uint32_t sampleRate() const = 0;
+    virtual uint32_t sourceChannels() const = 0;
+    virtual uint64_t numFrames() const = 0;
+    virtual bool seek(uint64_t frame) = 0;
+    /// Decode up to frames stereo frames at the current position; returns frames written.
+    virtual uint32_t read(float* dst, uint32_t frames) = 0;
+    /// A second decoder over the same file, or nullptr if it can't be reopened. Any thread.
+    virtual std::unique_ptr<StreamDecoder> reopen() const { return nullptr; }
+};
+
+/**
+ * @brief Compressed clip decoded into a per-clip lock-free read-ahead ring.
+ *
+ * Single producer (the I/O thread servicing it), single consumer (the audio
+ * thread). The ring holds a contiguous run of source frames; the producer
+ * decodes ahead of the consumer's last read and never overwrites frames at or
+ * after it. A read outside the run (locate, loop jump) is silence, counts as an
+ * underrun and makes the producer seek there; cue() does the same ahead of time.
+ * Reading backward misses every time, so reversed, looped and time-stretched
+ * clips play a decoded copy instead (decodeAll()).
+ */
+class RingStreamSource : public StreamingSource {
+public:
+    RingStreamSource(std::unique_ptr<StreamDecoder> decoder, const std::string& path,
+                     uint64_t capacityFrames = 0);
+
+    bool read(uint64_t start, uint32_t frames, float* dst) noexcept override;
+    void cue(uint64_t frame, double secondsUntilNeeded) noexcept override;
+    bool needsService() const noexcept override;
+    double bufferedSeconds() const noexcept override;
+    bool service() override;
+    bool randomAccess() const noexcept override { return false; }
+    bool decodeSlices(const SliceConsumer& consume) const override;
+
+    uint64_t capacityFrames() const noexcept { return m_capacity; }
+
+private:
+    static constexpr uint64_t kNoSeek = ~0ull;
+    static constexpr uint32_t kDecodeChunkFrames = 4096;
+
+    bool inRun(uint64_t start, uint64_t end) const noexcept;
+    /// One past the last frame the read-ahead should hold (never more than a ring ahead).
+    uint64_t wantedEnd(uint64_t consumed) const noexcept;
+
+    std::unique_ptr<StreamDecoder> m_decoder;
+    std::vector<float> m_ring;                   // m_capacity stereo frames
+    uint64_t m_capacity{0};
+
+    std::atomic<uint32_t> m_epoch{0};            // Odd while the producer repositions
+    std::atomic<uint64_t> m_runStart{0};         // First frame still in the ring
+    std::atomic<uint64_t> m_runEnd{0};           // One past the last decoded frame
+    std::atomic<uint64_t> m_consumed{0};         // Consumer's low mark: never overwritten
+    std::atomic<uint64_t> m_seekRequest{0};      // kNoSeek when none (starts at frame 0)
+    std::vector<float> m_scratch;                // Producer: decoder output across the wrap
+};
+
+/**
+ * @brief Counters for the shared streaming I/O service.
+ */
+struct StreamIOStats {
+    uint32_t queueDepth{0};        ///< Sources waiting for service at the latest pass
+    uint32_t peakQueueDepth{0};    ///< Deepest queue seen
+    uint64_t requests{0};          ///< service() calls (one chunk each)
+    uint64_t bytesLoaded{0};       ///< Sum of StreamingSource::bytesLoaded() over serviced chunks
+    double bytesPerSecond{0.0};    ///< Load rate over roughly the last half second
+    uint64_t deadlineMisses{0};    ///< Reads that reached the playhead before their data
+    double tightestDeadline{0.0};  ///< Seconds to the most urgent deadline at the latest pass
+};
+
+/**
+ * @brief Shared disk I/O scheduler that keeps every streaming source's read-ahead full.
+ *
+ * A small fixed set of threads (not one per clip). Each pass batches the
+ * registered sources that need data and services them earliest deadline first
+ * (the time until the playhead reaches data that isn't loaded, see
+ * StreamingSource::deadlineSeconds), one chunk at a time, so a starving clip
+ * is never stuck behind a long read for a comfortable one. Threads sleep on a
+ * futex word until a source asks for service; the audio thread can do that
+ * without blocking.
+ */
+class StreamIOPool {
+public:
+    static StreamIOPool& getInstance();
+
+    /// Register a source; the pool holds it weakly. Starts the threads on first use.
+    void add(const std::shared_ptr<StreamingSource>& source);
+    /// Wake the threads (RT-safe).
+    void notify() noexcept;
+    /// Service every source until none needs more (tests, offline rendering).
+    void serviceAllNow();
+    /// Service one source on the calling thread until it needs no more (offline rendering).
+    void serviceNow(StreamingSource& source);
+    /// Run one scheduling pass on the calling thread; false if nothing needed service.
+    bool serviceOnce() { return servicePass(); }
+
+    void setThreadCount(uint32_t threads);
+    uint32_t threadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+    size_t sourceCount() const;
+
+    StreamIOStats stats() const;
+    /// Called by sources when a read misses (RT-safe).
+    void countDeadlineMiss() noexcept { m_deadlineMisses.fetch_add(1, std::memory_order_relaxed); }
+
+    ~StreamIOPool();
+
+private:
+    StreamIOPool() = default;
+    StreamIOPool(const StreamIOPool&) = delete;
+    StreamIOPool& operator=(const StreamIOPool&) = delete;
+
+    void start(uint32_t threads);
+    void stop();
+    void threadLoop();
+    /// One pass over the sources that need service; false if none did.
+    bool servicePass();
+    /// service() one chunk of a source this thread owns, counting what it loaded.
+    bool serviceSource(StreamingSource& source);
+
+    mutable std::mutex m_mutex;                  // Guards m_sources and the thread set
+    std::vector<std::weak_ptr<StreamingSource>> m_sources;
+    std::vector<std::thread> m_threads;
+    std::atomic<uint32_t> m_wake{0};
+    std::atomic<bool> m_stop{false};
+    uint32_t m_defaultThreads{2};
+
+    // Statistics (relaxed; read by stats())
+    std::atomic<uint32_t> m_queueDepth{0};
+    std::atomic<uint32_t> m_peakQueueDepth{0};
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_bytesLoaded{0};
+    std::atomic<uint64_t> m_deadlineMisses{0};
+    std::atomic<double> m_tightestDeadline{0.0};
+    // Rate window: bytes since m_rateStartNs, folded into m_bytesPerSecond every half second.
+    std::mutex m_rateMutex;
+    std::atomic<int64_t> m_rateStartNs{0};
+    std::atomic<uint64_t> m_rateStartBytes{0};
+    std::atomic<double> m_bytesPerSecond{0.0};
+};
+
+} // namespace Audio
+} // namespace Nomad
@@ -0,0 +1,126 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Nomad {
+namespace Audio {
+
+/**
+ * @brief Time-stretch quality tiers.
+ */
+enum class StretchQuality {
+    Realtime,       // 1024-frame grains, coarse-to-fine search (live playback)
+    HighQuality     // 2048-frame grains, exhaustive search (offline export)
+};
+
+/**
+ * @brief One clip's WSOLA time-stretch / pitch-shift voice.
+ *
+ * Output is overlap-added from Hann-windowed grains on a fixed output grid
+ * (50% overlap). Each grain is read from the source around its nominal
+ * position, origin + outputFrame * tempo, at the offset whose overlap best
+ * correlates with the natural continuation of the previous grain, so tempo
+ * changes without a pitch change. Grains are read at pitchStep source frames
+ * per output frame, which shifts pitch independently of tempo.
+ *
+ * Onsets are detected in the continuation grain. A grain holding one is
+ * played unshifted and later grains never reach back before it, so drums
+ * are not doubled or smeared.
+ *
+ * Work per grain is fixed by the quality tier, so CPU per voice is bounded.
+ * A voice is stateful: it renders one clip on one thread at a time and
+ * restarts its grid whenever the requested output frame or parameters jump
+ * (seek, loop, relocation). Buffers are allocated by configure() (non-RT);
+ * process() never allocates. Grain searches read behind the playhead, so the
+ * source must be random access (the engine gives forward-only streams a
+ * decoded copy).
+ *
+ * Usage:
+ * @code
+ *   TimeStretcher voice;
+ *   voice.configure(StretchQuality::Realtime);                                      // Non-RT
+ *   voice.process(read, &clip, clipOffset, 0.8, 1.0, frameInClip, block, frames);   // RT
+ * @endcode
+ */
+class TimeStretcher {
+public:
+    /**
+     * @brief Source reader: frames source frames at position + i * step, interleaved stereo.
+     * @return false if a streamed read underran (those frames read as silence)
+     */
+    using Reader = bool (*)(void* context, double position, double step, double* dst, uint32_t frames);
+
+    /// Allocate grain buffers for a quality tier (non-RT).
+    void configure(StretchQuality quality);
+
+    bool isConfigured() const noexcept { return m_grainFrames > 0; }
+    StretchQuality quality() const noexcept { return m_quality; }
+    uint32_t grainFrames() const noexcept { return m_grainFrames; }
+
+    /**
+     * @brief Render frames output frames (RT-safe, no allocation).
+     *
+     * @param context Passed to reader; only used during this call
+     * @param origin Source position at output frame 0
+     * @param tempo Source frames the output advances per output frame
+     * @param pitchStep Source frames read per output frame inside a grain
+     * @param outputFrame Output frame of dst[0], counted from origin
+     * @return false if any source read underran
+     */
+    bool process(Reader reader, void* context, double origin, double tempo, double pitchStep,
+                 uint64_t outputFrame, double* dst, uint32_t frames) noexcept;
+
+    /// Forget the grid; the next process() starts a fresh one.
+    void reset() noexcept { m_expectedFrame = kNoFrame; }
+
+    /// Grains played unshifted because they held an onset (since configure()).
+    uint64_t transientGrains() const noexcept { return m_transientGrains; }
+
+    /// The engine rendering this voice; a voice is never shared between engines.
+    const void* owner() const noexcept { return m_owner; }
+    void setOwner(const void* owner) noexcept { m_owner = owner; }
+
+private:
+    static constexpr uint64_t kNoFrame = ~0ull;
+
+    void restart(uint64_t outputFrame) noexcept;
+    void advance() noexcept;
+    void addGrain(int64_t grain, bool seed) noexcept;
+    double searchStart(double nominal) noexcept;
+    bool holdsOnset(const double* grain) const noexcept;
+
+    StretchQuality m_quality{StretchQuality::Realtime};
+    uint32_t m_grainFrames{0};      // N
+    uint32_t m_hopFrames{0};        // N / 2
+    uint32_t m_searchFrames{0};     // Largest shift from the nominal position, in output frames
+    uint32_t m_coarseStride{1};     // Lag and sample decimation of the first search pass
+
+    std::vector<double> m_window;   // Periodic Hann, N
+    std::vector<double> m_ola;      // N output frames from m_olaGrain's start, stereo
+    std::vector<double> m_grain;    // Grain being added, stereo
+    std::vector<double> m_next;     // Continuation of the previous grain, stereo
+    std::vector<double> m_region;   // Search region, stereo
+    std::vector<float> m_target;    // Continuation overlap, mono
+    std::vector<float> m_candidates;// Search region, mono
+
+    const void* m_owner{nullptr};
+
+    // Parameters and grid of the current run (context is only valid during process())
+    Reader m_reader{nullptr};
+    void* m_context{nullptr};
+    double m_origin{0.0};
+    double m_tempo{1.0};
+    double m_pitchStep{1.0};
+    uint64_t m_expectedFrame{kNoFrame};
+    int64_t m_olaGrain{0};          // Grain whose start is m_ola[0]
+    double m_lastStart{0.0};        // Source start of the last grain added
+    double m_onsetFloor{0.0};       // Grains never start before this once an onset was played
+    bool m_complete{true};
+    uint64_t m_transientGrains{0};
+};
+
+} // namespace Audio
+} // namespace Nomad
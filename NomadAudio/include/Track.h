@@ -261,6 +261,35 @@ public:
 
     // Audio Data Management
     bool loadAudioFile(const std::string& filePath);
+
+    /**
+     * @brief Load without blocking: the decode runs on SamplePool's decode threads.
+     *
+     * Missing, streamed and undecodable files load synchronously (none of them
+     * wait on a decode), as do samples already in the pool. Otherwise
+     * isLoading() stays true until pollAsyncLoad() adopts the decoded buffer.
+     */
+    bool loadAudioFileAsync(const std::string& filePath);
+    bool isLoading() const { return m_loading.load(std::memory_order_acquire); }
+    /**
+     * @brief Adopt a finished asynchronous load, marking the graph dirty.
+     *
+     * Call from the thread that owns the track (TrackManager::pollAsyncLoads()
+     * on the UI loop): the decode thread never writes the track, so the
+     * unlocked audio-data getters stay race-free.
+     * @return true if a load finished (successfully or not) and was adopted
+     */
+    bool pollAsyncLoad();
+    /// Fraction of a pending asynchronous load decoded (1 when none is pending).
+    float getLoadProgress() const;
+    /**
+     * @brief Abandon a pending asynchronous load without waiting for it.
+     *
+     * Withdraws this track's request (the decode stops if nobody else wants
+     * the file) and returns at once. Call from the owning thread, like
+     * pollAsyncLoad(): it does not synchronise with an adoption in progress.
+     */
+    void cancelLoad();
     bool generatePreviewTone(const std::string& filePath);
     bool generateDemoAudio(const std::string& filePath);
     // Optional targetSampleRate allows resampling on load to match engine/device SR.
@@ -268,9 +297,31 @@ public:
     void clearAudioData();
     
     // Waveform data access (for UI visualization)
+    /**
+     * @brief Interleaved float samples (empty for streamed files).
+     *
+     * A packed sample buffer (see SampleStorage) is expanded into a float copy
+     * held by the track, which costs the memory packing saved; prefer
+     * hasAudioData() for emptiness checks and getSampleBuffer() for reading.
+     */
     const std::vector<float>& getAudioData() const;
+    /// True once there is audio to play, in memory or streamed from disk.
+    bool hasAudioData() const;
+    /// The audio streams from disk: getAudioData() is empty, edits share the stream.
+    bool isStreamed() const;
     // Shared decoded buffer (non-streaming). Non-RT thread only.
     std::shared_ptr<const AudioBuffer> getSampleBuffer() const;
+    /**
+     * @brief Display peaks for the track's audio (UI thread, never scans samples).
+     *
+     * The first call queues a background build (mapping the peak file when one
+     * is current) and returns nullptr; later calls return the finished cache.
+     * Pool samples share one cache across every clip using them; generated,
+     * recorded and edited audio gets a new cache per audio data version, the
+     * previous one standing in meanwhile. Streamed files are read through
+     * their stream on the same pool, one slice at a time.
+     */
+    std::shared_ptr<const WaveformCache> getWaveformCache() const;
     uint32_t getSampleRate() const { return m_sampleRate; }
     uint32_t getNumChannels() const { return m_numChannels; }
 
@@ -291,13 +342,14 @@ public:
     double getDuration() const { return m_durationSeconds.load(); }
     
     // Sample Timeline Position (where sample starts in the timeline, in seconds)
-    void setStartPositionInTimeline(double seconds) { m_startPositionInTimeline.store(seconds); }
+    void setStartPositionInTimeline(double seconds) { m_startPositionInTimeline.store(seconds); touchGraph(); }
     double getStartPositionInTimeline() const { return m_startPositionInTimeline.load(); }
     void setSourcePath(const std::string& path) { m_sourcePath = path; }
     const std::string& getSourcePath() const { return m_sourcePath; }
     
     // === CLIP TRIMMING (non-destructive) ===
     // Trim positions define which portion of the audio is used (in seconds from start of audio)
+    // Trims clamp to the audio; while an async load is pending they are kept as given and clamped on adoption.
     void setTrimStart(double seconds);    // Where playback begins within the audio
     void setTrimEnd(double seconds);      // Where playback ends within the audio  
     double getTrimStart() const { return m_trimStart.load(); }
@@ -311,6 +363,24 @@ public:
     // Create a copy of this clip (for duplicate/copy operations)
     std::shared_ptr<Track> duplicate() const;
 
+    /**
+     * @brief Split a streamed clip into a track the caller made (splitAt() without the copy).
+     *
+     * second shares the stream and plays everything after positionInClip, from
+     * there on the timeline; this clip's trim end moves to the cut. False if the
+     * clip isn't streamed or the cut is outside it.
+     */
+    bool splitStreamInto(Track& second, double positionInClip);
+
+    /**
+     * @brief Play the file source streams, sharing its stream (non-RT).
+     *
+     * Streamed audio has no samples to copy, so split, duplicate and paste of a
+     * streamed clip share the stream and narrow the trims instead. Trims and
+     * timeline position are left to the caller. False if source isn't streamed.
+     */
+    bool shareStream(const Track& source);
+
     // Audio Processing
     void processAudio(float* outputBuffer, uint32_t numFrames, double streamTime, double outputSampleRate);
 
@@ -328,6 +398,14 @@ public:
 
     // Change notifications (owner can observe data changes to rebuild graphs)
     void setOnDataChanged(std::function<void()> cb) { m_onDataChanged = std::move(cb); }
+
+    // === GRAPH DIRTY TRACKING ===
+    // Bumped after every change an AudioGraph snapshot reflects (graph version) and
+    // after every change to the samples themselves (audio data version, which also
+    // bumps the graph version). Values are unique across all tracks, so a cached
+    // snapshot can never match a different track.
+    uint64_t getGraphVersion() const { return m_graphVersion.load(std::memory_order_acquire); }
+    uint64_t getAudioDataVersion() const { return m_audioDataVersion.load(std::memory_order_acquire); }
     // Command sink for RT parameter updates
     void setCommandSink(std::function<void(const AudioQueueCommand&)> cb) { m_commandSink = std::move(cb); }
 
@@ -358,25 +436,36 @@ private:
     std::atomic<double> m_trimEnd{-1.0};      // End point within audio (-1 = full length)
 
     // Audio data
-    std::vector<float> m_audioData;  // Interleaved stereo samples (streaming/recording/temp)
+    // Interleaved stereo samples (generated/recorded/setAudioData). Replaced, never
+    // modified in place, so a background peak build can share them.
+    std::shared_ptr<const std::vector<float>> m_audioData;
     std::shared_ptr<AudioBuffer> m_sampleBuffer; // Shared decoded buffer from SamplePool (non-streaming)
     uint32_t m_sampleRate{48000};
     uint32_t m_numChannels{2};       // Always 2 after downmix
     uint32_t m_sourceChannels{2};    // Original channel count on load
     std::string m_sourcePath;
     std::atomic<double> m_playbackPhase{0.0};  // For sample-accurate playback
-    mutable std::recursive_mutex m_audioDataMutex;  // Recursive to allow nested locking (e.g., copyAudioData -> trimStreamBuffer)
-    std::atomic<bool> m_streaming{false};
-    std::thread m_streamThread;
-    std::atomic<bool> m_streamStop{false};
-    std::condition_variable m_streamCv;
-    std::mutex m_streamMutex;
-    std::atomic<uint64_t> m_streamBaseFrame{0};     // absolute frame index for m_audioData[0]
-    std::atomic<uint64_t> m_streamTotalFrames{0};   // total frames in source
-    std::atomic<bool> m_streamEof{false};
-    std::atomic<uint32_t> m_streamBytesPerSample{0};
-    std::atomic<uint32_t> m_streamDataOffset{0};
-    std::ifstream m_streamFile;
+    mutable std::recursive_mutex m_audioDataMutex;
+    std::vector<float> m_streamWindow;   // copyAudioData(): this block's frames of a streamed or packed file
+    mutable std::vector<float> m_unpacked;                       // getAudioData() view of a packed buffer
+    mutable std::shared_ptr<const AudioBuffer> m_unpackedFrom;
+    mutable std::mutex m_unpackedMutex;
+
+    // Display peaks of m_audioData, shared with the background build filling them
+    struct WaveformSlot {
+        std::mutex mutex;
+        std::shared_ptr<const WaveformCache> cache;
+        uint64_t cacheVersion{0};       // Audio data version cache was built from
+        uint64_t requestedVersion{0};   // Audio data version of the newest queued build
+    };
+    std::shared_ptr<WaveformSlot> m_waveformSlot{std::make_shared<WaveformSlot>()};
+
+    // Asynchronous load in flight (loadAudioFileAsync)
+    SampleLoadHandle m_pendingLoad;
+    std::string m_pendingLoadPath;
+    TrackState m_pendingLoadState{TrackState::Empty};   // State to restore on adoption
+    mutable std::mutex m_pendingLoadMutex;
+    std::atomic<bool> m_loading{false};
 
     // Mixer integration
     std::unique_ptr<MixerBus> m_mixerBus;
@@ -418,13 +507,28 @@ private:
     std::function<void()> m_onDataChanged;
     std::function<void(const AudioQueueCommand&)> m_commandSink;
 
+    // Graph dirty tracking (see getGraphVersion)
+    static uint64_t nextVersion();
+    void touchGraph() { m_graphVersion.store(nextVersion(), std::memory_order_release); }
+    void touchAudioData() {
+        const uint64_t version = nextVersion();
+        m_audioDataVersion.store(version, std::memory_order_release);
+        m_graphVersion.store(version, std::memory_order_release);
+    }
+    std::atomic<uint64_t> m_audioDataVersion{nextVersion()};
+    std::atomic<uint64_t> m_graphVersion{m_audioDataVersion.load()};
+
     // Internal audio processing
     void generateSilence(float* buffer, uint32_t numFrames);
     void copyAudioData(float* outputBuffer, uint32_t numFrames, double outputSampleRate);
-    void trimStreamBuffer(uint64_t currentFrame);
-    void stopStreaming();
-    bool startWavStreaming(const std::string& filePath, uint32_t sampleRate, uint16_t channels, uint16_t bitsPerSample, uint32_t dataOffset, uint64_t dataSize, uint64_t startFrame = 0);
-    void streamWavThread(uint32_t channels);
+    /// Serve a large (or AIFF) file from disk via SamplePool::acquireStreaming().
+    bool loadStreamingFile(const std::string& filePath, TrackState previousState);
+    /// Completion of loadAudioFileAsync() (owning thread, via pollAsyncLoad()).
+    void adoptLoadedBuffer(const std::string& filePath, const std::shared_ptr<AudioBuffer>& buffer,
+                           TrackState previousState);
+    /// Play buffer in place of the current audio (takes m_audioDataMutex).
+    void useSampleBuffer(const std::string& filePath, const std::shared_ptr<AudioBuffer>& buffer,
+                         uint32_t sourceChannels);
     
     // Interpolation methods
     float interpolateLinear(const float* data, uint32_t totalSamples, double position, uint32_t channel) const;
@@ -3,53 +3,18 @@
 
 #include "Track.h"
 #include "MeterSnapshot.h"
+#include "AudioJobSystem.h"
 #include <memory>
 #include <vector>
 #include <atomic>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
 #include <functional>
 #include <unordered_map>
 
 namespace Nomad {
 namespace Audio {
 
-/**
- * @brief Thread pool for parallel audio processing
- * 
- * Distributes track processing across multiple CPU cores for reduced latency
- * Uses lock-free design and thread affinity for real-time performance
- */
-class AudioThreadPool {
-public:
-    AudioThreadPool(size_t numThreads);
-    ~AudioThreadPool();
-    
-    // Submit a task to the thread pool
-    void enqueue(std::function<void()> task);
-    
-    // Wait for all tasks to complete
-    void waitForCompletion();
-    
-    // Get number of worker threads
-    size_t getThreadCount() const { return m_workers.size(); }
-    
-private:
-    std::vector<std::thread> m_workers;
-    std::queue<std::function<void()>> m_tasks;
-    
-    std::mutex m_queueMutex;
-    std::condition_variable m_condition;
-    std::condition_variable m_completionCondition;
-    
-    std::atomic<bool> m_stop{false};
-    std::atomic<size_t> m_activeTasks{0};
-    
-    void workerThread();
-};
-
 /**
  * @brief Manages multiple audio tracks for the DAW
  *
@@ -58,7 +23,8 @@ private:
  * track management, and audio routing.
  * 
  * MULTI-THREADING:
- * - Processes tracks in parallel using thread pool
+ * - Processes tracks in parallel on a preallocated job system (AudioJobSystem,
+ *   started by the first multi-threaded block)
  * - Distributes CPU load across all cores
  * - Lock-free audio buffer mixing
  * - Real-time thread priorities
@@ -125,7 +91,7 @@ public:
     bool isMultiThreadingEnabled() const { return m_multiThreadingEnabled; }
     
     void setThreadCount(size_t count);
-    size_t getThreadCount() const { return m_threadPool ? m_threadPool->getThreadCount() : 1; }
+    size_t getThreadCount() const { return m_threadCount; }
 
     // Connect a command sink for RT updates (pushed from tracks)
     void setCommandSink(std::function<void(const AudioQueueCommand&)> sink) { m_commandSink = std::move(sink); }
@@ -139,6 +105,9 @@ public:
     // Solo/Mute Management
     void clearAllSolos();
 
+    /// Adopt finished asynchronous track loads (UI thread, once per frame); returns how many finished.
+    size_t pollAsyncLoads();
+
     // Graph rebuild hint
     void markGraphDirty() { m_graphDirty.store(true, std::memory_order_release); }
     bool consumeGraphDirty() { return m_graphDirty.exchange(false, std::memory_order_acq_rel); }
@@ -172,8 +141,13 @@ private:
     std::function<void(const float*, const float*, size_t, double)> m_onAudioOutput;
     
     // Multi-threading
-    std::unique_ptr<AudioThreadPool> m_threadPool;
+    std::unique_ptr<AudioJobSystem> m_threadPool;     // Started by the first multi-threaded processAudio()
+    size_t m_threadCount{1};
     std::atomic<bool> m_multiThreadingEnabled{true};  // Enabled by default
+    // Per-block parameters read by processTrackJob (written before dispatch)
+    uint32_t m_jobNumFrames{0};
+    double m_jobStreamTime{0.0};
+    double m_jobSampleRate{48000.0};
     
     // Performance tracking
     std::atomic<double> m_audioLoadPercent{0.0};
@@ -203,6 +177,7 @@ private:
     // Processing helpers
     void processAudioSingleThreaded(float* outputBuffer, uint32_t numFrames, double streamTime, double outputSampleRate);
     void processAudioMultiThreaded(float* outputBuffer, uint32_t numFrames, double streamTime, double outputSampleRate);
+    static void processTrackJob(void* context, uint32_t trackIndex);
     
 public:
     // Modified state tracking for graceful shutdown
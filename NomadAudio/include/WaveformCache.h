@@ -6,8 +6,10 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace Nomad {
@@ -34,6 +36,9 @@ struct WaveformPeak {
     }
 };
 
+// Peak files store peaks as raw float pairs and map them straight back in.
+static_assert(sizeof(WaveformPeak) == 2 * sizeof(float), "WaveformPeak must stay a packed min/max pair");
+
 // =============================================================================
 // WaveformMipLevel - Single resolution level of peaks
 // =============================================================================
@@ -43,20 +48,27 @@ struct WaveformPeak {
  * 
  * Each level stores min/max pairs at a specific samples-per-pixel ratio.
  * Lower levels = more detail, higher levels = more zoomed out.
+ * Peaks live either in the owned vector or, for a level loaded from a peak
+ * file, in the file mapping held by the owning WaveformCache.
  */
 struct WaveformMipLevel {
-    std::vector<WaveformPeak> peaks;     ///< Peak data for each channel
+    std::vector<WaveformPeak> peaks;     ///< Peak data for each channel (empty when mapped)
+    const WaveformPeak* mapped = nullptr; ///< Peak data inside a mapped peak file
     uint32_t samplesPerPeak = 1;         ///< How many source samples per peak
     uint32_t numChannels = 0;            ///< Number of channels
     SampleIndex numPeaks = 0;            ///< Number of peaks per channel
     
+    /// Interleaved peaks (numPeaks * numChannels), wherever they are stored
+    const WaveformPeak* data() const { return mapped ? mapped : peaks.data(); }
+    size_t size() const { return mapped ? static_cast<size_t>(numPeaks * numChannels) : peaks.size(); }
+    
     /// Get peak at index for channel
     WaveformPeak getPeak(uint32_t channel, SampleIndex peakIndex) const {
         if (channel >= numChannels || peakIndex < 0 || peakIndex >= numPeaks) {
             return WaveformPeak();
         }
         size_t idx = static_cast<size_t>(peakIndex * numChannels + channel);
-        return idx < peaks.size() ? peaks[idx] : WaveformPeak();
+        return idx < size() ? data()[idx] : WaveformPeak();
     }
     
     /// Get interpolated peak at fractional index
@@ -118,6 +130,17 @@ struct WaveformMipLevel {
  * 
  * The cache is built on a background thread when audio is loaded.
  * The UI can check isReady() before using.
+ *
+ * A build reads the audio once: each finest-level peak comes from the SIMD
+ * peakRange kernel and is folded into the coarser levels as it is produced.
+ * Long sources are split into chunks of whole coarsest-level peaks and built
+ * in parallel on a bounded worker pool shared with WaveformCacheBuilder.
+ *
+ * Built caches can be saved as peak files and memory-mapped back on later
+ * loads, so reopening a session doesn't rescan its audio. A peak file is
+ * keyed on the source's path, size and modification time; any change to the
+ * source makes it stale and it is rebuilt. Peak files sit beside the source
+ * (<source>.nkpeaks) unless setPeakFileDirectory() names a cache directory.
  */
 class WaveformCache {
 public:
@@ -155,6 +178,57 @@ public:
                       uint32_t baseSamplesPerPeak = DEFAULT_BASE_SAMPLES_PER_PEAK,
                       uint32_t numLevels = DEFAULT_NUM_LEVELS);
     
+    /**
+     * @brief Extend the cache with frames appended to the source (recordings)
+     * 
+     * Only the last peak of each level and the new peaks are recomputed, and
+     * the result equals a full build of the whole source. An empty cache is
+     * started with the given level settings; a mapped cache is copied into
+     * memory first.
+     */
+    void append(const float* data, SampleIndex numFrames, uint32_t numChannels,
+                uint32_t baseSamplesPerPeak = DEFAULT_BASE_SAMPLES_PER_PEAK,
+                uint32_t numLevels = DEFAULT_NUM_LEVELS);
+    
+    /// Threads one build may use, the calling thread included (0 = automatic, 1 = caller only)
+    static void setBuildThreads(uint32_t threads);
+    static uint32_t getBuildThreads();
+    
+    // === Peak Files ===
+    
+    /// Current peak file format; older or newer files are rebuilt.
+    static constexpr uint32_t PEAK_FILE_VERSION = 1;
+    
+    /**
+     * @brief Map the peak file for sourcePath, if present and current
+     * 
+     * Fails (leaving the cache untouched) if the file is missing, corrupt,
+     * from another format version, stale against the source, or built with
+     * different level settings.
+     */
+    bool loadPeakFile(const std::string& sourcePath,
+                      uint32_t baseSamplesPerPeak = DEFAULT_BASE_SAMPLES_PER_PEAK,
+                      uint32_t numLevels = DEFAULT_NUM_LEVELS);
+    
+    /**
+     * @brief Write the cache as the peak file for sourcePath
+     * 
+     * Keyed on the source as it is on disk now, so save after the source is
+     * complete (e.g. when a recording stops). Written to a temporary file and
+     * renamed into place, so readers never see a partial file.
+     */
+    bool savePeakFile(const std::string& sourcePath) const;
+    
+    /// Where the peak file for sourcePath lives
+    static std::string peakFilePath(const std::string& sourcePath);
+    
+    /// Keep peak files in dir instead of beside their sources (empty = beside)
+    static void setPeakFileDirectory(const std::string& dir);
+    static std::string getPeakFileDirectory();
+    
+    /// True if the levels are mapped from a peak file
+    bool isMapped() const;
+    
     /// Check if cache is ready for use
     bool isReady() const { return m_ready.load(std::memory_order_acquire); }
     
@@ -203,19 +277,25 @@ public:
     /// Clear all cached data
     void clear();
     
-    /// Get memory usage in bytes
+    /// Get memory usage in bytes (heap only; mapped peaks are not counted)
     size_t getMemoryUsage() const;
 
 private:
+    struct PeakFileMapping;
+    
     std::vector<WaveformMipLevel> m_levels;
+    std::shared_ptr<const PeakFileMapping> m_mapping;   ///< Backs mapped levels
     uint32_t m_numChannels = 0;
     SampleIndex m_sourceFrames = 0;
     std::atomic<bool> m_ready{false};
     mutable std::mutex m_mutex;
     
-    void buildLevel(const float* data, SampleIndex numFrames, uint32_t numChannels,
-                   uint32_t samplesPerPeak, WaveformMipLevel& outLevel);
-    void buildNextLevel(const WaveformMipLevel& source, WaveformMipLevel& dest);
+    /// Build finest peaks [firstPeak, endPeak) and fold them into every coarser level.
+    void buildChunk(const float* data, SampleIndex numFrames, SampleIndex firstPeak, SampleIndex endPeak);
+    /// Rebuild dest from source; peaks before fromPeak are kept as they are.
+    void buildNextLevel(const WaveformMipLevel& source, WaveformMipLevel& dest, SampleIndex fromPeak = 0);
+    /// Copy mapped levels into memory so they can be modified.
+    void detachMapping();
 };
 
 // =============================================================================
@@ -225,6 +305,10 @@ private:
 /**
  * @brief Helper for async waveform cache building
  * 
+ * Async requests run on the peak worker pool (bounded, no thread per
+ * request). Both build paths load the source's peak file when it is current and
+ * write one after scanning the audio, so each file is scanned once.
+ * 
  * Example usage:
  * ```
  * WaveformCacheBuilder builder;
@@ -236,6 +320,8 @@ private:
 class WaveformCacheBuilder {
 public:
     using CompletionCallback = std::function<void(std::shared_ptr<WaveformCache>)>;
+    /// Fills a cache from audio the caller owns; returns false if there was nothing to scan
+    using BuildFunction = std::function<bool(WaveformCache&)>;
     
     WaveformCacheBuilder();
     ~WaveformCacheBuilder();
@@ -243,11 +329,27 @@ public:
     /**
      * @brief Build cache asynchronously
      * 
+     * A source whose audio isn't loaded yet still gets its cache if a current
+     * peak file exists.
+     * 
      * @param source Source to build cache for
      * @param callback Called on completion (may be on worker thread)
      */
     void buildAsync(const ClipSource& source, CompletionCallback callback);
     
+    /**
+     * @brief Build cache asynchronously from audio that isn't a ClipSource
+     * 
+     * Maps sourcePath's peak file when it is current; otherwise runs build on
+     * the peak worker pool and writes the peak file. An empty sourcePath skips
+     * the peak file.
+     * 
+     * @param sourcePath File the audio was decoded from (keys the peak file)
+     * @param build Scans the audio into the cache (runs on a worker thread)
+     * @param callback Called on completion (may be on worker thread)
+     */
+    void buildAsync(const std::string& sourcePath, BuildFunction build, CompletionCallback callback);
+    
     /**
      * @brief Build cache synchronously (blocking)
      */
@@ -264,5 +366,72 @@ private:
     std::unique_ptr<Impl> m_impl;
 };
 
+// =============================================================================
+// WaveformVertexCache - Per-clip display columns at power-of-two zoom buckets
+// =============================================================================
+
+/**
+ * @brief Draw-ready waveform vertices for one clip
+ * 
+ * Splits the source into vertices of bucket samples each (bucket = the largest
+ * power of two not above the current samples per pixel) and keeps them in
+ * fixed-size tiles of channel-merged min/max pairs, contiguous and ready to
+ * upload as a vertex buffer. Tiles are filled from WaveformCache::getPeaksForRange
+ * and only for the visible range, so scrolling and zooming within a bucket
+ * reuse them and nothing ever reads the source samples. Least recently used
+ * tiles are dropped past the tile limit.
+ * 
+ * Not thread-safe: owned and used by one UI component.
+ */
+class WaveformVertexCache {
+public:
+    /// Vertices per tile
+    static constexpr uint32_t TILE_VERTICES = 1024;
+    /// Default tile limit (2 MB of vertices)
+    static constexpr size_t DEFAULT_MAX_TILES = 256;
+    
+    /// Use peaks from cache; a different cache drops every tile
+    void setSource(std::shared_ptr<const WaveformCache> cache);
+    const std::shared_ptr<const WaveformCache>& getSource() const { return m_source; }
+    
+    /// Zoom bucket for a samples-per-pixel ratio: largest power of two <= it (at least 1)
+    static SampleIndex bucketFor(double samplesPerPixel);
+    
+    /**
+     * @brief Get one channel-merged min/max column per pixel
+     * 
+     * @param startSample Start sample in source audio
+     * @param endSample End sample in source audio
+     * @param numPixels Number of pixels to render
+     * @param outColumns Output vector of columns (one per pixel; (0, 0) past the source)
+     * @return false if there is no ready source to draw from
+     */
+    bool getColumns(SampleIndex startSample, SampleIndex endSample, uint32_t numPixels,
+                    std::vector<WaveformPeak>& outColumns);
+    
+    void setMaxTiles(size_t maxTiles);
+    size_t getTileCount() const { return m_tiles.size(); }
+    
+    /// Drop every tile
+    void clear();
+
+private:
+    struct Tile {
+        std::vector<WaveformPeak> vertices;   ///< TILE_VERTICES channel-merged peaks
+        uint64_t lastUse = 0;
+    };
+    using TileKey = std::pair<SampleIndex, SampleIndex>;   ///< (bucket, tile index)
+    
+    const Tile& getTile(SampleIndex bucket, SampleIndex tileIndex);
+    void evict();
+    
+    std::shared_ptr<const WaveformCache> m_source;
+    SampleIndex m_sourceFrames = 0;
+    std::map<TileKey, Tile> m_tiles;
+    std::vector<WaveformPeak> m_scratch;
+    uint64_t m_useCounter = 0;
+    size_t m_maxTiles = DEFAULT_MAX_TILES;
+};
+
 } // namespace Audio
 } // namespace Nomad
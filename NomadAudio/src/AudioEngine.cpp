@@ -1,72 +1,132 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #include "AudioEngine.h"
+#include "AudioGraphCompiler.h"
+#include "AudioKernels.h"
+#include "ChannelSlotMap.h"
+#include "NomadLog.h"
+#include "SamplePool.h"
+#include "StreamingSource.h"
 #include <cmath>
 #include <algorithm>
 #include <cstring>
+#include <string>
+#include <thread>
 
 namespace Nomad {
 namespace Audio {
 
-void AudioEngine::applyPendingCommands() {
+void AudioEngine::drainCommandQueue(uint64_t blockStart) {
+    // Drain both lanes (bounded by their capacity per block) into the schedule,
+    // kept sorted by sampleTime; equal times keep their push order.
     AudioQueueCommand cmd;
-    // Bounded drain - max 16 commands per block (less work = less RT risk)
-    int cmdCount = 0;
-    bool hasTransport = false;
-    AudioQueueCommand lastTransport;
-    
-    while (cmdCount < 16 && m_commandQueue.pop(cmd)) {
-        ++cmdCount;
-        // Coalesce transport commands: keep only the latest per block.
-        if (cmd.type == AudioQueueCommandType::SetTransportState) {
-            lastTransport = cmd;
-            hasTransport = true;
-            continue;
+    for (uint32_t n = 0; n < AudioCommandQueue::capacity(); ++n) {
+        if (m_scheduledCount >= kMaxScheduledCommands) {
+            // Leave the rest in their lane: order is preserved, they drain next block.
+            if (m_commandQueue.hasDated()) {
+                m_telemetry.incrementScheduleOverflows();
+            }
+            break;
+        }
+        if (!m_commandQueue.popDated(cmd)) {
+            break;
         }
+        if (cmd.sampleTime < blockStart) {
+            m_telemetry.incrementLateCommands();
+            cmd.sampleTime = blockStart;
+        }
+        scheduleCommand(cmd);
+    }
 
-        switch (cmd.type) {
-            case AudioQueueCommandType::None:
-                break;
-            case AudioQueueCommandType::SetTrackVolume: {
-                auto& state = ensureTrackState(cmd.trackIndex);
-                state.volume.setTarget(static_cast<double>(cmd.value1));
-                break;
-            }
-            case AudioQueueCommandType::SetTrackPan: {
-                auto& state = ensureTrackState(cmd.trackIndex);
-                state.pan.setTarget(static_cast<double>(cmd.value1));
-                break;
-            }
-            case AudioQueueCommandType::SetTrackMute: {
-                auto& state = ensureTrackState(cmd.trackIndex);
-                state.mute = (cmd.value1 != 0.0f);
-                break;
-            }
-            case AudioQueueCommandType::SetTrackSolo: {
-                auto& state = ensureTrackState(cmd.trackIndex);
-                state.solo = (cmd.value1 != 0.0f);
-                break;
-            }
-            default:
-                break;
+    // Immediate commands use the reserve, which every block empties (they are
+    // all due at its start), so future-dated ones can never hold them up.
+    for (uint32_t n = 0; n < kImmediateReserve; ++n) {
+        if (!m_commandQueue.popImmediate(cmd)) {
+            break;
         }
+        cmd.sampleTime = blockStart;
+        scheduleCommand(cmd);
     }
+}
 
-    if (hasTransport) {
-        const bool wasPlaying = m_transportPlaying;
-        const uint64_t oldPos = m_globalSamplePos;
-        const bool nextPlaying = (lastTransport.value1 != 0.0f);
-        const bool posChanged = (lastTransport.samplePos != oldPos);
+void AudioEngine::scheduleCommand(const AudioQueueCommand& cmd) noexcept {
+    // A late dated command and an immediate one can land on the same frame from
+    // different lanes: the push stamp keeps them in push order.
+    uint32_t pos = m_scheduledCount;
+    while (pos > 0 && (m_scheduled[pos - 1].sampleTime > cmd.sampleTime ||
+                       (m_scheduled[pos - 1].sampleTime == cmd.sampleTime &&
+                        m_scheduled[pos - 1].enqueueNs > cmd.enqueueNs))) {
+        m_scheduled[pos] = m_scheduled[pos - 1];
+        --pos;
+    }
+    m_scheduled[pos] = cmd;
+    ++m_scheduledCount;
+}
+
+void AudioEngine::applyDueCommands(uint64_t streamPos, uint64_t& nowNs) {
+    uint32_t due = 0;
+    while (due < m_scheduledCount && m_scheduled[due].sampleTime <= streamPos) {
+        if (nowNs == 0) {
+            nowNs = AudioCommandQueue::nowNs();   // One clock read per block, only if needed
+        }
+        const AudioQueueCommand& cmd = m_scheduled[due];
+        applyCommand(cmd);
+        m_telemetry.recordCommandApplied(nowNs > cmd.enqueueNs ? nowNs - cmd.enqueueNs : 0);
+        ++due;
+    }
+    if (due > 0) {
+        std::move(m_scheduled.begin() + due, m_scheduled.begin() + m_scheduledCount, m_scheduled.begin());
+        m_scheduledCount -= due;
+    }
+}
+
+void AudioEngine::applyCommand(const AudioQueueCommand& cmd) {
+    switch (cmd.type) {
+        case AudioQueueCommandType::None:
+            break;
+        case AudioQueueCommandType::SetTransportState: {
+            const bool wasPlaying = m_transportPlaying;
+            const uint64_t oldPos = m_globalSamplePos;
+            const bool nextPlaying = (cmd.value1 != 0.0f);
+            const bool posChanged = (cmd.samplePos != oldPos);
 
-        m_transportPlaying = nextPlaying;
-        m_globalSamplePos = lastTransport.samplePos;
+            m_transportPlaying = nextPlaying;
+            m_globalSamplePos = cmd.samplePos;
 
-        if (nextPlaying && (!wasPlaying || posChanged)) {
-            m_fadeState = FadeState::FadingIn;
-            m_fadeSamplesRemaining = FADE_IN_SAMPLES;
-        } else if (nextPlaying && m_fadeState == FadeState::Silent) {
-            m_fadeState = FadeState::None;
-            m_fadeSamplesRemaining = 0;
+            if (nextPlaying && (!wasPlaying || posChanged)) {
+                m_fadeState = FadeState::FadingIn;
+                m_fadeSamplesRemaining = FADE_IN_SAMPLES;
+            } else if (nextPlaying && m_fadeState == FadeState::Silent) {
+                m_fadeState = FadeState::None;
+                m_fadeSamplesRemaining = 0;
+            }
+            break;
+        }
+        case AudioQueueCommandType::SetTrackVolume: {
+            auto& state = ensureTrackState(cmd.trackIndex);
+            state.volume.setTarget(static_cast<double>(cmd.value1));
+            state.volumeSet = true;
+            break;
+        }
+        case AudioQueueCommandType::SetTrackPan: {
+            auto& state = ensureTrackState(cmd.trackIndex);
+            state.pan.setTarget(static_cast<double>(cmd.value1));
+            state.panSet = true;
+            break;
+        }
+        case AudioQueueCommandType::SetTrackMute: {
+            auto& state = ensureTrackState(cmd.trackIndex);
+            state.mute = (cmd.value1 != 0.0f);
+            state.muteSet = true;
+            break;
         }
+        case AudioQueueCommandType::SetTrackSolo: {
+            auto& state = ensureTrackState(cmd.trackIndex);
+            state.solo = (cmd.value1 != 0.0f);
+            state.soloSet = true;
+            break;
+        }
+        default:
+            break;
     }
 }
 
@@ -81,11 +141,68 @@ void AudioEngine::processBlock(float* outputBuffer,
         return;
     }
 
-    const bool wasPlaying = m_transportPlaying;
+    // Read the graph before adopting resources: setGraph() publishes resources
+    // first, so any graph seen here has its resources already pending.
+    const AudioGraph& graph = m_state.acquireGraph();
+    adoptPendingResources();
+    adoptPendingLoudness();
+    if (&graph != m_lastGraph) {
+        // A newly published graph already carries the commanded values.
+        m_lastGraph = &graph;
+        if (m_rt) {
+            for (auto& state : m_rt->trackState) {
+                state.volumeSet = state.panSet = state.muteSet = state.soloSet = false;
+            }
+        }
+    }
 
-    // Process commands FIRST (lock-free)
-    applyPendingCommands();
+    // Commands (lock-free). The block is split at every scheduled command so
+    // each lands on its exact sample; sub-blocks run the full render and output
+    // stage with the state in effect for them.
+    const uint64_t blockStart = m_streamSamplePos;
+    const uint64_t blockEnd = blockStart + numFrames;
+    drainCommandQueue(blockStart);
+    if (m_loudness) {
+        prepareLoudnessMeters();
+    }
 
+    StereoLevels levels;
+    uint64_t nowNs = 0;
+    uint32_t offset = 0;
+    while (offset < numFrames) {
+        const bool wasPlaying = m_transportPlaying;
+        applyDueCommands(blockStart + offset, nowNs);
+        uint32_t segmentEnd = numFrames;
+        if (m_scheduledCount > 0 && m_scheduled[0].sampleTime < blockEnd) {
+            segmentEnd = static_cast<uint32_t>(m_scheduled[0].sampleTime - blockStart);
+            m_telemetry.incrementBlockSplits();
+        }
+        renderSegment(graph, outputBuffer + static_cast<size_t>(offset) * m_outputChannels,
+                      segmentEnd - offset, wasPlaying, levels);
+        offset = segmentEnd;
+    }
+    m_streamSamplePos = blockEnd;
+    m_streamClock.store(blockEnd, std::memory_order_relaxed);
+    m_telemetry.updateScheduledCommands(m_scheduledCount);
+
+    m_peakL.store(static_cast<float>(levels.peakL), std::memory_order_relaxed);
+    m_peakR.store(static_cast<float>(levels.peakR), std::memory_order_relaxed);
+    const double invN = 1.0 / static_cast<double>(numFrames);
+    m_rmsL.store(static_cast<float>(std::sqrt(levels.sumSqL * invN)), std::memory_order_relaxed);
+    m_rmsR.store(static_cast<float>(std::sqrt(levels.sumSqR * invN)), std::memory_order_relaxed);
+    if (m_loudness && m_outputChannels == 2) {
+        m_loudness->master.process(outputBuffer, numFrames);
+    }
+    if (m_meterSnapshots || m_loudness) {
+        publishMeters(graph, numFrames, levels);
+    }
+
+    // Telemetry (lightweight counter only on RT thread)
+    m_telemetry.incrementBlocksProcessed();
+}
+
+void AudioEngine::renderSegment(const AudioGraph& graph, float* outputBuffer, uint32_t numFrames,
+                                bool wasPlaying, StereoLevels& blockLevels) {
     // State transitions
     if (wasPlaying && !m_transportPlaying &&
         m_fadeState != FadeState::FadingOut && m_fadeState != FadeState::Silent) {
@@ -99,19 +216,12 @@ void AudioEngine::processBlock(float* outputBuffer,
 
     // Fast path: silent
     if (m_fadeState == FadeState::Silent) {
+        // Silence adds nothing to the meters, so they fall to zero instead of freezing.
         std::memset(outputBuffer, 0, static_cast<size_t>(numFrames) * m_outputChannels * sizeof(float));
-        // Clear meters so UI doesn't freeze on the last loud block.
-        m_peakL.store(0.0f, std::memory_order_relaxed);
-        m_peakR.store(0.0f, std::memory_order_relaxed);
-        m_rmsL.store(0.0f, std::memory_order_relaxed);
-        m_rmsR.store(0.0f, std::memory_order_relaxed);
-        m_telemetry.incrementBlocksProcessed();
         return;
     }
 
     // Render to double-precision master buffer
-    const AudioGraph& graph = m_state.activeGraph();
-
     // Transport looping: if playback has passed the end of the timeline, wrap to 0.
     // This is a simple whole-timeline loop until loop regions are implemented.
     if (m_transportPlaying && graph.timelineEndSample > 0 &&
@@ -134,23 +244,19 @@ void AudioEngine::processBlock(float* outputBuffer,
     const double targetGain = static_cast<double>(m_masterGainTarget) * static_cast<double>(m_headroomLinear);
     const double currentGain = m_smoothedMasterGain.current;
     const double gainDelta = (targetGain - currentGain) / static_cast<double>(numFrames);
-    double gain = currentGain;
-    
-    double peakL = 0.0;
-    double peakR = 0.0;
-    double rmsAccL = 0.0;
-    double rmsAccR = 0.0;
-    
-    const double* src = m_masterBufferD.data();
-    
-    const bool safety = m_safetyProcessingEnabled;
-    // Optimized output loop - minimal branches
-    for (uint32_t i = 0; i < numFrames; ++i) {
-        // Read from double buffer
-        double L = src[i * 2] * gain;
-        double R = src[i * 2 + 1] * gain;
-
-        if (safety) {
+    const AudioKernelTable& kernels = AudioKernels::active();
+    StereoRamp masterRamp{currentGain, currentGain, gainDelta, gainDelta};
+    StereoLevels levels;
+
+    if (m_safetyProcessingEnabled) {
+        // DC blocker + soft clip are sequential per sample; ramp first, then
+        // convert/measure the processed signal with a unit ramp.
+        double* data = m_masterBufferD.data();
+        kernels.applyGainRamp(data, numFrames, masterRamp);
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            double L = data[i * 2];
+            double R = data[i * 2 + 1];
+
             // DC blocking
             {
                 double y = L - m_dcBlockerL.x1 + DCBlockerD::R * m_dcBlockerL.y1;
@@ -173,38 +279,24 @@ void AudioEngine::processBlock(float* outputBuffer,
             if (R > 1.5) R = 1.0;
             else if (R < -1.5) R = -1.0;
             else { const double x2 = R * R; R = R * (27.0 + x2) / (27.0 + 9.0 * x2); }
+
+            data[i * 2] = L;
+            data[i * 2 + 1] = R;
         }
-        
-        // Track peaks
-        const double absL = (L >= 0.0) ? L : -L;
-        const double absR = (R >= 0.0) ? R : -R;
-        if (absL > peakL) peakL = absL;
-        if (absR > peakR) peakR = absR;
-
-        rmsAccL += L * L;
-        rmsAccR += R * R;
-        
-        // Output as float
-        outputBuffer[i * 2] = static_cast<float>(L);
-        outputBuffer[i * 2 + 1] = static_cast<float>(R);
-        
-        gain += gainDelta;
+        masterRamp = StereoRamp{};
     }
+
+    // Gain ramp, peak/RMS and float conversion in one pass
+    kernels.rampToFloat(outputBuffer, m_masterBufferD.data(), numFrames, masterRamp, levels);
     
     // Update smoothed gain state
     m_smoothedMasterGain.current = targetGain;
     m_smoothedMasterGain.target = targetGain;
     
-    m_peakL.store(static_cast<float>(peakL), std::memory_order_relaxed);
-    m_peakR.store(static_cast<float>(peakR), std::memory_order_relaxed);
-    if (numFrames > 0) {
-        const double invN = 1.0 / static_cast<double>(numFrames);
-        m_rmsL.store(static_cast<float>(std::sqrt(rmsAccL * invN)), std::memory_order_relaxed);
-        m_rmsR.store(static_cast<float>(std::sqrt(rmsAccR * invN)), std::memory_order_relaxed);
-    } else {
-        m_rmsL.store(0.0f, std::memory_order_relaxed);
-        m_rmsR.store(0.0f, std::memory_order_relaxed);
-    }
+    blockLevels.peakL = std::max(blockLevels.peakL, levels.peakL);
+    blockLevels.peakR = std::max(blockLevels.peakR, levels.peakR);
+    blockLevels.sumSqL += levels.sumSqL;
+    blockLevels.sumSqR += levels.sumSqR;
 
     // Fade envelopes (short ramps prevent clicks on stop/seek)
     if (m_fadeState == FadeState::FadingIn) {
@@ -261,9 +353,22 @@ void AudioEngine::processBlock(float* outputBuffer,
     if (m_transportPlaying) {
         m_globalSamplePos += numFrames;
     }
+}
 
-    // Telemetry (lightweight counter only on RT thread)
-    m_telemetry.incrementBlocksProcessed();
+AudioEngine::AudioEngine() {
+    const SRCQuality qualities[] = {SRCQuality::Linear, SRCQuality::Cubic, SRCQuality::Sinc8,
+                                    SRCQuality::Sinc16, SRCQuality::Sinc64};
+    for (SRCQuality quality : qualities) {
+        m_defaultResamplers[static_cast<size_t>(quality)].configure(1.0, 1.0, quality);
+    }
+}
+
+AudioEngine::~AudioEngine() {
+    // Stop decodes only this engine was waiting for.
+    std::lock_guard<std::mutex> lock(m_streamDecodeMutex);
+    for (auto& decode : m_streamDecodes) {
+        decode.cancel();
+    }
 }
 
 void AudioEngine::setBufferConfig(uint32_t maxFrames, uint32_t numChannels) {
@@ -276,23 +381,14 @@ void AudioEngine::setBufferConfig(uint32_t maxFrames, uint32_t numChannels) {
     }
 
     const size_t requiredSize = static_cast<size_t>(m_maxBufferFrames) * m_outputChannels;
-    const bool needAlloc = m_masterBufferD.size() < requiredSize ||
-                           m_trackBuffersD.size() != kMaxTracks;
-
-    if (needAlloc) {
+    if (m_masterBufferD.size() < requiredSize) {
         m_masterBufferD.resize(requiredSize);
         std::memset(m_masterBufferD.data(), 0, requiredSize * sizeof(double));
-
-        m_trackBuffersD.clear();
-        m_trackBuffersD.resize(kMaxTracks);
-        for (auto& buf : m_trackBuffersD) {
-            buf.assign(requiredSize, 0.0);
-        }
-        if (m_trackState.size() != kMaxTracks) {
-            m_trackState.assign(kMaxTracks, TrackRTState{});
-        }
     }
 
+    // Render slots follow m_maxBufferFrames; counts keep whatever the last graph needed.
+    ensureRenderCapacity(kInitialSlotCapacity, kInitialTrackCapacity, kInitialBusCapacity, kInitialSlotCapacity);
+
     // Allocate waveform history ring (non-RT).
     if (m_waveformHistoryFrames == 0) {
         m_waveformHistoryFrames = kWaveformHistoryFramesDefault;
@@ -308,6 +404,265 @@ void AudioEngine::setBufferConfig(uint32_t maxFrames, uint32_t numChannels) {
     m_smoothedMasterGain.coeff = 1.0 / static_cast<double>(coeffFrames);
 }
 
+void AudioEngine::setGraph(const AudioGraph& graph) {
+    setGraph(AudioGraph(graph));
+}
+
+void AudioEngine::setGraph(AudioGraph&& graph) {
+    // Hand-built graphs (tests, tools) get their schedule compiled here, and clips
+    // at another sample rate get their resampler, all off the RT thread.
+    auto next = std::make_unique<AudioGraph>(std::move(graph));
+    if (!next->schedule.compiled) {
+        AudioGraphCompiler::compile(*next);
+    }
+    prepareDecodedStreams(*next);
+    if (!resamplersReady(*next)) {
+        prepareResamplers(*next);
+    }
+    prepareStretchers(*next);
+    ChannelSlotMap slots;
+    assignMeterSlots(*next, slots);
+
+    // Size the render resources before the graph can be seen by the audio thread.
+    uint32_t tracks = 0;
+    for (const auto& track : next->tracks) {
+        tracks = std::max(tracks, track.trackIndex + 1);
+    }
+    ensureRenderCapacity(next->schedule.bufferCount, tracks,
+                         static_cast<uint32_t>(next->buses.size()),
+                         static_cast<uint32_t>(next->schedule.nodes.size()));
+    m_state.publish(std::move(next));
+    {
+        std::lock_guard<std::mutex> lock(m_meterSlotMutex);
+        m_meterSlots = std::move(slots);
+    }
+}
+
+void AudioEngine::setResamplingQuality(SRCQuality quality) {
+    m_resampleQuality.store(quality, std::memory_order_relaxed);
+    AudioGraph current = m_state.copyActiveGraph();
+    if (!current.tracks.empty()) {
+        setGraph(std::move(current));
+    }
+}
+
+void AudioEngine::setStretchQuality(StretchQuality quality) {
+    m_stretchQuality.store(quality, std::memory_order_relaxed);
+    AudioGraph current = m_state.copyActiveGraph();
+    if (!current.tracks.empty()) {
+        setGraph(std::move(current));
+    }
+}
+
+void AudioEngine::prepareDecodedStreams(AudioGraph& graph) {
+    // A read-ahead ring only moves forward: a backward read, a loop wrap or a
+    // stretch grain searching behind the playhead misses and plays silence, so
+    // these clips read the whole file from the sample pool. Decoding it can
+    // take seconds, so it runs on the pool's threads; until the copy is ready
+    // the clip keeps its stream and refreshDecodedStreams() republishes.
+    std::lock_guard<std::mutex> lock(m_streamDecodeMutex);
+    m_streamDecodes.erase(std::remove_if(m_streamDecodes.begin(), m_streamDecodes.end(),
+                                         [](const SampleLoadHandle& decode) { return decode.isReady(); }),
+                          m_streamDecodes.end());
+    for (auto& track : graph.tracks) {
+        for (auto& clip : track.clips) {
+            const bool outOfOrder = clip.reversed || clip.loopFrames > 0 || clip.stretched();
+            if (!clip.stream || clip.stream->randomAccess() || !outOfOrder) {
+                continue;
+            }
+            std::shared_ptr<StreamingSource> source = clip.buffer ? clip.buffer->stream : nullptr;
+            if (source.get() != clip.stream) {
+                continue;   // Nothing owns the stream beyond this graph
+            }
+            // The flag is shared: a finished load's callback may still be running after the prune above.
+            SampleLoadHandle decode = SamplePool::getInstance().acquireDecodedAsync(
+                source, [done = m_streamDecodesDone](const std::shared_ptr<AudioBuffer>&) {
+                    done->store(true, std::memory_order_release);
+                });
+            if (!decode.isReady()) {
+                m_streamDecodes.push_back(std::move(decode));
+                continue;
+            }
+            // Cached: swap now. Another loader may have cached the path in a different format.
+            std::shared_ptr<AudioBuffer> decoded = decode.get();
+            if (!decoded || decoded->channels != 2 || decoded->sampleRate != source->sampleRate()) {
+                Log::warning("AudioEngine: can't decode " + source->path() + " for out-of-order playback");
+                continue;
+            }
+            const bool packed = decoded->isPacked();
+            clip.audioData = packed ? nullptr : decoded->data.data();
+            clip.packedData = packed ? decoded->packed.data() : nullptr;
+            clip.packedSampleBytes = decoded->packedSampleBytes();
+            clip.stream = nullptr;
+            clip.totalFrames = decoded->numFrames;
+            clip.buffer = std::move(decoded);
+        }
+    }
+}
+
+bool AudioEngine::refreshDecodedStreams() {
+    if (!m_streamDecodesDone->exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+    AudioGraph current = m_state.copyActiveGraph();
+    setGraph(std::move(current));
+    return true;
+}
+
+void AudioEngine::waitForDecodedStreams() {
+    std::vector<std::shared_future<std::shared_ptr<AudioBuffer>>> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_streamDecodeMutex);
+        for (const auto& decode : m_streamDecodes) {
+            if (!decode.isReady()) {
+                pending.push_back(decode.future());
+            }
+        }
+    }
+    if (pending.empty()) {
+        return;
+    }
+    for (const auto& result : pending) {
+        result.wait();
+    }
+    m_streamDecodesDone->store(false, std::memory_order_relaxed);
+    AudioGraph current = m_state.copyActiveGraph();
+    setGraph(std::move(current));
+}
+
+bool AudioEngine::resamplersReady(const AudioGraph& graph) const {
+    const double outputRate = static_cast<double>(m_sampleRate);
+    const SRCQuality quality = m_resampleQuality.load(std::memory_order_relaxed);
+    for (const auto& track : graph.tracks) {
+        for (const auto& clip : track.clips) {
+            const double srcRate = clip.resampleRate(outputRate);
+            if (srcRate != outputRate &&
+                (!clip.resampler || !clip.resampler->matches(srcRate, outputRate, quality))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void AudioEngine::prepareResamplers(AudioGraph& graph) const {
+    const double outputRate = static_cast<double>(m_sampleRate);
+    const SRCQuality quality = m_resampleQuality.load(std::memory_order_relaxed);
+    // Clips reading at the same rate share one resampler (a playlist may hold thousands).
+    std::vector<std::shared_ptr<const ClipResampler>> shared;
+    for (auto& track : graph.tracks) {
+        for (auto& clip : track.clips) {
+            const double srcRate = clip.resampleRate(outputRate);
+            if (srcRate == outputRate) {
+                clip.resampler.reset();
+                continue;
+            }
+            if (clip.resampler && clip.resampler->matches(srcRate, outputRate, quality)) {
+                continue;
+            }
+            auto match = std::find_if(shared.begin(), shared.end(), [&](const auto& resampler) {
+                return resampler->matches(srcRate, outputRate, quality);
+            });
+            if (match == shared.end()) {
+                auto resampler = std::make_shared<ClipResampler>();
+                resampler->configure(srcRate, outputRate, quality);
+                match = shared.insert(shared.end(), std::move(resampler));
+            }
+            clip.resampler = *match;
+        }
+    }
+}
+
+void AudioEngine::prepareStretchers(AudioGraph& graph) const {
+    // Voices carry per-clip state, so a graph copied from another engine gets its own.
+    const StretchQuality quality = m_stretchQuality.load(std::memory_order_relaxed);
+    for (auto& track : graph.tracks) {
+        for (auto& clip : track.clips) {
+            if (!clip.stretched()) {
+                clip.stretcher.reset();
+                continue;
+            }
+            if (clip.stretcher && clip.stretcher->owner() == this && clip.stretcher->quality() == quality) {
+                continue;
+            }
+            auto voice = std::make_shared<TimeStretcher>();
+            voice->configure(quality);
+            voice->setOwner(this);
+            clip.stretcher = std::move(voice);
+        }
+    }
+}
+
+void AudioEngine::ensureRenderCapacity(uint32_t slots, uint32_t tracks, uint32_t buses, uint32_t nodes) {
+    std::lock_guard<std::mutex> lock(m_resourceMutex);
+
+    const RenderResources* current = m_publishedResources.get();
+    const uint32_t frames = m_maxBufferFrames;
+    if (current && current->buffers.frameCapacity() >= frames &&
+        current->buffers.slotCount() >= slots &&
+        current->trackState.size() >= tracks &&
+        current->busState.size() >= buses &&
+        current->nodeCapacity() >= nodes) {
+        return;
+    }
+
+    // Grow by at least half again so adding tracks one by one doesn't reallocate every time.
+    auto grow = [](uint32_t required, size_t have, uint32_t initial) {
+        const uint32_t cur = static_cast<uint32_t>(have);
+        return std::max({required, initial, cur > 0 && required > cur ? cur + cur / 2 : cur});
+    };
+    const uint32_t newSlots = grow(slots, current ? current->buffers.slotCount() : 0, kInitialSlotCapacity);
+    const uint32_t newTracks = grow(tracks, current ? current->trackState.size() : 0, kInitialTrackCapacity);
+    const uint32_t newBuses = grow(buses, current ? current->busState.size() : 0, kInitialBusCapacity);
+    const uint32_t newNodes = grow(nodes, current ? current->nodeCapacity() : 0, kInitialSlotCapacity);
+
+    auto fresh = std::make_unique<RenderResources>(newSlots, frames, newTracks, newBuses, newNodes);
+    RenderResources* unadopted = m_pendingResources.exchange(fresh.get(), std::memory_order_acq_rel);
+    if (unadopted) {
+        // The audio thread never picked up the last set; it is still on m_previousResources.
+        m_publishedResources = std::move(fresh);
+    } else {
+        // The audio thread took (or is taking) the last set. Once it has finished
+        // switching over, nothing references the set before it any more.
+        if (m_publishedResources) {
+            while (m_adoptedResources.load(std::memory_order_acquire) != m_publishedResources.get()) {
+                std::this_thread::yield();
+            }
+        }
+        m_previousResources = std::move(m_publishedResources);
+        m_publishedResources = std::move(fresh);
+    }
+
+    Log::info("AudioEngine: render capacity " + std::to_string(newTracks) + " tracks, " +
+              std::to_string(newBuses) + " buses, " + std::to_string(newSlots) + " slots (" +
+              std::to_string(m_publishedResources->buffers.bytes() / 1024) + " KiB)");
+}
+
+void AudioEngine::adoptPendingResources() {
+    RenderResources* next = m_pendingResources.exchange(nullptr, std::memory_order_acq_rel);
+    if (!next) {
+        return;
+    }
+    if (m_rt) {
+        // Carry smoothing/mute/solo state over; capacities only ever grow.
+        std::copy(m_rt->trackState.begin(), m_rt->trackState.end(), next->trackState.begin());
+        std::copy(m_rt->busState.begin(), m_rt->busState.end(), next->busState.begin());
+    }
+    m_rt = next;
+    m_adoptedResources.store(next, std::memory_order_release);
+}
+
+void AudioEngine::setRenderThreadCount(uint32_t numWorkers) {
+    if (numWorkers == m_renderPool.getWorkerCount()) {
+        return;
+    }
+    if (numWorkers == 0) {
+        m_renderPool.stop();
+    } else {
+        m_renderPool.start(numWorkers);
+    }
+}
+
 uint32_t AudioEngine::copyWaveformHistory(float* outInterleaved, uint32_t maxFrames) const {
     if (!outInterleaved || m_waveformHistoryFrames == 0 || m_waveformHistory.empty()) {
         return 0;
@@ -331,8 +686,6 @@ uint32_t AudioEngine::copyWaveformHistory(float* outInterleaved, uint32_t maxFra
 }
 
 void AudioEngine::renderGraph(const AudioGraph& graph, uint32_t numFrames) {
-    bool srcActiveThisBlock = false;
-
     // Guard
     if (numFrames > m_maxBufferFrames || m_outputChannels != 2) {
         std::memset(m_masterBufferD.data(), 0, 
@@ -341,8 +694,8 @@ void AudioEngine::renderGraph(const AudioGraph& graph, uint32_t numFrames) {
        return;
     }
 
-    const size_t availableTracks = m_trackBuffersD.size();
-    if (availableTracks == 0) {
+    RenderResources* rt = m_rt;
+    if (!rt || numFrames > rt->buffers.frameCapacity()) {
         std::memset(m_masterBufferD.data(), 0,
                     static_cast<size_t>(numFrames) * m_outputChannels * sizeof(double));
         m_telemetry.incrementUnderruns();
@@ -353,274 +706,773 @@ void AudioEngine::renderGraph(const AudioGraph& graph, uint32_t numFrames) {
     std::memset(m_masterBufferD.data(), 0, 
                static_cast<size_t>(numFrames) * m_outputChannels * sizeof(double));
 
-    const uint64_t blockStart = m_globalSamplePos;
-    const uint64_t blockEnd = blockStart + numFrames;
+    const RenderSchedule& schedule = graph.schedule;
+    const uint32_t nodeCount = static_cast<uint32_t>(schedule.nodes.size());
+    if (!schedule.compiled || nodeCount == 0) {
+        return;
+    }
+    if (nodeCount > rt->nodeCapacity() || schedule.bufferCount > rt->buffers.slotCount()) {
+        // Graph published without going through setGraph(); never index past the pools.
+        m_telemetry.incrementOverruns();
+        return;
+    }
+
+    m_renderGraph = &graph;
+    m_renderBlockStart = m_globalSamplePos;
+    m_renderBlockFrames = numFrames;
+    m_renderSrcActive.store(false, std::memory_order_relaxed);
 
     // Solo detection (single pass)
     bool anySolo = false;
     for (const auto& tr : graph.tracks) {
         auto& state = ensureTrackState(tr.trackIndex);
-        if (tr.solo || state.solo) {
+        if (state.soloedFor(tr)) {
             anySolo = true;
             break;
         }
     }
 
-    // Process tracks
-    for (const auto& track : graph.tracks) {
-        const uint32_t trackIdx = track.trackIndex;
-        if (static_cast<size_t>(trackIdx) >= availableTracks) {
-            m_telemetry.incrementOverruns();
-            continue;
+    // Activity pass in schedule order. A track is live only if a clip overlaps
+    // this block, a bus only if one of its inputs is live. Live nodes get arena
+    // slots packed from 0, so the working set scales with what is audible rather
+    // than with the size of the project.
+    const uint64_t blockEnd = m_renderBlockStart + numFrames;
+    uint8_t* active = rt->nodeActive.data();
+    uint32_t* slotMap = rt->slotMap.data();
+    uint32_t nextSlot = 0;
+    uint32_t tracksRendered = 0;
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+        const RenderNode& node = schedule.nodes[n];
+        bool live = false;
+        if (node.type == RenderNode::Type::Track) {
+            const TrackRenderState& track = graph.tracks[node.index];
+            if (track.hasStreamedClips) {
+                cueUpcomingClips(track, blockEnd);
+            }
+            if (static_cast<size_t>(track.trackIndex) >= rt->trackState.size()) {
+                m_telemetry.incrementOverruns();
+            } else {
+                auto& state = ensureTrackState(track.trackIndex);
+                const bool muted = state.mutedFor(track);
+                const bool soloed = state.soloedFor(track);
+                if (!muted && !(anySolo && !soloed)) {
+                    if (track.clips.empty() || track.activeClips(m_renderBlockStart, blockEnd).empty()) {
+                        // Nothing to play this block: don't touch RT buffers. Still keep param
+                        // state updated so automation is consistent when a clip starts.
+                        state.volume.setTarget(static_cast<double>(state.volumeFor(track)));
+                        state.pan.setTarget(static_cast<double>(state.panFor(track)));
+                        state.volume.snap();
+                        state.pan.snap();
+                    } else {
+                        live = true;
+                        ++tracksRendered;
+                    }
+                }
+            }
+        } else {
+            const BusRenderState& bus = graph.buses[node.index];
+            if (!bus.mute && node.index < rt->busState.size()) {
+                for (uint32_t e = 0; e < node.inputCount; ++e) {
+                    if (active[schedule.inputs[node.firstInput + e].sourceNode]) {
+                        live = true;
+                        break;
+                    }
+                }
+            }
+            if (!live && node.index < rt->busState.size()) {
+                auto& state = rt->busState[node.index];
+                state.volume.setTarget(static_cast<double>(bus.volume));
+                state.pan.setTarget(static_cast<double>(bus.pan));
+                state.volume.snap();
+                state.pan.snap();
+            }
         }
-        auto& state = ensureTrackState(trackIdx);
-        
-        // Skip early
-        const bool muted = track.mute || state.mute;
-        const bool soloed = track.solo || state.solo;
-        if (muted || (anySolo && !soloed)) {
+        active[n] = live ? 1 : 0;
+        if (live) {
+            slotMap[node.postSlot] = nextSlot++;
+            if (node.preSlot != kNoBufferSlot) {
+                slotMap[node.preSlot] = nextSlot++;
+            }
+        }
+    }
+    m_telemetry.updateTrackActivity(tracksRendered, static_cast<uint32_t>(graph.tracks.size()));
+
+    // Render level by level. Nodes in one level only read lower levels and write
+    // their own buffers/state, so each level's jobs may run in parallel.
+    const bool parallelAllowed = m_parallelRenderEnabled.load(std::memory_order_relaxed) &&
+                                 m_renderPool.isRunning();
+    const uint32_t minParallel = m_parallelMinTracks.load(std::memory_order_relaxed);
+    bool dispatched = false;
+    const uint32_t levels = schedule.levelCount();
+    for (uint32_t level = 0; level < levels; ++level) {
+        uint32_t jobCount = 0;
+        for (uint32_t n = schedule.levelOffsets[level]; n < schedule.levelOffsets[level + 1]; ++n) {
+            if (active[n]) {
+                rt->renderJobs[jobCount++] = n;
+            }
+        }
+        if (parallelAllowed && jobCount >= minParallel) {
+            m_renderPool.run(&AudioEngine::renderNodeTask, this, jobCount);
+            dispatched = true;
+        } else {
+            for (uint32_t j = 0; j < jobCount; ++j) {
+                renderNode(rt->renderJobs[j]);
+            }
+        }
+    }
+    if (dispatched) {
+        m_telemetry.incrementParallelRenderBlocks();
+    }
+    if (m_stemTaps) {
+        captureStems(schedule, numFrames);
+    }
+
+    // Sum into master in schedule order (deterministic regardless of execution order)
+    double* master = m_masterBufferD.data();
+    const size_t samples = static_cast<size_t>(numFrames) * 2;
+    const AudioKernelTable& kernels = AudioKernels::active();
+    for (const RenderEdge& edge : schedule.masterInputs) {
+        if (!active[edge.sourceNode]) {
             continue;
         }
+        kernels.mix(master, slotBuffer(edge.sourceSlot), edge.gain, samples);
+    }
+
+    if (m_renderSrcActive.load(std::memory_order_relaxed)) {
+        m_telemetry.incrementSrcActiveBlocks();
+    }
+}
 
-        // Empty tracks should not touch RT buffers. Still keep param state updated
-        // so automation is consistent when clips appear later.
-        if (track.clips.empty()) {
-            state.volume.setTarget(static_cast<double>(track.volume));
-            state.pan.setTarget(static_cast<double>(track.pan));
-            state.volume.snap();
-            state.pan.snap();
+void AudioEngine::captureStems(const RenderSchedule& schedule, uint32_t numFrames) {
+    const size_t samples = static_cast<size_t>(numFrames) * 2;
+    const uint8_t* active = m_rt->nodeActive.data();
+    const AudioKernelTable& kernels = AudioKernels::active();
+    const uint32_t nodeCount = static_cast<uint32_t>(schedule.nodes.size());
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+        const RenderNode& node = schedule.nodes[n];
+        if (node.type != RenderNode::Type::Track || node.index >= m_stemTapCount) {
             continue;
         }
-        
-        auto& buffer = m_trackBuffersD[trackIdx];
-        
-        // Clear track buffer with memset
-        std::memset(buffer.data(), 0, static_cast<size_t>(numFrames) * 2 * sizeof(double));
+        float* tap = m_stemTaps[node.index];
+        if (!tap) {
+            continue;
+        }
+        if (active[n]) {
+            kernels.doubleToFloat(tap, slotBuffer(node.postSlot), samples);
+        } else {
+            std::memset(tap, 0, samples * sizeof(float));
+        }
+    }
+}
 
-        // Render clips
-        for (const auto& clip : track.clips) {
-            if (!clip.audioData || blockEnd <= clip.startSample || blockStart >= clip.endSample) {
-                continue;
+void AudioEngine::assignMeterSlots(AudioGraph& graph, ChannelSlotMap& slots) {
+    slots.rebuild(graph);
+    for (RenderNode& node : graph.schedule.nodes) {
+        node.meterSlot = node.type == RenderNode::Type::Track
+                             ? slots.getSlotIndex(graph.tracks[node.index].trackId)
+                             : slots.getBusSlotIndex(graph.buses[node.index].busId);
+    }
+}
+
+uint32_t AudioEngine::getMeterSlot(uint32_t trackId) const {
+    std::lock_guard<std::mutex> lock(m_meterSlotMutex);
+    return m_meterSlots.getSlotIndex(trackId);
+}
+
+void AudioEngine::setLoudnessSnapshots(std::shared_ptr<LoudnessSnapshotBuffer> snapshots, bool perChannel) {
+    // Build the whole set here; the audio thread only ever swaps a pointer.
+    auto fresh = std::make_unique<LoudnessMeters>();
+    if (snapshots) {
+        fresh->snapshots = std::move(snapshots);
+        fresh->master.prepare(static_cast<double>(m_sampleRate));
+        if (perChannel) {
+            fresh->channels.resize(ChannelSlotMap::MAX_CHANNEL_SLOTS);
+            for (auto& meter : fresh->channels) {
+                meter.prepare(static_cast<double>(m_sampleRate));
             }
-            
-            const uint64_t start = std::max(blockStart, clip.startSample);
-            const uint64_t end = std::min(blockEnd, clip.endSample);
-            const uint32_t localOffset = static_cast<uint32_t>(start - blockStart);
-            uint32_t framesToRender = static_cast<uint32_t>(end - start);
-            
-            // Sample rate ratio
-            const double outputRate = static_cast<double>(m_sampleRate);
-            const double srcRate = clip.sourceSampleRate > 0.0 ? clip.sourceSampleRate : outputRate;
-            const double ratio = srcRate / outputRate;
-            
-            // Source position
-            const double outputFrameOffset = static_cast<double>(start - clip.startSample);
-            double phase = static_cast<double>(clip.sampleOffset) + outputFrameOffset * ratio;
-
-            // Bounds
-            const int64_t totalFrames = static_cast<int64_t>(clip.totalFrames);
-            if (totalFrames > 0 && phase >= static_cast<double>(totalFrames)) {
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_loudnessMutex);
+    LoudnessMeters* unadopted = m_pendingLoudness.exchange(fresh.get(), std::memory_order_acq_rel);
+    if (unadopted) {
+        // The audio thread never picked up the last set; it is still on m_previousLoudness.
+        m_publishedLoudness = std::move(fresh);
+        return;
+    }
+    // The audio thread took (or is taking) the last set. Once it has finished
+    // switching over, it no longer meters into the set before it.
+    if (m_publishedLoudness) {
+        while (m_adoptedLoudness.load(std::memory_order_acquire) != m_publishedLoudness.get()) {
+            std::this_thread::yield();
+        }
+    }
+    m_previousLoudness = std::move(m_publishedLoudness);
+    m_publishedLoudness = std::move(fresh);
+}
+
+LoudnessSnapshotBuffer* AudioEngine::getLoudnessSnapshots() const {
+    std::lock_guard<std::mutex> lock(m_loudnessMutex);
+    return m_publishedLoudness ? m_publishedLoudness->snapshots.get() : nullptr;
+}
+
+void AudioEngine::adoptPendingLoudness() noexcept {
+    LoudnessMeters* next = m_pendingLoudness.exchange(nullptr, std::memory_order_acq_rel);
+    if (!next) {
+        return;
+    }
+    m_loudness = next->snapshots ? next : nullptr;
+    m_adoptedLoudness.store(next, std::memory_order_release);
+}
+
+void AudioEngine::prepareLoudnessMeters() noexcept {
+    const bool reset = m_loudnessResetPending.exchange(false, std::memory_order_relaxed);
+    const double rate = static_cast<double>(m_sampleRate);
+    if (reset || m_loudness->master.sampleRate() != rate) {
+        m_loudness->master.prepare(rate);
+    }
+    for (auto& meter : m_loudness->channels) {
+        if (reset || meter.sampleRate() != rate) {
+            meter.prepare(rate);
+        }
+    }
+}
+
+void AudioEngine::meterNode(uint32_t nodeIndex, const RenderNode& node) noexcept {
+    const double* data = slotBuffer(node.postSlot);
+    if (m_meterSnapshots) {
+        StereoLevels block;
+        AudioKernels::active().measure(data, m_renderBlockFrames, block);
+        StereoLevels& levels = m_rt->nodeLevels[nodeIndex];
+        levels.peakL = std::max(levels.peakL, block.peakL);
+        levels.peakR = std::max(levels.peakR, block.peakR);
+        levels.sumSqL += block.sumSqL;
+        levels.sumSqR += block.sumSqR;
+    }
+    if (m_loudness && node.meterSlot < m_loudness->channels.size()) {
+        m_loudness->channels[node.meterSlot].process(data, m_renderBlockFrames);
+        m_rt->nodeMeteredFrames[nodeIndex] += m_renderBlockFrames;
+    }
+}
+
+void AudioEngine::publishMeters(const AudioGraph& graph, uint32_t numFrames, const StereoLevels& master) noexcept {
+    // Nodes that rendered nothing this block publish zero, so their meters fall;
+    // their loudness meters see the missing frames as silence.
+    const double invN = 1.0 / static_cast<double>(numFrames);
+    auto publish = [&](uint32_t slot, const StereoLevels& levels) {
+        MeterSnapshotBuffer& meters = *m_meterSnapshots;
+        const float peakL = static_cast<float>(levels.peakL);
+        const float peakR = static_cast<float>(levels.peakR);
+        meters.writeLevels(slot, peakL, peakR,
+                           static_cast<float>(std::sqrt(levels.sumSqL * invN)),
+                           static_cast<float>(std::sqrt(levels.sumSqR * invN)));
+        if (peakL >= 1.0f || peakR >= 1.0f) {
+            meters.setClip(slot, peakL >= 1.0f, peakR >= 1.0f);
+        }
+    };
+
+    if (m_rt) {
+        const size_t nodeCount = std::min(graph.schedule.nodes.size(), m_rt->nodeLevels.size());
+        for (size_t n = 0; n < nodeCount; ++n) {
+            const uint32_t slot = graph.schedule.nodes[n].meterSlot;
+            if (slot == kNoMeterSlot) {
                 continue;
             }
-            if (totalFrames > 0) {
-                const double remaining = static_cast<double>(totalFrames) - phase;
-                const uint32_t maxFrames = static_cast<uint32_t>(remaining / ratio);
-                framesToRender = std::min(framesToRender, maxFrames);
-            }
-            if (framesToRender == 0) continue;
-
-            const float* data = clip.audioData;
-            double* dst = buffer.data() + static_cast<size_t>(localOffset) * 2;
-
-            const uint64_t fadeLen = CLIP_EDGE_FADE_SAMPLES;
-
-            // Fast path: matching sample rates - direct copy to double
-            if (std::abs(ratio - 1.0) < 1e-9) {
-                const uint64_t srcStart = static_cast<uint64_t>(phase);
-                const float* src = data + srcStart * 2;
-                const double clipGain = static_cast<double>(clip.gain);
-                for (uint32_t i = 0; i < framesToRender; ++i) {
-                    // Micro-fade at clip edges to avoid clicks/crackles.
-                    double fade = 1.0;
-                    const uint64_t projectSample = start + i;
-                    if (fadeLen > 0) {
-                        if (projectSample < clip.startSample + fadeLen) {
-                            fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                        }
-                        if (projectSample + fadeLen > clip.endSample) {
-                            fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                        }
-                    }
-                    dst[i * 2] = static_cast<double>(src[i * 2]) * clipGain * fade;
-                    dst[i * 2 + 1] = static_cast<double>(src[i * 2 + 1]) * clipGain * fade;
-                }
-            } else {
-                srcActiveThisBlock = true;
-                // Resampling - use selected quality, pre-compute end condition
-                const double phaseEnd = static_cast<double>(totalFrames);
-                
-                // Select interpolator at block level, not per-sample
-                switch (m_interpQuality) {
-                    case Interpolators::InterpolationQuality::Cubic:
-                        for (uint32_t i = 0; i < framesToRender && phase < phaseEnd; ++i) {
-                            float outL, outR;
-                            Interpolators::CubicInterpolator::interpolate(data, totalFrames, phase, outL, outR);
-                            double fade = 1.0;
-                            const uint64_t projectSample = start + i;
-                            if (fadeLen > 0) {
-                                if (projectSample < clip.startSample + fadeLen) {
-                                    fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                                }
-                                if (projectSample + fadeLen > clip.endSample) {
-                                    fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                                }
-                            }
-                            const double clipGain = static_cast<double>(clip.gain);
-                            dst[i * 2] = static_cast<double>(outL) * clipGain * fade;
-                            dst[i * 2 + 1] = static_cast<double>(outR) * clipGain * fade;
-                            phase += ratio;
-                        }
-                        break;
-                    case Interpolators::InterpolationQuality::Sinc8:
-                        for (uint32_t i = 0; i < framesToRender && phase < phaseEnd; ++i) {
-                            float outL, outR;
-                            Interpolators::Sinc8Interpolator::interpolate(data, totalFrames, phase, outL, outR);
-                            double fade = 1.0;
-                            const uint64_t projectSample = start + i;
-                            if (fadeLen > 0) {
-                                if (projectSample < clip.startSample + fadeLen) {
-                                    fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                                }
-                                if (projectSample + fadeLen > clip.endSample) {
-                                    fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                                }
-                            }
-                            const double clipGain = static_cast<double>(clip.gain);
-                            dst[i * 2] = static_cast<double>(outL) * clipGain * fade;
-                            dst[i * 2 + 1] = static_cast<double>(outR) * clipGain * fade;
-                            phase += ratio;
-                        }
-                        break;
-                    case Interpolators::InterpolationQuality::Sinc16:
-                        for (uint32_t i = 0; i < framesToRender && phase < phaseEnd; ++i) {
-                            float outL, outR;
-                            Interpolators::Sinc16Interpolator::interpolate(data, totalFrames, phase, outL, outR);
-                            double fade = 1.0;
-                            const uint64_t projectSample = start + i;
-                            if (fadeLen > 0) {
-                                if (projectSample < clip.startSample + fadeLen) {
-                                    fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                                }
-                                if (projectSample + fadeLen > clip.endSample) {
-                                    fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                                }
-                            }
-                            const double clipGain = static_cast<double>(clip.gain);
-                            dst[i * 2] = static_cast<double>(outL) * clipGain * fade;
-                            dst[i * 2 + 1] = static_cast<double>(outR) * clipGain * fade;
-                            phase += ratio;
-                        }
-                        break;
-                    case Interpolators::InterpolationQuality::Sinc32:
-                        for (uint32_t i = 0; i < framesToRender && phase < phaseEnd; ++i) {
-                            float outL, outR;
-                            Interpolators::Sinc32Interpolator::interpolate(data, totalFrames, phase, outL, outR);
-                            double fade = 1.0;
-                            const uint64_t projectSample = start + i;
-                            if (fadeLen > 0) {
-                                if (projectSample < clip.startSample + fadeLen) {
-                                    fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                                }
-                                if (projectSample + fadeLen > clip.endSample) {
-                                    fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                                }
-                            }
-                            const double clipGain = static_cast<double>(clip.gain);
-                            dst[i * 2] = static_cast<double>(outL) * clipGain * fade;
-                            dst[i * 2 + 1] = static_cast<double>(outR) * clipGain * fade;
-                            phase += ratio;
-                        }
-                        break;
-                    case Interpolators::InterpolationQuality::Sinc64:
-                        for (uint32_t i = 0; i < framesToRender && phase < phaseEnd; ++i) {
-                            float outL, outR;
-                            Interpolators::Sinc64Interpolator::interpolate(data, totalFrames, phase, outL, outR);
-                            double fade = 1.0;
-                            const uint64_t projectSample = start + i;
-                            if (fadeLen > 0) {
-                                if (projectSample < clip.startSample + fadeLen) {
-                                    fade = std::min(fade, (static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen)));
-                                }
-                                if (projectSample + fadeLen > clip.endSample) {
-                                    fade = std::min(fade, (static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen)));
-                                }
-                            }
-                            const double clipGain = static_cast<double>(clip.gain);
-                            dst[i * 2] = static_cast<double>(outL) * clipGain * fade;
-                            dst[i * 2 + 1] = static_cast<double>(outR) * clipGain * fade;
-                            phase += ratio;
-                        }
-                        break;
-                }
+            if (m_meterSnapshots) {
+                publish(slot, m_rt->nodeLevels[n]);
+                m_rt->nodeLevels[n] = StereoLevels{};
+            }
+            if (m_loudness && slot < m_loudness->channels.size()) {
+                LoudnessMeter& meter = m_loudness->channels[slot];
+                meter.processSilence(numFrames - std::min(numFrames, m_rt->nodeMeteredFrames[n]));
+                m_rt->nodeMeteredFrames[n] = 0;
+                m_loudness->snapshots->write(slot, meter.readings());
             }
         }
+    }
+    if (m_meterSnapshots) {
+        publish(ChannelSlotMap::MASTER_SLOT_INDEX, master);
+    }
+    if (m_loudness) {
+        m_loudness->snapshots->write(ChannelSlotMap::MASTER_SLOT_INDEX, m_loudness->master.readings());
+    }
+}
 
-        // Mix track into master - PRE-COMPUTE gains per block to avoid per-sample trig
-        state.volume.setTarget(static_cast<double>(track.volume));
-        state.pan.setTarget(static_cast<double>(track.pan));
-        
-        // Get current smoothed values
-        const double vol = state.volume.current;
-        const double pan = state.pan.current;
-        const double volTarget = static_cast<double>(track.volume);
-        const double panTarget = static_cast<double>(track.pan);
-        
-        // Pre-compute start/end gains (linear interpolation across block)
-        const double panAngleStart = (pan + 1.0) * QUARTER_PI_D;
-        const double panAngleEnd = (panTarget + 1.0) * QUARTER_PI_D;
-        
-        const double leftGainStart = std::cos(panAngleStart) * vol;
-        const double rightGainStart = std::sin(panAngleStart) * vol;
-        const double leftGainEnd = std::cos(panAngleEnd) * volTarget;
-        const double rightGainEnd = std::sin(panAngleEnd) * volTarget;
-        
-        // Linear interpolation of gains across block (cheap, smooth)
-        const double leftGainDelta = (leftGainEnd - leftGainStart) / static_cast<double>(numFrames);
-        const double rightGainDelta = (rightGainEnd - rightGainStart) / static_cast<double>(numFrames);
+void AudioEngine::renderNodeTask(void* context, uint32_t jobIndex) {
+    auto* engine = static_cast<AudioEngine*>(context);
+    engine->renderNode(engine->m_rt->renderJobs[jobIndex]);
+}
+
+void AudioEngine::renderNode(uint32_t nodeIndex) {
+    const AudioGraph& graph = *m_renderGraph;
+    const RenderNode& node = graph.schedule.nodes[nodeIndex];
+    if (node.type == RenderNode::Type::Track) {
+        renderTrack(node, graph.tracks[node.index]);
+    } else {
+        renderBus(node, graph.buses[node.index]);
+    }
+    if ((m_meterSnapshots || (m_loudness && !m_loudness->channels.empty())) && node.meterSlot != kNoMeterSlot) {
+        meterNode(nodeIndex, node);
+    }
+}
+
+void AudioEngine::renderBus(const RenderNode& node, const BusRenderState& bus) {
+    const uint32_t numFrames = m_renderBlockFrames;
+    const size_t samples = static_cast<size_t>(numFrames) * 2;
+    const RenderSchedule& schedule = m_renderGraph->schedule;
+    const uint8_t* active = m_rt->nodeActive.data();
+    double* data = slotBuffer(node.postSlot);
+
+    const AudioKernelTable& kernels = AudioKernels::active();
+    std::memset(data, 0, samples * sizeof(double));
+    for (uint32_t e = 0; e < node.inputCount; ++e) {
+        const RenderEdge& edge = schedule.inputs[node.firstInput + e];
+        if (active[edge.sourceNode]) {
+            kernels.mix(data, slotBuffer(edge.sourceSlot), edge.gain, samples);
+        }
+    }
+
+    if (node.preSlot != kNoBufferSlot) {
+        std::memcpy(slotBuffer(node.preSlot), data, samples * sizeof(double));
+    }
+    applyFaderPan(data, numFrames, m_rt->busState[node.index], bus.volume, bus.pan);
+}
+
+void AudioEngine::renderTrack(const RenderNode& node, const TrackRenderState& track) {
+    const uint32_t numFrames = m_renderBlockFrames;
+    const uint64_t blockStart = m_renderBlockStart;
+    const uint64_t blockEnd = blockStart + numFrames;
+    auto& state = ensureTrackState(track.trackIndex);
+    
+    double* buffer = slotBuffer(node.postSlot);
+    bool srcActive = false;
+    const AudioKernelTable& kernels = AudioKernels::active();
+    const SRCQuality quality = m_resampleQuality.load(std::memory_order_relaxed);
+    
+    // Clear track buffer with memset
+    std::memset(buffer, 0, static_cast<size_t>(numFrames) * 2 * sizeof(double));
+
+    // Render clips overlapping this block (interval index narrows the candidates).
+    // Clips start in order, so a clip either begins past the frames written so far
+    // and renders in place, or overlaps them (a crossfade) and is rendered aside and summed.
+    uint32_t writtenEnd = 0;
+    const ClipIntervalIndex::Range range = track.activeClips(blockStart, blockEnd);
+    for (uint32_t c = range.first; c < range.last; ++c) {
+        const ClipRenderState& clip = track.clips[c];
+        if ((!clip.audioData && !clip.packedData && !clip.stream) ||
+            blockEnd <= clip.startSample || blockStart >= clip.endSample) {
+            continue;
+        }
         
-        double leftGain = leftGainStart;
-        double rightGain = rightGainStart;
+        const uint64_t start = std::max(blockStart, clip.startSample);
+        const uint64_t end = std::min(blockEnd, clip.endSample);
+        const uint32_t localOffset = static_cast<uint32_t>(start - blockStart);
+        uint32_t framesToRender = static_cast<uint32_t>(end - start);
         
-        const double* trackData = buffer.data();
-        double* master = m_masterBufferD.data();
+        // Sample rate ratio (playback rate included)
+        const double outputRate = static_cast<double>(m_sampleRate);
+        const double ratio = clip.readRate(outputRate) / outputRate;
         
-        for (uint32_t i = 0; i < numFrames; ++i) {
-            master[i * 2] += trackData[i * 2] * leftGain;
-            master[i * 2 + 1] += trackData[i * 2 + 1] * rightGain;
-            leftGain += leftGainDelta;
-            rightGain += rightGainDelta;
+        // Source position
+        const double outputFrameOffset = static_cast<double>(start - clip.startSample);
+        const double phase = static_cast<double>(clip.sampleOffset) + outputFrameOffset * ratio;
+
+        // Bounds (a looping clip plays until its end on the timeline)
+        const int64_t totalFrames = clip.loopFrames > 0 ? 0 : static_cast<int64_t>(clip.totalFrames);
+        if (totalFrames > 0 && phase >= static_cast<double>(totalFrames)) {
+            continue;
+        }
+        if (totalFrames > 0) {
+            const double remaining = static_cast<double>(totalFrames) - phase;
+            const uint32_t maxFrames = static_cast<uint32_t>(remaining / ratio);
+            framesToRender = std::min(framesToRender, maxFrames);
+        }
+        if (framesToRender == 0) continue;
+
+        double* dst = buffer + static_cast<size_t>(localOffset) * 2;
+        srcActive |= clip.resampleRate(outputRate) != outputRate;
+        const uint64_t clipFrame = start - clip.startSample;
+        bool streamComplete = true;
+        if (localOffset >= writtenEnd) {
+            streamComplete = renderClipSource(clip, phase, clipFrame, ratio, quality, dst, framesToRender);
+            applyClipGain(dst, framesToRender, start, clip);
+        } else {
+            alignas(64) double scratch[CLIP_MIX_CHUNK_FRAMES * 2];
+            for (uint32_t done = 0; done < framesToRender;) {
+                const uint32_t n = std::min(framesToRender - done, CLIP_MIX_CHUNK_FRAMES);
+                streamComplete &= renderClipSource(clip, phase + done * ratio, clipFrame + done, ratio, quality,
+                                                   scratch, n);
+                applyClipGain(scratch, n, start + done, clip);
+                kernels.mix(dst + static_cast<size_t>(done) * 2, scratch, 1.0, static_cast<size_t>(n) * 2);
+                done += n;
+            }
+        }
+        writtenEnd = std::max(writtenEnd, localOffset + framesToRender);
+        if (clip.stream) {
+            m_telemetry.recordStreamRead(streamComplete);
         }
-        
-        // Snap smoothed params to target for next block
-        state.volume.snap();
-        state.pan.snap();
     }
 
-    if (srcActiveThisBlock) {
-        m_telemetry.incrementSrcActiveBlocks();
+    if (node.preSlot != kNoBufferSlot) {
+        std::memcpy(slotBuffer(node.preSlot), buffer,
+                    static_cast<size_t>(numFrames) * 2 * sizeof(double));
+    }
+    applyFaderPan(buffer, numFrames, state, state.volumeFor(track), state.panFor(track));
+
+    if (srcActive) {
+        m_renderSrcActive.store(true, std::memory_order_relaxed);
     }
 }
 
-AudioEngine::TrackRTState& AudioEngine::ensureTrackState(uint32_t trackIndex) {
-    if (m_trackState.empty()) {
-        static TrackRTState dummy;
-        return dummy;
+struct AudioEngine::GrainReadContext {
+    const AudioEngine* engine;
+    const ClipRenderState* clip;
+    SRCQuality quality;
+};
+
+bool AudioEngine::renderClipSource(const ClipRenderState& clip, double phase, uint64_t clipFrame, double ratio,
+                                   SRCQuality quality, double* dst, uint32_t frames) const noexcept {
+    if (!clip.stretcher || !clip.stretched()) {
+        return readClip(clip, phase, ratio, quality, dst, frames);
+    }
+    // Grains advance at the clip's tempo and are read at its pitch.
+    const double outputRate = static_cast<double>(m_sampleRate);
+    GrainReadContext context{this, &clip, quality};
+    return clip.stretcher->process(&AudioEngine::readGrain, &context, static_cast<double>(clip.sampleOffset), ratio,
+                                   clip.resampleRate(outputRate) / outputRate, clipFrame, dst, frames);
+}
+
+bool AudioEngine::readGrain(void* context, double position, double step, double* dst, uint32_t frames) noexcept {
+    const auto& read = *static_cast<const GrainReadContext*>(context);
+    return read.engine->readClip(*read.clip, position, step, read.quality, dst, frames);
+}
+
+bool AudioEngine::readClip(const ClipRenderState& clip, double phase, double step, SRCQuality quality,
+                           double* dst, uint32_t frames) const noexcept {
+    if (!clip.reversed && clip.loopFrames == 0) {
+        return readSpan(clip, phase, step, quality, dst, frames);
+    }
+    const double outputRate = static_cast<double>(m_sampleRate);
+    const double span = clipSpan(clip, clip.readRate(outputRate) / outputRate);
+    if (span <= 0.0) {
+        std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+        return true;
+    }
+
+    // Split at every wrap: each pass is one contiguous run of source frames.
+    const double offset = phase - static_cast<double>(clip.sampleOffset);
+    bool complete = true;
+    for (uint32_t done = 0; done < frames;) {
+        const double position = offset + static_cast<double>(done) * step;
+        const double pass = clip.loopFrames > 0 ? std::floor(position / span) : 0.0;
+        const double within = position - pass * span;
+        uint32_t n = frames - done;
+        if (clip.loopFrames > 0) {
+            const double untilWrap = std::ceil((span - within) / step);
+            n = static_cast<uint32_t>(std::min(static_cast<double>(n), std::max(1.0, untilWrap)));
+        }
+        double* out = dst + static_cast<size_t>(done) * 2;
+        complete &= readPass(clip, within, span, step, quality, out, n);
+        if (clip.loopFrames > 0) {
+            complete &= blendLoopSeam(clip, within, span, pass > 0.0, step, quality, out, n);
+        }
+        done += n;
     }
-    if (trackIndex >= m_trackState.size()) {
+    return complete;
+}
+
+bool AudioEngine::readPass(const ClipRenderState& clip, double within, double span, double step,
+                           SRCQuality quality, double* dst, uint32_t frames) const noexcept {
+    const double origin = static_cast<double>(clip.sampleOffset);
+    if (!clip.reversed) {
+        return readSpan(clip, origin + within, step, quality, dst, frames);
+    }
+
+    // Backward: read the same frames forward from the far end, then flip them in place.
+    const double last = within + static_cast<double>(frames - 1) * step;
+    const bool complete = readSpan(clip, origin + span - 1.0 - last, step, quality, dst, frames);
+    for (uint32_t i = 0, j = frames - 1; i < j; ++i, --j) {
+        std::swap(dst[i * 2], dst[j * 2]);
+        std::swap(dst[i * 2 + 1], dst[j * 2 + 1]);
+    }
+    return complete;
+}
+
+bool AudioEngine::blendLoopSeam(const ClipRenderState& clip, double within, double span, bool wrapped,
+                                double step, SRCQuality quality, double* dst, uint32_t frames) const noexcept {
+    const AudioKernelTable& kernels = AudioKernels::active();
+    const double seam = std::min(static_cast<double>(LOOP_SEAM_FRAMES), std::floor(span / 2.0));
+    if (seam < 1.0) {
+        return true;
+    }
+    // The next pass continues from the material just outside the loop: before it when
+    // playing forward, after it when reversed. Without that material the seam dips instead.
+    const double origin = static_cast<double>(clip.sampleOffset);
+    const bool preRoll = clip.reversed ? origin + span + seam <= static_cast<double>(clip.totalFrames)
+                                       : origin >= seam;
+
+    bool complete = true;
+    const double fadeStart = span - seam;
+    const double last = within + static_cast<double>(frames - 1) * step;
+    if (last >= fadeStart) {
+        const uint32_t first = within >= fadeStart
+            ? 0 : static_cast<uint32_t>(std::ceil((fadeStart - within) / step));
+        const double t0 = (within + static_cast<double>(first) * step - fadeStart) / seam;
+        const double dt = step / seam;
+        double* out = dst + static_cast<size_t>(first) * 2;
+        const uint32_t count = frames - first;
+        kernels.applyGainRamp(out, count, StereoRamp{1.0 - t0, 1.0 - t0, -dt, -dt});
+        if (preRoll) {
+            alignas(64) double incoming[CLIP_MIX_CHUNK_FRAMES * 2];
+            for (uint32_t done = 0; done < count;) {
+                const uint32_t n = std::min(count - done, CLIP_MIX_CHUNK_FRAMES);
+                const double from = within + static_cast<double>(first + done) * step - span;
+                complete &= readPass(clip, from, span, step, quality, incoming, n);
+                const double t = t0 + static_cast<double>(done) * dt;
+                kernels.mixGainRamp(out + static_cast<size_t>(done) * 2, incoming, n, StereoRamp{t, t, dt, dt});
+                done += n;
+            }
+        }
+    }
+    if (!preRoll && wrapped && within < seam) {
+        const double untilFaded = std::ceil((seam - within) / step);
+        const uint32_t count = static_cast<uint32_t>(std::min(static_cast<double>(frames), untilFaded));
+        kernels.applyGainRamp(dst, count, StereoRamp{within / seam, within / seam, step / seam, step / seam});
+    }
+    return complete;
+}
+
+double AudioEngine::clipSpan(const ClipRenderState& clip, double ratio) noexcept {
+    if (clip.loopFrames > 0) {
+        return static_cast<double>(clip.loopFrames);
+    }
+    // A reversed clip plays its trimmed span from the far end.
+    const double length = std::ceil(static_cast<double>(clip.endSample - clip.startSample) * ratio);
+    const double available = static_cast<double>(clip.totalFrames) - static_cast<double>(clip.sampleOffset);
+    return std::max(0.0, std::min(length, available));
+}
+
+bool AudioEngine::readSpan(const ClipRenderState& clip, double phase, double step, SRCQuality quality,
+                           double* dst, uint32_t frames) const noexcept {
+    if (std::abs(step - 1.0) < 1e-9) {
+        // Time-stretch grains reach past both ends of the source; those frames are silence.
+        const double total = static_cast<double>(clip.totalFrames);
+        const double start = std::floor(phase);
+        if (clip.totalFrames > 0 && (start < 0.0 || start + frames > total)) {
+            std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+            const double first = std::max(0.0, -start);
+            const double last = std::min(static_cast<double>(frames), total - start);
+            if (last <= first) {
+                return true;
+            }
+            const uint32_t skip = static_cast<uint32_t>(first);
+            return readSpan(clip, start + first, step, quality, dst + static_cast<size_t>(skip) * 2,
+                            static_cast<uint32_t>(last) - skip);
+        }
+        // Fast path: matching sample rates - direct copy to double
+        if (clip.audioData) {
+            const float* src = clip.audioData + static_cast<uint64_t>(phase) * 2;
+            AudioKernels::active().floatToDouble(dst, src, static_cast<size_t>(frames) * 2);
+            return true;
+        }
+        if (clip.packedData) {
+            readPacked(clip, static_cast<uint64_t>(phase), frames, dst);
+            return true;
+        }
+        return readStream(*clip.stream, static_cast<uint64_t>(phase), frames, dst);
+    }
+
+    const double outputRate = static_cast<double>(m_sampleRate);
+    const ClipResampler* resampler = clip.resampler.get();
+    if (!resampler || !resampler->matches(clip.resampleRate(outputRate), outputRate, quality)) {
+        // Not prepared by setGraph() (graph swapped in directly, or the rate changed since).
+        resampler = &m_defaultResamplers[static_cast<size_t>(quality)];
+    }
+    if (clip.audioData) {
+        resampler->process(clip.audioData, clip.totalFrames, phase, step, dst, frames);
+        return true;
+    }
+    if (clip.packedData) {
+        resampler->process(clip.packedData, clip.packedSampleBytes, clip.totalFrames, phase, step, dst, frames);
+        return true;
+    }
+    return resampler->process(*clip.stream, phase, step, dst, frames);
+}
+
+bool AudioEngine::readStream(StreamingSource& stream, uint64_t start, uint32_t frames, double* dst) noexcept {
+    constexpr uint32_t kChunkFrames = 512;
+    alignas(64) float chunk[kChunkFrames * 2];
+    const AudioKernelTable& kernels = AudioKernels::active();
+    bool complete = true;
+    for (uint32_t done = 0; done < frames;) {
+        const uint32_t n = std::min(frames - done, kChunkFrames);
+        complete &= stream.read(start + done, n, chunk);
+        kernels.floatToDouble(dst + static_cast<size_t>(done) * 2, chunk, static_cast<size_t>(n) * 2);
+        done += n;
+    }
+    return complete;
+}
+
+void AudioEngine::readPacked(const ClipRenderState& clip, uint64_t start, uint32_t frames, double* dst) noexcept {
+    constexpr uint32_t kChunkFrames = 512;
+    alignas(64) float chunk[kChunkFrames * 2];
+    const AudioKernelTable& kernels = AudioKernels::active();
+    const uint32_t bytes = clip.packedSampleBytes;
+    for (uint32_t done = 0; done < frames;) {
+        const uint32_t n = std::min(frames - done, kChunkFrames);
+        kernels.unpack(chunk, clip.packedData + (start + done) * 2 * bytes, bytes, static_cast<size_t>(n) * 2);
+        kernels.floatToDouble(dst + static_cast<size_t>(done) * 2, chunk, static_cast<size_t>(n) * 2);
+        done += n;
+    }
+}
+
+void AudioEngine::cueUpcomingClips(const TrackRenderState& track, uint64_t blockEnd) const noexcept {
+    // Clips starting within the look-ahead get their first frames loaded before
+    // the playhead reaches them (cue() returns at once when they already are).
+    const uint64_t lookAhead = static_cast<uint64_t>(m_sampleRate) * STREAM_CUE_SECONDS;
+    const ClipIntervalIndex::Range range = track.activeClips(blockEnd, blockEnd + lookAhead);
+    for (uint32_t c = range.first; c < range.last; ++c) {
+        const ClipRenderState& clip = track.clips[c];
+        if (clip.stream && clip.startSample >= blockEnd) {
+            // Back off by the widest resampler's lead-in so its first window is loaded too.
+            // The time until the clip starts is its I/O deadline.
+            const uint64_t lead = ClipResampler::tapsFor(SRCQuality::Sinc64) / 2;
+            const double secondsUntilStart = static_cast<double>(clip.startSample - blockEnd) /
+                                             static_cast<double>(m_sampleRate);
+            // A reversed clip starts from the far end of its span.
+            uint64_t first = clip.sampleOffset;
+            if (clip.reversed) {
+                const double step = clip.readRate(static_cast<double>(m_sampleRate)) / static_cast<double>(m_sampleRate);
+                first += static_cast<uint64_t>(std::max(0.0, clipSpan(clip, step) - 1.0));
+            }
+            clip.stream->cue(first > lead ? first - lead : 0, secondsUntilStart);
+        }
+    }
+}
+
+void AudioEngine::cueStreams(uint64_t position) const {
+    const AudioGraph graph = m_state.copyActiveGraph();
+    const double outputRate = static_cast<double>(m_sampleRate);
+    const uint64_t lead = ClipResampler::tapsFor(SRCQuality::Sinc64) / 2;
+    for (const TrackRenderState& track : graph.tracks) {
+        if (!track.hasStreamedClips) {
+            continue;
+        }
+        cueUpcomingClips(track, position);
+        const ClipIntervalIndex::Range range = track.activeClips(position, position + 1);
+        for (uint32_t c = range.first; c < range.last; ++c) {
+            const ClipRenderState& clip = track.clips[c];
+            if (!clip.stream || clip.startSample >= position || clip.endSample <= position) {
+                continue;
+            }
+            // Where the clip reads at position, as readClip() maps it.
+            const double step = clip.readRate(outputRate) / outputRate;
+            const double span = clipSpan(clip, step);
+            if (span <= 0.0) {
+                continue;
+            }
+            double within = static_cast<double>(position - clip.startSample) * step;
+            if (clip.loopFrames > 0) {
+                within = std::fmod(within, span);
+            } else if (within >= span) {
+                continue;
+            }
+            const double frame = static_cast<double>(clip.sampleOffset) +
+                                 (clip.reversed ? std::max(0.0, span - 1.0 - within) : within);
+            const uint64_t first = static_cast<uint64_t>(frame);
+clip.stream->cue(first > lead ? first - lead : 0, 0.0);
+        }
+    }
+}
+
+void AudioEngine::applyClipGain(double* data, uint32_t numFrames, uint64_t start, const ClipRenderState& clip) {
+    const AudioKernelTable& kernels = AudioKernels::active();
+    const uint64_t end = start + numFrames;
+    const double clipGain = static_cast<double>(clip.gain);
+    if (clipGain != 1.0 || clip.pan != 0.0f) {
+        const double left = clip.pan > 0.0f ? 1.0 - static_cast<double>(clip.pan) : 1.0;
+        const double right = clip.pan < 0.0f ? 1.0 + static_cast<double>(clip.pan) : 1.0;
+        kernels.applyGainRamp(data, numFrames, StereoRamp{clipGain * left, clipGain * right, 0.0, 0.0});
+    }
+
+    // Clip fades: one linear ramp over the frames each covers.
+    if (clip.fadeInSamples > 0 && start < clip.startSample + clip.fadeInSamples) {
+        const uint64_t rampEnd = std::min(end, clip.startSample + clip.fadeInSamples);
+        const double step = 1.0 / static_cast<double>(clip.fadeInSamples);
+        const double gain = static_cast<double>(start - clip.startSample) * step;
+        kernels.applyGainRamp(data, static_cast<uint32_t>(rampEnd - start), StereoRamp{gain, gain, step, step});
+    }
+    if (clip.fadeOutSamples > 0 && end + clip.fadeOutSamples > clip.endSample) {
+        const uint64_t fadeStart = clip.endSample > clip.fadeOutSamples ? clip.endSample - clip.fadeOutSamples : 0;
+        const uint64_t rampStart = std::max(start, fadeStart);
+        const double step = 1.0 / static_cast<double>(clip.fadeOutSamples);
+        const double gain = static_cast<double>(clip.endSample - rampStart) * step;
+        kernels.applyGainRamp(data + static_cast<size_t>(rampStart - start) * 2,
+                              static_cast<uint32_t>(end - rampStart), StereoRamp{gain, gain, -step, -step});
+    }
+
+    // Micro-fade at clip edges to avoid clicks/crackles; only frames near an edge are touched.
+    const uint64_t fadeLen = CLIP_EDGE_FADE_SAMPLES;
+    const uint64_t fadeInEnd = std::min(end, clip.startSample + fadeLen);
+    const uint64_t fadeOutStart = std::max(start, clip.endSample > fadeLen ? clip.endSample - fadeLen : 0);
+    auto fadeFrame = [&](uint64_t projectSample) {
+        double fade = 1.0;
+        if (projectSample < clip.startSample + fadeLen) {
+            fade = std::min(fade, static_cast<double>(projectSample - clip.startSample) / static_cast<double>(fadeLen));
+        }
+        if (projectSample + fadeLen > clip.endSample) {
+            fade = std::min(fade, static_cast<double>(clip.endSample - projectSample) / static_cast<double>(fadeLen));
+        }
+        const size_t i = static_cast<size_t>(projectSample - start) * 2;
+        data[i] *= fade;
+        data[i + 1] *= fade;
+    };
+    for (uint64_t s = start; s < fadeInEnd; ++s) {
+        fadeFrame(s);
+    }
+    for (uint64_t s = std::max(fadeOutStart, fadeInEnd); s < end; ++s) {
+        fadeFrame(s);
+    }
+}
+
+void AudioEngine::applyFaderPan(double* data, uint32_t numFrames, TrackRTState& state,
+                                float volume, float panValue) {
+    // Apply fader/pan in place - PRE-COMPUTE gains per block to avoid per-sample trig
+    state.volume.setTarget(static_cast<double>(volume));
+    state.pan.setTarget(static_cast<double>(panValue));
+    
+    // Get current smoothed values
+    const double vol = state.volume.current;
+    const double pan = state.pan.current;
+    const double volTarget = static_cast<double>(volume);
+    const double panTarget = static_cast<double>(panValue);
+    
+    // Pre-compute start/end gains (linear interpolation across block)
+    const double panAngleStart = (pan + 1.0) * QUARTER_PI_D;
+    const double panAngleEnd = (panTarget + 1.0) * QUARTER_PI_D;
+    
+    const double leftGainStart = std::cos(panAngleStart) * vol;
+    const double rightGainStart = std::sin(panAngleStart) * vol;
+    const double leftGainEnd = std::cos(panAngleEnd) * volTarget;
+    const double rightGainEnd = std::sin(panAngleEnd) * volTarget;
+    
+    // Linear interpolation of gains across block (cheap, smooth)
+    const StereoRamp ramp{leftGainStart, rightGainStart,
+                          (leftGainEnd - leftGainStart) / static_cast<double>(numFrames),
+                          (rightGainEnd - rightGainStart) / static_cast<double>(numFrames)};
+    AudioKernels::active().applyGainRamp(data, numFrames, ramp);
+    
+    // Snap smoothed params to target for next block
+    state.volume.snap();
+    state.pan.snap();
+}
+
+AudioEngine::TrackRTState& AudioEngine::ensureTrackState(uint32_t trackIndex) {
+    if (!m_rt || trackIndex >= m_rt->trackState.size()) {
         static TrackRTState dummy;
         return dummy;
     }
-    return m_trackState[trackIndex];
+    return m_rt->trackState[trackIndex];
 }
 
 } // namespace Audio
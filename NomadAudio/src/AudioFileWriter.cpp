@@ -0,0 +1,862 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "AudioFileWriter.h"
+#include "PathUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+// =============================================================================
+// Little-endian helpers
+// =============================================================================
+
+void putLE16(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void putLE32(uint8_t* p, uint32_t v) {
+    putLE16(p, v);
+    putLE16(p + 2, v >> 16);
+}
+
+// =============================================================================
+// Checksums (FLAC frame CRCs and the STREAMINFO MD5)
+// =============================================================================
+
+struct CrcTables {
+    std::array<uint8_t, 256> crc8{};
+    std::array<uint16_t, 256> crc16{};
+
+    CrcTables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c8 = i;
+            uint32_t c16 = i << 8;
+            for (int b = 0; b < 8; ++b) {
+                c8 = (c8 & 0x80) ? ((c8 << 1) ^ 0x07) : (c8 << 1);
+                c16 = (c16 & 0x8000) ? ((c16 << 1) ^ 0x8005) : (c16 << 1);
+            }
+            crc8[i] = static_cast<uint8_t>(c8);
+            crc16[i] = static_cast<uint16_t>(c16);
+        }
+    }
+};
+
+const CrcTables& crcTables() {
+    static const CrcTables tables;
+    return tables;
+}
+
+uint8_t crc8(const uint8_t* data, size_t size) {
+    const auto& table = crcTables().crc8;
+    uint8_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[crc ^ data[i]];
+    }
+    return crc;
+}
+
+uint16_t crc16(const uint8_t* data, size_t size) {
+    const auto& table = crcTables().crc16;
+    uint16_t crc = 0;
+    for (size_t i = 0; i < size; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+}
+
+/// RFC 1321 MD5, streamed.
+class Md5 {
+public:
+    void update(const uint8_t* data, size_t size) {
+        m_length += size;
+        while (size > 0) {
+            const size_t take = std::min(size, sizeof(m_buffer) - m_used);
+            std::memcpy(m_buffer + m_used, data, take);
+            m_used += take;
+            data += take;
+            size -= take;
+            if (m_used == sizeof(m_buffer)) {
+                transform(m_buffer);
+                m_used = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t digest[16]) {
+        const uint64_t bitLength = m_length * 8;
+        const uint8_t pad = 0x80;
+        update(&pad, 1);
+        const uint8_t zero = 0;
+        while (m_used != 56) {
+            update(&zero, 1);
+        }
+        uint8_t lengthBytes[8];
+        for (int i = 0; i < 8; ++i) {
+            lengthBytes[i] = static_cast<uint8_t>(bitLength >> (8 * i));
+        }
+        update(lengthBytes, 8);
+        for (int i = 0; i < 4; ++i) {
+            putLE32(digest + i * 4, m_h[i]);
+        }
+    }
+
+private:
+    static uint32_t rotl(uint32_t x, uint32_t c) { return (x << c) | (x >> (32 - c)); }
+
+    void transform(const uint8_t* block) {
+        static const uint32_t K[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+        static const uint32_t S[64] = {7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                                       5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+                                       4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                                       6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+        uint32_t M[16];
+        for (int i = 0; i < 16; ++i) {
+            M[i] = static_cast<uint32_t>(block[i * 4]) | (static_cast<uint32_t>(block[i * 4 + 1]) << 8) |
+                   (static_cast<uint32_t>(block[i * 4 + 2]) << 16) | (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+        }
+        uint32_t a = m_h[0], b = m_h[1], c = m_h[2], d = m_h[3];
+        for (uint32_t i = 0; i < 64; ++i) {
+            uint32_t f, g;
+            if (i < 16)      { f = (b & c) | (~b & d); g = i; }
+            else if (i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) & 15; }
+            else if (i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) & 15; }
+            else             { f = c ^ (b | ~d);       g = (7 * i) & 15; }
+            const uint32_t next = d;
+            d = c;
+            c = b;
+            b = b + rotl(a + f + K[i] + M[g], S[i]);
+            a = next;
+        }
+        m_h[0] += a; m_h[1] += b; m_h[2] += c; m_h[3] += d;
+    }
+
+    uint32_t m_h[4]{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    uint8_t m_buffer[64]{};
+    size_t m_used{0};
+    uint64_t m_length{0};
+};
+
+// =============================================================================
+// WAV
+// =============================================================================
+
+class WavFileWriter final : public AudioFileWriter {
+protected:
+    bool writeHeader() override {
+        const bool isFloat = m_sampleFormat == AudioSampleFormat::Float32;
+        m_headerBytes = isFloat ? 58u : 44u;   // Float adds cbSize and a fact chunk
+        uint8_t header[58] = {};
+        writeHeaderBytes(header, 0);
+        m_file.write(reinterpret_cast<const char*>(header), m_headerBytes);
+        return m_file.good() || fail("failed to write WAV header");
+    }
+
+    bool writeInt(const int32_t* interleaved, uint32_t frames) override {
+        const size_t samples = static_cast<size_t>(frames) * m_channels;
+        const uint32_t width = bitsPerSample(m_sampleFormat) / 8;
+        if (!reserve(samples * width)) {
+            return false;
+        }
+        m_bytes.resize(samples * width);
+        uint8_t* out = m_bytes.data();
+        if (width == 2) {
+            for (size_t i = 0; i < samples; ++i, out += 2) {
+                putLE16(out, static_cast<uint32_t>(interleaved[i]));
+            }
+        } else {
+            for (size_t i = 0; i < samples; ++i, out += 3) {
+                const uint32_t v = static_cast<uint32_t>(interleaved[i]);
+                out[0] = static_cast<uint8_t>(v);
+                out[1] = static_cast<uint8_t>(v >> 8);
+                out[2] = static_cast<uint8_t>(v >> 16);
+            }
+        }
+        m_file.write(reinterpret_cast<const char*>(m_bytes.data()), static_cast<std::streamsize>(m_bytes.size()));
+        return m_file.good() || fail("write failed");
+    }
+
+    bool writeFloat(const float* interleaved, uint32_t frames) override {
+        const size_t bytes = static_cast<size_t>(frames) * m_channels * sizeof(float);
+        if (!reserve(bytes)) {
+            return false;
+        }
+        m_file.write(reinterpret_cast<const char*>(interleaved), static_cast<std::streamsize>(bytes));
+        return m_file.good() || fail("write failed");
+    }
+
+    bool finish() override {
+        if (m_dataBytes & 1) {
+            m_file.put(0);   // RIFF chunks are word aligned
+        }
+        uint8_t header[58] = {};
+        writeHeaderBytes(header, m_dataBytes);
+        m_file.seekp(0);
+        m_file.write(reinterpret_cast<const char*>(header), m_headerBytes);
+        return m_file.good() || fail("failed to finalize WAV header");
+    }
+
+private:
+    /// RIFF sizes are 32-bit: refuse to grow past 4 GB rather than write a corrupt file.
+    bool reserve(size_t bytes) {
+        if (m_dataBytes + bytes + m_headerBytes > std::numeric_limits<uint32_t>::max() - 1) {
+            return fail("WAV files are limited to 4 GB");
+        }
+        m_dataBytes += bytes;
+        return true;
+    }
+
+    void writeHeaderBytes(uint8_t* h, uint64_t dataBytes) const {
+        const bool isFloat = m_sampleFormat == AudioSampleFormat::Float32;
+        const uint32_t bits = bitsPerSample(m_sampleFormat);
+        const uint32_t blockAlign = m_channels * bits / 8;
+        const uint32_t data = static_cast<uint32_t>(dataBytes);
+        std::memcpy(h, "RIFF", 4);
+        putLE32(h + 4, m_headerBytes - 8 + data + (data & 1));
+        std::memcpy(h + 8, "WAVEfmt ", 8);
+        putLE32(h + 16, isFloat ? 18 : 16);
+        putLE16(h + 20, isFloat ? 3 : 1);     // WAVE_FORMAT_IEEE_FLOAT / WAVE_FORMAT_PCM
+        putLE16(h + 22, m_channels);
+        putLE32(h + 24, m_sampleRate);
+        putLE32(h + 28, m_sampleRate * blockAlign);
+        putLE16(h + 32, blockAlign);
+        putLE16(h + 34, bits);
+        uint8_t* p = h + 36;
+        if (isFloat) {
+            putLE16(p, 0);                    // cbSize
+            std::memcpy(p + 2, "fact", 4);
+            putLE32(p + 6, 4);
+            putLE32(p + 10, blockAlign ? data / blockAlign : 0);
+            p += 14;
+        }
+        std::memcpy(p, "data", 4);
+        putLE32(p + 4, data);
+    }
+
+    uint32_t m_headerBytes{44};
+    uint64_t m_dataBytes{0};
+    std::vector<uint8_t> m_bytes;
+};
+
+// =============================================================================
+// FLAC
+// =============================================================================
+
+/// MSB-first bit packer for FLAC frames.
+class BitWriter {
+public:
+    void clear() {
+        m_bytes.clear();
+        m_acc = 0;
+        m_bits = 0;
+    }
+
+    void put(uint32_t value, uint32_t bits) {
+        if (bits == 0) {
+            return;
+        }
+        m_acc = (m_acc << bits) | (value & (0xFFFFFFFFu >> (32 - bits)));
+        m_bits += bits;
+        while (m_bits >= 8) {
+            m_bits -= 8;
+            m_bytes.push_back(static_cast<uint8_t>(m_acc >> m_bits));
+        }
+        m_acc &= (1u << m_bits) - 1;
+    }
+
+    void putSigned(int32_t value, uint32_t bits) { put(static_cast<uint32_t>(value), bits); }
+
+    void putRice(uint32_t value, uint32_t param) {
+        uint32_t quotient = value >> param;
+        while (quotient >= 32) {
+            put(0, 32);
+            quotient -= 32;
+        }
+        put(1, quotient + 1);   // quotient zeros, then a one
+        put(value, param);
+    }
+
+    void alignToByte() {
+        if (m_bits) {
+            put(0, 8 - m_bits);
+        }
+    }
+
+    std::vector<uint8_t>& bytes() { return m_bytes; }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint64_t m_acc{0};
+    uint32_t m_bits{0};
+};
+
+/**
+ * @brief Cheapest encoding of one subframe (constant, verbatim or fixed predictor).
+ *
+ * Fixed predictors of order 0-4 are picked by sum of absolute residuals, then
+ * the Rice partition order and per-partition parameters are searched for the
+ * exact smallest residual size.
+ */
+struct SubframePlan {
+    enum class Kind { Constant, Verbatim, Fixed } kind{Kind::Verbatim};
+    uint32_t order{0};
+    uint32_t partitionOrder{0};
+    uint32_t riceMethod{0};                 // 0: 4-bit parameters, 1: 5-bit
+    std::array<uint8_t, 256> params{};
+    uint64_t bits{0};
+};
+
+constexpr uint32_t kFlacBlockSize = 4096;
+constexpr uint32_t kMaxPartitionOrder = 8;
+constexpr uint32_t kMaxFixedOrder = 4;
+
+inline uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+void fixedResidual(const int32_t* x, uint32_t n, uint32_t order, int32_t* residual) {
+    for (uint32_t i = order; i < n; ++i) {
+        int64_t r;
+        switch (order) {
+            case 0:  r = x[i]; break;
+            case 1:  r = int64_t(x[i]) - x[i - 1]; break;
+            case 2:  r = int64_t(x[i]) - 2 * int64_t(x[i - 1]) + x[i - 2]; break;
+            case 3:  r = int64_t(x[i]) - 3 * int64_t(x[i - 1]) + 3 * int64_t(x[i - 2]) - x[i - 3]; break;
+            default: r = int64_t(x[i]) - 4 * int64_t(x[i - 1]) + 6 * int64_t(x[i - 2]) - 4 * int64_t(x[i - 3]) + x[i - 4]; break;
+        }
+        residual[i - order] = static_cast<int32_t>(r);
+    }
+}
+
+/// Bits for one partition at its best Rice parameter.
+uint64_t bestRice(const int32_t* residual, uint32_t count, uint32_t& param) {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        sum += zigzag(residual[i]);
+    }
+    uint32_t estimate = 0;
+    while (estimate < 30 && (static_cast<uint64_t>(count) << (estimate + 1)) <= sum) {
+        ++estimate;
+    }
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    const uint32_t lo = estimate > 0 ? estimate - 1 : 0;
+    const uint32_t hi = std::min<uint32_t>(estimate + 1, 30);
+    for (uint32_t k = lo; k <= hi; ++k) {
+        uint64_t bits = static_cast<uint64_t>(count) * (k + 1);
+        for (uint32_t i = 0; i < count; ++i) {
+            bits += zigzag(residual[i]) >> k;
+        }
+        if (bits < best) {
+            best = bits;
+            param = k;
+        }
+    }
+    return best;
+}
+
+void planSubframe(const int32_t* x, uint32_t n, uint32_t bps, int32_t* residual, SubframePlan& plan) {
+    plan = SubframePlan{};
+    if (std::all_of(x + 1, x + n, [&](int32_t v) { return v == x[0]; })) {
+        plan.kind = SubframePlan::Kind::Constant;
+        plan.bits = 8 + bps;
+        return;
+    }
+    plan.kind = SubframePlan::Kind::Verbatim;
+    plan.bits = 8 + static_cast<uint64_t>(n) * bps;
+
+    // Predictor order by sum of absolute residuals over the common range.
+    const uint32_t maxOrder = std::min(kMaxFixedOrder, n - 1);
+    uint32_t order = 0;
+    uint64_t bestSum = std::numeric_limits<uint64_t>::max();
+    for (uint32_t o = 0; o <= maxOrder; ++o) {
+        fixedResidual(x, n, o, residual);
+        uint64_t sum = 0;
+        for (uint32_t i = maxOrder - o; i < n - o; ++i) {
+            sum += static_cast<uint64_t>(std::abs(static_cast<int64_t>(residual[i])));
+        }
+        if (sum < bestSum) {
+            bestSum = sum;
+            order = o;
+        }
+    }
+    fixedResidual(x, n, order, residual);
+
+    // Partition order: n must split evenly and the first partition must hold the warm-up.
+    SubframePlan candidate;
+    for (uint32_t p = 0; p <= kMaxPartitionOrder; ++p) {
+        const uint32_t parts = 1u << p;
+        if (n % parts != 0 || (n >> p) <= order) {
+            break;
+        }
+        uint64_t bits = 0;
+        uint32_t maxParam = 0;
+        const int32_t* r = residual;
+        for (uint32_t part = 0; part < parts; ++part) {
+            const uint32_t count = (n >> p) - (part == 0 ? order : 0);
+            uint32_t param = 0;
+            bits += bestRice(r, count, param);
+            candidate.params[part] = static_cast<uint8_t>(param);
+            maxParam = std::max(maxParam, param);
+            r += count;
+        }
+        const uint32_t method = maxParam > 14 ? 1 : 0;
+        bits += 8 + static_cast<uint64_t>(order) * bps + 2 + 4 + static_cast<uint64_t>(parts) * (method ? 5 : 4);
+        if (bits < plan.bits) {
+            plan.kind = SubframePlan::Kind::Fixed;
+            plan.order = order;
+            plan.partitionOrder = p;
+            plan.riceMethod = method;
+            plan.params = candidate.params;
+            plan.bits = bits;
+        }
+    }
+}
+
+void encodeSubframe(BitWriter& bw, const int32_t* x, uint32_t n, uint32_t bps,
+                    const int32_t* residual, const SubframePlan& plan) {
+    bw.put(0, 1);   // Zero padding bit
+    switch (plan.kind) {
+        case SubframePlan::Kind::Constant:
+            bw.put(0, 6);
+            bw.put(0, 1);   // No wasted bits
+            bw.putSigned(x[0], bps);
+            return;
+        case SubframePlan::Kind::Verbatim:
+            bw.put(1, 6);
+            bw.put(0, 1);
+            for (uint32_t i = 0; i < n; ++i) {
+                bw.putSigned(x[i], bps);
+            }
+            return;
+        case SubframePlan::Kind::Fixed:
+            break;
+    }
+    bw.put(0x08 | plan.order, 6);
+    bw.put(0, 1);
+    for (uint32_t i = 0; i < plan.order; ++i) {
+        bw.putSigned(x[i], bps);
+    }
+    bw.put(plan.riceMethod, 2);
+    bw.put(plan.partitionOrder, 4);
+    const uint32_t parts = 1u << plan.partitionOrder;
+    const uint32_t paramBits = plan.riceMethod ? 5 : 4;
+    const int32_t* r = residual;
+    for (uint32_t part = 0; part < parts; ++part) {
+        const uint32_t count = (n >> plan.partitionOrder) - (part == 0 ? plan.order : 0);
+        const uint32_t param = plan.params[part];
+        bw.put(param, paramBits);
+        for (uint32_t i = 0; i < count; ++i) {
+            bw.putRice(zigzag(r[i]), param);
+        }
+        r += count;
+    }
+}
+
+class FlacFileWriter final : public AudioFileWriter {
+protected:
+    bool writeHeader() override {
+        m_bits = bitsPerSample(m_sampleFormat);
+        m_block.assign(m_channels, std::vector<int32_t>(kFlacBlockSize));
+        m_blockFill = 0;
+        m_frameNumber = 0;
+        m_minFrameBytes = std::numeric_limits<uint32_t>::max();
+        m_maxFrameBytes = 0;
+        m_md5 = Md5{};
+        m_file.write("fLaC", 4);
+        return writeStreamInfo() || fail("failed to write FLAC header");
+    }
+
+    bool writeInt(const int32_t* interleaved, uint32_t frames) override {
+        updateMd5(interleaved, frames);
+        uint32_t done = 0;
+        while (done < frames) {
+            const uint32_t take = std::min(frames - done, kFlacBlockSize - m_blockFill);
+            for (uint32_t i = 0; i < take; ++i) {
+                const int32_t* frame = interleaved + static_cast<size_t>(done + i) * m_channels;
+                for (uint32_t ch = 0; ch < m_channels; ++ch) {
+                    m_block[ch][m_blockFill + i] = frame[ch];
+                }
+            }
+            m_blockFill += take;
+            done += take;
+            if (m_blockFill == kFlacBlockSize && !encodeFrame()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool writeFloat(const float*, uint32_t) override {
+        return fail("FLAC stores integer samples only");
+    }
+
+    bool finish() override {
+        if (m_blockFill > 0 && !encodeFrame()) {
+            return false;
+        }
+        m_file.seekp(4);
+        return writeStreamInfo() || fail("failed to finalize FLAC header");
+    }
+
+private:
+    bool writeStreamInfo() {
+        uint8_t digest[16] = {};
+        if (m_framesWritten > 0) {
+            Md5 md5 = m_md5;
+            md5.finish(digest);
+        }
+        BitWriter bw;
+        bw.put(0x80, 8);                  // Last metadata block, type 0 (STREAMINFO)
+        bw.put(34, 24);
+        bw.put(kFlacBlockSize, 16);       // Min/max block size
+        bw.put(kFlacBlockSize, 16);
+        bw.put(m_maxFrameBytes ? m_minFrameBytes : 0, 24);
+        bw.put(m_maxFrameBytes, 24);
+        bw.put(m_sampleRate, 20);
+        bw.put(m_channels - 1, 3);
+        bw.put(m_bits - 1, 5);
+        bw.put(static_cast<uint32_t>(m_framesWritten >> 32), 4);
+        bw.put(static_cast<uint32_t>(m_framesWritten), 32);
+        for (uint8_t byte : digest) {
+            bw.put(byte, 8);
+        }
+        m_file.write(reinterpret_cast<const char*>(bw.bytes().data()), static_cast<std::streamsize>(bw.bytes().size()));
+        return m_file.good();
+    }
+
+    /// MD5 of the samples as little-endian signed integers (FLAC's signature format).
+    void updateMd5(const int32_t* interleaved, uint32_t frames) {
+        const uint32_t width = m_bits / 8;
+        const size_t samples = static_cast<size_t>(frames) * m_channels;
+        m_md5Bytes.resize(samples * width);
+        uint8_t* out = m_md5Bytes.data();
+        for (size_t i = 0; i < samples; ++i) {
+            const uint32_t v = static_cast<uint32_t>(interleaved[i]);
+            for (uint32_t b = 0; b < width; ++b) {
+                *out++ = static_cast<uint8_t>(v >> (8 * b));
+            }
+        }
+        m_md5.update(m_md5Bytes.data(), m_md5Bytes.size());
+    }
+
+    static uint32_t sampleRateCode(uint32_t rate) {
+        switch (rate) {
+            case 88200:  return 0x1;
+            case 176400: return 0x2;
+            case 192000: return 0x3;
+            case 8000:   return 0x4;
+            case 16000:  return 0x5;
+            case 22050:  return 0x6;
+            case 24000:  return 0x7;
+            case 32000:  return 0x8;
+            case 44100:  return 0x9;
+            case 48000:  return 0xA;
+            case 96000:  return 0xB;
+            default:     return 0x0;   // Taken from STREAMINFO
+        }
+    }
+
+    void putFrameNumber(BitWriter& bw, uint64_t v) {
+        // UTF-8 style variable-length integer
+        if (v < 0x80) {
+            bw.put(static_cast<uint32_t>(v), 8);
+            return;
+        }
+        uint32_t continuation = 1;
+        while (continuation < 6 && v >= (1ull << (6 * continuation + (6 - continuation)))) {
+            ++continuation;
+        }
+        const uint32_t lead = (0xFF00u >> (continuation + 1)) & 0xFF;
+        bw.put(lead | static_cast<uint32_t>(v >> (6 * continuation)), 8);
+        for (int c = static_cast<int>(continuation) - 1; c >= 0; --c) {
+            bw.put(0x80 | static_cast<uint32_t>((v >> (6 * c)) & 0x3F), 8);
+        }
+    }
+
+    bool encodeFrame() {
+        const uint32_t n = m_blockFill;
+        m_residual.resize(4);
+        for (auto& r : m_residual) {
+            r.resize(kFlacBlockSize);
+        }
+
+        // Channel assignment: stereo tries left/side, right/side and mid/side.
+        uint32_t assignment = m_channels - 1;
+        const int32_t* signals[2] = {nullptr, nullptr};
+        uint32_t widths[2] = {m_bits, m_bits};
+        SubframePlan plans[4];
+        const bool stereo = m_channels == 2 && n > 1;
+        if (stereo) {
+            m_mid.resize(kFlacBlockSize);
+            m_side.resize(kFlacBlockSize);
+            const int32_t* left = m_block[0].data();
+            const int32_t* right = m_block[1].data();
+            for (uint32_t i = 0; i < n; ++i) {
+                m_mid[i] = (left[i] + right[i]) >> 1;
+                m_side[i] = left[i] - right[i];
+            }
+            planSubframe(left, n, m_bits, m_residual[0].data(), plans[0]);
+            planSubframe(right, n, m_bits, m_residual[1].data(), plans[1]);
+            planSubframe(m_mid.data(), n, m_bits, m_residual[2].data(), plans[2]);
+            planSubframe(m_side.data(), n, m_bits + 1, m_residual[3].data(), plans[3]);
+
+            // {assignment, first plan, second plan}
+            const uint32_t options[4][3] = {{1, 0, 1}, {8, 0, 3}, {9, 3, 1}, {10, 2, 3}};
+            uint64_t bestBits = std::numeric_limits<uint64_t>::max();
+            uint32_t best = 0;
+            for (uint32_t o = 0; o < 4; ++o) {
+                const uint64_t bits = plans[options[o][1]].bits + plans[options[o][2]].bits;
+                if (bits < bestBits) {
+                    bestBits = bits;
+                    best = o;
+                }
+            }
+            assignment = options[best][0];
+            const int32_t* sources[4] = {left, right, m_mid.data(), m_side.data()};
+            for (int s = 0; s < 2; ++s) {
+                const uint32_t plan = options[best][1 + s];
+                signals[s] = sources[plan];
+                widths[s] = plan == 3 ? m_bits + 1 : m_bits;
+                m_chosen[s] = plan;
+            }
+        }
+
+        BitWriter& bw = m_frame;
+        bw.clear();
+        bw.put(0x3FFE, 14);                           // Sync
+        bw.put(0, 1);
+        bw.put(0, 1);                                 // Fixed block size
+        const uint32_t blockCode = n == kFlacBlockSize ? 0xC : (n <= 256 ? 0x6 : 0x7);
+        bw.put(blockCode, 4);
+        bw.put(sampleRateCode(m_sampleRate), 4);
+        bw.put(assignment, 4);
+        bw.put(m_bits == 16 ? 0x4 : 0x6, 3);
+        bw.put(0, 1);
+        putFrameNumber(bw, m_frameNumber);
+        if (blockCode == 0x6) {
+            bw.put(n - 1, 8);
+        } else if (blockCode == 0x7) {
+            bw.put(n - 1, 16);
+        }
+        bw.put(crc8(bw.bytes().data(), bw.bytes().size()), 8);
+
+        if (stereo) {
+            for (int s = 0; s < 2; ++s) {
+                encodeSubframe(bw, signals[s], n, widths[s], m_residual[m_chosen[s]].data(), plans[m_chosen[s]]);
+            }
+        } else {
+            for (uint32_t ch = 0; ch < m_channels; ++ch) {
+                SubframePlan plan;
+                planSubframe(m_block[ch].data(), n, m_bits, m_residual[0].data(), plan);
+                encodeSubframe(bw, m_block[ch].data(), n, m_bits, m_residual[0].data(), plan);
+            }
+        }
+        bw.alignToByte();
+        const uint16_t crc = crc16(bw.bytes().data(), bw.bytes().size());
+        bw.put(crc, 16);
+
+        const auto& bytes = bw.bytes();
+        m_file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        const uint32_t frameBytes = static_cast<uint32_t>(bytes.size());
+        m_minFrameBytes = std::min(m_minFrameBytes, frameBytes);
+        m_maxFrameBytes = std::max(m_maxFrameBytes, frameBytes);
+        ++m_frameNumber;
+        m_blockFill = 0;
+        return m_file.good() || fail("write failed");
+    }
+
+    uint32_t m_bits{16};
+    std::vector<std::vector<int32_t>> m_block;        // Planar, one block
+    uint32_t m_blockFill{0};
+    std::vector<std::vector<int32_t>> m_residual;     // Per candidate subframe
+    std::vector<int32_t> m_mid;
+    std::vector<int32_t> m_side;
+    uint32_t m_chosen[2]{0, 1};
+    BitWriter m_frame;
+    uint64_t m_frameNumber{0};
+    uint32_t m_minFrameBytes{0};
+    uint32_t m_maxFrameBytes{0};
+    Md5 m_md5;
+    std::vector<uint8_t> m_md5Bytes;
+};
+
+} // anonymous namespace
+
+// =============================================================================
+// SampleQuantizer
+// =============================================================================
+
+void SampleQuantizer::configure(uint32_t bits, uint32_t channels, DitheringMode mode, uint32_t seed) {
+    m_bits = std::clamp<uint32_t>(bits, 8, 24);
+    m_channels = std::max<uint32_t>(channels, 1);
+    m_mode = mode;
+    m_rngState = seed ? seed : 0x9E3779B9u;   // xorshift must not start at zero
+    m_state.assign(m_channels, ChannelState{});
+}
+
+float SampleQuantizer::nextTpdf() noexcept {
+    // Two xorshift32 draws; their sum is triangular over +/-1 LSB
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+    const float r1 = static_cast<float>(m_rngState) / 4294967295.0f - 0.5f;
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+    const float r2 = static_cast<float>(m_rngState) / 4294967295.0f - 0.5f;
+    return r1 + r2;
+}
+
+void SampleQuantizer::process(const float* input, int32_t* output, uint32_t frames) noexcept {
+    // Work in LSBs so the dither and the feedback are independent of the word length
+    const double scale = static_cast<double>(1u << (m_bits - 1));
+    const double maxValue = scale - 1.0;
+    const double minValue = -scale;
+    const float a1 = 2.033f;   // Noise-shaping filter (matches Track's NoiseShaped mode)
+    const float a2 = -1.165f;
+    const float HP_COEFF = 0.5f;
+
+    for (uint32_t i = 0; i < frames; ++i) {
+        for (uint32_t ch = 0; ch < m_channels; ++ch) {
+            const size_t index = static_cast<size_t>(i) * m_channels + ch;
+            double value = static_cast<double>(input[index]) * scale;
+            ChannelState& state = m_state[ch];
+            switch (m_mode) {
+                case DitheringMode::Triangular:
+                    value = std::nearbyint(value + nextTpdf());
+                    break;
+                case DitheringMode::HighPass: {
+                    const float dither = nextTpdf();
+                    value = std::nearbyint(value + dither - HP_COEFF * state.prevDither);
+                    state.prevDither = dither;
+                    break;
+                }
+                case DitheringMode::NoiseShaped: {
+                    // Error feedback: noise transfer 1 - a1 z^-1 - a2 z^-2 (quiet at DC, loud near Nyquist)
+                    const double shaped = value - (a1 * state.error1 + a2 * state.error2);
+                    value = std::nearbyint(shaped + nextTpdf());
+                    state.error2 = state.error1;
+                    state.error1 = static_cast<float>(value - shaped);
+                    break;
+                }
+                case DitheringMode::None:
+                default:
+                    value = std::nearbyint(value);
+                    break;
+            }
+            output[index] = static_cast<int32_t>(std::clamp(value, minValue, maxValue));
+        }
+    }
+}
+
+// =============================================================================
+// AudioFileWriter
+// =============================================================================
+
+std::unique_ptr<AudioFileWriter> AudioFileWriter::create(AudioFileFormat format) {
+    switch (format) {
+        case AudioFileFormat::Flac:
+            return std::make_unique<FlacFileWriter>();
+        case AudioFileFormat::Wav:
+        default:
+            return std::make_unique<WavFileWriter>();
+    }
+}
+
+bool AudioFileWriter::supports(AudioFileFormat format, AudioSampleFormat sampleFormat) {
+    return format != AudioFileFormat::Flac || sampleFormat != AudioSampleFormat::Float32;
+}
+
+const char* AudioFileWriter::extension(AudioFileFormat format) {
+    return format == AudioFileFormat::Flac ? ".flac" : ".wav";
+}
+
+uint32_t AudioFileWriter::bitsPerSample(AudioSampleFormat sampleFormat) {
+    switch (sampleFormat) {
+        case AudioSampleFormat::Int16:   return 16;
+        case AudioSampleFormat::Int24:   return 24;
+        case AudioSampleFormat::Float32:
+        default:                         return 32;
+    }
+}
+
+bool AudioFileWriter::open(const std::string& path, uint32_t sampleRate, uint32_t channels,
+                           AudioSampleFormat sampleFormat, DitheringMode dithering) {
+    close();
+    m_path = path;
+    m_error.clear();
+    m_sampleRate = sampleRate;
+    m_channels = channels;
+    m_sampleFormat = sampleFormat;
+    m_framesWritten = 0;
+    if (channels == 0 || channels > 8 || sampleRate == 0) {
+        return fail("unsupported channel count or sample rate");
+    }
+    if (sampleFormat != AudioSampleFormat::Float32) {
+        // Seed per file so stems don't share a dither sequence
+        const uint32_t seed = static_cast<uint32_t>(std::hash<std::string>{}(path)) | 1u;
+        m_quantizer.configure(bitsPerSample(sampleFormat), channels, dithering, seed);
+    }
+
+    m_file.open(makeUnicodePath(path), std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        return fail("cannot open for writing");
+    }
+    return writeHeader();
+}
+
+bool AudioFileWriter::write(const float* interleaved, uint32_t frames) {
+    if (!m_file.is_open() || !m_error.empty()) {
+        return false;
+    }
+    if (frames == 0) {
+        return true;
+    }
+    bool ok;
+    if (m_sampleFormat == AudioSampleFormat::Float32) {
+        ok = writeFloat(interleaved, frames);
+    } else {
+        m_intScratch.resize(static_cast<size_t>(frames) * m_channels);
+        m_quantizer.process(interleaved, m_intScratch.data(), frames);
+        ok = writeInt(m_intScratch.data(), frames);
+    }
+    if (ok) {
+        m_framesWritten += frames;
+    }
+    return ok;
+}
+
+bool AudioFileWriter::close() {
+    if (!m_file.is_open()) {
+        return m_error.empty();
+    }
+    const bool ok = m_error.empty() && finish();
+    m_file.close();
+    return ok && !m_file.fail();
+}
+
+bool AudioFileWriter::fail(const std::string& message) {
+    if (m_error.empty()) {
+        m_error = m_path + ": " + message;
+    }
+    return false;
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -1,5 +1,10 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #include "AudioGraphBuilder.h"
+#include "AudioGraphCompiler.h"
+#include "PlaylistClip.h"
+#include "SamplePool.h"
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <iostream>
 #include <cmath>
@@ -33,9 +38,27 @@ namespace {
 }
 
 AudioGraph AudioGraphBuilder::buildFromTrackManager(const TrackManager& trackManager, double outputSampleRate) {
+    AudioGraphBuilder builder;
+    return builder.build(trackManager, outputSampleRate);
+}
+
+AudioGraph AudioGraphBuilder::build(const TrackManager& trackManager, double outputSampleRate,
+                                    AudioTelemetry* telemetry) {
+    const auto t0 = std::chrono::steady_clock::now();
+    if (outputSampleRate != m_sampleRate) {
+        // Clip positions and pre-resampled buffers all depend on the output rate.
+        m_cache.clear();
+        m_sampleRate = outputSampleRate;
+    }
+    m_stats = BuildStats{};
+
     AudioGraph graph;
     const size_t trackCount = trackManager.getTrackCount();
     graph.tracks.reserve(trackCount);
+    std::vector<const AudioBuffer*> buffers;
+    buffers.reserve(trackCount);
+    std::unordered_map<const Track*, CachedTrack> next;
+    next.reserve(trackCount);
     uint64_t maxEndSample = 0;
 
     for (size_t t = 0; t < trackCount; ++t) {
@@ -44,80 +67,271 @@ AudioGraph AudioGraphBuilder::buildFromTrackManager(const TrackManager& trackMan
             continue;
         }
 
-        TrackRenderState trackState;
-        trackState.trackId = track->getTrackId();
-        trackState.trackIndex = track->getTrackIndex();
-        trackState.volume = track->getVolume();
-        trackState.pan = track->getPan();
-        trackState.mute = track->isMuted();
-        trackState.solo = track->isSoloed();
-
-        const uint32_t channels = track->getNumChannels();
-
-        // Resolve an owned buffer for this snapshot. If the track already has a
-        // shared decoded buffer, reuse it; otherwise, copy from the track's
-        // internal vector so edits/clears can't invalidate the active graph.
-        std::shared_ptr<const AudioBuffer> clipBuffer = track->getSampleBuffer();
-        const std::vector<float>* audioDataPtr = nullptr;
-        if (clipBuffer && clipBuffer->ready.load(std::memory_order_relaxed)) {
-            audioDataPtr = &clipBuffer->data;
+        // Read the versions before the state they cover: a change racing with
+        // this build bumps them again and is picked up by the next one.
+        const uint64_t graphVersion = track->getGraphVersion();
+        const uint64_t audioDataVersion = track->getAudioDataVersion();
+
+        CachedTrack entry;
+        auto cached = m_cache.find(track.get());
+        const bool hit = cached != m_cache.end() && !cached->second.audio.pending;
+        if (hit && cached->second.graphVersion == graphVersion) {
+            entry = std::move(cached->second);
+            ++m_stats.reused;
         } else {
-            const auto& audioData = track->getAudioData();
-            if (!audioData.empty() && channels > 0) {
-                auto owned = std::make_shared<AudioBuffer>();
-                owned->data = audioData;
-                owned->channels = channels;
-                owned->sampleRate = track->getSampleRate();
-                owned->numFrames = owned->channels > 0 ? owned->data.size() / owned->channels : 0;
-                owned->ready.store(true, std::memory_order_relaxed);
-                owned->sourcePath = track->getSourcePath();
-                clipBuffer = owned;
-                audioDataPtr = &owned->data;
+            if (hit && cached->second.audioDataVersion == audioDataVersion) {
+                entry.audio = std::move(cached->second.audio);
+                ++m_stats.patched;
+            } else {
+                entry.audio = resolveAudio(*track, outputSampleRate);
+                ++m_stats.rebuilt;
             }
+            entry.state = makeTrackState(*track, entry.audio, outputSampleRate);
+            entry.graphVersion = graphVersion;
+            entry.audioDataVersion = audioDataVersion;
         }
+        entry.state.trackIndex = track->getTrackIndex();   // Moves with insert/remove, not versioned
 
-        if (audioDataPtr && !audioDataPtr->empty() && channels > 0) {
-            // Single-clip fallback (until playlist provides multiple)
-            ClipRenderState clip;
-            clip.buffer = clipBuffer;
-            clip.audioData = audioDataPtr->data();
-            const uint64_t frames = static_cast<uint64_t>(audioDataPtr->size() / channels);
-            const double startSeconds = track->getStartPositionInTimeline();
-            const double trimStart = track->getTrimStart();
-            const double trimEnd = track->getTrimEnd();
-            const double sourceDuration = track->getDuration();
-            const double effectiveEnd = (trimEnd > 0.0) ? trimEnd : sourceDuration;
-            const double trimmedDuration = std::max(0.0, effectiveEnd - trimStart);
-
-            clip.startSample = safeSecondsToSamples(startSeconds, outputSampleRate);
-            clip.endSample = clip.startSample + safeSecondsToSamples(trimmedDuration, outputSampleRate);
-            clip.sampleOffset = safeSecondsToSamples(trimStart, static_cast<double>(track->getSampleRate()));
-            clip.totalFrames = frames;
-            clip.sourceSampleRate = static_cast<double>(track->getSampleRate());
-            clip.gain = 1.0f;
-            clip.pan = 0.0f;
-
-            // Clamp offset to available frames
-            if (clip.sampleOffset > frames) {
-                clip.sampleOffset = frames;
-            }
-            // Ensure endSample not before startSample
-            if (clip.endSample < clip.startSample) {
-                clip.endSample = clip.startSample;
-            }
+        for (const auto& clip : entry.state.clips) {
+            maxEndSample = std::max(maxEndSample, clip.endSample);
+            buffers.push_back(clip.buffer.get());
+        }
+        graph.tracks.push_back(entry.state);
+        next.emplace(track.get(), std::move(entry));
+    }
+    m_cache.swap(next);   // Drops entries for removed tracks
+    m_pins.assign(std::move(buffers));
+
+    graph.timelineEndSample = maxEndSample;
+
+    // Flatten routing into the RT schedule here, off the audio thread.
+    AudioGraphCompiler::compile(graph);
 
-            trackState.clips.push_back(clip);
-            if (clip.endSample > maxEndSample) {
-                maxEndSample = clip.endSample;
+    m_stats.buildNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count());
+    if (telemetry) {
+        telemetry->recordGraphBuild(m_stats.buildNs, m_stats.rebuilt, m_stats.patched, m_stats.reused);
+    }
+    return graph;
+}
+
+AudioGraph AudioGraphBuilder::build(const PlaylistRuntimeSnapshot& snapshot, const SourceManager& sources,
+                                    double outputSampleRate, AudioTelemetry* telemetry) {
+    const auto t0 = std::chrono::steady_clock::now();
+    m_stats = BuildStats{};
+
+    // The snapshot holds raw buffer pointers; the graph must own what it plays.
+    std::unordered_map<const AudioBufferData*, std::shared_ptr<const AudioBufferData>> owners;
+    for (const ClipSourceID& id : sources.getAllSourceIDs()) {
+        const ClipSource* source = sources.getSource(id);
+        if (source && source->getBuffer()) {
+            owners.emplace(source->getRawBuffer(), source->getBuffer());
+        }
+    }
+
+    std::unordered_map<const AudioBufferData*, StereoSource> stereoSources;
+    auto engineFormat = [&](const AudioBufferData* raw) -> std::shared_ptr<const AudioBufferData> {
+        auto owner = owners.find(raw);
+        if (owner == owners.end() || !owner->second->isValid()) {
+            return nullptr;
+        }
+        if (owner->second->numChannels == 2) {
+            return owner->second;
+        }
+        auto converted = stereoSources.find(raw);
+        if (converted == stereoSources.end()) {
+            auto cached = m_stereoSources.find(raw);
+            StereoSource entry;
+            if (cached != m_stereoSources.end() && cached->second.source.lock() == owner->second) {
+                entry = std::move(cached->second);
+            } else {
+                entry.source = owner->second;
+                entry.stereo = toStereo(*owner->second);
             }
+            converted = stereoSources.emplace(raw, std::move(entry)).first;
         }
+        return converted->second.stereo;
+    };
+
+    const double projectRate = snapshot.projectSampleRate > 0.0 ? snapshot.projectSampleRate : outputSampleRate;
+    const double toOutput = outputSampleRate / projectRate;
+    auto toOutputSamples = [toOutput](SampleIndex projectSamples) {
+        return projectSamples > 0 ? static_cast<uint64_t>(std::llround(static_cast<double>(projectSamples) * toOutput))
+                                  : 0;
+    };
+
+    AudioGraph graph;
+    graph.tracks.reserve(snapshot.lanes.size());
+    uint64_t maxEndSample = 0;
+    for (size_t l = 0; l < snapshot.lanes.size(); ++l) {
+        const LaneRuntimeInfo& lane = snapshot.lanes[l];
+        TrackRenderState trackState;
+        trackState.trackIndex = static_cast<uint32_t>(l);
+        trackState.trackId = static_cast<uint32_t>(l + 1);
+        trackState.volume = lane.volume;
+        trackState.pan = lane.pan;
+        trackState.mute = lane.muted;
+        trackState.solo = lane.solo;
+        trackState.clips.reserve(lane.clips.size());
 
+        for (const ClipRuntimeInfo& info : lane.clips) {
+            // Checked against sources before anything is read through the raw pointer.
+            if (info.muted || info.length <= 0 || info.playbackRate <= 0.0) {
+                continue;
+            }
+            auto data = engineFormat(info.audioData);
+            if (!data) {
+                continue;
+            }
+            ClipRenderState clip;
+            clip.sourceData = data;
+            clip.audioData = data->interleavedData.data();
+            clip.totalFrames = static_cast<uint64_t>(data->numFrames);
+            clip.sourceSampleRate = static_cast<double>(data->sampleRate);
+            clip.startSample = toOutputSamples(info.startTime);
+            clip.endSample = clip.startSample + toOutputSamples(info.length);
+            clip.sampleOffset = std::min<uint64_t>(info.sourceStart > 0 ? info.sourceStart : 0, clip.totalFrames);
+            clip.gain = info.gainLinear;
+            clip.pan = info.pan;
+            clip.playbackRate = info.playbackRate;
+            clip.fadeInSamples = toOutputSamples(info.fadeInLength);
+            clip.fadeOutSamples = toOutputSamples(info.fadeOutLength);
+            clip.reversed = (info.flags & ClipFlags::Reversed) != 0;
+            clip.preservePitch = (info.flags & ClipFlags::PreservePitch) != 0 || info.pitchSemitones != 0.0f;
+            clip.pitchRatio = std::pow(2.0, static_cast<double>(info.pitchSemitones) / 12.0);
+            if (info.flags & ClipFlags::Looping) {
+                const uint64_t available = clip.totalFrames - clip.sampleOffset;
+                clip.loopFrames = info.loopLength > 0 ? std::min<uint64_t>(info.loopLength, available) : available;
+            }
+            maxEndSample = std::max(maxEndSample, clip.endSample);
+            trackState.clips.push_back(std::move(clip));
+        }
         graph.tracks.push_back(std::move(trackState));
+        ++m_stats.rebuilt;
     }
-
+    m_stereoSources.swap(stereoSources);   // Drops conversions no clip uses any more
     graph.timelineEndSample = maxEndSample;
+
+    // Sorts each lane's clips and builds their interval index, off the audio thread.
+    AudioGraphCompiler::compile(graph);
+
+    m_stats.buildNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count());
+    if (telemetry) {
+        telemetry->recordGraphBuild(m_stats.buildNs, m_stats.rebuilt, m_stats.patched, m_stats.reused);
+    }
     return graph;
 }
 
+std::shared_ptr<const AudioBufferData> AudioGraphBuilder::toStereo(const AudioBufferData& source) {
+    auto stereo = std::make_shared<AudioBufferData>();
+    stereo->sampleRate = source.sampleRate;
+    stereo->numChannels = 2;
+    stereo->numFrames = source.numFrames;
+    stereo->interleavedData.resize(static_cast<size_t>(source.numFrames) * 2);
+    const uint32_t channels = source.numChannels;
+    for (SampleIndex f = 0; f < source.numFrames; ++f) {
+        // Mono is copied to both sides; wider sources keep their first two channels.
+        const float* frame = source.interleavedData.data() + static_cast<size_t>(f) * channels;
+        stereo->interleavedData[static_cast<size_t>(f) * 2] = frame[0];
+        stereo->interleavedData[static_cast<size_t>(f) * 2 + 1] = frame[channels > 1 ? 1 : 0];
+    }
+    return stereo;
+}
+
+AudioGraphBuilder::ResolvedAudio AudioGraphBuilder::resolveAudio(const Track& track, double outputSampleRate) {
+    ResolvedAudio resolved;
+    const uint32_t channels = track.getNumChannels();
+
+    // Resolve an owned buffer for this snapshot. If the track already has a
+    // shared decoded buffer, reuse it; otherwise, copy from the track's
+    // internal vector so edits/clears can't invalidate the active graph.
+    std::shared_ptr<const AudioBuffer> clipBuffer = track.getSampleBuffer();
+    resolved.sampleRate = static_cast<double>(track.getSampleRate());
+    if (clipBuffer && clipBuffer->ready.load(std::memory_order_relaxed)) {
+        // Prefer a pre-resampled copy at the output rate so the engine takes its
+        // direct-copy path; until one is ready the engine resamples in real time.
+        // Streamed clips always resample in real time (there is nothing to copy).
+        const uint32_t outputRate = static_cast<uint32_t>(std::lround(outputSampleRate));
+        if (clipBuffer->isStreaming) {
+            resolved.sampleRate = static_cast<double>(clipBuffer->sampleRate);
+        } else if (auto resampled = SamplePool::getInstance().acquireResampled(clipBuffer, outputRate)) {
+            clipBuffer = resampled;
+            resolved.sampleRate = static_cast<double>(resampled->sampleRate);
+        }
+        resolved.pending = !clipBuffer->isStreaming && clipBuffer->sampleRate != outputRate;
+        resolved.buffer = clipBuffer;
+    } else {
+        resolved.pending = clipBuffer != nullptr;   // Still decoding
+        const auto& audioData = track.getAudioData();
+        if (!audioData.empty() && channels > 0) {
+            auto owned = std::make_shared<AudioBuffer>();
+            owned->data = audioData;
+            owned->channels = channels;
+            owned->sampleRate = track.getSampleRate();
+            owned->numFrames = owned->channels > 0 ? owned->data.size() / owned->channels : 0;
+            owned->ready.store(true, std::memory_order_relaxed);
+            owned->sourcePath = track.getSourcePath();
+            resolved.buffer = owned;
+        }
+    }
+    return resolved;
+}
+
+TrackRenderState AudioGraphBuilder::makeTrackState(const Track& track, const ResolvedAudio& audio,
+                                                   double outputSampleRate) {
+    TrackRenderState trackState;
+    trackState.trackId = track.getTrackId();
+    trackState.trackIndex = track.getTrackIndex();
+    trackState.volume = track.getVolume();
+    trackState.pan = track.getPan();
+    trackState.mute = track.isMuted();
+    trackState.solo = track.isSoloed();
+
+    const uint32_t channels = track.getNumChannels();
+    const AudioBuffer* buffer = audio.buffer.get();
+    StreamingSource* stream = buffer && buffer->isStreaming ? buffer->stream.get() : nullptr;
+    const bool packed = buffer && buffer->isPacked() && !buffer->packed.empty();
+    const bool floatData = buffer && !stream && !packed && !buffer->data.empty();
+    if ((stream || packed || floatData) && channels > 0) {
+        // Single-clip fallback (until playlist provides multiple)
+        ClipRenderState clip;
+        clip.buffer = audio.buffer;
+        clip.audioData = floatData ? buffer->data.data() : nullptr;
+        clip.packedData = packed ? buffer->packed.data() : nullptr;
+        clip.packedSampleBytes = packed ? buffer->packedSampleBytes() : 0;
+        clip.stream = stream;
+        const uint64_t frames = stream ? stream->numFrames()
+                              : packed ? buffer->numFrames
+                              : static_cast<uint64_t>(buffer->data.size() / channels);
+        const double startSeconds = track.getStartPositionInTimeline();
+        const double trimStart = track.getTrimStart();
+        const double trimEnd = track.getTrimEnd();
+        const double sourceDuration = track.getDuration();
+        const double effectiveEnd = (trimEnd > 0.0) ? trimEnd : sourceDuration;
+        const double trimmedDuration = std::max(0.0, effectiveEnd - trimStart);
+
+        clip.startSample = safeSecondsToSamples(startSeconds, outputSampleRate);
+        clip.endSample = clip.startSample + safeSecondsToSamples(trimmedDuration, outputSampleRate);
+        clip.sampleOffset = safeSecondsToSamples(trimStart, audio.sampleRate);
+        clip.totalFrames = frames;
+        clip.sourceSampleRate = audio.sampleRate;
+        clip.gain = 1.0f;
+        clip.pan = 0.0f;
+
+        // Clamp offset to available frames
+        if (clip.sampleOffset > frames) {
+            clip.sampleOffset = frames;
+        }
+        // Ensure endSample not before startSample
+        if (clip.endSample < clip.startSample) {
+            clip.endSample = clip.startSample;
+        }
+
+        trackState.clips.push_back(clip);
+    }
+    return trackState;
+}
+
 } // namespace Audio
 } // namespace Nomad
@@ -0,0 +1,283 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "AudioGraphCompiler.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+// Routing edge before scheduling. Node ids: tracks [0, T), buses [T, T + B).
+struct PendingEdge {
+    uint32_t source{0};
+    uint32_t targetBus{kMasterBusIndex};
+    double gain{1.0};
+    bool preFader{false};
+    bool mainOutput{false};   // The node's output routing (vs. a send)
+};
+
+/**
+ * @brief Kahn's algorithm over bus → bus edges.
+ * @return Topological order of the buses that are not part of (or fed by) a cycle.
+ */
+std::vector<uint32_t> sortBuses(uint32_t trackCount, uint32_t busCount,
+                                const std::vector<PendingEdge>& edges) {
+    std::vector<uint32_t> indegree(busCount, 0);
+    std::vector<std::vector<uint32_t>> successors(busCount);
+    for (const auto& e : edges) {
+        if (e.source >= trackCount && e.targetBus != kMasterBusIndex) {
+            successors[e.source - trackCount].push_back(e.targetBus);
+            ++indegree[e.targetBus];
+        }
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(busCount);
+    for (uint32_t b = 0; b < busCount; ++b) {
+        if (indegree[b] == 0) {
+            order.push_back(b);
+        }
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (uint32_t next : successors[order[i]]) {
+            if (--indegree[next] == 0) {
+                order.push_back(next);
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * @brief Pick a bus that lies on a cycle, given the buses Kahn could not order.
+ *
+ * Buses only downstream of a cycle are peeled off by repeatedly removing
+ * remaining buses with no outgoing edge into the remaining set.
+ */
+uint32_t findCycleBus(uint32_t trackCount, uint32_t busCount,
+                      const std::vector<PendingEdge>& edges,
+                      const std::vector<bool>& ordered) {
+    std::vector<bool> remaining(busCount);
+    for (uint32_t b = 0; b < busCount; ++b) {
+        remaining[b] = !ordered[b];
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t b = 0; b < busCount; ++b) {
+            if (!remaining[b]) {
+                continue;
+            }
+            bool feedsRemaining = false;
+            for (const auto& e : edges) {
+                if (e.source == trackCount + b && e.targetBus != kMasterBusIndex && remaining[e.targetBus]) {
+                    feedsRemaining = true;
+                    break;
+                }
+            }
+            if (!feedsRemaining) {
+                remaining[b] = false;
+                changed = true;
+            }
+        }
+    }
+
+    for (uint32_t b = 0; b < busCount; ++b) {
+        if (remaining[b]) {
+            return b;
+        }
+    }
+    // Unreachable when called with an incomplete order; fall back to the first unordered bus.
+    for (uint32_t b = 0; b < busCount; ++b) {
+        if (!ordered[b]) {
+            return b;
+        }
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+void AudioGraphCompiler::indexClips(TrackRenderState& track) {
+    auto& clips = track.clips;
+    std::stable_sort(clips.begin(), clips.end(), [](const ClipRenderState& a, const ClipRenderState& b) {
+        return a.startSample < b.startSample;
+    });
+
+    auto& maxEnd = track.clipIndex.maxEnd;
+    maxEnd.resize(clips.size());
+    uint64_t running = 0;
+    track.hasStreamedClips = false;
+    for (size_t i = 0; i < clips.size(); ++i) {
+        running = std::max(running, clips[i].endSample);
+        maxEnd[i] = running;
+        track.hasStreamedClips |= clips[i].stream != nullptr;
+    }
+}
+
+bool AudioGraphCompiler::compile(AudioGraph& graph) {
+    RenderSchedule& schedule = graph.schedule;
+    schedule = RenderSchedule{};
+
+    const uint32_t trackCount = static_cast<uint32_t>(graph.tracks.size());
+    const uint32_t busCount = static_cast<uint32_t>(graph.buses.size());
+    const uint32_t nodeCount = trackCount + busCount;
+    bool clean = true;
+
+    auto validTarget = [busCount](uint32_t target) {
+        return target == kMasterBusIndex || target < busCount;
+    };
+
+    // Collect routing edges in node order (this is also the summation order).
+    std::vector<PendingEdge> edges;
+    edges.reserve(nodeCount * 2);
+    auto addRouting = [&](uint32_t node, uint32_t selfBus, uint32_t outputBus,
+                          const std::vector<SendRenderState>& sends) {
+        if (!validTarget(outputBus) || (outputBus != kMasterBusIndex && outputBus == selfBus)) {
+            outputBus = kMasterBusIndex;
+            clean = false;
+        }
+        edges.push_back({node, outputBus, 1.0, false, true});
+        for (const auto& send : sends) {
+            if (send.targetBus >= busCount || send.targetBus == selfBus) {
+                clean = false;
+                continue;
+            }
+            edges.push_back({node, send.targetBus, static_cast<double>(send.gain), send.preFader, false});
+        }
+    };
+    for (uint32_t t = 0; t < trackCount; ++t) {
+        const auto& track = graph.tracks[t];
+        addRouting(t, kMasterBusIndex, track.outputBus, track.sends);
+    }
+    for (uint32_t b = 0; b < busCount; ++b) {
+        const auto& bus = graph.buses[b];
+        addRouting(trackCount + b, b, bus.outputBus, bus.sends);
+    }
+
+    // Topologically sort buses; break cycles by routing a cycle member to master.
+    std::vector<uint32_t> busOrder = sortBuses(trackCount, busCount, edges);
+    while (busOrder.size() < busCount) {
+        std::vector<bool> ordered(busCount, false);
+        for (uint32_t b : busOrder) {
+            ordered[b] = true;
+        }
+        const uint32_t cut = findCycleBus(trackCount, busCount, edges, ordered);
+        const uint32_t cutNode = trackCount + cut;
+
+        edges.erase(std::remove_if(edges.begin(), edges.end(), [cutNode](const PendingEdge& e) {
+            return e.source == cutNode && !e.mainOutput;
+        }), edges.end());
+        for (auto& e : edges) {
+            if (e.source == cutNode && e.mainOutput) {
+                e.targetBus = kMasterBusIndex;
+            }
+        }
+
+        Log::warning("AudioGraphCompiler: routing cycle through bus " +
+                     std::to_string(graph.buses[cut].busId) + ", routed to master");
+        clean = false;
+        busOrder = sortBuses(trackCount, busCount, edges);
+    }
+
+    // Levels: tracks are 0, a bus sits one above its deepest input.
+    std::vector<uint32_t> level(nodeCount, 0);
+    for (uint32_t b = 0; b < busCount; ++b) {
+        level[trackCount + b] = 1;
+    }
+    for (uint32_t b : busOrder) {
+        const uint32_t node = trackCount + b;
+        for (const auto& e : edges) {
+            if (e.targetBus != kMasterBusIndex && e.source == node) {
+                uint32_t& target = level[trackCount + e.targetBus];
+                target = std::max(target, level[node] + 1);
+            }
+        }
+    }
+
+    // Sorted node order: tracks (graph order) then buses by (level, index).
+    std::vector<uint32_t> order(nodeCount);
+    for (uint32_t n = 0; n < nodeCount; ++n) {
+        order[n] = n;
+    }
+    std::stable_sort(order.begin(), order.end(), [&level](uint32_t a, uint32_t b) {
+        return level[a] < level[b];
+    });
+    std::vector<uint32_t> sortedIndex(nodeCount, 0);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        sortedIndex[order[i]] = i;
+    }
+
+    // Nodes + buffer slots (post slot = original node id, pre-fader copies appended).
+    schedule.nodes.resize(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        const uint32_t id = order[i];
+        RenderNode& node = schedule.nodes[i];
+        node.type = (id < trackCount) ? RenderNode::Type::Track : RenderNode::Type::Bus;
+        node.index = (id < trackCount) ? id : id - trackCount;
+        node.level = level[id];
+        node.postSlot = id;
+    }
+    uint32_t nextSlot = nodeCount;
+    for (const auto& e : edges) {
+        RenderNode& src = schedule.nodes[sortedIndex[e.source]];
+        if (e.preFader && src.preSlot == kNoBufferSlot) {
+            src.preSlot = nextSlot++;
+        }
+    }
+    schedule.bufferCount = nextSlot;
+
+    auto makeEdge = [&](const PendingEdge& e) {
+        const RenderNode& src = schedule.nodes[sortedIndex[e.source]];
+        RenderEdge edge;
+        edge.sourceNode = sortedIndex[e.source];
+        edge.sourceSlot = e.preFader ? src.preSlot : src.postSlot;
+        edge.gain = e.gain;
+        return edge;
+    };
+
+    // Bus inputs grouped per node, each group in source-node order.
+    for (auto& node : schedule.nodes) {
+        if (node.type != RenderNode::Type::Bus) {
+            continue;
+        }
+        node.firstInput = static_cast<uint32_t>(schedule.inputs.size());
+        for (const auto& e : edges) {
+            if (e.targetBus == node.index) {
+                schedule.inputs.push_back(makeEdge(e));
+            }
+        }
+        node.inputCount = static_cast<uint32_t>(schedule.inputs.size()) - node.firstInput;
+    }
+    for (const auto& e : edges) {
+        if (e.targetBus == kMasterBusIndex) {
+            schedule.masterInputs.push_back(makeEdge(e));
+        }
+    }
+
+    // Level partition
+    schedule.levelOffsets.push_back(0);
+    for (uint32_t i = 1; i < nodeCount; ++i) {
+        if (schedule.nodes[i].level != schedule.nodes[i - 1].level) {
+            schedule.levelOffsets.push_back(i);
+        }
+    }
+    schedule.levelOffsets.push_back(nodeCount);
+    if (nodeCount == 0) {
+        schedule.levelOffsets.clear();
+    }
+
+    for (auto& track : graph.tracks) {
+        indexClips(track);
+    }
+
+    schedule.compiled = true;
+    return clean;
+}
+
+} // namespace Audio
+} // namespace Nomad
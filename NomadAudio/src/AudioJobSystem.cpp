@@ -0,0 +1,68 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "AudioJobSystem.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Nomad {
+namespace Audio {
+
+AudioJobSystem::AudioJobSystem(size_t numWorkers) {
+    m_pool.start(static_cast<uint32_t>(std::min<size_t>(numWorkers, kMaxWorkers)));
+    Log::info("AudioJobSystem created with " + std::to_string(m_pool.getWorkerCount()) + " threads");
+}
+
+AudioJobSystem::~AudioJobSystem() {
+    m_pool.stop();
+    Log::info("AudioJobSystem destroyed");
+}
+
+bool AudioJobSystem::submit(JobFn fn, void* context, uint32_t index) noexcept {
+    if (!fn) {
+        return false;
+    }
+    if (m_jobCount >= kMaxJobs) {
+        // Slot table full: degrade to inline execution rather than dropping work.
+        fn(context, index);
+        m_overflowJobs.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Job& job = m_jobs[m_jobCount++];
+    job.fn = fn;
+    job.context = context;
+    job.index = index;
+    return true;
+}
+
+void AudioJobSystem::runJob(void* context, uint32_t slot) noexcept {
+    const Job& job = static_cast<AudioJobSystem*>(context)->m_jobs[slot];
+    job.fn(job.context, job.index);
+}
+
+void AudioJobSystem::dispatchAndWait() noexcept {
+    const uint32_t count = m_jobCount;
+    if (count == 0) {
+        return;
+    }
+
+    m_pool.run(&AudioJobSystem::runJob, this, count);
+
+    m_jobCount = 0;
+    m_batches.fetch_add(1, std::memory_order_relaxed);
+}
+
+AudioJobSystem::Stats AudioJobSystem::getStats() const noexcept {
+    Stats s;
+    s.batches = m_batches.load(std::memory_order_relaxed);
+    for (uint32_t p = 0; p < m_pool.getParticipantCount(); ++p) {
+        const RTWorkerPool::ParticipantStats& ps = m_pool.getStats(p);
+        s.jobsExecuted += ps.tasksExecuted.load(std::memory_order_relaxed);
+        s.jobsStolen += ps.tasksStolen.load(std::memory_order_relaxed);
+    }
+    s.overflowJobs = m_overflowJobs.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace Audio
+} // namespace Nomad
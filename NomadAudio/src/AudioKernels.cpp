@@ -0,0 +1,1024 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "AudioKernels.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define NOMAD_KERNELS_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+// Per-function ISA targets so the rest of the build keeps its baseline flags.
+// MSVC exposes every intrinsic without target flags.
+#if defined(NOMAD_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define NOMAD_TARGET_SSE2 __attribute__((target("sse2")))
+    #define NOMAD_TARGET_AVX2 __attribute__((target("avx2")))
+    #define NOMAD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+    #define NOMAD_TARGET_SSE2
+    #define NOMAD_TARGET_AVX2
+    #define NOMAD_TARGET_AVX512
+#endif
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+//==============================================================================
+// Scalar reference (also the tail of every SIMD kernel)
+//==============================================================================
+
+// Sum-of-squares lanes: sample j accumulates into lane j % 8 in every tier.
+constexpr uint32_t kLanes = 8;
+
+struct LaneState {
+    double sq[kLanes] = {};
+    double peak[2] = {};    // L, R
+};
+
+inline void accumulate(LaneState& s, size_t sample, double x) noexcept {
+    s.sq[sample & (kLanes - 1)] += x * x;
+    const double a = std::fabs(x);
+    double& p = s.peak[sample & 1];
+    if (a > p) {
+        p = a;
+    }
+}
+
+inline void mergePeak(LaneState& s, uint32_t lane, double value) noexcept {
+    double& p = s.peak[lane & 1];
+    if (value > p) {
+        p = value;
+    }
+}
+
+inline void finish(const LaneState& s, StereoLevels& out) noexcept {
+    out.peakL = s.peak[0];
+    out.peakR = s.peak[1];
+    out.sumSqL = (s.sq[0] + s.sq[2]) + (s.sq[4] + s.sq[6]);
+    out.sumSqR = (s.sq[1] + s.sq[3]) + (s.sq[5] + s.sq[7]);
+}
+
+inline void applyGainRampTail(double* data, uint32_t begin, uint32_t frames, const StereoRamp& r) noexcept {
+    for (uint32_t i = begin; i < frames; ++i) {
+        const double t = static_cast<double>(i);
+        data[i * 2] *= r.startL + r.deltaL * t;
+        data[i * 2 + 1] *= r.startR + r.deltaR * t;
+    }
+}
+
+inline void mixGainRampTail(double* dst, const double* src, uint32_t begin, uint32_t frames,
+                            const StereoRamp& r) noexcept {
+    for (uint32_t i = begin; i < frames; ++i) {
+        const double t = static_cast<double>(i);
+        dst[i * 2] += src[i * 2] * (r.startL + r.deltaL * t);
+        dst[i * 2 + 1] += src[i * 2 + 1] * (r.startR + r.deltaR * t);
+    }
+}
+
+inline void mixTail(double* dst, const double* src, double gain, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+inline void measureTail(LaneState& s, const double* src, uint32_t begin, uint32_t frames) noexcept {
+    for (size_t j = static_cast<size_t>(begin) * 2; j < static_cast<size_t>(frames) * 2; ++j) {
+        accumulate(s, j, src[j]);
+    }
+}
+
+inline void rampToFloatTail(float* dst, const double* src, uint32_t begin, uint32_t frames,
+                            const StereoRamp& r, LaneState& s) noexcept {
+    for (uint32_t i = begin; i < frames; ++i) {
+        const double t = static_cast<double>(i);
+        const double L = src[i * 2] * (r.startL + r.deltaL * t);
+        const double R = src[i * 2 + 1] * (r.startR + r.deltaR * t);
+        dst[i * 2] = static_cast<float>(L);
+        dst[i * 2 + 1] = static_cast<float>(R);
+        accumulate(s, static_cast<size_t>(i) * 2, L);
+        accumulate(s, static_cast<size_t>(i) * 2 + 1, R);
+    }
+}
+
+inline void doubleToFloatTail(float* dst, const double* src, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+inline void floatToDoubleTail(double* dst, const float* src, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        dst[i] = static_cast<double>(src[i]);
+    }
+}
+
+inline void interleaveTail(float* dst, const float* left, const float* right,
+                           uint32_t begin, uint32_t frames) noexcept {
+    for (uint32_t i = begin; i < frames; ++i) {
+        dst[i * 2] = left[i];
+        dst[i * 2 + 1] = right[i];
+    }
+}
+
+inline void deinterleaveTail(float* left, float* right, const float* src,
+                             uint32_t begin, uint32_t frames) noexcept {
+    for (uint32_t i = begin; i < frames; ++i) {
+        left[i] = src[i * 2];
+        right[i] = src[i * 2 + 1];
+    }
+}
+
+constexpr float kInt16Scale = 1.0f / 32768.0f;
+constexpr float kInt24Scale = 1.0f / 8388608.0f;
+
+inline void int16ToFloatTail(float* dst, const uint8_t* src, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        const int16_t v = static_cast<int16_t>(static_cast<uint16_t>(src[i * 2] | src[i * 2 + 1] << 8));
+        dst[i] = static_cast<float>(v) * kInt16Scale;
+    }
+}
+
+inline void int24ToFloatTail(float* dst, const uint8_t* src, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        const uint8_t* p = src + i * 3;
+        // Assemble in the top three bytes, then shift back down to sign-extend.
+        const int32_t v = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 | static_cast<uint32_t>(p[1]) << 16 |
+                                               static_cast<uint32_t>(p[2]) << 24) >> 8;
+        dst[i] = static_cast<float>(v) * kInt24Scale;
+    }
+}
+
+// Peak ranges keep eight min/max lanes (flat sample index mod 8) when the channel
+// count divides eight, so the SIMD tiers see each lane's samples in the same order.
+constexpr uint32_t kPeakLanes = 8;
+
+inline bool peakLanesFit(uint32_t channels) noexcept {
+    return channels > 0 && kPeakLanes % channels == 0;
+}
+
+inline void peakLaneInit(float* mins, float* maxs, const float* peaks, uint32_t channels) noexcept {
+    for (uint32_t l = 0; l < kPeakLanes; ++l) {
+        mins[l] = peaks[(l % channels) * 2];
+        maxs[l] = peaks[(l % channels) * 2 + 1];
+    }
+}
+
+// x < m ? x : m is exactly what minps(x, m) computes (and likewise for max), NaNs included.
+inline void peakRangeTail(float* mins, float* maxs, const float* src, size_t begin, size_t samples) noexcept {
+    for (size_t i = begin; i < samples; ++i) {
+        const size_t l = i % kPeakLanes;
+        mins[l] = src[i] < mins[l] ? src[i] : mins[l];
+        maxs[l] = src[i] > maxs[l] ? src[i] : maxs[l];
+    }
+}
+
+inline void peakLaneReduce(const float* mins, const float* maxs, uint32_t channels, float* peaks) noexcept {
+    for (uint32_t c = 0; c < channels; ++c) {
+        float mn = mins[c];
+        float mx = maxs[c];
+        for (uint32_t l = c + channels; l < kPeakLanes; l += channels) {
+            mn = mins[l] < mn ? mins[l] : mn;
+            mx = maxs[l] > mx ? maxs[l] : mx;
+        }
+        peaks[c * 2] = mn;
+        peaks[c * 2 + 1] = mx;
+    }
+}
+
+// Channel counts that don't divide the lanes: one running pair per channel.
+inline void peakRangeGeneric(const float* src, size_t frames, uint32_t channels, float* peaks) noexcept {
+    for (size_t f = 0; f < frames; ++f) {
+        const float* frame = src + f * channels;
+        for (uint32_t c = 0; c < channels; ++c) {
+            peaks[c * 2] = frame[c] < peaks[c * 2] ? frame[c] : peaks[c * 2];
+            peaks[c * 2 + 1] = frame[c] > peaks[c * 2 + 1] ? frame[c] : peaks[c * 2 + 1];
+        }
+    }
+}
+
+void applyGainRampScalar(double* data, uint32_t frames, const StereoRamp& r) noexcept {
+    applyGainRampTail(data, 0, frames, r);
+}
+
+void mixGainRampScalar(double* dst, const double* src, uint32_t frames, const StereoRamp& r) noexcept {
+    mixGainRampTail(dst, src, 0, frames, r);
+}
+
+void mixScalar(double* dst, const double* src, double gain, size_t samples) noexcept {
+    mixTail(dst, src, gain, 0, samples);
+}
+
+void measureScalar(const double* src, uint32_t frames, StereoLevels& out) noexcept {
+    LaneState s;
+    measureTail(s, src, 0, frames);
+    finish(s, out);
+}
+
+void rampToFloatScalar(float* dst, const double* src, uint32_t frames, const StereoRamp& r,
+                       StereoLevels& out) noexcept {
+    LaneState s;
+    rampToFloatTail(dst, src, 0, frames, r, s);
+    finish(s, out);
+}
+
+void doubleToFloatScalar(float* dst, const double* src, size_t samples) noexcept {
+    doubleToFloatTail(dst, src, 0, samples);
+}
+
+void floatToDoubleScalar(double* dst, const float* src, size_t samples) noexcept {
+    floatToDoubleTail(dst, src, 0, samples);
+}
+
+void interleaveScalar(float* dst, const float* left, const float* right, uint32_t frames) noexcept {
+    interleaveTail(dst, left, right, 0, frames);
+}
+
+void deinterleaveScalar(float* left, float* right, const float* src, uint32_t frames) noexcept {
+    deinterleaveTail(left, right, src, 0, frames);
+}
+
+void int16ToFloatScalar(float* dst, const uint8_t* src, size_t samples) noexcept {
+    int16ToFloatTail(dst, src, 0, samples);
+}
+
+void int24ToFloatScalar(float* dst, const uint8_t* src, size_t samples) noexcept {
+    int24ToFloatTail(dst, src, 0, samples);
+}
+
+void peakRangeScalar(const float* src, size_t frames, uint32_t channels, float* peaks) noexcept {
+    if (!peakLanesFit(channels)) {
+        peakRangeGeneric(src, frames, channels, peaks);
+        return;
+    }
+    float mins[kPeakLanes], maxs[kPeakLanes];
+    peakLaneInit(mins, maxs, peaks, channels);
+    peakRangeTail(mins, maxs, src, 0, frames * channels);
+    peakLaneReduce(mins, maxs, channels, peaks);
+}
+
+const AudioKernelTable kScalarTable = {
+    SimdLevel::Scalar,
+    &applyGainRampScalar,
+    &mixGainRampScalar,
+    &mixScalar,
+    &measureScalar,
+    &rampToFloatScalar,
+    &doubleToFloatScalar,
+    &floatToDoubleScalar,
+    &interleaveScalar,
+    &deinterleaveScalar,
+    &int16ToFloatScalar,
+    &int24ToFloatScalar,
+    &peakRangeScalar,
+};
+
+#ifdef NOMAD_KERNELS_X86
+
+//==============================================================================
+// SSE2: one stereo frame per register
+//==============================================================================
+
+NOMAD_TARGET_SSE2
+void applyGainRampSSE2(double* data, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m128d start = _mm_set_pd(r.startR, r.startL);
+    const __m128d delta = _mm_set_pd(r.deltaR, r.deltaL);
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d idx = _mm_setzero_pd();
+    for (uint32_t i = 0; i < frames; ++i) {
+        const __m128d g = _mm_add_pd(start, _mm_mul_pd(delta, idx));
+        _mm_storeu_pd(data + i * 2, _mm_mul_pd(_mm_loadu_pd(data + i * 2), g));
+        idx = _mm_add_pd(idx, one);
+    }
+}
+
+NOMAD_TARGET_SSE2
+void mixGainRampSSE2(double* dst, const double* src, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m128d start = _mm_set_pd(r.startR, r.startL);
+    const __m128d delta = _mm_set_pd(r.deltaR, r.deltaL);
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d idx = _mm_setzero_pd();
+    for (uint32_t i = 0; i < frames; ++i) {
+        const __m128d g = _mm_add_pd(start, _mm_mul_pd(delta, idx));
+        const __m128d v = _mm_mul_pd(_mm_loadu_pd(src + i * 2), g);
+        _mm_storeu_pd(dst + i * 2, _mm_add_pd(_mm_loadu_pd(dst + i * 2), v));
+        idx = _mm_add_pd(idx, one);
+    }
+}
+
+NOMAD_TARGET_SSE2
+void mixSSE2(double* dst, const double* src, double gain, size_t samples) noexcept {
+    const __m128d g = _mm_set1_pd(gain);
+    size_t i = 0;
+    for (; i + 2 <= samples; i += 2) {
+        _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_mul_pd(_mm_loadu_pd(src + i), g)));
+    }
+    mixTail(dst, src, gain, i, samples);
+}
+
+// Sums of squares in four registers = lanes {0,1} {2,3} {4,5} {6,7}.
+NOMAD_TARGET_SSE2
+inline void storeLanesSSE2(LaneState& s, const __m128d sq[4], __m128d peak) noexcept {
+    for (uint32_t k = 0; k < 4; ++k) {
+        _mm_storeu_pd(s.sq + k * 2, sq[k]);
+    }
+    alignas(16) double p[2];
+    _mm_store_pd(p, peak);
+    mergePeak(s, 0, p[0]);
+    mergePeak(s, 1, p[1]);
+}
+
+NOMAD_TARGET_SSE2
+void measureSSE2(const double* src, uint32_t frames, StereoLevels& out) noexcept {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    __m128d sq[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+    __m128d peak = _mm_setzero_pd();
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        for (uint32_t k = 0; k < 4; ++k) {
+            const __m128d x = _mm_loadu_pd(src + (i + k) * 2);
+            sq[k] = _mm_add_pd(sq[k], _mm_mul_pd(x, x));
+            peak = _mm_max_pd(peak, _mm_andnot_pd(signMask, x));
+        }
+    }
+    LaneState s;
+    storeLanesSSE2(s, sq, peak);
+    measureTail(s, src, i, frames);
+    finish(s, out);
+}
+
+NOMAD_TARGET_SSE2
+void rampToFloatSSE2(float* dst, const double* src, uint32_t frames, const StereoRamp& r,
+                     StereoLevels& out) noexcept {
+    const __m128d start = _mm_set_pd(r.startR, r.startL);
+    const __m128d delta = _mm_set_pd(r.deltaR, r.deltaL);
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d four = _mm_set1_pd(4.0);
+    __m128d sq[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+    __m128d peak = _mm_setzero_pd();
+    __m128d idx = _mm_setzero_pd();
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        __m128d x[4];
+        __m128d t = idx;
+        for (uint32_t k = 0; k < 4; ++k) {
+            const __m128d g = _mm_add_pd(start, _mm_mul_pd(delta, t));
+            x[k] = _mm_mul_pd(_mm_loadu_pd(src + (i + k) * 2), g);
+            sq[k] = _mm_add_pd(sq[k], _mm_mul_pd(x[k], x[k]));
+            peak = _mm_max_pd(peak, _mm_andnot_pd(signMask, x[k]));
+            t = _mm_add_pd(t, one);
+        }
+        _mm_storeu_ps(dst + i * 2, _mm_movelh_ps(_mm_cvtpd_ps(x[0]), _mm_cvtpd_ps(x[1])));
+        _mm_storeu_ps(dst + i * 2 + 4, _mm_movelh_ps(_mm_cvtpd_ps(x[2]), _mm_cvtpd_ps(x[3])));
+        idx = _mm_add_pd(idx, four);
+    }
+    LaneState s;
+    storeLanesSSE2(s, sq, peak);
+    rampToFloatTail(dst, src, i, frames, r, s);
+    finish(s, out);
+}
+
+NOMAD_TARGET_SSE2
+void doubleToFloatSSE2(float* dst, const double* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+    }
+    doubleToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_SSE2
+void floatToDoubleSSE2(double* dst, const float* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        const __m128 v = _mm_loadu_ps(src + i);
+        _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+        _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    floatToDoubleTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_SSE2
+void interleaveSSE2(float* dst, const float* left, const float* right, uint32_t frames) noexcept {
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 l = _mm_loadu_ps(left + i);
+        const __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(l, r));
+        _mm_storeu_ps(dst + i * 2 + 4, _mm_unpackhi_ps(l, r));
+    }
+    interleaveTail(dst, left, right, i, frames);
+}
+
+NOMAD_TARGET_SSE2
+void deinterleaveSSE2(float* left, float* right, const float* src, uint32_t frames) noexcept {
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 a = _mm_loadu_ps(src + i * 2);
+        const __m128 b = _mm_loadu_ps(src + i * 2 + 4);
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    deinterleaveTail(left, right, src, i, frames);
+}
+
+NOMAD_TARGET_SSE2
+void int16ToFloatSSE2(float* dst, const uint8_t* src, size_t samples) noexcept {
+    const __m128 scale = _mm_set1_ps(kInt16Scale);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        // Each sample paired with itself, then shifted down: sign extension without SSE4.1.
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    int16ToFloatTail(dst, src, i, samples);
+}
+
+inline int32_t load32(const uint8_t* p) noexcept {
+    int32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+NOMAD_TARGET_SSE2
+void int24ToFloatSSE2(float* dst, const uint8_t* src, size_t samples) noexcept {
+    const __m128 scale = _mm_set1_ps(kInt24Scale);
+    size_t i = 0;
+    // Each four-byte load takes one byte of the next sample, so stop before the last.
+    for (; i + 4 < samples; i += 4) {
+        const uint8_t* p = src + i * 3;
+        const __m128i v = _mm_setr_epi32(load32(p), load32(p + 3), load32(p + 6), load32(p + 9));
+        const __m128i s = _mm_srai_epi32(_mm_slli_epi32(v, 8), 8);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(s), scale));
+    }
+    int24ToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_SSE2
+void peakRangeSSE2(const float* src, size_t frames, uint32_t channels, float* peaks) noexcept {
+    if (!peakLanesFit(channels)) {
+        peakRangeGeneric(src, frames, channels, peaks);
+        return;
+    }
+    float mins[kPeakLanes], maxs[kPeakLanes];
+    peakLaneInit(mins, maxs, peaks, channels);
+    __m128 mn0 = _mm_loadu_ps(mins), mn1 = _mm_loadu_ps(mins + 4);
+    __m128 mx0 = _mm_loadu_ps(maxs), mx1 = _mm_loadu_ps(maxs + 4);
+    const size_t samples = frames * channels;
+    size_t i = 0;
+    for (; i + kPeakLanes <= samples; i += kPeakLanes) {
+        const __m128 a = _mm_loadu_ps(src + i);
+        const __m128 b = _mm_loadu_ps(src + i + 4);
+        mn0 = _mm_min_ps(a, mn0);
+        mn1 = _mm_min_ps(b, mn1);
+        mx0 = _mm_max_ps(a, mx0);
+        mx1 = _mm_max_ps(b, mx1);
+    }
+    _mm_storeu_ps(mins, mn0);
+    _mm_storeu_ps(mins + 4, mn1);
+    _mm_storeu_ps(maxs, mx0);
+    _mm_storeu_ps(maxs + 4, mx1);
+    peakRangeTail(mins, maxs, src, i, samples);
+    peakLaneReduce(mins, maxs, channels, peaks);
+}
+
+const AudioKernelTable kSSE2Table = {
+    SimdLevel::SSE2,
+    &applyGainRampSSE2,
+    &mixGainRampSSE2,
+    &mixSSE2,
+    &measureSSE2,
+    &rampToFloatSSE2,
+    &doubleToFloatSSE2,
+    &floatToDoubleSSE2,
+    &interleaveSSE2,
+    &deinterleaveSSE2,
+    &int16ToFloatSSE2,
+    &int24ToFloatSSE2,
+    &peakRangeSSE2,
+};
+
+//==============================================================================
+// AVX2: two stereo frames per register
+//==============================================================================
+
+NOMAD_TARGET_AVX2
+void applyGainRampAVX2(double* data, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m256d start = _mm256_set_pd(r.startR, r.startL, r.startR, r.startL);
+    const __m256d delta = _mm256_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m256d two = _mm256_set1_pd(2.0);
+    __m256d idx = _mm256_set_pd(1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 2 <= frames; i += 2) {
+        const __m256d g = _mm256_add_pd(start, _mm256_mul_pd(delta, idx));
+        _mm256_storeu_pd(data + i * 2, _mm256_mul_pd(_mm256_loadu_pd(data + i * 2), g));
+        idx = _mm256_add_pd(idx, two);
+    }
+    applyGainRampTail(data, i, frames, r);
+}
+
+NOMAD_TARGET_AVX2
+void mixGainRampAVX2(double* dst, const double* src, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m256d start = _mm256_set_pd(r.startR, r.startL, r.startR, r.startL);
+    const __m256d delta = _mm256_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m256d two = _mm256_set1_pd(2.0);
+    __m256d idx = _mm256_set_pd(1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 2 <= frames; i += 2) {
+        const __m256d g = _mm256_add_pd(start, _mm256_mul_pd(delta, idx));
+        const __m256d v = _mm256_mul_pd(_mm256_loadu_pd(src + i * 2), g);
+        _mm256_storeu_pd(dst + i * 2, _mm256_add_pd(_mm256_loadu_pd(dst + i * 2), v));
+        idx = _mm256_add_pd(idx, two);
+    }
+    mixGainRampTail(dst, src, i, frames, r);
+}
+
+NOMAD_TARGET_AVX2
+void mixAVX2(double* dst, const double* src, double gain, size_t samples) noexcept {
+    const __m256d g = _mm256_set1_pd(gain);
+    size_t i = 0;
+    for (; i + 4 <= samples; i += 4) {
+        _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                                _mm256_mul_pd(_mm256_loadu_pd(src + i), g)));
+    }
+    mixTail(dst, src, gain, i, samples);
+}
+
+// Sums of squares in two registers = lanes {0..3} {4..7}.
+NOMAD_TARGET_AVX2
+inline void storeLanesAVX2(LaneState& s, __m256d sq0, __m256d sq1, __m256d peak) noexcept {
+    _mm256_storeu_pd(s.sq, sq0);
+    _mm256_storeu_pd(s.sq + 4, sq1);
+    alignas(32) double p[4];
+    _mm256_store_pd(p, peak);
+    for (uint32_t k = 0; k < 4; ++k) {
+        mergePeak(s, k, p[k]);
+    }
+}
+
+NOMAD_TARGET_AVX2
+void measureAVX2(const double* src, uint32_t frames, StereoLevels& out) noexcept {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    __m256d sq0 = _mm256_setzero_pd();
+    __m256d sq1 = _mm256_setzero_pd();
+    __m256d peak = _mm256_setzero_pd();
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m256d x0 = _mm256_loadu_pd(src + i * 2);
+        const __m256d x1 = _mm256_loadu_pd(src + i * 2 + 4);
+        sq0 = _mm256_add_pd(sq0, _mm256_mul_pd(x0, x0));
+        sq1 = _mm256_add_pd(sq1, _mm256_mul_pd(x1, x1));
+        peak = _mm256_max_pd(peak, _mm256_andnot_pd(signMask, x0));
+        peak = _mm256_max_pd(peak, _mm256_andnot_pd(signMask, x1));
+    }
+    LaneState s;
+    storeLanesAVX2(s, sq0, sq1, peak);
+    measureTail(s, src, i, frames);
+    finish(s, out);
+}
+
+NOMAD_TARGET_AVX2
+void rampToFloatAVX2(float* dst, const double* src, uint32_t frames, const StereoRamp& r,
+                     StereoLevels& out) noexcept {
+    const __m256d start = _mm256_set_pd(r.startR, r.startL, r.startR, r.startL);
+    const __m256d delta = _mm256_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+    __m256d sq0 = _mm256_setzero_pd();
+    __m256d sq1 = _mm256_setzero_pd();
+    __m256d peak = _mm256_setzero_pd();
+    __m256d idx = _mm256_set_pd(1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m256d g0 = _mm256_add_pd(start, _mm256_mul_pd(delta, idx));
+        const __m256d g1 = _mm256_add_pd(start, _mm256_mul_pd(delta, _mm256_add_pd(idx, two)));
+        const __m256d x0 = _mm256_mul_pd(_mm256_loadu_pd(src + i * 2), g0);
+        const __m256d x1 = _mm256_mul_pd(_mm256_loadu_pd(src + i * 2 + 4), g1);
+        sq0 = _mm256_add_pd(sq0, _mm256_mul_pd(x0, x0));
+        sq1 = _mm256_add_pd(sq1, _mm256_mul_pd(x1, x1));
+        peak = _mm256_max_pd(peak, _mm256_andnot_pd(signMask, x0));
+        peak = _mm256_max_pd(peak, _mm256_andnot_pd(signMask, x1));
+        _mm_storeu_ps(dst + i * 2, _mm256_cvtpd_ps(x0));
+        _mm_storeu_ps(dst + i * 2 + 4, _mm256_cvtpd_ps(x1));
+        idx = _mm256_add_pd(idx, four);
+    }
+    LaneState s;
+    storeLanesAVX2(s, sq0, sq1, peak);
+    rampToFloatTail(dst, src, i, frames, r, s);
+    finish(s, out);
+}
+
+NOMAD_TARGET_AVX2
+void doubleToFloatAVX2(float* dst, const double* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+        _mm_storeu_ps(dst + i + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i + 4)));
+    }
+    doubleToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX2
+void floatToDoubleAVX2(double* dst, const float* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+        _mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(src + i + 4)));
+    }
+    floatToDoubleTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX2
+void interleaveAVX2(float* dst, const float* left, const float* right, uint32_t frames) noexcept {
+    uint32_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 l = _mm256_loadu_ps(left + i);
+        const __m256 r = _mm256_loadu_ps(right + i);
+        const __m256 lo = _mm256_unpacklo_ps(l, r);   // l0 r0 l1 r1 | l4 r4 l5 r5
+        const __m256 hi = _mm256_unpackhi_ps(l, r);   // l2 r2 l3 r3 | l6 r6 l7 r7
+        _mm256_storeu_ps(dst + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(dst + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    interleaveTail(dst, left, right, i, frames);
+}
+
+NOMAD_TARGET_AVX2
+void deinterleaveAVX2(float* left, float* right, const float* src, uint32_t frames) noexcept {
+    uint32_t i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 a = _mm256_loadu_ps(src + i * 2);
+        const __m256 b = _mm256_loadu_ps(src + i * 2 + 8);
+        // Within 128-bit halves: l0 l1 l4 l5 | l2 l3 l6 l7, then fix the 64-bit order.
+        const __m256 l = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm256_storeu_ps(left + i, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(l), 0xD8)));
+        _mm256_storeu_ps(right + i, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), 0xD8)));
+    }
+    deinterleaveTail(left, right, src, i, frames);
+}
+
+NOMAD_TARGET_AVX2
+void int16ToFloatAVX2(float* dst, const uint8_t* src, size_t samples) noexcept {
+    const __m256 scale = _mm256_set1_ps(kInt16Scale);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2 + 16));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), scale));
+    }
+    int16ToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX2
+void int24ToFloatAVX2(float* dst, const uint8_t* src, size_t samples) noexcept {
+    const __m256 scale = _mm256_set1_ps(kInt24Scale);
+    // Per 128-bit lane: four samples into the top three bytes of each dword.
+    const __m256i spread = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                            -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    size_t i = 0;
+    // The upper load reads four bytes past the eighth sample (into the next two).
+    for (; i + 10 <= samples; i += 8) {
+        const uint8_t* p = src + i * 3;
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 12));
+        const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        const __m256i s = _mm256_srai_epi32(_mm256_shuffle_epi8(v, spread), 8);
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(s), scale));
+    }
+    int24ToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX2
+void peakRangeAVX2(const float* src, size_t frames, uint32_t channels, float* peaks) noexcept {
+    if (!peakLanesFit(channels)) {
+        peakRangeGeneric(src, frames, channels, peaks);
+        return;
+    }
+    float mins[kPeakLanes], maxs[kPeakLanes];
+    peakLaneInit(mins, maxs, peaks, channels);
+    __m256 mn = _mm256_loadu_ps(mins);
+    __m256 mx = _mm256_loadu_ps(maxs);
+    const size_t samples = frames * channels;
+    size_t i = 0;
+    for (; i + kPeakLanes <= samples; i += kPeakLanes) {
+        const __m256 v = _mm256_loadu_ps(src + i);
+        mn = _mm256_min_ps(v, mn);
+        mx = _mm256_max_ps(v, mx);
+    }
+    _mm256_storeu_ps(mins, mn);
+    _mm256_storeu_ps(maxs, mx);
+    peakRangeTail(mins, maxs, src, i, samples);
+    peakLaneReduce(mins, maxs, channels, peaks);
+}
+
+const AudioKernelTable kAVX2Table = {
+    SimdLevel::AVX2,
+    &applyGainRampAVX2,
+    &mixGainRampAVX2,
+    &mixAVX2,
+    &measureAVX2,
+    &rampToFloatAVX2,
+    &doubleToFloatAVX2,
+    &floatToDoubleAVX2,
+    &interleaveAVX2,
+    &deinterleaveAVX2,
+    &int16ToFloatAVX2,
+    &int24ToFloatAVX2,
+    &peakRangeAVX2,
+};
+
+//==============================================================================
+// AVX-512: four stereo frames per register
+//==============================================================================
+
+// GCC's unmasked max/convert intrinsics pass an _mm512_undefined_*() source to
+// their masked builtins, which trips -Wmaybe-uninitialized. The zero-masking
+// forms with a full mask compile to the same instructions without it.
+constexpr __mmask8 kAllLanes8 = 0xFF;
+constexpr __mmask16 kAllLanes16 = 0xFFFF;
+
+NOMAD_TARGET_AVX512
+void applyGainRampAVX512(double* data, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m512d start = _mm512_set_pd(r.startR, r.startL, r.startR, r.startL,
+                                        r.startR, r.startL, r.startR, r.startL);
+    const __m512d delta = _mm512_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL,
+                                        r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m512d four = _mm512_set1_pd(4.0);
+    __m512d idx = _mm512_set_pd(3.0, 3.0, 2.0, 2.0, 1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m512d g = _mm512_add_pd(start, _mm512_mul_pd(delta, idx));
+        _mm512_storeu_pd(data + i * 2, _mm512_mul_pd(_mm512_loadu_pd(data + i * 2), g));
+        idx = _mm512_add_pd(idx, four);
+    }
+    applyGainRampTail(data, i, frames, r);
+}
+
+NOMAD_TARGET_AVX512
+void mixGainRampAVX512(double* dst, const double* src, uint32_t frames, const StereoRamp& r) noexcept {
+    const __m512d start = _mm512_set_pd(r.startR, r.startL, r.startR, r.startL,
+                                        r.startR, r.startL, r.startR, r.startL);
+    const __m512d delta = _mm512_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL,
+                                        r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m512d four = _mm512_set1_pd(4.0);
+    __m512d idx = _mm512_set_pd(3.0, 3.0, 2.0, 2.0, 1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m512d g = _mm512_add_pd(start, _mm512_mul_pd(delta, idx));
+        const __m512d v = _mm512_mul_pd(_mm512_loadu_pd(src + i * 2), g);
+        _mm512_storeu_pd(dst + i * 2, _mm512_add_pd(_mm512_loadu_pd(dst + i * 2), v));
+        idx = _mm512_add_pd(idx, four);
+    }
+    mixGainRampTail(dst, src, i, frames, r);
+}
+
+NOMAD_TARGET_AVX512
+void mixAVX512(double* dst, const double* src, double gain, size_t samples) noexcept {
+    const __m512d g = _mm512_set1_pd(gain);
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                                _mm512_mul_pd(_mm512_loadu_pd(src + i), g)));
+    }
+    mixTail(dst, src, gain, i, samples);
+}
+
+// Sums of squares in one register = lanes {0..7}.
+NOMAD_TARGET_AVX512
+inline void storeLanesAVX512(LaneState& s, __m512d sq, __m512d peak) noexcept {
+    _mm512_storeu_pd(s.sq, sq);
+    alignas(64) double p[8];
+    _mm512_store_pd(p, peak);
+    for (uint32_t k = 0; k < 8; ++k) {
+        mergePeak(s, k, p[k]);
+    }
+}
+
+NOMAD_TARGET_AVX512
+void measureAVX512(const double* src, uint32_t frames, StereoLevels& out) noexcept {
+    __m512d sq = _mm512_setzero_pd();
+    __m512d peak = _mm512_setzero_pd();
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m512d x = _mm512_loadu_pd(src + i * 2);
+        sq = _mm512_add_pd(sq, _mm512_mul_pd(x, x));
+        peak = _mm512_maskz_max_pd(kAllLanes8, peak, _mm512_abs_pd(x));
+    }
+    LaneState s;
+    storeLanesAVX512(s, sq, peak);
+    measureTail(s, src, i, frames);
+    finish(s, out);
+}
+
+NOMAD_TARGET_AVX512
+void rampToFloatAVX512(float* dst, const double* src, uint32_t frames, const StereoRamp& r,
+                       StereoLevels& out) noexcept {
+    const __m512d start = _mm512_set_pd(r.startR, r.startL, r.startR, r.startL,
+                                        r.startR, r.startL, r.startR, r.startL);
+    const __m512d delta = _mm512_set_pd(r.deltaR, r.deltaL, r.deltaR, r.deltaL,
+                                        r.deltaR, r.deltaL, r.deltaR, r.deltaL);
+    const __m512d four = _mm512_set1_pd(4.0);
+    __m512d sq = _mm512_setzero_pd();
+    __m512d peak = _mm512_setzero_pd();
+    __m512d idx = _mm512_set_pd(3.0, 3.0, 2.0, 2.0, 1.0, 1.0, 0.0, 0.0);
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m512d g = _mm512_add_pd(start, _mm512_mul_pd(delta, idx));
+        const __m512d x = _mm512_mul_pd(_mm512_loadu_pd(src + i * 2), g);
+        sq = _mm512_add_pd(sq, _mm512_mul_pd(x, x));
+        peak = _mm512_maskz_max_pd(kAllLanes8, peak, _mm512_abs_pd(x));
+        _mm256_storeu_ps(dst + i * 2, _mm512_maskz_cvtpd_ps(kAllLanes8, x));
+        idx = _mm512_add_pd(idx, four);
+    }
+    LaneState s;
+    storeLanesAVX512(s, sq, peak);
+    rampToFloatTail(dst, src, i, frames, r, s);
+    finish(s, out);
+}
+
+NOMAD_TARGET_AVX512
+void doubleToFloatAVX512(float* dst, const double* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm512_maskz_cvtpd_ps(kAllLanes8, _mm512_loadu_pd(src + i)));
+    }
+    doubleToFloatTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX512
+void floatToDoubleAVX512(double* dst, const float* src, size_t samples) noexcept {
+    size_t i = 0;
+    for (; i + 8 <= samples; i += 8) {
+        _mm512_storeu_pd(dst + i, _mm512_maskz_cvtps_pd(kAllLanes8, _mm256_loadu_ps(src + i)));
+    }
+    floatToDoubleTail(dst, src, i, samples);
+}
+
+NOMAD_TARGET_AVX512
+void interleaveAVX512(float* dst, const float* left, const float* right, uint32_t frames) noexcept {
+    // Index bit 4 selects the second operand (right).
+    const __m512i lo = _mm512_set_epi32(23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+    const __m512i hi = _mm512_set_epi32(31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8);
+    uint32_t i = 0;
+    for (; i + 16 <= frames; i += 16) {
+        const __m512 l = _mm512_loadu_ps(left + i);
+        const __m512 r = _mm512_loadu_ps(right + i);
+        _mm512_storeu_ps(dst + i * 2, _mm512_permutex2var_ps(l, lo, r));
+        _mm512_storeu_ps(dst + i * 2 + 16, _mm512_permutex2var_ps(l, hi, r));
+    }
+    interleaveTail(dst, left, right, i, frames);
+}
+
+NOMAD_TARGET_AVX512
+void deinterleaveAVX512(float* left, float* right, const float* src, uint32_t frames) noexcept {
+    const __m512i even = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i odd = _mm512_set_epi32(31, 29, 27, 25, 23, 21, 19, 17, 15, 13, 11, 9, 7, 5, 3, 1);
+    uint32_t i = 0;
+    for (; i + 16 <= frames; i += 16) {
+        const __m512 a = _mm512_loadu_ps(src + i * 2);
+        const __m512 b = _mm512_loadu_ps(src + i * 2 + 16);
+        _mm512_storeu_ps(left + i, _mm512_permutex2var_ps(a, even, b));
+        _mm512_storeu_ps(right + i, _mm512_permutex2var_ps(a, odd, b));
+    }
+    deinterleaveTail(left, right, src, i, frames);
+}
+
+NOMAD_TARGET_AVX512
+void int16ToFloatAVX512(float* dst, const uint8_t* src, size_t samples) noexcept {
+    const __m512 scale = _mm512_set1_ps(kInt16Scale);
+    size_t i = 0;
+    for (; i + 16 <= samples; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 2));
+        const __m512i wide = _mm512_maskz_cvtepi16_epi32(kAllLanes16, v);
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(kAllLanes16, wide), scale));
+    }
+    int16ToFloatTail(dst, src, i, samples);
+}
+
+const AudioKernelTable kAVX512Table = {
+    SimdLevel::AVX512,
+    &applyGainRampAVX512,
+    &mixGainRampAVX512,
+    &mixAVX512,
+    &measureAVX512,
+    &rampToFloatAVX512,
+    &doubleToFloatAVX512,
+    &floatToDoubleAVX512,
+    &interleaveAVX512,
+    &deinterleaveAVX512,
+    &int16ToFloatAVX512,
+    &int24ToFloatAVX2,   // AVX-512F has no byte shuffle (that is AVX-512BW)
+    &peakRangeAVX2,      // Sixteen lanes would reorder the eight-lane reduction
+};
+
+#endif // NOMAD_KERNELS_X86
+
+//==============================================================================
+// Dispatch
+//==============================================================================
+
+SimdLevel probeCpu() noexcept {
+#ifdef NOMAD_KERNELS_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    bool avx512f = false;
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+    }
+    // The OS must save the wider register files across context switches.
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+    const bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+    if (avx512f && zmmEnabled) return SimdLevel::AVX512;
+    if (avx && avx2 && ymmEnabled) return SimdLevel::AVX2;
+    if (sse2) return SimdLevel::SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+const AudioKernelTable* tableFor(SimdLevel level) noexcept {
+    switch (level) {
+#ifdef NOMAD_KERNELS_X86
+        case SimdLevel::AVX512: return &kAVX512Table;
+        case SimdLevel::AVX2: return &kAVX2Table;
+        case SimdLevel::SSE2: return &kSSE2Table;
+#endif
+        default: return &kScalarTable;
+    }
+}
+
+std::atomic<const AudioKernelTable*> g_active{nullptr};
+
+} // anonymous namespace
+
+SimdLevel AudioKernels::detectedLevel() noexcept {
+    static const SimdLevel level = probeCpu();
+    return level;
+}
+
+const AudioKernelTable& AudioKernels::active() noexcept {
+    const AudioKernelTable* t = g_active.load(std::memory_order_acquire);
+    if (!t) {
+        // First use: racing initialisers all store the same table.
+        t = tableFor(detectedLevel());
+        g_active.store(t, std::memory_order_release);
+    }
+    return *t;
+}
+
+const AudioKernelTable* AudioKernels::table(SimdLevel level) noexcept {
+    if (static_cast<uint8_t>(level) > static_cast<uint8_t>(detectedLevel())) {
+        return nullptr;
+    }
+    const AudioKernelTable* t = tableFor(level);
+    return t->level == level ? t : nullptr;
+}
+
+void AudioKernels::setLevel(SimdLevel level) noexcept {
+    if (static_cast<uint8_t>(level) > static_cast<uint8_t>(detectedLevel())) {
+        level = detectedLevel();
+    }
+    g_active.store(tableFor(level), std::memory_order_release);
+}
+
+const char* AudioKernels::levelName(SimdLevel level) noexcept {
+    switch (level) {
+        case SimdLevel::Scalar: return "Scalar";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+    }
+    return "Unknown";
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -1,15 +1,14 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 
 #include "ChannelSlotMap.h"
+#include "AudioGraph.h"
 #include "Track.h"
 
 namespace Nomad {
 namespace Audio {
 
 void ChannelSlotMap::rebuild(const std::vector<std::shared_ptr<Track>>& tracks) {
-    m_idToSlot.clear();
-    m_slotToId.clear();
-    m_channelCount = 0;
+    clear();
 
     uint32_t slot = 0;
     for (const auto& track : tracks) {
@@ -23,6 +22,25 @@ void ChannelSlotMap::rebuild(const std::vector<std::shared_ptr<Track>>& tracks)
     m_channelCount = slot;
 }
 
+void ChannelSlotMap::rebuild(const AudioGraph& graph) {
+    clear();
+
+    uint32_t slot = 0;
+    for (const auto& track : graph.tracks) {
+        if (slot < MAX_CHANNEL_SLOTS && m_idToSlot.emplace(track.trackId, slot).second) {
+            m_slotToId[slot] = track.trackId;
+            ++slot;
+        }
+    }
+    m_channelCount = slot;
+    for (const auto& bus : graph.buses) {
+        if (slot < MAX_CHANNEL_SLOTS && m_busToSlot.emplace(bus.busId, slot).second) {
+            ++slot;
+        }
+    }
+    m_busCount = slot - m_channelCount;
+}
+
 uint32_t ChannelSlotMap::getSlotIndex(uint32_t channelId) const {
     auto it = m_idToSlot.find(channelId);
     return (it != m_idToSlot.end()) ? it->second : INVALID_SLOT;
@@ -37,10 +55,17 @@ bool ChannelSlotMap::hasChannel(uint32_t channelId) const {
     return m_idToSlot.find(channelId) != m_idToSlot.end();
 }
 
+uint32_t ChannelSlotMap::getBusSlotIndex(uint32_t busId) const {
+    auto it = m_busToSlot.find(busId);
+    return (it != m_busToSlot.end()) ? it->second : INVALID_SLOT;
+}
+
 void ChannelSlotMap::clear() {
     m_idToSlot.clear();
     m_slotToId.clear();
+    m_busToSlot.clear();
     m_channelCount = 0;
+    m_busCount = 0;
 }
 
 } // namespace Audio
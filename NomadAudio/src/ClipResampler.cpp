@@ -0,0 +1,440 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "ClipResampler.h"
+#include "AudioKernels.h"
+#include "StreamingSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define NOMAD_RESAMPLER_X86 1
+    #include <immintrin.h>
+#endif
+
+// Per-function ISA targets so the rest of the build keeps its baseline flags.
+#if defined(NOMAD_RESAMPLER_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define NOMAD_TARGET_SSE2 __attribute__((target("sse2")))
+    #define NOMAD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define NOMAD_TARGET_SSE2
+    #define NOMAD_TARGET_AVX2
+#endif
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+constexpr uint32_t kPhases = SRCConstants::POLYPHASE_PHASES;
+constexpr uint32_t kTapPadding = 8;        // Row stride granularity (one AVX register)
+constexpr uint32_t kChunkFrames = 256;     // Output frames per planar window
+constexpr uint32_t kWindowFrames = 1024;   // Planar window capacity per channel
+
+using ChunkKernel = void (*)(const ClipResamplerBank& bank, const float* left, const float* right,
+                             int64_t windowStart, double position, double step,
+                             uint32_t first, uint32_t frames, double* dst) noexcept;
+
+double besselI0(double x) noexcept {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+    for (int k = 1; k < 25; ++k) {
+        term *= (halfX / static_cast<double>(k));
+        term *= (halfX / static_cast<double>(k));
+        sum += term;
+        if (term < 1e-12 * sum) break;
+    }
+    return sum;
+}
+
+/// Locates output frame j of a chunk: window offset of its first tap, phase row and blend.
+struct TapPosition {
+    int64_t offset;
+    uint32_t phase;
+    float blend;
+};
+
+inline TapPosition locate(const ClipResamplerBank& bank, int64_t windowStart, double position,
+                          double step, uint32_t frame) noexcept {
+    // Relative to the window the position is never negative, so truncation is floor
+    // (std::floor is a libm call on baseline x86-64).
+    const double rel = position + static_cast<double>(frame) * step - static_cast<double>(windowStart);
+    const int64_t whole = static_cast<int64_t>(rel);
+    const double scaled = (rel - static_cast<double>(whole)) * static_cast<double>(kPhases);
+    const uint32_t phase = std::min(static_cast<uint32_t>(scaled), kPhases - 1);
+    const int64_t lead = static_cast<int64_t>(bank.numTaps / 2) - 1;
+    return {whole - lead, phase, static_cast<float>(scaled - static_cast<double>(phase))};
+}
+
+void renderChunkScalar(const ClipResamplerBank& bank, const float* left, const float* right,
+                       int64_t windowStart, double position, double step,
+                       uint32_t first, uint32_t frames, double* dst) noexcept {
+    const uint32_t taps = bank.numTaps;
+    for (uint32_t j = 0; j < frames; ++j) {
+        const TapPosition at = locate(bank, windowStart, position, step, first + j);
+        const float* c0 = bank.row(at.phase);
+        const float* c1 = c0 + bank.stride;
+        const float* l = left + at.offset;
+        const float* r = right + at.offset;
+        float sumL = 0.0f;
+        float sumR = 0.0f;
+        for (uint32_t k = 0; k < taps; ++k) {
+            const float c = c0[k] + at.blend * (c1[k] - c0[k]);
+            sumL += l[k] * c;
+            sumR += r[k] * c;
+        }
+        dst[j * 2] = static_cast<double>(sumL);
+        dst[j * 2 + 1] = static_cast<double>(sumR);
+    }
+}
+
+#ifdef NOMAD_RESAMPLER_X86
+
+NOMAD_TARGET_SSE2
+inline float horizontalSum(__m128 v) noexcept {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    sums = _mm_add_ss(sums, shuf);
+    return _mm_cvtss_f32(sums);
+}
+
+NOMAD_TARGET_SSE2
+void renderChunkSSE2(const ClipResamplerBank& bank, const float* left, const float* right,
+                     int64_t windowStart, double position, double step,
+                     uint32_t first, uint32_t frames, double* dst) noexcept {
+    // Four-tap filters (Linear pads to one register pair) only need the first half-row.
+    const uint32_t taps = bank.numTaps <= 4 ? 4 : bank.stride;
+    for (uint32_t j = 0; j < frames; ++j) {
+        const TapPosition at = locate(bank, windowStart, position, step, first + j);
+        const float* c0 = bank.row(at.phase);
+        const float* c1 = c0 + bank.stride;
+        const float* l = left + at.offset;
+        const float* r = right + at.offset;
+        const __m128 blend = _mm_set1_ps(at.blend);
+        __m128 accL = _mm_setzero_ps();
+        __m128 accR = _mm_setzero_ps();
+        for (uint32_t k = 0; k < taps; k += 4) {
+            const __m128 a = _mm_loadu_ps(c0 + k);
+            const __m128 c = _mm_add_ps(a, _mm_mul_ps(blend, _mm_sub_ps(_mm_loadu_ps(c1 + k), a)));
+            accL = _mm_add_ps(accL, _mm_mul_ps(_mm_loadu_ps(l + k), c));
+            accR = _mm_add_ps(accR, _mm_mul_ps(_mm_loadu_ps(r + k), c));
+        }
+        dst[j * 2] = static_cast<double>(horizontalSum(accL));
+        dst[j * 2 + 1] = static_cast<double>(horizontalSum(accR));
+    }
+}
+
+NOMAD_TARGET_AVX2
+void renderChunkAVX2(const ClipResamplerBank& bank, const float* left, const float* right,
+                     int64_t windowStart, double position, double step,
+                     uint32_t first, uint32_t frames, double* dst) noexcept {
+    if (bank.numTaps <= 4) {
+        // A 256-bit register would be half padding; SSE is as fast here.
+        renderChunkSSE2(bank, left, right, windowStart, position, step, first, frames, dst);
+        return;
+    }
+    const uint32_t taps = bank.stride;
+    for (uint32_t j = 0; j < frames; ++j) {
+        const TapPosition at = locate(bank, windowStart, position, step, first + j);
+        const float* c0 = bank.row(at.phase);
+        const float* c1 = c0 + bank.stride;
+        const float* l = left + at.offset;
+        const float* r = right + at.offset;
+        const __m256 blend = _mm256_set1_ps(at.blend);
+        __m256 accL = _mm256_setzero_ps();
+        __m256 accR = _mm256_setzero_ps();
+        for (uint32_t k = 0; k < taps; k += 8) {
+            const __m256 a = _mm256_loadu_ps(c0 + k);
+            const __m256 c = _mm256_add_ps(a, _mm256_mul_ps(blend, _mm256_sub_ps(_mm256_loadu_ps(c1 + k), a)));
+            accL = _mm256_add_ps(accL, _mm256_mul_ps(_mm256_loadu_ps(l + k), c));
+            accR = _mm256_add_ps(accR, _mm256_mul_ps(_mm256_loadu_ps(r + k), c));
+        }
+        // Reduce both channels together: [L0..3 + L4..7 | R0..3 + R4..7]
+        const __m256 lo = _mm256_permute2f128_ps(accL, accR, 0x20);
+        const __m256 hi = _mm256_permute2f128_ps(accL, accR, 0x31);
+        const __m256 pairs = _mm256_add_ps(lo, hi);
+        const __m256 sums = _mm256_hadd_ps(pairs, pairs);
+        const __m256 total = _mm256_hadd_ps(sums, sums);
+        dst[j * 2] = static_cast<double>(_mm256_cvtss_f32(total));
+        dst[j * 2 + 1] = static_cast<double>(_mm_cvtss_f32(_mm256_extractf128_ps(total, 1)));
+    }
+}
+
+#endif // NOMAD_RESAMPLER_X86
+
+/// Follows the AudioKernels tier so forcing a tier down covers the resampler too.
+/// AVX-512 uses the AVX2 loop: rows are at most 64 taps and mostly 8 or 16.
+ChunkKernel kernelFor(SimdLevel level) noexcept {
+#ifdef NOMAD_RESAMPLER_X86
+    switch (level) {
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            return &renderChunkAVX2;
+        case SimdLevel::SSE2:
+            return &renderChunkSSE2;
+        case SimdLevel::Scalar:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    return &renderChunkScalar;
+}
+
+/// Deinterleave source frames [start, start + count) into the planar window;
+/// frames outside the clip are silence.
+/// Zero-pads the window outside [0, totalFrames); load(left, right, first, count) fills the rest.
+template <typename LoadFrames>
+void fillWindow(float* left, float* right, uint64_t totalFrames, int64_t start, uint32_t count,
+                LoadFrames&& load) noexcept {
+    const int64_t total = static_cast<int64_t>(totalFrames);
+    const int64_t end = start + static_cast<int64_t>(count);
+    const int64_t validStart = std::clamp<int64_t>(start, 0, total);
+    const int64_t validEnd = std::clamp<int64_t>(end, 0, total);
+
+    if (validEnd <= validStart) {
+        std::memset(left, 0, count * sizeof(float));
+        std::memset(right, 0, count * sizeof(float));
+        return;
+    }
+    const uint32_t before = static_cast<uint32_t>(validStart - start);
+    const uint32_t inside = static_cast<uint32_t>(validEnd - validStart);
+    const uint32_t after = count - before - inside;
+    if (before > 0) {
+        std::memset(left, 0, before * sizeof(float));
+        std::memset(right, 0, before * sizeof(float));
+    }
+    load(left + before, right + before, static_cast<uint64_t>(validStart), inside);
+    if (after > 0) {
+        std::memset(left + before + inside, 0, after * sizeof(float));
+        std::memset(right + before + inside, 0, after * sizeof(float));
+    }
+}
+
+/// Chunk loop shared by every source: fill(left, right, start, count) loads the planar window.
+template <typename FillWindow>
+void renderBlock(const ClipResamplerBank& bank, double position, double step,
+                 double* dst, uint32_t frames, FillWindow&& fill) noexcept {
+    const ChunkKernel render = kernelFor(AudioKernels::active().level);
+    const int64_t lead = static_cast<int64_t>(bank.numTaps / 2) - 1;
+
+    // Planar window on the stack; chunks are sized so the frames they read fit.
+    alignas(64) float left[kWindowFrames];
+    alignas(64) float right[kWindowFrames];
+    const double span = static_cast<double>(kWindowFrames - bank.stride - 2);
+    const uint32_t chunkLimit = static_cast<uint32_t>(
+        std::clamp(span / step, 1.0, static_cast<double>(kChunkFrames)));
+
+    uint32_t done = 0;
+    while (done < frames) {
+        const uint32_t n = std::min(frames - done, chunkLimit);
+        const double firstPos = position + static_cast<double>(done) * step;
+        const double lastPos = position + static_cast<double>(done + n - 1) * step;
+        const int64_t windowStart = static_cast<int64_t>(std::floor(firstPos)) - lead;
+        const int64_t windowEnd = static_cast<int64_t>(std::floor(lastPos)) - lead + bank.stride;
+        const int64_t count = windowEnd - windowStart;
+        if (count > static_cast<int64_t>(kWindowFrames)) {
+            // Only reachable with absurd steps (> ~900 source frames per output frame).
+            std::memset(dst + static_cast<size_t>(done) * 2, 0, static_cast<size_t>(frames - done) * 2 * sizeof(double));
+            return;
+        }
+        fill(left, right, windowStart, static_cast<uint32_t>(count));
+        render(bank, left, right, windowStart, position, step, done, n, dst + static_cast<size_t>(done) * 2);
+        done += n;
+    }
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Configuration (non-RT)
+// =============================================================================
+
+void ClipResampler::configure(double sourceRate, double outputRate, SRCQuality quality) {
+    m_sourceRate = sourceRate;
+    m_outputRate = outputRate;
+    m_step = (sourceRate > 0.0 && outputRate > 0.0) ? sourceRate / outputRate : 1.0;
+
+    // Same cutoff rule as SampleRateConverter: output Nyquist when downsampling,
+    // slight roll-off otherwise. Linear and Catmull-Rom have fixed responses.
+    double cutoff = 1.0;
+    if (tapsFor(quality) > 4) {
+        cutoff = m_step > 1.0 ? 0.95 / m_step : 0.98;
+    }
+    m_bank = bankFor(quality, cutoff);
+}
+
+uint32_t ClipResampler::tapsFor(SRCQuality quality) noexcept {
+    switch (quality) {
+        case SRCQuality::Linear: return 2;
+        case SRCQuality::Cubic:  return 4;
+        case SRCQuality::Sinc8:  return 8;
+        case SRCQuality::Sinc16: return 16;
+        case SRCQuality::Sinc64: return 64;
+    }
+    return 4;
+}
+
+const char* ClipResampler::qualityName(SRCQuality quality) noexcept {
+    switch (quality) {
+        case SRCQuality::Linear: return "Linear";
+        case SRCQuality::Cubic:  return "Cubic";
+        case SRCQuality::Sinc8:  return "Sinc8";
+        case SRCQuality::Sinc16: return "Sinc16";
+        case SRCQuality::Sinc64: return "Sinc64";
+    }
+    return "Unknown";
+}
+
+std::shared_ptr<const ClipResamplerBank> ClipResampler::bankFor(SRCQuality quality, double cutoff) {
+    // A session only ever uses a handful of rate pairs; tables live for the process.
+    static std::mutex s_mutex;
+    static std::vector<std::shared_ptr<const ClipResamplerBank>> s_banks;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    for (const auto& bank : s_banks) {
+        if (bank->quality == quality && bank->cutoff == cutoff) {
+            return bank;
+        }
+    }
+    s_banks.push_back(buildBank(quality, cutoff));
+    return s_banks.back();
+}
+
+std::shared_ptr<const ClipResamplerBank> ClipResampler::buildBank(SRCQuality quality, double cutoff) {
+    auto bank = std::make_shared<ClipResamplerBank>();
+    const uint32_t taps = tapsFor(quality);
+    bank->numTaps = taps;
+    bank->stride = (taps + kTapPadding - 1) / kTapPadding * kTapPadding;
+    bank->quality = quality;
+    bank->cutoff = cutoff;
+    bank->coeffs.assign(static_cast<size_t>(kPhases + 1) * bank->stride, 0.0f);
+
+    double beta = SRCConstants::KAISER_BETA_DEFAULT;
+    if (quality == SRCQuality::Sinc8) beta = 6.0;
+    else if (quality == SRCQuality::Sinc64) beta = 10.0;
+
+    // Tap k sits at source frame floor(pos) - (taps/2 - 1) + k, i.e. distance
+    // x = k - (taps/2 - 1) - frac from the wanted position.
+    const double half = static_cast<double>(taps / 2);
+    for (uint32_t phase = 0; phase <= kPhases; ++phase) {
+        const double frac = static_cast<double>(phase) / static_cast<double>(kPhases);
+        float* row = bank->coeffs.data() + static_cast<size_t>(phase) * bank->stride;
+
+        if (quality == SRCQuality::Linear) {
+            row[0] = static_cast<float>(1.0 - frac);
+            row[1] = static_cast<float>(frac);
+            continue;
+        }
+        if (quality == SRCQuality::Cubic) {
+            // Catmull-Rom weights for frames -1, 0, +1, +2
+            const double f2 = frac * frac;
+            const double f3 = f2 * frac;
+            row[0] = static_cast<float>(0.5 * (-f3 + 2.0 * f2 - frac));
+            row[1] = static_cast<float>(0.5 * (3.0 * f3 - 5.0 * f2 + 2.0));
+            row[2] = static_cast<float>(0.5 * (-3.0 * f3 + 4.0 * f2 + frac));
+            row[3] = static_cast<float>(0.5 * (f3 - f2));
+            continue;
+        }
+
+        double weights[SRCConstants::MAX_FILTER_TAPS];
+        double sum = 0.0;
+        for (uint32_t k = 0; k < taps; ++k) {
+            const double x = static_cast<double>(k) - (half - 1.0) - frac;
+            double sinc = cutoff;
+            if (std::abs(x) > 1e-10) {
+                sinc = std::sin(SRCConstants::PI * x * cutoff) / (SRCConstants::PI * x);
+            }
+            // Kaiser window follows the fractional position so every phase is symmetric.
+            const double r = x / half;
+            const double window = besselI0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(beta);
+            weights[k] = sinc * window;
+            sum += weights[k];
+        }
+        const double norm = sum > 1e-10 ? 1.0 / sum : 1.0;   // Unity DC gain
+        for (uint32_t k = 0; k < taps; ++k) {
+            row[k] = static_cast<float>(weights[k] * norm);
+        }
+    }
+    return bank;
+}
+
+// =============================================================================
+// Processing (RT)
+// =============================================================================
+
+void ClipResampler::process(const float* source, uint64_t totalFrames, double position, double step,
+                            double* dst, uint32_t frames) const noexcept {
+    if (frames == 0) {
+        return;
+    }
+    if (!m_bank || !source || !(step > 0.0)) {
+        std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+        return;
+    }
+    const AudioKernelTable& kernels = AudioKernels::active();
+    renderBlock(*m_bank, position, step, dst, frames,
+                [&](float* left, float* right, int64_t start, uint32_t count) noexcept {
+                    fillWindow(left, right, totalFrames, start, count,
+                               [&](float* l, float* r, uint64_t first, uint32_t n) noexcept {
+                                   kernels.deinterleave(l, r, source + first * 2, n);
+                               });
+                });
+}
+
+void ClipResampler::process(const uint8_t* source, uint32_t sampleBytes, uint64_t totalFrames, double position,
+                            double step, double* dst, uint32_t frames) const noexcept {
+    if (frames == 0) {
+        return;
+    }
+    if (!m_bank || !source || !(step > 0.0)) {
+        std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+        return;
+    }
+    const AudioKernelTable& kernels = AudioKernels::active();
+    renderBlock(*m_bank, position, step, dst, frames,
+                [&](float* left, float* right, int64_t start, uint32_t count) noexcept {
+                    fillWindow(left, right, totalFrames, start, count,
+                               [&](float* l, float* r, uint64_t first, uint32_t n) noexcept {
+                                   // Unpack the window once, then split it like float data.
+                                   alignas(64) float interleaved[kWindowFrames * 2];
+                                   kernels.unpack(interleaved, source + first * 2 * sampleBytes, sampleBytes,
+                                                  static_cast<size_t>(n) * 2);
+                                   kernels.deinterleave(l, r, interleaved, n);
+                               });
+                });
+}
+
+bool ClipResampler::process(StreamingSource& source, double position, double step,
+                            double* dst, uint32_t frames) const noexcept {
+    if (frames == 0) {
+        return true;
+    }
+    if (!m_bank || !(step > 0.0)) {
+        std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+        return true;
+    }
+    const AudioKernelTable& kernels = AudioKernels::active();
+    bool complete = true;
+    renderBlock(*m_bank, position, step, dst, frames,
+                [&](float* left, float* right, int64_t start, uint32_t count) noexcept {
+                    // Frames before the clip are silence; the source pads past its end.
+                    alignas(64) float interleaved[kWindowFrames * 2];
+                    const uint32_t before = start < 0 ? static_cast<uint32_t>(std::min<int64_t>(-start, count)) : 0;
+                    if (before > 0) {
+                        std::memset(left, 0, before * sizeof(float));
+                        std::memset(right, 0, before * sizeof(float));
+                    }
+                    if (before < count) {
+                        complete &= source.read(static_cast<uint64_t>(start + before), count - before, interleaved);
+                        kernels.deinterleave(left + before, right + before, interleaved, count - before);
+                    }
+                });
+    return complete;
+}
+
+} // namespace Audio
+} // namespace Nomad
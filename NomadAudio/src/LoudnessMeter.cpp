@@ -0,0 +1,312 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "LoudnessMeter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kAbsoluteGateLufs = -70.0;
+constexpr double kIntegratedRelativeGate = -10.0;   // LU below the absolute-gated mean
+constexpr double kRangeRelativeGate = -20.0;        // EBU Tech 3342
+constexpr double kHistogramFloorLufs = -70.0;
+constexpr double kHistogramStepLu = 0.1;
+
+// BS.1770-4 Annex 2: 48-tap 4x interpolator as four 12-tap phases.
+constexpr double kTruePeakPhases[4][12] = {
+    { 0.0017089843750,  0.0109863281250, -0.0196533203125,  0.0332031250000,
+     -0.0594482421875,  0.1373291015625,  0.9721679687500, -0.1022949218750,
+      0.0476074218750, -0.0266113281250,  0.0148925781250, -0.0083007812500},
+    {-0.0291748046875,  0.0292968750000, -0.0517578125000,  0.0891113281250,
+     -0.1665039062500,  0.4650878906250,  0.7797851562500, -0.2003173828125,
+      0.1015625000000, -0.0582275390625,  0.0330810546875, -0.0189208984375},
+    {-0.0189208984375,  0.0330810546875, -0.0582275390625,  0.1015625000000,
+     -0.2003173828125,  0.7797851562500,  0.4650878906250, -0.1665039062500,
+      0.0891113281250, -0.0517578125000,  0.0292968750000, -0.0291748046875},
+    {-0.0083007812500,  0.0148925781250, -0.0266113281250,  0.0476074218750,
+     -0.1022949218750,  0.9721679687500,  0.1373291015625, -0.0594482421875,
+      0.0332031250000, -0.0196533203125,  0.0109863281250,  0.0017089843750},
+};
+
+double energyToLufs(double energy) noexcept {
+    return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -std::numeric_limits<double>::infinity();
+}
+
+inline double runBiquad(double x, const double* c, double* s) noexcept {
+    // c = {b0, b1, b2, a1, a2}; transposed direct form II
+    const double y = c[0] * x + s[0];
+    s[0] = c[1] * x - c[3] * y + s[1];
+    s[1] = c[2] * x - c[4] * y;
+    return y;
+}
+
+} // anonymous namespace
+
+void LoudnessMeter::Histogram::add(double blockEnergy) noexcept {
+    const double bin = std::floor((energyToLufs(blockEnergy) - kHistogramFloorLufs) / kHistogramStepLu);
+    const uint32_t b = static_cast<uint32_t>(std::clamp(bin, 0.0, static_cast<double>(kHistogramBins - 1)));
+    ++counts[b];
+    energy[b] += blockEnergy;
+    ++total;
+}
+
+double LoudnessMeter::Histogram::meanAbove(double gateLufs, uint64_t* count) const noexcept {
+    // Bins straddling the gate are left out: the error is under one bin (0.1 LU) of gate.
+    const double first = std::ceil((gateLufs - kHistogramFloorLufs) / kHistogramStepLu - 1e-9);
+    double sum = 0.0;
+    uint64_t n = 0;
+    for (uint32_t b = static_cast<uint32_t>(std::clamp(first, 0.0, static_cast<double>(kHistogramBins)));
+         b < kHistogramBins; ++b) {
+        sum += energy[b];
+        n += counts[b];
+    }
+    if (count) {
+        *count = n;
+    }
+    return n > 0 ? sum / static_cast<double>(n) : 0.0;
+}
+
+void LoudnessMeter::Histogram::clear() noexcept {
+    counts.fill(0);
+    energy.fill(0.0);
+    total = 0;
+}
+
+void LoudnessMeter::prepare(double sampleRate) noexcept {
+    m_sampleRate = sampleRate;
+    m_stepFrames = sampleRate > 0.0 ? std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(sampleRate * 0.1))) : 0;
+
+    if (sampleRate > 0.0) {
+        // K-weighting for any rate (the BS.1770 tables are the 48 kHz case of these).
+        {
+            const double f0 = 1681.974450955533;
+            const double gainDb = 3.999843853973347;
+            const double q = 0.7071752369554196;
+            const double k = std::tan(kPi * f0 / sampleRate);
+            const double vh = std::pow(10.0, gainDb / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+            m_shelf.b0 = (vh + vb * k / q + k * k) / a0;
+            m_shelf.b1 = 2.0 * (k * k - vh) / a0;
+            m_shelf.b2 = (vh - vb * k / q + k * k) / a0;
+            m_shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+            m_shelf.a2 = (1.0 - k / q + k * k) / a0;
+        }
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+            const double k = std::tan(kPi * f0 / sampleRate);
+            const double a0 = 1.0 + k / q + k * k;
+            m_highPass.b0 = 1.0;
+            m_highPass.b1 = -2.0;
+            m_highPass.b2 = 1.0;
+            m_highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+            m_highPass.a2 = (1.0 - k / q + k * k) / a0;
+        }
+    }
+    reset();
+}
+
+void LoudnessMeter::reset() noexcept {
+    m_stepPos = 0;
+    m_stepEnergy = {};
+    m_steps.fill(0.0);
+    m_stepIndex = 0;
+    m_stepsSeen = 0;
+    m_momentaryBlocks.clear();
+    m_shortTermBlocks.clear();
+    m_truePeak = {};
+    m_readings = LoudnessReadings{};
+    clearSignalState();
+}
+
+void LoudnessMeter::clearSignalState() noexcept {
+    for (auto& state : m_filterState) {
+        state.fill(0.0);
+    }
+    for (auto& history : m_peakHistory) {
+        history.fill(0.0);
+    }
+    m_peakPos = 0;
+    m_signalStateClear = true;
+}
+
+void LoudnessMeter::process(const float* interleaved, uint32_t frames) noexcept {
+    processFrames(interleaved, frames);
+}
+
+void LoudnessMeter::process(const double* interleaved, uint32_t frames) noexcept {
+    processFrames(interleaved, frames);
+}
+
+void LoudnessMeter::processSilence(uint32_t frames) noexcept {
+    if (m_stepFrames == 0 || frames == 0) {
+        return;
+    }
+    if (!m_signalStateClear) {
+        clearSignalState();
+    }
+    while (frames > 0) {
+        const uint32_t n = std::min(frames, m_stepFrames - m_stepPos);
+        m_stepPos += n;
+        frames -= n;
+        if (m_stepPos == m_stepFrames) {
+            completeStep();
+        }
+    }
+}
+
+template <typename Sample>
+void LoudnessMeter::processFrames(const Sample* src, uint32_t frames) noexcept {
+    if (m_stepFrames == 0 || frames == 0) {
+        return;
+    }
+    m_signalStateClear = false;
+    const double shelf[5] = {m_shelf.b0, m_shelf.b1, m_shelf.b2, m_shelf.a1, m_shelf.a2};
+    const double highPass[5] = {m_highPass.b0, m_highPass.b1, m_highPass.b2, m_highPass.a1, m_highPass.a2};
+    double* stateL = m_filterState[0].data();
+    double* stateR = m_filterState[1].data();
+
+    while (frames > 0) {
+        const uint32_t n = std::min(frames, m_stepFrames - m_stepPos);
+        double energyL = 0.0;
+        double energyR = 0.0;
+        double peakL = m_truePeak[0];
+        double peakR = m_truePeak[1];
+        for (uint32_t i = 0; i < n; ++i) {
+            const double L = static_cast<double>(src[i * 2]);
+            const double R = static_cast<double>(src[i * 2 + 1]);
+            const double kL = runBiquad(runBiquad(L, shelf, stateL), highPass, stateL + 2);
+            const double kR = runBiquad(runBiquad(R, shelf, stateR), highPass, stateR + 2);
+            energyL += kL * kL;
+            energyR += kR * kR;
+            peakL = std::max(peakL, truePeakStep(0, L));
+            peakR = std::max(peakR, truePeakStep(1, R));
+            m_peakPos = (m_peakPos + 1) % kTruePeakTaps;
+        }
+        m_truePeak[0] = peakL;
+        m_truePeak[1] = peakR;
+        m_stepEnergy[0] += energyL;
+        m_stepEnergy[1] += energyR;
+        src += static_cast<size_t>(n) * 2;
+        frames -= n;
+        m_stepPos += n;
+        if (m_stepPos == m_stepFrames) {
+            completeStep();
+        }
+    }
+    m_readings.truePeakL = static_cast<float>(m_truePeak[0]);
+    m_readings.truePeakR = static_cast<float>(m_truePeak[1]);
+}
+
+double LoudnessMeter::truePeakStep(uint32_t channel, double x) noexcept {
+    auto& history = m_peakHistory[channel];
+    history[m_peakPos] = x;
+    history[m_peakPos + kTruePeakTaps] = x;
+    // Last kTruePeakTaps inputs, oldest first; x[n - k] is window[kTruePeakTaps - 1 - k].
+    const double* window = history.data() + m_peakPos + 1;
+    double peak = 0.0;
+    for (const auto& phase : kTruePeakPhases) {
+        double y = 0.0;
+        for (uint32_t k = 0; k < kTruePeakTaps; ++k) {
+            y += phase[k] * window[kTruePeakTaps - 1 - k];
+        }
+        peak = std::max(peak, std::abs(y));
+    }
+    return peak;
+}
+
+void LoudnessMeter::completeStep() noexcept {
+    const double energy = (m_stepEnergy[0] + m_stepEnergy[1]) / static_cast<double>(m_stepFrames);
+    m_stepEnergy = {};
+    m_stepPos = 0;
+    m_steps[m_stepIndex] = energy;
+    m_stepIndex = (m_stepIndex + 1) % kShortTermSteps;
+    ++m_stepsSeen;
+
+    double momentary = 0.0;
+    for (uint32_t k = 1; k <= kMomentarySteps; ++k) {
+        momentary += m_steps[(m_stepIndex + kShortTermSteps - k) % kShortTermSteps];
+    }
+    momentary /= static_cast<double>(kMomentarySteps);
+    double shortTerm = 0.0;
+    for (double step : m_steps) {
+        shortTerm += step;
+    }
+    shortTerm /= static_cast<double>(kShortTermSteps);
+
+    const double momentaryLufs = energyToLufs(momentary);
+    const double shortTermLufs = energyToLufs(shortTerm);
+    m_readings.momentaryLufs = static_cast<float>(momentaryLufs);
+    m_readings.shortTermLufs = static_cast<float>(shortTermLufs);
+
+    // Gating blocks overlap by 75% (one every step); windows count once they are full.
+    if (m_stepsSeen >= kMomentarySteps) {
+        m_readings.maxMomentaryLufs = std::max(m_readings.maxMomentaryLufs, m_readings.momentaryLufs);
+        if (momentaryLufs >= kAbsoluteGateLufs) {
+            m_momentaryBlocks.add(momentary);
+        }
+    }
+    if (m_stepsSeen >= kShortTermSteps) {
+        m_readings.maxShortTermLufs = std::max(m_readings.maxShortTermLufs, m_readings.shortTermLufs);
+        if (shortTermLufs >= kAbsoluteGateLufs) {
+            m_shortTermBlocks.add(shortTerm);
+        }
+    }
+    updateGatedReadings();
+}
+
+void LoudnessMeter::updateGatedReadings() noexcept {
+    // Integrated: mean of blocks above the absolute gate sets the relative gate.
+    const double absoluteMean = m_momentaryBlocks.meanAbove(kAbsoluteGateLufs);
+    if (absoluteMean > 0.0) {
+        const double gate = energyToLufs(absoluteMean) + kIntegratedRelativeGate;
+        m_readings.integratedLufs = static_cast<float>(energyToLufs(m_momentaryBlocks.meanAbove(gate)));
+    }
+
+    // Loudness range: spread of the gated short-term values.
+    const double shortMean = m_shortTermBlocks.meanAbove(kAbsoluteGateLufs);
+    if (shortMean <= 0.0) {
+        return;
+    }
+    const double gate = energyToLufs(shortMean) + kRangeRelativeGate;
+    uint64_t count = 0;
+    m_shortTermBlocks.meanAbove(gate, &count);
+    if (count == 0) {
+        return;
+    }
+    const uint64_t lowRank = (count - 1) * 10 / 100;
+    const uint64_t highRank = (count - 1) * 95 / 100;
+    const double first = std::ceil((gate - kHistogramFloorLufs) / kHistogramStepLu - 1e-9);
+    double low = 0.0;
+    double high = 0.0;
+    uint64_t seen = 0;
+    for (uint32_t b = static_cast<uint32_t>(std::clamp(first, 0.0, static_cast<double>(kHistogramBins)));
+         b < kHistogramBins; ++b) {
+        const uint32_t n = m_shortTermBlocks.counts[b];
+        if (n == 0) {
+            continue;
+        }
+        const double centre = kHistogramFloorLufs + (static_cast<double>(b) + 0.5) * kHistogramStepLu;
+        if (seen <= lowRank && lowRank < seen + n) {
+            low = centre;
+        }
+        if (seen <= highRank && highRank < seen + n) {
+            high = centre;
+            break;
+        }
+        seen += n;
+    }
+    m_readings.loudnessRange = static_cast<float>(high - low);
+}
+
+float LoudnessMeter::toDecibels(float linear) noexcept {
+    return linear > 0.0f ? 20.0f * std::log10(linear) : LoudnessReadings::kSilence;
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -2,6 +2,8 @@
 #include "MiniAudioDecoder.h"
 #include "PathUtils.h"
 
+#include <algorithm>
+
 #if defined(NOMAD_USE_MINIAUDIO)
 // Miniaudio is header-only. Provide the implementation unit here when enabled.
 // Expectation: user vendors `miniaudio.h` under NomadAudio/External/miniaudio or similar
@@ -16,7 +18,8 @@ namespace Audio {
 bool loadWithMiniAudio(const std::string& filePath,
                        std::vector<float>& audioData,
                        uint32_t& sampleRate,
-                       uint32_t& numChannels) {
+                       uint32_t& numChannels,
+                       const std::function<bool(float)>& progress) {
     ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
     ma_decoder decoder;
     
@@ -45,10 +48,23 @@ bool loadWithMiniAudio(const std::string& filePath,
     }
 
     audioData.resize(static_cast<size_t>(totalFrames) * ch);
-    ma_uint64 framesRead = ma_decoder_read_pcm_frames(&decoder,
-                                                      audioData.data(),
-                                                      totalFrames,
-                                                      nullptr);
+    // Decode in slices so callers can follow progress and abort.
+    constexpr ma_uint64 kSliceFrames = 65536;
+    ma_uint64 framesRead = 0;
+    while (framesRead < totalFrames) {
+        const ma_uint64 want = std::min<ma_uint64>(kSliceFrames, totalFrames - framesRead);
+        ma_uint64 got = 0;
+        ma_decoder_read_pcm_frames(&decoder, audioData.data() + static_cast<size_t>(framesRead) * ch, want, &got);
+        framesRead += got;
+        if (got < want) {
+            break;
+        }
+        if (progress && !progress(static_cast<float>(framesRead) / static_cast<float>(totalFrames))) {
+            ma_decoder_uninit(&decoder);
+            audioData.clear();
+            return false;
+        }
+    }
     ma_decoder_uninit(&decoder);
 
     if (framesRead == 0) {
@@ -66,6 +82,86 @@ bool loadWithMiniAudio(const std::string& filePath,
     return true;
 }
 
+namespace {
+
+bool initDecoder(const std::string& filePath, ma_uint32 channels, ma_decoder& decoder) {
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, channels, 0);
+#ifdef _WIN32
+    std::wstring widePath = pathStringToWide(filePath);
+    return ma_decoder_init_file_w(widePath.c_str(), &config, &decoder) == MA_SUCCESS;
+#else
+    return ma_decoder_init_file(filePath.c_str(), &config, &decoder) == MA_SUCCESS;
+#endif
+}
+
+class MiniAudioStreamDecoder : public StreamDecoder {
+public:
+    ~MiniAudioStreamDecoder() override {
+        if (m_open) {
+            ma_decoder_uninit(&m_decoder);
+        }
+    }
+
+    bool open(const std::string& filePath) {
+        m_path = filePath;
+        // Probe the native channel count, then decode with miniaudio's stereo mapping.
+        ma_decoder probe;
+        if (!initDecoder(filePath, 0, probe)) {
+            return false;
+        }
+        m_sourceChannels = probe.outputChannels;
+        ma_decoder_uninit(&probe);
+
+        if (!initDecoder(filePath, 2, m_decoder)) {
+            return false;
+        }
+        m_open = true;
+        ma_uint64 totalFrames = 0;
+        if (ma_decoder_get_length_in_pcm_frames(&m_decoder, &totalFrames) != MA_SUCCESS || totalFrames == 0) {
+            return false;
+        }
+        m_numFrames = totalFrames;
+        m_sampleRate = m_decoder.outputSampleRate;
+        return true;
+    }
+
+    uint32_t sampleRate() const override { return m_sampleRate; }
+    uint32_t sourceChannels() const override { return m_sourceChannels; }
+    uint64_t numFrames() const override { return m_numFrames; }
+
+    bool seek(uint64_t frame) override {
+        return ma_decoder_seek_to_pcm_frame(&m_decoder, frame) == MA_SUCCESS;
+    }
+
+    uint32_t read(float* dst, uint32_t frames) override {
+        ma_uint64 framesRead = 0;
+        ma_decoder_read_pcm_frames(&m_decoder, dst, frames, &framesRead);
+        return static_cast<uint32_t>(framesRead);
+    }
+
+    std::unique_ptr<StreamDecoder> reopen() const override {
+        return openMiniAudioStream(m_path);
+    }
+
+private:
+    std::string m_path;
+    ma_decoder m_decoder{};
+    bool m_open{false};
+    uint32_t m_sampleRate{0};
+    uint32_t m_sourceChannels{0};
+    uint64_t m_numFrames{0};
+};
+
+} // anonymous namespace
+
+std::unique_ptr<StreamDecoder> openMiniAudioStream(const std::string& filePath) {
+    auto decoder = std::make_unique<MiniAudioStreamDecoder>();
+    if (!decoder->open(filePath)) {
+        return nullptr;
+    }
+    return decoder;
+}
+
 } // namespace Audio
 } // namespace Nomad
 
@@ -77,10 +173,15 @@ namespace Audio {
 bool loadWithMiniAudio(const std::string&,
                        std::vector<float>&,
                        uint32_t&,
-                       uint32_t&) {
+                       uint32_t&,
+                       const std::function<bool(float)>&) {
     return false;
 }
 
+std::unique_ptr<StreamDecoder> openMiniAudioStream(const std::string&) {
+    return nullptr;
+}
+
 } // namespace Audio
 } // namespace Nomad
 
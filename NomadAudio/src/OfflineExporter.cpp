@@ -0,0 +1,427 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "OfflineExporter.h"
+#include "AudioEngine.h"
+#include "NomadLog.h"
+#include "OfflineRenderHarness.h"
+#include "PathUtils.h"
+#include "StreamingSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+constexpr uint32_t kMinBlockFrames = 64;
+constexpr uint32_t kMaxBlockFrames = 16384;
+constexpr uint32_t kMaxCorrectionPasses = 4;       // Re-measures when the safety stage is on
+constexpr float kNormalizeToleranceDb = 0.1f;
+
+/// One rendered block: the mix followed by every stem, each interleaved stereo.
+struct ExportBlock {
+    std::vector<float> data;
+    std::vector<float*> stemTaps;   // Into data, one per stem
+    uint32_t frames{0};
+};
+
+/// Every stream the graph's clips read from, once each.
+std::vector<StreamingSource*> streamsIn(const AudioGraph& graph) {
+    std::set<StreamingSource*> streams;
+    for (const auto& track : graph.tracks) {
+        for (const auto& clip : track.clips) {
+            if (clip.stream) {
+                streams.insert(clip.stream);
+            }
+        }
+    }
+    return std::vector<StreamingSource*>(streams.begin(), streams.end());
+}
+
+/// Load each stream's read-ahead before a block. Rendering runs far faster than
+/// real time, so the I/O threads alone would leave the render reading silence.
+void fillStreams(const std::vector<StreamingSource*>& streams) {
+    for (StreamingSource* stream : streams) {
+        StreamIOPool::getInstance().serviceNow(*stream);
+    }
+}
+
+/// Configure an export engine, publish the graph and pre-roll so rendering can start at start.
+void startEngine(AudioEngine& engine, OfflineRenderHarness& harness, const AudioGraph& graph,
+                 const std::vector<StreamingSource*>& streams, const ExportSettings& settings,
+                 float masterGain, uint64_t start) {
+    engine.setSampleRate(settings.sampleRate);
+    engine.setResamplingQuality(settings.resampling);
+    engine.setStretchQuality(settings.stretching);
+    engine.setMasterGain(masterGain);
+    engine.setHeadroom(settings.headroomDb);
+    engine.setSafetyProcessingEnabled(settings.safetyProcessing);
+    const uint32_t cores = std::max(1u, std::thread::hardware_concurrency());
+    engine.setRenderThreadCount(settings.renderThreads ? settings.renderThreads : cores - 1);
+    engine.setParallelRenderMinTracks(2);   // Blocks are long: dispatch is always worth it
+
+    // The export range decides where rendering stops, not the transport's timeline wrap.
+    AudioGraph renderGraph = graph;
+    renderGraph.timelineEndSample = 0;
+    engine.setGraph(std::move(renderGraph));
+    engine.waitForDecodedStreams();
+    engine.setTransportPlaying(true);
+
+    // Pre-roll one block so fader/pan and master gain smoothing start at their
+    // targets instead of ramping in from unity over the first exported block.
+    // A ring stream only reads forward: load start again after the pre-roll.
+    auto locate = [&] {
+        engine.setGlobalSamplePos(start);
+        engine.cueStreams(start);
+        fillStreams(streams);
+    };
+    locate();
+    harness.processBlocks(1);
+    locate();
+}
+
+} // anonymous namespace
+
+void ExportSettings::applyQualitySettings(const AudioQualitySettings& quality) {
+    dithering = quality.dithering;
+    switch (quality.resampling) {
+        case ResamplingMode::Fast:    resampling = SRCQuality::Linear; break;
+        case ResamplingMode::Medium:  resampling = SRCQuality::Cubic; break;
+        case ResamplingMode::High:    resampling = SRCQuality::Sinc8; break;
+        case ResamplingMode::Ultra:   resampling = SRCQuality::Sinc16; break;
+        case ResamplingMode::Extreme:
+        case ResamplingMode::Perfect:
+        default:                      resampling = SRCQuality::Sinc64; break;
+    }
+    safetyProcessing = quality.enableSoftClipping;
+}
+
+std::string OfflineExporter::sanitizeFileName(const std::string& name) {
+    std::string out;
+    out.reserve(name.size());
+    for (char c : name) {
+        const bool reserved = static_cast<unsigned char>(c) < 0x20 ||
+                              std::string("<>:\"/\\|?*").find(c) != std::string::npos;
+        out += reserved ? '_' : c;
+    }
+    while (!out.empty() && (out.back() == ' ' || out.back() == '.')) {
+        out.pop_back();
+    }
+    return out.empty() ? "Untitled" : out;
+}
+
+ExportResult OfflineExporter::run(const AudioGraph& graph, const ExportSettings& settings,
+                                  const ProgressFn& progress) {
+    ExportResult result;
+    auto failWith = [&](const std::string& message) {
+        result.error = message;
+        Log::warning("OfflineExporter: " + message);
+        return result;
+    };
+
+    const uint64_t start = settings.startSample;
+    const uint64_t end = settings.endSample ? settings.endSample : graph.timelineEndSample;
+    if (!settings.exportMix && !settings.exportStems) {
+        return failWith("nothing to export (mix and stems both disabled)");
+    }
+    if (settings.exportMix && settings.outputPath.empty()) {
+        return failWith("no output path for the mix");
+    }
+    if (settings.exportStems && settings.stemDirectory.empty()) {
+        return failWith("no directory for stems");
+    }
+    if (!AudioFileWriter::supports(settings.format, settings.sampleFormat)) {
+        return failWith("FLAC export needs 16- or 24-bit samples");
+    }
+    if (settings.sampleRate == 0 || end <= start) {
+        return failWith("empty render range");
+    }
+
+    const uint32_t blockFrames = std::clamp(settings.blockFrames, kMinBlockFrames, kMaxBlockFrames);
+    const std::vector<StreamingSource*> streams = streamsIn(graph);
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Progress runs 0..1 over every pass: with normalisation, measuring is the first half.
+    const bool normalize = settings.normalizeLoudness && settings.exportMix;
+    // The safety stage (DC blocker + soft clip) runs after master gain and is not
+    // linear, so gain changes can't be predicted from one measurement: re-measure.
+    const uint32_t measuringPasses = normalize ? (settings.safetyProcessing ? 1 + kMaxCorrectionPasses : 1) : 0;
+    double progressBase = 0.0;
+    double progressScale = normalize ? 0.5 / measuringPasses : 1.0;
+    auto reportProgress = [&](uint64_t position) {
+        const double done = static_cast<double>(position - start) / static_cast<double>(end - start);
+        return !progress || progress(progressBase + progressScale * done);
+    };
+
+    // === Loudness normalisation: measuring passes ===
+    float masterGain = settings.masterGain;
+    if (normalize) {
+        // Render the mix at a master gain and measure it; false if cancelled.
+        auto measure = [&](float gain, LoudnessReadings& readings) {
+            AudioEngine engine;
+            OfflineRenderHarness harness(engine, blockFrames, 2);
+            startEngine(engine, harness, graph, streams, settings, gain, start);
+            auto meter = std::make_unique<LoudnessMeter>();
+            meter->prepare(static_cast<double>(settings.sampleRate));
+            std::vector<float> block(static_cast<size_t>(blockFrames) * 2);
+            for (uint64_t position = start; position < end;) {
+                const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(blockFrames, end - position));
+                fillStreams(streams);
+                harness.renderBlock(block.data(), frames);
+                meter->process(block.data(), frames);
+                position += frames;
+                if (!reportProgress(position)) {
+                    return false;
+                }
+            }
+            readings = meter->readings();
+            progressBase += progressScale;
+            return true;
+        };
+        // dB under the true-peak ceiling (infinite for silence).
+        auto peakRoomDb = [&](const LoudnessReadings& readings) {
+            const float peakDb = LoudnessMeter::toDecibels(std::max(readings.truePeakL, readings.truePeakR));
+            return std::isfinite(peakDb) ? settings.truePeakCeilingDb - peakDb : std::numeric_limits<float>::infinity();
+        };
+        // dB to move the mix by: up to the target loudness, but never over the true-peak ceiling.
+        auto correctionDb = [&](const LoudnessReadings& readings) {
+            return std::min(settings.targetLufs - readings.integratedLufs, peakRoomDb(readings));
+        };
+        auto cancel = [&] {
+            result.cancelled = true;
+            Log::info("OfflineExporter: export cancelled");
+            return result;
+        };
+
+        LoudnessReadings measured;
+        if (!measure(masterGain, measured)) {
+            return cancel();
+        }
+        // Silence has no integrated loudness and is left alone. Without the safety
+        // stage master gain scales the mix linearly, so the measured loudness and
+        // true peak move by exactly gainDb.
+        if (std::isfinite(measured.integratedLufs)) {
+            float gainDb = correctionDb(measured);
+            // With it, measure each gain after applying it and correct what it missed,
+            // until a pass lands within tolerance and under the ceiling.
+            for (uint32_t pass = 1; pass < measuringPasses; ++pass) {
+                LoudnessReadings applied;
+                if (!measure(settings.masterGain * std::pow(10.0f, gainDb / 20.0f), applied)) {
+                    return cancel();
+                }
+                const float error = correctionDb(applied);
+                if (peakRoomDb(applied) >= 0.0f && std::abs(error) <= kNormalizeToleranceDb) {
+                    break;
+                }
+                gainDb += error;
+            }
+            result.normalizationGainDb = gainDb;
+            masterGain *= std::pow(10.0f, gainDb / 20.0f);
+        }
+        progressBase = 0.5;
+        progressScale = 0.5;
+    }
+
+    // === Output files ===
+    const uint32_t stemCount = settings.exportStems ? static_cast<uint32_t>(graph.tracks.size()) : 0;
+    std::vector<std::unique_ptr<AudioFileWriter>> writers;   // Mix (if any), then stems
+    auto openWriter = [&](const std::string& path) {
+        auto writer = AudioFileWriter::create(settings.format);
+        if (!writer->open(path, settings.sampleRate, 2, settings.sampleFormat, settings.dithering)) {
+            result.error = writer->lastError();
+            return false;
+        }
+        writers.push_back(std::move(writer));
+        result.files.push_back(path);
+        return true;
+    };
+    auto discardFiles = [&] {
+        writers.clear();
+        for (const auto& path : result.files) {
+            std::error_code ec;
+            fs::remove(makeUnicodePath(path), ec);
+        }
+        result.files.clear();
+    };
+
+    bool opened = !settings.exportMix || openWriter(settings.outputPath);
+    if (opened && stemCount > 0) {
+        std::error_code ec;
+        fs::create_directories(makeUnicodePath(settings.stemDirectory), ec);
+        std::set<std::string> used;
+        for (uint32_t i = 0; i < stemCount && opened; ++i) {
+            std::string name = i < settings.stemNames.size() && !settings.stemNames[i].empty()
+                                   ? settings.stemNames[i]
+                                   : "Track " + std::to_string(graph.tracks[i].trackId);
+            name = sanitizeFileName(name);
+            if (!used.insert(name).second) {
+                name += "_" + std::to_string(i + 1);
+                used.insert(name);
+            }
+            const fs::path path = makeUnicodePath(settings.stemDirectory) /
+                                  makeUnicodePath(name + AudioFileWriter::extension(settings.format));
+            opened = openWriter(pathToUtf8(path));
+        }
+    }
+    if (!opened) {
+        const std::string error = result.error;
+        discardFiles();
+        return failWith(error);
+    }
+
+    // === Engine ===
+    AudioEngine engine;
+    OfflineRenderHarness harness(engine, blockFrames, 2);
+    startEngine(engine, harness, graph, streams, settings, masterGain, start);
+
+    // Loudness of the written mix, measured on the writer thread.
+    auto mixLoudness = std::make_unique<LoudnessMeter>();
+    mixLoudness->prepare(static_cast<double>(settings.sampleRate));
+
+    // === Bounded render -> writer queue ===
+    const uint32_t queueBlocks = std::max(2u, settings.queueBlocks);
+    const size_t outputSamples = static_cast<size_t>(blockFrames) * 2;
+    std::vector<ExportBlock> ring(queueBlocks);
+    for (auto& block : ring) {
+        block.data.resize(outputSamples * (1 + stemCount));
+        for (uint32_t s = 0; s < stemCount; ++s) {
+            block.stemTaps.push_back(block.data.data() + outputSamples * (1 + s));
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint64_t produced = 0;
+    uint64_t consumed = 0;
+    bool finished = false;
+    bool writeFailed = false;
+
+    std::thread writerThread([&] {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return consumed < produced || finished; });
+                if (consumed == produced) {
+                    return;   // Finished and drained
+                }
+            }
+            const ExportBlock& block = ring[consumed % queueBlocks];
+            bool ok = true;
+            size_t w = 0;
+            if (settings.exportMix) {
+                mixLoudness->process(block.data.data(), block.frames);
+                ok = writers[w++]->write(block.data.data(), block.frames);
+            }
+            for (uint32_t s = 0; s < stemCount && ok; ++s) {
+                ok = writers[w++]->write(block.stemTaps[s], block.frames);
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++consumed;
+                writeFailed = !ok;
+            }
+            cv.notify_all();
+            if (!ok) {
+                return;
+            }
+        }
+    });
+
+    uint64_t position = start;
+    while (position < end) {
+        const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(blockFrames, end - position));
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (produced - consumed == queueBlocks) {
+                ++result.writerStalls;
+            }
+            cv.wait(lock, [&] { return produced - consumed < queueBlocks || writeFailed; });
+            if (writeFailed) {
+                break;
+            }
+        }
+        ExportBlock& block = ring[produced % queueBlocks];
+        engine.setStemCapture(stemCount ? block.stemTaps.data() : nullptr, stemCount);
+        fillStreams(streams);
+        harness.renderBlock(block.data.data(), frames);
+        block.frames = frames;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++produced;
+        }
+        cv.notify_all();
+
+        position += frames;
+        if (!reportProgress(position)) {
+            result.cancelled = true;
+            break;
+        }
+    }
+    engine.setStemCapture(nullptr, 0);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    cv.notify_all();
+    writerThread.join();
+
+    bool ok = !writeFailed;
+    for (auto& writer : writers) {
+        if (!writer->close()) {
+            ok = false;
+            if (result.error.empty()) {
+                result.error = writer->lastError();
+            }
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    result.framesRendered = position - start;
+    result.audioSeconds = static_cast<double>(result.framesRendered) / settings.sampleRate;
+    result.renderSeconds = std::chrono::duration<double>(t1 - t0).count();
+    result.realtimeFactor = result.renderSeconds > 0.0 ? result.audioSeconds / result.renderSeconds : 0.0;
+
+    if (result.cancelled || !ok) {
+        discardFiles();
+        if (result.cancelled) {
+            Log::info("OfflineExporter: export cancelled");
+            return result;
+        }
+        return failWith(result.error.empty() ? "write failed" : result.error);
+    }
+
+    result.success = true;
+    if (settings.exportMix) {
+        result.loudness = mixLoudness->readings();
+    }
+    std::ostringstream summary;
+    summary.precision(1);
+    summary << std::fixed << "OfflineExporter: rendered " << result.audioSeconds << " s to "
+            << result.files.size() << " file(s) in " << result.renderSeconds << " s ("
+            << result.realtimeFactor << "x realtime, " << result.writerStalls << " writer stalls)";
+    if (settings.exportMix && std::isfinite(result.loudness.integratedLufs)) {
+        summary << ", mix " << result.loudness.integratedLufs << " LUFS, "
+                << LoudnessMeter::toDecibels(std::max(result.loudness.truePeakL, result.loudness.truePeakR))
+                << " dBTP";
+        if (normalize) {
+            summary << " (normalised by " << result.normalizationGainDb << " dB)";
+        }
+    }
+    Log::info(summary.str());
+    return result;
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -499,10 +499,12 @@ std::unique_ptr<PlaylistRuntimeSnapshot> PlaylistModel::buildRuntimeSnapshot(
             clipInfo.startTime = clip.startTime;
             clipInfo.length = clip.length;
             clipInfo.sourceStart = clip.sourceStart;
+            clipInfo.loopLength = clip.loopLength;
             clipInfo.gainLinear = clip.gainLinear;
             clipInfo.pan = clip.pan;
             clipInfo.muted = clip.muted;
             clipInfo.playbackRate = clip.playbackRate;
+            clipInfo.pitchSemitones = clip.pitchSemitones;
             clipInfo.fadeInLength = clip.fadeInLength;
             clipInfo.fadeOutLength = clip.fadeOutLength;
             clipInfo.flags = clip.flags;
@@ -353,7 +353,7 @@ void PreviewEngine::process(float* interleavedOutput, uint32_t numFrames) {
         return;
     }
     auto buffer = voice->buffer;
-    if (!buffer || buffer->data.empty() || buffer->sampleRate == 0) {
+    if (!buffer || buffer->numFrames == 0 || buffer->isStreaming || buffer->sampleRate == 0) {
         return;
     }
 
@@ -376,10 +376,20 @@ void PreviewEngine::process(float* interleavedOutput, uint32_t numFrames) {
         uint64_t idx1 = std::min<uint64_t>(idx + 1, totalFrames - 1);
         float frac = static_cast<float>(phase - idx);
 
-        float l0 = data[idx * 2];
-        float l1 = data[idx1 * 2];
-        float r0 = data[idx * 2 + 1];
-        float r1 = data[idx1 * 2 + 1];
+        float l0, l1, r0, r1;
+        if (buffer->isPacked()) {
+            float frame0[2];
+            float frame1[2];
+            SamplePool::readFrames(*buffer, idx, 1, frame0);
+            SamplePool::readFrames(*buffer, idx1, 1, frame1);
+            l0 = frame0[0]; r0 = frame0[1];
+            l1 = frame1[0]; r1 = frame1[1];
+        } else {
+            l0 = data[idx * 2];
+            l1 = data[idx1 * 2];
+            r0 = data[idx * 2 + 1];
+            r1 = data[idx1 * 2 + 1];
+        }
 
         float outL = l0 + frac * (l1 - l0);
         float outR = r0 + frac * (r1 - r0);
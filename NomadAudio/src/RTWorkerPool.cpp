@@ -0,0 +1,209 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "RTWorkerPool.h"
+#include "AudioRT.h"
+#include "NomadLog.h"
+#include "NomadPlatform.h"
+
+#include <algorithm>
+
+namespace Nomad {
+namespace Audio {
+
+RTWorkerPool::~RTWorkerPool() {
+    stop();
+}
+
+void RTWorkerPool::start(uint32_t numWorkers) {
+    stop();
+
+    numWorkers = std::min(numWorkers, kMaxWorkers);
+    if (numWorkers == 0) {
+        return;
+    }
+
+    m_stop.store(false, std::memory_order_release);
+    m_threads.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        const uint32_t participant = i + 1; // Slot 0 belongs to the calling (audio) thread
+        m_threads.emplace_back([this, participant] { workerLoop(participant); });
+    }
+    m_numWorkers = numWorkers;
+
+    Log::info("RTWorkerPool started with " + std::to_string(numWorkers) + " workers");
+}
+
+void RTWorkerPool::stop() {
+    if (m_threads.empty()) {
+        return;
+    }
+
+    m_stop.store(true, std::memory_order_release);
+    // Bump the generation so spinning workers notice, then wake any sleepers.
+    m_generation.fetch_add(1, std::memory_order_seq_cst);
+    Platform::wakeAllOnAddress(m_generation);
+
+    for (auto& t : m_threads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    m_threads.clear();
+    m_numWorkers = 0;
+
+    Log::info("RTWorkerPool stopped");
+}
+
+void RTWorkerPool::resetStats() noexcept {
+    for (auto& s : m_stats) {
+        s.tasksExecuted.store(0, std::memory_order_relaxed);
+        s.tasksStolen.store(0, std::memory_order_relaxed);
+        s.busyCycles.store(0, std::memory_order_relaxed);
+        s.wakeups.store(0, std::memory_order_relaxed);
+    }
+    m_dispatchCount.store(0, std::memory_order_relaxed);
+    m_dispatchCycles.store(0, std::memory_order_relaxed);
+}
+
+void RTWorkerPool::run(TaskFn fn, void* context, uint32_t taskCount) noexcept {
+    if (!fn || taskCount == 0) {
+        return;
+    }
+
+    // Inline path: no helpers, nothing to split, or too many tasks to pack.
+    if (m_numWorkers == 0 || taskCount < 2 || taskCount > kMaxTasksPerRun) {
+        const uint64_t t0 = RT::readCycleCounter();
+        for (uint32_t i = 0; i < taskCount; ++i) {
+            fn(context, i);
+        }
+        const uint64_t t1 = RT::readCycleCounter();
+        m_stats[0].tasksExecuted.fetch_add(taskCount, std::memory_order_relaxed);
+        m_stats[0].busyCycles.fetch_add(t1 - t0, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint64_t t0 = RT::readCycleCounter();
+
+    uint32_t generation = m_generation.load(std::memory_order_relaxed) + 1;
+    if (generation == 0) {
+        generation = 1; // 0 is never a live dispatch
+    }
+
+    m_fn = fn;
+    m_context = context;
+
+    const uint32_t participants = std::min(m_numWorkers + 1, taskCount);
+    m_numRanges.store(participants, std::memory_order_relaxed);
+    m_pending.store(taskCount, std::memory_order_relaxed);
+
+    for (uint32_t p = 0; p < participants; ++p) {
+        const uint32_t begin = static_cast<uint32_t>((static_cast<uint64_t>(taskCount) * p) / participants);
+        const uint32_t end = static_cast<uint32_t>((static_cast<uint64_t>(taskCount) * (p + 1)) / participants);
+        m_ranges[p].state.store(packRange(generation, begin, end), std::memory_order_release);
+    }
+
+    // Publish, then wake parked workers (Dekker pairing with m_sleepers in workerLoop).
+    m_generation.store(generation, std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_seq_cst) > 0) {
+        Platform::wakeAllOnAddress(m_generation);
+    }
+
+    participate(0, generation);
+
+    // Join: the caller has drained everything it could claim; wait for in-flight tasks.
+    while (m_pending.load(std::memory_order_acquire) != 0) {
+        RT::cpuRelax();
+    }
+
+    const uint64_t t1 = RT::readCycleCounter();
+    m_dispatchCount.fetch_add(1, std::memory_order_relaxed);
+    m_dispatchCycles.fetch_add(t1 - t0, std::memory_order_relaxed);
+}
+
+bool RTWorkerPool::claim(uint32_t rangeIndex, uint32_t generation, uint32_t& outTask) noexcept {
+    auto& range = m_ranges[rangeIndex].state;
+    uint64_t s = range.load(std::memory_order_acquire);
+    while (true) {
+        if (static_cast<uint32_t>(s >> 32) != generation) {
+            return false; // Range belongs to another dispatch
+        }
+        const uint32_t next = static_cast<uint32_t>((s >> 16) & 0xFFFF);
+        const uint32_t end = static_cast<uint32_t>(s & 0xFFFF);
+        if (next >= end) {
+            return false;
+        }
+        if (range.compare_exchange_weak(s, packRange(generation, next + 1, end),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+            outTask = next;
+            return true;
+        }
+    }
+}
+
+void RTWorkerPool::participate(uint32_t participant, uint32_t generation) noexcept {
+    const uint64_t t0 = RT::readCycleCounter();
+    const uint32_t ranges = m_numRanges.load(std::memory_order_relaxed);
+    uint32_t executed = 0;
+    uint32_t stolen = 0;
+    uint32_t task = 0;
+
+    // Own range first (contiguous, cache-friendly), then steal round-robin.
+    for (uint32_t k = 0; k < ranges; ++k) {
+        const uint32_t victim = (participant + k) % ranges;
+        while (claim(victim, generation, task)) {
+            m_fn(m_context, task);
+            m_pending.fetch_sub(1, std::memory_order_release);
+            ++executed;
+            if (victim != participant) {
+                ++stolen;
+            }
+        }
+    }
+
+    if (executed > 0) {
+        auto& stats = m_stats[participant];
+        stats.tasksExecuted.fetch_add(executed, std::memory_order_relaxed);
+        stats.tasksStolen.fetch_add(stolen, std::memory_order_relaxed);
+        stats.busyCycles.fetch_add(RT::readCycleCounter() - t0, std::memory_order_relaxed);
+    }
+}
+
+void RTWorkerPool::workerLoop(uint32_t participant) {
+    // Match the callback thread's FP environment so parallel renders are bit-identical.
+    RT::initAudioThread();
+    Platform::setCurrentThreadPriority(Platform::ThreadPriority::RealtimeAudio);
+
+    uint32_t seen = m_generation.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t generation = m_generation.load(std::memory_order_acquire);
+        for (uint32_t spin = 0; generation == seen && spin < kSpinIterations; ++spin) {
+            RT::cpuRelax();
+            generation = m_generation.load(std::memory_order_acquire);
+        }
+
+        if (generation == seen) {
+            if (m_stop.load(std::memory_order_acquire)) {
+                return;   // Stopped before this worker first read the generation
+            }
+            // Park. Re-check after registering so run() either sees us or we see it.
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_generation.load(std::memory_order_seq_cst) == seen &&
+                !m_stop.load(std::memory_order_acquire)) {
+                Platform::waitOnAddress(m_generation, seen);
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            m_stats[participant].wakeups.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_stop.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        seen = generation;
+        participate(participant, generation);
+    }
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -0,0 +1,55 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "RenderArena.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace Nomad {
+namespace Audio {
+
+RenderArena::RenderArena(uint32_t slotCount, uint32_t frameCapacity)
+    : m_slotCount(slotCount)
+    , m_frameCapacity(frameCapacity) {
+    constexpr size_t kDoublesPerLine = kAlignment / sizeof(double);
+    const size_t samples = static_cast<size_t>(frameCapacity) * 2;
+    m_stride = (samples + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine;
+
+    const size_t total = m_stride * m_slotCount;
+    if (total > 0) {
+        m_data = static_cast<double*>(::operator new(total * sizeof(double), std::align_val_t(kAlignment)));
+        std::memset(m_data, 0, total * sizeof(double));
+    }
+}
+
+RenderArena::~RenderArena() {
+    release();
+}
+
+RenderArena::RenderArena(RenderArena&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_stride(std::exchange(other.m_stride, 0))
+    , m_slotCount(std::exchange(other.m_slotCount, 0))
+    , m_frameCapacity(std::exchange(other.m_frameCapacity, 0)) {
+}
+
+RenderArena& RenderArena::operator=(RenderArena&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_stride = std::exchange(other.m_stride, 0);
+        m_slotCount = std::exchange(other.m_slotCount, 0);
+        m_frameCapacity = std::exchange(other.m_frameCapacity, 0);
+    }
+    return *this;
+}
+
+void RenderArena::release() noexcept {
+    if (m_data) {
+        ::operator delete(m_data, std::align_val_t(kAlignment));
+        m_data = nullptr;
+    }
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -1,10 +1,15 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 #include "SamplePool.h"
+#include "AudioKernels.h"
+#include "ClipResampler.h"
+#include "MiniAudioDecoder.h"
 #include "NomadLog.h"
 #include "PathUtils.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -12,11 +17,102 @@ namespace fs = std::filesystem;
 namespace Nomad {
 namespace Audio {
 
+namespace {
+constexpr uint32_t kMaxDecodeThreads = 8;
+
+/// Loader for the decoded copy of a stream: every frame, stereo at the source's rate.
+bool decodeStream(const StreamingSource& source, AudioBuffer& out) {
+    if (!source.decodeAll(out.data)) {
+        return false;
+    }
+    out.channels = 2;
+    out.sampleRate = source.sampleRate();
+    return true;
+}
+}
+
+/**
+ * @brief A load in flight, shared by every request for its key.
+ */
+struct SampleLoad {
+    SampleKey key;
+    std::string path;
+    SamplePool::AsyncLoader loader;
+    SampleLoadContext context;
+    std::promise<std::shared_ptr<AudioBuffer>> promise;
+    std::shared_future<std::shared_ptr<AudioBuffer>> result;
+    uint64_t batch{0};
+
+    // Guarded by the pool mutex
+    bool started{false};
+    uint32_t liveRequests{0};     // Requests not cancelled (synchronous joins included)
+
+    struct Requester {
+        uint64_t id;
+        SamplePool::LoadCallback onComplete;
+        bool cancelled;
+    };
+    std::mutex callbackMutex;     // Guards requesters/finished; held while callbacks run
+    std::vector<Requester> requesters;
+    bool finished{false};
+};
+
+// =============================================================================
+// SampleLoadHandle
+// =============================================================================
+
+bool SampleLoadHandle::isReady() const {
+    return m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+float SampleLoadHandle::progress() const noexcept {
+    if (isReady()) {
+        return 1.0f;
+    }
+    return m_load ? m_load->context.progress() : 0.0f;
+}
+
+std::shared_ptr<AudioBuffer> SampleLoadHandle::get() const {
+    return m_future.valid() ? m_future.get() : nullptr;
+}
+
+void SampleLoadHandle::cancel() {
+    if (m_cancelled) {
+        return;
+    }
+    m_cancelled = true;
+    if (m_load) {
+        SamplePool::getInstance().cancelRequest(*m_load, m_requester);
+    }
+}
+
+// =============================================================================
+// SamplePool
+// =============================================================================
+
 SamplePool& SamplePool::getInstance() {
     static SamplePool instance;
     return instance;
 }
 
+SamplePool::~SamplePool() {
+    std::vector<std::thread> decodeThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_resampleStop = true;
+        m_decodeStop = true;
+        decodeThreads.swap(m_decodeThreads);
+    }
+    m_resampleCv.notify_all();
+    m_decodeCv.notify_all();
+    if (m_resampleThread.joinable()) {
+        m_resampleThread.join();
+    }
+    for (auto& thread : decodeThreads) {
+        thread.join();
+    }
+}
+
 // static: No instance state needed
 SampleKey SamplePool::makeKey(const std::string& path) {
     SampleKey key;
@@ -36,17 +132,7 @@ SampleKey SamplePool::makeKey(const std::string& path) {
 }
 
 size_t SamplePool::calculateBufferBytes(const AudioBuffer& buffer) {
-    return buffer.data.size() * sizeof(float);
-}
-
-void SamplePool::updateMemoryUsageLocked() {
-    size_t total = 0;
-    for (const auto& [_, weakBuf] : m_samples) {
-        if (auto buf = weakBuf.lock()) {
-            total += calculateBufferBytes(*buf);
-        }
-    }
-    m_memoryCurrent.store(total);
+    return buffer.data.size() * sizeof(float) + buffer.packed.size();
 }
 
 std::shared_ptr<AudioBuffer> SamplePool::acquire(
@@ -55,59 +141,318 @@ std::shared_ptr<AudioBuffer> SamplePool::acquire(
     
     SampleKey key = makeKey(path);
 
-    // Fast path: try to find an existing buffer
+    std::shared_ptr<SampleLoad> load;
+    bool runHere = false;
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        if (auto it = m_samples.find(key); it != m_samples.end()) {
-            if (auto existing = it->second.lock()) {
-                existing->lastAccessTick.store(++m_accessCounter);
-                return existing; // Cache hit
+        if (auto existing = lookupSampleLocked(key)) {
+            ++m_hits;
+            return existing; // Cache hit
+        }
+        ++m_misses;
+
+        if (auto it = m_loading.find(key); it != m_loading.end()) {
+            // Someone is already loading it: share that load. If it is still
+            // queued, run it here rather than wait for a decode thread.
+            load = it->second;
+            ++load->liveRequests;
+            ++m_loadsJoined;
+            runHere = !load->started;
+            load->started = true;
+        } else {
+            if (!loader) {
+                Log::warning("SamplePool: no loader provided for missing sample: " + path);
+                return nullptr;
             }
-            // Expired entry: clean it up
-            m_samples.erase(it);
+            load = registerLoadLocked(key, path,
+                                      [loader](AudioBuffer& buffer, SampleLoadContext&) { return loader(buffer); });
+            load->liveRequests = 1;
+            load->started = true;
+            runHere = true;
         }
     }
 
-    // Miss: load the sample outside the lock
-    if (!loader) {
-        Log::warning("SamplePool: no loader provided for missing sample: " + path);
-        return nullptr;
+    if (runHere) {
+        runLoad(load);
     }
+    return load->result.get();
+}
 
-    auto buffer = std::make_shared<AudioBuffer>();
-    buffer->sourcePath = path;
-    
-    // Exception-safe loading
-    try {
-        if (!loader(*buffer)) {
-            Log::warning("SamplePool: loader failed for " + path);
-            return nullptr;
+SampleLoadHandle SamplePool::acquireAsync(const std::string& path, AsyncLoader loader, LoadCallback onComplete) {
+    SampleKey key = makeKey(path);
+
+    SampleLoadHandle handle;
+    std::shared_ptr<AudioBuffer> immediate;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        immediate = lookupSampleLocked(key);
+        ++(immediate ? m_hits : m_misses);
+        if (!immediate) {
+            if (auto it = m_loading.find(key); it != m_loading.end()) {
+                handle.m_load = it->second;
+                ++handle.m_load->liveRequests;
+                ++m_loadsJoined;
+            } else if (loader) {
+                handle.m_load = registerLoadLocked(key, path, std::move(loader));
+                handle.m_load->liveRequests = 1;
+                m_decodeQueue.push_back(handle.m_load);
+                startDecodeThreadsLocked();
+                m_decodeCv.notify_all();
+            } else {
+                Log::warning("SamplePool: no loader provided for missing sample: " + path);
+            }
+        }
+        if (handle.m_load) {
+            handle.m_requester = m_nextRequester++;
+        }
+    }
+
+    if (!handle.m_load) {
+        // Cache hit or nothing to do: complete now.
+        std::promise<std::shared_ptr<AudioBuffer>> done;
+        done.set_value(immediate);
+        handle.m_future = done.get_future().share();
+        if (onComplete) {
+            onComplete(immediate);
+        }
+        return handle;
+    }
+
+    handle.m_future = handle.m_load->result;
+    bool finished = false;
+    {
+        std::lock_guard<std::mutex> callbacks(handle.m_load->callbackMutex);
+        finished = handle.m_load->finished;
+        if (!finished) {
+            handle.m_load->requesters.push_back({handle.m_requester, std::move(onComplete), false});
         }
-    } catch (const std::exception& e) {
-        Log::warning(std::string("SamplePool: loader exception for ") + path + ": " + e.what());
-        return nullptr;
     }
+    if (finished && onComplete) {
+        onComplete(handle.m_future.get());   // Finished between registering and here
+    }
+    return handle;
+}
 
-    buffer->numFrames = (buffer->channels > 0) ? buffer->data.size() / buffer->channels : 0;
-    buffer->ready.store(true);
-    buffer->lastAccessTick.store(++m_accessCounter);
+std::shared_ptr<SampleLoad> SamplePool::registerLoadLocked(const SampleKey& key, const std::string& path,
+                                                          AsyncLoader loader) {
+    if (m_loading.empty()) {
+        // Nothing in flight: this starts a new batch for progress reporting.
+        ++m_batchId;
+        m_batchTotal = 0;
+        m_batchDone = 0;
+    }
+    auto load = std::make_shared<SampleLoad>();
+    load->key = key;
+    load->path = path;
+    load->loader = std::move(loader);
+    load->result = load->promise.get_future().share();
+    load->batch = m_batchId;
+    ++m_batchTotal;
+    m_loading[key] = load;
+    return load;
+}
+
+void SamplePool::runLoad(const std::shared_ptr<SampleLoad>& load) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_activeLoads;
+    }
+
+    std::shared_ptr<AudioBuffer> buffer;
+    if (!load->context.cancelled()) {
+        auto candidate = std::make_shared<AudioBuffer>();
+        candidate->sourcePath = load->path;
+        bool ok = false;
+        // Exception-safe loading
+        try {
+            ok = load->loader(*candidate, load->context);
+        } catch (const std::exception& e) {
+            Log::warning(std::string("SamplePool: loader exception for ") + load->path + ": " + e.what());
+        }
+        if (!ok && !load->context.cancelled()) {
+            Log::warning("SamplePool: loader failed for " + load->path);
+        }
+        if (ok && !load->context.cancelled()) {
+            candidate->numFrames = (candidate->channels > 0) ? candidate->data.size() / candidate->channels : 0;
+            SampleStorage storage = m_storage.load();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (auto it = m_storageByFile.find(load->key.filePath); it != m_storageByFile.end()) {
+                    storage = it->second;
+                }
+            }
+            pack(*candidate, storage);
+            candidate->ready.store(true);
+            buffer = std::move(candidate);
+        }
+    }
+    load->loader = nullptr;   // Drop the loader's captures now
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_activeLoads;
+        if (buffer) {
+            // A load cancelled and restarted for the same key may have beaten us.
+            if (auto existing = lookupSampleLocked(load->key)) {
+                buffer = std::move(existing);
+            } else {
+                CacheEntry& entry = m_samples[load->key];
+                entry.key.source = load->key;
+                entry.key.targetRate = 0;
+                holdLocked(entry, buffer);
+                enforceBudgetLocked();
+            }
+            ++m_loadsCompleted;
+        } else if (load->context.cancelled()) {
+            ++m_loadsCancelled;
+        } else {
+            ++m_loadsFailed;
+        }
+        if (auto it = m_loading.find(load->key); it != m_loading.end() && it->second == load) {
+            m_loading.erase(it);
+        }
+        if (load->batch == m_batchId) {
+            ++m_batchDone;
+        }
+    }
+
+    load->context.setProgress(1.0f);
+    load->promise.set_value(buffer);
+    {
+        std::lock_guard<std::mutex> callbacks(load->callbackMutex);
+        load->finished = true;
+        for (auto& requester : load->requesters) {
+            if (!requester.cancelled && requester.onComplete) {
+                requester.onComplete(buffer);
+            }
+            requester.onComplete = nullptr;
+        }
+    }
+    m_decodeCv.notify_all();
+}
+
+void SamplePool::cancelRequest(SampleLoad& load, uint64_t requester) {
+    {
+        // Waits for a callback that is running right now.
+        std::lock_guard<std::mutex> callbacks(load.callbackMutex);
+        for (auto& entry : load.requesters) {
+            if (entry.id == requester) {
+                entry.cancelled = true;
+                entry.onComplete = nullptr;
+            }
+        }
+    }
 
-    // Insert into cache (re-check to prevent race)
     std::lock_guard<std::mutex> lock(m_mutex);
-    
-    // Race check: another thread may have loaded this while we were unlocked
-    if (auto it = m_samples.find(key); it != m_samples.end()) {
-        if (auto existing = it->second.lock()) {
-            return existing; // Another thread won: use their buffer
+    if (load.liveRequests > 0 && --load.liveRequests == 0) {
+        // Nobody wants it any more: stop the decode, and let a later request start afresh.
+        load.context.m_cancelled.store(true, std::memory_order_release);
+        if (auto it = m_loading.find(load.key); it != m_loading.end() && it->second.get() == &load) {
+            m_loading.erase(it);
         }
-        m_samples.erase(it); // Expired: remove stale entry
     }
-    
-    m_samples.emplace(key, buffer);
-    updateMemoryUsageLocked();
-    garbageCollectLocked(); // Already locked: use private variant
+}
 
-    return buffer;
+void SamplePool::startDecodeThreadsLocked() {
+    if (!m_decodeThreads.empty()) {
+        return;
+    }
+    uint32_t threads = m_decodeThreadCount;
+    if (threads == 0) {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        threads = std::min(kMaxDecodeThreads, hardware > 1 ? hardware - 1 : 1u);
+    }
+    for (uint32_t i = 0; i < threads; ++i) {
+        m_decodeThreads.emplace_back([this] { decodeWorkerLoop(); });
+    }
+}
+
+void SamplePool::setDecodeThreadCount(uint32_t threads) {
+    std::vector<std::thread> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodeThreadCount = threads;
+        m_decodeStop = true;
+        previous.swap(m_decodeThreads);
+    }
+    m_decodeCv.notify_all();
+    for (auto& thread : previous) {
+        thread.join();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_decodeStop = false;
+    if (!m_decodeQueue.empty()) {
+        startDecodeThreadsLocked();
+    }
+}
+
+uint32_t SamplePool::getDecodeThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_decodeThreads.empty()) {
+        return static_cast<uint32_t>(m_decodeThreads.size());
+    }
+    if (m_decodeThreadCount > 0) {
+        return m_decodeThreadCount;
+    }
+    const uint32_t hardware = std::thread::hardware_concurrency();
+    return std::min(kMaxDecodeThreads, hardware > 1 ? hardware - 1 : 1u);
+}
+
+void SamplePool::decodeWorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_decodeCv.wait(lock, [this] { return m_decodeStop || !m_decodeQueue.empty(); });
+        if (m_decodeStop) {
+            return;
+        }
+        std::shared_ptr<SampleLoad> load = std::move(m_decodeQueue.front());
+        m_decodeQueue.pop_front();
+        if (load->started) {
+            continue;   // A synchronous acquire() ran it
+        }
+        load->started = true;
+
+        lock.unlock();
+        runLoad(load);
+        load.reset();
+        lock.lock();
+    }
+}
+
+SampleLoadProgress SamplePool::getLoadProgress() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SampleLoadProgress progress;
+    for (const auto& load : m_decodeQueue) {
+        if (!load->started) {
+            ++progress.queued;
+        }
+    }
+    progress.active = m_activeLoads;
+    progress.batchTotal = m_batchTotal;
+    progress.batchDone = m_batchDone;
+    progress.completed = m_loadsCompleted;
+    progress.failed = m_loadsFailed;
+    progress.cancelled = m_loadsCancelled;
+    progress.joined = m_loadsJoined;
+    if (m_batchTotal > 0) {
+        float done = static_cast<float>(m_batchDone);
+        for (const auto& [_, load] : m_loading) {
+            if (load->batch == m_batchId) {
+                done += load->context.progress();
+            }
+        }
+        progress.fraction = std::min(1.0f, done / static_cast<float>(m_batchTotal));
+    }
+    return progress;
+}
+
+void SamplePool::waitForLoads() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_decodeCv.wait(lock, [this] {
+        return m_loading.empty() && m_activeLoads == 0 &&
+               std::none_of(m_decodeQueue.begin(), m_decodeQueue.end(),
+                            [](const std::shared_ptr<SampleLoad>& load) { return !load->started; });
+    });
 }
 
 void SamplePool::garbageCollect() {
@@ -115,55 +460,458 @@ void SamplePool::garbageCollect() {
     garbageCollectLocked();
 }
 
+void SamplePool::purge() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_lru.empty()) {
+        evictLocked(*m_lru.back());
+    }
+    garbageCollectLocked();
+}
+
 void SamplePool::garbageCollectLocked() {
-    // Remove expired entries first
+    // Evicted samples whose last user has gone
     for (auto it = m_samples.begin(); it != m_samples.end(); ) {
-        if (it->second.expired()) {
-            it = m_samples.erase(it);
-        } else {
-            ++it;
+        CacheEntry& entry = it->second;
+        ++it;
+        if (!entry.buffer && entry.weak.expired()) {
+            eraseLocked(entry);
         }
     }
+    enforceBudgetLocked();
+}
 
-    if (m_memoryBudget == 0) {
-        return; // Unlimited budget, skip calculation entirely
+std::shared_ptr<AudioBuffer> SamplePool::lookupSampleLocked(const SampleKey& key) {
+    auto it = m_samples.find(key);
+    if (it == m_samples.end()) {
+        return nullptr;
+    }
+    CacheEntry& entry = it->second;
+    if (entry.buffer) {
+        touchLocked(entry);
+        return entry.buffer;
+    }
+    if (auto alive = entry.weak.lock()) {
+        // Evicted, but clips still use it: hold it again instead of decoding a duplicate.
+        holdLocked(entry, alive);
+        enforceBudgetLocked();
+        return alive;
     }
+    eraseLocked(entry);
+    return nullptr;
+}
 
-    // Build live list AND calculate total size in one pass
-    struct EntryInfo {
-        SampleKey key;
-        uint64_t lastTick;
-        size_t sizeBytes;
-    };
-    std::vector<EntryInfo> live;
-    live.reserve(m_samples.size());
-    
-    size_t totalBytes = 0;
-    for (auto& [key, weakBuf] : m_samples) {
-        if (auto buf = weakBuf.lock()) {
-            size_t sz = calculateBufferBytes(*buf);
-            live.push_back({key, buf->lastAccessTick.load(), sz});
-            totalBytes += sz;
+void SamplePool::holdLocked(CacheEntry& entry, std::shared_ptr<AudioBuffer> buffer) {
+    entry.buffer = std::move(buffer);
+    entry.weak = entry.buffer;
+    entry.address = entry.buffer.get();
+    entry.bytes = calculateBufferBytes(*entry.buffer);
+    m_entryByBuffer[entry.address] = &entry;
+
+    m_memoryCurrent.fetch_add(entry.bytes);
+    if (entry.key.targetRate != 0) {
+        m_resampledBytes.fetch_add(entry.bytes);
+    }
+    ++m_heldEntries;
+    if (entry.pins > 0) {
+        m_pinnedBytes += entry.bytes;
+        ++m_pinnedEntries;
+    } else {
+        m_lru.push_front(&entry);
+        entry.lru = m_lru.begin();
+    }
+    entry.buffer->lastAccessTick.store(++m_accessCounter);
+}
+
+void SamplePool::touchLocked(CacheEntry& entry) {
+    if (entry.pins == 0) {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+    }
+    entry.buffer->lastAccessTick.store(++m_accessCounter);
+}
+
+void SamplePool::evictLocked(CacheEntry& entry) {
+    m_lru.erase(entry.lru);
+    m_memoryCurrent.fetch_sub(entry.bytes);
+    if (entry.key.targetRate != 0) {
+        m_resampledBytes.fetch_sub(entry.bytes);
+    }
+    --m_heldEntries;
+    ++m_evictions;
+    m_evictedBytes += entry.bytes;
+
+    // Holders keep the buffer itself alive. A copy is simply forgotten (it is
+    // re-rendered on demand); a sample stays findable while anything uses it.
+    entry.buffer.reset();
+    if (entry.key.targetRate != 0 || entry.weak.expired()) {
+        eraseLocked(entry);
+    }
+}
+
+void SamplePool::eraseLocked(CacheEntry& entry) {
+    if (auto it = m_entryByBuffer.find(entry.address); it != m_entryByBuffer.end() && it->second == &entry) {
+        m_entryByBuffer.erase(it);
+    }
+    const ResampledKey key = entry.key;   // entry dies below
+    if (key.targetRate == 0) {
+        m_samples.erase(key.source);
+    } else {
+        m_resampled.erase(key);
+    }
+}
+
+void SamplePool::enforceBudgetLocked() {
+    while (m_memoryBudget > 0 && m_memoryCurrent.load() > m_memoryBudget && !m_lru.empty()) {
+        evictLocked(*m_lru.back());
+    }
+}
+
+std::vector<const AudioBuffer*> SamplePool::pin(const std::vector<const AudioBuffer*>& buffers) {
+    std::vector<const AudioBuffer*> pinned;
+    pinned.reserve(buffers.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const AudioBuffer* address : buffers) {
+        auto it = m_entryByBuffer.find(address);
+        if (it == m_entryByBuffer.end()) {
+            continue;   // Not the pool's
+        }
+        CacheEntry& entry = *it->second;
+        if (!entry.buffer) {
+            auto alive = entry.weak.lock();
+            if (!alive) {
+                continue;
+            }
+            holdLocked(entry, std::move(alive));
+        }
+        if (entry.pins++ == 0) {
+            m_lru.erase(entry.lru);
+            m_pinnedBytes += entry.bytes;
+            ++m_pinnedEntries;
+        }
+        pinned.push_back(address);
+    }
+    enforceBudgetLocked();
+    return pinned;
+}
+
+void SamplePool::unpin(const std::vector<const AudioBuffer*>& buffers) {
+    if (buffers.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const AudioBuffer* address : buffers) {
+        auto it = m_entryByBuffer.find(address);
+        if (it == m_entryByBuffer.end()) {
+            continue;
+        }
+        CacheEntry& entry = *it->second;
+        if (entry.pins > 0 && --entry.pins == 0) {
+            m_pinnedBytes -= entry.bytes;
+            --m_pinnedEntries;
+            m_lru.push_front(&entry);
+            entry.lru = m_lru.begin();
         }
     }
+    enforceBudgetLocked();
+}
 
-    m_memoryCurrent.store(totalBytes);
+SamplePoolStats SamplePool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SamplePoolStats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.copyHits = m_copyHits;
+    stats.copyMisses = m_copyMisses;
+    stats.evictions = m_evictions;
+    stats.evictedBytes = m_evictedBytes;
+    stats.bytes = m_memoryCurrent.load();
+    stats.pinnedBytes = m_pinnedBytes;
+    stats.resampledBytes = m_resampledBytes.load();
+    stats.budget = m_memoryBudget;
+    stats.entries = m_heldEntries;
+    stats.pinnedEntries = m_pinnedEntries;
+    return stats;
+}
+
+// =============================================================================
+// SamplePinSet
+// =============================================================================
+
+SamplePinSet& SamplePinSet::operator=(SamplePinSet&& other) noexcept {
+    if (this != &other) {
+        clear();
+        m_pinned = std::move(other.m_pinned);
+        other.m_pinned.clear();
+    }
+    return *this;
+}
 
-    if (m_memoryCurrent.load() <= m_memoryBudget) {
+void SamplePinSet::assign(std::vector<const AudioBuffer*> buffers) {
+    std::sort(buffers.begin(), buffers.end());
+    buffers.erase(std::unique(buffers.begin(), buffers.end()), buffers.end());
+    buffers.erase(std::remove(buffers.begin(), buffers.end(), nullptr), buffers.end());
+    if (buffers == m_pinned) {
         return;
     }
+    SamplePool& pool = SamplePool::getInstance();
+    std::vector<const AudioBuffer*> pinned = pool.pin(buffers);
+    pool.unpin(m_pinned);
+    m_pinned = std::move(pinned);
+}
+
+void SamplePinSet::clear() {
+    if (!m_pinned.empty()) {
+        SamplePool::getInstance().unpin(m_pinned);
+        m_pinned.clear();
+    }
+}
+
+// =============================================================================
+// Sample storage
+// =============================================================================
+
+void SamplePool::setSampleStorage(SampleStorage storage) {
+    m_storage.store(storage);
+}
+
+SampleStorage SamplePool::getSampleStorage() const {
+    return m_storage.load();
+}
+
+void SamplePool::setSampleStorage(const std::string& path, SampleStorage storage) {
+    const SampleKey key = makeKey(path);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_storageByFile[key.filePath] = storage;
+}
+
+bool SamplePool::pack(AudioBuffer& buffer, SampleStorage storage) {
+    if (buffer.isStreaming || buffer.isPacked() || buffer.data.empty()) {
+        return false;
+    }
+    if (storage == SampleStorage::Native) {
+        const uint32_t bits = buffer.sourceBitDepth;
+        storage = (bits > 0 && bits <= 16) ? SampleStorage::Int16
+                : (bits > 16 && bits <= 24) ? SampleStorage::Int24 : SampleStorage::Float32;
+    }
+    if (storage != SampleStorage::Int16 && storage != SampleStorage::Int24) {
+        return false;
+    }
+
+    // Inverse of the kernels' unpack (x / 2^(bits-1)): exact for samples decoded from that depth.
+    const bool int16 = storage == SampleStorage::Int16;
+    const uint32_t bytes = int16 ? 2 : 3;
+    const float scale = int16 ? 32768.0f : 8388608.0f;
+    const long maxValue = int16 ? 32767 : 8388607;
+    std::vector<uint8_t> packed(buffer.data.size() * bytes);
+    uint8_t* out = packed.data();
+    for (float x : buffer.data) {
+        const long v = std::clamp(std::lround(static_cast<double>(x) * scale), -maxValue - 1, maxValue);
+        const uint32_t u = static_cast<uint32_t>(v);
+        out[0] = static_cast<uint8_t>(u);
+        out[1] = static_cast<uint8_t>(u >> 8);
+        if (!int16) {
+            out[2] = static_cast<uint8_t>(u >> 16);
+        }
+        out += bytes;
+    }
+    buffer.packed = std::move(packed);
+    std::vector<float>().swap(buffer.data);
+    buffer.storage = storage;
+    return true;
+}
+
+void SamplePool::readFrames(const AudioBuffer& buffer, uint64_t start, uint32_t frames, float* dst) noexcept {
+    const uint32_t channels = buffer.channels;
+    const uint64_t available = start < buffer.numFrames ? std::min<uint64_t>(frames, buffer.numFrames - start) : 0;
+    const size_t samples = static_cast<size_t>(available) * channels;
+    const size_t first = static_cast<size_t>(start) * channels;
+    if (buffer.isPacked()) {
+        const uint32_t bytes = buffer.packedSampleBytes();
+        AudioKernels::active().unpack(dst, buffer.packed.data() + first * bytes, bytes, samples);
+    } else if (samples > 0) {
+        std::memcpy(dst, buffer.data.data() + first, samples * sizeof(float));
+    }
+    std::fill(dst + samples, dst + static_cast<size_t>(frames) * channels, 0.0f);
+}
+
+std::vector<float> SamplePool::toFloat(const AudioBuffer& buffer) {
+    if (!buffer.isPacked()) {
+        return buffer.data;
+    }
+    std::vector<float> out(static_cast<size_t>(buffer.numFrames) * buffer.channels);
+    AudioKernels::active().unpack(out.data(), buffer.packed.data(), buffer.packedSampleBytes(), out.size());
+    return out;
+}
+
+// =============================================================================
+// Streaming buffers
+// =============================================================================
+
+std::shared_ptr<AudioBuffer> SamplePool::acquireStreaming(const std::string& path) {
+    std::shared_ptr<StreamingSource> source = MappedPcmSource::open(path);
+    if (!source) {
+        if (auto decoder = openMiniAudioStream(path)) {
+            auto ring = std::make_shared<RingStreamSource>(std::move(decoder), path);
+            StreamIOPool::getInstance().add(ring);
+            source = std::move(ring);
+        }
+    }
+    if (!source || source->numFrames() == 0) {
+        return nullptr;
+    }
+
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = source->sampleRate();
+    buffer->numFrames = source->numFrames();
+    buffer->isStreaming = true;
+    buffer->sourcePath = path;
+    buffer->stream = std::move(source);
+    buffer->ready.store(true, std::memory_order_release);
+    return buffer;
+}
 
-    // Sort and evict (using pre-calculated sizes)
-    std::sort(live.begin(), live.end(), [](const EntryInfo& a, const EntryInfo& b) {
-        return a.lastTick < b.lastTick;
+std::shared_ptr<AudioBuffer> SamplePool::acquireDecoded(const StreamingSource& source) {
+    auto buffer = acquire(source.path(), [&source](AudioBuffer& out) {
+        return decodeStream(source, out);
     });
+    // A buffer another loader cached for this path may not be in engine format.
+    if (!buffer || buffer->channels != 2 || buffer->sampleRate != source.sampleRate()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+SampleLoadHandle SamplePool::acquireDecodedAsync(const std::shared_ptr<StreamingSource>& source,
+                                                 LoadCallback onComplete) {
+    // The loader owns the source, so the clip may drop it while the decode runs.
+    return acquireAsync(source->path(), [source](AudioBuffer& out, SampleLoadContext&) {
+        return decodeStream(*source, out);
+    }, std::move(onComplete));
+}
+
+// =============================================================================
+// Pre-resampled clip cache
+// =============================================================================
+
+uint64_t SamplePool::resampledFrameCount(uint64_t frames, uint32_t sourceRate, uint32_t targetRate) {
+    // Round up so the copy covers the original's last frame.
+    return (frames * targetRate + sourceRate - 1) / sourceRate;
+}
+
+std::shared_ptr<const AudioBuffer> SamplePool::acquireResampled(
+    const std::shared_ptr<const AudioBuffer>& source, uint32_t targetRate) {
+
+    if (!m_resampleEnabled.load() || !source || targetRate == 0 || source->sampleRate == 0 ||
+        source->sampleRate == targetRate || source->channels != 2 || source->sourcePath.empty() ||
+        source->isStreaming ||
+        !source->ready.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    ResampledKey key;
+    key.source = makeKey(source->sourcePath);
+    key.targetRate = targetRate;
+    key.quality = m_resampleQuality.load();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_resampled.find(key); it != m_resampled.end()) {
+        ++m_copyHits;
+        touchLocked(it->second);
+        return it->second.buffer;
+    }
+    ++m_copyMisses;
+    if (m_resamplePending.count(key) > 0) {
+        return nullptr;
+    }
+
+    const size_t sampleBytes = source->isPacked() ? source->packedSampleBytes() : sizeof(float);
+    const size_t bytes = static_cast<size_t>(
+        resampledFrameCount(source->numFrames, source->sampleRate, targetRate)) * 2 * sampleBytes;
+    if (m_memoryBudget > 0 && bytes > m_memoryBudget) {
+        return nullptr;   // Would evict itself; keep resampling in real time instead
+    }
 
-    for (const auto& info : live) {
-        if (m_memoryCurrent.load() <= m_memoryBudget) break;
-        if (m_samples.erase(info.key) > 0) {
-            m_memoryCurrent.fetch_sub(info.sizeBytes);
+    m_resamplePending.insert(key);
+    m_resampleQueue.push_back({key, source});
+    if (!m_resampleThread.joinable()) {
+        m_resampleThread = std::thread([this] { resampleWorkerLoop(); });
+    }
+    m_resampleCv.notify_all();
+    return nullptr;
+}
+
+void SamplePool::waitForResampleJobs() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_resampleCv.wait(lock, [this] { return m_resamplePending.empty(); });
+}
+
+void SamplePool::resampleWorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_resampleCv.wait(lock, [this] { return m_resampleStop || !m_resampleQueue.empty(); });
+        if (m_resampleStop) {
+            return;
+        }
+        ResampleJob job = std::move(m_resampleQueue.front());
+        m_resampleQueue.pop_front();
+
+        lock.unlock();
+        std::shared_ptr<AudioBuffer> copy;
+        try {
+            copy = renderResampled(*job.source, job.key.targetRate, job.key.quality);
+        } catch (const std::exception& e) {
+            Log::warning(std::string("SamplePool: resampling failed for ") + job.source->sourcePath + ": " + e.what());
+        }
+        job.source.reset();
+        lock.lock();
+
+        m_resamplePending.erase(job.key);
+        if (copy) {
+            CacheEntry& entry = m_resampled[job.key];
+            entry.key = job.key;
+            holdLocked(entry, copy);
+            enforceBudgetLocked();
+            m_resampledReady.store(true);
+            Log::info("SamplePool: resampled " + copy->sourcePath + " to " +
+                      std::to_string(job.key.targetRate) + " Hz (" +
+                      std::to_string(calculateBufferBytes(*copy) / 1024) + " KB)");
+        }
+        m_resampleCv.notify_all();
+    }
+}
+
+std::shared_ptr<AudioBuffer> SamplePool::renderResampled(const AudioBuffer& source, uint32_t targetRate,
+                                                         SRCQuality quality) {
+    ClipResampler resampler;
+    resampler.configure(static_cast<double>(source.sampleRate), static_cast<double>(targetRate), quality);
+
+    auto copy = std::make_shared<AudioBuffer>();
+    copy->channels = 2;
+    copy->sampleRate = targetRate;
+    copy->sourcePath = source.sourcePath;
+    copy->numFrames = resampledFrameCount(source.numFrames, source.sampleRate, targetRate);
+    copy->data.resize(static_cast<size_t>(copy->numFrames) * 2);
+
+    // Render in slices through a double scratch block (the resampler's output format).
+    constexpr uint32_t kSliceFrames = 4096;
+    std::vector<double> slice(static_cast<size_t>(kSliceFrames) * 2);
+    const double step = resampler.step();
+    for (uint64_t done = 0; done < copy->numFrames; done += kSliceFrames) {
+        const uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(kSliceFrames, copy->numFrames - done));
+        if (source.isPacked()) {
+            resampler.process(source.packed.data(), source.packedSampleBytes(), source.numFrames,
+                              static_cast<double>(done) * step, step, slice.data(), n);
+        } else {
+            resampler.process(source.data.data(), source.numFrames, static_cast<double>(done) * step, step,
+                              slice.data(), n);
         }
+        AudioKernels::active().doubleToFloat(copy->data.data() + static_cast<size_t>(done) * 2,
+                                             slice.data(), static_cast<size_t>(n) * 2);
     }
+    // A copy of a packed sample is held the same way (requantised at the source's depth).
+    pack(*copy, source.storage);
+    copy->ready.store(true, std::memory_order_release);
+    return copy;
 }
 
 void SamplePool::setMemoryBudget(size_t bytes) {
@@ -0,0 +1,978 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "StreamingSource.h"
+#include "NomadLog.h"
+#include "NomadPlatform.h"
+#include "PathUtils.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+constexpr double kDefaultReadAheadSeconds = 2.0;
+constexpr double kDefaultRingSeconds = 4.0;
+constexpr uint64_t kMappedServiceFrames = 65536;   // Frames touched per service() call
+constexpr uint64_t kPageBytes = 4096;
+constexpr int64_t kRateWindowNs = 500000000;        // StreamIOStats::bytesPerSecond window
+
+int64_t nowNs() noexcept {
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint16_t readLE16(const uint8_t* p) noexcept { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+uint32_t readLE32(const uint8_t* p) noexcept {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+uint64_t readLE64(const uint8_t* p) noexcept {
+    return static_cast<uint64_t>(readLE32(p)) | (static_cast<uint64_t>(readLE32(p + 4)) << 32);
+}
+uint16_t readBE16(const uint8_t* p) noexcept { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+uint32_t readBE32(const uint8_t* p) noexcept {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+/// AIFF sample rates are 80-bit IEEE extended floats.
+double readExtended(const uint8_t* p) noexcept {
+    const int exponent = ((p[0] & 0x7F) << 8) | p[1];
+    uint64_t mantissa = 0;
+    for (int i = 0; i < 8; ++i) {
+        mantissa = (mantissa << 8) | p[2 + i];
+    }
+    if (exponent == 0 && mantissa == 0) {
+        return 0.0;
+    }
+    const double value = std::ldexp(static_cast<double>(mantissa), exponent - 16383 - 63);
+    return (p[0] & 0x80) ? -value : value;
+}
+
+bool tagIs(const uint8_t* p, const char* tag) noexcept { return std::memcmp(p, tag, 4) == 0; }
+
+/// Where the samples are and how they're encoded.
+struct PcmLayout {
+    uint64_t dataOffset{0};
+    uint64_t dataBytes{0};
+    uint32_t sampleRate{0};
+    uint32_t channels{0};
+    uint32_t bitsPerSample{0};
+    bool isFloat{false};
+    bool bigEndian{false};
+};
+
+bool parseWave(const uint8_t* file, uint64_t size, PcmLayout& out) {
+    const bool rf64 = tagIs(file, "RF64");
+    uint64_t ds64DataBytes = 0;
+    bool haveFormat = false;
+    uint64_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = file + pos;
+        const uint64_t chunkBytes = readLE32(chunk + 4);
+        const uint64_t body = pos + 8;
+        if (tagIs(chunk, "ds64") && body + 24 <= size) {
+            ds64DataBytes = readLE64(file + body + 8);
+        } else if (tagIs(chunk, "fmt ") && body + 16 <= size) {
+            const uint8_t* fmt = file + body;
+            uint16_t formatTag = readLE16(fmt);
+            out.channels = readLE16(fmt + 2);
+            out.sampleRate = readLE32(fmt + 4);
+            out.bitsPerSample = readLE16(fmt + 14);
+            if (formatTag == 0xFFFE && chunkBytes >= 40 && body + 40 <= size) {
+                formatTag = readLE16(fmt + 24);   // WAVE_FORMAT_EXTENSIBLE: first bytes of the subformat GUID
+            }
+            if (formatTag != 1 && formatTag != 3) {
+                return false;
+            }
+            out.isFloat = formatTag == 3;
+            haveFormat = true;
+        } else if (tagIs(chunk, "data")) {
+            out.dataOffset = body;
+            out.dataBytes = (rf64 && chunkBytes == 0xFFFFFFFFu) ? ds64DataBytes : chunkBytes;
+            return haveFormat;
+        }
+        pos = body + chunkBytes + (chunkBytes & 1);
+    }
+    return false;
+}
+
+bool parseAiff(const uint8_t* file, uint64_t size, PcmLayout& out) {
+    const bool aifc = tagIs(file + 8, "AIFC");
+    bool haveFormat = false;
+    bool haveData = false;
+    uint64_t pos = 12;
+    while (pos + 8 <= size) {
+        const uint8_t* chunk = file + pos;
+        const uint64_t chunkBytes = readBE32(chunk + 4);
+        const uint64_t body = pos + 8;
+        if (tagIs(chunk, "COMM") && body + 18 <= size) {
+            const uint8_t* comm = file + body;
+            out.channels = readBE16(comm);
+            out.bitsPerSample = readBE16(comm + 6);
+            out.sampleRate = static_cast<uint32_t>(readExtended(comm + 8) + 0.5);
+            out.bigEndian = true;
+            if (aifc && chunkBytes >= 22 && body + 22 <= size) {
+                const uint8_t* compression = comm + 18;
+                if (tagIs(compression, "sowt")) {
+                    out.bigEndian = false;
+                } else if (tagIs(compression, "fl32") || tagIs(compression, "FL32")) {
+                    out.isFloat = true;
+                    out.bitsPerSample = 32;
+                } else if (!tagIs(compression, "NONE") && !tagIs(compression, "in24") &&
+                           !tagIs(compression, "in32") && !tagIs(compression, "twos")) {
+                    return false;   // Compressed AIFC: decode instead
+                }
+            }
+            haveFormat = true;
+        } else if (tagIs(chunk, "SSND") && body + 8 <= size) {
+            const uint64_t offset = readBE32(file + body);
+            out.dataOffset = body + 8 + offset;
+            out.dataBytes = chunkBytes >= 8 + offset ? chunkBytes - 8 - offset : 0;
+            haveData = true;
+        }
+        pos = body + chunkBytes + (chunkBytes & 1);
+    }
+    return haveFormat && haveData;
+}
+
+inline int32_t load24(const uint8_t* p, bool bigEndian) noexcept {
+    const int32_t v = bigEndian ? (p[0] << 16) | (p[1] << 8) | p[2]
+                                : (p[2] << 16) | (p[1] << 8) | p[0];
+    return (v & 0x800000) ? (v | ~0xFFFFFF) : v;
+}
+
+inline uint32_t load32(const uint8_t* p, bool bigEndian) noexcept {
+    return bigEndian ? readBE32(p) : readLE32(p);
+}
+
+/// Positional read: no shared file offset, so any I/O thread may use the handle.
+/// Returns the bytes read (short at end of file or on error).
+#ifdef _WIN32
+uint64_t readAt(HANDLE file, uint64_t offset, uint8_t* dst, uint64_t bytes) noexcept {
+    uint64_t done = 0;
+    while (done < bytes) {
+        OVERLAPPED at{};
+        at.Offset = static_cast<DWORD>((offset + done) & 0xFFFFFFFFu);
+        at.OffsetHigh = static_cast<DWORD>((offset + done) >> 32);
+        const DWORD want = static_cast<DWORD>(std::min<uint64_t>(bytes - done, 1u << 30));
+        DWORD got = 0;
+        if (!ReadFile(file, dst + done, want, &got, &at) || got == 0) {
+            break;
+        }
+        done += got;
+    }
+    return done;
+}
+#else
+uint64_t readAt(int fd, uint64_t offset, uint8_t* dst, uint64_t bytes) noexcept {
+    uint64_t done = 0;
+    while (done < bytes) {
+        const ssize_t got = ::pread(fd, dst + done, static_cast<size_t>(bytes - done),
+                                    static_cast<off_t>(offset + done));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            break;
+        }
+        done += static_cast<uint64_t>(got);
+    }
+    return done;
+}
+#endif
+
+} // anonymous namespace
+
+// =============================================================================
+// StreamingSource
+// =============================================================================
+
+void StreamingSource::requestService() noexcept {
+    if (!m_serviceRequested.exchange(true, std::memory_order_acq_rel)) {
+        StreamIOPool::getInstance().notify();
+    }
+}
+
+void StreamingSource::countUnderrun() noexcept {
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+    m_dueNs.store(0, std::memory_order_relaxed);
+    StreamIOPool::getInstance().countDeadlineMiss();
+}
+
+void StreamingSource::setDue(double secondsUntilNeeded) noexcept {
+    const int64_t due = secondsUntilNeeded > 0.0 ? nowNs() + static_cast<int64_t>(secondsUntilNeeded * 1e9) : 0;
+    m_dueNs.store(due, std::memory_order_relaxed);
+}
+
+double StreamingSource::deadlineSeconds(int64_t nowNs) const noexcept {
+    const double buffered = bufferedSeconds();
+    if (buffered > 0.0) {
+        return buffered;
+    }
+    const int64_t due = m_dueNs.load(std::memory_order_relaxed);
+    return due > nowNs ? static_cast<double>(due - nowNs) * 1e-9 : 0.0;
+}
+
+bool StreamingSource::decodeAll(std::vector<float>& out) const {
+    out.assign(static_cast<size_t>(m_numFrames) * 2, 0.0f);
+    uint64_t done = 0;
+    return decodeSlices([&](const float* stereo, uint32_t frames) {
+        const uint64_t n = std::min<uint64_t>(frames, m_numFrames - done);
+        std::memcpy(out.data() + static_cast<size_t>(done) * 2, stereo, static_cast<size_t>(n) * 2 * sizeof(float));
+        done += n;
+        return true;
+    });
+}
+
+// =============================================================================
+// MappedPcmSource
+// =============================================================================
+
+std::shared_ptr<MappedPcmSource> MappedPcmSource::open(const std::string& path) {
+    std::shared_ptr<MappedPcmSource> source(new MappedPcmSource());
+    source->m_path = path;
+    if (!source->map()) {
+        return nullptr;
+    }
+
+    const uint8_t* file = static_cast<const uint8_t*>(source->m_mapping);
+    const uint64_t size = source->m_mappingBytes;
+    PcmLayout layout;
+    bool parsed = false;
+    if (size >= 12 && (tagIs(file, "RIFF") || tagIs(file, "RF64")) && tagIs(file + 8, "WAVE")) {
+        parsed = parseWave(file, size, layout);
+    } else if (size >= 12 && tagIs(file, "FORM") && (tagIs(file + 8, "AIFF") || tagIs(file + 8, "AIFC"))) {
+        parsed = parseAiff(file, size, layout);
+    }
+    if (!parsed || layout.channels < 1 || layout.channels > 2 || layout.sampleRate == 0 ||
+        layout.dataOffset >= size) {
+        return nullptr;
+    }
+
+    switch (layout.bitsPerSample) {
+        case 16: source->m_encoding = Encoding::Int16; break;
+        case 24: source->m_encoding = Encoding::Int24; break;
+        case 32: source->m_encoding = layout.isFloat ? Encoding::Float32 : Encoding::Int32; break;
+        default: return nullptr;
+    }
+    if (layout.isFloat && layout.bitsPerSample != 32) {
+        return nullptr;
+    }
+
+    source->m_bigEndian = layout.bigEndian;
+    source->m_sourceChannels = layout.channels;
+    source->m_sampleRate = layout.sampleRate;
+    source->m_bytesPerFrame = layout.channels * (layout.bitsPerSample / 8);
+    // Truncated files stream whatever is actually there.
+    const uint64_t dataBytes = std::min(layout.dataBytes, size - layout.dataOffset);
+    source->m_numFrames = dataBytes / source->m_bytesPerFrame;
+    source->m_data = file + layout.dataOffset;
+    if (source->m_numFrames == 0) {
+        return nullptr;
+    }
+    source->setReadAheadFrames(static_cast<uint64_t>(layout.sampleRate * kDefaultReadAheadSeconds));
+
+    StreamIOPool::getInstance().add(source);
+    return source;
+}
+
+MappedPcmSource::~MappedPcmSource() {
+    unmap();
+}
+
+bool MappedPcmSource::map() {
+    const auto fsPath = makeUnicodePath(m_path);
+#ifdef _WIN32
+    HANDLE file = CreateFileW(fsPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mapHandle = mapping;
+    m_mapping = view;
+    m_mappingBytes = static_cast<uint64_t>(size.QuadPart);
+#else
+    const int fd = ::open(fsPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;   // Kept for the I/O pool's positional reads
+    m_mapping = view;
+    m_mappingBytes = static_cast<uint64_t>(info.st_size);
+#endif
+    return true;
+}
+
+void MappedPcmSource::unmap() {
+    if (!m_mapping) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(static_cast<HANDLE>(m_mapHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_mapHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(m_mapping, static_cast<size_t>(m_mappingBytes));
+    ::close(m_fd);
+    m_fd = -1;
+#endif
+    m_mapping = nullptr;
+    m_data = nullptr;
+}
+
+void MappedPcmSource::convert(const uint8_t* src, uint32_t frames, float* dst) const noexcept {
+    const uint32_t channels = m_sourceChannels;
+    const size_t samples = static_cast<size_t>(frames) * channels;
+    // Decode into dst (channels per frame), then widen mono to stereo from the back.
+    switch (m_encoding) {
+        case Encoding::Int16:
+            for (size_t i = 0; i < samples; ++i) {
+                const uint8_t* p = src + i * 2;
+                const int16_t v = static_cast<int16_t>(m_bigEndian ? readBE16(p) : readLE16(p));
+                dst[i] = v / 32768.0f;
+            }
+            break;
+        case Encoding::Int24:
+            for (size_t i = 0; i < samples; ++i) {
+                dst[i] = load24(src + i * 3, m_bigEndian) / 8388608.0f;
+            }
+            break;
+        case Encoding::Int32: {
+            const float invScale = 1.0f / 2147483648.0f;
+            for (size_t i = 0; i < samples; ++i) {
+                dst[i] = static_cast<float>(static_cast<int32_t>(load32(src + i * 4, m_bigEndian))) * invScale;
+            }
+            break;
+        }
+        case Encoding::Float32:
+            for (size_t i = 0; i < samples; ++i) {
+                const uint32_t bits = load32(src + i * 4, m_bigEndian);
+                std::memcpy(&dst[i], &bits, sizeof(float));
+            }
+            break;
+    }
+    if (channels == 1) {
+        for (size_t i = frames; i-- > 0;) {
+            dst[i * 2] = dst[i];
+            dst[i * 2 + 1] = dst[i];
+        }
+    }
+}
+
+bool MappedPcmSource::read(uint64_t start, uint32_t frames, float* dst) noexcept {
+    const uint64_t end = start + frames;
+    const uint64_t validEnd = std::min(end, m_numFrames);
+    const uint32_t valid = validEnd > start ? static_cast<uint32_t>(validEnd - start) : 0;
+
+    m_playhead.store(start, std::memory_order_relaxed);
+    const uint64_t windowStart = m_windowStart.load(std::memory_order_acquire);
+    const uint64_t windowEnd = m_windowEnd.load(std::memory_order_acquire);
+    const bool resident = valid == 0 || (start >= windowStart && validEnd <= windowEnd);
+
+    // Outside the window the pages may not be resident (or, on a truncated file,
+    // not backed at all): never touch them here, play silence instead.
+    const uint32_t converted = resident ? valid : 0;
+    if (converted > 0) {
+        convert(m_data + start * m_bytesPerFrame, converted, dst);
+    }
+    if (converted < frames) {
+        std::memset(dst + static_cast<size_t>(converted) * 2, 0,
+                    static_cast<size_t>(frames - converted) * 2 * sizeof(float));
+    }
+
+    // Top the window up once half the read-ahead has been played through.
+    const uint64_t wanted = std::min(m_numFrames, start + readAheadFrames());
+    if (!resident || (windowEnd < wanted && windowEnd < start + readAheadFrames() / 2)) {
+        requestService();
+    }
+    if (!resident) {
+        countUnderrun();
+    }
+    return resident;
+}
+
+void MappedPcmSource::cue(uint64_t frame, double secondsUntilNeeded) noexcept {
+    const uint64_t windowStart = m_windowStart.load(std::memory_order_acquire);
+    const uint64_t windowEnd = m_windowEnd.load(std::memory_order_acquire);
+    const uint64_t wanted = std::min(m_numFrames, frame + readAheadFrames() / 2);
+    if (frame >= windowStart && wanted <= windowEnd) {
+        return;
+    }
+    setDue(secondsUntilNeeded);
+    m_playhead.store(frame, std::memory_order_relaxed);
+    requestService();
+}
+
+bool MappedPcmSource::needsService() const noexcept {
+    const uint64_t playhead = m_playhead.load(std::memory_order_relaxed);
+    const uint64_t windowStart = m_windowStart.load(std::memory_order_relaxed);
+    const uint64_t windowEnd = m_windowEnd.load(std::memory_order_relaxed);
+    return playhead < windowStart || playhead > windowEnd ||
+           windowEnd < std::min(m_numFrames, playhead + readAheadFrames());
+}
+
+double MappedPcmSource::bufferedSeconds() const noexcept {
+    const uint64_t playhead = m_playhead.load(std::memory_order_relaxed);
+    const uint64_t windowStart = m_windowStart.load(std::memory_order_relaxed);
+    const uint64_t windowEnd = m_windowEnd.load(std::memory_order_relaxed);
+    if (playhead < windowStart || playhead >= windowEnd) {
+        return 0.0;
+    }
+    return static_cast<double>(windowEnd - playhead) / static_cast<double>(m_sampleRate);
+}
+
+bool MappedPcmSource::service() {
+    const uint64_t readAhead = readAheadFrames();
+    const uint64_t playhead = std::min(m_playhead.load(std::memory_order_relaxed), m_numFrames);
+    uint64_t windowStart = m_windowStart.load(std::memory_order_relaxed);
+    uint64_t windowEnd = m_windowEnd.load(std::memory_order_relaxed);
+
+    if (playhead < windowStart || playhead > windowEnd) {
+        // Located away: restart the window at the playhead (shrink before moving the start).
+        m_windowEnd.store(playhead, std::memory_order_release);
+        m_windowStart.store(playhead, std::memory_order_release);
+        windowStart = windowEnd = playhead;
+    } else {
+        // Keep a little history behind the playhead for the resampler's lead-in.
+        const uint64_t history = readAhead / 4;
+        const uint64_t keepFrom = playhead > history ? playhead - history : 0;
+        if (keepFrom > windowStart) {
+            m_windowStart.store(keepFrom, std::memory_order_release);
+        }
+    }
+
+    const uint64_t target = std::min(m_numFrames, playhead + readAhead);
+    if (windowEnd >= target) {
+        return false;
+    }
+    const uint64_t frames = std::min(target - windowEnd, kMappedServiceFrames);
+
+    // One positional read pulls the chunk into the page cache as a single
+    // request (and reports I/O errors here instead of as a fault on the audio
+    // thread); touching the pages afterwards maps them without further I/O.
+    const uint64_t dataStart = static_cast<uint64_t>(m_data - static_cast<const uint8_t*>(m_mapping));
+    const uint64_t first = dataStart + windowEnd * m_bytesPerFrame;
+    const uint64_t last = std::min(m_mappingBytes, dataStart + (windowEnd + frames) * m_bytesPerFrame);
+    thread_local std::vector<uint8_t> scratch;
+    scratch.resize(static_cast<size_t>(kMappedServiceFrames) * 8);
+    uint64_t loaded = 0;
+    for (uint64_t offset = first; offset < last;) {
+        const uint64_t want = std::min<uint64_t>(last - offset, scratch.size());
+#ifdef _WIN32
+        const uint64_t got = readAt(static_cast<HANDLE>(m_fileHandle), offset, scratch.data(), want);
+#else
+        const uint64_t got = readAt(m_fd, offset, scratch.data(), want);
+#endif
+        loaded += got;
+        if (got < want) {
+            if (!m_readFailed) {
+                Log::warning("MappedPcmSource: read failed in " + m_path);
+                m_readFailed = true;
+            }
+            break;
+        }
+        offset += want;
+    }
+    countBytesLoaded(loaded);
+
+    const volatile uint8_t* bytes = static_cast<const uint8_t*>(m_mapping);
+    uint8_t sink = 0;
+    for (uint64_t offset = first; offset < last; offset += kPageBytes) {
+        sink ^= bytes[offset];
+    }
+    if (last > first) {
+        sink ^= bytes[last - 1];
+    }
+    (void)sink;
+
+    m_windowEnd.store(windowEnd + frames, std::memory_order_release);
+    return windowEnd + frames < target;
+}
+
+bool MappedPcmSource::decodeSlices(const SliceConsumer& consume) const {
+    // Positional reads, not the mapping: a truncated file reports an error here
+    // instead of faulting, and the playback window's pages are left alone.
+    const uint64_t dataStart = static_cast<uint64_t>(m_data - static_cast<const uint8_t*>(m_mapping));
+    std::vector<uint8_t> bytes(static_cast<size_t>(kMappedServiceFrames) * m_bytesPerFrame);
+    std::vector<float> stereo(static_cast<size_t>(kMappedServiceFrames) * 2);
+    for (uint64_t done = 0; done < m_numFrames;) {
+        const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(m_numFrames - done, kMappedServiceFrames));
+        const uint64_t want = static_cast<uint64_t>(frames) * m_bytesPerFrame;
+#ifdef _WIN32
+        const uint64_t got = readAt(static_cast<HANDLE>(m_fileHandle), dataStart + done * m_bytesPerFrame, bytes.data(), want);
+#else
+        const uint64_t got = readAt(m_fd, dataStart + done * m_bytesPerFrame, bytes.data(), want);
+#endif
+        if (got < want) {
+            Log::warning("MappedPcmSource: read failed in " + m_path);
+            return false;
+        }
+        convert(bytes.data(), frames, stereo.data());
+        if (!consume(stereo.data(), frames)) {
+            return false;
+        }
+        done += frames;
+    }
+    return true;
+}
+
+// =============================================================================
+// RingStreamSource
+// =============================================================================
+
+RingStreamSource::RingStreamSource(std::unique_ptr<StreamDecoder> decoder, const std::string& path,
+                                   uint64_t capacityFrames)
+    : m_decoder(std::move(decoder)) {
+    m_path = path;
+    m_sampleRate = m_decoder->sampleRate();
+    m_numFrames = m_decoder->numFrames();
+    m_sourceChannels = m_decoder->sourceChannels();
+
+    m_capacity = capacityFrames ? capacityFrames : static_cast<uint64_t>(m_sampleRate * kDefaultRingSeconds);
+    m_capacity = std::max<uint64_t>(m_capacity, kDecodeChunkFrames * 2);
+    m_ring.assign(static_cast<size_t>(m_capacity) * 2, 0.0f);
+    m_scratch.resize(static_cast<size_t>(kDecodeChunkFrames) * 2);
+    // Leave one chunk of slack so the producer can always decode behind the consumer.
+    setReadAheadFrames(m_capacity - kDecodeChunkFrames);
+}
+
+uint64_t RingStreamSource::wantedEnd(uint64_t consumed) const noexcept {
+    return std::min(m_numFrames, consumed + std::min(readAheadFrames(), m_capacity));
+}
+
+bool RingStreamSource::inRun(uint64_t start, uint64_t end) const noexcept {
+    return start >= m_runStart.load(std::memory_order_acquire) &&
+           end <= m_runEnd.load(std::memory_order_acquire);
+}
+
+bool RingStreamSource::read(uint64_t start, uint32_t frames, float* dst) noexcept {
+    const uint64_t validEnd = std::min(start + frames, m_numFrames);
+    const uint32_t valid = validEnd > start ? static_cast<uint32_t>(validEnd - start) : 0;
+    const size_t tailBytes = static_cast<size_t>(frames - valid) * 2 * sizeof(float);
+    if (valid < frames) {
+        std::memset(dst + static_cast<size_t>(valid) * 2, 0, tailBytes);
+    }
+    if (valid == 0) {
+        return true;
+    }
+
+    auto miss = [&]() noexcept {
+        std::memset(dst, 0, static_cast<size_t>(valid) * 2 * sizeof(float));
+        m_seekRequest.store(start, std::memory_order_release);
+        requestService();
+        countUnderrun();
+        return false;
+    };
+
+    // Seqlock read: the producer bumps the epoch around every reposition.
+    const uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+    if (epoch & 1u) {
+        return miss();
+    }
+    // Playback only moves forward between repositions; the producer may already
+    // have reused frames before the last read.
+    if (start < m_consumed.load(std::memory_order_seq_cst)) {
+        return miss();
+    }
+    m_consumed.store(start, std::memory_order_seq_cst);
+    if (!inRun(start, validEnd)) {
+        return miss();
+    }
+
+    const size_t first = static_cast<size_t>(start % m_capacity);
+    const size_t firstFrames = std::min<size_t>(valid, static_cast<size_t>(m_capacity) - first);
+    std::memcpy(dst, m_ring.data() + first * 2, firstFrames * 2 * sizeof(float));
+    if (firstFrames < valid) {
+        std::memcpy(dst + firstFrames * 2, m_ring.data(), (valid - firstFrames) * 2 * sizeof(float));
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_epoch.load(std::memory_order_relaxed) != epoch) {
+        return miss();
+    }
+
+    const uint64_t runEnd = m_runEnd.load(std::memory_order_relaxed);
+    if (runEnd < m_numFrames && runEnd < start + readAheadFrames() / 2) {
+        requestService();
+    }
+    return true;
+}
+
+void RingStreamSource::cue(uint64_t frame, double secondsUntilNeeded) noexcept {
+    const uint64_t consumed = m_consumed.load(std::memory_order_acquire);
+    if (frame >= consumed && frame >= m_runStart.load(std::memory_order_acquire) &&
+        frame <= m_runEnd.load(std::memory_order_acquire)) {
+        return;   // Already buffered (or being buffered) from there
+    }
+    setDue(secondsUntilNeeded);
+    m_seekRequest.store(frame, std::memory_order_release);
+    requestService();
+}
+
+bool RingStreamSource::needsService() const noexcept {
+    if (m_seekRequest.load(std::memory_order_acquire) != kNoSeek) {
+        return true;
+    }
+    return m_runEnd.load(std::memory_order_relaxed) < wantedEnd(m_consumed.load(std::memory_order_relaxed));
+}
+
+double RingStreamSource::bufferedSeconds() const noexcept {
+    if (m_seekRequest.load(std::memory_order_acquire) != kNoSeek) {
+        return 0.0;
+    }
+    const uint64_t consumed = m_consumed.load(std::memory_order_relaxed);
+    const uint64_t runEnd = m_runEnd.load(std::memory_order_relaxed);
+    return runEnd > consumed ? static_cast<double>(runEnd - consumed) / static_cast<double>(m_sampleRate) : 0.0;
+}
+
+bool RingStreamSource::service() {
+    const uint64_t seek = m_seekRequest.exchange(kNoSeek, std::memory_order_acq_rel);
+    if (seek != kNoSeek) {
+        const uint64_t runStart = m_runStart.load(std::memory_order_relaxed);
+        const uint64_t runEnd = m_runEnd.load(std::memory_order_relaxed);
+        const uint64_t consumed = m_consumed.load(std::memory_order_seq_cst);
+        const bool buffered = seek >= runStart && seek >= consumed && seek <= runEnd && runEnd > runStart;
+        if (!buffered) {
+            m_epoch.fetch_add(1, std::memory_order_acq_rel);   // Odd: readers miss
+            const uint64_t target = std::min(seek, m_numFrames);
+            m_runStart.store(target, std::memory_order_relaxed);
+            m_runEnd.store(target, std::memory_order_relaxed);
+            m_consumed.store(target, std::memory_order_seq_cst);
+            if (!m_decoder->seek(target)) {
+                Log::warning("RingStreamSource: seek failed in " + m_path);
+            }
+            m_epoch.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    const uint64_t runEnd = m_runEnd.load(std::memory_order_relaxed);
+    const uint64_t consumed = m_consumed.load(std::memory_order_seq_cst);
+    const uint64_t target = wantedEnd(consumed);
+    if (runEnd >= target) {
+        return false;
+    }
+    // target never exceeds consumed + capacity, so this never overwrites the
+    // frame the consumer last read from, or anything after it.
+    const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(target - runEnd, kDecodeChunkFrames));
+    const uint64_t newEnd = runEnd + frames;
+    if (newEnd > m_capacity) {
+        const uint64_t newStart = newEnd - m_capacity;
+        if (newStart > m_runStart.load(std::memory_order_relaxed)) {
+            m_runStart.store(newStart, std::memory_order_seq_cst);
+        }
+    }
+
+    const uint32_t got = m_decoder->read(m_scratch.data(), frames);
+    if (got < frames) {
+        // The decoder ran dry before its reported length: the rest plays as silence.
+        std::memset(m_scratch.data() + static_cast<size_t>(got) * 2, 0,
+                    static_cast<size_t>(frames - got) * 2 * sizeof(float));
+    }
+    countBytesLoaded(static_cast<uint64_t>(got) * 2 * sizeof(float));
+    const size_t first = static_cast<size_t>(runEnd % m_capacity);
+    const size_t firstFrames = std::min<size_t>(frames, static_cast<size_t>(m_capacity) - first);
+    std::memcpy(m_ring.data() + first * 2, m_scratch.data(), firstFrames * 2 * sizeof(float));
+    if (firstFrames < frames) {
+        std::memcpy(m_ring.data(), m_scratch.data() + firstFrames * 2, (frames - firstFrames) * 2 * sizeof(float));
+    }
+    m_runEnd.store(newEnd, std::memory_order_release);
+    return newEnd < target;
+}
+
+bool RingStreamSource::decodeSlices(const SliceConsumer& consume) const {
+    std::unique_ptr<StreamDecoder> decoder = m_decoder->reopen();
+    if (!decoder || !decoder->seek(0)) {
+        return false;
+    }
+    std::vector<float> stereo(static_cast<size_t>(kDecodeChunkFrames) * 2);
+    for (uint64_t done = 0; done < m_numFrames;) {
+        const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(m_numFrames - done, kDecodeChunkFrames));
+        const uint32_t got = decoder->read(stereo.data(), frames);
+        if (got == 0) {
+            break;   // Ran dry before its reported length: the rest stays silent
+        }
+        if (!consume(stereo.data(), got)) {
+            return false;
+        }
+        done += got;
+    }
+    return true;
+}
+
+// =============================================================================
+// StreamIOPool
+// =============================================================================
+
+StreamIOPool& StreamIOPool::getInstance() {
+    static StreamIOPool instance;
+    return instance;
+}
+
+StreamIOPool::~StreamIOPool() {
+    stop();
+}
+
+void StreamIOPool::add(const std::shared_ptr<StreamingSource>& source) {
+    if (!source) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(),
+                                       [](const std::weak_ptr<StreamingSource>& s) { return s.expired(); }),
+                        m_sources.end());
+        m_sources.push_back(source);
+        if (m_threads.empty()) {
+            start(m_defaultThreads);
+        }
+    }
+    // Fill the head of the file before anyone reads it.
+    source->requestService();
+}
+
+void StreamIOPool::notify() noexcept {
+    m_wake.fetch_add(1, std::memory_order_release);
+    Platform::wakeAllOnAddress(m_wake);
+}
+
+size_t StreamIOPool::sourceCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(std::count_if(m_sources.begin(), m_sources.end(),
+                                             [](const std::weak_ptr<StreamingSource>& s) { return !s.expired(); }));
+}
+
+void StreamIOPool::setThreadCount(uint32_t threads) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaultThreads = threads;
+    if (!m_threads.empty()) {
+        stop();
+        if (threads > 0) {
+            start(threads);
+        }
+    }
+}
+
+void StreamIOPool::start(uint32_t threads) {
+    m_stop.store(false, std::memory_order_release);
+    for (uint32_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back([this] { threadLoop(); });
+    }
+}
+
+void StreamIOPool::stop() {
+    m_stop.store(true, std::memory_order_release);
+    notify();
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+void StreamIOPool::threadLoop() {
+    while (!m_stop.load(std::memory_order_acquire)) {
+        const uint32_t generation = m_wake.load(std::memory_order_acquire);
+        if (servicePass()) {
+            continue;
+        }
+        if (m_stop.load(std::memory_order_acquire)) {
+            return;
+        }
+        Platform::waitOnAddress(m_wake, generation);
+    }
+}
+
+bool StreamIOPool::servicePass() {
+    struct Pending {
+        std::shared_ptr<StreamingSource> source;
+        double deadline;
+    };
+    std::vector<Pending> pending;
+    const int64_t now = nowNs();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return true;   // Being resized; try again
+        }
+        for (const auto& weak : m_sources) {
+            if (auto source = weak.lock()) {
+                if (source->m_serviceRequested.load(std::memory_order_acquire) || source->needsService()) {
+                    const double deadline = source->deadlineSeconds(now);
+                    pending.push_back({std::move(source), deadline});
+                }
+            }
+        }
+    }
+    const uint32_t depth = static_cast<uint32_t>(pending.size());
+    m_queueDepth.store(depth, std::memory_order_relaxed);
+    uint32_t peak = m_peakQueueDepth.load(std::memory_order_relaxed);
+    while (depth > peak && !m_peakQueueDepth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+    }
+    if (pending.empty()) {
+        return false;
+    }
+
+    // Earliest deadline first; one chunk each so nobody waits behind a long fill.
+    std::sort(pending.begin(), pending.end(),
+              [](const Pending& a, const Pending& b) { return a.deadline < b.deadline; });
+    m_tightestDeadline.store(pending.front().deadline, std::memory_order_relaxed);
+    bool serviced = false;
+    for (const auto& entry : pending) {
+        StreamingSource& source = *entry.source;
+        if (source.m_servicing.exchange(true, std::memory_order_acquire)) {
+            continue;   // Another I/O thread has it
+        }
+        source.m_serviceRequested.store(false, std::memory_order_release);
+        serviced |= serviceSource(source);
+        source.m_servicing.store(false, std::memory_order_release);
+    }
+    return serviced;
+}
+
+bool StreamIOPool::serviceSource(StreamingSource& source) {
+    const uint64_t before = source.bytesLoaded();
+    const bool more = source.service();
+    const uint64_t loaded = source.bytesLoaded() - before;
+    const uint64_t total = m_bytesLoaded.fetch_add(loaded, std::memory_order_relaxed) + loaded;
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+
+    // Fold the rate window every half second (whichever I/O thread gets there).
+    std::unique_lock<std::mutex> lock(m_rateMutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        const int64_t now = nowNs();
+        const int64_t start = m_rateStartNs.load(std::memory_order_relaxed);
+        if (start == 0) {
+            m_rateStartNs.store(now, std::memory_order_relaxed);
+            m_rateStartBytes.store(total - loaded, std::memory_order_relaxed);
+        } else if (now - start >= kRateWindowNs) {
+            const uint64_t bytes = total - m_rateStartBytes.load(std::memory_order_relaxed);
+            m_bytesPerSecond.store(static_cast<double>(bytes) * 1e9 / static_cast<double>(now - start),
+                                   std::memory_order_relaxed);
+            m_rateStartNs.store(now, std::memory_order_relaxed);
+            m_rateStartBytes.store(total, std::memory_order_relaxed);
+        }
+    }
+    return more;
+}
+
+StreamIOStats StreamIOPool::stats() const {
+    StreamIOStats out;
+    out.queueDepth = m_queueDepth.load(std::memory_order_relaxed);
+    out.peakQueueDepth = m_peakQueueDepth.load(std::memory_order_relaxed);
+    out.requests = m_requests.load(std::memory_order_relaxed);
+    out.bytesLoaded = m_bytesLoaded.load(std::memory_order_relaxed);
+    out.deadlineMisses = m_deadlineMisses.load(std::memory_order_relaxed);
+    out.tightestDeadline = m_tightestDeadline.load(std::memory_order_relaxed);
+    out.bytesPerSecond = m_bytesPerSecond.load(std::memory_order_relaxed);
+    // No fold yet, or idle since the last one: average over the open window
+    // (so the rate decays instead of holding its last busy value).
+    const int64_t start = m_rateStartNs.load(std::memory_order_relaxed);
+    const int64_t now = nowNs();
+    if (start != 0 && now > start && (out.bytesPerSecond == 0.0 || now - start >= 2 * kRateWindowNs)) {
+        const uint64_t bytes = out.bytesLoaded - m_rateStartBytes.load(std::memory_order_relaxed);
+        out.bytesPerSecond = static_cast<double>(bytes) * 1e9 / static_cast<double>(now - start);
+    }
+    return out;
+}
+
+void StreamIOPool::serviceAllNow() {
+    for (;;) {
+        std::vector<std::shared_ptr<StreamingSource>> live;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& weak : m_sources) {
+                if (auto source = weak.lock()) {
+                    live.push_back(std::move(source));
+                }
+            }
+        }
+        bool busy = false;
+        for (const auto& source : live) {
+            if (source->m_servicing.exchange(true, std::memory_order_acquire)) {
+                busy = true;
+                continue;
+            }
+            source->m_serviceRequested.store(false, std::memory_order_release);
+            while (serviceSource(*source)) {
+            }
+            busy |= source->needsService();
+            source->m_servicing.store(false, std::memory_order_release);
+        }
+        if (!busy) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void StreamIOPool::serviceNow(StreamingSource& source) {
+    for (;;) {
+        // An I/O thread may hold it mid-chunk; let that finish and carry on after it.
+        if (source.m_servicing.exchange(true, std::memory_order_acquire)) {
+            std::this_thread::yield();
+            continue;
+        }
+        source.m_serviceRequested.store(false, std::memory_order_release);
+        while (serviceSource(source)) {
+        }
+        const bool more = source.needsService();
+        source.m_servicing.store(false, std::memory_order_release);
+        if (!more) {
+            return;
+        }
+    }
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -0,0 +1,245 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+#include "TimeStretcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Nomad {
+namespace Audio {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr uint32_t kOnsetBlocks = 8;        // Energy sub-blocks per grain
+constexpr double kOnsetRatio = 8.0;         // ~9 dB rise over the preceding sub-blocks
+constexpr double kOnsetFloor = 1e-6;        // Mean power below -60 dBFS never counts as an onset
+
+struct TierParams {
+    uint32_t grainFrames;
+    uint32_t searchFrames;
+    uint32_t coarseStride;
+};
+
+TierParams paramsFor(StretchQuality quality) noexcept {
+    switch (quality) {
+        case StretchQuality::HighQuality: return {2048, 512, 1};
+        case StretchQuality::Realtime:
+        default:                          return {1024, 192, 4};
+    }
+}
+
+void toMono(const double* stereo, uint32_t frames, float* mono) noexcept {
+    for (uint32_t i = 0; i < frames; ++i) {
+        mono[i] = static_cast<float>(0.5 * (stereo[i * 2] + stereo[i * 2 + 1]));
+    }
+}
+
+/// Correlation of target with the candidate at lag, over every stride-th sample.
+double correlate(const float* target, const float* candidates, uint32_t lag, uint32_t frames,
+                 uint32_t stride) noexcept {
+    float dot = 0.0f, energy = 0.0f;
+    const float* c = candidates + lag;
+    for (uint32_t i = 0; i < frames; i += stride) {
+        dot += target[i] * c[i];
+        energy += c[i] * c[i];
+    }
+    return energy > 0.0f ? static_cast<double>(dot) / std::sqrt(static_cast<double>(energy)) : 0.0;
+}
+
+} // anonymous namespace
+
+void TimeStretcher::configure(StretchQuality quality) {
+    const TierParams params = paramsFor(quality);
+    m_quality = quality;
+    m_grainFrames = params.grainFrames;
+    m_hopFrames = params.grainFrames / 2;
+    m_searchFrames = params.searchFrames;
+    m_coarseStride = params.coarseStride;
+
+    // Periodic Hann: windows a hop apart sum to exactly one.
+    m_window.resize(m_grainFrames);
+    for (uint32_t i = 0; i < m_grainFrames; ++i) {
+        m_window[i] = 0.5 - 0.5 * std::cos(2.0 * kPi * i / m_grainFrames);
+    }
+    const uint32_t regionFrames = 2 * m_searchFrames + 1 + m_hopFrames;
+    m_ola.assign(static_cast<size_t>(m_grainFrames) * 2, 0.0);
+    m_grain.assign(static_cast<size_t>(m_grainFrames) * 2, 0.0);
+    m_next.assign(static_cast<size_t>(m_grainFrames) * 2, 0.0);
+    m_region.assign(static_cast<size_t>(regionFrames) * 2, 0.0);
+    m_target.assign(m_hopFrames, 0.0f);
+    m_candidates.assign(regionFrames, 0.0f);
+    m_transientGrains = 0;
+    reset();
+}
+
+bool TimeStretcher::process(Reader reader, void* context, double origin, double tempo, double pitchStep,
+                            uint64_t outputFrame, double* dst, uint32_t frames) noexcept {
+    if (!isConfigured() || !reader) {
+        std::memset(dst, 0, static_cast<size_t>(frames) * 2 * sizeof(double));
+        return true;
+    }
+    m_complete = true;
+    m_context = context;
+    if (outputFrame != m_expectedFrame || reader != m_reader || origin != m_origin || tempo != m_tempo ||
+        pitchStep != m_pitchStep) {
+        m_reader = reader;
+        m_origin = origin;
+        m_tempo = tempo;
+        m_pitchStep = pitchStep;
+        restart(outputFrame);
+    }
+
+    // The first hop of m_ola is complete; later grains only add to the rest.
+    uint64_t position = outputFrame;
+    for (uint32_t done = 0; done < frames;) {
+        uint64_t olaStart = static_cast<uint64_t>(m_olaGrain) * m_hopFrames;
+        while (position >= olaStart + m_hopFrames) {
+            advance();
+            olaStart += m_hopFrames;
+        }
+        const uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(frames - done, olaStart + m_hopFrames - position));
+        std::memcpy(dst + static_cast<size_t>(done) * 2, m_ola.data() + (position - olaStart) * 2,
+                    static_cast<size_t>(n) * 2 * sizeof(double));
+        done += n;
+        position += n;
+    }
+    m_expectedFrame = position;
+    return m_complete;
+}
+
+void TimeStretcher::restart(uint64_t outputFrame) noexcept {
+    // Seed the grid with two grains that overlap on the same source frames, so the first
+    // hop is the source itself from the nominal position on.
+    m_olaGrain = static_cast<int64_t>(outputFrame / m_hopFrames);
+    std::fill(m_ola.begin(), m_ola.end(), 0.0);
+    const double nominal = m_origin + static_cast<double>(m_olaGrain) * m_hopFrames * m_tempo;
+    m_lastStart = nominal - m_hopFrames * m_pitchStep;
+    addGrain(m_olaGrain - 1, true);
+    m_lastStart = nominal;
+    addGrain(m_olaGrain, true);
+    m_onsetFloor = -std::numeric_limits<double>::infinity();
+}
+
+void TimeStretcher::advance() noexcept {
+    // Slide the output window one hop, then add the grain starting at its new head.
+    const size_t hopSamples = static_cast<size_t>(m_hopFrames) * 2;
+    std::memmove(m_ola.data(), m_ola.data() + hopSamples, hopSamples * sizeof(double));
+    std::fill(m_ola.begin() + static_cast<std::ptrdiff_t>(hopSamples), m_ola.end(), 0.0);
+    ++m_olaGrain;
+    addGrain(m_olaGrain, false);
+}
+
+void TimeStretcher::addGrain(int64_t grain, bool seed) noexcept {
+    if (!seed) {
+        // The continuation is what the previous grain would have played next.
+        const double continuation = m_lastStart + m_hopFrames * m_pitchStep;
+        m_complete &= m_reader(m_context, continuation, m_pitchStep, m_next.data(), m_grainFrames);
+        const double nominal = m_origin + static_cast<double>(grain) * m_hopFrames * m_tempo;
+        const double maxDrift = 2.0 * m_searchFrames * m_pitchStep;
+        if (continuation < m_onsetFloor) {
+            m_lastStart = continuation;   // Still inside the onset's grains
+        } else if (holdsOnset(m_next.data()) && std::abs(continuation - nominal) <= maxDrift) {
+            // Play the onset unshifted; the next grain continues through it too, and
+            // none after that may reach back into it.
+            m_lastStart = continuation;
+            m_onsetFloor = continuation + m_grainFrames * m_pitchStep;
+            ++m_transientGrains;
+        } else {
+            m_lastStart = searchStart(nominal);
+            if (m_lastStart != continuation) {
+                m_complete &= m_reader(m_context, m_lastStart, m_pitchStep, m_next.data(), m_grainFrames);
+            }
+        }
+        std::memcpy(m_grain.data(), m_next.data(), m_grain.size() * sizeof(double));
+    } else {
+        m_complete &= m_reader(m_context, m_lastStart, m_pitchStep, m_grain.data(), m_grainFrames);
+    }
+
+    // Window and overlap-add the part that falls inside m_ola.
+    const int64_t offset = (grain - m_olaGrain) * static_cast<int64_t>(m_hopFrames);
+    const uint32_t first = offset < 0 ? static_cast<uint32_t>(-offset) : 0;
+    for (uint32_t i = first; i < m_grainFrames; ++i) {
+        const int64_t at = offset + i;
+        if (at >= static_cast<int64_t>(m_grainFrames)) break;
+        const double w = m_window[i];
+        m_ola[at * 2] += m_grain[i * 2] * w;
+        m_ola[at * 2 + 1] += m_grain[i * 2 + 1] * w;
+    }
+}
+
+double TimeStretcher::searchStart(double nominal) noexcept {
+    // Candidate starts lo + lag * pitchStep, lag in [0, lags), never before the onset floor.
+    const double step = m_pitchStep;
+    double lo = nominal - m_searchFrames * step;
+    uint32_t lags = 2 * m_searchFrames + 1;
+    if (lo < m_onsetFloor) {
+        const double skipped = std::ceil((m_onsetFloor - lo) / step);
+        if (skipped >= lags) {
+            return m_onsetFloor;
+        }
+        lo += skipped * step;
+        lags -= static_cast<uint32_t>(skipped);
+    }
+    const uint32_t regionFrames = lags - 1 + m_hopFrames;
+    m_complete &= m_reader(m_context, lo, step, m_region.data(), regionFrames);
+    toMono(m_region.data(), regionFrames, m_candidates.data());
+    toMono(m_next.data(), m_hopFrames, m_target.data());
+
+    // Ties (periodic material) go to the lag nearest the nominal position.
+    const double centre = (nominal - lo) / step;
+    uint32_t bestLag = 0;
+    double best = -std::numeric_limits<double>::infinity();
+    auto consider = [&](uint32_t lag, uint32_t stride) {
+        const double score = correlate(m_target.data(), m_candidates.data(), lag, m_hopFrames, stride);
+        const double margin = 1e-9 * std::abs(best) + 1e-12;
+        if (score > best + margin ||
+            (score >= best - margin && std::abs(lag - centre) < std::abs(bestLag - centre))) {
+            best = score;
+            bestLag = lag;
+        }
+    };
+
+    // Coarse pass over every stride-th lag and sample, then refine around the winner.
+    const uint32_t stride = m_coarseStride;
+    const uint32_t phase = static_cast<uint32_t>(std::llround(centre)) % stride;
+    for (uint32_t lag = phase; lag < lags; lag += stride) {
+        consider(lag, stride);
+    }
+    if (stride > 1) {
+        const uint32_t coarse = bestLag;
+        best = -std::numeric_limits<double>::infinity();
+        const uint32_t from = coarse > stride - 1 ? coarse - (stride - 1) : 0;
+        const uint32_t to = std::min(lags - 1, coarse + stride - 1);
+        for (uint32_t lag = from; lag <= to; ++lag) {
+            consider(lag, 1);
+        }
+    }
+    return lo + bestLag * step;
+}
+
+bool TimeStretcher::holdsOnset(const double* grain) const noexcept {
+    // Energy per sub-block; an onset is a jump over the two sub-blocks before it. One in the
+    // overlap half is caught too: the previous grain already holds it at this alignment.
+    const uint32_t blockFrames = m_grainFrames / kOnsetBlocks;
+    double energy[kOnsetBlocks];
+    for (uint32_t b = 0; b < kOnsetBlocks; ++b) {
+        double sum = 0.0;
+        const double* p = grain + static_cast<size_t>(b) * blockFrames * 2;
+        for (uint32_t i = 0; i < blockFrames * 2; ++i) {
+            sum += p[i] * p[i];
+        }
+        energy[b] = sum / (blockFrames * 2);
+    }
+    for (uint32_t b = 2; b < kOnsetBlocks; ++b) {
+        const double before = 0.5 * (energy[b - 1] + energy[b - 2]);
+        if (energy[b] > kOnsetFloor && energy[b] > kOnsetRatio * before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Audio
+} // namespace Nomad
@@ -5,12 +5,14 @@
 #include <cmath>
 #include <fstream>
 #include <cstring>
+#include <filesystem>
 #include <mutex>
 #include <numeric>
 #include <condition_variable>
 #include "SamplePool.h"
 #include "MiniAudioDecoder.h"
 #include "PathUtils.h"
+#include "WaveformCache.h"
 #ifdef _WIN32
 #include <mfapi.h>
 #include <mfidl.h>
@@ -195,8 +197,8 @@ namespace {
 
         return true;
     }
-}
 #endif // _WIN32
+}
 
 // === Audio Quality Preset Implementations ===
 
@@ -292,85 +294,10 @@ struct WavHeader {
 };
 #pragma pack(pop)
 
-struct WavInfo {
-    uint32_t sampleRate{0};
-    uint16_t channels{0};
-    uint16_t bitsPerSample{0};
-    uint32_t dataOffset{0};
-    uint32_t dataSize{0};
-    uint16_t audioFormat{0};
-};
-
-static bool parseWavInfo(const std::string& filePath, WavInfo& info) {
-    // Use makeUnicodePath for proper Unicode file path handling
-    std::ifstream file(makeUnicodePath(filePath), std::ios::binary);
-    if (!file) {
-        Log::warning("Failed to open WAV file: " + filePath);
-        return false;
-    }
-
-    char riffId[4];
-    uint32_t riffSize = 0;
-    char waveId[4];
-    if (!file.read(riffId, 4) || !file.read(reinterpret_cast<char*>(&riffSize), 4) || !file.read(waveId, 4)) {
-        return false;
-    }
-    if (std::strncmp(riffId, "RIFF", 4) != 0 || std::strncmp(waveId, "WAVE", 4) != 0) {
-        return false;
-    }
-
-    bool fmtFound = false;
-    bool dataFound = false;
-    uint16_t audioFormat = 1;
-    uint16_t channelCount = 2;
-    uint32_t sr = 44100;
-    uint16_t bitsPerSample = 16;
-    uint32_t dataSize = 0;
-    std::streampos dataPos{};
-
-    while (file && !(fmtFound && dataFound)) {
-        char chunkId[4];
-        uint32_t chunkSize = 0;
-        if (!file.read(chunkId, 4) || !file.read(reinterpret_cast<char*>(&chunkSize), 4)) break;
-
-        if (std::strncmp(chunkId, "fmt ", 4) == 0) {
-            fmtFound = true;
-            if (chunkSize < 16) return false;
-            file.read(reinterpret_cast<char*>(&audioFormat), sizeof(uint16_t));
-            file.read(reinterpret_cast<char*>(&channelCount), sizeof(uint16_t));
-            file.read(reinterpret_cast<char*>(&sr), sizeof(uint32_t));
-
-            uint32_t byteRate = 0;
-            uint16_t blockAlign = 0;
-            file.read(reinterpret_cast<char*>(&byteRate), sizeof(uint32_t));
-            file.read(reinterpret_cast<char*>(&blockAlign), sizeof(uint16_t));
-            file.read(reinterpret_cast<char*>(&bitsPerSample), sizeof(uint16_t));
-            if (chunkSize > 16) {
-                file.seekg(chunkSize - 16, std::ios::cur);
-            }
-        } else if (std::strncmp(chunkId, "data", 4) == 0) {
-            dataFound = true;
-            dataSize = chunkSize;
-            dataPos = file.tellg();
-            file.seekg(chunkSize, std::ios::cur);
-        } else {
-            file.seekg(chunkSize, std::ios::cur);
-        }
-    }
-
-    if (!(fmtFound && dataFound)) return false;
-
-    info.sampleRate = sr;
-    info.channels = channelCount;
-    info.bitsPerSample = bitsPerSample;
-    info.dataOffset = static_cast<uint32_t>(dataPos);
-    info.dataSize = dataSize;
-    info.audioFormat = audioFormat;
-    return true;
-}
-
 // Simple WAV file loader
-bool loadWavFile(const std::string& filePath, std::vector<float>& audioData, uint32_t& sampleRate, uint32_t& numChannels) {
+bool loadWavFile(const std::string& filePath, std::vector<float>& audioData, uint32_t& sampleRate, uint32_t& numChannels,
+                 uint32_t& integerBits) {
+    integerBits = 0;
     // Use makeUnicodePath for proper Unicode file path handling
     std::ifstream file(makeUnicodePath(filePath), std::ios::binary);
     if (!file) {
@@ -536,6 +463,7 @@ bool loadWavFile(const std::string& filePath, std::vector<float>& audioData, uin
 
     sampleRate = sr;
     numChannels = channelCount;
+    integerBits = audioFormat == 1 ? bitsPerSample : 0;
 
     Log::info("WAV loaded: " + std::to_string(audioData.size()) + " samples, " +
               std::to_string(sampleRate) + " Hz, " + std::to_string(numChannels) + " channels");
@@ -543,6 +471,52 @@ bool loadWavFile(const std::string& filePath, std::vector<float>& audioData, uin
     return true;
 }
 
+bool loadWavFile(const std::string& filePath, std::vector<float>& audioData, uint32_t& sampleRate, uint32_t& numChannels) {
+    uint32_t integerBits = 0;
+    return loadWavFile(filePath, audioData, sampleRate, numChannels, integerBits);
+}
+
+// Decode a whole file into an interleaved stereo SamplePool buffer: WAV with the
+// reader above, other formats through miniaudio and then Media Foundation
+// (Windows only). Safe on any thread; progress may abort a compressed decode.
+static bool decodeIntoBuffer(const std::string& filePath, bool isWav, AudioBuffer& out, uint32_t& sourceChannels,
+                             [[maybe_unused]] const std::function<bool(float)>& progress = {}) {
+    std::vector<float> decoded;
+    uint32_t sr = 48000;
+    uint32_t ch = 2;
+    uint32_t bits = 0;
+    if (isWav) {
+        if (!loadWavFile(filePath, decoded, sr, ch, bits)) {
+            return false;
+        }
+    } else {
+#ifdef _WIN32
+        // Prefer miniaudio when enabled (MP3/FLAC/OGG/etc). Falls back to MF on Windows.
+        if (!loadWithMiniAudio(filePath, decoded, sr, ch, progress)) {
+            if (progress && !progress(0.0f)) {
+                return false;   // Aborted, not unsupported
+            }
+            if (!loadWithMediaFoundation(filePath, decoded, sr, ch)) {
+                return false;
+            }
+        }
+#else
+        return false;
+#endif
+    }
+
+    uint32_t srcCh = ch;
+    forceStereo(decoded, ch, srcCh);
+
+    out.sampleRate = sr;
+    out.channels = ch;
+    out.data.swap(decoded);
+    out.sourcePath = filePath;
+    out.sourceBitDepth = bits;   // Lets SampleStorage::Native pack it losslessly
+    sourceChannels = srcCh;
+    return true;
+}
+
 Track::Track(const std::string& name, uint32_t trackId)
     : m_uuid(TrackUUID::generate())  // Generate stable UUID on creation
     , m_name(name)
@@ -568,7 +542,7 @@ Track::Track(const std::string& name, uint32_t trackId)
 }
 
 Track::~Track() {
-    stopStreaming();
+    cancelLoad();   // Withdraw from a decode nobody will adopt
     if (isRecording()) {
         stopRecording();
     }
@@ -578,15 +552,144 @@ Track::~Track() {
 const std::vector<float>& Track::getAudioData() const {
     // Prefer shared sample buffer if present (non-streaming full loads)
     if (m_sampleBuffer && m_sampleBuffer->ready.load()) {
+        if (m_sampleBuffer->isPacked()) {
+            std::lock_guard<std::mutex> lock(m_unpackedMutex);
+            if (m_unpackedFrom != m_sampleBuffer) {
+                m_unpacked = SamplePool::toFloat(*m_sampleBuffer);
+                m_unpackedFrom = m_sampleBuffer;
+            }
+            return m_unpacked;
+        }
         return m_sampleBuffer->data;
     }
-    return m_audioData;
+    static const std::vector<float> kNoSamples;
+    return m_audioData ? *m_audioData : kNoSamples;
+}
+
+bool Track::hasAudioData() const {
+    if (m_sampleBuffer && m_sampleBuffer->ready.load()) {
+        return m_sampleBuffer->numFrames > 0;
+    }
+    return m_audioData && !m_audioData->empty();
+}
+
+bool Track::isStreamed() const {
+    std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+    return m_sampleBuffer && m_sampleBuffer->isStreaming;
 }
 
 std::shared_ptr<const AudioBuffer> Track::getSampleBuffer() const {
     return m_sampleBuffer;
 }
 
+namespace {
+
+// Shared by every track so peak builds queue on one bounded pool.
+WaveformCacheBuilder& waveformBuilder() {
+    static WaveformCacheBuilder builder;
+    return builder;
+}
+
+// Scan a pool buffer in slices, so a packed buffer is never expanded whole.
+bool buildBufferPeaks(WaveformCache& cache, const AudioBuffer& buffer) {
+    if (buffer.numFrames == 0 || buffer.channels == 0) {
+        return false;
+    }
+    if (!buffer.isPacked()) {
+        cache.buildFromRaw(buffer.data.data(), static_cast<SampleIndex>(buffer.numFrames), buffer.channels);
+        return true;
+    }
+    constexpr uint32_t kSliceFrames = 1 << 16;
+    std::vector<float> slice(static_cast<size_t>(kSliceFrames) * buffer.channels);
+    for (uint64_t start = 0; start < buffer.numFrames; start += kSliceFrames) {
+        const auto frames = static_cast<uint32_t>(std::min<uint64_t>(kSliceFrames, buffer.numFrames - start));
+        SamplePool::readFrames(buffer, start, frames, slice.data());
+        cache.append(slice.data(), frames, buffer.channels);
+    }
+    return true;
+}
+
+// Read a streamed file through the stream's own decoder or file position, so
+// playback from it is undisturbed and the file is never held whole.
+bool buildStreamPeaks(WaveformCache& cache, const StreamingSource& stream) {
+    if (stream.numFrames() == 0) {
+        return false;
+    }
+    return stream.decodeSlices([&cache](const float* stereo, uint32_t frames) {
+        cache.append(stereo, frames, 2);
+        return true;
+    });
+}
+
+} // namespace
+
+std::shared_ptr<const WaveformCache> Track::getWaveformCache() const {
+    std::shared_ptr<AudioBuffer> buffer;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+        buffer = m_sampleBuffer;
+    }
+    if (buffer && buffer->ready.load()) {
+        if (auto cache = std::atomic_load(&buffer->waveform)) {
+            return cache;
+        }
+        if (!buffer->waveformRequested.exchange(true)) {
+            waveformBuilder().buildAsync(
+                buffer->sourcePath,
+                [buffer](WaveformCache& cache) {
+                    if (buffer->isStreaming) {
+                        return buildStreamPeaks(cache, *buffer->stream);
+                    }
+                    return buildBufferPeaks(cache, *buffer);
+                },
+                [buffer](std::shared_ptr<WaveformCache> cache) {
+                    std::atomic_store(&buffer->waveform, std::shared_ptr<const WaveformCache>(std::move(cache)));
+                });
+        }
+        return nullptr;
+    }
+
+    // Generated/recorded audio: rebuild whenever the samples change. The builder
+    // shares the (immutable) samples, so nothing is copied here.
+    const uint64_t version = getAudioDataVersion();
+    std::shared_ptr<WaveformSlot> slot = m_waveformSlot;
+    {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->cacheVersion == version || slot->requestedVersion == version) {
+            return slot->cache;
+        }
+        slot->requestedVersion = version;
+    }
+    std::shared_ptr<const std::vector<float>> samples;
+    uint32_t channels = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+        samples = m_audioData;
+        channels = m_numChannels;
+    }
+    if (!samples || samples->empty() || channels == 0) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        slot->cache.reset();
+        slot->cacheVersion = version;
+        return nullptr;
+    }
+    waveformBuilder().buildAsync(
+        std::string(),
+        [samples = std::move(samples), channels](WaveformCache& cache) {
+            cache.buildFromRaw(samples->data(), static_cast<SampleIndex>(samples->size() / channels), channels);
+            return true;
+        },
+        [slot, version](std::shared_ptr<WaveformCache> cache) {
+            std::lock_guard<std::mutex> lock(slot->mutex);
+            if (cache && version > slot->cacheVersion) {
+                slot->cache = std::move(cache);
+                slot->cacheVersion = version;
+            }
+        });
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    return slot->cache;
+}
+
 // Track Properties
 void Track::setName(const std::string& name) {
     m_name = name;
@@ -600,6 +703,11 @@ void Track::setColor(uint32_t color) {
     m_color = color;
 }
 
+uint64_t Track::nextVersion() {
+    static std::atomic<uint64_t> s_version{0};
+    return s_version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
 // Audio Parameters (thread-safe)
 void Track::setVolume(float volume) {
     volume = (volume < 0.0f) ? 0.0f : (volume > 2.0f) ? 2.0f : volume;  // 0% to 200%
@@ -610,6 +718,7 @@ void Track::setVolume(float volume) {
     if (m_mixerBus) {
         m_mixerBus->setGain(volume);
     }
+    touchGraph();
     // Volume is RT-controlled via command queue; avoid forcing graph rebuilds for
     // parameter-only changes while the engine is connected.
     if (!m_commandSink && m_onDataChanged) {
@@ -633,6 +742,7 @@ void Track::setPan(float pan) {
     if (m_mixerBus) {
         m_mixerBus->setPan(pan);
     }
+    touchGraph();
     if (!m_commandSink && m_onDataChanged) {
         m_onDataChanged();
     }
@@ -653,6 +763,7 @@ void Track::setMute(bool mute) {
     if (m_mixerBus) {
         m_mixerBus->setMute(mute);
     }
+    touchGraph();
     if (!m_commandSink && m_onDataChanged) {
         m_onDataChanged();
     }
@@ -673,6 +784,7 @@ void Track::setSolo(bool solo) {
     if (m_mixerBus) {
         m_mixerBus->setSolo(solo);
     }
+    touchGraph();
     if (!m_commandSink && m_onDataChanged) {
         m_onDataChanged();
     }
@@ -718,11 +830,31 @@ void Track::setState(TrackState state) {
     }
 }
 
+bool Track::loadStreamingFile(const std::string& filePath, TrackState previousState) {
+    auto buffer = SamplePool::getInstance().acquireStreaming(filePath);
+    if (!buffer) {
+        return false;
+    }
+    useSampleBuffer(filePath, buffer, buffer->stream->sourceChannels());
+    setState(TrackState::Loaded);
+    Log::info("Streaming from disk: " + filePath + " (" + std::to_string(buffer->numFrames) + " frames @ " +
+              std::to_string(buffer->sampleRate) + " Hz)");
+    // Notify that audio data changed (for graph rebuild)
+    touchAudioData();
+    if (m_onDataChanged) {
+        m_onDataChanged();
+    }
+    if (previousState == TrackState::Playing) {
+        setState(TrackState::Playing);
+    }
+    return true;
+}
+
 // Audio Data Management
 bool Track::loadAudioFile(const std::string& filePath) {
+    cancelLoad();
     const TrackState previousState = getState();
     std::cout << "Loading: " << filePath << " (track: " << m_name << ")" << std::endl;
-    stopStreaming();
     m_sampleBuffer.reset();
 
     // Check if file exists (using makeUnicodePath for Unicode support)
@@ -736,7 +868,7 @@ bool Track::loadAudioFile(const std::string& filePath) {
     // Clear any existing audio data (streaming/recording buffers)
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-        m_audioData.clear();
+        m_audioData.reset();
     }
     m_durationSeconds.store(0.0);
     m_playbackPhase.store(0.0);
@@ -749,57 +881,34 @@ bool Track::loadAudioFile(const std::string& filePath) {
         std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     }
 
-    if (extension == "wav") {
-        WavInfo info{};
-        bool infoOk = parseWavInfo(filePath, info);
-        const uint64_t STREAM_THRESHOLD_BYTES = 50ull * 1024ull * 1024ull; // 50MB
-
-        const bool enableStreaming = false;
-        if (enableStreaming && infoOk) {
-            const uint64_t bytesPerFrame = (info.bitsPerSample / 8) * info.channels;
-            const uint64_t totalFrames = bytesPerFrame ? (static_cast<uint64_t>(info.dataSize) / bytesPerFrame) : 0;
-            bool streamableFormat = (info.audioFormat == 1 || info.audioFormat == 3) &&
-                                    (info.bitsPerSample == 16 || info.bitsPerSample == 24 || info.bitsPerSample == 32);
-
-            if (streamableFormat && info.dataSize > STREAM_THRESHOLD_BYTES && totalFrames > 0) {
-                if (startWavStreaming(filePath, info.sampleRate, info.channels, info.bitsPerSample, info.dataOffset, info.dataSize)) {
-                    m_sourcePath = filePath;
-                    m_durationSeconds.store(static_cast<double>(totalFrames) / info.sampleRate);
-                    setState(TrackState::Loaded);
-                    Log::info("WAV streaming enabled: " + std::to_string(totalFrames) + " frames");
-                    // Notify that audio data changed (for graph rebuild)
-                    if (m_onDataChanged) {
-                        m_onDataChanged();
-                    }
-                    return true;
-                }
-                Log::warning("Streaming setup failed, falling back to full load");
-            }
+    // Files too large to decode into memory stream from disk (memory-mapped PCM,
+    // or a read-ahead ring for compressed formats). AIFF has no in-memory
+    // decoder, so it always streams.
+    const uint64_t STREAM_THRESHOLD_BYTES = 50ull * 1024ull * 1024ull; // 50MB
+    const bool isAiff = extension == "aif" || extension == "aiff" || extension == "aifc";
+    std::error_code sizeError;
+    const uintmax_t fileBytes = std::filesystem::file_size(makeUnicodePath(filePath), sizeError);
+    if (isAiff || (!sizeError && fileBytes > STREAM_THRESHOLD_BYTES)) {
+        if (loadStreamingFile(filePath, previousState)) {
+            return true;
+        }
+        if (!isAiff) {
+            Log::warning("Streaming setup failed, falling back to full load");
         }
+    }
 
+    if (extension == "wav") {
         // Load WAV file fully through SamplePool
         uint32_t sampleRate = 48000; // Default fallback
         uint32_t numChannels = 2;    // Default fallback
         uint32_t sourceChannels = 2;
 
-        auto loader = [this, &sampleRate, &numChannels, &sourceChannels, filePath](AudioBuffer& out) -> bool {
-            std::vector<float> decoded;
-            uint32_t sr = sampleRate;
-            uint32_t ch = numChannels;
-            if (!loadWavFile(filePath, decoded, sr, ch)) {
+        auto loader = [&sampleRate, &numChannels, &sourceChannels, filePath](AudioBuffer& out) -> bool {
+            if (!decodeIntoBuffer(filePath, true, out, sourceChannels)) {
                 return false;
             }
-            uint32_t srcCh = ch;
-            forceStereo(decoded, ch, srcCh);
-
-            out.sampleRate = sr;
-            out.channels = ch;
-            out.data.swap(decoded);
-            out.sourcePath = filePath;
-
-            sampleRate = sr;
-            numChannels = ch;
-            sourceChannels = srcCh;
+            sampleRate = out.sampleRate;
+            numChannels = out.channels;
             return true;
         };
 
@@ -823,6 +932,7 @@ bool Track::loadAudioFile(const std::string& filePath) {
             Log::info("WAV loaded successfully via SamplePool: " + std::to_string(buffer->data.size()) + " samples, " +
                        std::to_string(m_durationSeconds.load()) + " seconds");
             // Notify that audio data changed (for graph rebuild)
+            touchAudioData();
             if (m_onDataChanged) {
                 m_onDataChanged();
             }
@@ -840,29 +950,12 @@ bool Track::loadAudioFile(const std::string& filePath) {
         uint32_t numChannels = 2;
         uint32_t sourceChannels = 2;
 
-        auto loader = [this, &sampleRate, &numChannels, &sourceChannels, filePath](AudioBuffer& out) -> bool {
-            std::vector<float> decoded;
-            uint32_t sr = sampleRate;
-            uint32_t ch = numChannels;
-
-            // Prefer miniaudio when enabled (MP3/FLAC/OGG/etc). Falls back to MF on Windows.
-            if (!loadWithMiniAudio(filePath, decoded, sr, ch)) {
-                if (!loadWithMediaFoundation(filePath, decoded, sr, ch)) {
-                    return false;
-                }
+        auto loader = [&sampleRate, &numChannels, &sourceChannels, filePath](AudioBuffer& out) -> bool {
+            if (!decodeIntoBuffer(filePath, false, out, sourceChannels)) {
+                return false;
             }
-
-            uint32_t srcCh = ch;
-            forceStereo(decoded, ch, srcCh);
-
-            out.sampleRate = sr;
-            out.channels = ch;
-            out.data.swap(decoded);
-            out.sourcePath = filePath;
-
-            sampleRate = sr;
-            numChannels = ch;
-            sourceChannels = srcCh;
+            sampleRate = out.sampleRate;
+            numChannels = out.channels;
             return true;
         };
 
@@ -887,6 +980,7 @@ bool Track::loadAudioFile(const std::string& filePath) {
                        std::to_string(m_durationSeconds.load()) + " seconds @ " +
                        std::to_string(sampleRate) + " Hz, channels: " + std::to_string(numChannels));
             // Notify that audio data changed (for graph rebuild)
+            touchAudioData();
             if (m_onDataChanged) {
                 m_onDataChanged();
             }
@@ -914,6 +1008,156 @@ bool Track::loadAudioFile(const std::string& filePath) {
     return generatePreviewTone(filePath);
 }
 
+bool Track::loadAudioFileAsync(const std::string& filePath) {
+    cancelLoad();
+
+    std::string extension;
+    if (auto dotPos = filePath.find_last_of('.'); dotPos != std::string::npos && dotPos + 1 < filePath.size()) {
+        extension = filePath.substr(dotPos + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    }
+    const bool isWav = extension == "wav";
+#ifdef _WIN32
+    const bool decodable = extension != "aif" && extension != "aiff" && extension != "aifc";
+#else
+    const bool decodable = isWav;
+#endif
+    // Missing, streamed and undecodable files never block on a decode: load them now.
+    const uint64_t STREAM_THRESHOLD_BYTES = 50ull * 1024ull * 1024ull; // Matches loadAudioFile()
+    std::error_code sizeError;
+    const uintmax_t fileBytes = std::filesystem::file_size(makeUnicodePath(filePath), sizeError);
+    if (sizeError || !decodable || fileBytes > STREAM_THRESHOLD_BYTES) {
+        return loadAudioFile(filePath);
+    }
+
+    const TrackState previousState = getState();
+    m_sourcePath = filePath;
+    m_loading.store(true, std::memory_order_release);
+
+    auto loader = [filePath, isWav](AudioBuffer& out, SampleLoadContext& context) -> bool {
+        uint32_t sourceChannels = 2;
+        return decodeIntoBuffer(filePath, isWav, out, sourceChannels, [&context](float fraction) {
+            context.setProgress(fraction);
+            return !context.cancelled();
+        });
+    };
+    // No completion callback: the buffer is adopted on this thread by pollAsyncLoad().
+    SampleLoadHandle handle = SamplePool::getInstance().acquireAsync(filePath, loader);
+    {
+        std::lock_guard<std::mutex> lock(m_pendingLoadMutex);
+        m_pendingLoad = std::move(handle);
+        m_pendingLoadPath = filePath;
+        m_pendingLoadState = previousState;
+    }
+    pollAsyncLoad();   // Cache hits are ready at once
+    return true;
+}
+
+bool Track::pollAsyncLoad() {
+    SampleLoadHandle finished;
+    std::string filePath;
+    TrackState previousState;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingLoadMutex);
+        if (!m_pendingLoad.valid() || !m_pendingLoad.isReady()) {
+            return false;
+        }
+        finished = std::move(m_pendingLoad);
+        filePath = std::move(m_pendingLoadPath);
+        previousState = m_pendingLoadState;
+    }
+    adoptLoadedBuffer(filePath, finished.get(), previousState);
+
+    // Trims set while loading were kept as requested; clamp them to the audio now.
+    const double trimStart = m_trimStart.load();
+    const double trimEnd = m_trimEnd.load();
+    if (trimStart != 0.0 || trimEnd >= 0.0) {
+        m_trimStart.store(0.0);
+        setTrimEnd(trimEnd);
+        setTrimStart(trimStart);
+    }
+    return true;
+}
+
+void Track::adoptLoadedBuffer(const std::string& filePath, const std::shared_ptr<AudioBuffer>& buffer,
+                              TrackState previousState) {
+    m_loading.store(false, std::memory_order_release);
+    if (!buffer || !buffer->ready.load() || buffer->sampleRate == 0) {
+        Log::warning("Failed to load audio file: " + filePath + ", generating preview tone instead");
+        generatePreviewTone(filePath);
+        return;
+    }
+
+    useSampleBuffer(filePath, buffer, buffer->channels);
+    m_playbackPhase.store(0.0);
+    m_positionSeconds.store(0.0);
+    setState(TrackState::Loaded);
+    Log::info("Audio loaded asynchronously via SamplePool: " + filePath + " (" +
+              std::to_string(m_durationSeconds.load()) + " seconds)");
+    // Notify that audio data changed (for graph rebuild)
+    touchAudioData();
+    if (m_onDataChanged) {
+        m_onDataChanged();
+    }
+    if (previousState == TrackState::Playing) {
+        setState(TrackState::Playing);
+    }
+}
+
+void Track::useSampleBuffer(const std::string& filePath, const std::shared_ptr<AudioBuffer>& buffer,
+                            uint32_t sourceChannels) {
+    std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+    m_audioData.reset();
+    m_sampleBuffer = buffer;
+    m_sampleRate = buffer->sampleRate;
+    m_numChannels = buffer->channels;
+    m_sourceChannels = sourceChannels;
+    m_sourcePath = filePath;
+    m_durationSeconds.store(static_cast<double>(buffer->numFrames) / buffer->sampleRate);
+}
+
+bool Track::shareStream(const Track& source) {
+    std::shared_ptr<AudioBuffer> buffer;
+    std::string path;
+    uint32_t sourceChannels = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(source.m_audioDataMutex);
+        buffer = source.m_sampleBuffer;
+        path = source.m_sourcePath;
+        sourceChannels = source.m_sourceChannels;
+    }
+    if (!buffer || !buffer->isStreaming || !buffer->ready.load() || buffer->sampleRate == 0) {
+        return false;
+    }
+    cancelLoad();
+    useSampleBuffer(path, buffer, sourceChannels);
+    m_playbackPhase.store(0.0);
+    m_positionSeconds.store(0.0);
+    setState(TrackState::Loaded);
+    touchAudioData();
+    if (m_onDataChanged) {
+        m_onDataChanged();
+    }
+    return true;
+}
+
+float Track::getLoadProgress() const {
+    std::lock_guard<std::mutex> lock(m_pendingLoadMutex);
+    return m_pendingLoad.valid() ? m_pendingLoad.progress() : 1.0f;
+}
+
+void Track::cancelLoad() {
+    SampleLoadHandle pending;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingLoadMutex);
+        pending = std::move(m_pendingLoad);
+    }
+    if (pending.valid()) {
+        pending.cancel();
+    }
+    m_loading.store(false, std::memory_order_release);
+}
+
 bool Track::generatePreviewTone(const std::string& filePath) {
     m_sampleBuffer.reset();
     m_sourcePath = filePath;
@@ -949,7 +1193,7 @@ bool Track::generatePreviewTone(const std::string& filePath) {
 
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-        m_audioData.swap(buffer);
+        m_audioData = std::make_shared<const std::vector<float>>(std::move(buffer));
         m_numChannels = 2;
         m_sourceChannels = 2;
     }
@@ -957,10 +1201,11 @@ bool Track::generatePreviewTone(const std::string& filePath) {
     m_durationSeconds.store(duration);
     setState(TrackState::Loaded);
 
-    std::cout << "Preview tone generated: " << m_audioData.size() << " samples, "
+    std::cout << "Preview tone generated: " << m_audioData->size() << " samples, "
               << m_durationSeconds.load() << " seconds, " << baseFrequency << " Hz" << std::endl;
 
     // Notify that audio data changed (for graph rebuild)
+    touchAudioData();
     if (m_onDataChanged) {
         m_onDataChanged();
     }
@@ -1011,7 +1256,7 @@ bool Track::generateDemoAudio(const std::string& filePath) {
 
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-        m_audioData.swap(buffer);
+        m_audioData = std::make_shared<const std::vector<float>>(std::move(buffer));
         m_numChannels = 2;
         m_sourceChannels = 2;
     }
@@ -1019,10 +1264,11 @@ bool Track::generateDemoAudio(const std::string& filePath) {
     m_durationSeconds.store(duration);
     setState(TrackState::Loaded);
 
-    std::cout << "Demo audio generated: " << m_audioData.size() << " samples, "
+    std::cout << "Demo audio generated: " << m_audioData->size() << " samples, "
               << m_durationSeconds.load() << " seconds, " << frequency << " Hz" << std::endl;
 
     // Notify that audio data changed (for graph rebuild)
+    touchAudioData();
     if (m_onDataChanged) {
         m_onDataChanged();
     }
@@ -1036,7 +1282,7 @@ void Track::clearAudioData() {
     }
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-        m_audioData.clear();
+        m_audioData.reset();
         m_recordingBuffer.clear();
         m_numChannels = 2;
         m_sourceChannels = 2;
@@ -1046,6 +1292,7 @@ void Track::clearAudioData() {
     m_positionSeconds.store(0.0);
     setState(TrackState::Empty);
 
+    touchAudioData();
     if (m_onDataChanged) {
         m_onDataChanged();
     }
@@ -1112,7 +1359,7 @@ void Track::setAudioData(const float* data, uint32_t numSamples, uint32_t sample
         return;
     }
     
-    stopStreaming();
+    cancelLoad();
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
         m_sampleBuffer.reset();
@@ -1141,20 +1388,21 @@ void Track::setAudioData(const float* data, uint32_t numSamples, uint32_t sample
     {
         std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
         m_sampleRate = targetSR;
-        m_audioData.swap(finalData.empty() ? temp : finalData);
+        m_audioData = std::make_shared<const std::vector<float>>(std::move(finalData.empty() ? temp : finalData));
         m_numChannels = 2;
     }
-    const double durationSeconds = static_cast<double>(m_audioData.size() / m_numChannels) / static_cast<double>(m_sampleRate);
+    const double durationSeconds = static_cast<double>(m_audioData->size() / m_numChannels) / static_cast<double>(m_sampleRate);
     m_durationSeconds.store(durationSeconds);
     m_playbackPhase.store(0.0);
     m_positionSeconds.store(0.0);
     setState(TrackState::Loaded);
     
-    const uint64_t storedFrames = static_cast<uint64_t>(m_audioData.size() / m_numChannels);
+    const uint64_t storedFrames = static_cast<uint64_t>(m_audioData->size() / m_numChannels);
     Log::info("Audio data loaded: " + std::to_string(storedFrames) + " frames @ " +
                std::to_string(m_sampleRate) + " Hz (source " + std::to_string(sampleRate) + " Hz, " +
                std::to_string(numChannels) + " ch)");
 
+    touchAudioData();
     if (m_onDataChanged) {
         m_onDataChanged();
     }
@@ -1188,7 +1436,8 @@ void Track::stopRecording() {
 
     // Move recording buffer to main audio data
     if (!m_recordingBuffer.empty()) {
-        m_audioData = std::move(m_recordingBuffer);
+        std::vector<float> recorded = std::move(m_recordingBuffer);
+        m_recordingBuffer.clear();
         
         // Apply latency compensation if configured
         if (m_latencyCompensationMs > 0.0) {
@@ -1198,10 +1447,10 @@ void Track::stopRecording() {
             );
             
             // Ensure we don't shift more than available data
-            if (compensationSamples > 0 && compensationSamples < m_audioData.size()) {
+            if (compensationSamples > 0 && compensationSamples < recorded.size()) {
                 // Shift audio data earlier by removing the latency from the beginning
                 // This aligns the recorded audio with the timeline
-                m_audioData.erase(m_audioData.begin(), m_audioData.begin() + compensationSamples);
+                recorded.erase(recorded.begin(), recorded.begin() + compensationSamples);
                 
                 Log::info("[Latency Compensation] Shifted recorded audio earlier by " + 
                           std::to_string(m_latencyCompensationMs) + " ms (" + 
@@ -1209,11 +1458,16 @@ void Track::stopRecording() {
             }
         }
         
-        m_durationSeconds.store(static_cast<double>(m_audioData.size()) / (m_sampleRate * m_numChannels));
+        m_durationSeconds.store(static_cast<double>(recorded.size()) / (m_sampleRate * m_numChannels));
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+            m_audioData = std::make_shared<const std::vector<float>>(std::move(recorded));
+        }
         setState(TrackState::Loaded);
     } else {
         setState(TrackState::Empty);
     }
+    touchAudioData();
 
     m_recordingBuffer.clear();
     m_isRecording.store(false);
@@ -1252,17 +1506,11 @@ void Track::setPosition(double seconds) {
     // Clamp position to valid range
     double duration = getDuration();
     seconds = (seconds < 0.0) ? 0.0 : (seconds > duration) ? duration : seconds;
-    
-    if (m_streaming.load(std::memory_order_relaxed)) {
-        uint64_t targetFrame = static_cast<uint64_t>(seconds * m_sampleRate);
-        uint64_t maxFrames = m_streamTotalFrames.load(std::memory_order_relaxed);
-        if (targetFrame > maxFrames) targetFrame = maxFrames;
 
-        // Re-seek streaming source
-        uint64_t dataSizeBytes = maxFrames * static_cast<uint64_t>(m_streamBytesPerSample.load(std::memory_order_relaxed) * m_sourceChannels);
-        startWavStreaming(m_sourcePath, m_sampleRate, static_cast<uint16_t>(m_sourceChannels),
-                          static_cast<uint16_t>(m_streamBytesPerSample.load(std::memory_order_relaxed) * 8),
-                          m_streamDataOffset.load(std::memory_order_relaxed), dataSizeBytes, targetFrame);
+    // Streamed files: have the I/O pool load the new position before playback reads it.
+    std::shared_ptr<AudioBuffer> sampleBuffer = m_sampleBuffer;
+    if (sampleBuffer && sampleBuffer->isStreaming && sampleBuffer->stream) {
+        sampleBuffer->stream->cue(static_cast<uint64_t>(seconds * m_sampleRate), 0.0);
     }
 
     m_positionSeconds.store(seconds);
@@ -1350,22 +1598,19 @@ void Track::copyAudioData(float* outputBuffer, uint32_t numFrames, double output
     std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
 
     std::shared_ptr<AudioBuffer> sampleBuffer = m_sampleBuffer;
+    StreamingSource* stream = sampleBuffer && sampleBuffer->isStreaming ? sampleBuffer->stream.get() : nullptr;
+    const bool packed = sampleBuffer && sampleBuffer->ready.load() && sampleBuffer->isPacked();
+    const bool windowed = stream || packed;   // Only this block's frames, as float, in m_streamWindow
     const std::vector<float>* buffer = nullptr;
     uint32_t channels = m_numChannels;
-    if (m_streaming) {
-        buffer = &m_audioData;
+    if (windowed) {
+        buffer = &m_streamWindow;
     } else if (sampleBuffer && sampleBuffer->ready.load()) {
         buffer = &sampleBuffer->data;
     } else {
-        buffer = &m_audioData;
-    }
-
-    if (!buffer || buffer->empty()) {
-        generateSilence(outputBuffer, numFrames);
-        return;
+        buffer = &getAudioData();
     }
 
-    uint32_t totalSamples = static_cast<uint32_t>(buffer->size());
     double phase = m_playbackPhase.load();
     
     // Calculate sample rate ratio for resampling
@@ -1375,13 +1620,35 @@ void Track::copyAudioData(float* outputBuffer, uint32_t numFrames, double output
     const double sampleRateRatio = static_cast<double>(m_sampleRate) / outputSampleRate;
     const uint32_t outputRate = static_cast<uint32_t>(outputSampleRate);
 
+    uint64_t baseFrame = 0;
+    if (windowed) {
+        // Pull only the source frames this block spans (plus the widest
+        // interpolator's reach) from the shared I/O pool's read-ahead, or
+        // unpack them from packed storage.
+        constexpr uint64_t margin = 256;
+        const uint64_t first = static_cast<uint64_t>(phase);
+        baseFrame = first > margin ? first - margin : 0;
+        const uint32_t frames = static_cast<uint32_t>(numFrames * sampleRateRatio) + static_cast<uint32_t>(margin * 2 + 2);
+        m_streamWindow.resize(static_cast<size_t>(frames) * 2);
+        if (stream) {
+            stream->read(baseFrame, frames, m_streamWindow.data());
+        } else {
+            SamplePool::readFrames(*sampleBuffer, baseFrame, frames, m_streamWindow.data());
+        }
+    }
+
+    if (!buffer || buffer->empty()) {
+        generateSilence(outputBuffer, numFrames);
+        return;
+    }
+
+    uint32_t totalSamples = static_cast<uint32_t>(buffer->size());
     const uint64_t bufferFrames = totalSamples / channels;
-    const uint64_t baseFrame = m_streamBaseFrame.load(std::memory_order_relaxed);
 
     // ============================================================================
     // SRC Module Path (batch processing - more efficient)
     // ============================================================================
-    if (m_useSRCModule && !m_streaming && m_sampleRate != outputRate) {
+    if (m_useSRCModule && !windowed && m_sampleRate != outputRate) {
         // Configure SRC if sample rate or output rate changed
         if (!m_srcConverter.isConfigured() || 
             m_srcConverter.getSourceRate() != m_sampleRate ||
@@ -1433,9 +1700,9 @@ void Track::copyAudioData(float* outputBuffer, uint32_t numFrames, double output
             
             for (uint32_t ch = 0; ch < channels; ++ch) {
                 float sample = 0.0f;
-                double localPos = m_streaming ? (exactSamplePos - baseFrame) : exactSamplePos;
+                double localPos = windowed ? (exactSamplePos - baseFrame) : exactSamplePos;
 
-                if (!m_streaming || (localPos >= 0.0 && localPos + 1.0 < bufferFrames)) {
+                if (!windowed || (localPos >= 0.0 && localPos + 1.0 < bufferFrames)) {
                     // Choose interpolation method based on resampling mode
                     switch (m_qualitySettings.resampling) {
                         case ResamplingMode::Fast:
@@ -1498,185 +1765,6 @@ void Track::copyAudioData(float* outputBuffer, uint32_t numFrames, double output
     }
 
     m_playbackPhase.store(phase);
-    if (m_streaming.load(std::memory_order_relaxed)) {
-        trimStreamBuffer(static_cast<uint64_t>(phase));
-        m_streamCv.notify_one();
-    }
-}
-
-void Track::trimStreamBuffer(uint64_t currentFrame) {
-    if (!m_streaming.load(std::memory_order_relaxed)) return;
-    const uint32_t keepMargin = 8192; // frames to keep ahead of playhead for safety
-    const uint64_t targetBase = (currentFrame > keepMargin) ? (currentFrame - keepMargin) : 0;
-
-    // CRITICAL: Must hold m_audioDataMutex when modifying m_audioData to prevent
-    // race conditions with streamWavThread and copyAudioData.
-    // Note: m_audioDataMutex is recursive, so this is safe even when called from
-    // copyAudioData which already holds the lock.
-    std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-    
-    uint64_t baseFrame = m_streamBaseFrame.load(std::memory_order_relaxed);
-    if (targetBase > baseFrame) {
-        uint64_t framesToDrop = targetBase - baseFrame;
-        uint64_t availableFrames = m_audioData.size() / m_numChannels;
-        if (framesToDrop >= availableFrames) {
-            // Do not drop everything
-            return;
-        }
-        const size_t dropSamples = static_cast<size_t>(framesToDrop * m_numChannels);
-        m_audioData.erase(m_audioData.begin(), m_audioData.begin() + dropSamples);
-        m_streamBaseFrame.store(baseFrame + framesToDrop, std::memory_order_relaxed);
-    }
-}
-
-bool Track::startWavStreaming(const std::string& filePath, uint32_t sampleRate, uint16_t channels, uint16_t bitsPerSample, uint32_t dataOffset, uint64_t dataSize, uint64_t startFrame) {
-    stopStreaming();
-    m_sampleBuffer.reset();
-
-    // Use makeUnicodePath for proper Unicode file path handling
-    m_streamFile = std::ifstream(makeUnicodePath(filePath), std::ios::binary);
-    if (!m_streamFile) {
-        Log::warning("Failed to open WAV for streaming: " + filePath);
-        return false;
-    }
-
-    const uint32_t bytesPerFrame = (bitsPerSample / 8) * channels;
-    uint64_t startOffset = dataOffset + startFrame * bytesPerFrame;
-    uint64_t maxOffset = dataOffset + dataSize;
-    if (startOffset >= maxOffset) {
-        startOffset = dataOffset;
-        startFrame = 0;
-    }
-
-    m_streamFile.seekg(static_cast<std::streamoff>(startOffset), std::ios::beg);
-    if (!m_streamFile.good()) {
-        Log::warning("Failed to seek WAV data chunk for streaming");
-        return false;
-    }
-
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
-        m_audioData.clear();
-        m_streamBaseFrame.store(startFrame, std::memory_order_relaxed);
-        m_streamEof.store(false, std::memory_order_relaxed);
-        m_streamTotalFrames.store((bitsPerSample / 8 == 0 || channels == 0) ? 0 : dataSize / bytesPerFrame, std::memory_order_relaxed);
-        m_streamBytesPerSample.store(bitsPerSample / 8, std::memory_order_relaxed);
-        m_streamDataOffset.store(dataOffset, std::memory_order_relaxed);
-        m_sampleRate = sampleRate;
-        m_numChannels = 2;
-        m_sourceChannels = channels;
-    }
-
-    m_streamStop.store(false);
-    m_streaming.store(true, std::memory_order_release);
-
-    // Launch background thread
-    m_streamThread = std::thread(&Track::streamWavThread, this, channels);
-    return true;
-}
-
-void Track::stopStreaming() {
-    if (!m_streaming.load(std::memory_order_relaxed)) return;
-    m_streamStop.store(true);
-    m_streamCv.notify_one();
-    if (m_streamThread.joinable()) {
-        m_streamThread.join();
-    }
-    m_streaming.store(false, std::memory_order_release);
-    m_streamEof.store(false, std::memory_order_relaxed);
-    if (m_streamFile.is_open()) {
-        m_streamFile.close();
-    }
-}
-
-void Track::streamWavThread(uint32_t channels) {
-    const uint32_t bytesPerSample = m_streamBytesPerSample.load(std::memory_order_relaxed);
-    const uint32_t bytesPerFrame = bytesPerSample * channels;
-    const uint32_t targetBufferFrames = m_sampleRate * 6; // keep ~6s buffered
-    const uint32_t chunkFrames = m_sampleRate;            // read ~1s per iteration
-
-    while (!m_streamStop.load()) {
-        std::unique_lock<std::mutex> lk(m_streamMutex);
-        m_streamCv.wait_for(lk, std::chrono::milliseconds(20), [&] {
-            std::lock_guard<std::recursive_mutex> audioLock(m_audioDataMutex);
-            uint64_t bufferedFrames = m_audioData.size() / m_numChannels;
-            return m_streamStop.load() || bufferedFrames < targetBufferFrames;
-        });
-        lk.unlock();
-        if (m_streamStop.load()) break;
-
-        // Check EOF
-        {
-            std::lock_guard<std::recursive_mutex> audioLock(m_audioDataMutex);
-            uint64_t bufferedFrames = m_audioData.size() / m_numChannels;
-            uint64_t baseFrame = m_streamBaseFrame.load(std::memory_order_relaxed);
-            uint64_t totalFrames = m_streamTotalFrames.load(std::memory_order_relaxed);
-            if (m_streamEof.load(std::memory_order_relaxed) || (baseFrame + bufferedFrames) >= totalFrames) {
-                m_streamEof.store(true, std::memory_order_relaxed);
-                continue;
-            }
-        }
-
-        // Read next chunk
-        const uint64_t baseFrame = m_streamBaseFrame.load(std::memory_order_relaxed);
-        const uint64_t totalFrames = m_streamTotalFrames.load(std::memory_order_relaxed);
-        const uint64_t currentEndFrame = baseFrame + (m_audioData.size() / m_numChannels);
-        const uint64_t remainingFrames = (totalFrames > currentEndFrame) ? (totalFrames - currentEndFrame) : 0;
-        uint32_t framesToRead = static_cast<uint32_t>(std::min<uint64_t>(chunkFrames, remainingFrames));
-        if (framesToRead == 0) {
-            m_streamEof.store(true, std::memory_order_relaxed);
-            continue;
-        }
-
-        std::vector<char> raw(framesToRead * bytesPerFrame);
-        m_streamFile.read(raw.data(), raw.size());
-        size_t got = static_cast<size_t>(m_streamFile.gcount());
-        if (got == 0) {
-            m_streamEof = true;
-            continue;
-        }
-        const size_t gotFrames = got / bytesPerFrame;
-        std::vector<float> decoded;
-        decoded.reserve(gotFrames * channels);
-
-        if (bytesPerSample == 2) {
-            const int16_t* in = reinterpret_cast<int16_t*>(raw.data());
-            for (size_t i = 0; i < gotFrames * channels; ++i) {
-                decoded.push_back(static_cast<float>(in[i]) / 32768.0f);
-            }
-        } else if (bytesPerSample == 3) {
-            for (size_t i = 0; i < gotFrames * channels; ++i) {
-                int32_t sample = (static_cast<uint8_t>(raw[i * 3])) |
-                                 (static_cast<uint8_t>(raw[i * 3 + 1]) << 8) |
-                                 (static_cast<int8_t>(raw[i * 3 + 2]) << 16);
-                decoded.push_back(std::max(-1.0f, std::min(1.0f, sample / 8388608.0f)));
-            }
-        } else if (bytesPerSample == 4) {
-            if (m_streamBytesPerSample == 4 && m_streamTotalFrames) {
-                // Assume float32 if audioFormat was IEEE float (we only stream PCM/float)
-                const float* in = reinterpret_cast<float*>(raw.data());
-                decoded.insert(decoded.end(), in, in + gotFrames * channels);
-            } else {
-                const int32_t* in = reinterpret_cast<int32_t*>(raw.data());
-                const float inv = 1.0f / 2147483648.0f;
-                for (size_t i = 0; i < gotFrames * channels; ++i) {
-                    decoded.push_back(std::max(-1.0f, std::min(1.0f, in[i] * inv)));
-                }
-            }
-        }
-
-        uint32_t inCh = channels;
-        forceStereo(decoded, inCh, m_sourceChannels);
-
-        {
-            std::lock_guard<std::recursive_mutex> audioLock(m_audioDataMutex);
-            m_audioData.insert(m_audioData.end(), decoded.begin(), decoded.end());
-        }
-
-        if (decoded.empty() || gotFrames < framesToRead) {
-            m_streamEof.store(true, std::memory_order_relaxed);
-        }
-    }
 }
 
 // Linear interpolation (2-point, fast)
@@ -2263,6 +2351,13 @@ void Track::setQualitySettings(const AudioQualitySettings& settings) {
 // ============================================================================
 
 void Track::setTrimStart(double seconds) {
+    if (isLoading()) {
+        // No duration to clamp against yet; pollAsyncLoad() clamps on adoption.
+        m_trimStart.store(std::max(0.0, seconds));
+        touchGraph();
+        return;
+    }
+
     double duration = getDuration();
     // Clamp to valid range
     seconds = std::max(0.0, std::min(seconds, duration));
@@ -2274,6 +2369,7 @@ void Track::setTrimStart(double seconds) {
     }
     
     m_trimStart.store(seconds);
+    touchGraph();
     Log::info("Track " + m_name + " trim start set to " + std::to_string(seconds) + "s");
 }
 
@@ -2283,6 +2379,13 @@ void Track::setTrimEnd(double seconds) {
     // -1 means use full length
     if (seconds < 0) {
         m_trimEnd.store(-1.0);
+        touchGraph();
+        return;
+    }
+
+    if (isLoading()) {
+        m_trimEnd.store(seconds);   // Clamped by pollAsyncLoad() on adoption
+        touchGraph();
         return;
     }
     
@@ -2296,6 +2399,7 @@ void Track::setTrimEnd(double seconds) {
     }
     
     m_trimEnd.store(seconds);
+    touchGraph();
     Log::info("Track " + m_name + " trim end set to " + std::to_string(seconds) + "s");
 }
 
@@ -2316,6 +2420,7 @@ double Track::getTrimmedDuration() const {
 void Track::resetTrim() {
     m_trimStart.store(0.0);
     m_trimEnd.store(-1.0);
+    touchGraph();
     Log::info("Track " + m_name + " trim reset to full length");
 }
 
@@ -2326,9 +2431,27 @@ std::shared_ptr<Track> Track::splitAt(double positionInClip) {
         return nullptr;
     }
     
+    if (isStreamed()) {
+        auto newTrack = std::make_shared<Track>(m_name, m_trackId + 1000);
+        newTrack->setColor(m_color);
+        newTrack->setLaneIndex(m_laneIndex);
+        if (!splitStreamInto(*newTrack, positionInClip)) {
+            return nullptr;
+        }
+        Log::info("Track " + m_name + " (UUID: " + m_uuid.toString() +
+                  ") split at " + std::to_string(positionInClip) + "s, new clip UUID: " +
+                  newTrack->getUUID().toString() + " (lane: " + std::to_string(m_laneIndex) + ")");
+        return newTrack;
+    }
+
     // Calculate split position in samples
     uint32_t splitSample = static_cast<uint32_t>(positionInClip * m_sampleRate);
-    uint32_t totalSamples = static_cast<uint32_t>(m_audioData.size() / m_numChannels);
+    std::shared_ptr<const std::vector<float>> samples;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+        samples = m_audioData;
+    }
+    uint32_t totalSamples = samples ? static_cast<uint32_t>(samples->size() / m_numChannels) : 0;
     
     if (splitSample >= totalSamples) {
         return nullptr;
@@ -2344,7 +2467,7 @@ std::shared_ptr<Track> Track::splitAt(double positionInClip) {
     
     // Copy second half to new track
     size_t splitIndex = splitSample * m_numChannels;
-    std::vector<float> secondHalf(m_audioData.begin() + splitIndex, m_audioData.end());
+    std::vector<float> secondHalf(samples->begin() + splitIndex, samples->end());
     newTrack->setAudioData(secondHalf.data(), 
                            totalSamples - splitSample,
                            m_sampleRate, m_numChannels, m_sampleRate);
@@ -2354,14 +2477,18 @@ std::shared_ptr<Track> Track::splitAt(double positionInClip) {
     newTrack->setStartPositionInTimeline(originalStart + positionInClip);
     newTrack->setSourcePath(m_sourcePath);
     
-    // Trim this track to only first half
-    m_audioData.resize(splitIndex);
+    // Trim this track to only first half (a new vector: peak builds may still hold the old one)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_audioDataMutex);
+        m_audioData = std::make_shared<const std::vector<float>>(samples->begin(), samples->begin() + splitIndex);
+    }
     m_durationSeconds.store(positionInClip);
     
     // Reset trim end since we truncated
     if (m_trimEnd.load() > positionInClip) {
         m_trimEnd.store(-1.0);
     }
+    touchAudioData();
     
     Log::info("Track " + m_name + " (UUID: " + m_uuid.toString() + 
               ") split at " + std::to_string(positionInClip) + "s, new clip UUID: " + 
@@ -2369,6 +2496,20 @@ std::shared_ptr<Track> Track::splitAt(double positionInClip) {
     return newTrack;
 }
 
+bool Track::splitStreamInto(Track& second, double positionInClip) {
+    // Both halves play the same stream: the cut is a trim, not a copy.
+    const double cut = getTrimStart() + positionInClip;
+    const double trimEnd = getTrimEnd();
+    if (positionInClip <= 0.0 || cut >= (trimEnd > 0.0 ? trimEnd : getDuration()) || !second.shareStream(*this)) {
+        return false;
+    }
+    second.setTrimEnd(trimEnd);
+    second.setTrimStart(cut);
+    second.setStartPositionInTimeline(getStartPositionInTimeline() + positionInClip);
+    setTrimEnd(cut);
+    return true;
+}
+
 std::shared_ptr<Track> Track::duplicate() const {
     // Duplicate uses same name (no "(copy)" suffix for cleaner workflow)
     // Each duplicate gets its own UUID automatically
@@ -2381,15 +2522,18 @@ std::shared_ptr<Track> Track::duplicate() const {
     newTrack->setMute(isMuted());
     newTrack->setSourcePath(m_sourcePath);
     
-    // Copy audio data
-    if (!m_audioData.empty()) {
-        uint32_t totalSamples = static_cast<uint32_t>(m_audioData.size() / m_numChannels);
-        newTrack->setAudioData(m_audioData.data(), totalSamples, m_sampleRate, m_numChannels, m_sampleRate);
+    // Copy audio data (a streamed file is shared, there is nothing to copy)
+    if (isStreamed()) {
+        newTrack->shareStream(*this);
+    } else if (m_audioData && !m_audioData->empty()) {
+        uint32_t totalSamples = static_cast<uint32_t>(m_audioData->size() / m_numChannels);
+        newTrack->setAudioData(m_audioData->data(), totalSamples, m_sampleRate, m_numChannels, m_sampleRate);
     }
     
     // Copy trim settings
     newTrack->m_trimStart.store(m_trimStart.load());
     newTrack->m_trimEnd.store(m_trimEnd.load());
+    newTrack->touchGraph();
     
     // Position slightly offset from original
     newTrack->setStartPositionInTimeline(getStartPositionInTimeline());
@@ -35,99 +35,20 @@ static void reindexTracks(std::vector<std::shared_ptr<Track>>& tracks, std::unor
     }
 }
 
-//==============================================================================
-// AudioThreadPool Implementation
-//==============================================================================
-
-AudioThreadPool::AudioThreadPool(size_t numThreads) {
-    for (size_t i = 0; i < numThreads; ++i) {
-        m_workers.emplace_back([this, i] { 
-            // Set thread priority to High (but not Realtime/MMCSS) for worker threads
-            Platform::setCurrentThreadPriority(Platform::ThreadPriority::High);
-            workerThread(); 
-        });
-    }
-    
-    Log::info("AudioThreadPool created with " + std::to_string(numThreads) + " threads");
-}
-
-AudioThreadPool::~AudioThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
-        m_stop = true;
-    }
-    m_condition.notify_all();
-    
-    for (std::thread& worker : m_workers) {
-        if (worker.joinable()) {
-            worker.join();
-        }
-    }
-    
-    Log::info("AudioThreadPool destroyed");
-}
-
-void AudioThreadPool::enqueue(std::function<void()> task) {
-    {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
-        m_tasks.push(std::move(task));
-        m_activeTasks.fetch_add(1);
-    }
-    m_condition.notify_one();
-}
-
-void AudioThreadPool::waitForCompletion() {
-    std::unique_lock<std::mutex> lock(m_queueMutex);
-    m_completionCondition.wait(lock, [this] { 
-        return m_tasks.empty() && m_activeTasks.load() == 0; 
-    });
-}
-
-void AudioThreadPool::workerThread() {
-    while (true) {
-        std::function<void()> task;
-        
-        {
-            std::unique_lock<std::mutex> lock(m_queueMutex);
-            m_condition.wait(lock, [this] { 
-                return m_stop || !m_tasks.empty(); 
-            });
-            
-            if (m_stop && m_tasks.empty()) {
-                return;
-            }
-            
-            if (!m_tasks.empty()) {
-                task = std::move(m_tasks.front());
-                m_tasks.pop();
-            }
-        }
-        
-        if (task) {
-            task();
-            
-            size_t remaining = m_activeTasks.fetch_sub(1) - 1;
-            if (remaining == 0) {
-                m_completionCondition.notify_all();
-            }
-        }
-    }
-}
-
 //==============================================================================
 // TrackManager Implementation
 //==============================================================================
 
 TrackManager::TrackManager() {
-    // Create thread pool with optimal thread count
+    // Pick the thread count for the job system
     // Use hardware concurrency minus 1 (leave one core for OS/UI)
     // Minimum 2 threads, maximum 8 threads for real-time audio
+    // The pool itself is created by the first multi-threaded processAudio():
+    // AudioEngine renders on its own pool, so most sessions never start this one.
     size_t hwThreads = std::thread::hardware_concurrency();
-    size_t audioThreads = (std::max)(static_cast<size_t>(2), (std::min)(static_cast<size_t>(8), hwThreads > 0 ? hwThreads - 1 : 4));
+    m_threadCount = (std::max)(static_cast<size_t>(2), (std::min)(static_cast<size_t>(8), hwThreads > 0 ? hwThreads - 1 : 4));
     
-    m_threadPool = std::make_unique<AudioThreadPool>(audioThreads);
-    
-    Log::info("TrackManager created with " + std::to_string(audioThreads) + " audio processing threads");
+    Log::info("TrackManager created with " + std::to_string(m_threadCount) + " audio processing threads");
 }
 
 TrackManager::~TrackManager() {
@@ -140,9 +61,14 @@ void TrackManager::setThreadCount(size_t count) {
     // Clamp between 1 and 16 threads
     count = std::max(size_t(1), std::min(size_t(16), count));
     
-    // Recreate thread pool with new count
-    m_threadPool.reset();
-    m_threadPool = std::make_unique<AudioThreadPool>(count);
+    // Recreate a running job system with the new count (under the track lock so
+    // the audio callback never sees a half-destroyed pool)
+    std::lock_guard<std::mutex> lock(m_trackMutex);
+    m_threadCount = count;
+    if (m_threadPool) {
+        m_threadPool.reset();
+        m_threadPool = std::make_unique<AudioJobSystem>(count);
+    }
     
     Log::info("TrackManager thread count set to: " + std::to_string(count));
 }
@@ -282,6 +208,27 @@ void TrackManager::clearAllTracks() {
     Log::info("Cleared all tracks");
 }
 
+size_t TrackManager::pollAsyncLoads() {
+    std::vector<std::shared_ptr<Track>> loading;
+    {
+        std::lock_guard<std::mutex> lock(m_trackMutex);
+        for (const auto& track : m_tracks) {
+            if (track && track->isLoading()) {
+                loading.push_back(track);
+            }
+        }
+    }
+
+    // Adopt outside the lock: adoption runs the track's data-changed callback.
+    size_t adopted = 0;
+    for (const auto& track : loading) {
+        if (track->pollAsyncLoad()) {
+            ++adopted;
+        }
+    }
+    return adopted;
+}
+
 // Transport Control
 void TrackManager::play() {
     m_isPlaying.store(true);  // CRITICAL: Set to true even when resuming from pause
@@ -406,7 +353,7 @@ double TrackManager::getMaxTimelineExtent() const {
     for (const auto& track : m_tracks) {
         if (!track) continue;
         double start = track->getStartPositionInTimeline();
-        double end = start + track->getDuration();
+        double end = start + track->getTrimmedDuration();
         maxExtent = std::max(maxExtent, end);
     }
     return maxExtent;
@@ -421,12 +368,20 @@ bool TrackManager::moveClipToTrack(size_t fromIndex, size_t toIndex) {
     if (!from || !to || from.get() == to.get()) {
         return false;
     }
-    // Move audio data and metadata
-    to->setAudioData(from->getAudioData().data(),
-                     static_cast<uint32_t>(from->getAudioData().size() / from->getNumChannels()),
-                     from->getSampleRate(),
-                     from->getNumChannels(),
-                     static_cast<uint32_t>(m_outputSampleRate.load()));
+    // Move audio data and metadata (a streamed file is shared along with its trims)
+    if (from->isStreamed()) {
+        if (!to->shareStream(*from)) {
+            return false;
+        }
+        to->setTrimEnd(from->getTrimEnd());
+        to->setTrimStart(from->getTrimStart());
+    } else {
+        to->setAudioData(from->getAudioData().data(),
+                         static_cast<uint32_t>(from->getAudioData().size() / from->getNumChannels()),
+                         from->getSampleRate(),
+                         from->getNumChannels(),
+                         static_cast<uint32_t>(m_outputSampleRate.load()));
+    }
     to->setStartPositionInTimeline(from->getStartPositionInTimeline());
     to->setSourcePath(from->getSourcePath());
     // Clear source track
@@ -451,8 +406,10 @@ std::shared_ptr<Track> TrackManager::sliceClip(size_t trackIndex, double sliceTi
     uint32_t sliceFrame = static_cast<uint32_t>(sliceTimeSeconds * sampleRate);
     uint32_t sliceSample = sliceFrame * numChannels;
 
+    // A streamed file has no samples here: both parts share the stream instead.
+    const bool streamed = track->isStreamed();
     const auto& data = track->getAudioData();
-    if (sliceSample >= data.size()) return nullptr;
+    if (!streamed && sliceSample >= data.size()) return nullptr;
 
     // Create new track with second half
     std::lock_guard<std::mutex> lock(m_trackMutex);
@@ -471,15 +428,21 @@ std::shared_ptr<Track> TrackManager::sliceClip(size_t trackIndex, double sliceTi
     uint32_t trackId = m_nextTrackId.fetch_add(1);
     auto newTrack = std::make_shared<Track>(track->getName(), trackId);
     
-    std::vector<float> secondPart(data.begin() + sliceSample, data.end());
-    newTrack->setAudioData(secondPart.data(),
-                           static_cast<uint32_t>(secondPart.size() / numChannels),
-                           sampleRate,
-                           numChannels,
-                           static_cast<uint32_t>(m_outputSampleRate.load()));
-    double newStart = track->getStartPositionInTimeline() + sliceTimeSeconds;
-    newTrack->setStartPositionInTimeline(newStart);
-    newTrack->setSourcePath(track->getSourcePath());
+    if (streamed) {
+        if (!track->splitStreamInto(*newTrack, sliceTimeSeconds)) {
+            return nullptr;
+        }
+    } else {
+        std::vector<float> secondPart(data.begin() + sliceSample, data.end());
+        newTrack->setAudioData(secondPart.data(),
+                               static_cast<uint32_t>(secondPart.size() / numChannels),
+                               sampleRate,
+                               numChannels,
+                               static_cast<uint32_t>(m_outputSampleRate.load()));
+        double newStart = track->getStartPositionInTimeline() + sliceTimeSeconds;
+        newTrack->setStartPositionInTimeline(newStart);
+        newTrack->setSourcePath(track->getSourcePath());
+    }
     newTrack->setColor(track->getColor());  // Preserve color
     
     // Assign same lane index - this groups clips on the same visual row
@@ -496,12 +459,14 @@ std::shared_ptr<Track> TrackManager::sliceClip(size_t trackIndex, double sliceTi
     }
 
     // Resize original track to first part (must do this AFTER we read from data)
-    std::vector<float> firstPart(data.begin(), data.begin() + sliceSample);
-    track->setAudioData(firstPart.data(),
-                        static_cast<uint32_t>(firstPart.size() / numChannels),
-                        sampleRate,
-                        numChannels,
-                        static_cast<uint32_t>(m_outputSampleRate.load()));
+    if (!streamed) {
+        std::vector<float> firstPart(data.begin(), data.begin() + sliceSample);
+        track->setAudioData(firstPart.data(),
+                            static_cast<uint32_t>(firstPart.size() / numChannels),
+                            sampleRate,
+                            numChannels,
+                            static_cast<uint32_t>(m_outputSampleRate.load()));
+    }
     // Keep original start position
     
     // Mark project as modified
@@ -535,7 +500,7 @@ void TrackManager::processAudio(float* outputBuffer, uint32_t numFrames, double
     }
     
     // Dispatch to single-threaded or multi-threaded implementation
-    if (m_multiThreadingEnabled && m_threadPool && m_tracks.size() > 2) {
+    if (m_multiThreadingEnabled && m_tracks.size() > 2) {
         // Use multi-threading for 3+ tracks
         processAudioMultiThreaded(outputBuffer, numFrames, streamTime, outputSampleRate);
     } else {
@@ -686,11 +651,23 @@ void TrackManager::processAudioSingleThreaded(float* outputBuffer, uint32_t numF
     }
 }
 
+void TrackManager::processTrackJob(void* context, uint32_t trackIndex) {
+    auto* self = static_cast<TrackManager*>(context);
+    self->m_tracks[trackIndex]->processAudio(self->m_trackBuffers[trackIndex].data(),
+                                             self->m_jobNumFrames,
+                                             self->m_jobStreamTime,
+                                             self->m_jobSampleRate);
+}
+
 void TrackManager::processAudioMultiThreaded(float* outputBuffer, uint32_t numFrames, double streamTime, double outputSampleRate) {
-    if (!outputBuffer || numFrames == 0 || !m_threadPool) {
+    if (!outputBuffer || numFrames == 0) {
         return;
     }
     std::lock_guard<std::mutex> lock(m_trackMutex);
+    if (!m_threadPool) {
+        // One-time start on the first multi-threaded block of this legacy path.
+        m_threadPool = std::make_unique<AudioJobSystem>(m_threadCount);
+    }
     
     size_t bufferSize = numFrames * 2; // Stereo
     
@@ -714,6 +691,11 @@ void TrackManager::processAudioMultiThreaded(float* outputBuffer, uint32_t numFr
         }
     }
     
+    // Block parameters shared by all track jobs
+    m_jobNumFrames = numFrames;
+    m_jobStreamTime = streamTime;
+    m_jobSampleRate = outputSampleRate;
+
     // Check if any track is soloed (for exclusive solo behavior)
     bool anySoloed = false;
     for (const auto& track : m_tracks) {
@@ -750,15 +732,13 @@ void TrackManager::processAudioMultiThreaded(float* outputBuffer, uint32_t numFr
                 track->setPosition(relPos);
             }
             
-            // Submit track processing task to thread pool
-            m_threadPool->enqueue([track, &buffer = m_trackBuffers[i], numFrames, streamTime, outputSampleRate]() {
-                track->processAudio(buffer.data(), numFrames, streamTime, outputSampleRate);
-            });
+            // Stage track processing job (preallocated slot, no allocation)
+            m_threadPool->submit(&TrackManager::processTrackJob, this, static_cast<uint32_t>(i));
         }
     }
     
-    // Wait for all tracks to finish processing
-    m_threadPool->waitForCompletion();
+    // Run all staged tracks and wait on the job counter barrier
+    m_threadPool->dispatchAndWait();
     
     // Mix all track buffers into output buffer (lock-free summation)
     // Zero the output buffer first
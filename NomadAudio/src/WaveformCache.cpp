@@ -1,16 +1,286 @@
 // © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
 
 #include "WaveformCache.h"
+#include "AudioKernels.h"
 #include "NomadLog.h"
+#include "PathUtils.h"
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
 #include <future>
 #include <queue>
 #include <thread>
 
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 namespace Nomad {
 namespace Audio {
 
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Peak File Format
+// =============================================================================
+//
+// [PeakFileHeader][PeakFileLevel x numLevels][level 0 peaks][level 1 peaks]...
+//
+// Peaks are interleaved WaveformPeak pairs in native byte order, each level
+// starting on an 8-byte boundary so a mapping can be read in place.
+
+namespace {
+
+constexpr char kPeakFileMagic[8] = {'N', 'O', 'M', 'A', 'D', 'P', 'K', '\0'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr const char* kPeakFileExtension = ".nkpeaks";
+
+struct PeakFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;           ///< kByteOrderMark as written; rejects foreign-endian files
+    uint64_t sourceSize;          ///< Source file key: size in bytes...
+    uint64_t sourceModTime;       ///< ...and last write time
+    int64_t sourceFrames;
+    uint32_t numChannels;
+    uint32_t numLevels;
+    uint32_t baseSamplesPerPeak;
+    uint32_t levelMultiplier;
+};
+
+struct PeakFileLevel {
+    uint32_t samplesPerPeak;
+    uint32_t reserved;
+    int64_t numPeaks;
+    uint64_t offset;              ///< Byte offset of the level's peaks
+};
+
+static_assert(sizeof(PeakFileHeader) == 56, "Peak file header layout changed");
+static_assert(sizeof(PeakFileLevel) == 24, "Peak file level layout changed");
+
+/// Identity of a source file's contents as far as peak files are concerned.
+struct SourceStamp {
+    uint64_t size = 0;
+    uint64_t modTime = 0;
+};
+
+bool stampSource(const std::string& sourcePath, SourceStamp& out) {
+    std::error_code ec;
+    const fs::path p = makeUnicodePath(sourcePath);
+    const auto size = fs::file_size(p, ec);
+    if (ec) {
+        return false;
+    }
+    const auto mod = fs::last_write_time(p, ec);
+    if (ec) {
+        return false;
+    }
+    out.size = static_cast<uint64_t>(size);
+    out.modTime = static_cast<uint64_t>(mod.time_since_epoch().count());
+    return true;
+}
+
+/// FNV-1a, so peak files for same-named sources don't collide in a shared directory.
+uint64_t hashPath(const std::string& path) {
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : path) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash;
+}
+
+std::mutex g_peakDirMutex;
+std::string g_peakDir;
+
+// =============================================================================
+// PeakWorkerPool - Bounded threads for peak building
+// =============================================================================
+
+constexpr uint32_t kMaxPeakThreads = 8;
+
+/// Finest-level frames per parallel chunk (rounded up to whole coarsest peaks).
+constexpr SampleIndex kPeakChunkFrames = 1 << 18;
+
+std::atomic<uint32_t> g_buildThreads{0};
+
+/**
+ * @brief Bounded worker pool for peak building (non-RT).
+ *
+ * Runs WaveformCacheBuilder requests and the chunks of long builds. A thread
+ * waiting in parallelFor() works through the chunks itself, so a build issued
+ * from a pool task never waits on a busy pool.
+ */
+class PeakWorkerPool {
+public:
+    static PeakWorkerPool& instance() {
+        static PeakWorkerPool pool;
+        return pool;
+    }
+
+    ~PeakWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_queue.clear();
+        }
+        m_cv.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    static uint32_t workerCount() {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        return std::min(kMaxPeakThreads, hardware > 1 ? hardware - 1 : 1u);
+    }
+
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_threads.empty()) {
+                for (uint32_t i = 0; i < workerCount(); ++i) {
+                    m_threads.emplace_back([this] { workerLoop(); });
+                }
+            }
+            m_queue.push_back(std::move(task));
+        }
+        m_cv.notify_one();
+    }
+
+    /// Run fn(0) .. fn(count - 1) on up to threads threads, the caller included.
+    void parallelFor(uint32_t count, uint32_t threads, const std::function<void(uint32_t)>& fn) {
+        struct Batch {
+            const std::function<void(uint32_t)>* fn = nullptr;
+            uint32_t count = 0;
+            std::atomic<uint32_t> next{0};
+            std::atomic<uint32_t> done{0};
+            std::mutex mutex;
+            std::condition_variable cv;
+        };
+        auto batch = std::make_shared<Batch>();
+        batch->fn = &fn;
+        batch->count = count;
+        auto work = [](Batch& b) {
+            for (uint32_t i = b.next.fetch_add(1); i < b.count; i = b.next.fetch_add(1)) {
+                (*b.fn)(i);
+                if (b.done.fetch_add(1) + 1 == b.count) {
+                    std::lock_guard<std::mutex> lock(b.mutex);
+                    b.cv.notify_all();
+                }
+            }
+        };
+
+        const uint32_t helpers = std::min(count > 0 ? count - 1 : 0, threads > 0 ? threads - 1 : 0);
+        for (uint32_t h = 0; h < helpers; ++h) {
+            post([batch, work] { work(*batch); });
+        }
+        work(*batch);
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->cv.wait(lock, [&] { return batch->done.load() == count; });
+    }
+
+private:
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) {
+                return;
+            }
+            auto task = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_queue;
+    std::vector<std::thread> m_threads;
+    bool m_stop = false;
+};
+
+} // anonymous namespace
+
+/**
+ * @brief Read-only mapping of a whole peak file.
+ */
+struct WaveformCache::PeakFileMapping {
+    const uint8_t* data = nullptr;
+    uint64_t bytes = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    ~PeakFileMapping() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), static_cast<size_t>(bytes));
+#endif
+    }
+
+    bool map(const std::string& path) {
+        const auto fsPath = makeUnicodePath(path);
+#ifdef _WIN32
+        file = CreateFileW(fsPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+            return false;
+        }
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        bytes = static_cast<uint64_t>(size.QuadPart);
+#else
+        const int fd = ::open(fsPath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);   // The mapping keeps the file alive
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<const uint8_t*>(view);
+        bytes = static_cast<uint64_t>(info.st_size);
+#endif
+        return data != nullptr;
+    }
+};
+
 // =============================================================================
 // WaveformCache Implementation
 // =============================================================================
@@ -45,60 +315,76 @@ void WaveformCache::buildFromRaw(const float* data, SampleIndex numFrames, uint3
     
     m_ready.store(false, std::memory_order_release);
     m_levels.clear();
+    m_mapping.reset();
     m_numChannels = numChannels;
     m_sourceFrames = numFrames;
     
-    // Build first level from raw data
+    // Size every level up front. Coarser peaks start empty (1, -1) and are
+    // widened as the finest peaks inside them are produced, so the audio is
+    // read once for all levels.
     m_levels.resize(numLevels);
-    buildLevel(data, numFrames, numChannels, baseSamplesPerPeak, m_levels[0]);
-    
-    // Build subsequent levels from previous level
-    for (uint32_t i = 1; i < numLevels; ++i) {
-        buildNextLevel(m_levels[i - 1], m_levels[i]);
+    uint32_t samplesPerPeak = baseSamplesPerPeak;
+    for (auto& level : m_levels) {
+        level.samplesPerPeak = samplesPerPeak;
+        level.numChannels = numChannels;
+        level.numPeaks = (numFrames + samplesPerPeak - 1) / samplesPerPeak;
+        level.peaks.assign(static_cast<size_t>(level.numPeaks * numChannels), WaveformPeak(1.0f, -1.0f));
+        samplesPerPeak *= MIP_LEVEL_MULTIPLIER;
     }
     
+    // Chunks cover whole coarsest-level peaks, so no two chunks write the same peak at any level.
+    const SampleIndex perCoarsest = m_levels.back().samplesPerPeak / baseSamplesPerPeak;
+    const SampleIndex wanted = std::max<SampleIndex>(kPeakChunkFrames / baseSamplesPerPeak, 1);
+    const SampleIndex chunkPeaks = (wanted + perCoarsest - 1) / perCoarsest * perCoarsest;
+    const SampleIndex basePeaks = m_levels[0].numPeaks;
+    const auto chunks = static_cast<uint32_t>((basePeaks + chunkPeaks - 1) / chunkPeaks);
+    const uint32_t threads = g_buildThreads.load() > 0 ? g_buildThreads.load() : PeakWorkerPool::workerCount() + 1;
+    PeakWorkerPool::instance().parallelFor(chunks, threads, [&](uint32_t chunk) {
+        const SampleIndex first = chunk * chunkPeaks;
+        buildChunk(data, numFrames, first, std::min(first + chunkPeaks, basePeaks));
+    });
+    
     m_ready.store(true, std::memory_order_release);
     
     Log::info("WaveformCache: Built " + std::to_string(numLevels) + " mip levels for " +
               std::to_string(numFrames) + " frames (" + std::to_string(numChannels) + " ch)");
 }
 
-void WaveformCache::buildLevel(const float* data, SampleIndex numFrames, uint32_t numChannels,
-                                uint32_t samplesPerPeak, WaveformMipLevel& outLevel) {
-    outLevel.samplesPerPeak = samplesPerPeak;
-    outLevel.numChannels = numChannels;
-    outLevel.numPeaks = (numFrames + samplesPerPeak - 1) / samplesPerPeak;
-    
-    outLevel.peaks.resize(static_cast<size_t>(outLevel.numPeaks * numChannels));
+void WaveformCache::buildChunk(const float* data, SampleIndex numFrames,
+                               SampleIndex firstPeak, SampleIndex endPeak) {
+    const AudioKernelTable& kernels = AudioKernels::active();
+    WaveformMipLevel& base = m_levels[0];
+    const SampleIndex samplesPerPeak = base.samplesPerPeak;
+    const uint32_t numChannels = base.numChannels;
     
-    for (SampleIndex peakIdx = 0; peakIdx < outLevel.numPeaks; ++peakIdx) {
-        SampleIndex startFrame = peakIdx * samplesPerPeak;
-        SampleIndex endFrame = std::min(startFrame + samplesPerPeak, numFrames);
+    for (SampleIndex peakIdx = firstPeak; peakIdx < endPeak; ++peakIdx) {
+        const SampleIndex startFrame = peakIdx * samplesPerPeak;
+        const SampleIndex frames = std::min(samplesPerPeak, numFrames - startFrame);
+        WaveformPeak* peak = base.peaks.data() + static_cast<size_t>(peakIdx * numChannels);
+        kernels.peakRange(data + static_cast<size_t>(startFrame * numChannels), static_cast<size_t>(frames),
+                          numChannels, reinterpret_cast<float*>(peak));
         
-        for (uint32_t ch = 0; ch < numChannels; ++ch) {
-            float minVal = 1.0f;
-            float maxVal = -1.0f;
-            
-            for (SampleIndex frame = startFrame; frame < endFrame; ++frame) {
-                float sample = data[frame * numChannels + ch];
-                minVal = std::min(minVal, sample);
-                maxVal = std::max(maxVal, sample);
+        // Fold into the coarser levels while the peak is still in cache.
+        SampleIndex coarseIdx = peakIdx;
+        for (size_t i = 1; i < m_levels.size(); ++i) {
+            coarseIdx /= MIP_LEVEL_MULTIPLIER;
+            WaveformPeak* coarse = m_levels[i].peaks.data() + static_cast<size_t>(coarseIdx * numChannels);
+            for (uint32_t ch = 0; ch < numChannels; ++ch) {
+                coarse[ch].merge(peak[ch]);
             }
-            
-            size_t idx = static_cast<size_t>(peakIdx * numChannels + ch);
-            outLevel.peaks[idx] = WaveformPeak(minVal, maxVal);
         }
     }
 }
 
-void WaveformCache::buildNextLevel(const WaveformMipLevel& source, WaveformMipLevel& dest) {
+void WaveformCache::buildNextLevel(const WaveformMipLevel& source, WaveformMipLevel& dest,
+                                   SampleIndex fromPeak) {
     dest.samplesPerPeak = source.samplesPerPeak * MIP_LEVEL_MULTIPLIER;
     dest.numChannels = source.numChannels;
     dest.numPeaks = (source.numPeaks + MIP_LEVEL_MULTIPLIER - 1) / MIP_LEVEL_MULTIPLIER;
     
     dest.peaks.resize(static_cast<size_t>(dest.numPeaks * dest.numChannels));
     
-    for (SampleIndex peakIdx = 0; peakIdx < dest.numPeaks; ++peakIdx) {
+    for (SampleIndex peakIdx = fromPeak; peakIdx < dest.numPeaks; ++peakIdx) {
         SampleIndex startSourcePeak = peakIdx * MIP_LEVEL_MULTIPLIER;
         SampleIndex endSourcePeak = std::min(startSourcePeak + MIP_LEVEL_MULTIPLIER, source.numPeaks);
         
@@ -115,6 +401,237 @@ void WaveformCache::buildNextLevel(const WaveformMipLevel& source, WaveformMipLe
     }
 }
 
+void WaveformCache::append(const float* data, SampleIndex numFrames, uint32_t numChannels,
+                           uint32_t baseSamplesPerPeak, uint32_t numLevels) {
+    if (!data || numFrames <= 0 || numChannels == 0) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (m_levels.empty()) {
+        if (baseSamplesPerPeak == 0 || numLevels == 0) {
+            Log::warning("WaveformCache: Invalid parameters for append");
+            return;
+        }
+        m_levels.resize(numLevels);
+        m_levels[0].samplesPerPeak = baseSamplesPerPeak;
+        m_levels[0].numChannels = numChannels;
+        m_numChannels = numChannels;
+        m_sourceFrames = 0;
+    } else if (numChannels != m_numChannels) {
+        Log::warning("WaveformCache: Append channel count does not match the cache");
+        return;
+    }
+    detachMapping();
+    
+    // Level 0: the last peak may be partial; fold new frames into it, then into new peaks,
+    // each starting from (1, -1) as in a full build.
+    const AudioKernelTable& kernels = AudioKernels::active();
+    WaveformMipLevel& base = m_levels[0];
+    const SampleIndex spp = base.samplesPerPeak;
+    const SampleIndex firstFrame = m_sourceFrames;
+    const SampleIndex endFrame = firstFrame + numFrames;
+    base.numPeaks = (endFrame + spp - 1) / spp;
+    base.peaks.resize(static_cast<size_t>(base.numPeaks * numChannels), WaveformPeak(1.0f, -1.0f));
+    for (SampleIndex frame = firstFrame; frame < endFrame;) {
+        const SampleIndex peakIdx = frame / spp;
+        const SampleIndex count = std::min((peakIdx + 1) * spp, endFrame) - frame;
+        kernels.peakRange(data + static_cast<size_t>((frame - firstFrame) * numChannels), static_cast<size_t>(count),
+                          numChannels, reinterpret_cast<float*>(base.peaks.data() + peakIdx * numChannels));
+        frame += count;
+    }
+    m_sourceFrames = endFrame;
+    
+    // Coarser levels: rebuild from the first peak whose sources changed.
+    SampleIndex dirty = firstFrame / spp;
+    for (size_t i = 1; i < m_levels.size(); ++i) {
+        dirty /= MIP_LEVEL_MULTIPLIER;
+        buildNextLevel(m_levels[i - 1], m_levels[i], dirty);
+    }
+    
+    m_ready.store(true, std::memory_order_release);
+}
+
+void WaveformCache::detachMapping() {
+    if (!m_mapping) {
+        return;
+    }
+    for (auto& level : m_levels) {
+        if (level.mapped) {
+            level.peaks.assign(level.mapped, level.mapped + level.size());
+            level.mapped = nullptr;
+        }
+    }
+    m_mapping.reset();
+}
+
+void WaveformCache::setBuildThreads(uint32_t threads) {
+    g_buildThreads.store(threads);
+}
+
+uint32_t WaveformCache::getBuildThreads() {
+    const uint32_t threads = g_buildThreads.load();
+    return threads > 0 ? threads : PeakWorkerPool::workerCount() + 1;
+}
+
+// =============================================================================
+// Peak Files
+// =============================================================================
+
+void WaveformCache::setPeakFileDirectory(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(g_peakDirMutex);
+    g_peakDir = dir;
+}
+
+std::string WaveformCache::getPeakFileDirectory() {
+    std::lock_guard<std::mutex> lock(g_peakDirMutex);
+    return g_peakDir;
+}
+
+std::string WaveformCache::peakFilePath(const std::string& sourcePath) {
+    const std::string dir = getPeakFileDirectory();
+    if (dir.empty()) {
+        return sourcePath + kPeakFileExtension;
+    }
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(hashPath(sourcePath)));
+    const fs::path source = makeUnicodePath(sourcePath);
+    const fs::path file = makeUnicodePath(dir) /
+                          makeUnicodePath(pathToUtf8(source.filename()) + "-" + hash + kPeakFileExtension);
+    return pathToUtf8(file);
+}
+
+bool WaveformCache::isMapped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mapping != nullptr;
+}
+
+bool WaveformCache::loadPeakFile(const std::string& sourcePath, uint32_t baseSamplesPerPeak,
+                                 uint32_t numLevels) {
+    SourceStamp stamp;
+    if (!stampSource(sourcePath, stamp)) {
+        return false;
+    }
+    auto mapping = std::make_shared<PeakFileMapping>();
+    if (!mapping->map(peakFilePath(sourcePath)) || mapping->bytes < sizeof(PeakFileHeader)) {
+        return false;
+    }
+    
+    PeakFileHeader header;
+    std::memcpy(&header, mapping->data, sizeof(header));
+    if (std::memcmp(header.magic, kPeakFileMagic, sizeof(kPeakFileMagic)) != 0 ||
+        header.version != PEAK_FILE_VERSION || header.byteOrder != kByteOrderMark) {
+        return false;
+    }
+    if (header.sourceSize != stamp.size || header.sourceModTime != stamp.modTime) {
+        return false;   // Stale: the source changed since the peaks were built
+    }
+    if (header.baseSamplesPerPeak != baseSamplesPerPeak || header.numLevels != numLevels ||
+        header.levelMultiplier != MIP_LEVEL_MULTIPLIER || header.numChannels == 0 || numLevels == 0) {
+        return false;
+    }
+    const uint64_t tableEnd = sizeof(PeakFileHeader) + static_cast<uint64_t>(numLevels) * sizeof(PeakFileLevel);
+    if (mapping->bytes < tableEnd) {
+        return false;
+    }
+    
+    std::vector<WaveformMipLevel> levels(numLevels);
+    for (uint32_t i = 0; i < numLevels; ++i) {
+        PeakFileLevel entry;
+        std::memcpy(&entry, mapping->data + sizeof(PeakFileHeader) + i * sizeof(PeakFileLevel), sizeof(entry));
+        const uint64_t count = static_cast<uint64_t>(entry.numPeaks) * header.numChannels;
+        if (entry.numPeaks < 0 || entry.offset % alignof(WaveformPeak) != 0 || entry.offset < tableEnd ||
+            entry.offset > mapping->bytes || count > (mapping->bytes - entry.offset) / sizeof(WaveformPeak)) {
+            return false;
+        }
+        levels[i].mapped = reinterpret_cast<const WaveformPeak*>(mapping->data + entry.offset);
+        levels[i].samplesPerPeak = entry.samplesPerPeak;
+        levels[i].numChannels = header.numChannels;
+        levels[i].numPeaks = entry.numPeaks;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_levels = std::move(levels);
+    m_mapping = std::move(mapping);
+    m_numChannels = header.numChannels;
+    m_sourceFrames = header.sourceFrames;
+    m_ready.store(true, std::memory_order_release);
+    return true;
+}
+
+bool WaveformCache::savePeakFile(const std::string& sourcePath) const {
+    SourceStamp stamp;
+    if (!stampSource(sourcePath, stamp)) {
+        Log::warning("WaveformCache: Cannot stat source for peak file: " + sourcePath);
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_ready.load(std::memory_order_acquire) || m_levels.empty()) {
+        return false;
+    }
+    
+    PeakFileHeader header{};
+    std::memcpy(header.magic, kPeakFileMagic, sizeof(kPeakFileMagic));
+    header.version = PEAK_FILE_VERSION;
+    header.byteOrder = kByteOrderMark;
+    header.sourceSize = stamp.size;
+    header.sourceModTime = stamp.modTime;
+    header.sourceFrames = m_sourceFrames;
+    header.numChannels = m_numChannels;
+    header.numLevels = static_cast<uint32_t>(m_levels.size());
+    header.baseSamplesPerPeak = m_levels[0].samplesPerPeak;
+    header.levelMultiplier = MIP_LEVEL_MULTIPLIER;
+    
+    std::vector<PeakFileLevel> table(m_levels.size());
+    uint64_t offset = sizeof(PeakFileHeader) + table.size() * sizeof(PeakFileLevel);
+    for (size_t i = 0; i < m_levels.size(); ++i) {
+        table[i].samplesPerPeak = m_levels[i].samplesPerPeak;
+        table[i].reserved = 0;
+        table[i].numPeaks = m_levels[i].numPeaks;
+        table[i].offset = offset;
+        offset += (m_levels[i].size() * sizeof(WaveformPeak) + 7) & ~static_cast<uint64_t>(7);
+    }
+    
+    const std::string peakPath = peakFilePath(sourcePath);
+    const fs::path target = makeUnicodePath(peakPath);
+    const fs::path temp = makeUnicodePath(peakPath + ".tmp");
+    std::error_code ec;
+    if (target.has_parent_path()) {
+        fs::create_directories(target.parent_path(), ec);
+    }
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            Log::warning("WaveformCache: Cannot write peak file: " + peakPath);
+            return false;
+        }
+        static const char padding[8] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()),
+                  static_cast<std::streamsize>(table.size() * sizeof(PeakFileLevel)));
+        for (const auto& level : m_levels) {
+            const size_t bytes = level.size() * sizeof(WaveformPeak);
+            out.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(bytes));
+            out.write(padding, static_cast<std::streamsize>(((bytes + 7) & ~size_t(7)) - bytes));
+        }
+        if (!out) {
+            Log::warning("WaveformCache: Failed writing peak file: " + peakPath);
+            out.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    fs::rename(temp, target, ec);
+    if (ec) {
+        Log::warning("WaveformCache: Cannot replace peak file " + peakPath + ": " + ec.message());
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
 const WaveformMipLevel* WaveformCache::getLevel(size_t levelIndex) const {
     std::lock_guard<std::mutex> lock(m_mutex);
     if (levelIndex < m_levels.size()) {
@@ -206,6 +723,7 @@ void WaveformCache::clear() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_ready.store(false, std::memory_order_release);
     m_levels.clear();
+    m_mapping.reset();
     m_numChannels = 0;
     m_sourceFrames = 0;
 }
@@ -232,52 +750,81 @@ struct WaveformCacheBuilder::Impl {
 WaveformCacheBuilder::WaveformCacheBuilder()
     : m_impl(std::make_unique<Impl>())
 {
+    // Construct the pool first so it is destroyed after any static builder:
+    // ~WaveformCacheBuilder waits for requests the pool has to run.
+    PeakWorkerPool::instance();
 }
 
 WaveformCacheBuilder::~WaveformCacheBuilder() {
     cancelAll();
 }
 
+namespace {
+
+/// Map the source's peak file, or run build and write one.
+std::shared_ptr<WaveformCache> loadOrBuild(const std::string& path, const WaveformCacheBuilder::BuildFunction& build) {
+    auto cache = std::make_shared<WaveformCache>();
+    if (!path.empty() && cache->loadPeakFile(path)) {
+        return cache;
+    }
+    if (!build || !build(*cache) || !cache->isReady()) {
+        return nullptr;
+    }
+    if (!path.empty()) {
+        cache->savePeakFile(path);
+    }
+    return cache;
+}
+
+/// Scan a ClipSource's decoded buffer.
+WaveformCacheBuilder::BuildFunction bufferBuild(std::shared_ptr<AudioBufferData> buffer) {
+    return [buffer](WaveformCache& cache) {
+        if (!buffer || !buffer->isValid()) {
+            Log::warning("WaveformCacheBuilder: Source not ready");
+            return false;
+        }
+        cache.buildFromBuffer(*buffer);
+        return true;
+    };
+}
+
+} // anonymous namespace
+
 void WaveformCacheBuilder::buildAsync(const ClipSource& source, CompletionCallback callback) {
-    if (!source.isReady()) {
+    if (!source.isReady() && source.getFilePath().empty()) {
         Log::warning("WaveformCacheBuilder: Source not ready");
         if (callback) callback(nullptr);
         return;
     }
     
-    m_impl->pendingCount.fetch_add(1);
-    
     // Capture buffer by shared_ptr for thread safety
-    auto buffer = source.getBuffer();
+    buildAsync(source.getFilePath(), bufferBuild(source.getBuffer()), std::move(callback));
+}
+
+void WaveformCacheBuilder::buildAsync(const std::string& sourcePath, BuildFunction build,
+                                      CompletionCallback callback) {
+    m_impl->pendingCount.fetch_add(1);
     auto* impl = m_impl.get();
     
-    std::thread([buffer, callback, impl]() {
+    PeakWorkerPool::instance().post([sourcePath, build = std::move(build), callback = std::move(callback), impl]() {
         if (impl->cancelFlag.load()) {
             impl->pendingCount.fetch_sub(1);
             if (callback) callback(nullptr);
             return;
         }
         
-        auto cache = std::make_shared<WaveformCache>();
-        cache->buildFromBuffer(*buffer);
+        auto cache = loadOrBuild(sourcePath, build);
         
         impl->pendingCount.fetch_sub(1);
         
         if (callback) {
             callback(cache);
         }
-    }).detach();
+    });
 }
 
 std::shared_ptr<WaveformCache> WaveformCacheBuilder::buildSync(const ClipSource& source) {
-    if (!source.isReady()) {
-        Log::warning("WaveformCacheBuilder: Source not ready");
-        return nullptr;
-    }
-    
-    auto cache = std::make_shared<WaveformCache>();
-    cache->buildFromBuffer(*source.getBuffer());
-    return cache;
+    return loadOrBuild(source.getFilePath(), bufferBuild(source.getBuffer()));
 }
 
 void WaveformCacheBuilder::cancelAll() {
@@ -295,5 +842,119 @@ size_t WaveformCacheBuilder::getPendingCount() const {
     return m_impl->pendingCount.load();
 }
 
+// =============================================================================
+// WaveformVertexCache Implementation
+// =============================================================================
+
+void WaveformVertexCache::setSource(std::shared_ptr<const WaveformCache> cache) {
+    if (cache == m_source) {
+        return;
+    }
+    m_source = std::move(cache);
+    clear();
+}
+
+SampleIndex WaveformVertexCache::bucketFor(double samplesPerPixel) {
+    SampleIndex bucket = 1;
+    while (static_cast<double>(bucket * 2) <= samplesPerPixel) {
+        bucket *= 2;
+    }
+    return bucket;
+}
+
+bool WaveformVertexCache::getColumns(SampleIndex startSample, SampleIndex endSample, uint32_t numPixels,
+                                     std::vector<WaveformPeak>& outColumns) {
+    outColumns.assign(numPixels, WaveformPeak());
+    if (!m_source || !m_source->isReady()) {
+        return false;
+    }
+    // A cache still growing (recording) changes its last tiles.
+    if (m_source->getSourceFrames() != m_sourceFrames) {
+        clear();
+        m_sourceFrames = m_source->getSourceFrames();
+    }
+    if (numPixels == 0 || endSample <= startSample) {
+        return true;
+    }
+    
+    const double samplesPerPixel = static_cast<double>(endSample - startSample) / numPixels;
+    const SampleIndex bucket = bucketFor(samplesPerPixel);
+    const SampleIndex numVertices = (m_sourceFrames + bucket - 1) / bucket;
+    
+    // Each pixel merges the 1-3 vertices its sample range touches.
+    const Tile* tile = nullptr;
+    SampleIndex tileIndex = -1;
+    for (uint32_t pixel = 0; pixel < numPixels; ++pixel) {
+        const double from = startSample + pixel * samplesPerPixel;
+        const double to = startSample + (pixel + 1) * samplesPerPixel;
+        const SampleIndex first = std::max<SampleIndex>(0, static_cast<SampleIndex>(std::floor(from / bucket)));
+        const SampleIndex last = std::min(numVertices, static_cast<SampleIndex>(std::ceil(to / bucket)));
+        
+        bool any = false;
+        WaveformPeak column;
+        for (SampleIndex v = first; v < last; ++v) {
+            if (v / TILE_VERTICES != tileIndex) {
+                tileIndex = v / TILE_VERTICES;
+                tile = &getTile(bucket, tileIndex);
+            }
+            const WaveformPeak& vertex = tile->vertices[static_cast<size_t>(v % TILE_VERTICES)];
+            if (any) {
+                column.merge(vertex);
+            } else {
+                column = vertex;
+                any = true;
+            }
+        }
+        outColumns[pixel] = column;
+    }
+    
+    evict();
+    return true;
+}
+
+const WaveformVertexCache::Tile& WaveformVertexCache::getTile(SampleIndex bucket, SampleIndex tileIndex) {
+    Tile& tile = m_tiles[TileKey(bucket, tileIndex)];
+    tile.lastUse = ++m_useCounter;
+    if (!tile.vertices.empty()) {
+        return tile;
+    }
+    
+    // One vertex per bucket samples; power-of-two buckets line up with the mip levels.
+    const SampleIndex start = tileIndex * TILE_VERTICES * bucket;
+    const SampleIndex end = start + TILE_VERTICES * bucket;
+    for (uint32_t ch = 0; ch < m_source->getNumChannels(); ++ch) {
+        m_source->getPeaksForRange(ch, start, end, TILE_VERTICES, ch == 0 ? tile.vertices : m_scratch);
+        if (ch > 0) {
+            for (uint32_t v = 0; v < TILE_VERTICES; ++v) {
+                tile.vertices[v].merge(m_scratch[v]);
+            }
+        }
+    }
+    tile.vertices.resize(TILE_VERTICES);
+    return tile;
+}
+
+void WaveformVertexCache::evict() {
+    while (m_tiles.size() > m_maxTiles) {
+        auto oldest = m_tiles.begin();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (it->second.lastUse < oldest->second.lastUse) {
+                oldest = it;
+            }
+        }
+        m_tiles.erase(oldest);
+    }
+}
+
+void WaveformVertexCache::setMaxTiles(size_t maxTiles) {
+    m_maxTiles = std::max<size_t>(maxTiles, 1);
+    evict();
+}
+
+void WaveformVertexCache::clear() {
+    m_tiles.clear();
+    m_sourceFrames = m_source ? m_source->getSourceFrames() : 0;
+}
+
 } // namespace Audio
 } // namespace Nomad
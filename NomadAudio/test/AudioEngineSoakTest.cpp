@@ -45,6 +45,7 @@ struct Options {
     uint32_t durationSeconds = 2 * 60 * 60; // 2 hours
     uint32_t commandHz = 500;
     uint32_t graphSwapHz = 10;
+    uint32_t renderThreads = 0;
     bool realtime = true;
 };
 
@@ -146,6 +147,7 @@ Options parseArgs(int argc, char** argv) {
         else if (a == "--duration-sec") nextU32(opt.durationSeconds);
         else if (a == "--cmd-hz") nextU32(opt.commandHz);
         else if (a == "--graph-hz") nextU32(opt.graphSwapHz);
+        else if (a == "--render-threads") nextU32(opt.renderThreads);
         else if (a == "--no-realtime") opt.realtime = false;
     }
     return opt;
@@ -164,12 +166,14 @@ int main(int argc, char** argv) {
               << " durationSec=" << opt.durationSeconds
               << " cmdHz=" << opt.commandHz
               << " graphHz=" << opt.graphSwapHz
+              << " renderThreads=" << opt.renderThreads
               << " realtime=" << (opt.realtime ? "yes" : "no")
               << "\n";
 
     AudioEngine engine;
     engine.setSampleRate(opt.sampleRate);
     engine.setBufferConfig(opt.bufferFrames, 2);
+    engine.setRenderThreadCount(opt.renderThreads);
 
     // Force SRC activity by using a mismatched source sample rate.
     auto source = makeSineBuffer(44100, opt.timelineSeconds, 997.0);
@@ -350,6 +354,22 @@ int main(int argc, char** argv) {
     std::cout << "driftSamples=" << driftSamples << "\n";
     std::cout << "rssStartMB=" << (rssStart / (1024.0 * 1024.0)) << "\n";
     std::cout << "rssMaxMB=" << (rssMax / (1024.0 * 1024.0)) << "\n";
+    std::cout << "parallelBlocks=" << engine.telemetry().getParallelRenderBlocks() << "\n";
+    std::cout << "tracksRendered=" << engine.telemetry().getTracksRendered()
+              << " tracksInGraph=" << engine.telemetry().getTracksInGraph() << "\n";
+
+    const RTWorkerPool& pool = engine.renderWorkerPool();
+    const uint64_t dispatchCycles = pool.getDispatchCycles();
+    if (pool.isRunning() && dispatchCycles > 0) {
+        for (uint32_t p = 0; p < pool.getParticipantCount(); ++p) {
+            const auto& st = pool.getStats(p);
+            const double util = static_cast<double>(st.busyCycles.load(std::memory_order_relaxed)) /
+                                static_cast<double>(dispatchCycles) * 100.0;
+            std::cout << "worker[" << p << "] tasks=" << st.tasksExecuted.load(std::memory_order_relaxed)
+                      << " stolen=" << st.tasksStolen.load(std::memory_order_relaxed)
+                      << " util=" << util << "%\n";
+        }
+    }
 
     // Pass/fail thresholds (tune as we collect baselines).
     const bool passXruns = (xruns == 0);
@@ -0,0 +1,349 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for incremental AudioGraphBuilder: per-track versions, reuse and rebuild time
+
+#include "AudioFileWriter.h"
+#include "AudioGraphBuilder.h"
+#include "AudioTelemetry.h"
+#include "PlaylistModel.h"
+#include "SamplePool.h"
+#include "TrackManager.h"
+#include "NomadLog.h"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kTracks = 100;
+constexpr uint32_t kFramesPerTrack = kRate * 10;   // 10 s stereo per track
+
+void fillTracks(TrackManager& manager) {
+    std::vector<float> audio(static_cast<size_t>(kFramesPerTrack) * 2);
+    for (uint32_t t = 0; t < kTracks; ++t) {
+        for (size_t i = 0; i < audio.size(); ++i) {
+            audio[i] = static_cast<float>(0.1 * std::sin(0.001 * (i + t)));
+        }
+        auto track = manager.addTrack("Track " + std::to_string(t + 1));
+        track->setAudioData(audio.data(), kFramesPerTrack, kRate, 2);
+        track->setStartPositionInTimeline(0.5 * t);
+    }
+}
+
+bool sameGraph(const AudioGraph& a, const AudioGraph& b) {
+    if (a.tracks.size() != b.tracks.size() || a.timelineEndSample != b.timelineEndSample ||
+        a.schedule.nodes.size() != b.schedule.nodes.size()) {
+        return false;
+    }
+    for (size_t t = 0; t < a.tracks.size(); ++t) {
+        const auto& x = a.tracks[t];
+        const auto& y = b.tracks[t];
+        if (x.trackId != y.trackId || x.trackIndex != y.trackIndex || x.volume != y.volume ||
+            x.pan != y.pan || x.mute != y.mute || x.solo != y.solo || x.clips.size() != y.clips.size()) {
+            return false;
+        }
+        for (size_t c = 0; c < x.clips.size(); ++c) {
+            const auto& p = x.clips[c];
+            const auto& q = y.clips[c];
+            if (p.startSample != q.startSample || p.endSample != q.endSample ||
+                p.sampleOffset != q.sampleOffset || p.totalFrames != q.totalFrames ||
+                p.sourceSampleRate != q.sourceSampleRate || p.buffer->data != q.buffer->data) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool matches(const AudioGraphBuilder::BuildStats& stats, uint32_t rebuilt, uint32_t patched, uint32_t reused) {
+    return stats.rebuilt == rebuilt && stats.patched == patched && stats.reused == reused;
+}
+
+std::string describe(const AudioGraphBuilder::BuildStats& stats) {
+    return std::to_string(stats.rebuilt) + " rebuilt, " + std::to_string(stats.patched) + " patched, " +
+           std::to_string(stats.reused) + " reused, " + std::to_string(stats.buildNs / 1000) + " us";
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testIncrementalBuilds() {
+    std::cout << "\n=== Test: Incremental builds ===\n";
+    TrackManager manager;
+    fillTracks(manager);
+    AudioGraphBuilder builder;
+    AudioTelemetry telemetry;
+
+    AudioGraph first = builder.build(manager, kRate, &telemetry);
+    const auto full = builder.lastStats();
+    recordTest("First build resolves every track", matches(full, kTracks, 0, 0), describe(full));
+
+    AudioGraph second = builder.build(manager, kRate, &telemetry);
+    const auto unchanged = builder.lastStats();
+    recordTest("Unchanged session reuses every track", matches(unchanged, 0, 0, kTracks), describe(unchanged));
+    recordTest("Reused tracks share the previous buffers",
+               second.tracks[7].clips[0].buffer == first.tracks[7].clips[0].buffer);
+    recordTest("Reuse is faster than a full build", unchanged.buildNs < full.buildNs,
+               std::to_string(full.buildNs / 1000) + " us -> " + std::to_string(unchanged.buildNs / 1000) + " us");
+
+    manager.getTrack(3)->setVolume(0.25f);
+    AudioGraph fader = builder.build(manager, kRate, &telemetry);
+    recordTest("Fader change patches one track", matches(builder.lastStats(), 0, 1, kTracks - 1),
+               describe(builder.lastStats()));
+    recordTest("Patched track carries the new volume and keeps its buffer",
+               fader.tracks[3].volume == 0.25f &&
+               fader.tracks[3].clips[0].buffer == first.tracks[3].clips[0].buffer);
+
+    manager.getTrack(5)->setStartPositionInTimeline(42.0);
+    manager.getTrack(6)->setTrimStart(1.0);
+    AudioGraph nudge = builder.build(manager, kRate, &telemetry);
+    recordTest("Clip nudge and trim patch two tracks", matches(builder.lastStats(), 0, 2, kTracks - 2),
+               describe(builder.lastStats()));
+    recordTest("Nudged clip moved", nudge.tracks[5].clips[0].startSample == 42ull * kRate);
+
+    std::vector<float> replacement(static_cast<size_t>(kRate) * 2, 0.5f);
+    manager.getTrack(9)->setAudioData(replacement.data(), kRate, kRate, 2);
+    AudioGraph replaced = builder.build(manager, kRate, &telemetry);
+    recordTest("New audio rebuilds only that track", matches(builder.lastStats(), 1, 0, kTracks - 1),
+               describe(builder.lastStats()));
+    recordTest("Rebuilt track has the new audio",
+               replaced.tracks[9].clips[0].totalFrames == kRate && replaced.tracks[9].clips[0].buffer->data[0] == 0.5f);
+
+    recordTest("Incremental graph matches a full rebuild",
+               sameGraph(replaced, AudioGraphBuilder::buildFromTrackManager(manager, kRate)));
+
+    manager.removeTrack(0);
+    AudioGraph removed = builder.build(manager, kRate, &telemetry);
+    recordTest("Removing a track keeps the others", matches(builder.lastStats(), 0, 0, kTracks - 1),
+               describe(builder.lastStats()));
+    recordTest("Reused tracks pick up their new index",
+               sameGraph(removed, AudioGraphBuilder::buildFromTrackManager(manager, kRate)));
+
+    builder.build(manager, 44100.0, &telemetry);
+    recordTest("Output rate change rebuilds everything", builder.lastStats().rebuilt == kTracks - 1);
+
+    recordTest("Build time reaches telemetry",
+               telemetry.getGraphBuilds() == 7 && telemetry.getLastGraphTracksRebuilt() == kTracks - 1 &&
+               telemetry.getMaxGraphBuildNs() >= telemetry.getLastGraphBuildNs(),
+               "max " + std::to_string(telemetry.getMaxGraphBuildNs() / 1000) + " us");
+}
+
+void testVersions() {
+    std::cout << "\n=== Test: Track version counters ===\n";
+    TrackManager manager;
+    auto a = manager.addTrack("A");
+    auto b = manager.addTrack("B");
+    recordTest("Fresh tracks never share a version", a->getGraphVersion() != b->getGraphVersion());
+
+    const uint64_t graph = a->getGraphVersion();
+    const uint64_t data = a->getAudioDataVersion();
+    a->setPan(0.5f);
+    recordTest("Parameter change bumps only the graph version",
+               a->getGraphVersion() != graph && a->getAudioDataVersion() == data);
+    const uint64_t afterPan = a->getGraphVersion();
+    a->setPan(0.5f);
+    recordTest("Setting the same value is not a change", a->getGraphVersion() == afterPan);
+
+    std::vector<float> audio(256, 0.1f);
+    a->setAudioData(audio.data(), 128, kRate, 2);
+    recordTest("New audio bumps both versions",
+               a->getAudioDataVersion() != data && a->getGraphVersion() == a->getAudioDataVersion());
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+void testPlaylistSnapshot() {
+    std::cout << "\n=== Test: Playlist snapshot ===\n";
+
+    SourceManager sources;
+    auto makeSource = [&](uint32_t channels) {
+        auto data = std::make_shared<AudioBufferData>();
+        data->sampleRate = kRate;
+        data->numChannels = channels;
+        data->numFrames = kRate;
+        data->interleavedData.resize(static_cast<size_t>(kRate) * channels);
+        for (size_t i = 0; i < data->interleavedData.size(); ++i) {
+            data->interleavedData[i] = static_cast<float>(i % channels + 1) * 0.1f;
+        }
+        const ClipSourceID id = sources.createSource("Source " + std::to_string(channels));
+        sources.getSource(id)->setBuffer(data);
+        return id;
+    };
+    const ClipSourceID mono = makeSource(1);
+    const ClipSourceID stereo = makeSource(2);
+
+    // Project at 48 kHz, rendered at 96 kHz: every position doubles.
+    PlaylistModel playlist;
+    playlist.setProjectSampleRate(kRate);
+    const PlaylistLaneID first = playlist.createLane("Lane 1");
+    const PlaylistLaneID second = playlist.createLane("Lane 2");
+    playlist.createLane("Empty");
+    playlist.addClipFromSource(first, stereo, 0, 24000);
+    playlist.addClipFromSource(first, mono, 12000, 24000, 100);
+    PlaylistClip muted(stereo);
+    muted.startTime = 96000;
+    muted.length = 1000;
+    muted.muted = true;
+    playlist.addClip(first, muted);
+    PlaylistClip faded(stereo);
+    faded.startTime = 48000;
+    faded.length = 48000;
+    faded.gainLinear = 0.5f;
+    faded.pan = -0.25f;
+    faded.playbackRate = 0.5;
+    faded.fadeInLength = 480;
+    faded.fadeOutLength = 960;
+    faded.flags = ClipFlags::Reversed | ClipFlags::Looping;
+    faded.loopLength = 4800;
+    playlist.addClip(second, faded);
+    playlist.getLane(second)->volume = 0.75f;
+
+    const auto snapshot = playlist.buildRuntimeSnapshot(sources);
+    AudioGraphBuilder builder;
+    const AudioGraph graph = builder.build(*snapshot, sources, kRate * 2.0);
+
+    recordTest("One track per lane", graph.tracks.size() == 3);
+    if (graph.tracks.size() != 3) {
+        return;
+    }
+    const auto& lane1 = graph.tracks[0].clips;
+    const auto& lane2 = graph.tracks[1].clips;
+    recordTest("Muted clips are skipped", lane1.size() == 2 && lane2.size() == 1 && graph.tracks[2].clips.empty());
+    if (lane1.size() != 2 || lane2.size() != 1) {
+        return;
+    }
+    recordTest("Positions scale to the output rate",
+               lane1[0].startSample == 0 && lane1[0].endSample == 48000 &&
+               lane1[1].startSample == 24000 && lane1[1].endSample == 72000 && lane1[1].sampleOffset == 100 &&
+               graph.timelineEndSample == 192000);
+    recordTest("Stereo sources are shared",
+               lane1[0].sourceData == sources.getSource(stereo)->getBuffer() &&
+               lane1[0].audioData == lane1[0].sourceData->interleavedData.data());
+    recordTest("Mono sources are converted to stereo",
+               lane1[1].sourceData && lane1[1].sourceData->numChannels == 2 &&
+               lane1[1].audioData[0] == 0.1f && lane1[1].audioData[1] == 0.1f);
+    recordTest("Clip properties carry over",
+               lane2[0].gain == 0.5f && lane2[0].pan == -0.25f && lane2[0].playbackRate == 0.5 &&
+               lane2[0].fadeInSamples == 960 && lane2[0].fadeOutSamples == 1920 &&
+               lane2[0].reversed && lane2[0].loopFrames == 4800 && !lane1[0].reversed && lane1[0].loopFrames == 0 &&
+               lane2[0].readRate(kRate * 2.0) == kRate * 0.5 && graph.tracks[1].volume == 0.75f);
+
+    // A rebuild reuses the cached conversion while the source is unchanged.
+    const AudioGraph again = builder.build(*snapshot, sources, kRate * 2.0);
+    recordTest("Stereo conversions are cached",
+               again.tracks.size() == 3 && again.tracks[0].clips.size() == 2 &&
+               again.tracks[0].clips[1].sourceData == lane1[1].sourceData);
+}
+
+void testAsyncLoadAdoption() {
+    std::cout << "\n=== Test: Async loads are adopted by the polling thread ===\n";
+    const std::string path = (std::filesystem::temp_directory_path() / "nomad_builder_async.wav").string();
+    {
+        std::vector<float> audio(static_cast<size_t>(kRate) * 2);
+        for (size_t i = 0; i < audio.size(); ++i) {
+            audio[i] = static_cast<float>(0.25 * std::sin(0.01 * static_cast<double>(i / 2)));
+        }
+        auto writer = AudioFileWriter::create(AudioFileFormat::Wav);
+        writer->open(path, kRate, 2, AudioSampleFormat::Float32, DitheringMode::None);
+        writer->write(audio.data(), kRate);
+        writer->close();
+    }
+
+    TrackManager manager;
+    auto track = manager.addTrack("Async");
+    const uint64_t versionBefore = track->getAudioDataVersion();
+    track->loadAudioFileAsync(path);
+    SamplePool::getInstance().waitForLoads();
+
+    // The decode has finished, but nothing polled: the track must be untouched.
+    const AudioGraph pending = AudioGraphBuilder::buildFromTrackManager(manager, kRate);
+    recordTest("Decode threads do not write the track",
+               track->isLoading() && !track->hasAudioData() && track->getAudioDataVersion() == versionBefore &&
+                   pending.tracks.size() == 1 && pending.tracks[0].clips.empty());
+
+    manager.consumeGraphDirty();
+    const size_t adopted = manager.pollAsyncLoads();
+    const AudioGraph graph = AudioGraphBuilder::buildFromTrackManager(manager, kRate);
+    recordTest("pollAsyncLoads adopts the finished load",
+               adopted == 1 && !track->isLoading() && track->hasAudioData() &&
+                   std::abs(track->getDuration() - 1.0) < 1e-9 && manager.consumeGraphDirty() &&
+                   graph.tracks.size() == 1 && graph.tracks[0].clips.size() == 1 && manager.pollAsyncLoads() == 0);
+
+    track.reset();
+    manager.clearAllTracks();
+    std::filesystem::remove(path);
+}
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Graph Builder Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testIncrementalBuilds();
+    testVersions();
+    testPlaylistSnapshot();
+    testAsyncLoadAdoption();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
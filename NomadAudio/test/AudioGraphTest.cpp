@@ -0,0 +1,544 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for AudioGraph routing: schedule compilation, buses, sends and publication
+
+#include "AudioEngine.h"
+#include "AudioGraph.h"
+#include "AudioGraphCompiler.h"
+#include "SamplePool.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kFrames = 256;
+
+std::shared_ptr<AudioBuffer> makeDcBuffer(float value, uint32_t frames) {
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = kRate;
+    buffer->numFrames = frames;
+    buffer->data.assign(static_cast<size_t>(frames) * 2, value);
+    buffer->ready.store(true, std::memory_order_release);
+    return buffer;
+}
+
+TrackRenderState makeTrack(uint32_t index, const std::shared_ptr<AudioBuffer>& src) {
+    TrackRenderState tr;
+    tr.trackId = index + 1;
+    tr.trackIndex = index;
+    ClipRenderState clip;
+    clip.buffer = src;
+    clip.audioData = src->data.data();
+    clip.startSample = 0;
+    clip.endSample = src->numFrames;
+    clip.totalFrames = src->numFrames;
+    clip.sourceSampleRate = kRate;
+    tr.clips.push_back(clip);
+    return tr;
+}
+
+BusRenderState makeBus(uint32_t id, uint32_t output = kMasterBusIndex) {
+    BusRenderState bus;
+    bus.busId = id;
+    bus.outputBus = output;
+    return bus;
+}
+
+std::vector<float> render(const AudioGraph& graph, uint32_t blocks, uint32_t renderThreads = 0) {
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    engine.setRenderThreadCount(renderThreads);
+    engine.setParallelRenderMinTracks(2);
+    engine.setGraph(graph);
+
+    AudioQueueCommand cmd;
+    cmd.type = AudioQueueCommandType::SetTransportState;
+    cmd.value1 = 1.0f;
+    cmd.samplePos = 0;
+    engine.commandQueue().push(cmd);
+
+    std::vector<float> out(static_cast<size_t>(blocks) * kFrames * 2);
+    for (uint32_t b = 0; b < blocks; ++b) {
+        engine.processBlock(out.data() + static_cast<size_t>(b) * kFrames * 2, nullptr, kFrames, 0.0);
+    }
+    return out;
+}
+
+// Left-channel sample in the steady state (past transport and clip edge fades).
+float steadyLeft(const std::vector<float>& out) {
+    return out[static_cast<size_t>(kFrames) * 2 * 8];
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testScheduleTopology() {
+    std::cout << "\n=== Test: Schedule topology ===\n";
+
+    auto src = makeDcBuffer(0.1f, kRate);
+    AudioGraph graph;
+    for (uint32_t t = 0; t < 4; ++t) {
+        graph.tracks.push_back(makeTrack(t, src));
+    }
+    graph.buses.push_back(makeBus(100, 1));   // 0: group → bus 1
+    graph.buses.push_back(makeBus(101));      // 1: submix → master
+    graph.buses.push_back(makeBus(102));      // 2: return → master
+    graph.tracks[0].outputBus = 0;
+    graph.tracks[1].outputBus = 0;
+    graph.tracks[2].sends.push_back({2, 0.5f, false});
+    graph.tracks[3].sends.push_back({2, 1.0f, true});
+
+    const bool clean = AudioGraphCompiler::compile(graph);
+    const RenderSchedule& s = graph.schedule;
+
+    recordTest("Valid routing compiles cleanly", clean && s.compiled);
+    recordTest("Three levels (tracks, group+return, submix)", s.levelCount() == 3,
+               "levels=" + std::to_string(s.levelCount()));
+
+    bool ordered = true;
+    for (size_t i = 1; i < s.nodes.size(); ++i) {
+        ordered = ordered && s.nodes[i - 1].level <= s.nodes[i].level;
+    }
+    for (const auto& node : s.nodes) {
+        for (uint32_t e = 0; e < node.inputCount; ++e) {
+            const RenderEdge& edge = s.inputs[node.firstInput + e];
+            ordered = ordered && s.nodes[edge.sourceNode].level < node.level;
+        }
+    }
+    recordTest("Every input comes from a lower level", ordered);
+
+    recordTest("Pre-fader send allocates one extra buffer", s.bufferCount == 8,
+               "bufferCount=" + std::to_string(s.bufferCount));
+    recordTest("Master inputs: two tracks + two buses", s.masterInputs.size() == 4,
+               "masterInputs=" + std::to_string(s.masterInputs.size()));
+}
+
+void testCycleRepair() {
+    std::cout << "\n=== Test: Cycle and bad-target repair ===\n";
+
+    auto src = makeDcBuffer(0.1f, kRate);
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(0, src));
+    graph.tracks[0].outputBus = 0;
+    graph.buses.push_back(makeBus(1, 1));
+    graph.buses.push_back(makeBus(2, 0));   // 0 ↔ 1 cycle
+    graph.buses.push_back(makeBus(3, 42));  // Out-of-range target
+
+    const bool clean = AudioGraphCompiler::compile(graph);
+    const RenderSchedule& s = graph.schedule;
+    recordTest("Repaired routing reports not clean", !clean);
+    recordTest("All nodes still scheduled", s.nodes.size() == 4);
+
+    const auto out = render(graph, 16);
+    recordTest("Repaired graph renders audio", std::abs(steadyLeft(out)) > 1e-4f);
+}
+
+void testBusGain() {
+    std::cout << "\n=== Test: Track → bus → master ===\n";
+
+    auto src = makeDcBuffer(0.25f, kRate);
+    AudioGraph direct;
+    direct.tracks.push_back(makeTrack(0, src));
+
+    AudioGraph grouped = direct;
+    grouped.buses.push_back(makeBus(1));
+    grouped.buses[0].volume = 0.5f;
+    grouped.tracks[0].outputBus = 0;
+
+    const float a = steadyLeft(render(direct, 16));
+    const float b = steadyLeft(render(grouped, 16));
+    // Centre pan law on the bus contributes cos(pi/4).
+    const float expected = a * 0.5f * static_cast<float>(std::cos(3.14159265358979323846 * 0.25));
+    recordTest("Bus applies its fader and pan", std::abs(b - expected) < 1e-6f,
+               "direct=" + std::to_string(a) + " bus=" + std::to_string(b));
+
+    grouped.buses[0].mute = true;
+    recordTest("Muted bus silences its inputs", steadyLeft(render(grouped, 16)) == 0.0f);
+}
+
+void testSends() {
+    std::cout << "\n=== Test: Pre/post-fader sends ===\n";
+
+    auto src = makeDcBuffer(0.25f, kRate);
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(0, src));
+    graph.tracks[0].volume = 0.0f;           // Fader down: main output silent
+    graph.buses.push_back(makeBus(1));
+
+    graph.tracks[0].sends = {{0, 1.0f, false}};
+    recordTest("Post-fader send follows the fader", steadyLeft(render(graph, 16)) == 0.0f);
+
+    graph.tracks[0].sends = {{0, 1.0f, true}};
+    recordTest("Pre-fader send ignores the fader", std::abs(steadyLeft(render(graph, 16))) > 1e-4f);
+}
+
+void testParallelLevels() {
+    std::cout << "\n=== Test: Parallel levels match serial ===\n";
+
+    auto a = makeDcBuffer(0.05f, kRate);
+    auto b = makeDcBuffer(-0.03f, kRate);
+    AudioGraph graph;
+    for (uint32_t t = 0; t < 24; ++t) {
+        graph.tracks.push_back(makeTrack(t, (t & 1) ? a : b));
+        graph.tracks.back().pan = -0.9f + 0.075f * static_cast<float>(t);
+        graph.tracks.back().outputBus = t % 4;
+        graph.tracks.back().sends.push_back({4, 0.3f, (t % 3) == 0});
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        graph.buses.push_back(makeBus(i, 5));
+        graph.buses.back().volume = 0.6f + 0.1f * static_cast<float>(i);
+    }
+    graph.buses.push_back(makeBus(4));     // Return
+    graph.buses.push_back(makeBus(5));     // Submix of the four groups
+
+    const auto serial = render(graph, 64, 0);
+    const auto parallel = render(graph, 64, 3);
+    recordTest("Parallel bus graph is bit-identical to serial",
+               std::memcmp(serial.data(), parallel.data(), serial.size() * sizeof(float)) == 0);
+}
+
+void testLargeGraphs() {
+    std::cout << "\n=== Test: Graphs past the initial render capacity ===\n";
+
+    auto src = makeDcBuffer(0.001f, kRate);
+    AudioGraph single;
+    single.tracks.push_back(makeTrack(0, src));
+    const float one = steadyLeft(render(single, 16));
+
+    // 320 tracks feeding 40 groups: well past the initial 64-track / 32-bus / 128-slot sizing.
+    AudioGraph large;
+    for (uint32_t t = 0; t < 320; ++t) {
+        large.tracks.push_back(makeTrack(t, src));
+        large.tracks.back().outputBus = t % 40;
+    }
+    for (uint32_t b = 0; b < 40; ++b) {
+        large.buses.push_back(makeBus(b));
+    }
+    AudioGraph flat = large;
+    flat.buses.clear();
+    for (auto& track : flat.tracks) {
+        track.outputBus = kMasterBusIndex;
+    }
+
+    const float sum = steadyLeft(render(flat, 16));
+    recordTest("320 tracks are all mixed", std::abs(sum - 320.0f * one) < 1e-4f,
+               "one=" + std::to_string(one) + " sum=" + std::to_string(sum));
+
+    const auto serial = render(large, 32, 0);
+    const auto parallel = render(large, 32, 3);
+    recordTest("320 tracks / 40 buses render", std::abs(steadyLeft(serial)) > 1e-4f);
+    recordTest("Large graph parallel is bit-identical to serial",
+               std::memcmp(serial.data(), parallel.data(), serial.size() * sizeof(float)) == 0);
+
+    // Grow while running: the engine swaps in bigger resources between blocks.
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    engine.setGraph(single);
+    AudioQueueCommand cmd;
+    cmd.type = AudioQueueCommandType::SetTransportState;
+    cmd.value1 = 1.0f;
+    cmd.samplePos = 0;
+    engine.commandQueue().push(cmd);
+
+    std::vector<float> block(static_cast<size_t>(kFrames) * 2);
+    for (int b = 0; b < 8; ++b) {
+        engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+    }
+    engine.setGraph(flat);
+    for (int b = 0; b < 4; ++b) {
+        engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+    }
+    recordTest("Growing mid-stream picks up every track",
+               std::abs(block[0] - sum) < 1e-4f && engine.telemetry().getOverruns() == 0,
+               "out=" + std::to_string(block[0]));
+}
+
+void testClipActivity() {
+    std::cout << "\n=== Test: Active-clip index ===\n";
+
+    auto src = makeDcBuffer(0.1f, kRate);
+    TrackRenderState track = makeTrack(0, src);
+    const uint64_t spans[][2] = {{5000, 6000}, {50, 1000}, {0, 100}, {200, 300}};
+    track.clips.clear();
+    for (const auto& span : spans) {
+        ClipRenderState clip;
+        clip.startSample = span[0];
+        clip.endSample = span[1];
+        track.clips.push_back(clip);
+    }
+    AudioGraphCompiler::indexClips(track);
+
+    auto overlapping = [&track](uint64_t start, uint64_t end) {
+        std::string found;
+        const auto range = track.activeClips(start, end);
+        for (uint32_t c = range.first; c < range.last; ++c) {
+            if (track.clips[c].endSample > start) {
+                found += std::to_string(track.clips[c].startSample) + ",";
+            }
+        }
+        return found;
+    };
+    recordTest("Index finds a long clip spanning the block", overlapping(400, 500) == "50,");
+    recordTest("Index finds every overlapping clip", overlapping(90, 250) == "0,50,200,");
+    recordTest("Gap between clips is empty", track.activeClips(1000, 2000).empty());
+    recordTest("Past the last clip is empty", track.activeClips(6000, 7000).empty());
+
+    // 100 tracks, only three with audio at the start of the timeline.
+    AudioGraph sparse;
+    AudioGraph dense;
+    for (uint32_t t = 0; t < 100; ++t) {
+        sparse.tracks.push_back(makeTrack(t, src));
+        if (t % 40 == 0) {
+            dense.tracks.push_back(sparse.tracks.back());
+        } else {
+            sparse.tracks.back().clips[0].startSample = kRate * 60;
+            sparse.tracks.back().clips[0].endSample = kRate * 61;
+        }
+    }
+
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    engine.setGraph(sparse);
+    AudioQueueCommand cmd;
+    cmd.type = AudioQueueCommandType::SetTransportState;
+    cmd.value1 = 1.0f;
+    cmd.samplePos = 0;
+    engine.commandQueue().push(cmd);
+    std::vector<float> out(static_cast<size_t>(16) * kFrames * 2);
+    for (uint32_t b = 0; b < 16; ++b) {
+        engine.processBlock(out.data() + static_cast<size_t>(b) * kFrames * 2, nullptr, kFrames, 0.0);
+    }
+
+    const auto& tel = engine.telemetry();
+    recordTest("Only tracks with audio are rendered",
+               tel.getLastTracksRendered() == 3 && tel.getLastTracksInGraph() == 100,
+               std::to_string(tel.getLastTracksRendered()) + "/" + std::to_string(tel.getLastTracksInGraph()));
+    const auto reference = render(dense, 16);
+    recordTest("Skipping idle tracks is bit-identical",
+               std::memcmp(out.data(), reference.data(), out.size() * sizeof(float)) == 0);
+}
+
+void testGraphPublication() {
+    std::cout << "\n=== Test: Graph publication and reclamation ===\n";
+
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    std::vector<float> out(static_cast<size_t>(kFrames) * 2);
+
+    // The audio thread pins the graph it renders; replacing it must not free it.
+    std::weak_ptr<AudioBuffer> firstBuffer;
+    {
+        AudioGraph first;
+        auto src = makeDcBuffer(0.1f, kRate);
+        firstBuffer = src;
+        first.tracks.push_back(makeTrack(0, src));
+        engine.setGraph(std::move(first));
+    }
+    engine.processBlock(out.data(), nullptr, kFrames, 0.0);
+
+    AudioGraph second;
+    second.tracks.push_back(makeTrack(0, makeDcBuffer(0.2f, kRate)));
+    engine.setGraph(second);
+    recordTest("Graph in use by the audio thread survives a publish",
+               !firstBuffer.expired() && engine.engineState().retiredCount() == 1);
+
+    engine.collectRetiredGraphs();
+    recordTest("Still pinned until the audio thread moves on", !firstBuffer.expired());
+
+    engine.processBlock(out.data(), nullptr, kFrames, 0.0);
+    recordTest("Audio thread never frees the replaced graph", !firstBuffer.expired());
+    engine.collectRetiredGraphs();
+    recordTest("Freed off the audio thread once unpinned",
+               firstBuffer.expired() && engine.engineState().retiredCount() == 0);
+
+    // Back-to-back publishes while the audio thread keeps rendering.
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> blocks{0};
+    std::thread audio([&] {
+        std::vector<float> buffer(static_cast<size_t>(kFrames) * 2);
+        while (!stop.load(std::memory_order_relaxed)) {
+            engine.processBlock(buffer.data(), nullptr, kFrames, 0.0);
+            blocks.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    size_t maxRetired = 0;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        AudioGraph next;
+        auto src = makeDcBuffer(0.01f * (i % 50), kFrames * 4);
+        for (uint32_t t = 0; t < 8; ++t) {
+            next.tracks.push_back(makeTrack(t, src));
+        }
+        engine.setGraph(std::move(next));
+        maxRetired = std::max(maxRetired, engine.engineState().retiredCount());
+    }
+    stop.store(true);
+    audio.join();
+    engine.processBlock(out.data(), nullptr, kFrames, 0.0);   // Move off a graph retired by the last publish
+    engine.collectRetiredGraphs();
+    recordTest("Rapid republishing keeps at most one graph retired",
+               maxRetired <= 1 && engine.engineState().retiredCount() == 0,
+               std::to_string(blocks.load()) + " blocks rendered during 2000 publishes");
+}
+
+// =============================================================================
+void testMultiClipLanes() {
+    std::cout << "\n=== Test: Multi-clip lanes ===\n";
+
+    auto quiet = makeDcBuffer(0.1f, kRate);
+    auto loud = makeDcBuffer(0.2f, kRate);
+    constexpr uint32_t kBlocks = 32;
+    auto clipOf = [](const std::shared_ptr<AudioBuffer>& src, uint64_t start, uint64_t end) {
+        ClipRenderState clip = makeTrack(0, src).clips[0];
+        clip.startSample = start;
+        clip.endSample = end;
+        return clip;
+    };
+    auto maxDiff = [](const std::vector<float>& a, const std::vector<float>& b) {
+        float diff = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) diff = std::max(diff, std::abs(a[i] - b[i]));
+        return diff;
+    };
+
+    // Overlapping clips on one lane sum like the same clips on two tracks.
+    AudioGraph lane;
+    lane.tracks.push_back(makeTrack(0, quiet));
+    lane.tracks[0].clips = {clipOf(quiet, 0, 3000), clipOf(loud, 1000, 5000), clipOf(quiet, 4500, 8000)};
+    AudioGraph split;
+    split.tracks.push_back(makeTrack(0, quiet));
+    split.tracks[0].clips = {clipOf(quiet, 0, 3000), clipOf(quiet, 4500, 8000)};
+    split.tracks.push_back(makeTrack(1, loud));
+    split.tracks[1].clips = {clipOf(loud, 1000, 5000)};
+    const auto laneOut = render(lane, kBlocks);
+    const auto splitOut = render(split, kBlocks);
+    recordTest("Overlapping clips on a lane sum", maxDiff(laneOut, splitOut) < 1e-6f,
+               "max diff " + std::to_string(maxDiff(laneOut, splitOut)));
+
+    AudioGraph plain;
+    plain.tracks.push_back(makeTrack(0, quiet));
+    const auto plainOut = render(plain, kBlocks);
+    const size_t probe = 2000 * 2;   // Past the transport and edge fades
+
+    AudioGraph faded = plain;
+    faded.tracks[0].clips[0].fadeInSamples = 4000;
+    faded.tracks[0].clips[0].fadeOutSamples = 2000;
+    faded.tracks[0].clips[0].endSample = 7000;
+    const auto fadedOut = render(faded, kBlocks);
+    recordTest("Clip fade-in ramps linearly",
+               std::abs(fadedOut[probe] / plainOut[probe] - 0.5f) < 1e-4f,
+               std::to_string(fadedOut[probe] / plainOut[probe]));
+    recordTest("Clip fade-out ramps linearly",
+               std::abs(fadedOut[6500 * 2] / plainOut[6500 * 2] - 0.25f) < 1e-4f,
+               std::to_string(fadedOut[6500 * 2] / plainOut[6500 * 2]));
+
+    AudioGraph panned = plain;
+    panned.tracks[0].clips[0].pan = 0.5f;
+    panned.tracks[0].clips[0].gain = 2.0f;
+    const auto pannedOut = render(panned, kBlocks);
+    recordTest("Clip pan and gain",
+               std::abs(pannedOut[probe] / plainOut[probe] - 1.0f) < 1e-4f &&
+               std::abs(pannedOut[probe + 1] / plainOut[probe + 1] - 2.0f) < 1e-4f);
+
+    // A ramp played at double speed reaches twice as far.
+    auto ramp = makeDcBuffer(0.0f, kRate);
+    for (uint32_t i = 0; i < kRate; ++i) {
+        ramp->data[i * 2] = ramp->data[i * 2 + 1] = static_cast<float>(i) / kRate;
+    }
+    AudioGraph normal;
+    normal.tracks.push_back(makeTrack(0, ramp));
+    AudioGraph doubled = normal;
+    doubled.tracks[0].clips[0].playbackRate = 2.0;
+    const auto normalOut = render(normal, kBlocks);
+    const auto doubledOut = render(doubled, kBlocks);
+    recordTest("Playback rate scales the read position",
+               std::abs(doubledOut[probe] - normalOut[probe * 2]) < 1e-4f,
+               std::to_string(doubledOut[probe]) + " vs " + std::to_string(normalOut[probe * 2]));
+}
+
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad AudioGraph Routing Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testScheduleTopology();
+    testCycleRepair();
+    testBusGain();
+    testSends();
+    testParallelLevels();
+    testLargeGraphs();
+    testClipActivity();
+    testMultiClipLanes();
+    testGraphPublication();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
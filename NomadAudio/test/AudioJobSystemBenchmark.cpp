@@ -0,0 +1,256 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Dispatch latency microbenchmark: AudioJobSystem vs the previous mutex/condvar AudioThreadPool
+
+#include "AudioJobSystem.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// =============================================================================
+// Reference: the pool TrackManager used before AudioJobSystem (std::function
+// queue, one mutex, condvar completion wait). The only change is notifying the
+// completion condvar under the lock, which the original could miss.
+// =============================================================================
+class LegacyAudioThreadPool {
+public:
+    explicit LegacyAudioThreadPool(size_t numThreads) {
+        for (size_t i = 0; i < numThreads; ++i) {
+            m_workers.emplace_back([this] { workerThread(); });
+        }
+    }
+
+    ~LegacyAudioThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (std::thread& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    void enqueue(std::function<void()> task) {
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_tasks.push(std::move(task));
+            m_activeTasks.fetch_add(1);
+        }
+        m_condition.notify_one();
+    }
+
+    void waitForCompletion() {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_completionCondition.wait(lock, [this] {
+            return m_tasks.empty() && m_activeTasks.load() == 0;
+        });
+    }
+
+private:
+    void workerThread() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_condition.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_stop && m_tasks.empty()) {
+                    return;
+                }
+                if (!m_tasks.empty()) {
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+            }
+            if (task) {
+                task();
+                size_t remaining = m_activeTasks.fetch_sub(1) - 1;
+                if (remaining == 0) {
+                    // Notify under the lock so the waiter cannot miss the wakeup
+                    std::lock_guard<std::mutex> lock(m_queueMutex);
+                    m_completionCondition.notify_all();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_queueMutex;
+    std::condition_variable m_condition;
+    std::condition_variable m_completionCondition;
+    bool m_stop{false};
+    std::atomic<size_t> m_activeTasks{0};
+};
+
+// =============================================================================
+// Workload: a light per-track gain pass over a stereo block
+// =============================================================================
+struct TrackWork {
+    std::vector<std::vector<float>> buffers;
+    uint32_t frames{256};
+};
+
+inline void processTrack(TrackWork& work, uint32_t index) {
+    float* data = work.buffers[index].data();
+    const float gain = 0.999f;
+    for (uint32_t i = 0; i < work.frames * 2; ++i) {
+        data[i] = data[i] * gain + 1e-6f;
+    }
+}
+
+void processTrackJob(void* context, uint32_t index) {
+    processTrack(*static_cast<TrackWork*>(context), index);
+}
+
+void countJob(void* context, uint32_t index) {
+    static_cast<std::atomic<uint32_t>*>(context)[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+struct LatencyStats {
+    double avgUs{0.0};
+    double p99Us{0.0};
+    double maxUs{0.0};
+};
+
+LatencyStats summarize(std::vector<double>& samples) {
+    LatencyStats s;
+    if (samples.empty()) {
+        return s;
+    }
+    double sum = 0.0;
+    for (double v : samples) sum += v;
+    s.avgUs = sum / static_cast<double>(samples.size());
+    std::sort(samples.begin(), samples.end());
+    s.p99Us = samples[static_cast<size_t>(static_cast<double>(samples.size() - 1) * 0.99)];
+    s.maxUs = samples.back();
+    return s;
+}
+
+template <typename BlockFn>
+LatencyStats measure(int iterations, BlockFn&& block) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(iterations));
+    // Warm-up
+    for (int i = 0; i < iterations / 10; ++i) {
+        block();
+    }
+    for (int i = 0; i < iterations; ++i) {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        block();
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    return summarize(samples);
+}
+
+void printRow(const char* name, uint32_t tracks, const LatencyStats& s) {
+    std::cout << "  " << std::left << std::setw(16) << name
+              << std::right << std::setw(6) << tracks
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << s.avgUs
+              << std::setw(12) << s.p99Us
+              << std::setw(12) << s.maxUs << "\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    int iterations = 5000;
+    size_t threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--iterations" && i + 1 < argc) iterations = std::atoi(argv[++i]);
+        else if (a == "--threads" && i + 1 < argc) threads = static_cast<size_t>(std::atoi(argv[++i]));
+    }
+    if (threads == 0) {
+        // Same sizing rule as TrackManager
+        const size_t hw = std::thread::hardware_concurrency();
+        threads = std::max<size_t>(2, std::min<size_t>(8, hw > 0 ? hw - 1 : 4));
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Audio Job System Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  workers=" << threads << " iterations=" << iterations << " frames=256\n\n";
+    std::cout << "  " << std::left << std::setw(16) << "pool"
+              << std::right << std::setw(6) << "tracks"
+              << std::setw(12) << "avg(us)"
+              << std::setw(12) << "p99(us)"
+              << std::setw(12) << "max(us)" << "\n";
+
+    LegacyAudioThreadPool legacy(threads);
+    AudioJobSystem jobs(threads);
+
+    for (uint32_t tracks : {32u, 64u, 128u}) {
+        TrackWork work;
+        work.buffers.assign(tracks, std::vector<float>(work.frames * 2, 0.25f));
+
+        const LatencyStats legacyStats = measure(iterations, [&] {
+            for (uint32_t t = 0; t < tracks; ++t) {
+                legacy.enqueue([&work, t] { processTrack(work, t); });
+            }
+            legacy.waitForCompletion();
+        });
+
+        const LatencyStats jobStats = measure(iterations, [&] {
+            for (uint32_t t = 0; t < tracks; ++t) {
+                jobs.submit(&processTrackJob, &work, t);
+            }
+            jobs.dispatchAndWait();
+        });
+
+        printRow("AudioThreadPool", tracks, legacyStats);
+        printRow("AudioJobSystem", tracks, jobStats);
+    }
+
+    // Sanity: every submitted job runs exactly once, including past the slot capacity
+    bool exact = true;
+    {
+        const uint32_t count = AudioJobSystem::kMaxJobs + 37;
+        std::vector<std::atomic<uint32_t>> hits(count);
+        for (int round = 0; round < 200 && exact; ++round) {
+            for (auto& h : hits) h.store(0, std::memory_order_relaxed);
+            const uint32_t n = 1 + static_cast<uint32_t>(round * 7) % count;
+            for (uint32_t i = 0; i < n; ++i) {
+                jobs.submit(&countJob, hits.data(), i);
+            }
+            jobs.dispatchAndWait();
+            for (uint32_t i = 0; i < count; ++i) {
+                if (hits[i].load(std::memory_order_relaxed) != (i < n ? 1u : 0u)) {
+                    exact = false;
+                    break;
+                }
+            }
+        }
+    }
+    std::cout << "\n  " << (exact ? "[PASS]" : "[FAIL]") << " every job executed exactly once\n";
+
+    const auto stats = jobs.getStats();
+    std::cout << "\n  AudioJobSystem: batches=" << stats.batches
+              << " jobs=" << stats.jobsExecuted
+              << " stolen=" << stats.jobsStolen
+              << " overflow=" << stats.overflowJobs << "\n";
+    return exact ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Throughput benchmark for AudioKernels: ns/frame per kernel and SIMD tier
+
+#include "AudioKernels.h"
+#include "NomadLog.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the kernel calls.
+volatile double g_sink = 0.0;
+
+struct Buffers {
+    explicit Buffers(uint32_t frames)
+        : a(frames * 2, 0.25), b(frames * 2, -0.125), f(frames * 2, 0.5f),
+          left(frames, 0.5f), right(frames, -0.5f) {}
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<float> f;
+    std::vector<float> left;
+    std::vector<float> right;
+};
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per frame.
+ */
+double nsPerFrame(uint32_t frames, double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    for (int i = 0; i < 64; ++i) {
+        fn();   // Warm-up
+    }
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        for (int i = 0; i < 64; ++i) {
+            fn();
+        }
+        iterations += 64;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return ns / static_cast<double>(iterations * frames);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t frames = 512;
+    double minMs = 50.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--frames" && i + 1 < argc) frames = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Audio Kernels Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  detected=" << AudioKernels::levelName(AudioKernels::detectedLevel())
+              << " frames=" << frames << " (stereo)\n\n";
+    std::cout << "  " << std::left << std::setw(36) << "Benchmark"
+              << std::right << std::setw(12) << "ns/frame"
+              << std::setw(10) << "speedup" << "\n";
+    std::cout << "  " << std::string(58, '-') << "\n";
+
+    Buffers buf(frames);
+    const StereoRamp ramp{0.9, 0.8, -1e-4, 1e-4};
+    const StereoRamp unityRamp{1.0, 1.0, 0.0, 0.0};   // In-place: repeated runs must not decay to denormals
+    StereoLevels levels;
+    const size_t samples = static_cast<size_t>(frames) * 2;
+
+    struct Kernel {
+        const char* name;
+        std::function<void(const AudioKernelTable&)> run;
+    };
+    const Kernel kernels[] = {
+        {"applyGainRamp", [&](const AudioKernelTable& k) { k.applyGainRamp(buf.a.data(), frames, unityRamp); }},
+        {"mixGainRamp", [&](const AudioKernelTable& k) { k.mixGainRamp(buf.a.data(), buf.b.data(), frames, ramp); }},
+        {"mix", [&](const AudioKernelTable& k) { k.mix(buf.a.data(), buf.b.data(), 0.5, samples); }},
+        {"measure", [&](const AudioKernelTable& k) {
+             k.measure(buf.a.data(), frames, levels);
+             g_sink = g_sink + levels.sumSqL;
+         }},
+        {"rampToFloat", [&](const AudioKernelTable& k) {
+             k.rampToFloat(buf.f.data(), buf.a.data(), frames, ramp, levels);
+             g_sink = g_sink + levels.peakR;
+         }},
+        {"doubleToFloat", [&](const AudioKernelTable& k) { k.doubleToFloat(buf.f.data(), buf.a.data(), samples); }},
+        {"floatToDouble", [&](const AudioKernelTable& k) { k.floatToDouble(buf.b.data(), buf.f.data(), samples); }},
+        {"interleave", [&](const AudioKernelTable& k) {
+             k.interleave(buf.f.data(), buf.left.data(), buf.right.data(), frames);
+         }},
+        {"deinterleave", [&](const AudioKernelTable& k) {
+             k.deinterleave(buf.left.data(), buf.right.data(), buf.f.data(), frames);
+         }},
+    };
+
+    const SimdLevel tiers[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (const Kernel& kernel : kernels) {
+        double scalarNs = 0.0;
+        for (SimdLevel tier : tiers) {
+            const AudioKernelTable* table = AudioKernels::table(tier);
+            if (!table) {
+                continue;
+            }
+            // Reset inputs so the ramps/mixes don't drift into denormals or infinities.
+            std::fill(buf.a.begin(), buf.a.end(), 0.25);
+            std::fill(buf.b.begin(), buf.b.end(), -0.125);
+            const double ns = nsPerFrame(frames, minMs, [&] { kernel.run(*table); });
+            if (tier == SimdLevel::Scalar) {
+                scalarNs = ns;
+            }
+            const std::string label = std::string("BM_") + kernel.name + "/" +
+                                      AudioKernels::levelName(tier) + "/" + std::to_string(frames);
+            std::cout << "  " << std::left << std::setw(36) << label
+                      << std::right << std::fixed << std::setprecision(3) << std::setw(12) << ns
+                      << std::setprecision(2) << std::setw(9) << (ns > 0.0 ? scalarNs / ns : 0.0) << "x\n";
+        }
+    }
+    return 0;
+}
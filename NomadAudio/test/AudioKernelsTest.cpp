@@ -0,0 +1,320 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for AudioKernels: every SIMD tier must match the scalar reference bit for bit
+
+#include "AudioKernels.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+// Odd sizes exercise every tail path; 1 element of offset keeps pointers unaligned.
+const uint32_t kFrameCounts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 64, 255, 256, 257, 1031};
+constexpr size_t kOffset = 1;
+
+std::mt19937 g_rng(0x5EED);
+
+std::vector<double> randomDoubles(size_t n) {
+    std::uniform_real_distribution<double> dist(-1.5, 1.5);
+    std::vector<double> v(n);
+    for (auto& x : v) x = dist(g_rng);
+    return v;
+}
+
+std::vector<float> randomFloats(size_t n) {
+    std::uniform_real_distribution<float> dist(-1.5f, 1.5f);
+    std::vector<float> v(n);
+    for (auto& x : v) x = dist(g_rng);
+    return v;
+}
+
+template <typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+bool sameLevels(const StereoLevels& a, const StereoLevels& b) {
+    return std::memcmp(&a, &b, sizeof(StereoLevels)) == 0;
+}
+
+const StereoRamp kRamp{0.8, 0.3, -1.0 / 1024.0, 1.0 / 3000.0};
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testScalarReference() {
+    std::cout << "\n=== Test: Scalar reference semantics ===\n";
+    const AudioKernelTable& k = *AudioKernels::table(SimdLevel::Scalar);
+
+    const uint32_t frames = 100;
+    const auto src = randomDoubles(frames * 2);
+
+    std::vector<double> ramped = src;
+    k.applyGainRamp(ramped.data(), frames, kRamp);
+    bool rampOk = true;
+    for (uint32_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i);
+        rampOk = rampOk && ramped[i * 2] == src[i * 2] * (kRamp.startL + kRamp.deltaL * t)
+                        && ramped[i * 2 + 1] == src[i * 2 + 1] * (kRamp.startR + kRamp.deltaR * t);
+    }
+    recordTest("Gain ramp evaluates start + delta * frame", rampOk);
+
+    StereoLevels levels;
+    k.measure(src.data(), frames, levels);
+    double peakL = 0.0, peakR = 0.0, sumL = 0.0, sumR = 0.0;
+    for (uint32_t i = 0; i < frames; ++i) {
+        peakL = std::max(peakL, std::fabs(src[i * 2]));
+        peakR = std::max(peakR, std::fabs(src[i * 2 + 1]));
+        sumL += src[i * 2] * src[i * 2];
+        sumR += src[i * 2 + 1] * src[i * 2 + 1];
+    }
+    recordTest("Peaks are exact", levels.peakL == peakL && levels.peakR == peakR);
+    recordTest("Sums of squares match a sequential sum",
+               std::fabs(levels.sumSqL - sumL) < 1e-12 * sumL && std::fabs(levels.sumSqR - sumR) < 1e-12 * sumR);
+
+    const auto left = randomFloats(frames);
+    const auto right = randomFloats(frames);
+    std::vector<float> inter(frames * 2);
+    std::vector<float> l2(frames), r2(frames);
+    k.interleave(inter.data(), left.data(), right.data(), frames);
+    k.deinterleave(l2.data(), r2.data(), inter.data(), frames);
+    recordTest("Interleave/deinterleave round-trips", sameBits(left, l2) && sameBits(right, r2) &&
+                                                      inter[2] == left[1] && inter[3] == right[1]);
+
+    const uint8_t pcm16[] = {0x00, 0x80, 0xFF, 0x7F, 0x01, 0x00, 0xFF, 0xFF};
+    float f16[4];
+    k.int16ToFloat(f16, pcm16, 4);
+    recordTest("int16 unpacks as x / 32768", f16[0] == -1.0f && f16[1] == 32767.0f / 32768.0f &&
+                                             f16[2] == 1.0f / 32768.0f && f16[3] == -1.0f / 32768.0f);
+    const uint8_t pcm24[] = {0x00, 0x00, 0x80, 0xFF, 0xFF, 0x7F, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xFF};
+    float f24[4];
+    k.int24ToFloat(f24, pcm24, 4);
+    recordTest("int24 unpacks as x / 8388608", f24[0] == -1.0f && f24[1] == 8388607.0f / 8388608.0f &&
+                                               f24[2] == 1.0f / 8388608.0f && f24[3] == -1.0f / 8388608.0f);
+
+    bool peaks = true;
+    for (uint32_t channels : {1u, 2u, 3u, 8u}) {
+        const auto samples = randomFloats(static_cast<size_t>(frames) * channels);
+        std::vector<float> got(channels * 2), want(channels * 2);
+        for (uint32_t c = 0; c < channels; ++c) {
+            got[c * 2] = want[c * 2] = 1.0f;
+            got[c * 2 + 1] = want[c * 2 + 1] = -1.0f;
+        }
+        k.peakRange(samples.data(), frames, channels, got.data());
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const size_t c = i % channels;
+            want[c * 2] = std::min(want[c * 2], samples[i]);
+            want[c * 2 + 1] = std::max(want[c * 2 + 1], samples[i]);
+        }
+        peaks = peaks && got == want;
+    }
+    recordTest("peakRange finds each channel's min and max", peaks);
+}
+
+void testTier(SimdLevel level) {
+    const AudioKernelTable* simd = AudioKernels::table(level);
+    const std::string name = AudioKernels::levelName(level);
+    std::cout << "\n=== Test: " << name << " vs scalar ===\n";
+    if (!simd) {
+        std::cout << "  (not supported on this CPU/build, skipped)\n";
+        return;
+    }
+    const AudioKernelTable& ref = *AudioKernels::table(SimdLevel::Scalar);
+
+    bool applyRamp = true, mixRamp = true, mix = true, measure = true, rampFloat = true;
+    bool toFloat = true, toDouble = true, inter = true, deinter = true, from16 = true, from24 = true;
+    bool peaks = true;
+    for (uint32_t frames : kFrameCounts) {
+        const size_t n = static_cast<size_t>(frames) * 2;
+        const size_t flat = n + (frames & 1);   // Odd sample counts for the flat kernels
+        const auto src = randomDoubles(flat + kOffset);
+        const auto base = randomDoubles(flat + kOffset);
+
+        auto a = src, b = src;
+        ref.applyGainRamp(a.data() + kOffset, frames, kRamp);
+        simd->applyGainRamp(b.data() + kOffset, frames, kRamp);
+        applyRamp = applyRamp && sameBits(a, b);
+
+        a = base; b = base;
+        ref.mixGainRamp(a.data() + kOffset, src.data() + kOffset, frames, kRamp);
+        simd->mixGainRamp(b.data() + kOffset, src.data() + kOffset, frames, kRamp);
+        mixRamp = mixRamp && sameBits(a, b);
+
+        for (double gain : {1.0, 0.7071}) {
+            a = base; b = base;
+            ref.mix(a.data() + kOffset, src.data() + kOffset, gain, flat);
+            simd->mix(b.data() + kOffset, src.data() + kOffset, gain, flat);
+            mix = mix && sameBits(a, b);
+        }
+
+        StereoLevels la, lb;
+        ref.measure(src.data() + kOffset, frames, la);
+        simd->measure(src.data() + kOffset, frames, lb);
+        measure = measure && sameLevels(la, lb);
+
+        std::vector<float> fa(flat + kOffset, 0.0f), fb(flat + kOffset, 0.0f);
+        ref.rampToFloat(fa.data() + kOffset, src.data() + kOffset, frames, kRamp, la);
+        simd->rampToFloat(fb.data() + kOffset, src.data() + kOffset, frames, kRamp, lb);
+        rampFloat = rampFloat && sameBits(fa, fb) && sameLevels(la, lb);
+
+        std::fill(fa.begin(), fa.end(), 0.0f);
+        std::fill(fb.begin(), fb.end(), 0.0f);
+        ref.doubleToFloat(fa.data() + kOffset, src.data() + kOffset, flat);
+        simd->doubleToFloat(fb.data() + kOffset, src.data() + kOffset, flat);
+        toFloat = toFloat && sameBits(fa, fb);
+
+        const auto fsrc = randomFloats(flat + kOffset);
+        std::vector<double> da(flat + kOffset, 0.0), db(flat + kOffset, 0.0);
+        ref.floatToDouble(da.data() + kOffset, fsrc.data() + kOffset, flat);
+        simd->floatToDouble(db.data() + kOffset, fsrc.data() + kOffset, flat);
+        toDouble = toDouble && sameBits(da, db);
+
+        const auto left = randomFloats(frames + kOffset);
+        const auto right = randomFloats(frames + kOffset);
+        std::fill(fa.begin(), fa.end(), 0.0f);
+        std::fill(fb.begin(), fb.end(), 0.0f);
+        ref.interleave(fa.data() + kOffset, left.data() + kOffset, right.data() + kOffset, frames);
+        simd->interleave(fb.data() + kOffset, left.data() + kOffset, right.data() + kOffset, frames);
+        inter = inter && sameBits(fa, fb);
+
+        std::vector<float> la2(frames + kOffset, 0.0f), ra2(frames + kOffset, 0.0f);
+        std::vector<float> lb2(frames + kOffset, 0.0f), rb2(frames + kOffset, 0.0f);
+        ref.deinterleave(la2.data() + kOffset, ra2.data() + kOffset, fa.data() + kOffset, frames);
+        simd->deinterleave(lb2.data() + kOffset, rb2.data() + kOffset, fa.data() + kOffset, frames);
+        deinter = deinter && sameBits(la2, lb2) && sameBits(ra2, rb2);
+
+        // Packed PCM: random bytes cover every bit pattern; exact-size sources catch over-reads.
+        std::vector<uint8_t> bytes(flat * 3);
+        for (auto& b : bytes) {
+            b = static_cast<uint8_t>(std::rand());
+        }
+        const std::vector<uint8_t> src16(bytes.begin(), bytes.begin() + flat * 2);
+        std::vector<float> ua(flat + kOffset, 0.0f), ub(flat + kOffset, 0.0f);
+        ref.int16ToFloat(ua.data() + kOffset, src16.data(), flat);
+        simd->int16ToFloat(ub.data() + kOffset, src16.data(), flat);
+        from16 = from16 && sameBits(ua, ub);
+        ref.int24ToFloat(ua.data() + kOffset, bytes.data(), flat);
+        simd->int24ToFloat(ub.data() + kOffset, bytes.data(), flat);
+        from24 = from24 && sameBits(ua, ub);
+
+        // Peaks: signed zeros and a NaN make lane order observable in the result bits.
+        auto psrc = randomFloats(flat * 8);
+        for (size_t i = 0; i < psrc.size(); i += 5) {
+            psrc[i] = (i & 1) ? -0.0f : 0.0f;
+        }
+        if (psrc.size() > 3) {
+            psrc[3] = std::nanf("");
+        }
+        for (uint32_t channels : {1u, 2u, 3u, 4u, 6u, 8u}) {
+            std::vector<float> pa(channels * 2, 0.0f), pb(channels * 2, 0.0f);
+            const size_t pframes = psrc.size() / channels;
+            ref.peakRange(psrc.data(), pframes, channels, pa.data());
+            simd->peakRange(psrc.data(), pframes, channels, pb.data());
+            peaks = peaks && sameBits(pa, pb);
+        }
+    }
+
+    recordTest(name + " applyGainRamp bit-exact", applyRamp);
+    recordTest(name + " mixGainRamp bit-exact", mixRamp);
+    recordTest(name + " mix bit-exact", mix);
+    recordTest(name + " measure bit-exact", measure);
+    recordTest(name + " rampToFloat bit-exact", rampFloat);
+    recordTest(name + " doubleToFloat bit-exact", toFloat);
+    recordTest(name + " floatToDouble bit-exact", toDouble);
+    recordTest(name + " interleave bit-exact", inter);
+    recordTest(name + " deinterleave bit-exact", deinter);
+    recordTest(name + " int16ToFloat bit-exact", from16);
+    recordTest(name + " int24ToFloat bit-exact", from24);
+    recordTest(name + " peakRange bit-exact", peaks);
+}
+
+void testDispatch() {
+    std::cout << "\n=== Test: Dispatch ===\n";
+    const SimdLevel detected = AudioKernels::detectedLevel();
+    std::cout << "  detected: " << AudioKernels::levelName(detected) << "\n";
+
+    recordTest("Default tier is the detected tier", AudioKernels::activeLevel() == detected);
+    AudioKernels::setLevel(SimdLevel::Scalar);
+    const bool forced = AudioKernels::activeLevel() == SimdLevel::Scalar;
+    AudioKernels::setLevel(SimdLevel::AVX512);
+    const bool clamped = AudioKernels::activeLevel() == detected;
+    recordTest("Tier can be forced down and is clamped to the CPU", forced && clamped);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Audio Kernels Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testScalarReference();
+    testTier(SimdLevel::SSE2);
+    testTier(SimdLevel::AVX2);
+    testTier(SimdLevel::AVX512);
+    testDispatch();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Cost per voice of clip resampling: block ClipResampler per SRCQuality and SIMD tier,
+// against the per-frame Interpolators path the engine used before
+
+#include "AudioKernels.h"
+#include "ClipResampler.h"
+#include "Interpolators.h"
+#include "NomadLog.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile double g_sink = 0.0;
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per call.
+ */
+double nsPerCall(double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    for (int i = 0; i < 16; ++i) {
+        fn();   // Warm-up
+    }
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        for (int i = 0; i < 16; ++i) {
+            fn();
+        }
+        iterations += 16;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+}
+
+/// Per-frame interpolator matching each quality (Linear had none).
+bool legacyQuality(SRCQuality quality, Interpolators::InterpolationQuality& out) {
+    switch (quality) {
+        case SRCQuality::Cubic:  out = Interpolators::InterpolationQuality::Cubic; return true;
+        case SRCQuality::Sinc8:  out = Interpolators::InterpolationQuality::Sinc8; return true;
+        case SRCQuality::Sinc16: out = Interpolators::InterpolationQuality::Sinc16; return true;
+        case SRCQuality::Sinc64: out = Interpolators::InterpolationQuality::Sinc64; return true;
+        case SRCQuality::Linear: break;
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t frames = 512;
+    double srcRate = 44100.0;
+    double dstRate = 48000.0;
+    double minMs = 100.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--frames" && i + 1 < argc) frames = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--src-rate" && i + 1 < argc) srcRate = std::atof(argv[++i]);
+        else if (a == "--dst-rate" && i + 1 < argc) dstRate = std::atof(argv[++i]);
+        else if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    // Ten seconds of stereo test material (two sines).
+    const uint32_t clipFrames = static_cast<uint32_t>(srcRate * 10.0);
+    std::vector<float> clip(static_cast<size_t>(clipFrames) * 2);
+    for (uint32_t i = 0; i < clipFrames; ++i) {
+        clip[i * 2] = static_cast<float>(0.5 * std::sin(0.031 * i));
+        clip[i * 2 + 1] = static_cast<float>(0.5 * std::sin(0.017 * i));
+    }
+    std::vector<double> out(static_cast<size_t>(frames) * 2);
+
+    const double blockBudgetNs = 1e9 * static_cast<double>(frames) / dstRate;
+    const double step = srcRate / dstRate;
+    const double span = static_cast<double>(clipFrames) - 2.0 * frames * step - 128.0;
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Clip Resampler Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  " << srcRate << " -> " << dstRate << " Hz, block=" << frames
+              << " frames (budget " << std::fixed << std::setprecision(1) << blockBudgetNs / 1000.0
+              << " us), detected=" << AudioKernels::levelName(AudioKernels::detectedLevel()) << "\n\n";
+    std::cout << "  " << std::left << std::setw(34) << "Benchmark"
+              << std::right << std::setw(12) << "ns/voice" << std::setw(10) << "ns/frame"
+              << std::setw(12) << "voices/blk" << std::setw(10) << "speedup" << "\n";
+    std::cout << "  " << std::string(78, '-') << "\n";
+
+    auto report = [&](const std::string& label, double ns, double baselineNs) {
+        std::cout << "  " << std::left << std::setw(34) << label << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(12) << ns
+                  << std::setprecision(2) << std::setw(10) << ns / frames
+                  << std::setprecision(0) << std::setw(12) << blockBudgetNs / ns;
+        if (baselineNs > 0.0) {
+            std::cout << std::setprecision(2) << std::setw(9) << baselineNs / ns << "x";
+        }
+        std::cout << "\n";
+    };
+
+    const SimdLevel detected = AudioKernels::detectedLevel();
+    const SRCQuality qualities[] = {SRCQuality::Linear, SRCQuality::Cubic, SRCQuality::Sinc8,
+                                    SRCQuality::Sinc16, SRCQuality::Sinc64};
+    for (SRCQuality quality : qualities) {
+        const std::string name = ClipResampler::qualityName(quality);
+        double position = 64.0;
+
+        // Baseline: one interpolate() call per output frame, as renderTrack used to do.
+        double legacyNs = 0.0;
+        Interpolators::InterpolationQuality legacy;
+        if (legacyQuality(quality, legacy)) {
+            legacyNs = nsPerCall(minMs, [&] {
+                double phase = position;
+                for (uint32_t i = 0; i < frames; ++i) {
+                    float l, r;
+                    Interpolators::interpolateSample(legacy, clip.data(), clipFrames, phase, l, r);
+                    out[i * 2] = l;
+                    out[i * 2 + 1] = r;
+                    phase += step;
+                }
+                position = position + frames * step < span ? position + frames * step : 64.0;
+                g_sink = g_sink + out[frames];
+            });
+            report("BM_PerFrame/" + name, legacyNs, 0.0);
+        }
+
+        ClipResampler resampler;
+        resampler.configure(srcRate, dstRate, quality);
+        for (SimdLevel tier : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+            if (!AudioKernels::table(tier)) {
+                continue;
+            }
+            AudioKernels::setLevel(tier);
+            const double ns = nsPerCall(minMs, [&] {
+                resampler.process(clip.data(), clipFrames, position, step, out.data(), frames);
+                position = position + frames * step < span ? position + frames * step : 64.0;
+                g_sink = g_sink + out[frames];
+            });
+            report("BM_Block/" + name + "/" + AudioKernels::levelName(tier), ns, legacyNs);
+        }
+        AudioKernels::setLevel(detected);
+    }
+    return 0;
+}
@@ -0,0 +1,397 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for LoudnessMeter (BS.1770 / EBU R128) and AudioEngine loudness publication and cost
+
+#include "AudioEngine.h"
+#include "AudioGraph.h"
+#include "ChannelSlotMap.h"
+#include "LoudnessMeter.h"
+#include "SamplePool.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+/// Feed seconds of a stereo sine (peak amplitude from dBFS) in blockFrames pieces.
+void feedSine(LoudnessMeter& meter, double rate, double freq, double dbfs, double seconds,
+              uint32_t blockFrames = 512, double phase = 0.0) {
+    const double amp = std::pow(10.0, dbfs / 20.0);
+    const uint64_t total = static_cast<uint64_t>(seconds * rate);
+    std::vector<float> block(static_cast<size_t>(blockFrames) * 2);
+    for (uint64_t done = 0; done < total;) {
+        const uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(blockFrames, total - done));
+        for (uint32_t i = 0; i < n; ++i) {
+            const float v = static_cast<float>(amp * std::sin(2.0 * PI * freq * static_cast<double>(done + i) / rate + phase));
+            block[i * 2] = block[i * 2 + 1] = v;
+        }
+        meter.process(block.data(), n);
+        done += n;
+    }
+}
+
+std::string lu(float value) {
+    return std::to_string(value);
+}
+
+std::shared_ptr<AudioBuffer> makeSineBuffer(uint32_t sampleRate, uint32_t frames, double amp) {
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = sampleRate;
+    buffer->numFrames = frames;
+    buffer->data.resize(static_cast<size_t>(frames) * 2);
+    for (uint32_t i = 0; i < frames; ++i) {
+        const float v = static_cast<float>(amp * std::sin(2.0 * PI * 1000.0 * i / sampleRate));
+        buffer->data[static_cast<size_t>(i) * 2] = buffer->data[static_cast<size_t>(i) * 2 + 1] = v;
+    }
+    buffer->ready.store(true, std::memory_order_release);
+    return buffer;
+}
+
+/// One track per amplitude, each a 1 kHz sine over the whole timeline.
+AudioGraph makeSineGraph(const std::vector<double>& amps, uint32_t sampleRate, uint32_t frames) {
+    AudioGraph graph;
+    graph.timelineEndSample = frames;
+    for (uint32_t t = 0; t < amps.size(); ++t) {
+        auto src = makeSineBuffer(sampleRate, frames, amps[t]);
+        TrackRenderState tr;
+        tr.trackId = 10 + t;
+        tr.trackIndex = t;
+        ClipRenderState clip;
+        clip.buffer = src;
+        clip.audioData = src->data.data();
+        clip.startSample = 0;
+        clip.endSample = graph.timelineEndSample;
+        clip.totalFrames = src->numFrames;
+        clip.sourceSampleRate = sampleRate;
+        tr.clips.push_back(clip);
+        graph.tracks.push_back(std::move(tr));
+    }
+    return graph;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testReferenceLevels() {
+    std::cout << "\n=== Test: 1 kHz reference at -23 dBFS reads -23 LUFS ===\n";
+
+    for (double rate : {44100.0, 48000.0, 96000.0}) {
+        LoudnessMeter meter;
+        meter.prepare(rate);
+        feedSine(meter, rate, 1000.0, -23.0, 20.0);
+        const LoudnessReadings& r = meter.readings();
+        const std::string tag = " @ " + std::to_string(static_cast<int>(rate)) + " Hz";
+        recordTest("Momentary, short-term and integrated" + tag,
+                   std::abs(r.momentaryLufs + 23.0f) < 0.1f && std::abs(r.shortTermLufs + 23.0f) < 0.1f &&
+                       std::abs(r.integratedLufs + 23.0f) < 0.1f,
+                   "I=" + lu(r.integratedLufs));
+        recordTest("Steady tone has no loudness range" + tag, r.loudnessRange < 0.2f, "LRA=" + lu(r.loudnessRange));
+    }
+
+    // Odd block sizes land on the same readings.
+    LoudnessMeter odd;
+    odd.prepare(48000.0);
+    feedSine(odd, 48000.0, 1000.0, -23.0, 20.0, 37);
+    recordTest("Readings do not depend on the block size", std::abs(odd.readings().integratedLufs + 23.0f) < 0.1f);
+}
+
+void testGating() {
+    std::cout << "\n=== Test: Gating (BS.1770-4, EBU Tech 3341) ===\n";
+
+    // Silence never counts: 10 s of tone, 10 s of silence.
+    LoudnessMeter meter;
+    meter.prepare(48000.0);
+    feedSine(meter, 48000.0, 1000.0, -23.0, 10.0);
+    meter.processSilence(48000 * 10);
+    recordTest("Silence is gated out of integrated loudness",
+               std::abs(meter.readings().integratedLufs + 23.0f) < 0.1f, "I=" + lu(meter.readings().integratedLufs));
+    recordTest("Momentary loudness falls in silence", std::isinf(meter.readings().momentaryLufs));
+
+    // Tech 3341 case 5: 20 s @ -26, 20.1 s @ -20, 20 s @ -26 dBFS -> -23 LUFS.
+    LoudnessMeter relative;
+    relative.prepare(48000.0);
+    feedSine(relative, 48000.0, 1000.0, -26.0, 20.0);
+    feedSine(relative, 48000.0, 1000.0, -20.0, 20.1);
+    feedSine(relative, 48000.0, 1000.0, -26.0, 20.0);
+    recordTest("Relative gate (Tech 3341 case 5)", std::abs(relative.readings().integratedLufs + 23.0f) < 0.1f,
+               "I=" + lu(relative.readings().integratedLufs));
+
+    // Tech 3341 case 4: quiet passages below the relative gate are dropped.
+    LoudnessMeter quiet;
+    quiet.prepare(48000.0);
+    feedSine(quiet, 48000.0, 1000.0, -72.0, 10.0);
+    feedSine(quiet, 48000.0, 1000.0, -36.0, 10.0);
+    feedSine(quiet, 48000.0, 1000.0, -23.0, 60.0);
+    feedSine(quiet, 48000.0, 1000.0, -36.0, 10.0);
+    feedSine(quiet, 48000.0, 1000.0, -72.0, 10.0);
+    recordTest("Absolute and relative gates (Tech 3341 case 4)",
+               std::abs(quiet.readings().integratedLufs + 23.0f) < 0.1f, "I=" + lu(quiet.readings().integratedLufs));
+
+    LoudnessMeter silent;
+    silent.prepare(48000.0);
+    silent.processSilence(48000 * 5);
+    recordTest("Silence alone has no integrated loudness", std::isinf(silent.readings().integratedLufs));
+}
+
+void testLoudnessRange() {
+    std::cout << "\n=== Test: Loudness range (EBU Tech 3342) ===\n";
+
+    struct Case { double a; double b; float expected; };
+    for (const Case& c : {Case{-20.0, -30.0, 10.0f}, Case{-20.0, -15.0, 5.0f}, Case{-40.0, -20.0, 20.0f}}) {
+        LoudnessMeter meter;
+        meter.prepare(48000.0);
+        feedSine(meter, 48000.0, 1000.0, c.a, 20.0);
+        feedSine(meter, 48000.0, 1000.0, c.b, 20.0);
+        const float lra = meter.readings().loudnessRange;
+        recordTest("LRA of " + std::to_string(static_cast<int>(c.a)) + " / " + std::to_string(static_cast<int>(c.b)) +
+                       " dBFS halves is " + std::to_string(static_cast<int>(c.expected)) + " LU",
+                   std::abs(lra - c.expected) < 1.0f, "LRA=" + lu(lra));
+    }
+}
+
+void testTruePeak() {
+    std::cout << "\n=== Test: True peak (4x oversampled) ===\n";
+
+    // fs/4 at 45 degrees: every sample sits at 0.707 of the waveform's peak.
+    LoudnessMeter meter;
+    meter.prepare(48000.0);
+    feedSine(meter, 48000.0, 12000.0, -6.0, 1.0, 512, PI / 4.0);
+    const float expected = static_cast<float>(std::pow(10.0, -6.0 / 20.0));
+    const float peak = meter.readings().truePeakL;
+    recordTest("Inter-sample peak is found", std::abs(peak - expected) < 0.03f * expected,
+               "peak=" + std::to_string(peak) + " expected=" + std::to_string(expected));
+    recordTest("True peak is above the sample peak", peak > expected * 0.75f);
+
+    meter.reset();
+    recordTest("reset() clears held peaks and integrated loudness",
+               meter.readings().truePeakL == 0.0f && std::isinf(meter.readings().integratedLufs));
+    recordTest("toDecibels maps unity to 0 dB and silence to -inf",
+               LoudnessMeter::toDecibels(1.0f) == 0.0f && std::isinf(LoudnessMeter::toDecibels(0.0f)));
+}
+
+void testEnginePublication() {
+    std::cout << "\n=== Test: AudioEngine publishes loudness ===\n";
+
+    constexpr uint32_t kRate = 48000;
+    constexpr uint32_t kFrames = 480;
+    const AudioGraph graph = makeSineGraph({0.2, 0.05}, kRate, kRate * 20);
+
+    auto loudness = std::make_shared<LoudnessSnapshotBuffer>();
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    engine.setLoudnessSnapshots(loudness, true);
+    engine.setGraph(graph);
+    engine.setTransportPlaying(true);
+
+    // Reference: the same output through a standalone meter.
+    LoudnessMeter reference;
+    reference.prepare(kRate);
+    std::vector<float> block(kFrames * 2);
+    for (uint32_t b = 0; b < kRate * 5 / kFrames; ++b) {
+        engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+        reference.process(block.data(), kFrames);
+    }
+
+    LoudnessReadings master;
+    loudness->read(ChannelSlotMap::MASTER_SLOT_INDEX, master);
+    recordTest("Master slot carries the output's loudness",
+               std::isfinite(master.integratedLufs) &&
+                   std::abs(master.integratedLufs - reference.readings().integratedLufs) < 1e-4f,
+               "I=" + lu(master.integratedLufs));
+    recordTest("Master true peak is published", master.truePeakL > 0.0f &&
+                                                    master.truePeakL == reference.readings().truePeakL);
+
+    ChannelSlotMap slots;
+    slots.rebuild(graph);
+    LoudnessReadings loud, soft;
+    loudness->read(slots.getSlotIndex(10), loud);
+    loudness->read(slots.getSlotIndex(11), soft);
+    // Track 1 is 12 dB below track 0 (0.05 vs 0.2).
+    recordTest("Per-track loudness in each track's slot",
+               std::isfinite(loud.integratedLufs) && std::abs((loud.integratedLufs - soft.integratedLufs) - 12.04f) < 0.1f,
+               "difference=" + lu(loud.integratedLufs - soft.integratedLufs));
+
+    engine.resetLoudness();
+    engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+    loudness->read(ChannelSlotMap::MASTER_SLOT_INDEX, master);
+    recordTest("resetLoudness() restarts the programme", std::isinf(master.integratedLufs));
+}
+
+void testSwapWhileRunning() {
+    std::cout << "\n=== Test: Loudness snapshots swapped while rendering ===\n";
+
+    constexpr uint32_t kRate = 48000;
+    constexpr uint32_t kFrames = 256;
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kFrames, 2);
+    engine.setRenderThreadCount(2);
+    engine.setGraph(makeSineGraph(std::vector<double>(8, 0.1), kRate, kRate * 10));
+    engine.setTransportPlaying(true);
+
+    // The control thread swaps, adds and drops meter sets while blocks render,
+    // per-channel meters included; none may be freed under the audio thread.
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> blocks{0};
+    std::thread audio([&] {
+        std::vector<float> block(kFrames * 2);
+        while (!done.load()) {
+            engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+            blocks.fetch_add(1);
+        }
+    });
+    std::shared_ptr<LoudnessSnapshotBuffer> last;
+    for (int i = 0; i < 300; ++i) {
+        last = i % 3 == 2 ? nullptr : std::make_shared<LoudnessSnapshotBuffer>();
+        engine.setLoudnessSnapshots(last, i % 2 == 0);
+        std::this_thread::yield();
+    }
+    last = std::make_shared<LoudnessSnapshotBuffer>();
+    engine.setLoudnessSnapshots(last, true);
+    const uint32_t settled = blocks.load();
+    while (blocks.load() < settled + 8) {
+        std::this_thread::yield();
+    }
+    done.store(true);
+    audio.join();
+
+    LoudnessReadings master;
+    last->read(ChannelSlotMap::MASTER_SLOT_INDEX, master);
+    recordTest("The last set published meters the output",
+               master.truePeakL > 0.0f && engine.getLoudnessSnapshots() == last.get(),
+               std::to_string(blocks.load()) + " blocks rendered");
+}
+
+void testMeteringCost() {
+    std::cout << "\n=== Test: Loudness metering cost at 64 tracks ===\n";
+
+    constexpr uint32_t kRate = 48000;
+    constexpr uint32_t kFrames = 512;
+    constexpr uint32_t kTracks = 64;
+    constexpr int kBlocks = 400;
+    const AudioGraph graph = makeSineGraph(std::vector<double>(kTracks, 0.05), kRate, kRate * 10);
+
+    // Serial render, so the figures are the audio thread's own work per block.
+    enum class Metering { Off, Master, PerChannel };
+    auto timeBlocks = [&](Metering metering) {
+        AudioEngine engine;
+        engine.setSampleRate(kRate);
+        engine.setBufferConfig(kFrames, 2);
+        engine.setRenderThreadCount(0);
+        if (metering != Metering::Off) {
+            engine.setLoudnessSnapshots(std::make_shared<LoudnessSnapshotBuffer>(), metering == Metering::PerChannel);
+        }
+        engine.setGraph(graph);
+        engine.setTransportPlaying(true);
+        std::vector<float> block(kFrames * 2);
+        for (int b = 0; b < 16; ++b) {
+            engine.processBlock(block.data(), nullptr, kFrames, 0.0);   // Warm-up
+        }
+        double best = 1e30;
+        for (int round = 0; round < 3; ++round) {
+            engine.setGlobalSamplePos(0);
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int b = 0; b < kBlocks; ++b) {
+                engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(t1 - t0).count() / kBlocks);
+        }
+        return best;
+    };
+
+    const double offUs = timeBlocks(Metering::Off);
+    const double masterUs = std::max(0.0, timeBlocks(Metering::Master) - offUs);
+    const double perChannelUs = std::max(0.0, timeBlocks(Metering::PerChannel) - offUs);
+    const double periodUs = 1e6 * kFrames / kRate;
+    std::cout << "  Block: " << offUs << " us unmetered; loudness adds " << masterUs << " us (master), "
+              << perChannelUs << " us (per channel) of a " << periodUs << " us period\n";
+    // The default (master only) must stay negligible; per-channel is opt-in and reported only.
+    recordTest("Master loudness stays within 2% of the block period", masterUs <= 0.02 * periodUs,
+               "master=" + std::to_string(masterUs) + "us, per-channel=" + std::to_string(perChannelUs) + "us");
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Loudness Meter Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Warning);
+
+    testReferenceLevels();
+    testGating();
+    testLoudnessRange();
+    testTruePeak();
+    testEnginePublication();
+    testSwapWhileRunning();
+    testMeteringCost();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,930 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for offline export: mixdown/stem files, dithering, FLAC encoding and speed
+
+#include "LoudnessMeter.h"
+#include "OfflineExporter.h"
+#include "NomadLog.h"
+#include "StreamingSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr uint32_t kRate = 48000;
+const double kHeadroom = std::pow(10.0f, -6.0f / 20.0f);   // ExportSettings::headroomDb default
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("nomad_export_" + name)).string();
+}
+
+double sineAt(double freq, double amp, uint64_t frame) {
+    return amp * std::sin(2.0 * PI * freq * static_cast<double>(frame) / kRate);
+}
+
+std::shared_ptr<AudioBuffer> makeSine(double freq, double amp, uint32_t frames) {
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = kRate;
+    buffer->numFrames = frames;
+    buffer->data.resize(static_cast<size_t>(frames) * 2);
+    for (uint32_t i = 0; i < frames; ++i) {
+        buffer->data[i * 2] = buffer->data[i * 2 + 1] = static_cast<float>(sineAt(freq, amp, i));
+    }
+    buffer->ready.store(true, std::memory_order_release);
+    return buffer;
+}
+
+TrackRenderState makeTrack(uint32_t index, const std::shared_ptr<AudioBuffer>& src,
+                           uint64_t start, float volume) {
+    TrackRenderState tr;
+    tr.trackId = index + 1;
+    tr.trackIndex = index;
+    tr.volume = volume;
+    ClipRenderState clip;
+    clip.buffer = src;
+    clip.audioData = src->data.data();
+    clip.startSample = start;
+    clip.endSample = start + src->numFrames;
+    clip.totalFrames = src->numFrames;
+    clip.sourceSampleRate = kRate;
+    tr.clips.push_back(clip);
+    return tr;
+}
+
+/// Track 0: 440 Hz at 0.5 for 2 s. Track 1: 1 kHz at 0.25, fader 0.5, from 1 s to 2 s.
+AudioGraph makeProject() {
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(0, makeSine(440.0, 0.5, kRate * 2), 0, 1.0f));
+    graph.tracks.push_back(makeTrack(1, makeSine(1000.0, 0.25, kRate), kRate, 0.5f));
+    graph.timelineEndSample = kRate * 2;
+    return graph;
+}
+
+/// Expected track output (post-fader, centre pan) at a project frame, before the master stage.
+double expectedStem(uint32_t track, uint64_t frame) {
+    const double centre = std::cos(PI * 0.25);
+    if (track == 0) {
+        return frame < kRate * 2 ? centre * sineAt(440.0, 0.5, frame) : 0.0;
+    }
+    return (frame >= kRate && frame < kRate * 2) ? centre * 0.5 * sineAt(1000.0, 0.25, frame - kRate) : 0.0;
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+uint32_t le(const uint8_t* p, int bytes) {
+    uint32_t v = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+struct WavData {
+    bool valid{false};
+    uint32_t format{0};
+    uint32_t channels{0};
+    uint32_t sampleRate{0};
+    uint32_t bits{0};
+    uint32_t riffSize{0};
+    size_t fileSize{0};
+    std::vector<float> floats;     // Float32 files
+    std::vector<int32_t> ints;     // PCM files
+};
+
+WavData readWav(const std::string& path) {
+    WavData wav;
+    const auto bytes = readFile(path);
+    wav.fileSize = bytes.size();
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return wav;
+    }
+    wav.riffSize = le(&bytes[4], 4);
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint32_t size = le(&bytes[pos + 4], 4);
+        const uint8_t* body = &bytes[pos + 8];
+        if (std::memcmp(&bytes[pos], "fmt ", 4) == 0) {
+            wav.format = le(body, 2);
+            wav.channels = le(body + 2, 2);
+            wav.sampleRate = le(body + 4, 4);
+            wav.bits = le(body + 14, 2);
+        } else if (std::memcmp(&bytes[pos], "data", 4) == 0) {
+            if (pos + 8 + size > bytes.size()) {
+                return wav;
+            }
+            if (wav.format == 3) {
+                wav.floats.resize(size / 4);
+                std::memcpy(wav.floats.data(), body, size);
+            } else {
+                const uint32_t width = wav.bits / 8;
+                for (uint32_t i = 0; i + width <= size; i += width) {
+                    const uint32_t shift = 32 - wav.bits;
+                    wav.ints.push_back(static_cast<int32_t>(le(body + i, width) << shift) >> shift);
+                }
+            }
+            wav.valid = true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    return wav;
+}
+
+// -----------------------------------------------------------------------------
+// Minimal FLAC decoder (fixed predictors, constant/verbatim, stereo decorrelation)
+// -----------------------------------------------------------------------------
+
+class BitReader {
+public:
+    BitReader(const std::vector<uint8_t>& data, size_t bytePos) : m_data(data), m_bit(bytePos * 8) {}
+
+    uint32_t read(uint32_t bits) {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < bits; ++i) {
+            const size_t byte = m_bit >> 3;
+            const uint32_t bit = byte < m_data.size() ? (m_data[byte] >> (7 - (m_bit & 7))) & 1 : 0;
+            v = (v << 1) | bit;
+            ++m_bit;
+        }
+        return v;
+    }
+    int32_t readSigned(uint32_t bits) {
+        const uint32_t v = read(bits);
+        return bits < 32 ? static_cast<int32_t>(v << (32 - bits)) >> (32 - bits) : static_cast<int32_t>(v);
+    }
+    uint32_t readUnary() {
+        uint32_t zeros = 0;
+        while (read(1) == 0) {
+            ++zeros;
+        }
+        return zeros;
+    }
+    void align() { m_bit = (m_bit + 7) & ~size_t(7); }
+    size_t bytePos() const { return m_bit >> 3; }
+    bool atEnd() const { return (m_bit >> 3) >= m_data.size(); }
+
+private:
+    const std::vector<uint8_t>& m_data;
+    size_t m_bit;
+};
+
+uint8_t refCrc8(const uint8_t* p, size_t n) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < n; ++i) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+    }
+    return crc;
+}
+
+uint16_t refCrc16(const uint8_t* p, size_t n) {
+    uint16_t crc = 0;
+    for (size_t i = 0; i < n; ++i) {
+        crc ^= static_cast<uint16_t>(p[i] << 8);
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x8005) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+struct FlacData {
+    bool valid{false};
+    bool crcOk{true};
+    uint32_t sampleRate{0};
+    uint32_t channels{0};
+    uint32_t bits{0};
+    uint64_t totalSamples{0};
+    uint32_t frames{0};
+    size_t fileSize{0};
+    std::vector<int32_t> samples;   // Interleaved
+};
+
+bool decodeSubframe(BitReader& br, uint32_t n, uint32_t bps, std::vector<int64_t>& out) {
+    out.assign(n, 0);
+    if (br.read(1) != 0) return false;
+    const uint32_t type = br.read(6);
+    if (br.read(1) != 0) return false;   // Wasted bits never emitted
+    if (type == 0) {
+        const int32_t v = br.readSigned(bps);
+        std::fill(out.begin(), out.end(), v);
+        return true;
+    }
+    if (type == 1) {
+        for (uint32_t i = 0; i < n; ++i) out[i] = br.readSigned(bps);
+        return true;
+    }
+    if ((type & 0x38) != 0x08 || (type & 7) > 4) return false;
+    const uint32_t order = type & 7;
+    for (uint32_t i = 0; i < order; ++i) out[i] = br.readSigned(bps);
+    const uint32_t method = br.read(2);
+    if (method > 1) return false;
+    const uint32_t porder = br.read(4);
+    const uint32_t parts = 1u << porder;
+    uint32_t i = order;
+    for (uint32_t p = 0; p < parts; ++p) {
+        const uint32_t param = br.read(method ? 5 : 4);
+        if (param == (method ? 31u : 15u)) return false;   // Escape never emitted
+        const uint32_t count = (n >> porder) - (p == 0 ? order : 0);
+        for (uint32_t k = 0; k < count; ++k, ++i) {
+            const uint32_t u = (br.readUnary() << param) | br.read(param);
+            const int64_t r = (u & 1) ? -static_cast<int64_t>(u >> 1) - 1 : static_cast<int64_t>(u >> 1);
+            int64_t pred = 0;
+            switch (order) {
+                case 1: pred = out[i - 1]; break;
+                case 2: pred = 2 * out[i - 1] - out[i - 2]; break;
+                case 3: pred = 3 * out[i - 1] - 3 * out[i - 2] + out[i - 3]; break;
+                case 4: pred = 4 * out[i - 1] - 6 * out[i - 2] + 4 * out[i - 3] - out[i - 4]; break;
+                default: break;
+            }
+            out[i] = pred + r;
+        }
+    }
+    return i == n;
+}
+
+FlacData decodeFlac(const std::string& path) {
+    FlacData flac;
+    const auto bytes = readFile(path);
+    flac.fileSize = bytes.size();
+    if (bytes.size() < 42 || std::memcmp(bytes.data(), "fLaC", 4) != 0) {
+        return flac;
+    }
+    size_t pos = 4;
+    bool last = false;
+    while (!last && pos + 4 <= bytes.size()) {
+        last = (bytes[pos] & 0x80) != 0;
+        const uint32_t type = bytes[pos] & 0x7F;
+        const uint32_t length = (bytes[pos + 1] << 16) | (bytes[pos + 2] << 8) | bytes[pos + 3];
+        if (type == 0) {
+            BitReader br(bytes, pos + 4);
+            br.read(16); br.read(16); br.read(24); br.read(24);
+            flac.sampleRate = br.read(20);
+            flac.channels = br.read(3) + 1;
+            flac.bits = br.read(5) + 1;
+            flac.totalSamples = (static_cast<uint64_t>(br.read(4)) << 32) | br.read(32);
+        }
+        pos += 4 + length;
+    }
+
+    std::vector<std::vector<int64_t>> channels(flac.channels);
+    while (pos + 2 < bytes.size()) {
+        const size_t frameStart = pos;
+        BitReader br(bytes, pos);
+        if (br.read(14) != 0x3FFE) return flac;
+        br.read(2);
+        const uint32_t bsCode = br.read(4);
+        br.read(4);
+        const uint32_t assignment = br.read(4);
+        const uint32_t ssCode = br.read(3);
+        br.read(1);
+        const uint32_t first = br.read(8);
+        uint32_t extra = 0;
+        while (extra < 7 && (first & (0x80 >> extra))) ++extra;
+        for (uint32_t e = 1; e < extra; ++e) br.read(8);
+        uint32_t n = 0;
+        if (bsCode == 6) n = br.read(8) + 1;
+        else if (bsCode == 7) n = br.read(16) + 1;
+        else if (bsCode >= 8) n = 256u << (bsCode - 8);
+        else return flac;
+        const size_t headerEnd = br.bytePos();
+        if (br.read(8) != refCrc8(&bytes[frameStart], headerEnd - frameStart)) flac.crcOk = false;
+        const uint32_t bps = ssCode == 4 ? 16 : (ssCode == 6 ? 24 : flac.bits);
+
+        for (uint32_t ch = 0; ch < flac.channels; ++ch) {
+            const bool side = (assignment == 8 && ch == 1) || (assignment == 9 && ch == 0) || (assignment == 10 && ch == 1);
+            if (!decodeSubframe(br, n, side ? bps + 1 : bps, channels[ch])) return flac;
+        }
+        br.align();
+        const size_t crcPos = br.bytePos();
+        if (br.read(16) != refCrc16(&bytes[frameStart], crcPos - frameStart)) flac.crcOk = false;
+        pos = br.bytePos();
+
+        for (uint32_t i = 0; i < n; ++i) {
+            int64_t a = channels[0][i];
+            int64_t b = flac.channels > 1 ? channels[1][i] : 0;
+            if (assignment == 8) b = a - b;                  // left, side
+            else if (assignment == 9) a = a + b;             // side, right
+            else if (assignment == 10) {                     // mid, side
+                const int64_t mid = (a << 1) | (b & 1);
+                a = (mid + b) >> 1;
+                b = (mid - b) >> 1;
+            }
+            flac.samples.push_back(static_cast<int32_t>(a));
+            if (flac.channels > 1) flac.samples.push_back(static_cast<int32_t>(b));
+        }
+        ++flac.frames;
+    }
+    flac.valid = true;
+    return flac;
+}
+
+ExportSettings baseSettings(const std::string& name, AudioSampleFormat sampleFormat) {
+    ExportSettings settings;
+    settings.outputPath = tempPath(name + ".wav");
+    settings.sampleRate = kRate;
+    settings.sampleFormat = sampleFormat;
+    settings.dithering = DitheringMode::None;
+    settings.renderThreads = 2;
+    settings.blockFrames = 4096;
+    return settings;
+}
+
+double lag1Correlation(const std::vector<double>& x) {
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        den += x[i] * x[i];
+        if (i > 0) num += x[i] * x[i - 1];
+    }
+    return den > 0.0 ? num / den : 0.0;
+}
+
+/// Source used by the clip flag goldens: a 437 Hz sine, so the loops below never hold whole cycles.
+double flagSource(double position) {
+    return 0.5 * std::sin(2.0 * PI * 437.0 * position / kRate);
+}
+
+/**
+ * @brief Render one clip alone and compare the mixdown with golden(frame), the expected source
+ * value at each project frame. Returns the max error; the 128-frame clip edge fades are skipped.
+ */
+double renderClipGolden(const std::string& name, const std::function<void(ClipRenderState&)>& setup,
+                        uint64_t frames, const std::function<double(uint64_t)>& golden,
+                        std::vector<float>* rendered = nullptr) {
+    auto src = std::make_shared<AudioBuffer>();
+    src->channels = 2;
+    src->sampleRate = kRate;
+    src->numFrames = kRate;
+    src->data.resize(static_cast<size_t>(kRate) * 2);
+    for (uint32_t i = 0; i < kRate; ++i) {
+        src->data[i * 2] = src->data[i * 2 + 1] = static_cast<float>(flagSource(i));
+    }
+    src->ready.store(true, std::memory_order_release);
+
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(0, src, 0, 1.0f));
+    ClipRenderState& clip = graph.tracks[0].clips[0];
+    clip.endSample = frames;
+    setup(clip);
+    graph.timelineEndSample = frames;
+
+    const ExportSettings settings = baseSettings(name, AudioSampleFormat::Float32);
+    OfflineExporter::run(graph, settings);
+    const WavData wav = readWav(settings.outputPath);
+    if (!wav.valid || wav.floats.size() != frames * 2) {
+        return 1.0;
+    }
+    const double scale = kHeadroom * std::cos(PI * 0.25);
+    double maxErr = 0.0;
+    for (uint64_t i = 128; i < frames - 128; ++i) {
+        const double expected = scale * golden(i);
+        maxErr = std::max(maxErr, std::abs(wav.floats[i * 2] - expected));
+        maxErr = std::max(maxErr, std::abs(wav.floats[i * 2 + 1] - expected));
+    }
+    if (rendered) {
+        *rendered = wav.floats;
+    }
+    std::filesystem::remove(settings.outputPath);
+    return maxErr;
+}
+
+/// Golden for a looping clip: the pass's own frame, crossfaded over the last 256 frames
+/// into the frame one loop length earlier (the next pass's pre-roll).
+double loopGolden(double within, double span, const std::function<double(double)>& at) {
+    const double seam = 256.0;
+    if (within < span - seam) {
+        return at(within);
+    }
+    const double t = (within - (span - seam)) / seam;
+    return at(within) * (1.0 - t) + at(within - span) * t;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testClipFlags() {
+    std::cout << "\n=== Test: Reversed and looping clips (goldens) ===\n";
+    const uint64_t frames = kRate / 2;
+
+    // Reversed, direct copy: frame f plays source frame (offset + span - 1 - f).
+    double err = renderClipGolden("reversed", [](ClipRenderState& clip) {
+        clip.sampleOffset = 1000;
+        clip.reversed = true;
+    }, frames, [&](uint64_t f) { return flagSource(static_cast<double>(1000 + frames - 1 - f)); });
+    recordTest("Reversed clip plays its span backward", err < 1e-6, "max error " + std::to_string(err));
+
+    // Looping, direct copy: 4800-frame loop from frame 2000, pre-roll crossfaded at each wrap.
+    std::vector<float> looped;
+    err = renderClipGolden("looping", [](ClipRenderState& clip) {
+        clip.sampleOffset = 2000;
+        clip.loopFrames = 4800;
+    }, frames, [](uint64_t f) {
+        return loopGolden(static_cast<double>(f % 4800), 4800.0,
+                          [](double w) { return flagSource(2000.0 + w); });
+    }, &looped);
+    recordTest("Looping clip repeats its loop with crossfaded seams", err < 1e-6,
+               "max error " + std::to_string(err));
+    double maxStep = 0.0;
+    for (size_t i = 128; i + 128 < frames && !looped.empty(); ++i) {
+        maxStep = std::max(maxStep, static_cast<double>(std::abs(looped[(i + 1) * 2] - looped[i * 2])));
+    }
+    const double sineSlope = kHeadroom * std::cos(PI * 0.25) * 0.5 * 2.0 * PI * 437.0 / kRate;
+    recordTest("Loop seams are click-free", !looped.empty() && maxStep < sineSlope * 1.05,
+               "max step " + std::to_string(maxStep) + " vs slope " + std::to_string(sineSlope));
+
+    // Reversed loop: backward over [0, 4800), the next pass continuing from just past the loop.
+    err = renderClipGolden("reversed_loop", [](ClipRenderState& clip) {
+        clip.reversed = true;
+        clip.loopFrames = 4800;
+    }, frames, [](uint64_t f) {
+        return loopGolden(static_cast<double>(f % 4800), 4800.0,
+                          [](double w) { return flagSource(4799.0 - w); });
+    });
+    recordTest("Reversed loop plays backward across wraps", err < 1e-6, "max error " + std::to_string(err));
+
+    // A forward loop from frame 0 has no pre-roll: it dips through silence at each wrap.
+    err = renderClipGolden("looping_dip", [](ClipRenderState& clip) {
+        clip.loopFrames = 4800;
+    }, frames, [](uint64_t f) {
+        const double w = static_cast<double>(f % 4800);
+        const double gain = w >= 4800.0 - 256.0 ? (4800.0 - w) / 256.0 : (f >= 4800 && w < 256.0 ? w / 256.0 : 1.0);
+        return gain * flagSource(w);
+    });
+    recordTest("Loop without pre-roll fades through the seam", err < 1e-6, "max error " + std::to_string(err));
+
+    // Resampled path (half speed): positions advance 0.5 source frames per output frame.
+    err = renderClipGolden("reversed_resampled", [](ClipRenderState& clip) {
+        clip.sampleOffset = 1000;
+        clip.reversed = true;
+        clip.playbackRate = 0.5;
+    }, frames, [&](uint64_t f) {
+        return flagSource(1000.0 + frames * 0.5 - 1.0 - static_cast<double>(f) * 0.5);
+    });
+    recordTest("Reversed clip on the resampled path", err < 1e-3, "max error " + std::to_string(err));
+
+    err = renderClipGolden("looping_resampled", [](ClipRenderState& clip) {
+        clip.sampleOffset = 2000;
+        clip.loopFrames = 4800;
+        clip.playbackRate = 0.5;
+    }, frames, [](uint64_t f) {
+        const double position = static_cast<double>(f) * 0.5;
+        return loopGolden(std::fmod(position, 4800.0), 4800.0,
+                          [](double w) { return flagSource(2000.0 + w); });
+    });
+    recordTest("Looping clip on the resampled path", err < 1e-3, "max error " + std::to_string(err));
+}
+
+void testFloatMixdown() {
+    std::cout << "\n=== Test: Float WAV mixdown ===\n";
+    const AudioGraph graph = makeProject();
+    ExportSettings settings = baseSettings("mix_float", AudioSampleFormat::Float32);
+    const ExportResult result = OfflineExporter::run(graph, settings);
+    recordTest("Export succeeds", result.success, result.error);
+
+    const WavData wav = readWav(settings.outputPath);
+    recordTest("WAV header is IEEE float stereo at the project rate",
+               wav.valid && wav.format == 3 && wav.channels == 2 && wav.sampleRate == kRate && wav.bits == 32);
+    recordTest("RIFF size matches the file", wav.riffSize + 8 == wav.fileSize);
+    recordTest("Length is the timeline (not a multiple of the block size)",
+               wav.floats.size() == static_cast<size_t>(kRate) * 2 * 2 && result.framesRendered == kRate * 2);
+
+    // Master stage: headroom only. Skip the clip edge fades (128 frames).
+    double maxErr = 0.0;
+    for (uint64_t i = 128; i < kRate * 2 - 128 && wav.valid; ++i) {
+        if (i >= kRate - 128 && i < kRate + 128) continue;
+        const double expected = kHeadroom * (expectedStem(0, i) + expectedStem(1, i));
+        maxErr = std::max(maxErr, std::abs(wav.floats[i * 2] - expected));
+        maxErr = std::max(maxErr, std::abs(wav.floats[i * 2 + 1] - expected));
+    }
+    recordTest("Mix matches the project from the first block (no gain ramp-in)", wav.valid && maxErr < 1e-6,
+               "max error " + std::to_string(maxErr));
+    recordTest("Realtime factor is reported", result.realtimeFactor > 0.0 && result.renderSeconds > 0.0,
+               std::to_string(result.realtimeFactor) + "x");
+}
+
+void testStems() {
+    std::cout << "\n=== Test: Stems in one pass ===\n";
+    const AudioGraph graph = makeProject();
+    ExportSettings settings = baseSettings("stems_mix", AudioSampleFormat::Float32);
+    settings.exportStems = true;
+    settings.stemDirectory = tempPath("stems");
+    settings.stemNames = {"Lead/Vox", ""};
+    const ExportResult result = OfflineExporter::run(graph, settings);
+    recordTest("Export with stems succeeds", result.success && result.files.size() == 3, result.error);
+    if (result.files.size() != 3) {
+        return;
+    }
+
+    const std::string stemDir = settings.stemDirectory;
+    recordTest("Stem files are named after their tracks",
+               result.files[1] == (std::filesystem::path(stemDir) / "Lead_Vox.wav").string() &&
+               result.files[2] == (std::filesystem::path(stemDir) / "Track 2.wav").string());
+
+    const WavData mix = readWav(result.files[0]);
+    const WavData stem0 = readWav(result.files[1]);
+    const WavData stem1 = readWav(result.files[2]);
+    const bool sameLength = mix.valid && stem0.valid && stem1.valid &&
+                            stem0.floats.size() == mix.floats.size() && stem1.floats.size() == mix.floats.size();
+    recordTest("Stems are as long as the mix", sameLength);
+    if (!sameLength) {
+        return;
+    }
+
+    double stemErr = 0.0;
+    double sumErr = 0.0;
+    float leadIn = 0.0f;
+    for (uint64_t i = 0; i < kRate * 2; ++i) {
+        const bool edge = i < 128 || (i >= kRate - 128 && i < kRate + 128) || i >= kRate * 2 - 128;
+        if (!edge) {
+            stemErr = std::max(stemErr, std::abs(stem0.floats[i * 2] - expectedStem(0, i)));
+            stemErr = std::max(stemErr, std::abs(stem1.floats[i * 2] - expectedStem(1, i)));
+        }
+        if (i < kRate) {
+            leadIn = std::max(leadIn, std::abs(stem1.floats[i * 2]));
+        }
+        for (int ch = 0; ch < 2; ++ch) {
+            const double summed = kHeadroom * (stem0.floats[i * 2 + ch] + stem1.floats[i * 2 + ch]);
+            sumErr = std::max(sumErr, std::abs(summed - mix.floats[i * 2 + ch]));
+        }
+    }
+    recordTest("Each stem is its track's post-fader output", stemErr < 1e-6, "max error " + std::to_string(stemErr));
+    recordTest("Stem is silent while its track has no clip", leadIn == 0.0f);
+    recordTest("Stems through the master stage sum to the mix", sumErr < 1e-6, "max error " + std::to_string(sumErr));
+}
+
+void testDithering() {
+    std::cout << "\n=== Test: Quantization and dithering ===\n";
+    AudioGraph graph = makeProject();
+    graph.timelineEndSample = kRate * 3;   // Last second is digital silence
+
+    ExportSettings floatSettings = baseSettings("dither_ref", AudioSampleFormat::Float32);
+    OfflineExporter::run(graph, floatSettings);
+    const WavData ref = readWav(floatSettings.outputPath);
+
+    auto exportInt = [&](const std::string& name, AudioSampleFormat format, DitheringMode mode) {
+        ExportSettings settings = baseSettings(name, format);
+        settings.dithering = mode;
+        OfflineExporter::run(graph, settings);
+        return readWav(settings.outputPath);
+    };
+
+    const WavData plain = exportInt("dither_none", AudioSampleFormat::Int16, DitheringMode::None);
+    bool exact = plain.valid && ref.valid && plain.bits == 16 && plain.ints.size() == ref.floats.size();
+    for (size_t i = 0; exact && i < ref.floats.size(); ++i) {
+        const double q = std::clamp(std::nearbyint(static_cast<double>(ref.floats[i]) * 32768.0), -32768.0, 32767.0);
+        exact = plain.ints[i] == static_cast<int32_t>(q);
+    }
+    recordTest("Undithered 16-bit is the rounded float mix", exact);
+
+    const WavData pcm24 = exportInt("dither_24", AudioSampleFormat::Int24, DitheringMode::None);
+    bool exact24 = pcm24.valid && pcm24.bits == 24 && pcm24.ints.size() == ref.floats.size();
+    for (size_t i = 0; exact24 && i < ref.floats.size(); ++i) {
+        exact24 = pcm24.ints[i] == static_cast<int32_t>(std::nearbyint(static_cast<double>(ref.floats[i]) * 8388608.0));
+    }
+    recordTest("Undithered 24-bit is the rounded float mix", exact24);
+
+    // Requantization error per dither mode (left channel, in LSBs).
+    auto errorOf = [&](const WavData& wav) {
+        std::vector<double> err;
+        for (size_t i = 0; i < ref.floats.size() && i < wav.ints.size(); i += 2) {
+            err.push_back(wav.ints[i] - static_cast<double>(ref.floats[i]) * 32768.0);
+        }
+        return err;
+    };
+    const WavData tpdf = exportInt("dither_tpdf", AudioSampleFormat::Int16, DitheringMode::Triangular);
+    const WavData shaped = exportInt("dither_shaped", AudioSampleFormat::Int16, DitheringMode::NoiseShaped);
+    const auto tpdfErr = errorOf(tpdf);
+    const auto shapedErr = errorOf(shaped);
+
+    double tpdfMax = 0.0, tpdfMean = 0.0;
+    for (double e : tpdfErr) {
+        tpdfMax = std::max(tpdfMax, std::abs(e));
+        tpdfMean += e;
+    }
+    tpdfMean /= std::max<size_t>(tpdfErr.size(), 1);
+    recordTest("TPDF error stays within 1.5 LSB and is unbiased",
+               !tpdfErr.empty() && tpdfMax <= 1.5 && std::abs(tpdfMean) < 0.01,
+               "max " + std::to_string(tpdfMax) + " mean " + std::to_string(tpdfMean));
+
+    const double tpdfCorr = lag1Correlation(tpdfErr);
+    const double shapedCorr = lag1Correlation(shapedErr);
+    recordTest("TPDF error is white", std::abs(tpdfCorr) < 0.05, "lag-1 " + std::to_string(tpdfCorr));
+    recordTest("Noise-shaped error is pushed towards high frequencies", shapedCorr < -0.5,
+               "lag-1 " + std::to_string(shapedCorr));
+
+    bool silentPlain = true;
+    bool ditheredTail = false;
+    for (size_t i = static_cast<size_t>(kRate) * 2 * 2 + 256; i < plain.ints.size() && i < tpdf.ints.size(); ++i) {
+        silentPlain = silentPlain && plain.ints[i] == 0;
+        ditheredTail = ditheredTail || tpdf.ints[i] != 0;
+    }
+    recordTest("Silence stays zero without dither and carries dither with it", silentPlain && ditheredTail);
+}
+
+void testFlac() {
+    std::cout << "\n=== Test: FLAC encoding ===\n";
+    const AudioGraph graph = makeProject();
+    for (AudioSampleFormat format : {AudioSampleFormat::Int16, AudioSampleFormat::Int24}) {
+        const std::string bits = format == AudioSampleFormat::Int16 ? "16" : "24";
+        ExportSettings wavSettings = baseSettings("flac_ref" + bits, format);
+        OfflineExporter::run(graph, wavSettings);
+        const WavData wav = readWav(wavSettings.outputPath);
+
+        ExportSettings settings = baseSettings("flac" + bits, format);
+        settings.format = AudioFileFormat::Flac;
+        settings.outputPath = tempPath("flac" + bits + ".flac");
+        const ExportResult result = OfflineExporter::run(graph, settings);
+        const FlacData flac = decodeFlac(settings.outputPath);
+
+        recordTest(bits + "-bit FLAC export succeeds", result.success && flac.valid, result.error);
+        recordTest(bits + "-bit STREAMINFO describes the stream",
+                   flac.sampleRate == kRate && flac.channels == 2 && flac.bits == std::stoul(bits) &&
+                   flac.totalSamples == kRate * 2 && flac.frames == (kRate * 2 + 4095) / 4096);
+        recordTest(bits + "-bit frame CRCs are valid", flac.valid && flac.crcOk);
+        recordTest(bits + "-bit FLAC decodes to the same samples as WAV",
+                   wav.valid && flac.valid && flac.samples == wav.ints);
+        recordTest(bits + "-bit FLAC is smaller than WAV", flac.fileSize * 2 < wav.fileSize,
+                   std::to_string(flac.fileSize) + " vs " + std::to_string(wav.fileSize) + " bytes");
+    }
+}
+
+void testCancelAndErrors() {
+    std::cout << "\n=== Test: Cancellation and errors ===\n";
+    const AudioGraph graph = makeProject();
+
+    ExportSettings settings = baseSettings("cancel", AudioSampleFormat::Int24);
+    int calls = 0;
+    const ExportResult cancelled = OfflineExporter::run(graph, settings, [&](double) { return ++calls < 3; });
+    recordTest("Progress callback cancels the export",
+               cancelled.cancelled && !cancelled.success && cancelled.framesRendered == 3 * 4096);
+    recordTest("Cancelled export leaves no file", !std::filesystem::exists(settings.outputPath));
+
+    ExportSettings flacFloat = baseSettings("flac_float", AudioSampleFormat::Float32);
+    flacFloat.format = AudioFileFormat::Flac;
+    recordTest("FLAC refuses float samples", !OfflineExporter::run(graph, flacFloat).success);
+
+    ExportSettings badPath = baseSettings("bad", AudioSampleFormat::Int16);
+    badPath.outputPath = tempPath("missing_dir/sub/out.wav");
+    const ExportResult bad = OfflineExporter::run(graph, badPath);
+    recordTest("Unwritable path is reported", !bad.success && !bad.error.empty(), bad.error);
+
+    AudioQualitySettings quality;
+    quality.dithering = DitheringMode::NoiseShaped;
+    quality.resampling = ResamplingMode::High;
+    ExportSettings fromQuality;
+    fromQuality.applyQualitySettings(quality);
+    recordTest("Dither and resampling come from AudioQualitySettings",
+               fromQuality.dithering == DitheringMode::NoiseShaped && fromQuality.resampling == SRCQuality::Sinc8);
+}
+
+void testRealtimeFactor() {
+    std::cout << "\n=== Test: Faster than realtime ===\n";
+    AudioGraph graph;
+    const uint32_t seconds = 20;
+    for (uint32_t t = 0; t < 32; ++t) {
+        graph.tracks.push_back(makeTrack(t, makeSine(100.0 + 37.0 * t, 0.05, kRate * seconds), 0, 0.8f));
+    }
+    graph.timelineEndSample = static_cast<uint64_t>(kRate) * seconds;
+
+    ExportSettings settings = baseSettings("speed", AudioSampleFormat::Int24);
+    settings.renderThreads = 0;   // Every spare core
+    settings.dithering = DitheringMode::Triangular;
+    const ExportResult result = OfflineExporter::run(graph, settings);
+    recordTest("32 tracks x 20 s export faster than realtime", result.success && result.realtimeFactor > 1.0,
+               std::to_string(result.realtimeFactor) + "x realtime, " + std::to_string(result.renderSeconds) + " s");
+}
+
+void testLoudness() {
+    std::cout << "\n=== Test: Mix loudness report and normalisation ===\n";
+    const AudioGraph graph = makeProject();
+    auto measureFile = [](const std::string& path) {
+        const WavData wav = readWav(path);
+        LoudnessMeter meter;
+        meter.prepare(kRate);
+        meter.process(wav.floats.data(), static_cast<uint32_t>(wav.floats.size() / 2));
+        return meter.readings();
+    };
+
+    ExportSettings settings = baseSettings("loudness", AudioSampleFormat::Float32);
+    const ExportResult plain = OfflineExporter::run(graph, settings);
+    const LoudnessReadings written = measureFile(settings.outputPath);
+    recordTest("Export reports the written mix's loudness and true peak",
+               plain.success && std::isfinite(plain.loudness.integratedLufs) &&
+                   std::abs(plain.loudness.integratedLufs - written.integratedLufs) < 1e-3f &&
+                   plain.loudness.truePeakL == written.truePeakL && plain.normalizationGainDb == 0.0f,
+               std::to_string(plain.loudness.integratedLufs) + " LUFS");
+
+    settings.normalizeLoudness = true;
+    settings.targetLufs = -23.0f;
+    std::vector<double> fractions;
+    const ExportResult normalized = OfflineExporter::run(graph, settings, [&](double p) {
+        fractions.push_back(p);
+        return true;
+    });
+    const LoudnessReadings target = measureFile(settings.outputPath);
+    recordTest("Normalised mix reaches the target loudness",
+               normalized.success && std::abs(target.integratedLufs + 23.0f) < 0.1f &&
+                   std::abs(normalized.loudness.integratedLufs - target.integratedLufs) < 1e-3f,
+               std::to_string(target.integratedLufs) + " LUFS, gain " + std::to_string(normalized.normalizationGainDb) + " dB");
+    recordTest("Progress covers both passes in order",
+               !fractions.empty() && std::is_sorted(fractions.begin(), fractions.end()) &&
+                   fractions.front() <= 0.5 && std::abs(fractions.back() - 1.0) < 1e-9);
+
+    settings.targetLufs = 0.0f;   // Unreachable without clipping
+    const ExportResult capped = OfflineExporter::run(graph, settings);
+    const LoudnessReadings loud = measureFile(settings.outputPath);
+    const float peakDb = LoudnessMeter::toDecibels(std::max(loud.truePeakL, loud.truePeakR));
+    recordTest("True-peak ceiling limits the normalisation gain",
+               capped.success && peakDb <= settings.truePeakCeilingDb + 0.05f && loud.integratedLufs < -1.0f,
+               std::to_string(peakDb) + " dBTP");
+
+    // The safety stage's soft clip is not linear: gain alone can't predict the result.
+    settings.safetyProcessing = true;
+    settings.targetLufs = -10.0f;
+    const ExportResult clipped = OfflineExporter::run(graph, settings);
+    const LoudnessReadings soft = measureFile(settings.outputPath);
+    recordTest("Normalisation through the soft clip reaches the target",
+               clipped.success && std::abs(soft.integratedLufs + 10.0f) < 0.15f,
+               std::to_string(soft.integratedLufs) + " LUFS, gain " + std::to_string(clipped.normalizationGainDb) + " dB");
+
+    settings.targetLufs = 0.0f;
+    settings.truePeakCeilingDb = -3.0f;
+    const ExportResult softCapped = OfflineExporter::run(graph, settings);
+    const LoudnessReadings softLoud = measureFile(settings.outputPath);
+    const float softPeakDb = LoudnessMeter::toDecibels(std::max(softLoud.truePeakL, softLoud.truePeakR));
+    recordTest("Soft-clipped normalisation stays under the true-peak ceiling",
+               softCapped.success && softPeakDb <= settings.truePeakCeilingDb + 0.05f &&
+                   softPeakDb > settings.truePeakCeilingDb - 0.5f,
+               std::to_string(softPeakDb) + " dBTP");
+    std::filesystem::remove(settings.outputPath);
+}
+
+/// Decodes the same sine makeSine() stores, so a streamed clip can be checked against it.
+class SineDecoder : public StreamDecoder {
+public:
+    SineDecoder(double freq, double amp, uint64_t frames) : m_freq(freq), m_amp(amp), m_frames(frames) {}
+    uint32_t sampleRate() const override { return kRate; }
+    uint32_t sourceChannels() const override { return 2; }
+    uint64_t numFrames() const override { return m_frames; }
+    bool seek(uint64_t frame) override { m_position = frame; return true; }
+    uint32_t read(float* dst, uint32_t frames) override {
+        const uint64_t n = std::min<uint64_t>(frames, m_frames - std::min(m_position, m_frames));
+        for (uint64_t i = 0; i < n; ++i) {
+            dst[i * 2] = dst[i * 2 + 1] = static_cast<float>(sineAt(m_freq, m_amp, m_position + i));
+        }
+        m_position += n;
+        return static_cast<uint32_t>(n);
+    }
+
+private:
+    double m_freq;
+    double m_amp;
+    uint64_t m_frames;
+    uint64_t m_position{0};
+};
+
+void testStreamedClip() {
+    std::cout << "\n=== Test: Ring-streamed clips ===\n";
+    // No I/O threads: only the exporter itself can fill the ring, and a quarter-second
+    // ring has to be refilled many times over the clip.
+    StreamIOPool::getInstance().setThreadCount(0);
+    const uint32_t frames = kRate * 3;
+    auto ring = std::make_shared<RingStreamSource>(std::make_unique<SineDecoder>(440.0, 0.5, frames),
+                                                   "sine-export", kRate / 4);
+    StreamIOPool::getInstance().add(ring);
+    auto streamed = std::make_shared<AudioBuffer>();
+    streamed->channels = 2;
+    streamed->sampleRate = kRate;
+    streamed->numFrames = frames;
+    streamed->isStreaming = true;
+    streamed->stream = ring;
+    streamed->ready.store(true, std::memory_order_release);
+
+    // Golden: the same clip from memory. It starts a quarter second in, so the first
+    // blocks only cue it.
+    auto project = [&](const std::shared_ptr<AudioBuffer>& buffer) {
+        AudioGraph graph;
+        graph.tracks.push_back(makeTrack(0, buffer, kRate / 4, 0.8f));
+        graph.tracks[0].clips[0].audioData = buffer->isStreaming ? nullptr : buffer->data.data();
+        graph.tracks[0].clips[0].stream = buffer->isStreaming ? buffer->stream.get() : nullptr;
+        graph.timelineEndSample = kRate / 4 + frames;
+        return graph;
+    };
+    const AudioGraph streamedGraph = project(streamed);
+    const AudioGraph memoryGraph = project(makeSine(440.0, 0.5, frames));
+
+    struct Case {
+        const char* label;
+        uint64_t startSample;
+        bool normalize;
+    };
+    for (const Case& c : {Case{"Streamed clip exports like the same clip from memory", 0, false},
+                          Case{"Export starting mid-clip reads it from the first block", kRate + 123, false},
+                          Case{"Normalising re-reads the stream for every pass", 0, true}}) {
+        ExportSettings settings = baseSettings("streamed", AudioSampleFormat::Float32);
+        settings.startSample = c.startSample;
+        settings.normalizeLoudness = c.normalize;
+        settings.targetLufs = -16.0f;
+        const uint64_t underrunsBefore = ring->underruns();
+        const ExportResult disk = OfflineExporter::run(streamedGraph, settings);
+        const WavData a = readWav(settings.outputPath);
+        const ExportResult memory = OfflineExporter::run(memoryGraph, settings);
+        const WavData b = readWav(settings.outputPath);
+        const uint64_t underruns = ring->underruns() - underrunsBefore;
+        recordTest(c.label,
+                   disk.success && memory.success && a.valid && b.valid && !a.floats.empty() &&
+                       a.floats == b.floats && underruns == 0,
+                   std::to_string(underruns) + " underruns, " +
+                       std::to_string(disk.loudness.integratedLufs) + " vs " +
+                       std::to_string(memory.loudness.integratedLufs) + " LUFS");
+        std::filesystem::remove(settings.outputPath);
+    }
+    StreamIOPool::getInstance().setThreadCount(2);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Offline Export Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testFloatMixdown();
+    testStems();
+    testClipFlags();
+    testDithering();
+    testFlac();
+    testCancelAndErrors();
+    testRealtimeFactor();
+    testLoudness();
+    testStreamedClip();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,400 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for RTWorkerPool, parallel AudioEngine track rendering and per-channel metering
+
+#include "AudioEngine.h"
+#include "AudioGraph.h"
+#include "ChannelSlotMap.h"
+#include "MeterSnapshot.h"
+#include "RTWorkerPool.h"
+#include "SamplePool.h"
+#include "NomadLog.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+std::shared_ptr<AudioBuffer> makeSineBuffer(uint32_t sampleRate, uint32_t frames, double frequencyHz) {
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = sampleRate;
+    buffer->numFrames = frames;
+    buffer->data.resize(static_cast<size_t>(frames) * 2);
+    for (uint32_t i = 0; i < frames; ++i) {
+        const double t = static_cast<double>(i) / static_cast<double>(sampleRate);
+        buffer->data[static_cast<size_t>(i) * 2] = static_cast<float>(0.1 * std::sin(2.0 * PI * frequencyHz * t));
+        buffer->data[static_cast<size_t>(i) * 2 + 1] = static_cast<float>(0.1 * std::cos(2.0 * PI * frequencyHz * t));
+    }
+    buffer->ready.store(true, std::memory_order_release);
+    return buffer;
+}
+
+// Mixed graph: alternating native-rate / resampled clips, varied volume & pan.
+AudioGraph buildGraph(const std::vector<std::shared_ptr<AudioBuffer>>& sources, uint32_t tracks) {
+    AudioGraph graph;
+    graph.timelineEndSample = 48000 * 4;
+    for (uint32_t i = 0; i < tracks; ++i) {
+        const auto& src = sources[i % sources.size()];
+        TrackRenderState tr;
+        tr.trackId = i + 1;
+        tr.trackIndex = i;
+        tr.volume = 0.5f + 0.01f * static_cast<float>(i);
+        tr.pan = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(tracks);
+
+        ClipRenderState clip;
+        clip.buffer = src;
+        clip.audioData = src->data.data();
+        clip.startSample = (i % 5) * 300;
+        clip.endSample = graph.timelineEndSample - (i % 3) * 1000;
+        clip.sampleOffset = i * 7;
+        clip.totalFrames = src->numFrames;
+        clip.sourceSampleRate = static_cast<double>(src->sampleRate);
+        clip.gain = 0.9f;
+        tr.clips.push_back(clip);
+        graph.tracks.push_back(std::move(tr));
+    }
+    return graph;
+}
+
+std::vector<float> renderBlocks(AudioEngine& engine, const AudioGraph& graph, uint32_t blocks, uint32_t frames) {
+    engine.setSampleRate(48000);
+    engine.setBufferConfig(frames, 2);
+    engine.setGraph(graph);
+
+    AudioQueueCommand cmd;
+    cmd.type = AudioQueueCommandType::SetTransportState;
+    cmd.value1 = 1.0f;
+    cmd.samplePos = 0;
+    engine.commandQueue().push(cmd);
+
+    std::vector<float> out(static_cast<size_t>(blocks) * frames * 2);
+    for (uint32_t b = 0; b < blocks; ++b) {
+        if (b == blocks / 2) {
+            // Mid-run parameter changes exercise the per-track ramps.
+            AudioQueueCommand vol;
+            vol.type = AudioQueueCommandType::SetTrackVolume;
+            vol.trackIndex = 3;
+            vol.value1 = 0.2f;
+            engine.commandQueue().push(vol);
+        }
+        engine.processBlock(out.data() + static_cast<size_t>(b) * frames * 2, nullptr, frames, 0.0);
+    }
+    return out;
+}
+
+void sumTask(void* context, uint32_t index) {
+    auto* counts = static_cast<std::atomic<uint32_t>*>(context);
+    counts[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testPoolExecutesEveryTaskOnce() {
+    std::cout << "\n=== Test: Every task executes exactly once ===\n";
+
+    RTWorkerPool pool;
+    pool.start(3);
+
+    constexpr uint32_t kTasks = 257;
+    std::vector<std::atomic<uint32_t>> counts(kTasks);
+    bool ok = true;
+    for (uint32_t iter = 0; iter < 2000 && ok; ++iter) {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        const uint32_t n = 1 + (iter % kTasks);
+        pool.run(&sumTask, counts.data(), n);
+        for (uint32_t i = 0; i < kTasks; ++i) {
+            const uint32_t expected = (i < n) ? 1u : 0u;
+            if (counts[i].load(std::memory_order_relaxed) != expected) {
+                ok = false;
+                break;
+            }
+        }
+    }
+    recordTest("Tasks run exactly once across 2000 dispatches", ok);
+
+    uint64_t total = 0;
+    for (uint32_t p = 0; p < pool.getParticipantCount(); ++p) {
+        total += pool.getStats(p).tasksExecuted.load(std::memory_order_relaxed);
+    }
+    recordTest("Participant stats account for all tasks", total > 0,
+               "tasks=" + std::to_string(total) + " dispatches=" + std::to_string(pool.getDispatchCount()));
+    pool.stop();
+    recordTest("Pool stops cleanly", !pool.isRunning());
+}
+
+void testInlineFallback() {
+    std::cout << "\n=== Test: Inline fallback without workers ===\n";
+
+    RTWorkerPool pool;
+    std::vector<std::atomic<uint32_t>> counts(16);
+    pool.run(&sumTask, counts.data(), 16);
+    bool ok = true;
+    for (auto& c : counts) ok = ok && (c.load() == 1);
+    recordTest("run() executes inline when no workers are started", ok);
+}
+
+void testParallelMatchesSerial() {
+    std::cout << "\n=== Test: Parallel render is bit-identical to serial ===\n";
+
+    std::vector<std::shared_ptr<AudioBuffer>> sources = {
+        makeSineBuffer(48000, 48000 * 4, 220.0),
+        makeSineBuffer(44100, 44100 * 4, 330.0),
+        makeSineBuffer(96000, 96000 * 4, 550.0),
+    };
+    const AudioGraph graph = buildGraph(sources, 48);
+    constexpr uint32_t kBlocks = 200;
+    constexpr uint32_t kFrames = 256;
+
+    AudioEngine serial;
+    const auto ref = renderBlocks(serial, graph, kBlocks, kFrames);
+
+    AudioEngine parallel;
+    parallel.setRenderThreadCount(3);
+    parallel.setParallelRenderMinTracks(2);
+    const auto out = renderBlocks(parallel, graph, kBlocks, kFrames);
+
+    const bool identical = std::memcmp(ref.data(), out.data(), ref.size() * sizeof(float)) == 0;
+    recordTest("Parallel output matches serial output", identical);
+    recordTest("Parallel path was used", parallel.telemetry().getParallelRenderBlocks() == kBlocks,
+               "parallelBlocks=" + std::to_string(parallel.telemetry().getParallelRenderBlocks()));
+    recordTest("Serial engine never dispatched", serial.telemetry().getParallelRenderBlocks() == 0);
+
+    // Runtime toggle: disabling falls back to serial without touching the workers.
+    parallel.setParallelRenderingEnabled(false);
+    const uint64_t before = parallel.telemetry().getParallelRenderBlocks();
+    std::vector<float> block(kFrames * 2);
+    parallel.processBlock(block.data(), nullptr, kFrames, 0.0);
+    recordTest("Disabling parallel rendering takes effect next block",
+               parallel.telemetry().getParallelRenderBlocks() == before);
+}
+
+void testChannelMeters() {
+    std::cout << "\n=== Test: Per-track meters from the engine path ===\n";
+
+    std::vector<std::shared_ptr<AudioBuffer>> sources = {
+        makeSineBuffer(48000, 48000 * 4, 220.0),
+        makeSineBuffer(44100, 44100 * 4, 330.0),
+    };
+    constexpr uint32_t kTracks = 126;   // Plus one bus: every channel slot below master
+    constexpr uint32_t kFrames = 512;
+    AudioGraph graph = buildGraph(sources, kTracks);
+    BusRenderState bus;
+    bus.busId = 7;
+    bus.volume = 0.5f;
+    graph.buses.push_back(bus);
+    graph.tracks[0].outputBus = 0;
+
+    auto meters = std::make_shared<MeterSnapshotBuffer>();
+    AudioEngine engine;
+    engine.setMeterSnapshots(meters);
+    renderBlocks(engine, graph, 4, kFrames);
+
+    ChannelSlotMap slots;
+    slots.rebuild(graph);
+    bool allLive = true;
+    for (uint32_t t = 0; t < kTracks; ++t) {
+        float peakL, peakR, rmsL, rmsR;
+        bool clipL, clipR;
+        meters->readSnapshot(slots.getSlotIndex(graph.tracks[t].trackId), peakL, peakR, clipL, clipR);
+        meters->readRms(slots.getSlotIndex(graph.tracks[t].trackId), rmsL, rmsR);
+        // Hard-panned tracks are silent on one side.
+        allLive &= peakL + peakR > 0.0f && rmsL + rmsR > 0.0f && rmsL <= peakL && rmsR <= peakR &&
+                   !clipL && !clipR;
+    }
+    recordTest("Every playing track publishes peak and RMS", allLive);
+
+    float busL, busR, masterL, masterR;
+    bool clipL, clipR;
+    meters->readSnapshot(slots.getBusSlotIndex(7), busL, busR, clipL, clipR);
+    meters->readSnapshot(ChannelSlotMap::MASTER_SLOT_INDEX, masterL, masterR, clipL, clipR);
+    recordTest("Bus and master slots are metered", busL > 0.0f && masterL > 0.0f,
+               "bus=" + std::to_string(busL) + " master=" + std::to_string(masterL));
+    recordTest("Master slot matches the engine's master peak",
+               std::abs(masterL - engine.getPeakL()) < 1e-6f && std::abs(masterR - engine.getPeakR()) < 1e-6f);
+
+    // A track's meter is its post-fader output: compare with a one-track engine.
+    AudioGraph single;
+    single.timelineEndSample = graph.timelineEndSample;
+    single.tracks.push_back(graph.tracks[5]);
+    single.tracks[0].trackIndex = 0;
+    auto singleMeters = std::make_shared<MeterSnapshotBuffer>();
+    AudioEngine reference;
+    reference.setMeterSnapshots(singleMeters);
+    renderBlocks(reference, single, 4, kFrames);
+    float refL, refR, gotL, gotR;
+    singleMeters->readSnapshot(0, refL, refR, clipL, clipR);
+    meters->readSnapshot(slots.getSlotIndex(graph.tracks[5].trackId), gotL, gotR, clipL, clipR);
+    recordTest("Track meter equals the track's own output level", std::abs(refL - gotL) < 1e-6f,
+               "ref=" + std::to_string(refL) + " got=" + std::to_string(gotL));
+
+    // Parallel rendering meters the same values as serial rendering.
+    auto parallelMeters = std::make_shared<MeterSnapshotBuffer>();
+    AudioEngine parallel;
+    parallel.setRenderThreadCount(3);
+    parallel.setParallelRenderMinTracks(2);
+    parallel.setMeterSnapshots(parallelMeters);
+    renderBlocks(parallel, graph, 4, kFrames);
+    bool same = true;
+    for (uint32_t slot = 0; slot < MeterSnapshotBuffer::MAX_CHANNELS; ++slot) {
+        float aL, aR, bL, bR;
+        meters->readSnapshot(slot, aL, aR, clipL, clipR);
+        parallelMeters->readSnapshot(slot, bL, bR, clipL, clipR);
+        same &= aL == bL && aR == bR;
+    }
+    recordTest("Parallel meters match serial meters", same);
+
+    // Stopping the transport lets every meter fall to zero.
+    AudioQueueCommand stop;
+    stop.type = AudioQueueCommandType::SetTransportState;
+    stop.value1 = 0.0f;
+    engine.commandQueue().push(stop);
+    std::vector<float> block(kFrames * 2);
+    for (int b = 0; b < 8; ++b) {
+        engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+    }
+    float stoppedL, stoppedR;
+    meters->readSnapshot(0, stoppedL, stoppedR, clipL, clipR);
+    recordTest("Meters fall to zero when stopped", stoppedL == 0.0f && stoppedR == 0.0f);
+}
+
+void testMeteringBudget() {
+    std::cout << "\n=== Test: Metering cost at 128 tracks ===\n";
+
+    std::vector<std::shared_ptr<AudioBuffer>> sources = {makeSineBuffer(48000, 48000 * 4, 220.0)};
+    constexpr uint32_t kTracks = 128;
+    constexpr uint32_t kFrames = 512;
+    constexpr int kBlocks = 400;
+    const AudioGraph graph = buildGraph(sources, kTracks);
+
+    auto timeBlocks = [&](bool metered) {
+        AudioEngine engine;
+        if (metered) {
+            engine.setMeterSnapshots(std::make_shared<MeterSnapshotBuffer>());
+        }
+        renderBlocks(engine, graph, 8, kFrames);   // Warm-up
+        std::vector<float> block(kFrames * 2);
+        double best = 1e30;
+        for (int round = 0; round < 3; ++round) {
+            engine.setGlobalSamplePos(0);
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int b = 0; b < kBlocks; ++b) {
+                engine.processBlock(block.data(), nullptr, kFrames, 0.0);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(t1 - t0).count() / kBlocks);
+        }
+        return best;
+    };
+
+    const double plainUs = timeBlocks(false);
+    const double meteredUs = timeBlocks(true);
+    const double overheadUs = std::max(0.0, meteredUs - plainUs);
+    // Budget: metering may take at most 2% of the block's real-time period.
+    const double budgetUs = 0.02 * 1e6 * kFrames / 48000.0;
+
+    std::cout << "  Block: " << plainUs << " us unmetered, " << meteredUs << " us metered (" << overheadUs
+              << " us for " << kTracks << " tracks, budget " << budgetUs << " us)\n";
+    recordTest("Metering 128 tracks stays within budget", overheadUs <= budgetUs,
+               "overhead=" + std::to_string(overheadUs) + "us");
+}
+
+void testDispatchLatency() {
+    std::cout << "\n=== Test: Dispatch latency ===\n";
+
+    RTWorkerPool pool;
+    pool.start(3);
+    std::vector<std::atomic<uint32_t>> counts(64);
+
+    constexpr int kIterations = 20000;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        pool.run(&sumTask, counts.data(), 64);
+    }
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    const double avgUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / kIterations;
+
+    std::cout << "  Average dispatch (64 trivial tasks, 3 workers): " << avgUs << " us\n";
+    recordTest("Dispatch completes", avgUs > 0.0);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Parallel Render Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Warning);
+
+    testPoolExecutesEveryTaskOnce();
+    testInlineFallback();
+    testParallelMatchesSerial();
+    testChannelMeters();
+    testMeteringBudget();
+    testDispatchLatency();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
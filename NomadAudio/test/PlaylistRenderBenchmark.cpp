@@ -0,0 +1,140 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Playlist render cost per audio block as clip counts grow: 100 lanes of overlapping clips,
+// built from a PlaylistRuntimeSnapshot and played through AudioEngine
+
+#include "AudioEngine.h"
+#include "AudioGraphBuilder.h"
+#include "PlaylistModel.h"
+#include "NomadLog.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile double g_sink = 0.0;
+
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kBlockFrames = 512;
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per call.
+ */
+double nsPerCall(double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    fn();   // Warm-up
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        fn();
+        ++iterations;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+}
+
+/// Clips last 0.5 s and start every 0.45 s, so neighbours overlap by 50 ms.
+void fillPlaylist(PlaylistModel& playlist, ClipSourceID source, uint32_t lanes, uint32_t clipsPerLane) {
+    const SampleIndex length = kRate / 2;
+    const SampleIndex spacing = kRate * 45 / 100;
+    for (uint32_t l = 0; l < lanes; ++l) {
+        const PlaylistLaneID lane = playlist.createLane("Lane " + std::to_string(l + 1));
+        for (uint32_t c = 0; c < clipsPerLane; ++c) {
+            PlaylistClip clip(source);
+            clip.startTime = static_cast<SampleIndex>(c) * spacing;
+            clip.length = length;
+            clip.sourceStart = (l * 977 + c * 131) % kRate;
+            clip.gainLinear = 0.01f;
+            clip.fadeInLength = 256;
+            clip.fadeOutLength = 256;
+            playlist.addClip(lane, clip);
+        }
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t lanes = 100;
+    double minMs = 500.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--lanes" && i + 1 < argc) lanes = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    // Two seconds of stereo noise-like material shared by every clip.
+    SourceManager sources;
+    auto data = std::make_shared<AudioBufferData>();
+    data->sampleRate = kRate;
+    data->numChannels = 2;
+    data->numFrames = kRate * 2;
+    data->interleavedData.resize(static_cast<size_t>(data->numFrames) * 2);
+    for (size_t i = 0; i < data->interleavedData.size(); ++i) {
+        data->interleavedData[i] = static_cast<float>(0.5 * std::sin(0.013 * static_cast<double>(i)));
+    }
+    const ClipSourceID source = sources.createSource("Material");
+    sources.getSource(source)->setBuffer(data);
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Playlist Render Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  " << lanes << " lanes, " << kBlockFrames << "-frame blocks at " << kRate / 1000
+              << " kHz, clips 0.5 s every 0.45 s\n\n";
+    std::cout << "  " << std::left << std::setw(30) << "Benchmark" << std::right << std::setw(10) << "clips"
+              << std::setw(12) << "build ms" << std::setw(12) << "us/block" << std::setw(10) << "ns/lane" << "\n";
+    std::cout << "  " << std::string(74, '-') << "\n";
+
+    for (uint32_t clipsPerLane : {1u, 10u, 100u}) {
+        PlaylistModel playlist;
+        playlist.setProjectSampleRate(kRate);
+        fillPlaylist(playlist, source, lanes, clipsPerLane);
+
+        AudioGraphBuilder builder;
+        AudioGraph graph;
+        const double buildNs = nsPerCall(minMs / 5.0, [&] {
+            auto snapshot = playlist.buildRuntimeSnapshot(sources);
+            graph = builder.build(*snapshot, sources, kRate);
+        });
+
+        AudioEngine engine;
+        engine.setSampleRate(kRate);
+        engine.setBufferConfig(kBlockFrames, 2);
+        engine.setGraph(graph);
+        AudioQueueCommand cmd;
+        cmd.type = AudioQueueCommandType::SetTransportState;
+        cmd.value1 = 1.0f;
+        cmd.samplePos = 0;
+        engine.commandQueue().push(cmd);
+
+        // Blocks spread over the timeline, so every clip count plays the same number of overlaps.
+        std::vector<float> block(static_cast<size_t>(kBlockFrames) * 2);
+        const uint64_t span = graph.timelineEndSample > kBlockFrames ? graph.timelineEndSample - kBlockFrames : 1;
+        uint64_t step = 0;
+        const double blockNs = nsPerCall(minMs, [&] {
+            engine.setGlobalSamplePos((step++ * 7919u * kBlockFrames) % span);
+            engine.processBlock(block.data(), nullptr, kBlockFrames, 0.0);
+            g_sink = g_sink + block[kBlockFrames];
+        });
+
+        std::cout << "  " << std::left << std::setw(30) << ("BM_PlaylistBlock/" + std::to_string(clipsPerLane))
+                  << std::right << std::setw(10) << lanes * clipsPerLane << std::fixed << std::setprecision(2)
+                  << std::setw(12) << buildNs / 1e6 << std::setw(12) << blockNs / 1e3 << std::setprecision(0)
+                  << std::setw(10) << blockNs / lanes << "\n";
+    }
+    return 0;
+}
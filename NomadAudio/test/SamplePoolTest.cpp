@@ -0,0 +1,591 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for SamplePool: decoded sample cache and pre-resampled clip copies
+
+#include "AudioEngine.h"
+#include "SamplePool.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+/// Sample keys stat the file, so every test sample needs one on disk.
+std::string makeTempFile(const std::string& name) {
+    const auto path = std::filesystem::temp_directory_path() / ("nomad_samplepool_" + name + ".raw");
+    std::ofstream(path) << name;
+    return path.string();
+}
+
+/// Loader producing a stereo 1 kHz sine at the given rate.
+std::function<bool(AudioBuffer&)> sineLoader(uint32_t sampleRate, uint32_t frames) {
+    return [=](AudioBuffer& buffer) {
+        buffer.channels = 2;
+        buffer.sampleRate = sampleRate;
+        buffer.data.resize(static_cast<size_t>(frames) * 2);
+        for (uint32_t i = 0; i < frames; ++i) {
+            const float s = static_cast<float>(0.5 * std::sin(2.0 * PI * 1000.0 * i / sampleRate));
+            buffer.data[i * 2] = s;
+            buffer.data[i * 2 + 1] = -s;
+        }
+        return true;
+    };
+}
+
+/// The sine loader, counting its calls.
+std::function<bool(AudioBuffer&)> countingLoader(int& calls) {
+    return [&calls](AudioBuffer& buffer) {
+        ++calls;
+        return sineLoader(48000, 4800)(buffer);
+    };
+}
+
+constexpr size_t kSineBytes = 4800 * 2 * sizeof(float);
+
+/// Async loader: the sine, after sleeping (stands in for a slow decode).
+SamplePool::AsyncLoader slowLoader(std::chrono::milliseconds delay, std::atomic<int>* calls = nullptr) {
+    return [=](AudioBuffer& buffer, SampleLoadContext&) {
+        if (calls) {
+            ++*calls;
+        }
+        std::this_thread::sleep_for(delay);
+        return sineLoader(48000, 4800)(buffer);
+    };
+}
+
+/// Async loader that reports half progress, then waits for release (or cancellation).
+SamplePool::AsyncLoader gatedLoader(std::atomic<bool>& release) {
+    return [&release](AudioBuffer& buffer, SampleLoadContext& context) {
+        context.setProgress(0.5f);
+        while (!release.load() && !context.cancelled()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return !context.cancelled() && sineLoader(48000, 4800)(buffer);
+    };
+}
+
+/// The sine rounded to 16-bit steps, as a 16-bit PCM decode would deliver it.
+std::function<bool(AudioBuffer&)> pcm16Loader(uint32_t sampleRate, uint32_t frames) {
+    return [=](AudioBuffer& buffer) {
+        sineLoader(sampleRate, frames)(buffer);
+        for (auto& s : buffer.data) {
+            s = static_cast<float>(std::lround(s * 32768.0f)) / 32768.0f;
+        }
+        buffer.sourceBitDepth = 16;
+        return true;
+    };
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+/// Renders one clip of buffer through the engine at 48 kHz.
+std::vector<float> renderClip(const std::shared_ptr<const AudioBuffer>& buffer, uint32_t blocks) {
+    constexpr uint32_t kBlockFrames = 256;
+    TrackRenderState track;
+    track.trackId = 1;
+    ClipRenderState clip;
+    clip.buffer = buffer;
+    if (buffer->isPacked()) {
+        clip.packedData = buffer->packed.data();
+        clip.packedSampleBytes = buffer->packedSampleBytes();
+    } else {
+        clip.audioData = buffer->data.data();
+    }
+    clip.totalFrames = buffer->numFrames;
+    clip.sourceSampleRate = buffer->sampleRate;
+    clip.endSample = static_cast<uint64_t>(static_cast<double>(buffer->numFrames) * 48000.0 / buffer->sampleRate);
+    track.clips.push_back(clip);
+    AudioGraph graph;
+    graph.tracks.push_back(track);
+    graph.timelineEndSample = clip.endSample;
+
+    AudioEngine engine;
+    engine.setSampleRate(48000);
+    engine.setBufferConfig(kBlockFrames, 2);
+    engine.setResamplingQuality(SRCQuality::Sinc16);
+    engine.setGraph(graph);
+    engine.setTransportPlaying(true);
+    std::vector<float> out(static_cast<size_t>(blocks) * kBlockFrames * 2);
+    for (uint32_t b = 0; b < blocks; ++b) {
+        engine.processBlock(out.data() + static_cast<size_t>(b) * kBlockFrames * 2, nullptr, kBlockFrames, 0.0);
+    }
+    return out;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate done, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testAcquireDeduplicates() {
+    std::cout << "\n=== Test: Acquire deduplicates by path ===\n";
+    auto& pool = SamplePool::getInstance();
+    const std::string path = makeTempFile("dedup");
+
+    auto a = pool.acquire(path, sineLoader(44100, 1000));
+    auto b = pool.acquire(path);
+    recordTest("Second acquire returns the cached buffer", a && a == b);
+    recordTest("Frame count is derived from the data", a && a->numFrames == 1000);
+}
+
+void testResampledCopy() {
+    std::cout << "\n=== Test: Pre-resampled copy ===\n";
+    auto& pool = SamplePool::getInstance();
+    const std::string path = makeTempFile("resample");
+    const uint32_t frames = 44100;
+    std::shared_ptr<const AudioBuffer> source = pool.acquire(path, sineLoader(44100, frames));
+
+    pool.setResampleCacheEnabled(false);
+    recordTest("Disabled cache returns nothing", pool.acquireResampled(source, 48000) == nullptr);
+
+    pool.setResampleCacheEnabled(true);
+    recordTest("Same-rate request returns nothing", pool.acquireResampled(source, 44100) == nullptr);
+
+    const bool firstMiss = pool.acquireResampled(source, 48000) == nullptr;
+    pool.waitForResampleJobs();
+    auto copy = pool.acquireResampled(source, 48000);
+    recordTest("First request queues, later request returns the copy", firstMiss && copy != nullptr);
+    if (!copy) {
+        return;
+    }
+    recordTest("Copy is at the target rate", copy->sampleRate == 48000 && copy->channels == 2);
+    recordTest("Copy covers the whole source", copy->numFrames == 48000 && copy->data.size() == 96000);
+
+    double maxErr = 0.0;
+    for (uint32_t i = 100; i + 100 < copy->numFrames; ++i) {
+        const double expected = 0.5 * std::sin(2.0 * PI * 1000.0 * i / 48000.0);
+        maxErr = std::max(maxErr, std::abs(copy->data[i * 2] - expected));
+        maxErr = std::max(maxErr, std::abs(copy->data[i * 2 + 1] + expected));
+    }
+    recordTest("Copy matches the signal at the new rate", maxErr < 1e-4, "max error " + std::to_string(maxErr));
+
+    recordTest("Ready flag is raised once", pool.consumeResampledReady() && !pool.consumeResampledReady());
+    recordTest("Copy is counted against the pool",
+               pool.getResampledMemoryUsage() >= copy->data.size() * sizeof(float) &&
+               pool.getMemoryUsage() >= pool.getResampledMemoryUsage());
+    recordTest("Repeat request is a cache hit", pool.acquireResampled(source, 48000) == copy);
+}
+
+void testResampledBudget() {
+    std::cout << "\n=== Test: Resampled copies respect the memory budget ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setResampleCacheEnabled(true);
+    pool.setMemoryBudget(0);
+    pool.purge();   // Only the two copies compete for the budget below
+    const uint32_t frames = 22050;
+    const uint32_t target = 192000;   // Copies dwarf their sources, so eviction has to reach them
+    std::shared_ptr<const AudioBuffer> first = pool.acquire(makeTempFile("budget_a"), sineLoader(22050, frames));
+    std::shared_ptr<const AudioBuffer> second = pool.acquire(makeTempFile("budget_b"), sineLoader(22050, frames));
+    const size_t copyBytes = static_cast<size_t>(target) * 2 * sizeof(float);
+
+    pool.setMemoryBudget(copyBytes / 2);
+    pool.acquireResampled(first, target);
+    pool.waitForResampleJobs();
+    recordTest("A copy larger than the budget is never made", pool.acquireResampled(first, target) == nullptr &&
+                                                              !pool.consumeResampledReady());
+
+    pool.setMemoryBudget(0);
+    pool.acquireResampled(first, target);
+    pool.waitForResampleJobs();
+    auto firstCopy = pool.acquireResampled(first, target);
+
+    // Room for one copy only: the second copy evicts the first.
+    pool.setMemoryBudget(pool.getMemoryUsage() + copyBytes / 2);
+    pool.acquireResampled(second, target);
+    pool.waitForResampleJobs();
+    auto secondCopy = pool.acquireResampled(second, target);
+    recordTest("Both copies were rendered", firstCopy && secondCopy);
+    recordTest("Least recently used copy was evicted", pool.acquireResampled(first, target) == nullptr);
+    recordTest("Usage stays within the budget", pool.getMemoryUsage() <= pool.getMemoryBudget());
+    recordTest("Evicted copy stays valid for its holders", firstCopy && firstCopy->numFrames == target);
+
+    pool.setMemoryBudget(0);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+void testAsyncLoadsRunConcurrently() {
+    std::cout << "\n=== Test: Async loads decode concurrently ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setDecodeThreadCount(4);
+
+    constexpr int kFiles = 8;
+    const auto delay = std::chrono::milliseconds(100);
+    std::vector<SampleLoadHandle> handles;
+    std::atomic<int> callbacks{0};
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFiles; ++i) {
+        handles.push_back(pool.acquireAsync(makeTempFile("async_" + std::to_string(i)), slowLoader(delay),
+                                            [&](const std::shared_ptr<AudioBuffer>& buffer) {
+                                                if (buffer) ++callbacks;
+                                            }));
+    }
+    const SampleLoadProgress early = pool.getLoadProgress();
+    pool.waitForLoads();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0);
+
+    bool allLoaded = true;
+    for (auto& handle : handles) {
+        auto buffer = handle.get();
+        allLoaded &= buffer && buffer->ready.load() && buffer->numFrames == 4800 && handle.progress() == 1.0f;
+    }
+    recordTest("Every async load completes", allLoaded && callbacks.load() == kFiles);
+    // Serially this takes 800 ms; four threads need two rounds.
+    recordTest("Loads overlap across decode threads", elapsed < delay * (kFiles - 2),
+               std::to_string(elapsed.count()) + " ms for " + std::to_string(kFiles) + " files");
+    const SampleLoadProgress done = pool.getLoadProgress();
+    recordTest("Batch progress is reported", early.batchTotal == kFiles && early.fraction < 1.0f &&
+                                                 done.batchDone == kFiles && done.fraction == 1.0f &&
+                                                 done.queued == 0 && done.active == 0);
+}
+
+void testAsyncJoinsInFlightLoads() {
+    std::cout << "\n=== Test: In-flight loads are shared ===\n";
+    auto& pool = SamplePool::getInstance();
+    const std::string path = makeTempFile("join");
+    std::atomic<int> calls{0};
+    const uint64_t joinedBefore = pool.getLoadProgress().joined;
+
+    SampleLoadHandle first = pool.acquireAsync(path, slowLoader(std::chrono::milliseconds(50), &calls));
+    SampleLoadHandle second = pool.acquireAsync(path, slowLoader(std::chrono::milliseconds(50), &calls));
+    auto sync = pool.acquire(path, sineLoader(48000, 4800));
+    recordTest("Same key decodes once", calls.load() == 1 && first.get() == second.get() && sync == first.get());
+    recordTest("Joins are counted", pool.getLoadProgress().joined == joinedBefore + 2);
+
+    bool hitCalled = false;
+    SampleLoadHandle hit = pool.acquireAsync(path, slowLoader(std::chrono::milliseconds(50), &calls),
+                                             [&](const std::shared_ptr<AudioBuffer>& buffer) { hitCalled = buffer != nullptr; });
+    recordTest("Cached sample completes immediately", hit.isReady() && hitCalled && calls.load() == 1);
+}
+
+void testAsyncCancellation() {
+    std::cout << "\n=== Test: Async loads cancel ===\n";
+    auto& pool = SamplePool::getInstance();
+    const std::string path = makeTempFile("cancel");
+    std::atomic<bool> release{false};
+    std::atomic<bool> called{false};
+    const uint64_t cancelledBefore = pool.getLoadProgress().cancelled;
+
+    SampleLoadHandle a = pool.acquireAsync(path, gatedLoader(release), [&](const std::shared_ptr<AudioBuffer>&) { called = true; });
+    SampleLoadHandle b = pool.acquireAsync(path, gatedLoader(release));
+    const bool started = waitFor([&] { return a.progress() == 0.5f; });
+    recordTest("Loader progress is visible", started && b.progress() == 0.5f);
+
+    a.cancel();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    recordTest("Load continues while another requester wants it", !b.isReady());
+    b.cancel();
+    const bool stopped = waitFor([&] { return b.isReady(); });
+    recordTest("Cancelling every requester stops the decode",
+               stopped && !b.get() && !called.load() && pool.getLoadProgress().cancelled == cancelledBefore + 1);
+
+    release = true;
+    SampleLoadHandle again = pool.acquireAsync(path, gatedLoader(release));
+    recordTest("A later request starts a fresh load", again.get() != nullptr);
+}
+
+void testSyncAcquireRunsQueuedLoad() {
+    std::cout << "\n=== Test: acquire() does not wait behind the decode queue ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setDecodeThreadCount(1);
+    std::atomic<bool> release{false};
+    SampleLoadHandle blocker = pool.acquireAsync(makeTempFile("blocker"), gatedLoader(release));
+    waitFor([&] { return blocker.progress() == 0.5f; });
+
+    const std::string path = makeTempFile("queued");
+    SampleLoadHandle queued = pool.acquireAsync(path, slowLoader(std::chrono::milliseconds(1)));
+    auto buffer = pool.acquire(path);
+    recordTest("Queued load runs on the caller's thread", buffer && queued.isReady() && !blocker.isReady());
+
+    release = true;
+    pool.waitForLoads();
+    pool.setDecodeThreadCount(0);
+}
+
+void testReleasedBuffersStayCached() {
+    std::cout << "\n=== Test: Released buffers stay cached ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setMemoryBudget(0);
+    pool.purge();
+    const SamplePoolStats before = pool.getStats();
+    const std::string path = makeTempFile("released");
+    int calls = 0;
+
+    const AudioBuffer* first = pool.acquire(path, countingLoader(calls)).get();   // Dropped at once
+    auto again = pool.acquire(path, countingLoader(calls));
+    recordTest("Re-acquiring a released sample does not decode", calls == 1 && again.get() == first);
+
+    const SamplePoolStats stats = pool.getStats();
+    recordTest("Hits and misses are counted", stats.hits == before.hits + 1 && stats.misses == before.misses + 1);
+    recordTest("Bytes are exact", stats.bytes == kSineBytes && stats.entries == 1 && pool.getMemoryUsage() == kSineBytes);
+
+    again.reset();
+    pool.purge();
+    recordTest("Purge empties the cache", pool.getMemoryUsage() == 0 && pool.getStats().entries == 0 &&
+                                          pool.getStats().evictedBytes == before.evictedBytes + kSineBytes);
+}
+
+void testLeastRecentlyUsedEviction() {
+    std::cout << "\n=== Test: LRU eviction under the budget ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setMemoryBudget(0);
+    pool.purge();
+    pool.setMemoryBudget(3 * kSineBytes);
+    const uint64_t evictionsBefore = pool.getStats().evictions;
+
+    std::vector<std::string> paths;
+    for (const char* name : {"lru_a", "lru_b", "lru_c", "lru_d"}) {
+        paths.push_back(makeTempFile(name));
+    }
+    int calls = 0;
+    pool.acquire(paths[0], countingLoader(calls));
+    pool.acquire(paths[1], countingLoader(calls));
+    pool.acquire(paths[2], countingLoader(calls));
+    pool.acquire(paths[0], countingLoader(calls));   // a is now more recent than b
+    pool.acquire(paths[3], countingLoader(calls));   // Over budget: evicts b
+    recordTest("Four decodes for four samples", calls == 4);
+    recordTest("Usage stays within the budget", pool.getMemoryUsage() == 3 * kSineBytes &&
+                                                pool.getStats().evictions == evictionsBefore + 1);
+
+    pool.acquire(paths[0], countingLoader(calls));
+    pool.acquire(paths[3], countingLoader(calls));
+    recordTest("Recently used samples survive", calls == 4);
+    pool.acquire(paths[1], countingLoader(calls));
+    recordTest("Least recently used sample was evicted", calls == 5);
+
+    pool.setMemoryBudget(0);
+}
+
+void testEvictedSampleInUseIsShared() {
+    std::cout << "\n=== Test: An evicted sample still in use is not decoded twice ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setMemoryBudget(0);
+    pool.purge();
+    pool.setMemoryBudget(kSineBytes);
+    const std::string held = makeTempFile("held");
+    int calls = 0;
+
+    auto clip = pool.acquire(held, countingLoader(calls));
+    pool.acquire(makeTempFile("newer"), countingLoader(calls));   // Evicts the held sample
+    recordTest("Held sample leaves the budget", pool.getMemoryUsage() == kSineBytes);
+
+    auto again = pool.acquire(held, countingLoader(calls));
+    recordTest("Re-acquiring it returns the live buffer", calls == 2 && again == clip);
+
+    pool.setMemoryBudget(0);
+}
+
+void testPinnedBuffersAreNotEvicted() {
+    std::cout << "\n=== Test: Pinned buffers are not evicted ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setMemoryBudget(0);
+    pool.purge();
+    const std::string path = makeTempFile("pinned");
+    int calls = 0;
+
+    SamplePinSet pins;
+    {
+        auto playing = pool.acquire(path, countingLoader(calls));
+        AudioBuffer unowned;
+        pins.assign({playing.get(), playing.get(), &unowned, nullptr});
+    }
+    recordTest("Only pool buffers are pinned, once", pins.size() == 1);
+
+    pool.setMemoryBudget(1);
+    pool.purge();
+    const SamplePoolStats stats = pool.getStats();
+    recordTest("Pinned buffer survives budget and purge",
+               stats.pinnedEntries == 1 && stats.pinnedBytes == kSineBytes && stats.bytes == kSineBytes);
+    pool.acquire(path, countingLoader(calls));
+    recordTest("Pinned buffer is served from the cache", calls == 1);
+
+    pins.clear();
+    recordTest("Unpinned buffer is evicted", pool.getMemoryUsage() == 0 && pool.getStats().pinnedEntries == 0);
+    pool.acquire(path, countingLoader(calls));
+    recordTest("Evicted buffer decodes again", calls == 2);
+
+    pool.setMemoryBudget(0);
+}
+
+void testNativeStoragePacksLosslessly() {
+    std::cout << "\n=== Test: Native storage packs 16-bit sources ===\n";
+    auto& pool = SamplePool::getInstance();
+    pool.setSampleStorage(SampleStorage::Native);
+
+    AudioBuffer reference;
+    pcm16Loader(48000, 4800)(reference);
+    auto packed = pool.acquire(makeTempFile("native16"), pcm16Loader(48000, 4800));
+    recordTest("16-bit source is stored as int16", packed && packed->storage == SampleStorage::Int16 &&
+                                                   packed->data.empty() && packed->packed.size() == 4800 * 2 * 2);
+    recordTest("Unpacked samples match the decode bit for bit", packed && sameBits(SamplePool::toFloat(*packed), reference.data));
+
+    std::vector<float> window(64 * 2, 1.0f);
+    SamplePool::readFrames(*packed, 4800 - 32, 64, window.data());
+    const bool tail = std::equal(window.begin(), window.begin() + 64, reference.data.end() - 64) &&
+                      std::all_of(window.begin() + 64, window.end(), [](float s) { return s == 0.0f; });
+    recordTest("readFrames zero-fills past the end", tail);
+
+    auto unknown = pool.acquire(makeTempFile("native_float"), sineLoader(48000, 4800));
+    recordTest("Source without a PCM depth stays float", unknown && !unknown->isPacked() && unknown->data.size() == 9600);
+
+    pool.setSampleStorage(SampleStorage::Float32);
+}
+
+void testPerFileStorageAndQuantization() {
+    std::cout << "\n=== Test: Per-file storage override ===\n";
+    auto& pool = SamplePool::getInstance();
+    const std::string path24 = makeTempFile("forced24");
+    const std::string path16 = makeTempFile("forced16");
+    pool.setSampleStorage(path24, SampleStorage::Int24);
+    pool.setSampleStorage(path16, SampleStorage::Int16);
+
+    AudioBuffer reference;
+    sineLoader(48000, 4800)(reference);
+    const size_t before = pool.getMemoryUsage();
+    auto b24 = pool.acquire(path24, sineLoader(48000, 4800));
+    const size_t charged = pool.getMemoryUsage() - before;
+    auto b16 = pool.acquire(path16, sineLoader(48000, 4800));
+    auto plain = pool.acquire(makeTempFile("unforced"), sineLoader(48000, 4800));
+    recordTest("Override applies only to its file", b24 && b24->storage == SampleStorage::Int24 &&
+                                                    b16 && b16->storage == SampleStorage::Int16 &&
+                                                    plain && !plain->isPacked());
+
+    auto maxError = [&](const AudioBuffer& buffer) {
+        const auto samples = SamplePool::toFloat(buffer);
+        double worst = 0.0;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            worst = std::max(worst, std::abs(static_cast<double>(samples[i]) - reference.data[i]));
+        }
+        return worst;
+    };
+    const double e16 = b16 ? maxError(*b16) : 1.0;
+    const double e24 = b24 ? maxError(*b24) : 1.0;
+    recordTest("int16 error is within half a step", e16 <= 0.5 / 32768.0, std::to_string(e16));
+    recordTest("int24 error is within half a step", e24 <= 0.5 / 8388608.0, std::to_string(e24));
+    recordTest("Packed buffers are charged their packed size", charged < kSineBytes, std::to_string(charged));
+
+    pool.setSampleStorage(path24, SampleStorage::Float32);
+    pool.setSampleStorage(path16, SampleStorage::Float32);
+}
+
+void testPackedClipRendersLikeFloat() {
+    std::cout << "\n=== Test: Packed clips render like float clips ===\n";
+    auto& pool = SamplePool::getInstance();
+
+    // 16-bit-exact material survives int16 packing unchanged, so the renders must match exactly.
+    for (uint32_t rate : {48000u, 44100u}) {
+        pool.setSampleStorage(SampleStorage::Float32);
+        auto floats = pool.acquire(makeTempFile("render_f" + std::to_string(rate)), pcm16Loader(rate, 4800));
+        pool.setSampleStorage(SampleStorage::Native);
+        auto packed = pool.acquire(makeTempFile("render_p" + std::to_string(rate)), pcm16Loader(rate, 4800));
+        pool.setSampleStorage(SampleStorage::Float32);
+
+        const auto a = renderClip(floats, 24);
+        const auto b = renderClip(packed, 24);
+        const bool audible = std::any_of(a.begin(), a.end(), [](float s) { return s != 0.0f; });
+        recordTest(std::string(rate == 48000 ? "Direct" : "Resampled") + " render is bit-identical",
+                   packed && packed->isPacked() && audible && sameBits(a, b));
+    }
+}
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad SamplePool Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testAcquireDeduplicates();
+    testResampledCopy();
+    testResampledBudget();
+    testAsyncLoadsRunConcurrently();
+    testAsyncJoinsInFlightLoads();
+    testAsyncCancellation();
+    testSyncAcquireRunsQueuedLoad();
+    testReleasedBuffersStayCached();
+    testLeastRecentlyUsedEviction();
+    testEvictedSampleInUseIsShared();
+    testPinnedBuffersAreNotEvicted();
+    testNativeStoragePacksLosslessly();
+    testPerFileStorageAndQuantization();
+    testPackedClipRendersLikeFloat();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
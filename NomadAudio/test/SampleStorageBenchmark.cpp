@@ -0,0 +1,193 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Render cost against memory for compact sample storage: float32 clips versus
+// int16/int24 packed clips unpacked on the fly, direct and resampled, per SIMD tier
+
+#include "AudioKernels.h"
+#include "ClipResampler.h"
+#include "SamplePool.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile double g_sink = 0.0;
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per call.
+ */
+double nsPerCall(double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    for (int i = 0; i < 16; ++i) {
+        fn();   // Warm-up
+    }
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        for (int i = 0; i < 16; ++i) {
+            fn();
+        }
+        iterations += 16;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+}
+
+/// Direct (unity-rate) clip read, as AudioEngine::renderTrack does it.
+void readDirect(const AudioBuffer& clip, uint64_t start, uint32_t frames, double* dst) {
+    const AudioKernelTable& kernels = AudioKernels::active();
+    if (!clip.isPacked()) {
+        kernels.floatToDouble(dst, clip.data.data() + start * 2, static_cast<size_t>(frames) * 2);
+        return;
+    }
+    constexpr uint32_t kChunkFrames = 512;
+    alignas(64) float chunk[kChunkFrames * 2];
+    const uint32_t bytes = clip.packedSampleBytes();
+    for (uint32_t done = 0; done < frames;) {
+        const uint32_t n = std::min(frames - done, kChunkFrames);
+        kernels.unpack(chunk, clip.packed.data() + (start + done) * 2 * bytes, bytes, static_cast<size_t>(n) * 2);
+        kernels.floatToDouble(dst + static_cast<size_t>(done) * 2, chunk, static_cast<size_t>(n) * 2);
+        done += n;
+    }
+}
+
+void resample(const ClipResampler& resampler, const AudioBuffer& clip, double position, double step,
+              double* dst, uint32_t frames) {
+    if (clip.isPacked()) {
+        resampler.process(clip.packed.data(), clip.packedSampleBytes(), clip.numFrames, position, step, dst, frames);
+    } else {
+        resampler.process(clip.data.data(), clip.numFrames, position, step, dst, frames);
+    }
+}
+
+const char* storageName(SampleStorage storage) {
+    switch (storage) {
+        case SampleStorage::Int16: return "int16";
+        case SampleStorage::Int24: return "int24";
+        default: return "float32";
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    uint32_t frames = 512;
+    double srcRate = 44100.0;
+    double dstRate = 48000.0;
+    double minMs = 100.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--frames" && i + 1 < argc) frames = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--src-rate" && i + 1 < argc) srcRate = std::atof(argv[++i]);
+        else if (a == "--dst-rate" && i + 1 < argc) dstRate = std::atof(argv[++i]);
+        else if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    // Ten seconds of stereo test material (two sines), in each storage format.
+    const uint32_t clipFrames = static_cast<uint32_t>(srcRate * 10.0);
+    std::vector<AudioBuffer> clips(3);
+    for (auto& clip : clips) {
+        clip.channels = 2;
+        clip.sampleRate = static_cast<uint32_t>(srcRate);
+        clip.numFrames = clipFrames;
+        clip.data.resize(static_cast<size_t>(clipFrames) * 2);
+        for (uint32_t i = 0; i < clipFrames; ++i) {
+            clip.data[i * 2] = static_cast<float>(0.5 * std::sin(0.031 * i));
+            clip.data[i * 2 + 1] = static_cast<float>(0.5 * std::sin(0.017 * i));
+        }
+    }
+    const double floatBytes = static_cast<double>(clips[0].data.size() * sizeof(float));
+    SamplePool::pack(clips[1], SampleStorage::Int16);
+    SamplePool::pack(clips[2], SampleStorage::Int24);
+    std::vector<double> out(static_cast<size_t>(frames) * 2);
+
+    const double blockBudgetNs = 1e9 * static_cast<double>(frames) / dstRate;
+    const double step = srcRate / dstRate;
+    const double span = static_cast<double>(clipFrames) - 2.0 * frames * step - 128.0;
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Sample Storage Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  block=" << frames << " frames (budget " << std::fixed << std::setprecision(1)
+              << blockBudgetNs / 1000.0 << " us), detected="
+              << AudioKernels::levelName(AudioKernels::detectedLevel()) << "\n\n";
+
+    std::cout << "  " << std::left << std::setw(12) << "Storage" << std::right << std::setw(16) << "MB/stereo min"
+              << std::setw(12) << "saved" << "\n";
+    std::cout << "  " << std::string(40, '-') << "\n";
+    for (const auto& clip : clips) {
+        const double bytes = clip.isPacked() ? static_cast<double>(clip.packed.size()) : floatBytes;
+        std::cout << "  " << std::left << std::setw(12) << storageName(clip.storage) << std::right
+                  << std::setprecision(2) << std::setw(16) << bytes * 6.0 / (1024.0 * 1024.0)
+                  << std::setprecision(0) << std::setw(11) << 100.0 * (1.0 - bytes / floatBytes) << "%\n";
+    }
+    std::cout << "\n";
+
+    std::cout << "  " << std::left << std::setw(34) << "Benchmark"
+              << std::right << std::setw(12) << "ns/voice" << std::setw(10) << "ns/frame"
+              << std::setw(12) << "voices/blk" << std::setw(10) << "vs float" << "\n";
+    std::cout << "  " << std::string(78, '-') << "\n";
+
+    auto report = [&](const std::string& label, double ns, double baselineNs) {
+        std::cout << "  " << std::left << std::setw(34) << label << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(12) << ns
+                  << std::setprecision(2) << std::setw(10) << ns / frames
+                  << std::setprecision(0) << std::setw(12) << blockBudgetNs / ns;
+        if (baselineNs > 0.0) {
+            std::cout << std::setprecision(2) << std::setw(9) << ns / baselineNs << "x";
+        }
+        std::cout << "\n";
+    };
+
+    ClipResampler resampler;
+    resampler.configure(srcRate, dstRate, SRCQuality::Sinc16);
+    const SimdLevel detected = AudioKernels::detectedLevel();
+    for (SimdLevel tier : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (!AudioKernels::table(tier)) {
+            continue;
+        }
+        AudioKernels::setLevel(tier);
+        const std::string suffix = std::string("/") + AudioKernels::levelName(tier);
+
+        double directBaseline = 0.0;
+        for (const auto& clip : clips) {
+            uint64_t start = 0;
+            const double ns = nsPerCall(minMs, [&] {
+                readDirect(clip, start, frames, out.data());
+                start = start + 2 * frames < clipFrames ? start + frames : 0;
+                g_sink = g_sink + out[frames];
+            });
+            report(std::string("BM_Direct/") + storageName(clip.storage) + suffix, ns, directBaseline);
+            directBaseline = directBaseline > 0.0 ? directBaseline : ns;
+        }
+
+        double resampledBaseline = 0.0;
+        for (const auto& clip : clips) {
+            double position = 64.0;
+            const double ns = nsPerCall(minMs, [&] {
+                resample(resampler, clip, position, step, out.data(), frames);
+                position = position + frames * step < span ? position + frames * step : 64.0;
+                g_sink = g_sink + out[frames];
+            });
+            report(std::string("BM_Sinc16/") + storageName(clip.storage) + suffix, ns, resampledBaseline);
+            resampledBaseline = resampledBaseline > 0.0 ? resampledBaseline : ns;
+        }
+    }
+    AudioKernels::setLevel(detected);
+    return 0;
+}
@@ -0,0 +1,859 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for disk streaming: memory-mapped PCM, read-ahead rings and engine render parity
+
+#include "AudioEngine.h"
+#include "AudioTelemetry.h"
+#include "ClipResampler.h"
+#include "SamplePool.h"
+#include "StreamingSource.h"
+#include "Track.h"
+#include "WaveformCache.h"
+#include "NomadLog.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kBlockFrames = 256;
+
+fs::path tempDir() {
+    const fs::path dir = fs::temp_directory_path() / "nomad_streaming_test";
+    fs::create_directories(dir);
+    return dir;
+}
+
+// --- File writers ------------------------------------------------------------
+
+void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+void putBE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+void putTag(std::vector<uint8_t>& out, const char* tag) { out.insert(out.end(), tag, tag + 4); }
+
+void writeFile(const fs::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+/// Deterministic test signal, distinct per channel.
+float signal(uint64_t frame, uint32_t channel) {
+    return static_cast<float>(0.5 * std::sin(0.013 * static_cast<double>(frame) + channel * 1.1));
+}
+
+/// Integer PCM samples, interleaved (channels per frame).
+std::vector<int32_t> pcmSamples(uint64_t frames, uint32_t channels, uint32_t bits) {
+    const double scale = std::ldexp(1.0, static_cast<int>(bits) - 1) - 1.0;
+    std::vector<int32_t> samples;
+    for (uint64_t f = 0; f < frames; ++f) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            samples.push_back(static_cast<int32_t>(std::lround(signal(f, c) * scale)));
+        }
+    }
+    return samples;
+}
+
+/// Little-endian RIFF/WAVE. formatTag 1 = PCM, 3 = float (samples are float bits then).
+void writeWav(const fs::path& path, uint32_t channels, uint32_t bits, uint16_t formatTag,
+              const std::vector<uint32_t>& words, uint32_t rate = kRate) {
+    const uint32_t bytesPerSample = bits / 8;
+    const uint32_t dataBytes = static_cast<uint32_t>(words.size()) * bytesPerSample;
+    std::vector<uint8_t> out;
+    putTag(out, "RIFF"); putLE(out, 4 + 8 + 16 + 8 + 8 + dataBytes, 4); putTag(out, "WAVE");
+    putTag(out, "LIST"); putLE(out, 4, 4); putTag(out, "INFO");   // A chunk to skip
+    putTag(out, "fmt "); putLE(out, 16, 4);
+    putLE(out, formatTag, 2); putLE(out, channels, 2); putLE(out, rate, 4);
+    putLE(out, rate * channels * bytesPerSample, 4); putLE(out, channels * bytesPerSample, 2); putLE(out, bits, 2);
+    putTag(out, "data"); putLE(out, dataBytes, 4);
+    for (uint32_t w : words) putLE(out, w, static_cast<int>(bytesPerSample));
+    writeFile(path, out);
+}
+
+/// AIFF (compression empty) or AIFC with the given compression type.
+void writeAiff(const fs::path& path, uint32_t channels, uint32_t bits, const char* compression,
+               const std::vector<uint32_t>& words, bool littleEndianSamples) {
+    const uint32_t bytesPerSample = bits / 8;
+    const uint32_t frames = static_cast<uint32_t>(words.size() / channels);
+    const uint32_t dataBytes = static_cast<uint32_t>(words.size()) * bytesPerSample;
+    const bool aifc = compression != nullptr;
+    const uint32_t commBytes = aifc ? 24 : 18;   // AIFC: type + empty pascal name (2 bytes)
+
+    std::vector<uint8_t> out;
+    putTag(out, "FORM"); putBE(out, 4 + 8 + commBytes + 8 + 8 + dataBytes, 4); putTag(out, aifc ? "AIFC" : "AIFF");
+    putTag(out, "COMM"); putBE(out, commBytes, 4);
+    putBE(out, channels, 2); putBE(out, frames, 4); putBE(out, bits, 2);
+    // 48000 as an 80-bit extended float: exponent 16383 + 15, mantissa 48000 << 48
+    putBE(out, 16383 + 15, 2); putBE(out, static_cast<uint64_t>(kRate) << 48, 8);
+    if (aifc) {
+        putTag(out, compression); putBE(out, 0, 2);
+    }
+    putTag(out, "SSND"); putBE(out, 8 + dataBytes, 4); putBE(out, 0, 4); putBE(out, 0, 4);
+    for (uint32_t w : words) {
+        if (littleEndianSamples) putLE(out, w, static_cast<int>(bytesPerSample));
+        else putBE(out, w, static_cast<int>(bytesPerSample));
+    }
+    writeFile(path, out);
+}
+
+std::vector<uint32_t> asWords(const std::vector<int32_t>& samples) {
+    return std::vector<uint32_t>(samples.begin(), samples.end());
+}
+
+std::vector<uint32_t> floatWords(uint64_t frames, uint32_t channels) {
+    std::vector<uint32_t> words;
+    for (uint64_t f = 0; f < frames; ++f) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            const float v = signal(f, c);
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            words.push_back(bits);
+        }
+    }
+    return words;
+}
+
+/// Compare a stereo read against the expected per-channel samples (mono duplicates).
+bool matches(const std::vector<float>& stereo, const std::vector<float>& expected, uint32_t channels,
+             uint64_t firstFrame, double tolerance = 0.0) {
+    const uint64_t frames = stereo.size() / 2;
+    for (uint64_t i = 0; i < frames; ++i) {
+        for (uint32_t c = 0; c < 2; ++c) {
+            const float want = expected[(firstFrame + i) * channels + (channels == 1 ? 0 : c)];
+            if (std::abs(stereo[i * 2 + c] - want) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<float> intToFloat(const std::vector<int32_t>& samples, float scale) {
+    std::vector<float> out;
+    for (int32_t s : samples) out.push_back(static_cast<float>(s) / scale);
+    return out;
+}
+
+// --- Synthetic decoder for ring sources --------------------------------------
+
+/// Frame f decodes to (f, -f) * 1e-6: every frame is identifiable.
+class RampDecoder : public StreamDecoder {
+public:
+    explicit RampDecoder(uint64_t frames) : m_frames(frames) {}
+    uint32_t sampleRate() const override { return kRate; }
+    uint32_t sourceChannels() const override { return 2; }
+    uint64_t numFrames() const override { return m_frames; }
+    bool seek(uint64_t frame) override { m_position = frame; ++seeks; return true; }
+    uint32_t read(float* dst, uint32_t frames) override {
+        const uint64_t n = std::min<uint64_t>(frames, m_frames - std::min(m_position, m_frames));
+        for (uint64_t i = 0; i < n; ++i) {
+            dst[i * 2] = value(m_position + i);
+            dst[i * 2 + 1] = -value(m_position + i);
+        }
+        m_position += n;
+        return static_cast<uint32_t>(n);
+    }
+    std::unique_ptr<StreamDecoder> reopen() const override { return std::make_unique<RampDecoder>(m_frames); }
+    static float value(uint64_t frame) { return static_cast<float>(static_cast<double>(frame) * 1e-6); }
+
+    std::atomic<uint32_t> seeks{0};
+
+private:
+    uint64_t m_frames;
+    uint64_t m_position{0};
+};
+
+/// RampDecoder whose reopened copies (decoded-copy loads) wait until open is set.
+class GatedRampDecoder : public RampDecoder {
+public:
+    GatedRampDecoder(uint64_t frames, std::shared_ptr<std::atomic<bool>> open, bool gated = false)
+        : RampDecoder(frames), m_open(std::move(open)), m_gated(gated) {}
+    uint32_t read(float* dst, uint32_t frames) override {
+        while (m_gated && !m_open->load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return RampDecoder::read(dst, frames);
+    }
+    std::unique_ptr<StreamDecoder> reopen() const override {
+        return std::make_unique<GatedRampDecoder>(numFrames(), m_open, true);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_open;
+    bool m_gated;
+};
+
+bool isRamp(const std::vector<float>& stereo, uint64_t firstFrame) {
+    for (size_t i = 0; i < stereo.size() / 2; ++i) {
+        if (stereo[i * 2] != RampDecoder::value(firstFrame + i) ||
+            stereo[i * 2 + 1] != -RampDecoder::value(firstFrame + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Engine rendering --------------------------------------------------------
+
+TrackRenderState makeTrack(const std::shared_ptr<AudioBuffer>& buffer, uint64_t startSample = 0,
+                           uint64_t sampleOffset = 0) {
+    TrackRenderState tr;
+    tr.trackId = 1;
+    tr.trackIndex = 0;
+    ClipRenderState clip;
+    clip.buffer = buffer;
+    clip.audioData = buffer->isStreaming ? nullptr : buffer->data.data();
+    clip.stream = buffer->isStreaming ? buffer->stream.get() : nullptr;
+    clip.startSample = startSample;
+    clip.sampleOffset = sampleOffset;
+    clip.totalFrames = buffer->numFrames;
+    clip.sourceSampleRate = buffer->sampleRate;
+    const uint64_t outputFrames = static_cast<uint64_t>(
+        static_cast<double>(buffer->numFrames - sampleOffset) * kRate / buffer->sampleRate);
+    clip.endSample = startSample + outputFrames;
+    tr.clips.push_back(clip);
+    return tr;
+}
+
+/// Renders blocks; services streams before each block unless told not to.
+std::vector<float> render(AudioEngine& engine, const AudioGraph& graph, uint32_t blocks, bool service = true) {
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kBlockFrames, 2);
+    engine.setResamplingQuality(SRCQuality::Sinc16);
+    engine.setGraph(graph);
+    engine.waitForDecodedStreams();
+    engine.setTransportPlaying(true);
+
+    std::vector<float> out(static_cast<size_t>(blocks) * kBlockFrames * 2);
+    for (uint32_t b = 0; b < blocks; ++b) {
+        if (service) {
+            StreamIOPool::getInstance().serviceAllNow();
+        }
+        engine.processBlock(out.data() + static_cast<size_t>(b) * kBlockFrames * 2, nullptr, kBlockFrames, 0.0);
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+// Cue a mapped source and let the I/O pool make the frames resident before reading.
+bool readResident(MappedPcmSource& source, uint64_t start, uint32_t frames, float* dst) {
+    source.cue(start, 0.0);
+    StreamIOPool::getInstance().serviceAllNow();
+    return source.read(start, frames, dst);
+}
+
+void testMappedWav() {
+    std::cout << "\n=== Test: Memory-mapped WAV ===\n";
+    const uint64_t frames = 20000;
+    const fs::path dir = tempDir();
+
+    const auto pcm16 = pcmSamples(frames, 2, 16);
+    writeWav(dir / "s16.wav", 2, 16, 1, asWords(pcm16));
+    auto s16 = MappedPcmSource::open((dir / "s16.wav").string());
+    bool ok = s16 && s16->numFrames() == frames && s16->sampleRate() == kRate && s16->sourceChannels() == 2;
+    if (ok) {
+        std::vector<float> out(1000 * 2);
+        ok = readResident(*s16, 5000, 1000, out.data()) && matches(out, intToFloat(pcm16, 32768.0f), 2, 5000);
+    }
+    recordTest("16-bit stereo converts exactly", ok);
+
+    const auto pcm24 = pcmSamples(frames, 1, 24);
+    std::vector<uint32_t> words24;
+    for (int32_t s : pcm24) words24.push_back(static_cast<uint32_t>(s) & 0xFFFFFF);
+    writeWav(dir / "s24mono.wav", 1, 24, 1, words24);
+    auto s24 = MappedPcmSource::open((dir / "s24mono.wav").string());
+    ok = s24 && s24->sourceChannels() == 1 && s24->encoding() == MappedPcmSource::Encoding::Int24;
+    if (ok) {
+        std::vector<float> out(300 * 2);
+        readResident(*s24, 100, 300, out.data());
+        ok = matches(out, intToFloat(pcm24, 8388608.0f), 1, 100);
+    }
+    recordTest("24-bit mono is duplicated to stereo", ok);
+
+    writeWav(dir / "f32.wav", 2, 32, 3, floatWords(frames, 2));
+    auto f32 = MappedPcmSource::open((dir / "f32.wav").string());
+    ok = f32 && f32->encoding() == MappedPcmSource::Encoding::Float32;
+    if (ok) {
+        std::vector<float> out(frames * 2);
+        readResident(*f32, 0, static_cast<uint32_t>(frames), out.data());
+        std::vector<float> expected;
+        for (uint64_t f = 0; f < frames; ++f) { expected.push_back(signal(f, 0)); expected.push_back(signal(f, 1)); }
+        ok = matches(out, expected, 2, 0);
+    }
+    recordTest("32-bit float passes through bit-exact", ok);
+
+    const auto pcm32 = pcmSamples(frames, 2, 32);
+    writeWav(dir / "s32.wav", 2, 32, 1, asWords(pcm32));
+    auto s32 = MappedPcmSource::open((dir / "s32.wav").string());
+    ok = s32 && s32->encoding() == MappedPcmSource::Encoding::Int32;
+    if (ok) {
+        std::vector<float> out(64 * 2);
+        readResident(*s32, frames - 64, 64, out.data());
+        ok = matches(out, intToFloat(pcm32, 2147483648.0f), 2, frames - 64, 1e-7);
+    }
+    recordTest("32-bit integer converts", ok);
+}
+
+void testMappedAiff() {
+    std::cout << "\n=== Test: Memory-mapped AIFF / AIFC ===\n";
+    const uint64_t frames = 4000;
+    const fs::path dir = tempDir();
+    const auto pcm16 = pcmSamples(frames, 2, 16);
+    std::vector<uint32_t> words16;
+    for (int32_t s : pcm16) words16.push_back(static_cast<uint32_t>(s) & 0xFFFF);
+
+    writeAiff(dir / "be16.aiff", 2, 16, nullptr, words16, false);
+    auto be = MappedPcmSource::open((dir / "be16.aiff").string());
+    bool ok = be && be->bigEndian() && be->sampleRate() == kRate && be->numFrames() == frames;
+    if (ok) {
+        std::vector<float> out(frames * 2);
+        readResident(*be, 0, static_cast<uint32_t>(frames), out.data());
+        ok = matches(out, intToFloat(pcm16, 32768.0f), 2, 0);
+    }
+    recordTest("AIFF big-endian 16-bit", ok);
+
+    writeAiff(dir / "sowt.aifc", 2, 16, "sowt", words16, true);
+    auto sowt = MappedPcmSource::open((dir / "sowt.aifc").string());
+    ok = sowt && !sowt->bigEndian();
+    if (ok) {
+        std::vector<float> out(500 * 2);
+        readResident(*sowt, 1234, 500, out.data());
+        ok = matches(out, intToFloat(pcm16, 32768.0f), 2, 1234);
+    }
+    recordTest("AIFC sowt (little-endian) 16-bit", ok);
+
+    writeAiff(dir / "fl32.aifc", 1, 32, "fl32", floatWords(frames, 1), false);
+    auto fl32 = MappedPcmSource::open((dir / "fl32.aifc").string());
+    ok = fl32 && fl32->encoding() == MappedPcmSource::Encoding::Float32 && fl32->sourceChannels() == 1;
+    if (ok) {
+        std::vector<float> out(100 * 2);
+        readResident(*fl32, 10, 100, out.data());
+        std::vector<float> expected;
+        for (uint64_t f = 0; f < frames; ++f) expected.push_back(signal(f, 0));
+        ok = matches(out, expected, 1, 10);
+    }
+    recordTest("AIFC fl32 mono float", ok);
+
+    writeAiff(dir / "ulaw.aifc", 1, 16, "ulaw", words16, false);
+    recordTest("Compressed AIFC is left to a decoder", !MappedPcmSource::open((dir / "ulaw.aifc").string()));
+}
+
+void testMappedEdgesAndUnderruns() {
+    std::cout << "\n=== Test: Mapped source edges and underruns ===\n";
+    const uint64_t frames = kRate * 10;
+    const fs::path dir = tempDir();
+    const auto pcm = pcmSamples(frames, 2, 16);
+    writeWav(dir / "long.wav", 2, 16, 1, asWords(pcm));
+
+    std::vector<uint32_t> surround(600, 0);
+    writeWav(dir / "surround.wav", 6, 16, 1, surround);
+    recordTest("More than two channels is not streamed", !MappedPcmSource::open((dir / "surround.wav").string()));
+    writeFile(dir / "garbage.wav", std::vector<uint8_t>(64, 0x5A));
+    recordTest("Non-audio file is rejected", !MappedPcmSource::open((dir / "garbage.wav").string()));
+
+    auto source = MappedPcmSource::open((dir / "long.wav").string());
+    if (!source) {
+        recordTest("Open 10 s file", false);
+        return;
+    }
+    StreamIOPool::getInstance().serviceAllNow();
+
+    std::vector<float> out(512 * 2, 1.0f);
+    const bool tail = source->read(frames - 100, 512, out.data());
+    bool silent = true;
+    for (size_t i = 200; i < out.size(); ++i) silent &= out[i] == 0.0f;
+    recordTest("Frames past the end read as silence", silent);
+    recordTest("Jump outside the read-ahead counts an underrun", !tail && source->underruns() == 1);
+
+    std::vector<float> far(256 * 2, 1.0f);
+    const bool farOk = source->read(frames / 2, 256, far.data());
+    bool farSilent = true;
+    for (float v : far) farSilent &= v == 0.0f;
+    recordTest("Unprefetched read is silence, not a fault into the mapping",
+               !farOk && farSilent && source->underruns() == 2);
+
+    StreamIOPool::getInstance().serviceAllNow();
+    const uint64_t before = source->underruns();
+    bool clean = true;
+    for (uint64_t pos = frames / 2; pos < frames / 2 + kRate; pos += 256) {
+        clean &= source->read(pos, 256, far.data());
+        StreamIOPool::getInstance().serviceAllNow();
+    }
+    recordTest("Sequential playback after servicing never underruns", clean && source->underruns() == before);
+}
+
+void testRingSource() {
+    std::cout << "\n=== Test: Read-ahead ring ===\n";
+    const uint64_t frames = kRate * 20;
+    auto decoder = std::make_unique<RampDecoder>(frames);
+    RampDecoder* ramp = decoder.get();
+    auto ring = std::make_shared<RingStreamSource>(std::move(decoder), "ramp", kRate / 2);
+    StreamIOPool::getInstance().add(ring);
+    StreamIOPool::getInstance().serviceAllNow();
+
+    std::vector<float> out(1000 * 2);
+    bool ok = ring->read(0, 1000, out.data()) && isRamp(out, 0);
+    recordTest("Prefilled ring serves the head of the file", ok && ring->underruns() == 0);
+
+    // Play through several ring lengths: every block must wrap correctly.
+    bool clean = true;
+    uint64_t pos = 1000;
+    for (; pos < kRate * 3; pos += kBlockFrames) {
+        std::vector<float> block(kBlockFrames * 2);
+        clean &= ring->read(pos, kBlockFrames, block.data()) && isRamp(block, pos);
+        StreamIOPool::getInstance().serviceAllNow();
+    }
+    recordTest("Sequential reads across ring wraps are exact", clean && ring->underruns() == 0);
+
+    const uint32_t seeksBefore = ramp->seeks.load();
+    const uint64_t target = kRate * 12;
+    ok = !ring->read(target, 512, out.data());
+    bool silent = true;
+    for (size_t i = 0; i < 1024; ++i) silent &= out[i] == 0.0f;
+    recordTest("Locate outside the ring underruns with silence", ok && silent && ring->underruns() == 1);
+
+    StreamIOPool::getInstance().serviceAllNow();
+    std::vector<float> after(512 * 2);
+    ok = ring->read(target, 512, after.data()) && isRamp(after, target) && ramp->seeks.load() == seeksBefore + 1;
+    recordTest("Ring recovers at the new position after one seek", ok);
+
+    ok = !ring->read(target - kRate, 512, after.data());
+    StreamIOPool::getInstance().serviceAllNow();
+    ok = ok && ring->read(target - kRate, 512, after.data()) && isRamp(after, target - kRate);
+    recordTest("Backward jump re-seeks", ok && ring->underruns() == 2);
+
+    ring->cue(kRate * 15, 0.0);
+    StreamIOPool::getInstance().serviceAllNow();
+    ok = ring->read(kRate * 15, 512, after.data()) && isRamp(after, kRate * 15);
+    recordTest("cue() prefetches before the first read", ok && ring->underruns() == 2);
+
+    std::vector<float> tail(512 * 2, 1.0f);
+    ring->cue(frames - 256, 0.0);
+    StreamIOPool::getInstance().serviceAllNow();
+    ok = ring->read(frames - 256, 512, tail.data());
+    silent = true;
+    for (size_t i = 512; i < tail.size(); ++i) silent &= tail[i] == 0.0f;
+    recordTest("Ring pads past the end of the file", ok && silent);
+}
+
+void testRingConcurrency() {
+    std::cout << "\n=== Test: Ring under the background I/O threads ===\n";
+    const uint64_t frames = kRate * 60;
+    auto ring = std::make_shared<RingStreamSource>(std::make_unique<RampDecoder>(frames), "ramp-mt", 16384);
+    StreamIOPool::getInstance().add(ring);
+
+    // Read as fast as possible with occasional jumps; whatever read() reports as
+    // complete must be the right frames, never a torn mix of old and new data.
+    uint64_t pos = 0;
+    uint64_t complete = 0;
+    uint64_t reads = 0;
+    bool torn = false;
+    std::vector<float> block(kBlockFrames * 2);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(400);
+    while (std::chrono::steady_clock::now() < deadline && pos + kBlockFrames < frames) {
+        if (ring->read(pos, kBlockFrames, block.data())) {
+            ++complete;
+            torn |= !isRamp(block, pos);
+            pos += kBlockFrames;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        if (++reads % 500 == 0) {
+            pos = (pos * 7919 + 12345) % (frames - kRate);
+        }
+    }
+    recordTest("Completed reads are never torn", !torn && complete > 100,
+               std::to_string(complete) + " complete, " + std::to_string(ring->underruns()) + " underruns");
+    recordTest("Pool runs a fixed thread set", StreamIOPool::getInstance().threadCount() == 2);
+}
+
+void testIOScheduler() {
+    std::cout << "\n=== Test: Deadline-ordered I/O scheduling ===\n";
+    StreamIOPool& pool = StreamIOPool::getInstance();
+    pool.setThreadCount(0);   // Drive passes by hand so the order is observable
+
+    // Logs which source each decode came from, in service order.
+    struct LoggingDecoder : RampDecoder {
+        LoggingDecoder(uint64_t frames, char tag, std::string& log) : RampDecoder(frames), tag(tag), log(log) {}
+        uint32_t read(float* dst, uint32_t frames) override {
+            log.push_back(tag);
+            return RampDecoder::read(dst, frames);
+        }
+        char tag;
+        std::string& log;
+    };
+    std::string log;
+    const uint64_t frames = kRate * 30;
+    auto makeRing = [&](char tag) {
+        auto ring = std::make_shared<RingStreamSource>(std::make_unique<LoggingDecoder>(frames, tag, log),
+                                                       std::string("sched-") + tag, kRate);
+        pool.add(ring);
+        return ring;
+    };
+    auto cued = makeRing('A');
+    auto located = makeRing('B');
+    auto playing = makeRing('C');
+    pool.serviceAllNow();
+
+    // A: an upcoming clip needed in 1.5 s. B: a locate the playhead is waiting on.
+    // C: playing, with ~0.2 s left in its read-ahead.
+    cued->cue(kRate * 10, 1.5);
+    located->cue(kRate * 20, 0.0);
+    std::vector<float> out(kBlockFrames * 2);
+    playing->read(kRate * 7 / 10, kBlockFrames, out.data());
+
+    const StreamIOStats before = pool.stats();
+    const uint64_t sourceBytesBefore = cued->bytesLoaded() + located->bytesLoaded() + playing->bytesLoaded();
+    log.clear();
+    pool.serviceOnce();
+    const StreamIOStats after = pool.stats();
+    recordTest("Most urgent deadline is serviced first", log == "BCA", "order " + log);
+    recordTest("Queue depth counts the batch", after.queueDepth == 3 && after.peakQueueDepth >= 3);
+    recordTest("Tightest deadline is reported", after.tightestDeadline == 0.0);
+    const uint64_t sourceBytes = cued->bytesLoaded() + located->bytesLoaded() + playing->bytesLoaded();
+    recordTest("Requests and bytes are counted",
+               after.requests == before.requests + 3 &&
+                   after.bytesLoaded - before.bytesLoaded == sourceBytes - sourceBytesBefore);
+
+    const uint64_t missesBefore = pool.stats().deadlineMisses;
+    playing->read(kRate * 25, kBlockFrames, out.data());
+    recordTest("An underrun counts a deadline miss", pool.stats().deadlineMisses == missesBefore + 1);
+    pool.serviceAllNow();
+    recordTest("Load rate is reported", pool.stats().bytesPerSecond > 0.0);
+
+    // Mapped PCM reads its read-ahead through positional reads.
+    const fs::path dir = tempDir();
+    writeWav(dir / "sched.wav", 2, 16, 1, asWords(pcmSamples(kRate * 4, 2, 16)));
+    auto mapped = MappedPcmSource::open((dir / "sched.wav").string());
+    pool.serviceAllNow();
+    recordTest("Mapped read-ahead is loaded by positional reads",
+               mapped && mapped->bytesLoaded() == mapped->readAheadFrames() * 4,
+               mapped ? std::to_string(mapped->bytesLoaded()) + " bytes" : "open failed");
+    pool.setThreadCount(2);
+}
+
+void testEngineParity() {
+    std::cout << "\n=== Test: Engine renders streamed clips like decoded ones ===\n";
+    const fs::path dir = tempDir();
+    SamplePool& pool = SamplePool::getInstance();
+
+    for (uint32_t rate : {kRate, 44100u}) {
+        const uint64_t frames = rate * 3;
+        const fs::path path = dir / ("parity_" + std::to_string(rate) + ".wav");
+        writeWav(path, 2, 32, 3, floatWords(frames, 2), rate);
+
+        auto streamed = pool.acquireStreaming(path.string());
+        auto decoded = std::make_shared<AudioBuffer>();
+        decoded->channels = 2;
+        decoded->sampleRate = rate;
+        decoded->numFrames = frames;
+        for (uint64_t f = 0; f < frames; ++f) {
+            decoded->data.push_back(signal(f, 0));
+            decoded->data.push_back(signal(f, 1));
+        }
+        decoded->ready.store(true);
+        if (!streamed || !streamed->isStreaming || streamed->numFrames != frames || !streamed->data.empty()) {
+            recordTest("acquireStreaming (" + std::to_string(rate) + " Hz)", false);
+            continue;
+        }
+
+        AudioGraph memGraph;
+        memGraph.tracks.push_back(makeTrack(decoded, 1000, 5000));
+        AudioGraph diskGraph;
+        diskGraph.tracks.push_back(makeTrack(streamed, 1000, 5000));
+
+        AudioEngine memEngine;
+        AudioEngine diskEngine;
+        const uint32_t blocks = 200;
+        const auto a = render(memEngine, memGraph, blocks);
+        const auto b = render(diskEngine, diskGraph, blocks);
+        bool nonSilent = false;
+        for (float v : a) nonSilent |= v != 0.0f;
+        const std::string label = rate == kRate ? "direct" : "resampled";
+        recordTest("Streamed clip renders bit-identically (" + label + ")", a == b && nonSilent);
+        recordTest("Telemetry counts streamed reads (" + label + ")",
+                   diskEngine.telemetry().getStreamedClipReads() > 0 &&
+                   diskEngine.telemetry().getStreamUnderruns() == 0 &&
+                   memEngine.telemetry().getStreamedClipReads() == 0);
+    }
+
+    recordTest("Streaming buffers stay out of the memory budget", pool.getMemoryUsage() == 0,
+               std::to_string(pool.getMemoryUsage()) + " bytes");
+}
+
+void testEngineUnderrunAndCue() {
+    std::cout << "\n=== Test: Engine underrun telemetry and cueing ===\n";
+    const uint64_t frames = kRate * 30;
+    auto decoder = std::make_unique<RampDecoder>(frames);
+    auto ring = std::make_shared<RingStreamSource>(std::move(decoder), "ramp-engine", kRate);
+    StreamIOPool::getInstance().setThreadCount(0);   // Nothing fills the ring behind our back
+    StreamIOPool::getInstance().add(ring);
+
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = kRate;
+    buffer->numFrames = frames;
+    buffer->isStreaming = true;
+    buffer->stream = ring;
+    buffer->ready.store(true);
+
+    // The clip starts one second in, playing from ten seconds into the file.
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(buffer, kRate, kRate * 10));
+    AudioEngine engine;
+    render(engine, graph, 4, false);
+
+    // Only the engine's cue could have moved the ring from the head of the file.
+    StreamIOPool::getInstance().serviceAllNow();
+    std::vector<float> out(256 * 2);
+    recordTest("Upcoming clip is cued during the look-ahead",
+               ring->read(kRate * 10, 256, out.data()) && isRamp(out, kRate * 10) && ring->underruns() == 0);
+
+    // Render across the clip start without servicing: the ring runs dry.
+    AudioEngine dry;
+    const uint32_t blocks = (kRate * 2) / kBlockFrames;
+    render(dry, graph, blocks, false);
+    recordTest("Starved stream is reported in telemetry",
+               dry.telemetry().getStreamUnderruns() > 0 && ring->underruns() > 0,
+               std::to_string(dry.telemetry().getStreamUnderruns()) + " underrun blocks");
+    StreamIOPool::getInstance().setThreadCount(2);
+}
+
+void testEngineOutOfOrderRing() {
+    std::cout << "\n=== Test: Reversed and looped clips from a ring stream ===\n";
+    const uint64_t frames = kRate * 4;
+    auto ring = std::make_shared<RingStreamSource>(std::make_unique<RampDecoder>(frames), "ramp-reverse", kRate / 2);
+    StreamIOPool::getInstance().add(ring);
+    auto streamed = std::make_shared<AudioBuffer>();
+    streamed->channels = 2;
+    streamed->sampleRate = kRate;
+    streamed->numFrames = frames;
+    streamed->isStreaming = true;
+    streamed->stream = ring;
+    streamed->ready.store(true);
+
+    auto decoded = std::make_shared<AudioBuffer>();
+    decoded->channels = 2;
+    decoded->sampleRate = kRate;
+    decoded->numFrames = frames;
+    decoded->data.resize(static_cast<size_t>(frames) * 2);
+    for (uint64_t f = 0; f < frames; ++f) {
+        decoded->data[f * 2] = RampDecoder::value(f);
+        decoded->data[f * 2 + 1] = -RampDecoder::value(f);
+    }
+    decoded->ready.store(true);
+
+    // Both outlast the ring's half second: the first window alone can't serve them.
+    const uint32_t blocks = static_cast<uint32_t>((kRate * 2) / kBlockFrames);
+    auto reversed = [](TrackRenderState track) {
+        track.clips[0].reversed = true;
+        return track;
+    };
+    auto looped = [](TrackRenderState track) {
+        track.clips[0].loopFrames = kRate / 4;
+        return track;
+    };
+    struct Case {
+        const char* label;
+        TrackRenderState (*edit)(TrackRenderState);
+    };
+    for (const Case& c : {Case{"reversed", reversed}, Case{"looped", looped}}) {
+        AudioGraph diskGraph;
+        diskGraph.tracks.push_back(c.edit(makeTrack(streamed, 0, kRate)));
+        AudioGraph memGraph;
+        memGraph.tracks.push_back(c.edit(makeTrack(decoded, 0, kRate)));
+
+        AudioEngine diskEngine;
+        AudioEngine memEngine;
+        const std::vector<float> a = render(diskEngine, diskGraph, blocks);
+        const std::vector<float> b = render(memEngine, memGraph, blocks);
+        bool tailSounds = false;
+        for (size_t i = a.size() - kBlockFrames * 2; i < a.size(); ++i) tailSounds |= a[i] != 0.0f;
+        recordTest(std::string("Ring-streamed ") + c.label + " clip plays past the first window",
+                   a == b && tailSounds && diskEngine.telemetry().getStreamUnderruns() == 0);
+    }
+}
+
+void testEngineDecodesInBackground() {
+    std::cout << "\n=== Test: Decoded copies load in the background ===\n";
+    const uint64_t frames = kRate * 4;
+    auto open = std::make_shared<std::atomic<bool>>(false);
+    auto ring = std::make_shared<RingStreamSource>(std::make_unique<GatedRampDecoder>(frames, open),
+                                                   "ramp-gated", kRate / 2);
+    StreamIOPool::getInstance().add(ring);
+    auto streamed = std::make_shared<AudioBuffer>();
+    streamed->channels = 2;
+    streamed->sampleRate = kRate;
+    streamed->numFrames = frames;
+    streamed->isStreaming = true;
+    streamed->stream = ring;
+    streamed->ready.store(true);
+
+    AudioGraph graph;
+    graph.tracks.push_back(makeTrack(streamed, 0, kRate));
+    graph.tracks[0].clips[0].reversed = true;
+
+    // The decode can't finish before the gate opens; a blocking setGraph() would wait it out.
+    std::thread opener([open] {
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        open->store(true);
+    });
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kBlockFrames, 2);
+    const auto before = std::chrono::steady_clock::now();
+    engine.setGraph(graph);
+    const bool quick = std::chrono::steady_clock::now() - before < std::chrono::seconds(1);
+    const bool streaming = engine.engineState().copyActiveGraph().tracks[0].clips[0].stream == ring.get();
+    recordTest("setGraph() plays the stream while the copy decodes",
+               quick && streaming && !engine.refreshDecodedStreams());
+
+    open->store(true);
+    opener.join();
+    bool refreshed = false;
+    for (int i = 0; i < 5000 && !refreshed; ++i) {
+        refreshed = engine.refreshDecodedStreams();
+        if (!refreshed) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const ClipRenderState clip = engine.engineState().copyActiveGraph().tracks[0].clips[0];
+    recordTest("The graph is republished with the decoded copy",
+               refreshed && !clip.stream && clip.audioData && clip.totalFrames == frames);
+}
+
+void testTrackStreamedClip() {
+    std::cout << "\n=== Test: Editing a streamed clip ===\n";
+    const uint64_t frames = kRate * 2;
+    const fs::path dir = tempDir();
+    const auto pcm16 = pcmSamples(frames, 2, 16);
+    std::vector<uint32_t> words16;
+    for (int32_t s : pcm16) words16.push_back(static_cast<uint32_t>(s) & 0xFFFF);
+    writeAiff(dir / "clip.aiff", 2, 16, nullptr, words16, false);
+
+    // AIFF always streams.
+    Track track("Streamed", 1);
+    const bool loaded = track.loadAudioFile((dir / "clip.aiff").string());
+    recordTest("Streamed clip has audio to show", loaded && track.isStreamed() && track.hasAudioData());
+
+    // Peaks come from the stream, in the background; poll like the UI does.
+    std::shared_ptr<const WaveformCache> cache;
+    for (int i = 0; i < 2000 && !(cache && cache->isReady()); ++i) {
+        cache = track.getWaveformCache();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto expected = intToFloat(pcm16, 32768.0f);
+    WaveformCache direct;
+    direct.buildFromRaw(expected.data(), static_cast<SampleIndex>(frames), 2);
+    bool samePeaks = cache && cache->isReady() && cache->getSourceFrames() == direct.getSourceFrames() &&
+                     cache->getNumLevels() == direct.getNumLevels();
+    for (size_t i = 0; samePeaks && i < direct.getNumLevels(); ++i) {
+        const WaveformMipLevel* a = cache->getLevel(i);
+        const WaveformMipLevel* b = direct.getLevel(i);
+        samePeaks = a->size() == b->size() &&
+                    std::memcmp(a->data(), b->data(), a->size() * sizeof(WaveformPeak)) == 0;
+    }
+    recordTest("Streamed peaks equal a build from the decoded samples", samePeaks);
+
+    // A split shares the stream and narrows the trims on both sides.
+    track.setStartPositionInTimeline(10.0);
+    auto second = track.splitAt(0.5);
+    recordTest("Split of a streamed clip shares the stream",
+               second && second->isStreamed() && second->hasAudioData() &&
+               track.getTrimEnd() == 0.5 && second->getTrimStart() == 0.5 &&
+               second->getStartPositionInTimeline() == 10.5 &&
+               std::abs(second->getTrimmedDuration() - 1.5) < 1e-9);
+
+    auto copy = track.duplicate();
+    recordTest("Duplicate of a streamed clip keeps the stream and the trims",
+               copy && copy->isStreamed() && copy->getTrimEnd() == 0.5 &&
+               std::abs(copy->getTrimmedDuration() - 0.5) < 1e-9);
+
+    Track memory("Memory", 2);
+    memory.setAudioData(expected.data(), static_cast<uint32_t>(frames), kRate, 2);
+    recordTest("Only streamed clips share a stream", !memory.isStreamed() && !memory.shareStream(memory) &&
+               !memory.splitStreamInto(*copy, 0.25));
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    Log::setLevel(LogLevel::Error);
+
+    std::cout << "==========================================\n";
+    std::cout << "  Streaming Source Tests\n";
+    std::cout << "==========================================\n";
+
+    testMappedWav();
+    testMappedAiff();
+    testMappedEdgesAndUnderruns();
+    testRingSource();
+    testRingConcurrency();
+    testIOScheduler();
+    testEngineParity();
+    testEngineUnderrunAndCue();
+    testEngineOutOfOrderRing();
+    testEngineDecodesInBackground();
+    testTrackStreamedClip();
+
+    std::error_code ec;
+    fs::remove_all(tempDir(), ec);
+
+    int passed = 0;
+    int failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) {
+            ++passed;
+        } else {
+            ++failed;
+        }
+    }
+
+    std::cout << "\n==========================================\n";
+    std::cout << "  Summary: " << passed << " passed, " << failed << " failed\n";
+    std::cout << "==========================================\n";
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Time-stretch cost per voice: ns per 512-frame block and real-time voices per core for each
+// quality tier, against plain varispeed playback through the clip resampler
+
+#include "ClipResampler.h"
+#include "TimeStretcher.h"
+#include "NomadLog.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile double g_sink = 0.0;
+
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kBlockFrames = 512;
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per call.
+ */
+double nsPerCall(double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    fn();   // Warm-up
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        fn();
+        ++iterations;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+}
+
+/// Clip source as the engine reads it: interleaved stereo through a cubic resampler.
+struct Source {
+    std::vector<float> data;
+    uint64_t frames{0};
+    ClipResampler resampler;
+
+    static bool read(void* context, double position, double step, double* dst, uint32_t count) {
+        const Source& s = *static_cast<const Source*>(context);
+        s.resampler.process(s.data.data(), s.frames, position, step, dst, count);
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    double minMs = 500.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    // Ten seconds of a chord with some noise, so the search has real work to do.
+    Source source;
+    source.frames = kRate * 10;
+    source.data.resize(static_cast<size_t>(source.frames) * 2);
+    uint32_t noise = 1;
+    for (uint64_t i = 0; i < source.frames; ++i) {
+        noise = noise * 1664525u + 1013904223u;
+        const double t = static_cast<double>(i) / kRate;
+        const double v = 0.2 * std::sin(6.2831853 * 220.0 * t) + 0.15 * std::sin(6.2831853 * 277.2 * t) +
+                         0.1 * std::sin(6.2831853 * 329.6 * t) + 0.02 * (static_cast<double>(noise >> 8) / 8388608.0 - 1.0);
+        source.data[i * 2] = static_cast<float>(v);
+        source.data[i * 2 + 1] = static_cast<float>(v * 0.9);
+    }
+    source.resampler.configure(kRate, kRate, SRCQuality::Cubic);
+
+    const double blockNs = 1e9 * kBlockFrames / kRate;
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Time-Stretch Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  " << kBlockFrames << "-frame blocks at " << kRate / 1000 << " kHz (" << std::fixed
+              << std::setprecision(2) << blockNs / 1e6 << " ms budget), cubic source reads\n\n";
+    std::cout << "  " << std::left << std::setw(38) << "Benchmark" << std::right << std::setw(12) << "us/block"
+              << std::setw(14) << "voices/core" << "\n";
+    std::cout << "  " << std::string(64, '-') << "\n";
+
+    auto report = [&](const std::string& label, double ns) {
+        std::cout << "  " << std::left << std::setw(38) << label << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << ns / 1e3 << std::setprecision(0) << std::setw(14) << blockNs / ns << "\n";
+    };
+
+    // Blocks walk through the first eight seconds of output and wrap.
+    const uint64_t wrapFrames = kRate * 8;
+    std::vector<double> block(static_cast<size_t>(kBlockFrames) * 2);
+
+    for (double tempo : {0.8, 1.25}) {
+        uint64_t frame = 0;
+        const double varispeedNs = nsPerCall(minMs, [&] {
+            Source::read(&source, static_cast<double>(frame) * tempo, tempo, block.data(), kBlockFrames);
+            frame = (frame + kBlockFrames) % wrapFrames;
+            g_sink = g_sink + block[0];
+        });
+        report("BM_Varispeed/tempo" + std::to_string(tempo).substr(0, 4), varispeedNs);
+    }
+
+    struct Case {
+        const char* name;
+        double tempo;
+        double pitch;
+    };
+    const Case cases[] = {{"tempo0.80", 0.8, 1.0}, {"tempo1.25", 1.25, 1.0}, {"pitch+5st", 1.0, std::pow(2.0, 5.0 / 12.0)}};
+    for (StretchQuality quality : {StretchQuality::Realtime, StretchQuality::HighQuality}) {
+        const std::string tier = quality == StretchQuality::Realtime ? "Realtime" : "HighQuality";
+        for (const Case& c : cases) {
+            TimeStretcher voice;
+            voice.configure(quality);
+            uint64_t frame = 0;
+            const double ns = nsPerCall(minMs, [&] {
+                voice.process(&Source::read, &source, 0.0, c.tempo, c.pitch, frame, block.data(), kBlockFrames);
+                frame = (frame + kBlockFrames) % wrapFrames;
+                g_sink = g_sink + block[0];
+            });
+            report("BM_Stretch/" + tier + "/" + c.name, ns);
+        }
+    }
+    return 0;
+}
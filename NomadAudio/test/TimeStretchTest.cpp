@@ -0,0 +1,418 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for the WSOLA time-stretch voice: identity, tempo without pitch change,
+// pitch without tempo change, onset preservation and engine playback of stretched clips
+
+#include "TimeStretcher.h"
+#include "AudioEngine.h"
+#include "SamplePool.h"
+#include "StreamingSource.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr uint32_t kRate = 48000;
+constexpr uint32_t kBlock = 512;
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+/// Interleaved stereo source read with linear interpolation; silence outside it.
+struct Source {
+    std::vector<float> data;
+    uint64_t frames{0};
+
+    static bool read(void* context, double position, double step, double* dst, uint32_t count) {
+        const Source& s = *static_cast<const Source*>(context);
+        for (uint32_t i = 0; i < count; ++i) {
+            const double pos = position + i * step;
+            const double whole = std::floor(pos);
+            const double frac = pos - whole;
+            for (uint32_t ch = 0; ch < 2; ++ch) {
+                auto at = [&](double f) {
+                    return f >= 0.0 && f < static_cast<double>(s.frames) ? s.data[static_cast<size_t>(f) * 2 + ch] : 0.0f;
+                };
+                dst[i * 2 + ch] = at(whole) * (1.0 - frac) + at(whole + 1.0) * frac;
+            }
+        }
+        return true;
+    }
+};
+
+Source makeSine(double freq, double seconds, double (*envelope)(double) = nullptr) {
+    Source s;
+    s.frames = static_cast<uint64_t>(seconds * kRate);
+    s.data.resize(s.frames * 2);
+    for (uint64_t i = 0; i < s.frames; ++i) {
+        const double t = static_cast<double>(i) / s.frames;
+        const double v = (envelope ? envelope(t) : 0.5) * std::sin(2.0 * PI * freq * i / kRate);
+        s.data[i * 2] = s.data[i * 2 + 1] = static_cast<float>(v);
+    }
+    return s;
+}
+
+/// Render frames output frames in engine-sized blocks; returns the left channel.
+std::vector<double> stretch(Source& source, StretchQuality quality, double tempo, double pitch, uint64_t frames,
+                            uint64_t firstFrame = 0, TimeStretcher* voiceOut = nullptr) {
+    TimeStretcher local;
+    TimeStretcher& voice = voiceOut ? *voiceOut : local;
+    if (!voice.isConfigured()) {
+        voice.configure(quality);
+    }
+    std::vector<double> block(kBlock * 2);
+    std::vector<double> left;
+    left.reserve(frames);
+    for (uint64_t done = 0; done < frames; done += kBlock) {
+        const uint32_t n = static_cast<uint32_t>(std::min<uint64_t>(kBlock, frames - done));
+        voice.process(&Source::read, &source, 0.0, tempo, pitch, firstFrame + done, block.data(), n);
+        for (uint32_t i = 0; i < n; ++i) left.push_back(block[i * 2]);
+    }
+    return left;
+}
+
+/// Frequency from upward zero crossings (interpolated) over [from, to).
+double measureFrequency(const std::vector<double>& x, size_t from, size_t to) {
+    double first = -1.0, last = -1.0;
+    int crossings = 0;
+    for (size_t i = from + 1; i < to && i < x.size(); ++i) {
+        if (x[i - 1] < 0.0 && x[i] >= 0.0) {
+            const double at = static_cast<double>(i - 1) + x[i - 1] / (x[i - 1] - x[i]);
+            if (first < 0.0) first = at;
+            last = at;
+            ++crossings;
+        }
+    }
+    return crossings > 1 ? (crossings - 1) * kRate / (last - first) : 0.0;
+}
+
+double rms(const std::vector<double>& x, size_t from, size_t count) {
+    double sum = 0.0;
+    for (size_t i = from; i < from + count; ++i) sum += x[i] * x[i];
+    return std::sqrt(sum / count);
+}
+
+const char* tierName(StretchQuality quality) {
+    return quality == StretchQuality::Realtime ? "Realtime" : "HighQuality";
+}
+
+float engineSine(uint64_t frame) {
+    return static_cast<float>(0.5 * std::sin(2.0 * PI * 440.0 * static_cast<double>(frame) / kRate));
+}
+
+/// The engine test tone, decoded sequentially like a compressed file.
+class SineDecoder : public StreamDecoder {
+public:
+    explicit SineDecoder(uint64_t frames) : m_frames(frames) {}
+    uint32_t sampleRate() const override { return kRate; }
+    uint32_t sourceChannels() const override { return 2; }
+    uint64_t numFrames() const override { return m_frames; }
+    bool seek(uint64_t frame) override { m_position = frame; return true; }
+    uint32_t read(float* dst, uint32_t frames) override {
+        const uint64_t n = std::min<uint64_t>(frames, m_frames - std::min(m_position, m_frames));
+        for (uint64_t i = 0; i < n; ++i) {
+            dst[i * 2] = dst[i * 2 + 1] = engineSine(m_position + i);
+        }
+        m_position += n;
+        return static_cast<uint32_t>(n);
+    }
+    std::unique_ptr<StreamDecoder> reopen() const override { return std::make_unique<SineDecoder>(m_frames); }
+
+private:
+    uint64_t m_frames;
+    uint64_t m_position{0};
+};
+
+/// One second of a 0.8x clip through the engine; returns the left channel.
+std::vector<double> renderClip(const std::shared_ptr<AudioBuffer>& buffer, bool preservePitch, double pitchRatio) {
+    AudioGraph graph;
+    TrackRenderState track;
+    track.trackId = 1;
+    ClipRenderState clip;
+    clip.buffer = buffer;
+    clip.audioData = buffer->isStreaming ? nullptr : buffer->data.data();
+    clip.stream = buffer->isStreaming ? buffer->stream.get() : nullptr;
+    clip.endSample = kRate;
+    clip.totalFrames = buffer->numFrames;
+    clip.sourceSampleRate = kRate;
+    clip.playbackRate = 0.8;
+    clip.preservePitch = preservePitch;
+    clip.pitchRatio = pitchRatio;
+    track.clips.push_back(clip);
+    graph.tracks.push_back(track);
+
+    AudioEngine engine;
+    engine.setSampleRate(kRate);
+    engine.setBufferConfig(kBlock, 2);
+    engine.setGraph(graph);
+    engine.waitForDecodedStreams();
+    AudioQueueCommand cmd;
+    cmd.type = AudioQueueCommandType::SetTransportState;
+    cmd.value1 = 1.0f;
+    engine.commandQueue().push(cmd);
+
+    std::vector<float> block(kBlock * 2);
+    std::vector<double> left;
+    for (uint32_t b = 0; b < kRate / kBlock; ++b) {
+        StreamIOPool::getInstance().serviceAllNow();
+        engine.processBlock(block.data(), nullptr, kBlock, 0.0);
+        for (uint32_t i = 0; i < kBlock; ++i) left.push_back(block[i * 2]);
+    }
+    return left;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testIdentity() {
+    std::cout << "\n=== Test: Unity tempo and pitch ===\n";
+    Source sine = makeSine(440.0, 1.0);
+    for (StretchQuality quality : {StretchQuality::Realtime, StretchQuality::HighQuality}) {
+        const auto out = stretch(sine, quality, 1.0, 1.0, kRate / 2);
+        double maxErr = 0.0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            maxErr = std::max(maxErr, std::abs(out[i] - sine.data[i * 2]));
+        }
+        recordTest(std::string("Unity stretch reproduces the source (") + tierName(quality) + ")", maxErr < 1e-6,
+                   "max error " + std::to_string(maxErr));
+    }
+}
+
+void testTempo() {
+    std::cout << "\n=== Test: Tempo without pitch change ===\n";
+    Source sine = makeSine(440.0, 4.0);
+    for (StretchQuality quality : {StretchQuality::Realtime, StretchQuality::HighQuality}) {
+        for (double tempo : {0.5, 0.8, 1.25, 2.0}) {
+            const auto out = stretch(sine, quality, tempo, 1.0, kRate);
+            const double freq = measureFrequency(out, 4096, kRate - 4096);
+            recordTest(std::string(tierName(quality)) + " tempo " + std::to_string(tempo).substr(0, 4) +
+                       " keeps 440 Hz", std::abs(freq - 440.0) < 440.0 * 0.005, std::to_string(freq) + " Hz");
+        }
+    }
+
+    // The output follows the source timeline at the tempo: the envelope at output frame t
+    // is the source's at t * tempo.
+    Source ramp = makeSine(440.0, 4.0, [](double t) { return t; });
+    const double tempo = 0.5;
+    const auto out = stretch(ramp, StretchQuality::Realtime, tempo, 1.0, kRate * 4);
+    double worst = 0.0;
+    for (size_t at = kRate / 2; at + 4800 < out.size(); at += kRate / 2) {
+        const double expected = (static_cast<double>(at + 2400) * tempo / ramp.frames) / std::sqrt(2.0);
+        worst = std::max(worst, std::abs(rms(out, at, 4800) / expected - 1.0));
+    }
+    recordTest("Stretched output tracks the source timeline", worst < 0.05,
+               "worst envelope error " + std::to_string(worst * 100.0) + "%");
+}
+
+void testPitch() {
+    std::cout << "\n=== Test: Pitch without tempo change ===\n";
+    Source sine = makeSine(440.0, 4.0);
+    for (StretchQuality quality : {StretchQuality::Realtime, StretchQuality::HighQuality}) {
+        for (double semitones : {-12.0, 7.0}) {
+            const double pitch = std::pow(2.0, semitones / 12.0);
+            const auto out = stretch(sine, quality, 1.0, pitch, kRate);
+            const double freq = measureFrequency(out, 4096, kRate - 4096);
+            recordTest(std::string(tierName(quality)) + " pitch " + std::to_string(static_cast<int>(semitones)) +
+                       " st", std::abs(freq / (440.0 * pitch) - 1.0) < 0.005, std::to_string(freq) + " Hz");
+        }
+    }
+}
+
+void testOnsets() {
+    std::cout << "\n=== Test: Onset preservation ===\n";
+    // Decaying clicks every 150 ms; stretching must neither double, drop nor soften them.
+    Source clicks;
+    clicks.frames = kRate * 3;
+    clicks.data.assign(clicks.frames * 2, 0.0f);
+    const uint64_t spacing = kRate * 15 / 100;
+    double clickPeak = 0.0;
+    for (uint64_t c = spacing / 2; c + 2000 < clicks.frames; c += spacing) {
+        for (uint64_t i = 0; i < 2000; ++i) {
+            const float v = static_cast<float>(0.9 * std::exp(-static_cast<double>(i) / 150.0) *
+                                               std::sin(2.0 * PI * 1500.0 * i / kRate));
+            clicks.data[(c + i) * 2] = clicks.data[(c + i) * 2 + 1] = v;
+            clickPeak = std::max(clickPeak, static_cast<double>(std::abs(v)));
+        }
+    }
+
+    for (double tempo : {0.5, 0.75, 1.5}) {
+        TimeStretcher voice;
+        voice.configure(StretchQuality::Realtime);
+        const uint64_t frames = static_cast<uint64_t>((clicks.frames - kRate / 4) / tempo);
+        const auto out = stretch(clicks, StretchQuality::Realtime, tempo, 1.0, frames, 0, &voice);
+
+        // Onsets: the envelope rising past half scale after a quiet stretch.
+        int onsets = 0;
+        size_t quiet = 0;
+        bool armed = false;
+        double softest = 1.0;
+        for (size_t i = 0; i < out.size(); ++i) {
+            quiet = std::abs(out[i]) < 0.05 ? quiet + 1 : 0;
+            armed |= quiet > 1500;
+            if (armed && std::abs(out[i]) > 0.2) {
+                ++onsets;
+                armed = false;
+                double peak = 0.0;
+                for (size_t j = i; j < std::min(out.size(), i + 200); ++j) peak = std::max(peak, std::abs(out[j]));
+                softest = std::min(softest, peak / clickPeak);
+            }
+        }
+        int expected = 0;
+        for (uint64_t c = spacing / 2; c < static_cast<uint64_t>(frames * tempo); c += spacing) ++expected;
+        recordTest("Tempo " + std::to_string(tempo).substr(0, 4) + ": every click once, at full level",
+                   onsets == expected && softest > 0.98,
+                   std::to_string(onsets) + " of " + std::to_string(expected) + ", softest at " +
+                   std::to_string(softest * 100.0) + "%, " + std::to_string(voice.transientGrains()) +
+                   " onset grains");
+    }
+}
+
+void testRelocation() {
+    std::cout << "\n=== Test: Relocation ===\n";
+    Source sine = makeSine(440.0, 4.0);
+    TimeStretcher voice;
+    voice.configure(StretchQuality::Realtime);
+    stretch(sine, StretchQuality::Realtime, 0.8, 1.0, kRate / 4, 0, &voice);
+    const auto jumped = stretch(sine, StretchQuality::Realtime, 0.8, 1.0, kBlock * 8, kRate, &voice);
+    const auto fresh = stretch(sine, StretchQuality::Realtime, 0.8, 1.0, kBlock * 8, kRate);
+    double diff = 0.0;
+    for (size_t i = 0; i < jumped.size(); ++i) diff = std::max(diff, std::abs(jumped[i] - fresh[i]));
+    recordTest("A jump restarts the grid like a fresh voice", diff == 0.0, "max diff " + std::to_string(diff));
+}
+
+void testEngineClips() {
+    std::cout << "\n=== Test: Stretched clips in the engine ===\n";
+    auto buffer = std::make_shared<AudioBuffer>();
+    buffer->channels = 2;
+    buffer->sampleRate = kRate;
+    buffer->numFrames = kRate * 2;
+    buffer->data.resize(static_cast<size_t>(buffer->numFrames) * 2);
+    for (uint32_t i = 0; i < buffer->numFrames; ++i) {
+        buffer->data[i * 2] = buffer->data[i * 2 + 1] = engineSine(i);
+    }
+    buffer->ready.store(true, std::memory_order_release);
+
+    auto render = [&](bool preservePitch, double pitchRatio) {
+        const std::vector<double> left = renderClip(buffer, preservePitch, pitchRatio);
+        return measureFrequency(left, 4096, left.size() - 4096);
+    };
+
+    const double varispeed = render(false, 1.0);
+    const double stretched = render(true, 1.0);
+    const double shifted = render(true, std::pow(2.0, 5.0 / 12.0));
+    recordTest("Varispeed clip drops pitch with tempo", std::abs(varispeed - 352.0) < 2.0,
+               std::to_string(varispeed) + " Hz");
+    recordTest("Pitch-preserving clip keeps 440 Hz", std::abs(stretched - 440.0) < 2.0,
+               std::to_string(stretched) + " Hz");
+    recordTest("Pitch-shifted clip plays a fourth up", std::abs(shifted / (440.0 * std::pow(2.0, 5.0 / 12.0)) - 1.0) < 0.005,
+               std::to_string(shifted) + " Hz");
+}
+
+void testStreamedClip() {
+    std::cout << "\n=== Test: Stretched clip from a read-ahead ring ===\n";
+    const uint64_t frames = kRate * 2;
+    // A quarter-second ring: the stretch outlasts its first window several times over.
+    auto ring = std::make_shared<RingStreamSource>(std::make_unique<SineDecoder>(frames), "sine-stretch", kRate / 4);
+    StreamIOPool::getInstance().add(ring);
+    auto streamed = std::make_shared<AudioBuffer>();
+    streamed->channels = 2;
+    streamed->sampleRate = kRate;
+    streamed->numFrames = frames;
+    streamed->isStreaming = true;
+    streamed->stream = ring;
+    streamed->ready.store(true, std::memory_order_release);
+
+    auto decoded = std::make_shared<AudioBuffer>();
+    decoded->channels = 2;
+    decoded->sampleRate = kRate;
+    decoded->numFrames = frames;
+    decoded->data.resize(static_cast<size_t>(frames) * 2);
+    for (uint32_t i = 0; i < frames; ++i) {
+        decoded->data[i * 2] = decoded->data[i * 2 + 1] = engineSine(i);
+    }
+    decoded->ready.store(true, std::memory_order_release);
+
+    const std::vector<double> fromRing = renderClip(streamed, true, 1.0);
+    const std::vector<double> fromMemory = renderClip(decoded, true, 1.0);
+    const size_t tail = fromRing.size() - kBlock * 4;
+    recordTest("Streamed stretched clip matches the decoded one", fromRing == fromMemory);
+    recordTest("Streamed stretched clip still sounds after the first window", rms(fromRing, tail, kBlock * 4) > 0.1,
+               "tail RMS " + std::to_string(rms(fromRing, tail, kBlock * 4)));
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Time-Stretch Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testIdentity();
+    testTempo();
+    testPitch();
+    testOnsets();
+    testRelocation();
+    testEngineClips();
+    testStreamedClip();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
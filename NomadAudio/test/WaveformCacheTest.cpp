@@ -0,0 +1,471 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for WaveformCache: single-pass parallel build, persistent peak files,
+// incremental append and the per-clip vertex cache
+
+#include "WaveformCache.h"
+#include "Track.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+fs::path tempDir() {
+    const fs::path dir = fs::temp_directory_path() / "nomad_waveformcache_test";
+    fs::create_directories(dir);
+    return dir;
+}
+
+/// A stand-in source file; peak files only look at its size and mtime.
+std::string makeSourceFile(const std::string& name, size_t bytes) {
+    const fs::path path = tempDir() / name;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(bytes, 'x');
+    return path.string();
+}
+
+/// Stereo test material: two sines at different rates plus a rising DC offset.
+std::vector<float> makeAudio(SampleIndex frames) {
+    std::vector<float> data(static_cast<size_t>(frames) * 2);
+    for (SampleIndex i = 0; i < frames; ++i) {
+        data[i * 2] = static_cast<float>(0.8 * std::sin(0.013 * i));
+        data[i * 2 + 1] = static_cast<float>(0.5 * std::sin(0.0021 * i) + 1e-6 * i);
+    }
+    return data;
+}
+
+bool sameLevels(const WaveformCache& a, const WaveformCache& b) {
+    if (a.getNumLevels() != b.getNumLevels() || a.getNumChannels() != b.getNumChannels() ||
+        a.getSourceFrames() != b.getSourceFrames()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.getNumLevels(); ++i) {
+        const WaveformMipLevel* la = a.getLevel(i);
+        const WaveformMipLevel* lb = b.getLevel(i);
+        if (la->samplesPerPeak != lb->samplesPerPeak || la->numPeaks != lb->numPeaks ||
+            la->size() != lb->size() ||
+            std::memcmp(la->data(), lb->data(), la->size() * sizeof(WaveformPeak)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testSinglePassBuild() {
+    std::cout << "\n=== Test: Single-pass and parallel build ===\n";
+    // Several parallel chunks, with a partial last peak at every level.
+    const SampleIndex frames = 3 * (1 << 18) + 12345;
+    const auto audio = makeAudio(frames);
+
+    WaveformCache::setBuildThreads(1);
+    WaveformCache serial;
+    serial.buildFromRaw(audio.data(), frames, 2);
+    WaveformCache::setBuildThreads(4);
+    WaveformCache parallel;
+    parallel.buildFromRaw(audio.data(), frames, 2);
+    WaveformCache::setBuildThreads(0);
+    recordTest("Parallel build equals the serial build", sameLevels(serial, parallel));
+
+    // Every level against a direct scan of the samples it covers.
+    bool exact = true;
+    for (size_t i = 0; i < serial.getNumLevels() && exact; ++i) {
+        const WaveformMipLevel* level = serial.getLevel(i);
+        for (SampleIndex p = 0; p < level->numPeaks && exact; p += 97) {
+            for (uint32_t ch = 0; ch < 2; ++ch) {
+                float mn = 1.0f, mx = -1.0f;
+                const SampleIndex end = std::min<SampleIndex>((p + 1) * level->samplesPerPeak, frames);
+                for (SampleIndex f = p * level->samplesPerPeak; f < end; ++f) {
+                    mn = std::min(mn, audio[f * 2 + ch]);
+                    mx = std::max(mx, audio[f * 2 + ch]);
+                }
+                const WaveformPeak peak = level->getPeak(ch, p);
+                exact = exact && peak.min == mn && peak.max == mx;
+            }
+        }
+    }
+    recordTest("Every level matches a direct scan", exact);
+}
+
+void testPeakFileRoundTrip() {
+    std::cout << "\n=== Test: Peak file round trip ===\n";
+    const SampleIndex frames = 100003;
+    const auto audio = makeAudio(frames);
+    const std::string source = makeSourceFile("roundtrip.wav", 4096);
+
+    WaveformCache built;
+    built.buildFromRaw(audio.data(), frames, 2);
+    recordTest("Peak file is written", built.savePeakFile(source) && fs::exists(WaveformCache::peakFilePath(source)));
+
+    WaveformCache loaded;
+    recordTest("Peak file loads", loaded.loadPeakFile(source) && loaded.isReady());
+    recordTest("Loaded levels are mapped, not copied", loaded.isMapped() && loaded.getMemoryUsage() == 0);
+    recordTest("Loaded peaks match the build bit for bit", sameLevels(built, loaded));
+
+    std::vector<WaveformPeak> a, b;
+    built.getPeaksForRange(1, 1000, 90000, 317, a);
+    loaded.getPeaksForRange(1, 1000, 90000, 317, b);
+    recordTest("getPeaksForRange agrees", a.size() == b.size() &&
+                                          std::memcmp(a.data(), b.data(), a.size() * sizeof(WaveformPeak)) == 0);
+
+    WaveformCache otherSettings;
+    recordTest("Different level settings are rejected", !otherSettings.loadPeakFile(source, 128, 5) &&
+                                                        !otherSettings.isReady());
+}
+
+void testStaleAndCorruptFilesAreRejected() {
+    std::cout << "\n=== Test: Stale and corrupt peak files ===\n";
+    const SampleIndex frames = 20000;
+    const auto audio = makeAudio(frames);
+    const std::string source = makeSourceFile("stale.wav", 1000);
+
+    WaveformCache built;
+    built.buildFromRaw(audio.data(), frames, 2);
+    built.savePeakFile(source);
+
+    makeSourceFile("stale.wav", 1001);   // Source re-rendered: size (and mtime) change
+    WaveformCache stale;
+    recordTest("Changed source makes the peak file stale", !stale.loadPeakFile(source));
+
+    built.savePeakFile(source);
+    const std::string peakPath = WaveformCache::peakFilePath(source);
+    {
+        std::fstream file(peakPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(8);
+        const uint32_t futureVersion = WaveformCache::PEAK_FILE_VERSION + 1;
+        file.write(reinterpret_cast<const char*>(&futureVersion), sizeof(futureVersion));
+    }
+    WaveformCache versioned;
+    recordTest("Other format versions are rejected", !versioned.loadPeakFile(source));
+
+    built.savePeakFile(source);
+    fs::resize_file(peakPath, fs::file_size(peakPath) - 16);
+    WaveformCache truncated;
+    recordTest("Truncated peak files are rejected", !truncated.loadPeakFile(source));
+
+    fs::remove(peakPath);
+    WaveformCache missing;
+    recordTest("Missing peak file fails to load", !missing.loadPeakFile(source));
+}
+
+void testAppendMatchesFullBuild() {
+    std::cout << "\n=== Test: Incremental append ===\n";
+    const SampleIndex frames = 70001;
+    const auto audio = makeAudio(frames);
+
+    WaveformCache full;
+    full.buildFromRaw(audio.data(), frames, 2);
+
+    // Uneven chunks, as a recording delivers them, straddling peak boundaries.
+    WaveformCache appended;
+    const SampleIndex chunks[] = {1, 63, 64, 1000, 37, 4096, 12345};
+    SampleIndex done = 0;
+    for (size_t i = 0; done < frames; ++i) {
+        const SampleIndex n = std::min(chunks[i % 7], frames - done);
+        appended.append(audio.data() + done * 2, n, 2);
+        done += n;
+    }
+    recordTest("Appended cache equals a full build", sameLevels(full, appended));
+
+    // Continue a recording whose peaks were mapped from disk.
+    const SampleIndex head = 30000;
+    const std::string source = makeSourceFile("take.wav", 2048);
+    WaveformCache partial;
+    partial.buildFromRaw(audio.data(), head, 2);
+    partial.savePeakFile(source);
+    WaveformCache resumed;
+    resumed.loadPeakFile(source);
+    resumed.append(audio.data() + head * 2, frames - head, 2);
+    recordTest("Append after loading a peak file equals a full build",
+               !resumed.isMapped() && sameLevels(full, resumed));
+
+    resumed.append(audio.data(), 100, 1);
+    recordTest("Append with another channel count is ignored", resumed.getSourceFrames() == frames);
+}
+
+void testPeakFileDirectoryAndBuilder() {
+    std::cout << "\n=== Test: Peak directory and builder ===\n";
+    const fs::path cacheDir = tempDir() / "peaks";
+    fs::remove_all(cacheDir);
+    WaveformCache::setPeakFileDirectory(cacheDir.string());
+
+    const SampleIndex frames = 48000;
+    auto buffer = std::make_shared<AudioBufferData>();
+    buffer->interleavedData = makeAudio(frames);
+    buffer->sampleRate = 48000;
+    buffer->numChannels = 2;
+    buffer->numFrames = frames;
+
+    const std::string source = makeSourceFile("builder.wav", 512);
+    const fs::path peakPath = WaveformCache::peakFilePath(source);
+    recordTest("Peak files go to the cache directory", peakPath.parent_path() == cacheDir);
+
+    ClipSource loaded;
+    loaded.setFilePath(source);
+    loaded.setBuffer(buffer);
+    WaveformCacheBuilder builder;
+    auto first = builder.buildSync(loaded);
+    recordTest("First build scans the audio and writes the peak file",
+               first && !first->isMapped() && fs::exists(peakPath));
+
+    // Audio not decoded yet: the peak file alone is enough.
+    ClipSource unloaded;
+    unloaded.setFilePath(source);
+    auto second = builder.buildSync(unloaded);
+    recordTest("Later builds map the peak file", second && second->isMapped() && sameLevels(*first, *second));
+
+    std::shared_ptr<WaveformCache> async;
+    std::atomic<bool> done{false};
+    builder.buildAsync(unloaded, [&](std::shared_ptr<WaveformCache> cache) {
+        async = std::move(cache);
+        done.store(true);
+    });
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    recordTest("Async builds map the peak file too", done && async && async->isMapped());
+
+    WaveformCache::setPeakFileDirectory("");
+}
+
+void testVertexCache() {
+    std::cout << "\n=== Test: Vertex cache ===\n";
+    const SampleIndex frames = 5 * 48000 + 321;
+    const auto audio = makeAudio(frames);
+    auto cache = std::make_shared<WaveformCache>();
+    cache->buildFromRaw(audio.data(), frames, 2);
+
+    WaveformVertexCache vertices;
+    std::vector<WaveformPeak> columns;
+    recordTest("No source, no columns", !vertices.getColumns(0, frames, 100, columns) && columns.size() == 100);
+    vertices.setSource(cache);
+
+    recordTest("Buckets are powers of two at most samples per pixel",
+               WaveformVertexCache::bucketFor(0.3) == 1 && WaveformVertexCache::bucketFor(64.0) == 64 &&
+               WaveformVertexCache::bucketFor(1000.0) == 512);
+
+    // Each column covers its pixel's samples: every one of them lies within it.
+    const SampleIndex start = 12345, end = 4 * 48000;
+    const uint32_t pixels = 700;
+    vertices.getColumns(start, end, pixels, columns);
+    bool covers = columns.size() == pixels;
+    const double spp = static_cast<double>(end - start) / pixels;
+    for (uint32_t p = 0; p < pixels && covers; ++p) {
+        const auto from = static_cast<SampleIndex>(std::ceil(start + p * spp));
+        const auto to = static_cast<SampleIndex>(start + (p + 1) * spp);
+        for (SampleIndex f = from; f < to; ++f) {
+            for (uint32_t ch = 0; ch < 2; ++ch) {
+                const float s = audio[f * 2 + ch];
+                covers = covers && columns[p].min <= s && s <= columns[p].max;
+            }
+        }
+    }
+    recordTest("Columns cover every sample of their pixel", covers);
+
+    // Vertices come from the cache's own peaks: a column equals the merged cache peaks.
+    std::vector<WaveformPeak> left, right;
+    const SampleIndex bucket = WaveformVertexCache::bucketFor(spp);
+    const SampleIndex aligned = 40 * bucket;
+    vertices.getColumns(aligned, aligned + 64 * bucket, 64, columns);
+    cache->getPeaksForRange(0, aligned, aligned + 64 * bucket, 64, left);
+    cache->getPeaksForRange(1, aligned, aligned + 64 * bucket, 64, right);
+    bool same = true;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        WaveformPeak merged = left[i];
+        merged.merge(right[i]);
+        same = same && merged.min == columns[i].min && merged.max == columns[i].max;
+    }
+    recordTest("Aligned columns equal the cache's merged peaks", same);
+
+    // Scrolling at a fixed zoom reuses tiles instead of refilling them.
+    vertices.clear();
+    vertices.getColumns(0, 48000, 800, columns);
+    const size_t tiles = vertices.getTileCount();
+    vertices.getColumns(100, 48100, 800, columns);
+    vertices.getColumns(250, 48250, 800, columns);
+    recordTest("Scrolling within a tile reuses it", tiles > 0 && vertices.getTileCount() == tiles);
+
+    std::vector<WaveformPeak> past;
+    vertices.getColumns(frames - 1000, frames + 1000, 20, past);
+    recordTest("Columns past the source are empty", past.back().min == 0.0f && past.back().max == 0.0f);
+
+    vertices.setMaxTiles(2);
+    for (SampleIndex zoom = 1; zoom < 16384; zoom *= 2) {
+        vertices.getColumns(0, zoom * 600, 600, columns);
+    }
+    recordTest("Tile count stays within the limit", vertices.getTileCount() <= 2);
+
+    auto other = std::make_shared<WaveformCache>();
+    other->buildFromRaw(audio.data(), 1000, 2);
+    vertices.setSource(other);
+    recordTest("A new source drops the tiles", vertices.getTileCount() == 0);
+
+    // A growing cache (recording) refreshes its tiles.
+    auto growing = std::make_shared<WaveformCache>();
+    growing->append(audio.data(), 4096, 2);
+    vertices.setMaxTiles(WaveformVertexCache::DEFAULT_MAX_TILES);
+    vertices.setSource(growing);
+    vertices.getColumns(0, 8192, 64, columns);
+    const bool emptyTail = columns.back().min == 0.0f && columns.back().max == 0.0f;
+    growing->append(audio.data() + 4096 * 2, 4096, 2);
+    vertices.getColumns(0, 8192, 64, columns);
+    recordTest("Appended audio shows up", emptyTail && columns.back().min < columns.back().max);
+}
+
+void testTrackInMemoryPeaks() {
+    std::cout << "\n=== Test: Peaks of a track's in-memory samples ===\n";
+    const SampleIndex frames = 200000;
+    const auto audio = makeAudio(frames);
+    Track track("Peaks", 1);
+    track.setAudioData(audio.data(), static_cast<uint32_t>(frames), 48000, 2);
+
+    // The build runs in the background; poll like the UI does.
+    auto waitForPeaks = [&](SampleIndex expectedFrames) {
+        std::shared_ptr<const WaveformCache> cache;
+        for (int i = 0; i < 2000; ++i) {
+            cache = track.getWaveformCache();
+            if (cache && cache->getSourceFrames() == expectedFrames) {
+                return cache;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return cache;
+    };
+    WaveformCache direct;
+    direct.buildFromRaw(audio.data(), frames, 2);
+    auto cache = waitForPeaks(frames);
+    recordTest("Track peaks equal a direct build", cache && sameLevels(*cache, direct));
+
+    // Splitting replaces the samples; the next build sees only the first half.
+    auto second = track.splitAt(static_cast<double>(frames / 2) / 48000.0);
+    WaveformCache firstHalf;
+    firstHalf.buildFromRaw(audio.data(), frames / 2, 2);
+    cache = waitForPeaks(frames / 2);
+    recordTest("Peaks follow the track's samples after a split",
+               second && cache && sameLevels(*cache, firstHalf));
+}
+
+void testBuildFunction() {
+    std::cout << "\n=== Test: Builder with a build function ===\n";
+    const SampleIndex frames = 30000;
+    const auto audio = makeAudio(frames);
+    const std::string source = makeSourceFile("function.wav", 256);
+
+    WaveformCacheBuilder builder;
+    std::atomic<int> builds{0};
+    auto build = [&](WaveformCache& cache) {
+        ++builds;
+        cache.buildFromRaw(audio.data(), frames, 2);
+        return true;
+    };
+    auto run = [&](const std::string& path, WaveformCacheBuilder::BuildFunction fn) {
+        std::shared_ptr<WaveformCache> result;
+        std::atomic<bool> done{false};
+        builder.buildAsync(path, std::move(fn), [&](std::shared_ptr<WaveformCache> cache) {
+            result = std::move(cache);
+            done.store(true);
+        });
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return result;
+    };
+
+    auto first = run(source, build);
+    auto second = run(source, build);
+    recordTest("Build function runs once, then the peak file is mapped",
+               first && second && second->isMapped() && builds.load() == 1);
+    auto unsaved = run("", build);
+    recordTest("No path, no peak file", unsaved && !unsaved->isMapped() && builds.load() == 2);
+    auto failed = run("", [](WaveformCache&) { return false; });
+    recordTest("A failed build yields no cache", !failed);
+    fs::remove(WaveformCache::peakFilePath(source));
+}
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad WaveformCache Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testSinglePassBuild();
+    testPeakFileRoundTrip();
+    testStaleAndCorruptFilesAreRejected();
+    testAppendMatchesFullBuild();
+    testPeakFileDirectoryAndBuilder();
+    testVertexCache();
+    testTrackInMemoryPeaks();
+    testBuildFunction();
+
+    fs::remove_all(tempDir());
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Waveform peak building throughput (GB/s of source audio): single-pass SIMD builder per
+// tier and thread count, against the per-level scalar scan WaveformCache used before
+
+#include "AudioKernels.h"
+#include "WaveformCache.h"
+#include "NomadLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+namespace {
+
+// Keeps results observable so the optimizer can't drop the work.
+volatile double g_sink = 0.0;
+
+/**
+ * @brief Run fn until minMs of wall time has passed; return ns per call.
+ */
+double nsPerCall(double minMs, const std::function<void()>& fn) {
+    using Clock = std::chrono::steady_clock;
+    fn();   // Warm-up
+    uint64_t iterations = 0;
+    const auto t0 = Clock::now();
+    auto t1 = t0;
+    do {
+        fn();
+        ++iterations;
+        t1 = Clock::now();
+    } while (std::chrono::duration<double, std::milli>(t1 - t0).count() < minMs);
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+}
+
+/// The previous builder: a scalar scan per channel for level 0, then each level from the one below.
+void legacyBuild(const float* data, SampleIndex numFrames, uint32_t numChannels,
+                 std::vector<WaveformMipLevel>& levels) {
+    levels.assign(WaveformCache::DEFAULT_NUM_LEVELS, WaveformMipLevel());
+    WaveformMipLevel& base = levels[0];
+    const SampleIndex spp = WaveformCache::DEFAULT_BASE_SAMPLES_PER_PEAK;
+    base.samplesPerPeak = static_cast<uint32_t>(spp);
+    base.numChannels = numChannels;
+    base.numPeaks = (numFrames + spp - 1) / spp;
+    base.peaks.resize(static_cast<size_t>(base.numPeaks * numChannels));
+    for (SampleIndex p = 0; p < base.numPeaks; ++p) {
+        const SampleIndex end = std::min((p + 1) * spp, numFrames);
+        for (uint32_t ch = 0; ch < numChannels; ++ch) {
+            float mn = 1.0f, mx = -1.0f;
+            for (SampleIndex f = p * spp; f < end; ++f) {
+                mn = std::min(mn, data[f * numChannels + ch]);
+                mx = std::max(mx, data[f * numChannels + ch]);
+            }
+            base.peaks[static_cast<size_t>(p * numChannels + ch)] = WaveformPeak(mn, mx);
+        }
+    }
+    for (size_t i = 1; i < levels.size(); ++i) {
+        const WaveformMipLevel& src = levels[i - 1];
+        WaveformMipLevel& dst = levels[i];
+        const SampleIndex m = WaveformCache::MIP_LEVEL_MULTIPLIER;
+        dst.samplesPerPeak = src.samplesPerPeak * static_cast<uint32_t>(m);
+        dst.numChannels = numChannels;
+        dst.numPeaks = (src.numPeaks + m - 1) / m;
+        dst.peaks.resize(static_cast<size_t>(dst.numPeaks * numChannels));
+        for (SampleIndex p = 0; p < dst.numPeaks; ++p) {
+            const SampleIndex end = std::min((p + 1) * m, src.numPeaks);
+            for (uint32_t ch = 0; ch < numChannels; ++ch) {
+                WaveformPeak merged = src.getPeak(ch, p * m);
+                for (SampleIndex q = p * m + 1; q < end; ++q) {
+                    merged.merge(src.getPeak(ch, q));
+                }
+                dst.peaks[static_cast<size_t>(p * numChannels + ch)] = merged;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    double seconds = 300.0;
+    uint32_t channels = 2;
+    double minMs = 500.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--seconds" && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (a == "--channels" && i + 1 < argc) channels = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--min-ms" && i + 1 < argc) minMs = std::atof(argv[++i]);
+    }
+
+    Log::setLevel(LogLevel::Warning);
+
+    // Test material at 48 kHz: a sine per channel at a different rate.
+    const auto frames = static_cast<SampleIndex>(seconds * 48000.0);
+    std::vector<float> audio(static_cast<size_t>(frames) * channels);
+    for (SampleIndex i = 0; i < frames; ++i) {
+        for (uint32_t ch = 0; ch < channels; ++ch) {
+            audio[static_cast<size_t>(i * channels + ch)] = static_cast<float>(0.5 * std::sin(0.01 * (ch + 1) * i));
+        }
+    }
+    const double bytes = static_cast<double>(audio.size() * sizeof(float));
+
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Waveform Peak Benchmark\n";
+    std::cout << "=========================================\n";
+    std::cout << "  " << seconds << " s x " << channels << " ch (" << std::fixed << std::setprecision(1)
+              << bytes / (1024.0 * 1024.0) << " MB), " << WaveformCache::DEFAULT_NUM_LEVELS
+              << " levels, detected=" << AudioKernels::levelName(AudioKernels::detectedLevel()) << "\n\n";
+    std::cout << "  " << std::left << std::setw(34) << "Benchmark"
+              << std::right << std::setw(12) << "ms/build" << std::setw(10) << "GB/s" << std::setw(10) << "speedup"
+              << "\n";
+    std::cout << "  " << std::string(66, '-') << "\n";
+
+    auto report = [&](const std::string& label, double ns, double baselineNs) {
+        std::cout << "  " << std::left << std::setw(34) << label << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(12) << ns / 1e6
+                  << std::setprecision(2) << std::setw(10) << bytes / ns;
+        if (baselineNs > 0.0) {
+            std::cout << std::setprecision(2) << std::setw(9) << baselineNs / ns << "x";
+        }
+        std::cout << "\n";
+    };
+
+    std::vector<WaveformMipLevel> legacy;
+    const double legacyNs = nsPerCall(minMs, [&] {
+        legacyBuild(audio.data(), frames, channels, legacy);
+        g_sink = g_sink + legacy.back().peaks[0].max;
+    });
+    report("BM_PerLevelScalar", legacyNs, 0.0);
+
+    WaveformCache cache;
+    auto build = [&] {
+        cache.buildFromRaw(audio.data(), frames, channels);
+        g_sink = g_sink + cache.getLevel(0)->getPeak(0, 1).max;
+    };
+
+    const SimdLevel detected = AudioKernels::detectedLevel();
+    WaveformCache::setBuildThreads(1);
+    for (SimdLevel tier : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (!AudioKernels::table(tier)) {
+            continue;
+        }
+        AudioKernels::setLevel(tier);
+        report(std::string("BM_SinglePass/") + AudioKernels::levelName(tier) + "/1t", nsPerCall(minMs, build),
+               legacyNs);
+    }
+    AudioKernels::setLevel(detected);
+
+    WaveformCache::setBuildThreads(0);
+    const uint32_t automatic = WaveformCache::getBuildThreads();
+    for (uint32_t threads = 2; threads <= automatic; threads *= 2) {
+        WaveformCache::setBuildThreads(threads);
+        report(std::string("BM_SinglePass/") + AudioKernels::levelName(detected) + "/" + std::to_string(threads) + "t",
+               nsPerCall(minMs, build), legacyNs);
+    }
+    WaveformCache::setBuildThreads(0);
+    report(std::string("BM_SinglePass/") + AudioKernels::levelName(detected) + "/auto(" + std::to_string(automatic) +
+               "t)",
+           nsPerCall(minMs, build), legacyNs);
+    return 0;
+}
@@ -151,7 +151,7 @@ private:
                 ss << (boolValue_ ? "true" : "false");
                 break;
             case Type::Number:
-                ss << numberValue_;
+                serializeNumber(ss, numberValue_);
                 break;
             case Type::String:
                 ss << "\"" << stringValue_ << "\"";
@@ -295,12 +295,33 @@ private:
         return JSON(value);
     }
 
+    // Shortest of 15 or 17 significant digits that reads back as the same double
+    // (the default 6 turned e.g. ARGB colours into lossy exponent notation).
+    static void serializeNumber(std::stringstream& ss, double value) {
+        std::ostringstream text;
+        text.precision(15);
+        text << value;
+        if (std::stod(text.str()) != value) {
+            text.str("");
+            text.precision(17);
+            text << value;
+        }
+        ss << text.str();
+    }
+
     static JSON parseNumber(const std::string& str, size_t& pos) {
         size_t start = pos;
         if (str[pos] == '-') pos++;
         while (pos < str.size() && (std::isdigit(str[pos]) || str[pos] == '.')) {
             pos++;
         }
+        if (pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+            pos++;
+            if (pos < str.size() && (str[pos] == '+' || str[pos] == '-')) pos++;
+            while (pos < str.size() && std::isdigit(str[pos])) {
+                pos++;
+            }
+        }
         double value = std::stod(str.substr(start, pos - start));
         return JSON(value);
     }
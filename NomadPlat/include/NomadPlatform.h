@@ -2,6 +2,8 @@
 #pragma once
 
 #include "../../NomadCore/include/NomadConfig.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <functional>
 
@@ -196,6 +198,12 @@ public:
     // Set priority for the CURRENT thread
     static bool setCurrentThreadPriority(ThreadPriority priority);
 
+    // Futex-style wait/wake on a 32-bit word (futex on Linux, WaitOnAddress on Windows).
+    // waitOnAddress blocks while word == expected (spurious wakeups are possible, callers
+    // must re-check). wakeAllOnAddress is non-blocking and safe to call from the audio thread.
+    static void waitOnAddress(const std::atomic<uint32_t>& word, uint32_t expected);
+    static void wakeAllOnAddress(std::atomic<uint32_t>& word);
+
 private:
     static IPlatformUtils* s_utils;
 
@@ -2,6 +2,10 @@
 #include <pthread.h>
 #include <sched.h>
 #include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <climits>
 #include <iostream>
 
 namespace Nomad {
@@ -59,6 +63,18 @@ bool Platform::setCurrentThreadPriority(ThreadPriority priority) {
     return true;
 }
 
+// Futex wait/wake (private futexes: the word never crosses process boundaries)
+void Platform::waitOnAddress(const std::atomic<uint32_t>& word, uint32_t expected) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32-bit");
+    syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&word), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+}
+
+void Platform::wakeAllOnAddress(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+}
+
 // AudioThreadScope implementation
 Platform::AudioThreadScope::AudioThreadScope() {
     // Attempt to set realtime priority
@@ -15,6 +15,8 @@
 
 // Link against avrt.lib for MMCSS functions
 #pragma comment(lib, "avrt.lib")
+// Link against Synchronization.lib for WaitOnAddress/WakeByAddressAll
+#pragma comment(lib, "Synchronization.lib")
 
 namespace Nomad {
 
@@ -49,6 +51,19 @@ bool Platform::setCurrentThreadPriority(ThreadPriority priority) {
     return false;
 }
 
+// =============================================================================
+// Address Wait/Wake (WaitOnAddress)
+// =============================================================================
+
+void Platform::waitOnAddress(const std::atomic<uint32_t>& word, uint32_t expected) {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "wait word must be 32-bit");
+    WaitOnAddress(const_cast<std::atomic<uint32_t>*>(&word), &expected, sizeof(expected), INFINITE);
+}
+
+void Platform::wakeAllOnAddress(std::atomic<uint32_t>& word) {
+    WakeByAddressAll(&word);
+}
+
 // =============================================================================
 // AudioThreadScope (MMCSS Implementation)
 // =============================================================================
@@ -31,6 +31,7 @@
 #include "../NomadAudio/include/AudioCommandQueue.h"
 #include "../NomadAudio/include/AudioRT.h"
 #include "../NomadAudio/include/PreviewEngine.h"
+#include "../NomadAudio/include/SamplePool.h"
 #include "../NomadCore/include/NomadLog.h"
 #include "../NomadCore/include/NomadProfiler.h"
 #include "TransportBar.h"
@@ -784,6 +785,16 @@ public:
         // Initialize audio engine
         m_audioManager = std::make_unique<AudioDeviceManager>();
         m_audioEngine = std::make_unique<AudioEngine>();
+        {
+            // Parallel track rendering: leave one core for the UI thread besides the audio thread.
+            const uint32_t cores = std::thread::hardware_concurrency();
+            m_audioEngine->setRenderThreadCount(cores > 2 ? cores - 2 : 0);
+        }
+        // Mixer meters: per-track/bus levels published by the engine each block.
+        m_meterSnapshots = std::make_shared<MeterSnapshotBuffer>();
+        m_audioEngine->setMeterSnapshots(m_meterSnapshots);
+        // Clips at another rate get a pre-resampled copy in the background.
+        SamplePool::getInstance().setResampleCacheEnabled(true);
         if (!m_audioManager->initialize()) {
             Log::error("Failed to initialize audio engine");
             // Continue without audio for now
@@ -878,8 +889,8 @@ public:
                                     m_audioEngine->setSampleRate(static_cast<uint32_t>(actualRate));
                                     m_audioEngine->setBufferConfig(config.bufferSize, config.numOutputChannels);
                                     if (m_content && m_content->getTrackManager()) {
-                                        auto graph = AudioGraphBuilder::buildFromTrackManager(*m_content->getTrackManager(), actualRate);
-                                        m_audioEngine->setGraph(graph);
+                                        auto graph = m_graphBuilder.build(*m_content->getTrackManager(), actualRate, &m_audioEngine->telemetry());
+                                        m_audioEngine->setGraph(std::move(graph));
                                     }
                                 }
                                 m_mainStreamConfig.sampleRate = static_cast<uint32_t>(actualRate);
@@ -943,10 +954,16 @@ public:
         m_content->setAudioStatus(m_audioInitialized);
         m_customWindow->setContent(m_content.get());
 
+        // Mixer channel meters read the engine's m_meterSnapshots
+        if (m_audioEngine && m_content->getTrackManagerUI()) {
+            m_content->getTrackManagerUI()->getMixerPanel()->getMixer()->setAudioEngine(m_audioEngine.get());
+        }
+
         // Build initial audio graph for engine (uses default tracks created in NomadContent)
         if (m_audioEngine && m_content && m_content->getTrackManager()) {
-            auto graph = AudioGraphBuilder::buildFromTrackManager(*m_content->getTrackManager(), m_mainStreamConfig.sampleRate);
-            m_audioEngine->setGraph(graph);
+            auto graph = m_graphBuilder.build(*m_content->getTrackManager(), m_mainStreamConfig.sampleRate,
+                                              &m_audioEngine->telemetry());
+            m_audioEngine->setGraph(std::move(graph));
         }
         
         // TODO: Implement async project loading with progress indicator
@@ -1009,8 +1026,9 @@ public:
                         if (actual > 0.0) sampleRate = actual;
                     }
                     // Rebuild the graph with latest track data
-                    auto graph = AudioGraphBuilder::buildFromTrackManager(*m_content->getTrackManager(), sampleRate);
-                    m_audioEngine->setGraph(graph);
+                    auto graph = m_graphBuilder.build(*m_content->getTrackManager(), sampleRate, &m_audioEngine->telemetry());
+                    const size_t graphTracks = graph.tracks.size();
+                    m_audioEngine->setGraph(std::move(graph));
                     // Clear the dirty flag since we just rebuilt
                     m_content->getTrackManager()->consumeGraphDirty();
                     
@@ -1022,7 +1040,7 @@ public:
                     cmd.samplePos = static_cast<uint64_t>(posSeconds * sampleRate);
                     m_audioEngine->commandQueue().push(cmd);
                     
-                    Log::info("Transport: Graph rebuilt with " + std::to_string(graph.tracks.size()) + " tracks");
+                    Log::info("Transport: Graph rebuilt with " + std::to_string(graphTracks) + " tracks");
                 }
             });
             
@@ -1320,6 +1338,13 @@ public:
                     m_rootComponent->onUpdate(deltaTime);
                 }
 
+                // Free graphs the audio thread has moved past (never on the callback),
+                // and swap in decoded stream copies that finished loading.
+                if (m_audioEngine) {
+                    m_audioEngine->collectRetiredGraphs();
+                    m_audioEngine->refreshDecodedStreams();
+                }
+
                 // Feed master peaks from AudioEngine into the VU meter.
                 // This avoids any RT-thread calls into UI and keeps metering in sync
                 // with the actual engine output.
@@ -1385,9 +1410,19 @@ public:
                     m_content->updateSoundPreview();
                 }
 
+                // Adopt finished asynchronous loads here so only this thread writes track audio data.
+                if (m_content && m_content->getTrackManager()) {
+                    m_content->getTrackManager()->pollAsyncLoads();
+                }
+
                 // Rebuild audio graph for engine when track data changes.
                 // IMPORTANT: while playing, do not push transport samplePos from this path,
                 // otherwise we can create tiny unintended seeks -> audible crackles.
+                if (m_content && m_content->getTrackManager() &&
+                    SamplePool::getInstance().consumeResampledReady()) {
+                    // A pre-resampled clip copy finished: swap it into the graph.
+                    m_content->getTrackManager()->markGraphDirty();
+                }
                 if (m_audioEngine && m_content && m_content->getTrackManager() &&
                     m_content->getTrackManager()->consumeGraphDirty()) {
                     double graphSampleRate = static_cast<double>(m_mainStreamConfig.sampleRate);
@@ -1397,8 +1432,8 @@ public:
                             graphSampleRate = actual;
                         }
                     }
-                    auto graph = AudioGraphBuilder::buildFromTrackManager(*m_content->getTrackManager(), graphSampleRate);
-                    m_audioEngine->setGraph(graph);
+                    auto graph = m_graphBuilder.build(*m_content->getTrackManager(), graphSampleRate, &m_audioEngine->telemetry());
+                    m_audioEngine->setGraph(std::move(graph));
                     const bool playing = m_content->getTrackManager()->isPlaying();
                     if (!playing) {
                         // When stopped, keep engine position aligned to UI position.
@@ -2134,6 +2169,8 @@ private:
     std::unique_ptr<NUIRenderer> m_renderer;
     std::unique_ptr<AudioDeviceManager> m_audioManager;
     std::unique_ptr<AudioEngine> m_audioEngine;
+    std::shared_ptr<MeterSnapshotBuffer> m_meterSnapshots;  // Per-track/bus meters written by m_audioEngine
+    AudioGraphBuilder m_graphBuilder;  // Incremental: keeps unchanged tracks between rebuilds
     std::shared_ptr<NomadRootComponent> m_rootComponent;
     std::shared_ptr<NUICustomWindow> m_customWindow;
     std::shared_ptr<NomadContent> m_content;
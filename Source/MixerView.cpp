@@ -94,19 +94,17 @@ void ChannelStrip::onRender(NomadUI::NUIRenderer& renderer) {
     
     // Level meter (simple bar for now) - positioned above track name
     if (m_track) {
-        float meterX = bounds.x + bounds.width - 15.0f;
-        float meterY = bounds.y + 10.0f;
-        float meterWidth = 10.0f;
-        float meterHeight = bounds.height - 80.0f;  // Leave space for controls and name
+        NomadUI::NUIRect meterBg = meterBounds();
+        float meterX = meterBg.x;
+        float meterY = meterBg.y;
+        float meterWidth = meterBg.width;
+        float meterHeight = meterBg.height;
         
         // Meter background
-        NomadUI::NUIRect meterBg(meterX, meterY, meterWidth, meterHeight);
         renderer.fillRect(meterBg, NomadUI::NUIColor(0.1f, 0.1f, 0.1f, 1.0f));
         renderer.strokeRect(meterBg, 1.0f, borderColor);
         
-        // Get current level from track
-        // TODO: Implement proper metering from audio callback
-        float level = m_track->getVolume() * 0.5f;  // Placeholder
+        float level = std::min(m_peakLevel, 1.0f);
         
         // Draw level bar (bottom-up)
         if (level > 0.0f) {
@@ -125,21 +123,62 @@ void ChannelStrip::onRender(NomadUI::NUIRenderer& renderer) {
             
             renderer.fillRect(levelBar, levelColor);
         }
+        
+        // Clip indicator above the meter (latched by the engine; click the meter to clear)
+        if (m_clipped) {
+            NomadUI::NUIRect clipLed(meterX, meterY - 6.0f, meterWidth, 4.0f);
+            renderer.fillRect(clipLed, NomadUI::NUIColor(0.9f, 0.2f, 0.2f, 1.0f));
+        }
     }
     
     // Render child controls
     renderChildren(renderer);
 }
 
+void ChannelStrip::onUpdate(double deltaTime) {
+    NomadUI::NUIComponent::onUpdate(deltaTime);
+    
+    // Follow the engine's post-fader peak: rise at once, fall back at a fixed rate
+    constexpr float kFalloffPerSecond = 1.5f;
+    float peak = 0.0f;
+    if (m_track && m_audioEngine && m_audioEngine->getMeterSnapshots()) {
+        const uint32_t slot = m_audioEngine->getMeterSlot(m_track->getTrackId());
+        if (slot != ChannelSlotMap::INVALID_SLOT) {
+            float peakL = 0.0f, peakR = 0.0f;
+            bool clipL = false, clipR = false;
+            m_audioEngine->getMeterSnapshots()->readSnapshot(slot, peakL, peakR, clipL, clipR);
+            peak = std::max(peakL, peakR);
+            m_clipped = clipL || clipR;
+        }
+    }
+    const float fallen = m_peakLevel - kFalloffPerSecond * static_cast<float>(deltaTime);
+    m_peakLevel = std::max(peak, std::max(fallen, 0.0f));
+}
+
 void ChannelStrip::onResize(int width, int height) {
     NomadUI::NUIComponent::onResize(width, height);
     layoutControls();
 }
 
 bool ChannelStrip::onMouseEvent(const NomadUI::NUIMouseEvent& event) {
+    if (event.pressed && event.button == NomadUI::NUIMouseButton::Left && m_clipped &&
+        meterBounds().contains(event.position) && m_audioEngine && m_audioEngine->getMeterSnapshots()) {
+        const uint32_t slot = m_audioEngine->getMeterSlot(m_track->getTrackId());
+        if (slot != ChannelSlotMap::INVALID_SLOT) {
+            m_audioEngine->getMeterSnapshots()->clearClip(slot);
+        }
+        m_clipped = false;
+        return true;
+    }
     return NomadUI::NUIComponent::onMouseEvent(event);
 }
 
+NomadUI::NUIRect ChannelStrip::meterBounds() const {
+    auto bounds = getBounds();
+    // Right edge, above the track name and clear of the controls
+    return NomadUI::NUIRect(bounds.x + bounds.width - 15.0f, bounds.y + 10.0f, 10.0f, bounds.height - 80.0f);
+}
+
 void ChannelStrip::layoutControls() {
     auto bounds = getBounds();
     float padding = 5.0f;
@@ -220,6 +259,7 @@ void MixerView::refreshChannels() {
         auto track = m_trackManager->getTrack(i);
         if (track && track->getName() != "Preview") {  // Skip preview track
             auto channelStrip = std::make_shared<ChannelStrip>(track, m_trackManager.get());
+            channelStrip->setAudioEngine(m_audioEngine);
             m_channelStrips.push_back(channelStrip);
             addChild(channelStrip);
         }
@@ -229,6 +269,13 @@ void MixerView::refreshChannels() {
     Log::info("Mixer: Created " + std::to_string(m_channelStrips.size()) + " channel strips");
 }
 
+void MixerView::setAudioEngine(const AudioEngine* engine) {
+    m_audioEngine = engine;
+    for (auto& strip : m_channelStrips) {
+        strip->setAudioEngine(engine);
+    }
+}
+
 void MixerView::layoutChannels() {
     auto bounds = getBounds();
     float padding = 5.0f;
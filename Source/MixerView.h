@@ -4,6 +4,7 @@
 #include "../NomadUI/Core/NUIComponent.h"
 #include "../NomadUI/Widgets/NUIMixerWidgets.h"
 #include "../NomadAudio/include/TrackManager.h"
+#include "../NomadAudio/include/AudioEngine.h"
 #include <memory>
 #include <vector>
 
@@ -19,15 +20,20 @@ public:
     ChannelStrip(std::shared_ptr<Track> track, TrackManager* trackManager = nullptr);
     
     void onRender(NomadUI::NUIRenderer& renderer) override;
+    void onUpdate(double deltaTime) override;
     void onResize(int width, int height) override;
     bool onMouseEvent(const NomadUI::NUIMouseEvent& event) override;
     
     void setTrack(std::shared_ptr<Track> track) { m_track = track; }
     std::shared_ptr<Track> getTrack() const { return m_track; }
 
+    // Engine whose meter snapshots drive the level meter (nullptr: meter stays empty)
+    void setAudioEngine(const AudioEngine* engine) { m_audioEngine = engine; }
+
 private:
     std::shared_ptr<Track> m_track;
     TrackManager* m_trackManager; // For coordinating solo exclusivity
+    const AudioEngine* m_audioEngine{nullptr};
     
     // UI Controls
     std::shared_ptr<NomadUI::Fader> m_volumeFader;
@@ -35,11 +41,12 @@ private:
     std::shared_ptr<NomadUI::MuteButton> m_muteButton;
     std::shared_ptr<NomadUI::SoloButton> m_soloButton;
     
-    // Level meter state
+    // Level meter state: displayed peak (linear) and whether the track has clipped
     float m_peakLevel{0.0f};
-    float m_peakDecay{0.0f};
+    bool m_clipped{false};
     
     void layoutControls();
+    NomadUI::NUIRect meterBounds() const;
 };
 
 /**
@@ -55,8 +62,12 @@ public:
     
     void refreshChannels();  // Rebuild channel strips when tracks change
 
+    // Engine publishing the per-track meters (see AudioEngine::setMeterSnapshots)
+    void setAudioEngine(const AudioEngine* engine);
+
 private:
     std::shared_ptr<TrackManager> m_trackManager;
+    const AudioEngine* m_audioEngine{nullptr};
     std::vector<std::shared_ptr<ChannelStrip>> m_channelStrips;
     
     float m_channelWidth{80.0f};  // Width of each channel strip
@@ -166,6 +166,8 @@ void PerformanceHUD::renderStats(NUIRenderer& renderer) {
         const uint64_t srcBlocks = tel.srcActiveBlocks.load(std::memory_order_relaxed);
         const uint32_t lastFrames = tel.lastBufferFrames.load(std::memory_order_relaxed);
         const uint32_t lastSR = tel.lastSampleRate.load(std::memory_order_relaxed);
+        const uint32_t tracksRendered = tel.getLastTracksRendered();
+        const uint32_t tracksInGraph = tel.getLastTracksInGraph();
 
         const uint64_t qDrops = m_audioEngine->commandQueue().droppedCount();
         const uint32_t qMax = m_audioEngine->commandQueue().maxDepth();
@@ -209,6 +211,24 @@ void PerformanceHUD::renderStats(NUIRenderer& renderer) {
                 oss << "n/a";
             }
             oss << "  SRC: " << std::fixed << std::setprecision(1) << srcPct << "%";
+            oss << "  Trk: " << tracksRendered << "/" << tracksInGraph;
+            renderer.drawText(oss.str(), NUIPoint(x, y), fontSize, textColor);
+            y += lineHeight;
+        }
+
+        // Parallel render workers: cumulative busy time per participant (0 = audio thread)
+        const auto& pool = m_audioEngine->renderWorkerPool();
+        const uint64_t dispatchCycles = pool.getDispatchCycles();
+        if (pool.isRunning()) {
+            std::ostringstream oss;
+            oss << "Workers:";
+            for (uint32_t p = 0; p < pool.getParticipantCount(); ++p) {
+                const uint64_t busy = pool.getStats(p).busyCycles.load(std::memory_order_relaxed);
+                const double util = (dispatchCycles > 0)
+                                        ? (100.0 * static_cast<double>(busy) / static_cast<double>(dispatchCycles))
+                                        : 0.0;
+                oss << " " << std::fixed << std::setprecision(0) << util << "%";
+            }
             renderer.drawText(oss.str(), NUIPoint(x, y), fontSize, textColor);
             y += lineHeight;
         }
@@ -62,7 +62,7 @@ private:
     
     // Position and size
     static constexpr float HUD_WIDTH = 400.0f;
-    static constexpr float HUD_HEIGHT = 190.0f;
+    static constexpr float HUD_HEIGHT = 208.0f;
     static constexpr float GRAPH_HEIGHT = 60.0f;
     static constexpr float PADDING = 8.0f;
 };
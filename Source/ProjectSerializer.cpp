@@ -121,14 +121,13 @@ ProjectSerializer::LoadResult ProjectSerializer::load(const std::string& path,
             if (t.has("solo")) track->setSolo(t["solo"].asBool());
             if (t.has("start")) track->setStartPositionInTimeline(t["start"].asNumber());
 
-            // Store the audio file path but DON'T load it during project restore
-            // This prevents hangs from loading large audio files synchronously
+            // Audio decodes on SamplePool's decode threads, all files concurrently;
+            // each track adopts its buffer when ready (see TrackManager::pollAsyncLoads).
             std::string file = t.has("file") ? t["file"].asString() : "";
             if (!file.empty()) {
-                // Just store the source path - don't load the audio data
-                // User can drag the file again to reload, or we can add async loading later
                 track->setSourcePath(file);
-                Log::info("Track '" + name + "' references audio: " + file + " (not loaded - drag to reload)");
+                track->loadAudioFileAsync(file);
+                Log::info("Track '" + name + "' loading audio: " + file);
             }
             
             // Restore trim settings
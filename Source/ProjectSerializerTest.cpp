@@ -0,0 +1,195 @@
+// © 2025 Nomad Studios — All Rights Reserved. Licensed for personal & educational use only.
+// Test program for ProjectSerializer: save/load round trip with asynchronous audio loads
+
+#include "ProjectSerializer.h"
+#include "../NomadAudio/include/AudioFileWriter.h"
+#include "../NomadAudio/include/SamplePool.h"
+#include "../NomadCore/include/NomadLog.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nomad;
+using namespace Nomad::Audio;
+
+// =============================================================================
+// Test Utilities
+// =============================================================================
+
+namespace {
+
+struct TestResult {
+    std::string name;
+    bool passed;
+    std::string details;
+};
+
+std::vector<TestResult> g_results;
+
+void recordTest(const std::string& name, bool passed, const std::string& details = "") {
+    g_results.push_back({name, passed, details});
+    std::cout << (passed ? "[PASS] " : "[FAIL] ") << name;
+    if (!details.empty()) {
+        std::cout << " - " << details;
+    }
+    std::cout << std::endl;
+}
+
+constexpr uint32_t kRate = 48000;
+constexpr double kTrimStart = 0.25;
+constexpr double kTrimEnd = 1.5;
+
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-9;
+}
+
+std::string describeTrims(const Track& track) {
+    return std::to_string(track.getTrimStart()) + " .. " + std::to_string(track.getTrimEnd()) + " s";
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void testTrimRoundTrip() {
+    std::cout << "\n=== Test: Trims survive save and an asynchronous reload ===\n";
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string audioPath = (dir / "nomad_project_trims.wav").string();
+    const std::string projectPath = (dir / "nomad_project_trims.json").string();
+    const std::string resavedPath = (dir / "nomad_project_trims_resaved.json").string();
+
+    std::vector<float> audio(static_cast<size_t>(kRate) * 2 * 2);   // 2 s stereo
+    for (size_t i = 0; i < audio.size(); ++i) {
+        audio[i] = static_cast<float>(0.25 * std::sin(0.01 * static_cast<double>(i / 2)));
+    }
+    {
+        auto writer = AudioFileWriter::create(AudioFileFormat::Wav);
+        writer->open(audioPath, kRate, 2, AudioSampleFormat::Float32, DitheringMode::None);
+        writer->write(audio.data(), kRate * 2);
+        writer->close();
+    }
+
+    // Saved from in-memory audio, so the reload below must decode from disk.
+    auto saved = std::make_shared<TrackManager>();
+    {
+        auto track = saved->addTrack("Trimmed");
+        track->setAudioData(audio.data(), kRate * 2, kRate, 2);
+        track->setSourcePath(audioPath);
+        track->setTrimStart(kTrimStart);
+        track->setTrimEnd(kTrimEnd);
+    }
+    const bool wrote = ProjectSerializer::save(projectPath, saved, 120.0, 0.0);
+
+    // Park the only decode thread so the project's decode stays queued until released.
+    auto& pool = SamplePool::getInstance();
+    pool.setDecodeThreadCount(1);
+    std::atomic<bool> release{false};
+    SampleLoadHandle blocker = pool.acquireAsync("nomad_project_trims_blocker",
+        [&release](AudioBuffer&, SampleLoadContext&) {
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return false;
+        });
+
+    auto loaded = std::make_shared<TrackManager>();
+    const ProjectSerializer::LoadResult result = ProjectSerializer::load(projectPath, loaded);
+    auto track = loaded->getTrackCount() == 1 ? loaded->getTrack(0) : nullptr;
+    recordTest("Project reloads its track", wrote && result.ok && track && track->isLoading());
+    if (!track) {
+        release = true;
+        pool.waitForLoads();
+        return;
+    }
+
+    recordTest("Trims read back as saved while the audio decodes",
+               near(track->getTrimStart(), kTrimStart) && near(track->getTrimEnd(), kTrimEnd),
+               describeTrims(*track));
+
+    // Saving again before the decode lands must not lose them either.
+    const bool resaved = ProjectSerializer::save(resavedPath, loaded, 120.0, 0.0);
+
+    release = true;
+    pool.waitForLoads();
+    pool.setDecodeThreadCount(0);
+    loaded->pollAsyncLoads();
+    recordTest("Trims are kept once the audio is adopted",
+               !track->isLoading() && near(track->getDuration(), 2.0) &&
+                   near(track->getTrimStart(), kTrimStart) && near(track->getTrimEnd(), kTrimEnd) &&
+                   near(track->getTrimmedDuration(), kTrimEnd - kTrimStart),
+               describeTrims(*track));
+
+    auto reloaded = std::make_shared<TrackManager>();
+    ProjectSerializer::load(resavedPath, reloaded);
+    SamplePool::getInstance().waitForLoads();
+    reloaded->pollAsyncLoads();
+    auto again = reloaded->getTrackCount() == 1 ? reloaded->getTrack(0) : nullptr;
+    recordTest("A project saved mid-load keeps its trims",
+               resaved && again && near(again->getTrimStart(), kTrimStart) && near(again->getTrimEnd(), kTrimEnd),
+               again ? describeTrims(*again) : "no track");
+
+    // Trims past the end of the audio still clamp, just later.
+    auto oversized = std::make_shared<TrackManager>();
+    ProjectSerializer::load(projectPath, oversized);
+    auto clamped = oversized->getTrack(0);
+    clamped->setTrimEnd(10.0);
+    SamplePool::getInstance().waitForLoads();
+    oversized->pollAsyncLoads();
+    recordTest("Pending trims clamp to the adopted audio",
+               near(clamped->getTrimStart(), kTrimStart) && near(clamped->getTrimEnd(), 2.0),
+               describeTrims(*clamped));
+
+    std::filesystem::remove(audioPath);
+    std::filesystem::remove(projectPath);
+    std::filesystem::remove(resavedPath);
+}
+
+} // namespace
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::cout << "=========================================\n";
+    std::cout << "  Nomad Project Serializer Test Suite\n";
+    std::cout << "=========================================\n";
+
+    Log::setLevel(LogLevel::Error);
+
+    testTrimRoundTrip();
+
+    // Summary
+    std::cout << "\n=========================================\n";
+    std::cout << "  Test Summary\n";
+    std::cout << "=========================================\n";
+
+    int passed = 0, failed = 0;
+    for (const auto& result : g_results) {
+        if (result.passed) ++passed;
+        else ++failed;
+    }
+
+    std::cout << "  Passed: " << passed << "\n";
+    std::cout << "  Failed: " << failed << "\n";
+    std::cout << "  Total:  " << (passed + failed) << "\n";
+    std::cout << "=========================================\n";
+
+    if (failed > 0) {
+        std::cout << "\nFailed tests:\n";
+        for (const auto& result : g_results) {
+            if (!result.passed) {
+                std::cout << "  - " << result.name << ": " << result.details << "\n";
+            }
+        }
+    }
+
+    return (failed == 0) ? 0 : 1;
+}
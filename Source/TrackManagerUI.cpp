@@ -389,12 +389,12 @@ void TrackManagerUI::renderSplitCursor(NomadUI::NUIRenderer& renderer, const Nom
         if (!trackUI) continue;
         
         auto track = trackUI->getTrack();
-        if (!track || track->getAudioData().empty()) continue;
+        if (!track || !track->hasAudioData()) continue;
         
         // Calculate clip bounds for this track
         NomadUI::NUIRect trackBounds = trackUI->getBounds();
         float clipStartPixel = gridStartX + static_cast<float>(track->getStartPositionInTimeline() * m_pixelsPerBeat * (120.0 / 60.0)) - m_timelineScrollOffset;
-        float clipWidth = static_cast<float>(track->getDuration() * m_pixelsPerBeat * (120.0 / 60.0));
+        float clipWidth = static_cast<float>(track->getTrimmedDuration() * m_pixelsPerBeat * (120.0 / 60.0));
         
         NomadUI::NUIRect clipBounds(clipStartPixel, trackBounds.y, clipWidth, trackBounds.height);
         
@@ -438,9 +438,9 @@ void TrackManagerUI::performSplitAtPosition(int trackIndex, double timeSeconds)
     double localTime = timeSeconds - trackStart;
     
     // Check if split point is within the track bounds
-    if (localTime <= 0.0 || localTime >= track->getDuration()) {
+    if (localTime <= 0.0 || localTime >= track->getTrimmedDuration()) {
         Log::info("Split point outside track bounds: " + std::to_string(localTime) + 
-                  "s (duration: " + std::to_string(track->getDuration()) + "s)");
+                  "s (duration: " + std::to_string(track->getTrimmedDuration()) + "s)");
         return;
     }
     
@@ -620,7 +620,7 @@ void TrackManagerUI::onClipDeleted(TrackUIComponent* trackComp, const NomadUI::N
     if (!trackComp) return;
     
     auto track = trackComp->getTrack();
-    if (!track || track->getAudioData().empty()) return;
+    if (!track || !track->hasAudioData()) return;
     
     // Get clip bounds before we clear
     NomadUI::NUIRect clipBounds = trackComp->getBounds();
@@ -647,7 +647,7 @@ void TrackManagerUI::onSplitRequested(TrackUIComponent* trackComp, double splitT
     if (!trackComp || !m_trackManager) return;
     
     auto track = trackComp->getTrack();
-    if (!track || track->getAudioData().empty()) return;
+    if (!track || !track->hasAudioData()) return;
     
     // Find the track index
     int trackIndex = -1;
@@ -663,9 +663,9 @@ void TrackManagerUI::onSplitRequested(TrackUIComponent* trackComp, double splitT
         return;
     }
     
-    // splitTime is already in audio-relative seconds (0 to duration)
+    // splitTime is already in clip-relative seconds (0 to the trimmed duration)
     // Validate split time is within clip bounds
-    double duration = track->getDuration();
+    double duration = track->getTrimmedDuration();
     if (splitTime <= 0.01 || splitTime >= duration - 0.01) {
         Log::warning("Split time outside clip bounds: " + std::to_string(splitTime) + 
                      " (duration=" + std::to_string(duration) + ")");
@@ -1927,9 +1927,9 @@ double TrackManagerUI::getMaxTimelineExtent() const {
     
     for (size_t i = 0; i < m_trackManager->getTrackCount(); ++i) {
         auto track = m_trackManager->getTrack(i);
-        if (track && !track->getAudioData().empty()) {
+        if (track && track->hasAudioData()) {
             double startPos = track->getStartPositionInTimeline();
-            double duration = track->getDuration();
+            double duration = track->getTrimmedDuration();
             double endPos = startPos + duration;
             
             // Add 2 bars padding after the last sample
@@ -2181,7 +2181,7 @@ void TrackManagerUI::splitSelectedClipAtPlayhead() {
     }
     
     auto track = selectedUI->getTrack();
-    if (!track || track->getAudioData().empty()) {
+    if (!track || !track->hasAudioData()) {
         Log::warning("Selected track has no audio to split");
         return;
     }
@@ -2192,7 +2192,7 @@ void TrackManagerUI::splitSelectedClipAtPlayhead() {
     double clipStart = track->getStartPositionInTimeline();
     double positionInClip = playheadTime - clipStart;
     
-    if (positionInClip <= 0 || positionInClip >= track->getDuration()) {
+    if (positionInClip <= 0 || positionInClip >= track->getTrimmedDuration()) {
         Log::warning("Playhead not within clip bounds for split");
         return;
     }
@@ -2219,7 +2219,7 @@ void TrackManagerUI::copySelectedClip() {
     }
     
     auto track = selectedUI->getTrack();
-    if (!track || track->getAudioData().empty()) {
+    if (!track || !track->hasAudioData()) {
         Log::warning("Selected track has no audio to copy");
         return;
     }
@@ -2227,6 +2227,7 @@ void TrackManagerUI::copySelectedClip() {
     // Copy to clipboard
     m_clipboard.hasData = true;
     m_clipboard.audioData = track->getAudioData();
+    m_clipboard.streamedClip = track->isStreamed() ? track->duplicate() : nullptr;
     m_clipboard.sampleRate = track->getSampleRate();
     m_clipboard.numChannels = track->getNumChannels();
     m_clipboard.name = track->getName();
@@ -2245,7 +2246,7 @@ void TrackManagerUI::cutSelectedClip() {
     }
     
     auto track = selectedUI->getTrack();
-    if (!track || track->getAudioData().empty()) {
+    if (!track || !track->hasAudioData()) {
         Log::warning("Selected track has no audio to cut");
         return;
     }
@@ -2253,6 +2254,7 @@ void TrackManagerUI::cutSelectedClip() {
     // Copy to clipboard first
     m_clipboard.hasData = true;
     m_clipboard.audioData = track->getAudioData();
+    m_clipboard.streamedClip = track->isStreamed() ? track->duplicate() : nullptr;
     m_clipboard.sampleRate = track->getSampleRate();
     m_clipboard.numChannels = track->getNumChannels();
     m_clipboard.name = track->getName();
@@ -2280,13 +2282,13 @@ void TrackManagerUI::pasteClip() {
     auto* selectedUI = getSelectedTrackUI();
     std::shared_ptr<Track> targetTrack = nullptr;
     
-    if (selectedUI && selectedUI->getTrack()->getAudioData().empty()) {
+    if (selectedUI && !selectedUI->getTrack()->hasAudioData()) {
         targetTrack = selectedUI->getTrack();
     } else {
         // Find first empty track
         for (size_t i = 0; i < m_trackManager->getTrackCount(); ++i) {
             auto track = m_trackManager->getTrack(i);
-            if (track && track->getAudioData().empty()) {
+            if (track && !track->hasAudioData()) {
                 targetTrack = track;
                 break;
             }
@@ -2298,11 +2300,15 @@ void TrackManagerUI::pasteClip() {
         return;
     }
     
-    // Paste the audio data
-    uint32_t totalSamples = static_cast<uint32_t>(m_clipboard.audioData.size() / m_clipboard.numChannels);
-    uint32_t targetSR = static_cast<uint32_t>(m_trackManager ? m_trackManager->getOutputSampleRate() : m_clipboard.sampleRate);
-    targetTrack->setAudioData(m_clipboard.audioData.data(), totalSamples,
-                              m_clipboard.sampleRate, m_clipboard.numChannels, targetSR);
+    // Paste the audio data (a streamed clip shares the stream)
+    if (m_clipboard.streamedClip) {
+        targetTrack->shareStream(*m_clipboard.streamedClip);
+    } else {
+        uint32_t totalSamples = static_cast<uint32_t>(m_clipboard.audioData.size() / m_clipboard.numChannels);
+        uint32_t targetSR = static_cast<uint32_t>(m_trackManager ? m_trackManager->getOutputSampleRate() : m_clipboard.sampleRate);
+        targetTrack->setAudioData(m_clipboard.audioData.data(), totalSamples,
+                                  m_clipboard.sampleRate, m_clipboard.numChannels, targetSR);
+    }
     targetTrack->setName(m_clipboard.name);  // Keep original name, no suffix
     targetTrack->setColor(m_clipboard.sourceColor);
     targetTrack->setTrimStart(m_clipboard.trimStart);
@@ -2327,7 +2333,7 @@ void TrackManagerUI::duplicateSelectedClip() {
     }
     
     auto track = selectedUI->getTrack();
-    if (!track || track->getAudioData().empty()) {
+    if (!track || !track->hasAudioData()) {
         Log::warning("Selected track has no audio to duplicate");
         return;
     }
@@ -2336,7 +2342,7 @@ void TrackManagerUI::duplicateSelectedClip() {
     auto duplicatedTrack = track->duplicate();
     if (duplicatedTrack) {
         // Position after original clip
-        double originalEnd = track->getStartPositionInTimeline() + track->getDuration();
+        double originalEnd = track->getStartPositionInTimeline() + track->getTrimmedDuration();
         duplicatedTrack->setStartPositionInTimeline(originalEnd);
         
         // Add to manager
@@ -2357,7 +2363,7 @@ void TrackManagerUI::deleteSelectedClip() {
     }
     
     auto track = selectedUI->getTrack();
-    if (!track || track->getAudioData().empty()) {
+    if (!track || !track->hasAudioData()) {
         return; // Already empty
     }
     
@@ -2528,9 +2534,16 @@ NomadUI::DropResult TrackManagerUI::onDrop(const NomadUI::DragData& data, const
         }
         // Different track - move clip data to new track
         else {
-            // Copy audio data to target track
+            // Copy audio data to target track (a streamed clip shares the stream and its trims)
             const auto& audioData = sourceTrack->getAudioData();
-            if (!audioData.empty()) {
+            bool moved = false;
+            if (sourceTrack->isStreamed()) {
+                moved = targetTrack->shareStream(*sourceTrack);
+                if (moved) {
+                    targetTrack->setTrimEnd(sourceTrack->getTrimEnd());
+                    targetTrack->setTrimStart(sourceTrack->getTrimStart());
+                }
+            } else if (!audioData.empty()) {
                 // Get source audio properties
                 uint32_t sampleRate = sourceTrack->getSampleRate();
                 uint32_t numChannels = sourceTrack->getNumChannels();
@@ -2540,6 +2553,9 @@ NomadUI::DropResult TrackManagerUI::onDrop(const NomadUI::DragData& data, const
                 targetTrack->setAudioData(audioData.data(), 
                                           static_cast<uint32_t>(audioData.size() / numChannels),
                                           sampleRate, numChannels, targetSR);
+                moved = true;
+            }
+            if (moved) {
                 targetTrack->setStartPositionInTimeline(timePosition);
                 targetTrack->setSourcePath(sourceTrack->getSourcePath());
                 targetTrack->setColor(sourceTrack->getColor());
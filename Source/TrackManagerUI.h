@@ -67,6 +67,7 @@ public:
     
     // Mixer Panel
     void toggleMixer();  // Show/hide mixer panel
+    std::shared_ptr<MixerPanel> getMixerPanel() const { return m_mixerPanel; }
 
     // Sequencer Panel
     void toggleSequencer();  // Show/hide step sequencer panel
@@ -267,6 +268,7 @@ private:
     struct ClipboardData {
         bool hasData = false;
         std::vector<float> audioData;
+        std::shared_ptr<Track> streamedClip;  // Streamed file: a copy sharing its stream (audioData stays empty)
         uint32_t sampleRate = 48000;
         uint32_t numChannels = 2;
         std::string name;
@@ -263,91 +263,14 @@ void TrackUIComponent::updateTrackNameColors() {
     }
 }
 
-void TrackUIComponent::generateWaveformCache(int width, int height) {
-    if (!m_track) return;
-    
-    const auto& audioData = m_track->getAudioData();
-    if (audioData.empty()) {
-        Log::warning("generateWaveformCache: Audio data is empty for track " + m_track->getName());
-        return;
-    }
-    
-    uint32_t numChannels = m_track->getNumChannels();
-    if (numChannels == 0) return;
-    
-    Log::info("generateWaveformCache: Generating cache for " + m_track->getName() + 
-              " Size: " + std::to_string(audioData.size()) + 
-              " Width: " + std::to_string(width));
-
-    // Clear and resize cache
-    m_waveformCache.clear();
-    m_waveformCache.resize(width, {0.0f, 0.0f});
-    
-    // Calculate samples per pixel
-    uint32_t totalSamples = static_cast<uint32_t>(audioData.size()) / numChannels;
-    float samplesPerPixel = static_cast<float>(totalSamples) / static_cast<float>(width);
-    
-    // Pre-calculate min/max for each pixel column
-    for (int x = 0; x < width; ++x) {
-        uint32_t sampleStart = static_cast<uint32_t>(x * samplesPerPixel);
-        uint32_t sampleEnd = static_cast<uint32_t>((x + 1) * samplesPerPixel);
-        
-        if (sampleStart >= totalSamples) break;
-        if (sampleEnd > totalSamples) sampleEnd = totalSamples;
-        
-        float minVal = 1000.0f;
-        float maxVal = -1000.0f;
-        bool hasSamples = false;
-
-        // Ensure we check at least one sample
-        if (sampleEnd <= sampleStart && sampleStart < totalSamples) {
-             sampleEnd = sampleStart + 1;
-        }
-        
-        for (uint32_t s = sampleStart; s < sampleEnd; ++s) {
-            uint32_t sampleIndex = s * numChannels;
-            if (sampleIndex < audioData.size()) {
-                float sample = audioData[sampleIndex];
-                if (sample < minVal) minVal = sample;
-                if (sample > maxVal) maxVal = sample;
-                hasSamples = true;
-            }
-        }
-
-        if (!hasSamples) {
-            minVal = 0.0f;
-            maxVal = 0.0f;
-        }
-        
-        m_waveformCache[x] = {minVal, maxVal};
-
-        // Debug log for middle pixel
-        if (x == width / 2) {
-             Log::info("generateWaveformCache: Middle pixel min=" + std::to_string(minVal) + " max=" + std::to_string(maxVal));
-        }
-    }
-    
-    // Update cache state
-    m_cachedWidth = width;
-    m_cachedHeight = height;
-    m_cachedAudioDataSize = audioData.size();
-}
-
 // Draw waveform for a specific track (for multi-clip lane support)
 void TrackUIComponent::drawWaveformForTrack(NomadUI::NUIRenderer& renderer, const NomadUI::NUIRect& bounds,
                                             std::shared_ptr<Track> track, float offsetRatio, float visibleRatio) {
     if (!track) return;
 
-    const auto& audioData = track->getAudioData();
-    if (audioData.empty()) return;
-
     int width = static_cast<int>(bounds.width);
     int height = static_cast<int>(bounds.height);
     
-    // For non-primary tracks, we need to generate waveform data on the fly
-    // (the cache is only for the primary track)
-    // Use a simpler approach: directly sample the audio data
-    
     uint32_t color = track->getColor();
     NomadUI::NUIColor waveformColor = NomadUI::NUIColor(
         (color >> 16) & 0xFF,
@@ -367,17 +290,35 @@ void TrackUIComponent::drawWaveformForTrack(NomadUI::NUIRenderer& renderer, cons
         waveformColor.withAlpha(0.3f)
     );
     
-    // Calculate sample range to draw
-    size_t numChannels = track->getNumChannels();
-    size_t totalFrames = audioData.size() / (numChannels > 0 ? numChannels : 1);
-    size_t startFrame = static_cast<size_t>(offsetRatio * totalFrames);
-    size_t endFrame = static_cast<size_t>((offsetRatio + visibleRatio) * totalFrames);
-    
-    startFrame = std::min(startFrame, totalFrames);
-    endFrame = std::min(endFrame, totalFrames);
+    // Peaks are built in the background; until then only the center line shows.
+    // Zooming and scrolling read cached vertices, never the samples.
+    auto peaks = track->getWaveformCache();
+    if (!peaks || !peaks->isReady() || width <= 0) return;
     
-    size_t visibleFrames = endFrame - startFrame;
-    if (visibleFrames == 0 || width <= 0) return;
+    auto& vertices = m_clipWaveforms[track.get()];
+    if (!vertices) {
+        vertices = std::make_unique<WaveformVertexCache>();
+    }
+    vertices->setSource(peaks);
+    
+    // Calculate sample range to draw; the ratios cover the trimmed part of the clip
+    SampleIndex totalFrames = peaks->getSourceFrames();
+    double duration = track->getDuration();
+    double framesPerSecond = duration > 0.0 ? static_cast<double>(totalFrames) / duration : 0.0;
+    SampleIndex firstFrame = static_cast<SampleIndex>(track->getTrimStart() * framesPerSecond);
+    SampleIndex lastFrame = track->getTrimEnd() > 0.0
+        ? static_cast<SampleIndex>(track->getTrimEnd() * framesPerSecond) : totalFrames;
+    lastFrame = std::clamp<SampleIndex>(lastFrame, 0, totalFrames);
+    firstFrame = std::clamp<SampleIndex>(firstFrame, 0, lastFrame);
+    double trimmedFrames = static_cast<double>(lastFrame - firstFrame);
+    SampleIndex startFrame = firstFrame + static_cast<SampleIndex>(offsetRatio * trimmedFrames);
+    SampleIndex endFrame = firstFrame + static_cast<SampleIndex>((offsetRatio + visibleRatio) * trimmedFrames);
+    
+    startFrame = std::clamp<SampleIndex>(startFrame, 0, totalFrames);
+    endFrame = std::clamp<SampleIndex>(endFrame, startFrame, totalFrames);
+    if (endFrame <= startFrame) return;
+    
+    if (!vertices->getColumns(startFrame, endFrame, static_cast<uint32_t>(width), m_waveformColumns)) return;
     
     // Build waveform as points
     std::vector<NomadUI::NUIPoint> topPoints;
@@ -386,30 +327,13 @@ void TrackUIComponent::drawWaveformForTrack(NomadUI::NUIRenderer& renderer, cons
     bottomPoints.reserve(width);
     
     float halfHeight = height / 2.0f;
-    size_t framesPerPixel = std::max(size_t(1), visibleFrames / width);
     
     for (int x = 0; x < width; ++x) {
-        size_t frameIndex = startFrame + (x * visibleFrames) / width;
-        size_t frameEnd = std::min(frameIndex + framesPerPixel, endFrame);
-        
-        float minVal = 0.0f;
-        float maxVal = 0.0f;
-        
-        // Find min/max in this pixel's range
-        for (size_t f = frameIndex; f < frameEnd; ++f) {
-            for (size_t c = 0; c < numChannels; ++c) {
-                size_t sampleIndex = f * numChannels + c;
-                if (sampleIndex < audioData.size()) {
-                    float sample = audioData[sampleIndex];
-                    minVal = std::min(minVal, sample);
-                    maxVal = std::max(maxVal, sample);
-                }
-            }
-        }
+        const WaveformPeak& column = m_waveformColumns[x];
         
         // Calculate screen coordinates
-        float topY = centerY - maxVal * halfHeight;
-        float bottomY = centerY - minVal * halfHeight;
+        float topY = centerY - column.max * halfHeight;
+        float bottomY = centerY - column.min * halfHeight;
         
         // Ensure silence is rendered as a 1px line
         if (bottomY - topY < 1.0f) {
@@ -429,101 +353,17 @@ void TrackUIComponent::drawWaveformForTrack(NomadUI::NUIRenderer& renderer, cons
 
 void TrackUIComponent::drawWaveform(NomadUI::NUIRenderer& renderer, const NomadUI::NUIRect& bounds,
                                      float offsetRatio, float visibleRatio) {
-    if (!m_track) return;
-
-    const auto& audioData = m_track->getAudioData();
-    if (audioData.empty()) return;
+    drawWaveformForTrack(renderer, bounds, m_track, offsetRatio, visibleRatio);
+}
 
-    int width = static_cast<int>(bounds.width);
-    int height = static_cast<int>(bounds.height);
-    
-    // Generate cache for reasonable resolution (fixed size, not based on pixel width)
-    // Use a fixed cache size of 4096 samples to represent the full waveform
-    const int CACHE_SIZE = 4096;
-    
-    // Regenerate cache only if audio data changed
-    if (m_cachedAudioDataSize != audioData.size() || m_waveformCache.size() != CACHE_SIZE) {
-        generateWaveformCache(CACHE_SIZE, height);
-    }
-    
-    // Fast drawing from cache
-    if (m_waveformCache.empty()) {
-        Log::warning("drawWaveform: Cache empty for " + m_track->getName());
-        return;
-    }
-    
-    uint32_t color = m_track->getColor();
-    NomadUI::NUIColor waveformColor = NomadUI::NUIColor(
-        (color >> 16) & 0xFF,
-        (color >> 8) & 0xFF,
-        color & 0xFF,
-        (color >> 24) & 0xFF
-    ) / 255.0f;
-    waveformColor = waveformColor.withAlpha(0.7f);
-    
-    int centerY = bounds.y + height / 2;
-    
-    // Draw center line
-    renderer.drawLine(
-        NomadUI::NUIPoint(bounds.x, centerY),
-        NomadUI::NUIPoint(bounds.x + bounds.width, centerY),
-        1.0f,
-        waveformColor.withAlpha(0.3f)
-    );
-    
-    // Calculate which portion of the cache to draw based on scroll/zoom
-    int cacheSize = static_cast<int>(m_waveformCache.size());
-    int cacheStartIndex = static_cast<int>(offsetRatio * cacheSize);
-    int cacheEndIndex = static_cast<int>((offsetRatio + visibleRatio) * cacheSize);
-    
-    // Clamp to valid range
-    cacheStartIndex = std::max(0, std::min(cacheStartIndex, cacheSize - 1));
-    cacheEndIndex = std::max(cacheStartIndex, std::min(cacheEndIndex, cacheSize));
-    
-    int visibleCacheSamples = cacheEndIndex - cacheStartIndex;
-    if (visibleCacheSamples <= 0) {
-        Log::warning("drawWaveform: No visible samples. Start=" + std::to_string(cacheStartIndex) + " End=" + std::to_string(cacheEndIndex));
-        return;
-    }
-    
-    // OPTIMIZED: Build waveform as triangle strip instead of per-pixel lines
-    // This reduces draw calls from 1920 to 1 per waveform
-    std::vector<NomadUI::NUIPoint> topPoints;
-    std::vector<NomadUI::NUIPoint> bottomPoints;
-    topPoints.reserve(width);
-    bottomPoints.reserve(width);
-    
-    float halfHeight = height / 2.0f;
-    
-    for (int x = 0; x < width; ++x) {
-        // Map screen pixel to cache index
-        float cacheProgress = static_cast<float>(x) / static_cast<float>(width);
-        int cacheIndex = cacheStartIndex + static_cast<int>(cacheProgress * visibleCacheSamples);
-        
-        if (cacheIndex >= cacheEndIndex || cacheIndex >= cacheSize) break;
-        
-        const auto& minMax = m_waveformCache[cacheIndex];
-        float minVal = minMax.first;
-        float maxVal = minMax.second;
-        
-        // Calculate screen coordinates
-        float topY = centerY - maxVal * halfHeight;
-        float bottomY = centerY - minVal * halfHeight;
-        
-        // Ensure silence is rendered as a 1px line
-        if (bottomY - topY < 1.0f) {
-            topY = centerY - 0.5f;
-            bottomY = centerY + 0.5f;
-        }
-        
-        // Top point (max value) and bottom point (min value)
-        topPoints.push_back(NomadUI::NUIPoint(bounds.x + x, topY));
-        bottomPoints.push_back(NomadUI::NUIPoint(bounds.x + x, bottomY));
-    }
-    
-    // Single draw call for entire waveform
-    if (!topPoints.empty()) {
-        renderer.fillWaveform(topPoints.data(), bottomPoints.data(), static_cast<int>(topPoints.size()), waveformColor);
+// Drop vertex caches of clips no longer on this lane
+void TrackUIComponent::pruneClipWaveforms() {
+    for (auto it = m_clipWaveforms.begin(); it != m_clipWaveforms.end();) {
+        const Track* clip = it->first;
+        bool onLane = m_track.get() == clip ||
+                      std::any_of(m_laneClips.begin(), m_laneClips.end(),
+                                  [clip](const std::shared_ptr<Track>& laneClip) { return laneClip.get() == clip; });
+        it = onLane ? std::next(it) : m_clipWaveforms.erase(it);
     }
 }
 
@@ -642,11 +482,11 @@ void TrackUIComponent::drawSampleClip(NomadUI::NUIRenderer& renderer, const Noma
 // Helper to draw a clip at its calculated position (for multi-clip lane support)
 void TrackUIComponent::drawClipAtPosition(NomadUI::NUIRenderer& renderer, std::shared_ptr<Track> clip,
                                           const NomadUI::NUIRect& bounds, float controlAreaWidth) {
-    if (!clip || clip->getAudioData().empty()) return;
+    if (!clip || !clip->hasAudioData()) return;
     
     // Calculate waveform position in timeline space
     double startPositionSeconds = clip->getStartPositionInTimeline();
-    double audioDuration = clip->getDuration();
+    double audioDuration = clip->getTrimmedDuration();
     double bpm = 120.0; // TODO: Get from project settings
     double secondsPerBeat = 60.0 / bpm;
     
@@ -811,16 +651,17 @@ void TrackUIComponent::onRender(NomadUI::NUIRenderer& renderer) {
     // Each clip is positioned based on its timeline position
     
     // Draw primary track's clip
-    if (m_track && !m_track->getAudioData().empty()) {
+    if (m_track && m_track->hasAudioData()) {
         drawClipAtPosition(renderer, m_track, bounds, controlAreaWidth);
     }
     
     // Draw additional lane clips (from split operations)
     for (const auto& laneClip : m_laneClips) {
-        if (laneClip && !laneClip->getAudioData().empty()) {
+        if (laneClip && laneClip->hasAudioData()) {
             drawClipAtPosition(renderer, laneClip, bounds, controlAreaWidth);
         }
     }
+    pruneClipWaveforms();
 
     // Apply greyscale overlay to playlist area for muted tracks (Bug #8: Mute/Solo Visual Feedback)
     if (m_track && m_track->isMuted() && m_isPrimaryForLane) {
@@ -1145,8 +986,9 @@ bool TrackUIComponent::onMouseEvent(const NomadUI::NUIMouseEvent& event) {
         
         // Convert pixel delta to time delta based on zoom level
         double duration = m_activeClip->getDuration();
-        if (duration > 0 && clipBounds.width > 0) {
-            double pixelsPerSecond = clipBounds.width / duration;
+        double shownDuration = m_activeClip->getTrimmedDuration();
+        if (duration > 0 && shownDuration > 0 && clipBounds.width > 0) {
+            double pixelsPerSecond = clipBounds.width / shownDuration;
             double timeDelta = deltaX / pixelsPerSecond;
             
             if (m_trimEdge == TrimEdge::Left) {
@@ -1243,11 +1085,11 @@ bool TrackUIComponent::onMouseEvent(const NomadUI::NUIMouseEvent& event) {
             if (isSplitToolActive && clickedClip && clickedClipBounds.width > 0) {
                 // Calculate time position from click - simple ratio of click position to clip width
                 double clickOffsetX = event.position.x - clickedClipBounds.x;
-                double duration = clickedClip->getDuration();
+                double duration = clickedClip->getTrimmedDuration();
                 
                 if (clickedClipBounds.width > 0 && duration > 0) {
                     double splitRatio = clickOffsetX / clickedClipBounds.width;
-                    // splitTime is seconds from start of the audio (0 to duration)
+                    // splitTime is seconds from the clip's visible start (0 to its trimmed duration)
                     double splitTime = splitRatio * duration;
                     
                     Log::info("Split requested at time: " + std::to_string(splitTime) + 
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "../NomadAudio/include/Track.h"
+#include "../NomadAudio/include/WaveformCache.h"
 #include "../NomadUI/Core/NUIComponent.h"
 #include "../NomadUI/Core/NUILabel.h"
 #include "../NomadUI/Core/NUIButton.h"
@@ -139,17 +140,16 @@ private:
                      float offsetRatio = 0.0f, float visibleRatio = 1.0f);
     void drawWaveformForTrack(NomadUI::NUIRenderer& renderer, const NomadUI::NUIRect& bounds,
                               std::shared_ptr<Track> track, float offsetRatio = 0.0f, float visibleRatio = 1.0f);
-    void generateWaveformCache(int width, int height);
     
     // Sample clip container (FL Studio style)
     void drawSampleClip(NomadUI::NUIRenderer& renderer, const NomadUI::NUIRect& clipBounds);
     void drawSampleClipForTrack(NomadUI::NUIRenderer& renderer, const NomadUI::NUIRect& clipBounds, std::shared_ptr<Track> track);
     
-    // Waveform cache (regenerate only when audio data or size changes)
-    std::vector<std::pair<float, float>> m_waveformCache; // min/max pairs per pixel
-    int m_cachedWidth = 0;
-    int m_cachedHeight = 0;
-    size_t m_cachedAudioDataSize = 0;
+    // Waveform vertices per clip (primary + lane clips), filled from the clip's
+    // shared WaveformCache for the visible range only
+    std::map<const Track*, std::unique_ptr<WaveformVertexCache>> m_clipWaveforms;
+    std::vector<WaveformPeak> m_waveformColumns;   // Scratch: one min/max per pixel
+    void pruneClipWaveforms();
     
     // Multi-clip support: additional clips on the same lane
     std::vector<std::shared_ptr<Track>> m_laneClips;